@@ -19,6 +19,11 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
 #include "celix/FrameworkFactory.h"
 #include "celix/FrameworkUtils.h"
 #include "celix_condition.h"
@@ -38,6 +43,19 @@ public:
             std::string{"("} + CELIX_CONDITION_ID + "=" + CELIX_CONDITION_ID_COMPONENTS_READY + ")";
 
     ComponentsReadyTestSuite() = default;
+
+    /**
+     * @brief Test component which calls the started function when the component is started.
+     */
+    struct CondComponent {
+        std::function<void()> started{};
+
+        void start() {
+            if (started) {
+                started();
+            }
+        }
+    };
 };
 
 TEST_F(ComponentsReadyTestSuite, ComponentsReadyTest) {
@@ -95,3 +113,61 @@ TEST_F(ComponentsReadyTestSuite, ComponentsReadyWithInactiveComponentTest) {
             .build();
     EXPECT_EQ(0, count);
 }
+
+TEST_F(ComponentsReadyTestSuite, ComponentsReadyAfterLastComponentIsActiveTest) {
+    // Given a Celix framework with a component which requires a not yet available condition service
+    auto fw = celix::createFramework();
+    auto ctx = fw->getFrameworkBundleContext();
+    std::mutex mutex{};
+    std::condition_variable cond{};
+    int eventSeq = 0;
+    int componentStartedSeq = -1;
+    int readySeq = -1;
+    bool componentActiveWhenReady = false;
+    auto& cmp = ctx->getDependencyManager()->createComponent<CondComponent>();
+    cmp.createServiceDependency<celix_condition>(CELIX_CONDITION_SERVICE_NAME)
+            .setFilter("(condition.id=test.dependency)")
+            .setRequired(true);
+    cmp.setCallbacks(nullptr, &CondComponent::start, nullptr, nullptr);
+    cmp.getInstance().started = [&] {
+        std::lock_guard<std::mutex> lck{mutex};
+        componentStartedSeq = ++eventSeq;
+    };
+    cmp.build();
+
+    // And a tracker which records when the "components.ready" condition becomes available
+    auto tracker = ctx->trackServices<celix_condition>(CELIX_CONDITION_SERVICE_NAME)
+            .setFilter(componentsReadyFilter)
+            .addAddCallback([&](const std::shared_ptr<celix_condition>&) {
+                std::lock_guard<std::mutex> lck{mutex};
+                readySeq = ++eventSeq;
+                componentActiveWhenReady = cmp.getState() == celix::dm::ComponentState::TRACKING_OPTIONAL;
+                cond.notify_all();
+            })
+            .build();
+
+    // When the components ready check bundle is installed
+    celix::installBundleSet(*fw, COMPONENTS_READY_CHECK_BUNDLE_SET);
+    ctx->waitForAllEvents();
+
+    // Then the "components.ready" condition is not available, because the component is not active
+    {
+        std::lock_guard<std::mutex> lck{mutex};
+        EXPECT_EQ(-1, readySeq);
+    }
+
+    // When the required condition service is registered
+    auto reg = ctx->registerService<celix_condition>(std::make_shared<celix_condition>(), CELIX_CONDITION_SERVICE_NAME)
+            .addProperty(CELIX_CONDITION_ID, "test.dependency")
+            .build();
+
+    // Then the "components.ready" condition becomes available, triggered by the component activation (the event queue
+    // becoming idle) instead of a polling interval
+    std::unique_lock<std::mutex> lck{mutex};
+    EXPECT_TRUE(cond.wait_for(lck, std::chrono::milliseconds{USE_SERVICE_TIMEOUT_IN_MS}, [&]{ return readySeq > 0; }));
+
+    // And the condition is signalled after the component became active
+    EXPECT_GT(componentStartedSeq, 0);
+    EXPECT_GT(readySeq, componentStartedSeq);
+    EXPECT_TRUE(componentActiveWhenReady);
+}
@@ -46,7 +46,7 @@ public:
         celix_ei_expect_celixThreadMutex_create(nullptr, 0, CELIX_SUCCESS);
         celix_ei_expect_celix_bundleContext_trackServicesWithOptionsAsync(nullptr, 0, 0);
         celix_ei_expect_celix_properties_create(nullptr, 0, nullptr);
-        celix_ei_expect_celix_bundleContext_scheduleEvent(nullptr, 0, 0);
+        celix_ei_expect_celix_bundleContext_addEventQueueIdleCallback(nullptr, 0, 0);
     }
 };
 
@@ -100,19 +100,21 @@ TEST_F(ComponentsReadyWithErrorInjectionTestSuite, ErrorRegisteringComponentsRea
     celix_componentsReadyCheck_destroy(rdy);
 }
 
-TEST_F(ComponentsReadyWithErrorInjectionTestSuite, ErrorSchedulingReadyCheckEventTest) {
+TEST_F(ComponentsReadyWithErrorInjectionTestSuite, ErrorAddingReadyCheckIdleCallbackTest) {
     // Given a Celix framework
     auto fw = celix::createFramework();
     auto ctx = fw->getFrameworkBundleContext();
 
-    // When an error injection for celix_bundleContext_scheduleEvent is primed when called from celix_componentReadyCheck_setFrameworkReadySvc
-    celix_ei_expect_celix_bundleContext_scheduleEvent((void*)celix_componentReadyCheck_setFrameworkReadySvc, 0, -1);
+    // When an error injection for celix_bundleContext_addEventQueueIdleCallback is primed when called from
+    // celix_componentReadyCheck_setFrameworkReadySvc
+    celix_ei_expect_celix_bundleContext_addEventQueueIdleCallback(
+        (void*)celix_componentReadyCheck_setFrameworkReadySvc, 0, -1);
 
     // And the components ready check is created
     auto* rdy = celix_componentsReadyCheck_create(ctx->getCBundleContext());
     EXPECT_NE(rdy, nullptr);
 
-    // But the components.ready condition will not become available, due to an error creating a check scheduled event
+    // But the components.ready condition will not become available, due to an error adding a check idle callback
     auto count = ctx->useService<celix_condition>(CELIX_CONDITION_SERVICE_NAME)
             .setFilter(componentsReadyFilter)
             .setTimeout(std::chrono::milliseconds {USE_SERVICE_TIMEOUT_IN_MS})
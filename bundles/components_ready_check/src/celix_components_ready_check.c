@@ -33,7 +33,8 @@ struct celix_components_ready_check {
     celix_condition_t conditionInstance;  /**< condition instance which can be used for multiple condition services.*/
     celix_thread_mutex_t mutex;           /**< mutex to protect the fields below. */
     long frameworkReadyTrackerId;         /**< tracker id for the framework ready condition service. */
-    long checkComponentsScheduledEventId; /**< event id of the scheduled event to check if the framework is ready. */
+    long checkComponentsIdleCallbackId;   /**< id of the event queue idle callback which checks if the components are
+                                            ready. */
     long componentsReadyConditionSvcId;   /**< service id of the condition service which is set when all components are
                                             ready. */
 };
@@ -44,7 +45,7 @@ celix_components_ready_check_t* celix_componentsReadyCheck_create(celix_bundle_c
     if (rdy) {
         rdy->ctx = ctx;
         rdy->frameworkReadyTrackerId = -1L;
-        rdy->checkComponentsScheduledEventId = -1L;
+        rdy->checkComponentsIdleCallbackId = -1L;
         rdy->componentsReadyConditionSvcId = -1L;
 
         status = celixThreadMutex_create(&rdy->mutex, NULL);
@@ -89,10 +90,10 @@ void celix_componentsReadyCheck_destroy(celix_components_ready_check_t* rdy) {
         celix_bundleContext_stopTracker(rdy->ctx, rdy->frameworkReadyTrackerId);
 
         celixThreadMutex_lock(&rdy->mutex);
-        long schedId = rdy->checkComponentsScheduledEventId;
-        rdy->checkComponentsScheduledEventId = -1L;
+        long idleCallbackId = rdy->checkComponentsIdleCallbackId;
+        rdy->checkComponentsIdleCallbackId = -1L;
         celixThreadMutex_unlock(&rdy->mutex);
-        celix_bundleContext_removeScheduledEvent(rdy->ctx, schedId);
+        celix_bundleContext_removeEventQueueIdleCallback(rdy->ctx, idleCallbackId);
 
         celixThreadMutex_lock(&rdy->mutex);
         long svcId = rdy->componentsReadyConditionSvcId;
@@ -122,15 +123,19 @@ void celix_componentReadyCheck_registerCondition(celix_components_ready_check_t*
 }
 
 static void celix_componentReadyCheck_check(void* data) {
+    // note called on the Celix event thread when the event queue became empty
     celix_components_ready_check_t* rdy = data;
     celix_dependency_manager_t* mng = celix_bundleContext_getDependencyManager(rdy->ctx);
     celix_framework_t* fw = celix_bundleContext_getFramework(rdy->ctx);
-    bool ready = celix_dependencyManager_allComponentsActive(mng) && celix_framework_isEventQueueEmpty(fw);
+    bool ready = celix_dependencyManager_nrOfInactiveComponentsOfAllBundles(mng) == 0 &&
+                 celix_framework_isEventQueueEmpty(fw);
     if (ready) {
         celixThreadMutex_lock(&rdy->mutex);
-        celix_bundleContext_removeScheduledEventAsync(rdy->ctx, rdy->checkComponentsScheduledEventId);
-        rdy->checkComponentsScheduledEventId = -1L;
-        celix_componentReadyCheck_registerCondition(rdy);
+        if (rdy->checkComponentsIdleCallbackId >= 0) {
+            celix_bundleContext_removeEventQueueIdleCallback(rdy->ctx, rdy->checkComponentsIdleCallbackId);
+            rdy->checkComponentsIdleCallbackId = -1L;
+            celix_componentReadyCheck_registerCondition(rdy);
+        }
         celixThreadMutex_unlock(&rdy->mutex);
     }
 }
@@ -138,20 +143,15 @@ static void celix_componentReadyCheck_check(void* data) {
 void celix_componentReadyCheck_setFrameworkReadySvc(void* handle, void* svc) {
     celix_components_ready_check_t* rdy = handle;
     celixThreadMutex_lock(&rdy->mutex);
-    if (svc && rdy->checkComponentsScheduledEventId < 0) {
-        // framework ready, now periodically check if all components are ready
-        celix_scheduled_event_options_t opts = CELIX_EMPTY_SCHEDULED_EVENT_OPTIONS;
-        opts.name = "celix_componentReady_check";
-        opts.callback = celix_componentReadyCheck_check;
-        opts.callbackData = rdy;
-        opts.initialDelayInSeconds = 0.1;
-        opts.intervalInSeconds = 0.1;
-        rdy->checkComponentsScheduledEventId = celix_bundleContext_scheduleEvent(rdy->ctx, &opts);
-        if (rdy->checkComponentsScheduledEventId < 0) {
+    if (svc && rdy->checkComponentsIdleCallbackId < 0 && rdy->componentsReadyConditionSvcId < 0) {
+        // framework ready, now check if all components are ready every time the event queue becomes empty
+        rdy->checkComponentsIdleCallbackId =
+            celix_bundleContext_addEventQueueIdleCallback(rdy->ctx, rdy, celix_componentReadyCheck_check);
+        if (rdy->checkComponentsIdleCallbackId < 0) {
             celix_bundleContext_log(rdy->ctx,
                                     CELIX_LOG_LEVEL_ERROR,
-                                    "Cannot schedule components ready check. Got event id %ld",
-                                    rdy->checkComponentsScheduledEventId);
+                                    "Cannot add components ready check idle callback. Got idle callback id %ld",
+                                    rdy->checkComponentsIdleCallbackId);
         }
     }
     celixThreadMutex_unlock(&rdy->mutex);
@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "celix_bundle_activator.h"
+#include "celix_bundle_context.h"
+#include "celix_configuration_admin_service.h"
+#include "celix_constants.h"
+#include "celix_file_utils.h"
+#include "celix_framework_factory.h"
+#include "celix_managed_service.h"
+
+#define CONFIG_ADMIN_ACT_TEST_STORE_DIR ".config_admin_act_test_store"
+
+class CelixConfigAdminActTestSuite : public ::testing::Test {
+public:
+    CelixConfigAdminActTestSuite() {
+        celix_utils_deleteDirectory(CONFIG_ADMIN_ACT_TEST_STORE_DIR, nullptr);
+        auto props = celix_properties_create();
+        celix_properties_set(props, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
+        celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, ".config_admin_act_test_cache");
+        celix_properties_set(props, "CELIX_CONFIG_ADMIN_STORE_DIR", CONFIG_ADMIN_ACT_TEST_STORE_DIR);
+        auto fwPtr = celix_frameworkFactory_createFramework(props);
+        fw = std::shared_ptr<celix_framework_t>{fwPtr, [](celix_framework_t* f) {celix_frameworkFactory_destroyFramework(f);}};
+        ctx = std::shared_ptr<celix_bundle_context_t>{celix_framework_getFrameworkContext(fw.get()), [](celix_bundle_context_t*){/*nop*/}};
+    }
+
+    ~CelixConfigAdminActTestSuite() override {
+        celix_utils_deleteDirectory(CONFIG_ADMIN_ACT_TEST_STORE_DIR, nullptr);
+    }
+
+    std::shared_ptr<celix_framework_t> fw{};
+    std::shared_ptr<celix_bundle_context_t> ctx{};
+};
+
+TEST_F(CelixConfigAdminActTestSuite, ActivatorStartTest) {
+    void *act{};
+    auto status = celix_bundleActivator_create(ctx.get(), &act);
+    ASSERT_EQ(CELIX_SUCCESS, status);
+    status = celix_bundleActivator_start(act, ctx.get());
+    ASSERT_EQ(CELIX_SUCCESS, status);
+
+    celix_bundleContext_waitForEvents(ctx.get());
+    long svcId = celix_bundleContext_findService(ctx.get(), CELIX_CONFIGURATION_ADMIN_SERVICE_NAME);
+    EXPECT_TRUE(svcId >= 0);
+
+    status = celix_bundleActivator_stop(act, ctx.get());
+    ASSERT_EQ(CELIX_SUCCESS, status);
+    status = celix_bundleActivator_destroy(act, ctx.get());
+    ASSERT_EQ(CELIX_SUCCESS, status);
+}
+
+TEST_F(CelixConfigAdminActTestSuite, UpdateManagedServiceTest) {
+    void *act{};
+    ASSERT_EQ(CELIX_SUCCESS, celix_bundleActivator_create(ctx.get(), &act));
+    ASSERT_EQ(CELIX_SUCCESS, celix_bundleActivator_start(act, ctx.get()));
+
+    static std::atomic<long> lastValue{-1};
+    celix_managed_service_t managedService{};
+    managedService.handle = nullptr;
+    managedService.updated = [](void*, const celix_properties_t* props) -> celix_status_t {
+        lastValue = props == nullptr ? -1 : celix_properties_getAsLong(props, "value", -2);
+        return CELIX_SUCCESS;
+    };
+    celix_service_registration_options_t regOpts{};
+    regOpts.svc = &managedService;
+    regOpts.serviceName = CELIX_MANAGED_SERVICE_NAME;
+    regOpts.serviceVersion = CELIX_MANAGED_SERVICE_VERSION;
+    regOpts.properties = celix_properties_create();
+    celix_properties_set(regOpts.properties, CELIX_CONFIGURATION_SERVICE_PID, "test.pid");
+    long managedSvcId = celix_bundleContext_registerServiceWithOptions(ctx.get(), &regOpts);
+    ASSERT_GE(managedSvcId, 0);
+
+    celix_service_use_options_t useOpts{};
+    useOpts.filter.serviceName = CELIX_CONFIGURATION_ADMIN_SERVICE_NAME;
+    useOpts.filter.versionRange = CELIX_CONFIGURATION_ADMIN_SERVICE_USE_RANGE;
+    useOpts.waitTimeoutInSeconds = 5;
+    useOpts.use = [](void*, void* svc) {
+        auto configAdmin = static_cast<celix_configuration_admin_service_t*>(svc);
+        celix_autoptr(celix_properties_t) props = celix_properties_create();
+        celix_properties_setLong(props, "value", 42);
+        EXPECT_EQ(CELIX_SUCCESS, configAdmin->updateConfiguration(configAdmin->handle, "test.pid", props));
+    };
+    EXPECT_TRUE(celix_bundleContext_useServiceWithOptions(ctx.get(), &useOpts));
+
+    for (int i = 0; i < 500 && lastValue != 42; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    EXPECT_EQ(42, lastValue);
+
+    celix_bundleContext_unregisterService(ctx.get(), managedSvcId);
+    ASSERT_EQ(CELIX_SUCCESS, celix_bundleActivator_stop(act, ctx.get()));
+    ASSERT_EQ(CELIX_SUCCESS, celix_bundleActivator_destroy(act, ctx.get()));
+}
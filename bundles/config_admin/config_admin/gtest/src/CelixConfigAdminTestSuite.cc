@@ -0,0 +1,315 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "celix_config_admin.h"
+#include "celix_configuration_admin_service.h"
+#include "celix_managed_service.h"
+#include "celix_managed_service_factory.h"
+#include "celix_bundle_context.h"
+#include "celix_constants.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_file_utils.h"
+#include "celix_framework_factory.h"
+
+#define CONFIG_ADMIN_TEST_STORE_DIR ".config_admin_test_store"
+
+class CelixConfigAdminTestSuite : public ::testing::Test {
+public:
+    CelixConfigAdminTestSuite() {
+        celix_utils_deleteDirectory(CONFIG_ADMIN_TEST_STORE_DIR, nullptr);
+        auto props = celix_properties_create();
+        celix_properties_set(props, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
+        celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, ".config_admin_test_cache");
+        celix_properties_set(props, "CELIX_CONFIG_ADMIN_STORE_DIR", CONFIG_ADMIN_TEST_STORE_DIR);
+        celix_properties_set(props, "CELIX_CONFIG_ADMIN_SYNC_INTERVAL", "0.01");
+        auto fwPtr = celix_frameworkFactory_createFramework(props);
+        fw = std::shared_ptr<celix_framework_t>{fwPtr, [](celix_framework_t* f) {celix_frameworkFactory_destroyFramework(f);}};
+        ctx = std::shared_ptr<celix_bundle_context_t>{celix_framework_getFrameworkContext(fw.get()), [](celix_bundle_context_t*){/*nop*/}};
+    }
+
+    ~CelixConfigAdminTestSuite() override {
+        celix_utils_deleteDirectory(CONFIG_ADMIN_TEST_STORE_DIR, nullptr);
+    }
+
+    struct ManagedService {
+        std::mutex mutex{};
+        std::condition_variable cond{};
+        int calls{0};
+        long lastValue{-1}; //-1 if updated with no configuration
+        std::atomic<bool> block{false};
+        std::atomic<bool> blocking{false};
+    };
+
+    static celix_status_t updated(void* handle, const celix_properties_t* props) {
+        auto* ms = static_cast<ManagedService*>(handle);
+        while (ms->block) {
+            ms->blocking = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        std::lock_guard<std::mutex> lock{ms->mutex};
+        ms->calls += 1;
+        ms->lastValue = props == nullptr ? -1 : celix_properties_getAsLong(props, "value", -2);
+        ms->cond.notify_all();
+        return CELIX_SUCCESS;
+    }
+
+    static bool waitFor(ManagedService& ms, const std::function<bool()>& predicate) {
+        std::unique_lock<std::mutex> lock{ms.mutex};
+        return ms.cond.wait_for(lock, std::chrono::seconds{5}, predicate);
+    }
+
+    static celix_properties_t* createServiceProperties(long svcId, const char* key, const char* pid) {
+        auto props = celix_properties_create();
+        celix_properties_setLong(props, CELIX_FRAMEWORK_SERVICE_ID, svcId);
+        celix_properties_set(props, key, pid);
+        return props;
+    }
+
+    static celix_properties_t* createConfiguration(long value) {
+        auto props = celix_properties_create();
+        celix_properties_setLong(props, "value", value);
+        return props;
+    }
+
+    static void updateConfiguration(celix_config_admin_t* admin, const char* pid, long value) {
+        celix_autoptr(celix_properties_t) props = createConfiguration(value);
+        EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_updateConfiguration(admin, pid, props));
+    }
+
+    std::shared_ptr<celix_framework_t> fw{};
+    std::shared_ptr<celix_bundle_context_t> ctx{};
+};
+
+TEST_F(CelixConfigAdminTestSuite, CreateStartStopDestroyTest) {
+    auto admin = celix_configAdmin_create(ctx.get());
+    ASSERT_NE(nullptr, admin);
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_start(admin));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_stop(admin));
+    celix_configAdmin_destroy(admin);
+}
+
+TEST_F(CelixConfigAdminTestSuite, ManagedServiceUpdatedTest) {
+    auto admin = celix_configAdmin_create(ctx.get());
+    ASSERT_NE(nullptr, admin);
+    ASSERT_EQ(CELIX_SUCCESS, celix_configAdmin_start(admin));
+
+    ManagedService ms{};
+    celix_managed_service_t svc{};
+    svc.handle = &ms;
+    svc.updated = updated;
+    celix_autoptr(celix_properties_t) svcProps = createServiceProperties(100, CELIX_CONFIGURATION_SERVICE_PID, "test.pid");
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_addManagedServiceWithProperties(admin, &svc, svcProps));
+    //no configuration yet -> updated with NULL
+    EXPECT_TRUE(waitFor(ms, [&]{return ms.calls == 1;}));
+    EXPECT_EQ(-1, ms.lastValue);
+
+    updateConfiguration(admin, "test.pid", 42);
+    EXPECT_TRUE(waitFor(ms, [&]{return ms.calls == 2;}));
+    EXPECT_EQ(42, ms.lastValue);
+
+    celix_properties_t* stored = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_getConfiguration(admin, "test.pid", &stored));
+    ASSERT_NE(nullptr, stored);
+    EXPECT_EQ(42, celix_properties_getAsLong(stored, "value", -1));
+    EXPECT_STREQ("test.pid", celix_properties_get(stored, CELIX_CONFIGURATION_SERVICE_PID, nullptr));
+    celix_properties_destroy(stored);
+
+    //configuration for another pid is not delivered
+    updateConfiguration(admin, "other.pid", 43);
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_deleteConfiguration(admin, "test.pid"));
+    EXPECT_TRUE(waitFor(ms, [&]{return ms.calls == 3;}));
+    EXPECT_EQ(-1, ms.lastValue);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_configAdmin_deleteConfiguration(admin, "test.pid"));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_getConfiguration(admin, "test.pid", &stored));
+    EXPECT_EQ(nullptr, stored);
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_removeManagedServiceWithProperties(admin, &svc, svcProps));
+    updateConfiguration(admin, "test.pid", 44);
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    EXPECT_EQ(3, ms.calls);
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_stop(admin));
+    celix_configAdmin_destroy(admin);
+}
+
+TEST_F(CelixConfigAdminTestSuite, CoalescedUpdatesTest) {
+    auto admin = celix_configAdmin_create(ctx.get());
+    ASSERT_NE(nullptr, admin);
+    ASSERT_EQ(CELIX_SUCCESS, celix_configAdmin_start(admin));
+
+    ManagedService ms{};
+    ms.block = true;
+    celix_managed_service_t svc{};
+    svc.handle = &ms;
+    svc.updated = updated;
+    celix_autoptr(celix_properties_t) svcProps = createServiceProperties(100, CELIX_CONFIGURATION_SERVICE_PID, "test.pid");
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_addManagedServiceWithProperties(admin, &svc, svcProps));
+    while (!ms.blocking) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    //while the managed service is busy, all updates are coalesced into a single pending update
+    for (long i = 0; i < 1000; ++i) {
+        updateConfiguration(admin, "test.pid", i);
+    }
+    ms.block = false;
+    EXPECT_TRUE(waitFor(ms, [&]{return ms.lastValue == 999;}));
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    EXPECT_EQ(2, ms.calls);
+
+    celix_config_store_statistics_t stats{};
+    celix_configAdmin_getStoreStatistics(admin, &stats);
+    EXPECT_EQ(1000, stats.appendedRecords);
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_removeManagedServiceWithProperties(admin, &svc, svcProps));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_stop(admin));
+    celix_configAdmin_destroy(admin);
+}
+
+TEST_F(CelixConfigAdminTestSuite, ManagedServiceFactoryTest) {
+    auto admin = celix_configAdmin_create(ctx.get());
+    ASSERT_NE(nullptr, admin);
+    ASSERT_EQ(CELIX_SUCCESS, celix_configAdmin_start(admin));
+
+    struct Factory {
+        std::mutex mutex{};
+        std::condition_variable cond{};
+        std::map<std::string, long> configs{};
+    } factory{};
+    celix_managed_service_factory_t svc{};
+    svc.handle = &factory;
+    svc.updated = [](void* handle, const char* pid, const celix_properties_t* props) -> celix_status_t {
+        auto* f = static_cast<Factory*>(handle);
+        std::lock_guard<std::mutex> lock{f->mutex};
+        f->configs[pid] = celix_properties_getAsLong(props, "value", -1);
+        f->cond.notify_all();
+        return CELIX_SUCCESS;
+    };
+    svc.deleted = [](void* handle, const char* pid) {
+        auto* f = static_cast<Factory*>(handle);
+        std::lock_guard<std::mutex> lock{f->mutex};
+        f->configs.erase(pid);
+        f->cond.notify_all();
+    };
+    auto waitForConfigs = [&](size_t n) {
+        std::unique_lock<std::mutex> lock{factory.mutex};
+        return factory.cond.wait_for(lock, std::chrono::seconds{5}, [&]{return factory.configs.size() == n;});
+    };
+
+    //existing factory configurations are delivered when the factory is added
+    celix_autoptr(celix_properties_t) config = createConfiguration(1);
+    celix_autofree char* pid1 = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_createFactoryConfiguration(admin, "test.factory", config, &pid1));
+    ASSERT_NE(nullptr, pid1);
+    celix_autoptr(celix_properties_t) svcProps = createServiceProperties(100, CELIX_CONFIGURATION_SERVICE_FACTORY_PID, "test.factory");
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_addManagedServiceFactoryWithProperties(admin, &svc, svcProps));
+    EXPECT_TRUE(waitForConfigs(1));
+
+    celix_autofree char* pid2 = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_createFactoryConfiguration(admin, "test.factory", config, &pid2));
+    ASSERT_NE(nullptr, pid2);
+    EXPECT_STRNE(pid1, pid2);
+    EXPECT_TRUE(waitForConfigs(2));
+
+    celix_properties_t* stored = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_getConfiguration(admin, pid2, &stored));
+    ASSERT_NE(nullptr, stored);
+    EXPECT_STREQ("test.factory", celix_properties_get(stored, CELIX_CONFIGURATION_SERVICE_FACTORY_PID, nullptr));
+    celix_properties_destroy(stored);
+
+    updateConfiguration(admin, pid2, 2);
+    {
+        std::unique_lock<std::mutex> lock{factory.mutex};
+        EXPECT_TRUE(factory.cond.wait_for(lock, std::chrono::seconds{5}, [&]{return factory.configs[pid2] == 2;}));
+    }
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_deleteConfiguration(admin, pid1));
+    EXPECT_TRUE(waitForConfigs(1));
+    EXPECT_EQ(1, factory.configs.count(pid2));
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_removeManagedServiceWithProperties(admin, &svc, svcProps));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_stop(admin));
+    celix_configAdmin_destroy(admin);
+}
+
+TEST_F(CelixConfigAdminTestSuite, ListConfigurationsTest) {
+    auto admin = celix_configAdmin_create(ctx.get());
+    ASSERT_NE(nullptr, admin);
+    updateConfiguration(admin, "pid1", 1);
+    updateConfiguration(admin, "pid2", 2);
+    updateConfiguration(admin, "pid3", 3);
+
+    celix_array_list_t* pids = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_listConfigurations(admin, nullptr, &pids));
+    ASSERT_NE(nullptr, pids);
+    EXPECT_EQ(3, celix_arrayList_size(pids));
+    celix_arrayList_destroy(pids);
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_listConfigurations(admin, "(value>=2)", &pids));
+    ASSERT_NE(nullptr, pids);
+    EXPECT_EQ(2, celix_arrayList_size(pids));
+    celix_arrayList_destroy(pids);
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_listConfigurations(admin, "(service.pid=pid1)", &pids));
+    ASSERT_NE(nullptr, pids);
+    ASSERT_EQ(1, celix_arrayList_size(pids));
+    EXPECT_STREQ("pid1", celix_arrayList_getString(pids, 0));
+    celix_arrayList_destroy(pids);
+
+    pids = nullptr;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_configAdmin_listConfigurations(admin, "(invalid", &pids));
+    EXPECT_EQ(nullptr, pids);
+    celix_configAdmin_destroy(admin);
+}
+
+TEST_F(CelixConfigAdminTestSuite, PersistedConfigurationTest) {
+    auto admin = celix_configAdmin_create(ctx.get());
+    ASSERT_NE(nullptr, admin);
+    ASSERT_EQ(CELIX_SUCCESS, celix_configAdmin_start(admin));
+    updateConfiguration(admin, "test.pid", 42);
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_stop(admin));
+    celix_configAdmin_destroy(admin);
+
+    admin = celix_configAdmin_create(ctx.get());
+    ASSERT_NE(nullptr, admin);
+    ASSERT_EQ(CELIX_SUCCESS, celix_configAdmin_start(admin));
+    ManagedService ms{};
+    celix_managed_service_t svc{};
+    svc.handle = &ms;
+    svc.updated = updated;
+    celix_autoptr(celix_properties_t) svcProps = createServiceProperties(100, CELIX_CONFIGURATION_SERVICE_PID, "test.pid");
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_addManagedServiceWithProperties(admin, &svc, svcProps));
+    EXPECT_TRUE(waitFor(ms, [&]{return ms.calls == 1;}));
+    EXPECT_EQ(42, ms.lastValue);
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_removeManagedServiceWithProperties(admin, &svc, svcProps));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configAdmin_stop(admin));
+    celix_configAdmin_destroy(admin);
+}
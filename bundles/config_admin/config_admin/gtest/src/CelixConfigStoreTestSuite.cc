@@ -0,0 +1,253 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "celix_config_store.h"
+#include "celix_bundle_context.h"
+#include "celix_constants.h"
+#include "celix_file_utils.h"
+#include "celix_framework_factory.h"
+#include "celix_log_helper.h"
+
+#define CONFIG_STORE_TEST_DIR ".config_store_test_dir"
+
+class CelixConfigStoreTestSuite : public ::testing::Test {
+public:
+    CelixConfigStoreTestSuite() {
+        auto props = celix_properties_create();
+        celix_properties_set(props, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
+        celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, ".config_store_test_cache");
+        auto fwPtr = celix_frameworkFactory_createFramework(props);
+        fw = std::shared_ptr<celix_framework_t>{fwPtr, [](celix_framework_t* f) {celix_frameworkFactory_destroyFramework(f);}};
+        ctx = std::shared_ptr<celix_bundle_context_t>{celix_framework_getFrameworkContext(fw.get()), [](celix_bundle_context_t*){/*nop*/}};
+        logHelper = std::shared_ptr<celix_log_helper_t>{celix_logHelper_create(ctx.get(), "ConfigStoreTest"), [](celix_log_helper_t* l) {celix_logHelper_destroy(l);}};
+        celix_utils_deleteDirectory(CONFIG_STORE_TEST_DIR, nullptr);
+    }
+
+    ~CelixConfigStoreTestSuite() override {
+        celix_utils_deleteDirectory(CONFIG_STORE_TEST_DIR, nullptr);
+    }
+
+    celix_config_store_t* createStore(size_t syncBatchSize = CELIX_CONFIG_STORE_DEFAULT_SYNC_BATCH_SIZE,
+                                      size_t compactMinWalSize = CELIX_CONFIG_STORE_DEFAULT_COMPACT_MIN_WAL_SIZE) {
+        celix_config_store_options_t opts{syncBatchSize, compactMinWalSize};
+        celix_config_store_t* store = nullptr;
+        auto status = celix_configStore_create(logHelper.get(), CONFIG_STORE_TEST_DIR, &opts, &store);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        return store;
+    }
+
+    static celix_properties_t* createProperties(long value) {
+        auto props = celix_properties_create();
+        celix_properties_set(props, "name", "test");
+        celix_properties_setLong(props, "value", value);
+        return props;
+    }
+
+    static off_t walFileSize() {
+        struct stat st{};
+        stat(CONFIG_STORE_TEST_DIR "/config.wal", &st);
+        return st.st_size;
+    }
+
+    std::shared_ptr<celix_framework_t> fw{};
+    std::shared_ptr<celix_bundle_context_t> ctx{};
+    std::shared_ptr<celix_log_helper_t> logHelper{};
+};
+
+TEST_F(CelixConfigStoreTestSuite, PutGetRemoveTest) {
+    auto store = createStore();
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(0, celix_configStore_size(store));
+    EXPECT_EQ(nullptr, celix_configStore_get(store, "pid1"));
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid1", nullptr, createProperties(1)));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid1", nullptr, createProperties(2)));
+    EXPECT_EQ(1, celix_configStore_size(store));
+    auto props = celix_configStore_get(store, "pid1");
+    ASSERT_NE(nullptr, props);
+    EXPECT_EQ(2, celix_properties_getAsLong(props, "value", -1));
+    EXPECT_EQ(nullptr, celix_configStore_getFactoryPid(store, "pid1"));
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_remove(store, "pid1"));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_configStore_remove(store, "pid1"));
+    EXPECT_EQ(nullptr, celix_configStore_get(store, "pid1"));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_configStore_put(store, "", nullptr, createProperties(1)));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_configStore_put(store, "pid1", nullptr, nullptr));
+    celix_configStore_destroy(store);
+}
+
+TEST_F(CelixConfigStoreTestSuite, FactoryIndexTest) {
+    auto store = createStore();
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "factory~1", "factory", createProperties(1)));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "factory~2", "factory", createProperties(2)));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "other~1", "other", createProperties(3)));
+    EXPECT_STREQ("factory", celix_configStore_getFactoryPid(store, "factory~1"));
+
+    auto pids = celix_configStore_getFactoryConfigurations(store, "factory");
+    ASSERT_NE(nullptr, pids);
+    EXPECT_EQ(2, celix_arrayList_size(pids));
+    EXPECT_EQ(nullptr, celix_configStore_getFactoryConfigurations(store, "unknown"));
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_remove(store, "factory~1"));
+    pids = celix_configStore_getFactoryConfigurations(store, "factory");
+    ASSERT_NE(nullptr, pids);
+    ASSERT_EQ(1, celix_arrayList_size(pids));
+    EXPECT_STREQ("factory~2", celix_arrayList_getString(pids, 0));
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_remove(store, "factory~2"));
+    EXPECT_EQ(nullptr, celix_configStore_getFactoryConfigurations(store, "factory"));
+    celix_configStore_destroy(store);
+}
+
+TEST_F(CelixConfigStoreTestSuite, ReloadTest) {
+    auto store = createStore();
+    ASSERT_NE(nullptr, store);
+    for (long i = 0; i < 10; ++i) {
+        EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid1", nullptr, createProperties(i)));
+    }
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid2", nullptr, createProperties(42)));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "factory~1", "factory", createProperties(43)));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid3", nullptr, createProperties(44)));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_remove(store, "pid3"));
+    celix_configStore_destroy(store);
+
+    store = createStore();
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(3, celix_configStore_size(store));
+    EXPECT_EQ(9, celix_properties_getAsLong(celix_configStore_get(store, "pid1"), "value", -1));
+    EXPECT_EQ(42, celix_properties_getAsLong(celix_configStore_get(store, "pid2"), "value", -1));
+    EXPECT_STREQ("test", celix_properties_get(celix_configStore_get(store, "pid2"), "name", nullptr));
+    EXPECT_STREQ("factory", celix_configStore_getFactoryPid(store, "factory~1"));
+    EXPECT_EQ(nullptr, celix_configStore_get(store, "pid3"));
+    celix_configStore_destroy(store);
+}
+
+TEST_F(CelixConfigStoreTestSuite, TornWalTailIsDiscardedTest) {
+    auto store = createStore();
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid1", nullptr, createProperties(1)));
+    celix_config_store_statistics_t stats{};
+    celix_configStore_getStatistics(store, &stats);
+    size_t firstRecordSize = stats.walSize;
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid2", nullptr, createProperties(2)));
+    celix_configStore_destroy(store);
+
+    //simulate a crash during the append of the second record
+    ASSERT_EQ(0, truncate(CONFIG_STORE_TEST_DIR "/config.wal", walFileSize() - 3));
+
+    store = createStore();
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(1, celix_configStore_size(store));
+    EXPECT_EQ(1, celix_properties_getAsLong(celix_configStore_get(store, "pid1"), "value", -1));
+    EXPECT_EQ(firstRecordSize, (size_t)walFileSize());
+
+    //new records are appended after the last valid record
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid3", nullptr, createProperties(3)));
+    celix_configStore_destroy(store);
+    store = createStore();
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(2, celix_configStore_size(store));
+    EXPECT_EQ(3, celix_properties_getAsLong(celix_configStore_get(store, "pid3"), "value", -1));
+    celix_configStore_destroy(store);
+}
+
+TEST_F(CelixConfigStoreTestSuite, CorruptRecordIsDiscardedTest) {
+    auto store = createStore();
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid1", nullptr, createProperties(1)));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid2", nullptr, createProperties(2)));
+    celix_configStore_destroy(store);
+
+    //flip the last byte of the second record
+    int fd = open(CONFIG_STORE_TEST_DIR "/config.wal", O_RDWR);
+    ASSERT_GE(fd, 0);
+    char c;
+    off_t last = walFileSize() - 1;
+    ASSERT_EQ(1, pread(fd, &c, 1, last));
+    c = (char)~c;
+    ASSERT_EQ(1, pwrite(fd, &c, 1, last));
+    close(fd);
+
+    store = createStore();
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(1, celix_configStore_size(store));
+    EXPECT_NE(nullptr, celix_configStore_get(store, "pid1"));
+    EXPECT_EQ(nullptr, celix_configStore_get(store, "pid2"));
+    celix_configStore_destroy(store);
+}
+
+TEST_F(CelixConfigStoreTestSuite, BatchedSyncTest) {
+    auto store = createStore(100);
+    ASSERT_NE(nullptr, store);
+    for (long i = 0; i < 10000; ++i) {
+        EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid1", nullptr, createProperties(i)));
+    }
+    celix_config_store_statistics_t stats{};
+    celix_configStore_getStatistics(store, &stats);
+    EXPECT_EQ(10000, stats.appendedRecords);
+    EXPECT_EQ(100, stats.syncs);
+    EXPECT_EQ(0, stats.unsyncedRecords);
+    EXPECT_FALSE(celix_configStore_needsSync(store));
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid1", nullptr, createProperties(10000)));
+    EXPECT_TRUE(celix_configStore_needsSync(store));
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_sync(store));
+    EXPECT_FALSE(celix_configStore_needsSync(store));
+    celix_configStore_destroy(store);
+}
+
+TEST_F(CelixConfigStoreTestSuite, CompactionTest) {
+    auto store = createStore(0, 4096);
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "factory~1", "factory", createProperties(-1)));
+    for (long i = 0; i < 1000; ++i) {
+        EXPECT_EQ(CELIX_SUCCESS, celix_configStore_put(store, "pid1", nullptr, createProperties(i)));
+    }
+    celix_config_store_statistics_t stats{};
+    celix_configStore_getStatistics(store, &stats);
+    EXPECT_GT(stats.compactions, 0);
+    EXPECT_LT(stats.walSize, 4096);
+    EXPECT_LT((size_t)walFileSize(), 4096);
+    celix_configStore_destroy(store);
+
+    //reload from snapshot + write-ahead log
+    store = createStore(0, 4096);
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(2, celix_configStore_size(store));
+    EXPECT_EQ(999, celix_properties_getAsLong(celix_configStore_get(store, "pid1"), "value", -1));
+    EXPECT_STREQ("factory", celix_configStore_getFactoryPid(store, "factory~1"));
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_configStore_compact(store));
+    celix_configStore_getStatistics(store, &stats);
+    EXPECT_EQ(0, stats.walSize);
+    celix_configStore_destroy(store);
+
+    store = createStore(0, 4096);
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(2, celix_configStore_size(store));
+    EXPECT_EQ(999, celix_properties_getAsLong(celix_configStore_get(store, "pid1"), "value", -1));
+    celix_configStore_destroy(store);
+}
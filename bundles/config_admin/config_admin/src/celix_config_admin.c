@@ -0,0 +1,537 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_config_admin.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "celix_configuration_admin_service.h"
+#include "celix_managed_service.h"
+#include "celix_managed_service_factory.h"
+#include "celix_bundle.h"
+#include "celix_constants.h"
+#include "celix_filter.h"
+#include "celix_log_helper.h"
+#include "celix_long_hash_map.h"
+#include "celix_string_hash_map.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_threads.h"
+#include "celix_utils.h"
+
+#define CELIX_CONFIG_ADMIN_STORE_DIR_DEFAULT "config_store" //relative to the bundle data dir
+#define CELIX_CONFIG_ADMIN_SYNC_INTERVAL_DEFAULT 0.2 //seconds
+
+typedef struct celix_config_admin_managed_service {
+    long svcId;
+    char* pid; //pid of a managed service or factory pid of a managed service factory
+    celix_managed_service_t* managedService; //NULL for a managed service factory
+    celix_managed_service_factory_t* factory; //NULL for a managed service
+} celix_config_admin_managed_service_t;
+
+typedef struct celix_config_admin_pending_update {
+    long svcId;
+    char* pid;
+    char* key;
+    struct celix_config_admin_pending_update* next;
+} celix_config_admin_pending_update_t;
+
+struct celix_config_admin {
+    celix_bundle_context_t* ctx;
+    celix_log_helper_t* logHelper;
+    double syncInterval;
+    celix_thread_mutex_t mutex; //protects below
+    celix_thread_cond_t cond;
+    celix_config_store_t* store;
+    celix_long_hash_map_t* managedServices; //key: service id, value: celix_config_admin_managed_service_t*
+    celix_string_hash_map_t* pendingUpdates; //key: "<service id>/<pid>", value: celix_config_admin_pending_update_t*
+    celix_config_admin_pending_update_t* pendingHead; //FIFO of the pending updates, owner of the pending updates
+    celix_config_admin_pending_update_t* pendingTail;
+    long deliveringSvcId; //service id of the managed service currently called by the dispatch thread or -1
+    unsigned long factoryPidCounter;
+    bool running;
+    celix_thread_t dispatchThread;
+};
+
+static void* celix_configAdmin_dispatchThread(void* data);
+
+static void celix_configAdmin_destroyManagedService(void* data) {
+    celix_config_admin_managed_service_t* entry = data;
+    if (entry != NULL) {
+        free(entry->pid);
+        free(entry);
+    }
+}
+
+static void celix_configAdmin_destroyPendingUpdate(celix_config_admin_pending_update_t* pending) {
+    free(pending->key);
+    free(pending->pid);
+    free(pending);
+}
+
+celix_config_admin_t* celix_configAdmin_create(celix_bundle_context_t* ctx) {
+    celix_autofree celix_config_admin_t* admin = calloc(1, sizeof(*admin));
+    if (admin == NULL) {
+        return NULL;
+    }
+    admin->ctx = ctx;
+    admin->deliveringSvcId = -1;
+    admin->running = false;
+
+    celix_autoptr(celix_log_helper_t) logHelper = admin->logHelper = celix_logHelper_create(ctx, "CelixConfigAdmin");
+    if (logHelper == NULL) {
+        return NULL;
+    }
+    admin->syncInterval = celix_bundleContext_getPropertyAsDouble(ctx, "CELIX_CONFIG_ADMIN_SYNC_INTERVAL", CELIX_CONFIG_ADMIN_SYNC_INTERVAL_DEFAULT);
+    if (admin->syncInterval <= 0) {
+        celix_logHelper_error(logHelper, "CELIX_CONFIG_ADMIN_SYNC_INTERVAL must be larger than 0.");
+        return NULL;
+    }
+    celix_config_store_options_t storeOpts;
+    storeOpts.syncBatchSize = (size_t)celix_bundleContext_getPropertyAsLong(ctx, "CELIX_CONFIG_ADMIN_SYNC_BATCH_SIZE", CELIX_CONFIG_STORE_DEFAULT_SYNC_BATCH_SIZE);
+    storeOpts.compactMinWalSize = (size_t)celix_bundleContext_getPropertyAsLong(ctx, "CELIX_CONFIG_ADMIN_COMPACT_MIN_WAL_SIZE", CELIX_CONFIG_STORE_DEFAULT_COMPACT_MIN_WAL_SIZE);
+
+    celix_autofree char* storeDir = NULL;
+    const char* configuredStoreDir = celix_bundleContext_getProperty(ctx, "CELIX_CONFIG_ADMIN_STORE_DIR", NULL);
+    if (configuredStoreDir != NULL) {
+        storeDir = celix_utils_strdup(configuredStoreDir);
+    } else {
+        storeDir = celix_bundle_getDataFile(celix_bundleContext_getBundle(ctx), CELIX_CONFIG_ADMIN_STORE_DIR_DEFAULT);
+    }
+    if (storeDir == NULL) {
+        celix_logHelper_error(logHelper, "Failed to get the configuration store dir.");
+        return NULL;
+    }
+    celix_status_t status = celix_configStore_create(logHelper, storeDir, &storeOpts, &admin->store);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Failed to create the configuration store in %s.", storeDir);
+        return NULL;
+    }
+    celix_autoptr(celix_config_store_t) store = admin->store;
+
+    status = celixThreadMutex_create(&admin->mutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Failed to create config admin mutex.");
+        return NULL;
+    }
+    celix_autoptr(celix_thread_mutex_t) mutex = &admin->mutex;
+    status = celixThreadCondition_init(&admin->cond, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Failed to create config admin condition.");
+        return NULL;
+    }
+    celix_autoptr(celix_thread_cond_t) cond = &admin->cond;
+
+    celix_long_hash_map_create_options_t opts = CELIX_EMPTY_LONG_HASH_MAP_CREATE_OPTIONS;
+    opts.simpleRemovedCallback = celix_configAdmin_destroyManagedService;
+    celix_autoptr(celix_long_hash_map_t) managedServices = admin->managedServices = celix_longHashMap_createWithOptions(&opts);
+    if (managedServices == NULL) {
+        celix_logHelper_logTssErrors(logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(logHelper, "Failed to create managed service map.");
+        return NULL;
+    }
+    celix_autoptr(celix_string_hash_map_t) pendingUpdates = admin->pendingUpdates = celix_stringHashMap_create();
+    if (pendingUpdates == NULL) {
+        celix_logHelper_logTssErrors(logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(logHelper, "Failed to create pending update map.");
+        return NULL;
+    }
+
+    celix_steal_ptr(pendingUpdates);
+    celix_steal_ptr(managedServices);
+    celix_steal_ptr(cond);
+    celix_steal_ptr(mutex);
+    celix_steal_ptr(store);
+    celix_steal_ptr(logHelper);
+    return celix_steal_ptr(admin);
+}
+
+void celix_configAdmin_destroy(celix_config_admin_t* admin) {
+    if (admin == NULL) {
+        return;
+    }
+    while (admin->pendingHead != NULL) {
+        celix_config_admin_pending_update_t* pending = admin->pendingHead;
+        admin->pendingHead = pending->next;
+        celix_configAdmin_destroyPendingUpdate(pending);
+    }
+    celix_stringHashMap_destroy(admin->pendingUpdates);
+    celix_longHashMap_destroy(admin->managedServices);
+    celixThreadCondition_destroy(&admin->cond);
+    celixThreadMutex_destroy(&admin->mutex);
+    celix_configStore_destroy(admin->store);
+    celix_logHelper_destroy(admin->logHelper);
+    free(admin);
+}
+
+int celix_configAdmin_start(celix_config_admin_t* admin) {
+    celixThreadMutex_lock(&admin->mutex);
+    admin->running = true;
+    celixThreadMutex_unlock(&admin->mutex);
+    celix_status_t status = celixThread_create(&admin->dispatchThread, NULL, celix_configAdmin_dispatchThread, admin);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(admin->logHelper, "Failed to create config admin dispatch thread.");
+        celixThreadMutex_lock(&admin->mutex);
+        admin->running = false;
+        celixThreadMutex_unlock(&admin->mutex);
+        return status;
+    }
+    celixThread_setName(&admin->dispatchThread, "CelixConfigAdmin");
+    return CELIX_SUCCESS;
+}
+
+int celix_configAdmin_stop(celix_config_admin_t* admin) {
+    celixThreadMutex_lock(&admin->mutex);
+    admin->running = false;
+    celixThreadCondition_broadcast(&admin->cond);
+    celixThreadMutex_unlock(&admin->mutex);
+    celixThread_join(admin->dispatchThread, NULL);
+
+    celixThreadMutex_lock(&admin->mutex);
+    celix_status_t status = celix_configStore_sync(admin->store);
+    celixThreadMutex_unlock(&admin->mutex);
+    return status;
+}
+
+/**
+ * @brief Queue the delivery of the configuration of a pid to a managed service (factory).
+ *
+ * If a delivery of the same pid to the same service is already pending, the updates are coalesced: the dispatch
+ * thread delivers the configuration as stored at the moment of the call.
+ * Should be called with the mutex locked.
+ */
+static void celix_configAdmin_queueUpdate(celix_config_admin_t* admin, long svcId, const char* pid) {
+    char buf[128];
+    char* key = celix_utils_writeOrCreateString(buf, sizeof(buf), "%li/%s", svcId, pid);
+    if (key == NULL) {
+        celix_logHelper_error(admin->logHelper, "Failed to queue configuration %s for service %li.", pid, svcId);
+        return;
+    }
+    if (celix_stringHashMap_hasKey(admin->pendingUpdates, key)) {
+        celix_utils_freeStringIfNotEqual(buf, key);
+        return;
+    }
+
+    celix_config_admin_pending_update_t* pending = calloc(1, sizeof(*pending));
+    if (pending != NULL) {
+        pending->svcId = svcId;
+        pending->pid = celix_utils_strdup(pid);
+        pending->key = celix_utils_strdup(key);
+    }
+    celix_utils_freeStringIfNotEqual(buf, key);
+    if (pending == NULL || pending->pid == NULL || pending->key == NULL ||
+        celix_stringHashMap_put(admin->pendingUpdates, pending->key, pending) != CELIX_SUCCESS) {
+        celix_logHelper_error(admin->logHelper, "Failed to queue configuration %s for service %li.", pid, svcId);
+        if (pending != NULL) {
+            celix_configAdmin_destroyPendingUpdate(pending);
+        }
+        return;
+    }
+    if (admin->pendingTail == NULL) {
+        admin->pendingHead = pending;
+    } else {
+        admin->pendingTail->next = pending;
+    }
+    admin->pendingTail = pending;
+    celixThreadCondition_broadcast(&admin->cond);
+}
+
+/**
+ * @brief Queue the delivery of the configuration of a pid to all matching managed services (factories).
+ * Should be called with the mutex locked.
+ */
+static void celix_configAdmin_queueUpdatesForPid(celix_config_admin_t* admin, const char* pid, const char* factoryPid) {
+    CELIX_LONG_HASH_MAP_ITERATE(admin->managedServices, iter) {
+        const celix_config_admin_managed_service_t* entry = iter.value.ptrValue;
+        if (factoryPid == NULL && entry->managedService != NULL && strcmp(entry->pid, pid) == 0) {
+            celix_configAdmin_queueUpdate(admin, entry->svcId, pid);
+        } else if (factoryPid != NULL && entry->factory != NULL && strcmp(entry->pid, factoryPid) == 0) {
+            celix_configAdmin_queueUpdate(admin, entry->svcId, pid);
+        }
+    }
+}
+
+/**
+ * @brief Deliver the first pending update. Called from the dispatch thread with the mutex locked, the mutex is
+ * unlocked while calling the managed service (factory).
+ */
+static void celix_configAdmin_deliverPendingUpdate(celix_config_admin_t* admin) {
+    celix_config_admin_pending_update_t* pending = admin->pendingHead;
+    admin->pendingHead = pending->next;
+    if (admin->pendingHead == NULL) {
+        admin->pendingTail = NULL;
+    }
+    celix_stringHashMap_remove(admin->pendingUpdates, pending->key);
+
+    const celix_config_admin_managed_service_t* entry = celix_longHashMap_get(admin->managedServices, pending->svcId);
+    if (entry == NULL) {
+        //managed service already removed
+        celix_configAdmin_destroyPendingUpdate(pending);
+        return;
+    }
+    const celix_properties_t* stored = celix_configStore_get(admin->store, pending->pid);
+    celix_autoptr(celix_properties_t) properties = stored == NULL ? NULL : celix_properties_copy(stored);
+    if (stored != NULL && properties == NULL) {
+        celix_logHelper_logTssErrors(admin->logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(admin->logHelper, "Failed to copy configuration %s.", pending->pid);
+        celix_configAdmin_destroyPendingUpdate(pending);
+        return;
+    }
+
+    //note the managed service entry cannot be removed while deliveringSvcId is set
+    admin->deliveringSvcId = pending->svcId;
+    celixThreadMutex_unlock(&admin->mutex);
+    celix_status_t status = CELIX_SUCCESS;
+    if (entry->managedService != NULL) {
+        status = entry->managedService->updated(entry->managedService->handle, properties);
+    } else if (properties != NULL) {
+        status = entry->factory->updated(entry->factory->handle, pending->pid, properties);
+    } else {
+        entry->factory->deleted(entry->factory->handle, pending->pid);
+    }
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_warning(admin->logHelper, "Service %li did not accept configuration %s: %s.", pending->svcId, pending->pid, celix_strerror(status));
+    }
+    celixThreadMutex_lock(&admin->mutex);
+    admin->deliveringSvcId = -1;
+    celixThreadCondition_broadcast(&admin->cond);
+    celix_configAdmin_destroyPendingUpdate(pending);
+}
+
+static void* celix_configAdmin_dispatchThread(void* data) {
+    celix_config_admin_t* admin = data;
+    celixThreadMutex_lock(&admin->mutex);
+    struct timespec nextSync = celixThreadCondition_getDelayedTime(admin->syncInterval);
+    while (admin->running) {
+        if (admin->pendingHead == NULL) {
+            celixThreadCondition_waitUntil(&admin->cond, &admin->mutex, &nextSync);
+        }
+        struct timespec now = celixThreadCondition_getTime();
+        if (celix_compareTime(&now, &nextSync) >= 0) {
+            //note batched fsync of the configuration updates of the last sync interval
+            (void)celix_configStore_sync(admin->store);
+            nextSync = celixThreadCondition_getDelayedTime(admin->syncInterval);
+        }
+        if (admin->running && admin->pendingHead != NULL) {
+            celix_configAdmin_deliverPendingUpdate(admin);
+        }
+    }
+    celixThreadMutex_unlock(&admin->mutex);
+    return NULL;
+}
+
+static int celix_configAdmin_addService(celix_config_admin_t* admin, void* svc, const celix_properties_t* props, bool factory) {
+    const char* pidKey = factory ? CELIX_CONFIGURATION_SERVICE_FACTORY_PID : CELIX_CONFIGURATION_SERVICE_PID;
+    const char* pid = celix_properties_get(props, pidKey, NULL);
+    long svcId = celix_properties_getAsLong(props, CELIX_FRAMEWORK_SERVICE_ID, -1L);
+    if (pid == NULL || svcId < 0) {
+        celix_logHelper_error(admin->logHelper, "Managed service without %s or service id.", pidKey);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_autofree celix_config_admin_managed_service_t* entry = calloc(1, sizeof(*entry));
+    if (entry == NULL) {
+        celix_logHelper_error(admin->logHelper, "Failed to allocate managed service entry.");
+        return CELIX_ENOMEM;
+    }
+    entry->svcId = svcId;
+    entry->managedService = factory ? NULL : svc;
+    entry->factory = factory ? svc : NULL;
+    celix_autofree char* entryPid = entry->pid = celix_utils_strdup(pid);
+    if (entryPid == NULL) {
+        celix_logHelper_error(admin->logHelper, "Failed to allocate managed service entry.");
+        return CELIX_ENOMEM;
+    }
+
+    celixThreadMutex_lock(&admin->mutex);
+    celix_status_t status = celix_longHashMap_put(admin->managedServices, svcId, entry);
+    if (status == CELIX_SUCCESS) {
+        celix_steal_ptr(entryPid);
+        celix_steal_ptr(entry);
+        if (!factory) {
+            celix_configAdmin_queueUpdate(admin, svcId, pid);
+        } else {
+            const celix_array_list_t* pids = celix_configStore_getFactoryConfigurations(admin->store, pid);
+            int size = pids == NULL ? 0 : celix_arrayList_size(pids);
+            for (int i = 0; i < size; ++i) {
+                celix_configAdmin_queueUpdate(admin, svcId, celix_arrayList_getString(pids, i));
+            }
+        }
+    } else {
+        celix_logHelper_logTssErrors(admin->logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(admin->logHelper, "Failed to add managed service %li.", svcId);
+    }
+    celixThreadMutex_unlock(&admin->mutex);
+    return status;
+}
+
+int celix_configAdmin_addManagedServiceWithProperties(void* handle, void* svc, const celix_properties_t* props) {
+    return celix_configAdmin_addService(handle, svc, props, false);
+}
+
+int celix_configAdmin_addManagedServiceFactoryWithProperties(void* handle, void* svc, const celix_properties_t* props) {
+    return celix_configAdmin_addService(handle, svc, props, true);
+}
+
+int celix_configAdmin_removeManagedServiceWithProperties(void* handle, void* svc CELIX_UNUSED, const celix_properties_t* props) {
+    celix_config_admin_t* admin = handle;
+    long svcId = celix_properties_getAsLong(props, CELIX_FRAMEWORK_SERVICE_ID, -1L);
+    celixThreadMutex_lock(&admin->mutex);
+    while (admin->deliveringSvcId == svcId) {
+        celixThreadCondition_wait(&admin->cond, &admin->mutex);
+    }
+    celix_longHashMap_remove(admin->managedServices, svcId);
+    celixThreadMutex_unlock(&admin->mutex);
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_configAdmin_getConfiguration(void* handle, const char* pid, celix_properties_t** properties) {
+    celix_config_admin_t* admin = handle;
+    *properties = NULL;
+    if (pid == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_auto(celix_mutex_lock_guard_t) lockGuard = celixMutexLockGuard_init(&admin->mutex);
+    const celix_properties_t* stored = celix_configStore_get(admin->store, pid);
+    if (stored != NULL) {
+        *properties = celix_properties_copy(stored);
+        if (*properties == NULL) {
+            celix_logHelper_logTssErrors(admin->logHelper, CELIX_LOG_LEVEL_ERROR);
+            return CELIX_ENOMEM;
+        }
+    }
+    return CELIX_SUCCESS;
+}
+
+/**
+ * @brief Store a (factory) configuration and queue its delivery. Should be called with the mutex locked.
+ */
+static celix_status_t celix_configAdmin_storeConfiguration(celix_config_admin_t* admin, const char* pid, const char* factoryPid, const celix_properties_t* properties) {
+    celix_autoptr(celix_properties_t) copy = celix_properties_copy(properties);
+    if (copy == NULL) {
+        celix_logHelper_logTssErrors(admin->logHelper, CELIX_LOG_LEVEL_ERROR);
+        return CELIX_ENOMEM;
+    }
+    celix_status_t status = celix_properties_set(copy, CELIX_CONFIGURATION_SERVICE_PID, pid);
+    if (status == CELIX_SUCCESS && factoryPid != NULL) {
+        status = celix_properties_set(copy, CELIX_CONFIGURATION_SERVICE_FACTORY_PID, factoryPid);
+    }
+    status = CELIX_DO_IF(status, celix_configStore_put(admin->store, pid, factoryPid, celix_steal_ptr(copy)));
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(admin->logHelper, "Failed to store configuration %s: %s.", pid, celix_strerror(status));
+        return status;
+    }
+    celix_configAdmin_queueUpdatesForPid(admin, pid, factoryPid);
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_configAdmin_updateConfiguration(void* handle, const char* pid, const celix_properties_t* properties) {
+    celix_config_admin_t* admin = handle;
+    if (pid == NULL || pid[0] == '\0' || properties == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_auto(celix_mutex_lock_guard_t) lockGuard = celixMutexLockGuard_init(&admin->mutex);
+    const char* storedFactoryPid = celix_configStore_getFactoryPid(admin->store, pid);
+    celix_autofree char* factoryPid = storedFactoryPid == NULL ? NULL : celix_utils_strdup(storedFactoryPid);
+    if (storedFactoryPid != NULL && factoryPid == NULL) {
+        return CELIX_ENOMEM;
+    }
+    return celix_configAdmin_storeConfiguration(admin, pid, factoryPid, properties);
+}
+
+celix_status_t celix_configAdmin_createFactoryConfiguration(void* handle, const char* factoryPid, const celix_properties_t* properties, char** pid) {
+    celix_config_admin_t* admin = handle;
+    *pid = NULL;
+    if (factoryPid == NULL || factoryPid[0] == '\0' || properties == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_auto(celix_mutex_lock_guard_t) lockGuard = celixMutexLockGuard_init(&admin->mutex);
+    celix_autofree char* newPid = NULL;
+    do {
+        free(newPid);
+        if (asprintf(&newPid, "%s~%lu", factoryPid, ++admin->factoryPidCounter) < 0) {
+            return CELIX_ENOMEM;
+        }
+    } while (celix_configStore_get(admin->store, newPid) != NULL);
+    celix_status_t status = celix_configAdmin_storeConfiguration(admin, newPid, factoryPid, properties);
+    if (status == CELIX_SUCCESS) {
+        *pid = celix_steal_ptr(newPid);
+    }
+    return status;
+}
+
+celix_status_t celix_configAdmin_deleteConfiguration(void* handle, const char* pid) {
+    celix_config_admin_t* admin = handle;
+    if (pid == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_auto(celix_mutex_lock_guard_t) lockGuard = celixMutexLockGuard_init(&admin->mutex);
+    const char* storedFactoryPid = celix_configStore_getFactoryPid(admin->store, pid);
+    celix_autofree char* factoryPid = storedFactoryPid == NULL ? NULL : celix_utils_strdup(storedFactoryPid);
+    if (storedFactoryPid != NULL && factoryPid == NULL) {
+        return CELIX_ENOMEM;
+    }
+    celix_status_t status = celix_configStore_remove(admin->store, pid);
+    if (status == CELIX_SUCCESS) {
+        celix_configAdmin_queueUpdatesForPid(admin, pid, factoryPid);
+    }
+    return status;
+}
+
+typedef struct celix_config_admin_list_data {
+    const celix_filter_t* filter;
+    celix_array_list_t* pids;
+    celix_status_t status;
+} celix_config_admin_list_data_t;
+
+static void celix_configAdmin_addMatchingPid(void* data, const char* pid, const celix_properties_t* properties) {
+    celix_config_admin_list_data_t* listData = data;
+    if (listData->status == CELIX_SUCCESS && (listData->filter == NULL || celix_filter_match(listData->filter, properties))) {
+        listData->status = celix_arrayList_addString(listData->pids, pid);
+    }
+}
+
+celix_status_t celix_configAdmin_listConfigurations(void* handle, const char* filter, celix_array_list_t** pids) {
+    celix_config_admin_t* admin = handle;
+    *pids = NULL;
+    celix_autoptr(celix_filter_t) configFilter = NULL;
+    if (filter != NULL) {
+        configFilter = celix_filter_create(filter);
+        if (configFilter == NULL) {
+            celix_logHelper_logTssErrors(admin->logHelper, CELIX_LOG_LEVEL_ERROR);
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+    }
+    celix_autoptr(celix_array_list_t) result = celix_arrayList_createStringArray();
+    if (result == NULL) {
+        return CELIX_ENOMEM;
+    }
+    celix_config_admin_list_data_t data = {configFilter, result, CELIX_SUCCESS};
+    celixThreadMutex_lock(&admin->mutex);
+    celix_configStore_forEach(admin->store, &data, celix_configAdmin_addMatchingPid);
+    celixThreadMutex_unlock(&admin->mutex);
+    if (data.status == CELIX_SUCCESS) {
+        *pids = celix_steal_ptr(result);
+    }
+    return data.status;
+}
+
+void celix_configAdmin_getStoreStatistics(celix_config_admin_t* admin, celix_config_store_statistics_t* stats) {
+    celix_auto(celix_mutex_lock_guard_t) lockGuard = celixMutexLockGuard_init(&admin->mutex);
+    celix_configStore_getStatistics(admin->store, stats);
+}
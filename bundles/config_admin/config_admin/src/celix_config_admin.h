@@ -0,0 +1,60 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_CONFIG_ADMIN_H
+#define CELIX_CONFIG_ADMIN_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdbool.h>
+
+#include "celix_bundle_context.h"
+#include "celix_properties.h"
+#include "celix_array_list.h"
+#include "celix_errno.h"
+#include "celix_config_store.h"
+
+typedef struct celix_config_admin celix_config_admin_t;
+
+celix_config_admin_t* celix_configAdmin_create(celix_bundle_context_t* ctx);
+
+void celix_configAdmin_destroy(celix_config_admin_t* admin);
+
+int celix_configAdmin_start(celix_config_admin_t* admin);
+int celix_configAdmin_stop(celix_config_admin_t* admin);
+
+int celix_configAdmin_addManagedServiceWithProperties(void* handle, void* svc, const celix_properties_t* props);
+int celix_configAdmin_addManagedServiceFactoryWithProperties(void* handle, void* svc, const celix_properties_t* props);
+int celix_configAdmin_removeManagedServiceWithProperties(void* handle, void* svc, const celix_properties_t* props);
+
+celix_status_t celix_configAdmin_getConfiguration(void* handle, const char* pid, celix_properties_t** properties);
+celix_status_t celix_configAdmin_updateConfiguration(void* handle, const char* pid, const celix_properties_t* properties);
+celix_status_t celix_configAdmin_createFactoryConfiguration(void* handle, const char* factoryPid, const celix_properties_t* properties, char** pid);
+celix_status_t celix_configAdmin_deleteConfiguration(void* handle, const char* pid);
+celix_status_t celix_configAdmin_listConfigurations(void* handle, const char* filter, celix_array_list_t** pids);
+
+/**
+ * @brief Get the statistics of the configuration store.
+ */
+void celix_configAdmin_getStoreStatistics(celix_config_admin_t* admin, celix_config_store_statistics_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //CELIX_CONFIG_ADMIN_H
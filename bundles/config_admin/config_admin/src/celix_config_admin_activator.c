@@ -0,0 +1,118 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <assert.h>
+
+#include "celix_bundle_activator.h"
+#include "celix_dm_component.h"
+#include "celix_dm_service_dependency.h"
+#include "celix_config_admin.h"
+#include "celix_configuration_admin_service.h"
+#include "celix_managed_service.h"
+#include "celix_managed_service_factory.h"
+
+typedef struct celix_config_admin_activator {
+    celix_config_admin_t* configAdmin;
+    celix_configuration_admin_service_t configAdminService;
+} celix_config_admin_activator_t;
+
+celix_status_t celix_configAdminActivator_start(celix_config_admin_activator_t* act, celix_bundle_context_t* ctx) {
+    assert(act != NULL);
+    assert(ctx != NULL);
+    celix_status_t status = CELIX_SUCCESS;
+    celix_autoptr(celix_dm_component_t) adminCmp = celix_dmComponent_create(ctx, "CONFIG_ADMIN_CMP");
+    if (adminCmp == NULL) {
+        return CELIX_ENOMEM;
+    }
+
+    act->configAdmin = celix_configAdmin_create(ctx);
+    if (act->configAdmin == NULL) {
+        return CELIX_BUNDLE_EXCEPTION;
+    }
+    celix_dmComponent_setImplementation(adminCmp, act->configAdmin);
+    CELIX_DM_COMPONENT_SET_CALLBACKS(adminCmp, celix_config_admin_t, NULL, celix_configAdmin_start, celix_configAdmin_stop, NULL);
+    CELIX_DM_COMPONENT_SET_IMPLEMENTATION_DESTROY_FUNCTION(adminCmp, celix_config_admin_t, celix_configAdmin_destroy);
+
+    {
+        celix_autoptr(celix_dm_service_dependency_t) managedServiceDep = celix_dmServiceDependency_create();
+        if (managedServiceDep == NULL) {
+            return CELIX_ENOMEM;
+        }
+        status = celix_dmServiceDependency_setService(managedServiceDep, CELIX_MANAGED_SERVICE_NAME, CELIX_MANAGED_SERVICE_USE_RANGE, "("CELIX_CONFIGURATION_SERVICE_PID"=*)");
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        celix_dmServiceDependency_setStrategy(managedServiceDep, DM_SERVICE_DEPENDENCY_STRATEGY_LOCKING);
+        celix_dm_service_dependency_callback_options_t opts = CELIX_EMPTY_DM_SERVICE_DEPENDENCY_CALLBACK_OPTIONS;
+        opts.addWithProps = celix_configAdmin_addManagedServiceWithProperties;
+        opts.removeWithProps = celix_configAdmin_removeManagedServiceWithProperties;
+        celix_dmServiceDependency_setCallbacksWithOptions(managedServiceDep, &opts);
+        status = celix_dmComponent_addServiceDependency(adminCmp, managedServiceDep);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        celix_steal_ptr(managedServiceDep);
+    }
+
+    {
+        celix_autoptr(celix_dm_service_dependency_t) factoryDep = celix_dmServiceDependency_create();
+        if (factoryDep == NULL) {
+            return CELIX_ENOMEM;
+        }
+        status = celix_dmServiceDependency_setService(factoryDep, CELIX_MANAGED_SERVICE_FACTORY_NAME, CELIX_MANAGED_SERVICE_FACTORY_USE_RANGE, "("CELIX_CONFIGURATION_SERVICE_FACTORY_PID"=*)");
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        celix_dmServiceDependency_setStrategy(factoryDep, DM_SERVICE_DEPENDENCY_STRATEGY_LOCKING);
+        celix_dm_service_dependency_callback_options_t opts = CELIX_EMPTY_DM_SERVICE_DEPENDENCY_CALLBACK_OPTIONS;
+        opts.addWithProps = celix_configAdmin_addManagedServiceFactoryWithProperties;
+        opts.removeWithProps = celix_configAdmin_removeManagedServiceWithProperties;
+        celix_dmServiceDependency_setCallbacksWithOptions(factoryDep, &opts);
+        status = celix_dmComponent_addServiceDependency(adminCmp, factoryDep);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        celix_steal_ptr(factoryDep);
+    }
+
+    act->configAdminService.handle = act->configAdmin;
+    act->configAdminService.getConfiguration = celix_configAdmin_getConfiguration;
+    act->configAdminService.updateConfiguration = celix_configAdmin_updateConfiguration;
+    act->configAdminService.createFactoryConfiguration = celix_configAdmin_createFactoryConfiguration;
+    act->configAdminService.deleteConfiguration = celix_configAdmin_deleteConfiguration;
+    act->configAdminService.listConfigurations = celix_configAdmin_listConfigurations;
+    status = celix_dmComponent_addInterface(adminCmp, CELIX_CONFIGURATION_ADMIN_SERVICE_NAME, CELIX_CONFIGURATION_ADMIN_SERVICE_VERSION, &act->configAdminService, NULL);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+
+    celix_dependency_manager_t* mng = celix_bundleContext_getDependencyManager(ctx);
+    if (mng == NULL) {
+        return CELIX_ENOMEM;
+    }
+    status = celix_dependencyManager_addAsync(mng, adminCmp);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    celix_steal_ptr(adminCmp);
+
+    return status;
+}
+
+CELIX_GEN_BUNDLE_ACTIVATOR(celix_config_admin_activator_t, celix_configAdminActivator_start, NULL)
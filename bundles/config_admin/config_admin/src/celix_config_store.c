@@ -0,0 +1,584 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_config_store.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "celix_file_utils.h"
+#include "celix_string_hash_map.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_utils.h"
+
+#define CELIX_CONFIG_STORE_WAL_FILE "config.wal"
+#define CELIX_CONFIG_STORE_SNAPSHOT_FILE "config.snapshot"
+#define CELIX_CONFIG_STORE_SNAPSHOT_TMP_FILE "config.snapshot.tmp"
+#define CELIX_CONFIG_STORE_RECORD_MAGIC 0x31474643U //"CFG1"
+
+typedef enum celix_config_store_record_type {
+    CELIX_CONFIG_STORE_RECORD_PUT = 1,
+    CELIX_CONFIG_STORE_RECORD_REMOVE = 2,
+} celix_config_store_record_type_e;
+
+/**
+ * @brief The header of a store record, followed by the pid, the factory pid and the JSON encoded properties.
+ * The crc covers the record after the crc field.
+ */
+typedef struct celix_config_store_record_header {
+    uint32_t magic;
+    uint32_t crc;
+    uint32_t type;
+    uint32_t pidLen;
+    uint32_t factoryPidLen;
+    uint32_t dataLen;
+} celix_config_store_record_header_t;
+
+#define CELIX_CONFIG_STORE_CRC_OFFSET (offsetof(celix_config_store_record_header_t, crc) + sizeof(uint32_t))
+
+typedef struct celix_config_store_entry {
+    char* pid;
+    char* factoryPid;
+    celix_properties_t* properties;
+    size_t recordSize;
+} celix_config_store_entry_t;
+
+struct celix_config_store {
+    celix_log_helper_t* logHelper;
+    celix_config_store_options_t opts;
+    char* dir;
+    char* walPath;
+    char* snapshotPath;
+    char* snapshotTmpPath;
+    int walFd;
+    size_t walSize;
+    size_t liveSize;
+    size_t unsyncedRecords;
+    unsigned long appendedRecords;
+    unsigned long syncs;
+    unsigned long compactions;
+    celix_string_hash_map_t* entries; //key: pid, value: celix_config_store_entry_t*
+    celix_string_hash_map_t* factoryIndex; //key: factory pid, value: celix_array_list_t* of pids
+};
+
+static uint32_t celix_configStore_crc32(uint32_t crc, const void* data, size_t len) {
+    const uint8_t* p = data;
+    crc = ~crc;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= p[i];
+        for (int k = 0; k < 8; ++k) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+static void celix_configStore_destroyEntry(void* data) {
+    celix_config_store_entry_t* entry = data;
+    if (entry != NULL) {
+        free(entry->pid);
+        free(entry->factoryPid);
+        celix_properties_destroy(entry->properties);
+        free(entry);
+    }
+}
+
+static void celix_configStore_destroyPidList(void* data) {
+    celix_arrayList_destroy(data);
+}
+
+static void celix_configStore_free(celix_config_store_t* store) {
+    if (store->walFd >= 0) {
+        close(store->walFd);
+    }
+    celix_stringHashMap_destroy(store->factoryIndex);
+    celix_stringHashMap_destroy(store->entries);
+    free(store->snapshotTmpPath);
+    free(store->snapshotPath);
+    free(store->walPath);
+    free(store->dir);
+    free(store);
+}
+
+static celix_status_t celix_configStore_addToFactoryIndex(celix_config_store_t* store, const char* factoryPid, const char* pid) {
+    celix_array_list_t* pids = celix_stringHashMap_get(store->factoryIndex, factoryPid);
+    if (pids == NULL) {
+        celix_autoptr(celix_array_list_t) newPids = celix_arrayList_createStringArray();
+        if (newPids == NULL) {
+            return CELIX_ENOMEM;
+        }
+        celix_status_t status = celix_stringHashMap_put(store->factoryIndex, factoryPid, newPids);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        pids = celix_steal_ptr(newPids);
+    }
+    return celix_arrayList_addString(pids, pid);
+}
+
+static void celix_configStore_removeFromFactoryIndex(celix_config_store_t* store, const char* factoryPid, const char* pid) {
+    celix_array_list_t* pids = celix_stringHashMap_get(store->factoryIndex, factoryPid);
+    if (pids != NULL) {
+        celix_arrayList_removeString(pids, pid);
+        if (celix_arrayList_size(pids) == 0) {
+            celix_stringHashMap_remove(store->factoryIndex, factoryPid);
+        }
+    }
+}
+
+static celix_status_t celix_configStore_applyPut(celix_config_store_t* store, const char* pid, const char* factoryPid, celix_properties_t* properties, size_t recordSize) {
+    celix_autofree celix_config_store_entry_t* entry = calloc(1, sizeof(*entry));
+    if (entry == NULL) {
+        celix_properties_destroy(properties);
+        return CELIX_ENOMEM;
+    }
+    entry->properties = properties;
+    entry->recordSize = recordSize;
+    entry->pid = celix_utils_strdup(pid);
+    entry->factoryPid = factoryPid == NULL ? NULL : celix_utils_strdup(factoryPid);
+    if (entry->pid == NULL || (factoryPid != NULL && entry->factoryPid == NULL)) {
+        celix_configStore_destroyEntry(celix_steal_ptr(entry));
+        return CELIX_ENOMEM;
+    }
+
+    const celix_config_store_entry_t* existing = celix_stringHashMap_get(store->entries, pid);
+    const char* oldFactoryPid = existing == NULL ? NULL : existing->factoryPid;
+    bool factoryPidChanged = celix_utils_stringEquals(oldFactoryPid, factoryPid) == false;
+    size_t oldRecordSize = existing == NULL ? 0 : existing->recordSize;
+    celix_autofree char* oldFactoryPidCopy = NULL;
+    if (factoryPidChanged && oldFactoryPid != NULL) {
+        oldFactoryPidCopy = celix_utils_strdup(oldFactoryPid);
+        if (oldFactoryPidCopy == NULL) {
+            celix_configStore_destroyEntry(celix_steal_ptr(entry));
+            return CELIX_ENOMEM;
+        }
+    }
+
+    if (factoryPidChanged && factoryPid != NULL) {
+        celix_status_t status = celix_configStore_addToFactoryIndex(store, factoryPid, pid);
+        if (status != CELIX_SUCCESS) {
+            celix_configStore_destroyEntry(celix_steal_ptr(entry));
+            return status;
+        }
+    }
+    celix_status_t status = celix_stringHashMap_put(store->entries, pid, entry);
+    if (status != CELIX_SUCCESS) {
+        if (factoryPidChanged && factoryPid != NULL) {
+            celix_configStore_removeFromFactoryIndex(store, factoryPid, pid);
+        }
+        celix_configStore_destroyEntry(celix_steal_ptr(entry));
+        return status;
+    }
+    celix_steal_ptr(entry); //note replaced entry is destroyed by the entries map
+    if (oldFactoryPidCopy != NULL) {
+        celix_configStore_removeFromFactoryIndex(store, oldFactoryPidCopy, pid);
+    }
+    store->liveSize = store->liveSize - oldRecordSize + recordSize;
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_configStore_applyRemove(celix_config_store_t* store, const char* pid) {
+    const celix_config_store_entry_t* entry = celix_stringHashMap_get(store->entries, pid);
+    if (entry == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (entry->factoryPid != NULL) {
+        celix_configStore_removeFromFactoryIndex(store, entry->factoryPid, pid);
+    }
+    store->liveSize -= entry->recordSize;
+    celix_stringHashMap_remove(store->entries, pid);
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_configStore_encodeRecord(celix_config_store_t* store, celix_config_store_record_type_e type, const char* pid, const char* factoryPid, const celix_properties_t* properties, char** recordOut, size_t* sizeOut) {
+    celix_autofree char* record = NULL;
+    size_t size = 0;
+    FILE* stream = open_memstream(&record, &size);
+    if (stream == NULL) {
+        celix_logHelper_error(store->logHelper, "Cannot open memory stream to encode configuration %s.", pid);
+        return CELIX_ENOMEM;
+    }
+
+    celix_config_store_record_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = CELIX_CONFIG_STORE_RECORD_MAGIC;
+    header.type = (uint32_t)type;
+    header.pidLen = (uint32_t)strlen(pid);
+    header.factoryPidLen = factoryPid == NULL ? 0 : (uint32_t)strlen(factoryPid);
+    fwrite(&header, sizeof(header), 1, stream);
+    fwrite(pid, 1, header.pidLen, stream);
+    if (factoryPid != NULL) {
+        fwrite(factoryPid, 1, header.factoryPidLen, stream);
+    }
+    celix_status_t status = CELIX_SUCCESS;
+    if (properties != NULL) {
+        status = celix_properties_encodeToStream(properties, stream, 0);
+    }
+    bool writeError = ferror(stream) != 0;
+    fclose(stream);
+    if (status != CELIX_SUCCESS || writeError) {
+        celix_logHelper_logTssErrors(store->logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(store->logHelper, "Cannot encode configuration %s.", pid);
+        return status != CELIX_SUCCESS ? status : CELIX_ENOMEM;
+    }
+
+    header.dataLen = (uint32_t)(size - sizeof(header) - header.pidLen - header.factoryPidLen);
+    header.crc = celix_configStore_crc32(0, (const char*)&header + CELIX_CONFIG_STORE_CRC_OFFSET, sizeof(header) - CELIX_CONFIG_STORE_CRC_OFFSET);
+    header.crc = celix_configStore_crc32(header.crc, record + sizeof(header), size - sizeof(header));
+    memcpy(record, &header, sizeof(header));
+    *recordOut = celix_steal_ptr(record);
+    *sizeOut = size;
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_configStore_append(celix_config_store_t* store, const char* record, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        ssize_t rc = write(store->walFd, record + written, size - written);
+        if (rc < 0 && errno == EINTR) {
+            continue;
+        } else if (rc < 0) {
+            celix_logHelper_error(store->logHelper, "Cannot append to %s: %s.", store->walPath, strerror(errno));
+            if (written > 0 && ftruncate(store->walFd, (off_t)store->walSize) != 0) {
+                celix_logHelper_error(store->logHelper, "Cannot discard partial record of %s: %s.", store->walPath, strerror(errno));
+            }
+            return CELIX_FILE_IO_EXCEPTION;
+        }
+        written += (size_t)rc;
+    }
+    store->walSize += size;
+    store->unsyncedRecords += 1;
+    store->appendedRecords += 1;
+    return CELIX_SUCCESS;
+}
+
+static void celix_configStore_afterAppend(celix_config_store_t* store) {
+    if (store->opts.syncBatchSize > 0 && store->unsyncedRecords >= store->opts.syncBatchSize) {
+        (void)celix_configStore_sync(store); //note on failure, the sync is retried with the next batch
+    }
+    if (store->walSize >= store->opts.compactMinWalSize && store->walSize > 2 * store->liveSize) {
+        (void)celix_configStore_compact(store); //note on failure, the write-ahead log is still valid
+    }
+}
+
+/**
+ * @brief Replay the records of a memory mapped store file. Replaying stops at the first invalid record.
+ */
+static celix_status_t celix_configStore_replay(celix_config_store_t* store, const char* path, int fd, size_t fileSize, size_t* validSize) {
+    *validSize = 0;
+    if (fileSize == 0) {
+        return CELIX_SUCCESS;
+    }
+    void* mapped = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        celix_logHelper_error(store->logHelper, "Cannot mmap %s: %s.", path, strerror(errno));
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+
+    const char* data = mapped;
+    size_t offset = 0;
+    celix_status_t status = CELIX_SUCCESS;
+    while (status == CELIX_SUCCESS && fileSize - offset >= sizeof(celix_config_store_record_header_t)) {
+        celix_config_store_record_header_t header;
+        memcpy(&header, data + offset, sizeof(header));
+        uint64_t recordSize = sizeof(header) + (uint64_t)header.pidLen + header.factoryPidLen + header.dataLen;
+        if (header.magic != CELIX_CONFIG_STORE_RECORD_MAGIC || header.pidLen == 0 || recordSize > fileSize - offset) {
+            break;
+        }
+        uint32_t crc = celix_configStore_crc32(0, data + offset + CELIX_CONFIG_STORE_CRC_OFFSET, recordSize - CELIX_CONFIG_STORE_CRC_OFFSET);
+        if (crc != header.crc) {
+            break;
+        }
+
+        const char* pidData = data + offset + sizeof(header);
+        celix_autofree char* pid = strndup(pidData, header.pidLen);
+        celix_autofree char* factoryPid = header.factoryPidLen == 0 ? NULL : strndup(pidData + header.pidLen, header.factoryPidLen);
+        if (pid == NULL || (header.factoryPidLen > 0 && factoryPid == NULL)) {
+            status = CELIX_ENOMEM;
+            break;
+        }
+        if (header.type == CELIX_CONFIG_STORE_RECORD_PUT && header.dataLen > 0) {
+            celix_properties_t* properties = NULL;
+            celix_status_t decodeStatus = celix_properties_decodeFromBuffer(pidData + header.pidLen + header.factoryPidLen,
+                                                                            header.dataLen, 0, &properties);
+            if (decodeStatus == CELIX_SUCCESS) {
+                status = celix_configStore_applyPut(store, pid, factoryPid, properties, (size_t)recordSize);
+            } else {
+                celix_logHelper_logTssErrors(store->logHelper, CELIX_LOG_LEVEL_WARNING);
+                celix_logHelper_warning(store->logHelper, "Skipping undecodable configuration %s in %s.", pid, path);
+            }
+        } else if (header.type == CELIX_CONFIG_STORE_RECORD_REMOVE) {
+            (void)celix_configStore_applyRemove(store, pid);
+        }
+        offset += (size_t)recordSize;
+    }
+    munmap(mapped, fileSize);
+    *validSize = offset;
+    return status;
+}
+
+static celix_status_t celix_configStore_load(celix_config_store_t* store) {
+    struct stat st;
+    int snapshotFd = open(store->snapshotPath, O_RDONLY | O_CLOEXEC);
+    if (snapshotFd >= 0) {
+        size_t validSize = 0;
+        celix_status_t status = fstat(snapshotFd, &st) == 0 ? CELIX_SUCCESS : CELIX_FILE_IO_EXCEPTION;
+        status = CELIX_DO_IF(status, celix_configStore_replay(store, store->snapshotPath, snapshotFd, (size_t)st.st_size, &validSize));
+        close(snapshotFd);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        if (validSize != (size_t)st.st_size) {
+            celix_logHelper_warning(store->logHelper, "Ignoring %zu corrupt bytes at the end of %s.", (size_t)st.st_size - validSize, store->snapshotPath);
+        }
+    } else if (errno != ENOENT) {
+        celix_logHelper_error(store->logHelper, "Cannot open %s: %s.", store->snapshotPath, strerror(errno));
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+    (void)unlink(store->snapshotTmpPath); //note leftover of an interrupted compaction
+
+    store->walFd = open(store->walPath, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (store->walFd < 0 || fstat(store->walFd, &st) != 0) {
+        celix_logHelper_error(store->logHelper, "Cannot open %s: %s.", store->walPath, strerror(errno));
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+    size_t validSize = 0;
+    celix_status_t status = celix_configStore_replay(store, store->walPath, store->walFd, (size_t)st.st_size, &validSize);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    if (validSize != (size_t)st.st_size) {
+        celix_logHelper_warning(store->logHelper, "Discarding %zu bytes of torn or corrupt records at the end of %s.", (size_t)st.st_size - validSize, store->walPath);
+        if (ftruncate(store->walFd, (off_t)validSize) != 0 || fsync(store->walFd) != 0) {
+            celix_logHelper_error(store->logHelper, "Cannot truncate %s: %s.", store->walPath, strerror(errno));
+            return CELIX_FILE_IO_EXCEPTION;
+        }
+    }
+    store->walSize = validSize;
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_configStore_create(celix_log_helper_t* logHelper, const char* dir, const celix_config_store_options_t* opts, celix_config_store_t** out) {
+    celix_config_store_t* store = calloc(1, sizeof(*store));
+    if (store == NULL) {
+        celix_logHelper_error(logHelper, "Cannot allocate configuration store.");
+        return CELIX_ENOMEM;
+    }
+    store->logHelper = logHelper;
+    store->walFd = -1;
+    store->opts.syncBatchSize = opts == NULL ? CELIX_CONFIG_STORE_DEFAULT_SYNC_BATCH_SIZE : opts->syncBatchSize;
+    store->opts.compactMinWalSize = opts == NULL ? CELIX_CONFIG_STORE_DEFAULT_COMPACT_MIN_WAL_SIZE : opts->compactMinWalSize;
+
+    celix_string_hash_map_create_options_t entriesOpts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    entriesOpts.simpleRemovedCallback = celix_configStore_destroyEntry;
+    store->entries = celix_stringHashMap_createWithOptions(&entriesOpts);
+    celix_string_hash_map_create_options_t indexOpts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    indexOpts.simpleRemovedCallback = celix_configStore_destroyPidList;
+    store->factoryIndex = celix_stringHashMap_createWithOptions(&indexOpts);
+    store->dir = celix_utils_strdup(dir);
+    if (store->entries == NULL || store->factoryIndex == NULL || store->dir == NULL ||
+        asprintf(&store->walPath, "%s/%s", dir, CELIX_CONFIG_STORE_WAL_FILE) < 0 ||
+        asprintf(&store->snapshotPath, "%s/%s", dir, CELIX_CONFIG_STORE_SNAPSHOT_FILE) < 0 ||
+        asprintf(&store->snapshotTmpPath, "%s/%s", dir, CELIX_CONFIG_STORE_SNAPSHOT_TMP_FILE) < 0) {
+        celix_logHelper_error(logHelper, "Cannot allocate configuration store.");
+        celix_configStore_free(store);
+        return CELIX_ENOMEM;
+    }
+
+    const char* error = NULL;
+    celix_status_t status = celix_utils_createDirectory(dir, false, &error);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Cannot create configuration store dir %s: %s.", dir, error);
+        celix_configStore_free(store);
+        return status;
+    }
+    status = celix_configStore_load(store);
+    if (status != CELIX_SUCCESS) {
+        celix_configStore_free(store);
+        return status;
+    }
+    *out = store;
+    return CELIX_SUCCESS;
+}
+
+void celix_configStore_destroy(celix_config_store_t* store) {
+    if (store != NULL) {
+        (void)celix_configStore_sync(store);
+        celix_configStore_free(store);
+    }
+}
+
+celix_status_t celix_configStore_put(celix_config_store_t* store, const char* pid, const char* factoryPid, celix_properties_t* props) {
+    celix_autoptr(celix_properties_t) properties = props;
+    if (pid == NULL || pid[0] == '\0' || properties == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_autofree char* record = NULL;
+    size_t size = 0;
+    celix_status_t status = celix_configStore_encodeRecord(store, CELIX_CONFIG_STORE_RECORD_PUT, pid, factoryPid, properties, &record, &size);
+    status = CELIX_DO_IF(status, celix_configStore_append(store, record, size));
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    status = celix_configStore_applyPut(store, pid, factoryPid, celix_steal_ptr(properties), size);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(store->logHelper, "Cannot apply stored configuration %s.", pid);
+        return status;
+    }
+    celix_configStore_afterAppend(store);
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_configStore_remove(celix_config_store_t* store, const char* pid) {
+    if (pid == NULL || !celix_stringHashMap_hasKey(store->entries, pid)) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_autofree char* record = NULL;
+    size_t size = 0;
+    celix_status_t status = celix_configStore_encodeRecord(store, CELIX_CONFIG_STORE_RECORD_REMOVE, pid, NULL, NULL, &record, &size);
+    status = CELIX_DO_IF(status, celix_configStore_append(store, record, size));
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    (void)celix_configStore_applyRemove(store, pid);
+    celix_configStore_afterAppend(store);
+    return CELIX_SUCCESS;
+}
+
+const celix_properties_t* celix_configStore_get(const celix_config_store_t* store, const char* pid) {
+    const celix_config_store_entry_t* entry = celix_stringHashMap_get(store->entries, pid);
+    return entry == NULL ? NULL : entry->properties;
+}
+
+const char* celix_configStore_getFactoryPid(const celix_config_store_t* store, const char* pid) {
+    const celix_config_store_entry_t* entry = celix_stringHashMap_get(store->entries, pid);
+    return entry == NULL ? NULL : entry->factoryPid;
+}
+
+const celix_array_list_t* celix_configStore_getFactoryConfigurations(const celix_config_store_t* store, const char* factoryPid) {
+    return celix_stringHashMap_get(store->factoryIndex, factoryPid);
+}
+
+size_t celix_configStore_size(const celix_config_store_t* store) {
+    return celix_stringHashMap_size(store->entries);
+}
+
+void celix_configStore_forEach(const celix_config_store_t* store, void* data, void (*callback)(void* data, const char* pid, const celix_properties_t* properties)) {
+    CELIX_STRING_HASH_MAP_ITERATE(store->entries, iter) {
+        const celix_config_store_entry_t* entry = iter.value.ptrValue;
+        callback(data, entry->pid, entry->properties);
+    }
+}
+
+bool celix_configStore_needsSync(const celix_config_store_t* store) {
+    return store->unsyncedRecords > 0;
+}
+
+celix_status_t celix_configStore_sync(celix_config_store_t* store) {
+    if (store->unsyncedRecords == 0) {
+        return CELIX_SUCCESS;
+    }
+    if (fsync(store->walFd) != 0) {
+        celix_logHelper_error(store->logHelper, "Cannot fsync %s: %s.", store->walPath, strerror(errno));
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+    store->unsyncedRecords = 0;
+    store->syncs += 1;
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_configStore_writeSnapshot(celix_config_store_t* store) {
+    FILE* snapshot = fopen(store->snapshotTmpPath, "w");
+    if (snapshot == NULL) {
+        celix_logHelper_error(store->logHelper, "Cannot create %s: %s.", store->snapshotTmpPath, strerror(errno));
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+    celix_status_t status = CELIX_SUCCESS;
+    size_t liveSize = 0;
+    CELIX_STRING_HASH_MAP_ITERATE(store->entries, iter) {
+        celix_config_store_entry_t* entry = iter.value.ptrValue;
+        celix_autofree char* record = NULL;
+        size_t size = 0;
+        status = celix_configStore_encodeRecord(store, CELIX_CONFIG_STORE_RECORD_PUT, entry->pid, entry->factoryPid, entry->properties, &record, &size);
+        if (status != CELIX_SUCCESS) {
+            break;
+        }
+        if (fwrite(record, 1, size, snapshot) != size) {
+            status = CELIX_FILE_IO_EXCEPTION;
+            break;
+        }
+        entry->recordSize = size;
+        liveSize += size;
+    }
+    if (status == CELIX_SUCCESS && (fflush(snapshot) != 0 || fsync(fileno(snapshot)) != 0)) {
+        status = CELIX_FILE_IO_EXCEPTION;
+    }
+    if (fclose(snapshot) != 0) {
+        status = CELIX_FILE_IO_EXCEPTION;
+    }
+    if (status == CELIX_SUCCESS && rename(store->snapshotTmpPath, store->snapshotPath) != 0) {
+        status = CELIX_FILE_IO_EXCEPTION;
+    }
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(store->logHelper, "Cannot write snapshot %s: %s.", store->snapshotPath, strerror(errno));
+        (void)unlink(store->snapshotTmpPath);
+        return status;
+    }
+    store->liveSize = liveSize;
+
+    //note fsync the dir, so that the rename is durable before the write-ahead log is truncated
+    int dirFd = open(store->dir, O_RDONLY | O_CLOEXEC);
+    if (dirFd >= 0) {
+        (void)fsync(dirFd);
+        close(dirFd);
+    }
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_configStore_compact(celix_config_store_t* store) {
+    celix_status_t status = celix_configStore_writeSnapshot(store);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    //note if the truncate fails, replaying the write-ahead log on top of the new snapshot results in the same state
+    if (ftruncate(store->walFd, 0) != 0 || fsync(store->walFd) != 0) {
+        celix_logHelper_error(store->logHelper, "Cannot truncate %s: %s.", store->walPath, strerror(errno));
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+    store->walSize = 0;
+    store->unsyncedRecords = 0;
+    store->compactions += 1;
+    return CELIX_SUCCESS;
+}
+
+void celix_configStore_getStatistics(const celix_config_store_t* store, celix_config_store_statistics_t* stats) {
+    stats->walSize = store->walSize;
+    stats->liveSize = store->liveSize;
+    stats->unsyncedRecords = store->unsyncedRecords;
+    stats->appendedRecords = store->appendedRecords;
+    stats->syncs = store->syncs;
+    stats->compactions = store->compactions;
+}
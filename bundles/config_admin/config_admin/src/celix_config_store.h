@@ -0,0 +1,161 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_CONFIG_STORE_H
+#define CELIX_CONFIG_STORE_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "celix_properties.h"
+#include "celix_array_list.h"
+#include "celix_log_helper.h"
+#include "celix_cleanup.h"
+#include "celix_errno.h"
+
+#define CELIX_CONFIG_STORE_DEFAULT_SYNC_BATCH_SIZE 256
+#define CELIX_CONFIG_STORE_DEFAULT_COMPACT_MIN_WAL_SIZE (1024 * 1024)
+
+/**
+ * @brief A persistent configuration store, indexed on PID and factory PID.
+ *
+ * Every put and remove is appended as a checksummed record to a write-ahead log (config.wal), so an update costs a
+ * single append instead of a file rewrite. The write-ahead log is fsynced in batches: when syncBatchSize records are
+ * not yet synced or when celix_configStore_sync is called. If the write-ahead log grows beyond compactMinWalSize and
+ * is more than twice the size of the live configurations, the live configurations are written to a new snapshot
+ * (config.snapshot, replaced atomically) and the write-ahead log is truncated.
+ *
+ * On creation the snapshot and write-ahead log are memory mapped and replayed. A torn or corrupt tail of the
+ * write-ahead log (e.g. due to a crash during an append) is discarded.
+ *
+ * @note Not thread safe.
+ */
+typedef struct celix_config_store celix_config_store_t;
+
+typedef struct celix_config_store_options {
+    size_t syncBatchSize; //nr of unsynced records after which the write-ahead log is fsynced, 0 disables batch syncing
+    size_t compactMinWalSize; //min size in bytes of the write-ahead log before it is compacted
+} celix_config_store_options_t;
+
+/**
+ * @brief The statistics of a configuration store.
+ */
+typedef struct celix_config_store_statistics {
+    size_t walSize; //current size of the write-ahead log in bytes
+    size_t liveSize; //size in bytes of the records of the live configurations
+    size_t unsyncedRecords; //nr of appended records which are not fsynced yet
+    unsigned long appendedRecords; //total nr of records appended to the write-ahead log
+    unsigned long syncs; //total nr of write-ahead log fsyncs
+    unsigned long compactions; //total nr of compactions
+} celix_config_store_statistics_t;
+
+/**
+ * @brief Create a configuration store in the provided directory and load the stored configurations.
+ * @param[in] logHelper The log helper to log errors with.
+ * @param[in] dir The store directory. Created if it does not exist.
+ * @param[in] opts The store options. If NULL, the defaults are used.
+ * @param[out] store The created store.
+ * @return CELIX_SUCCESS, CELIX_ENOMEM or CELIX_FILE_IO_EXCEPTION.
+ */
+celix_status_t celix_configStore_create(celix_log_helper_t* logHelper, const char* dir, const celix_config_store_options_t* opts, celix_config_store_t** store);
+
+/**
+ * @brief Sync and destroy the configuration store.
+ */
+void celix_configStore_destroy(celix_config_store_t* store);
+
+CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(celix_config_store_t, celix_configStore_destroy)
+
+/**
+ * @brief Put a (factory) configuration in the store.
+ *
+ * The store takes ownership of the properties, also if an error is returned.
+ *
+ * @param[in] store The store.
+ * @param[in] pid The PID of the configuration.
+ * @param[in] factoryPid The factory PID of the configuration or NULL for a non-factory configuration.
+ * @param[in] properties The configuration properties.
+ * @return CELIX_SUCCESS, CELIX_ENOMEM, CELIX_ILLEGAL_ARGUMENT if the properties cannot be encoded or
+ * CELIX_FILE_IO_EXCEPTION if the record could not be appended. On error the store is not changed.
+ */
+celix_status_t celix_configStore_put(celix_config_store_t* store, const char* pid, const char* factoryPid, celix_properties_t* properties);
+
+/**
+ * @brief Remove a configuration from the store.
+ * @return CELIX_SUCCESS, CELIX_ILLEGAL_ARGUMENT if no configuration exists for the pid, CELIX_ENOMEM or
+ * CELIX_FILE_IO_EXCEPTION.
+ */
+celix_status_t celix_configStore_remove(celix_config_store_t* store, const char* pid);
+
+/**
+ * @brief Get the configuration properties for a PID or NULL if no configuration exists for the PID.
+ * The returned properties are valid until the next put or remove of the PID.
+ */
+const celix_properties_t* celix_configStore_get(const celix_config_store_t* store, const char* pid);
+
+/**
+ * @brief Get the factory PID of a configuration or NULL if the configuration does not exist or is not a factory
+ * configuration.
+ */
+const char* celix_configStore_getFactoryPid(const celix_config_store_t* store, const char* pid);
+
+/**
+ * @brief Get the PIDs of the configurations of a factory PID as a string array list or NULL if the factory PID has
+ * no configurations. The returned list is valid until the next put or remove.
+ */
+const celix_array_list_t* celix_configStore_getFactoryConfigurations(const celix_config_store_t* store, const char* factoryPid);
+
+/**
+ * @brief Returns the nr of configurations in the store.
+ */
+size_t celix_configStore_size(const celix_config_store_t* store);
+
+/**
+ * @brief Call the provided callback for every configuration in the store.
+ */
+void celix_configStore_forEach(const celix_config_store_t* store, void* data, void (*callback)(void* data, const char* pid, const celix_properties_t* properties));
+
+/**
+ * @brief Returns whether there are appended records which are not fsynced yet.
+ */
+bool celix_configStore_needsSync(const celix_config_store_t* store);
+
+/**
+ * @brief Fsync the appended records of the write-ahead log.
+ * @return CELIX_SUCCESS or CELIX_FILE_IO_EXCEPTION.
+ */
+celix_status_t celix_configStore_sync(celix_config_store_t* store);
+
+/**
+ * @brief Write the live configurations to a new snapshot and truncate the write-ahead log.
+ * @return CELIX_SUCCESS, CELIX_ENOMEM or CELIX_FILE_IO_EXCEPTION.
+ */
+celix_status_t celix_configStore_compact(celix_config_store_t* store);
+
+/**
+ * @brief Get the statistics of the store.
+ */
+void celix_configStore_getStatistics(const celix_config_store_t* store, celix_config_store_statistics_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //CELIX_CONFIG_STORE_H
@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_CONFIGURATION_ADMIN_SERVICE_H
+#define CELIX_CONFIGURATION_ADMIN_SERVICE_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "celix_properties.h"
+#include "celix_array_list.h"
+#include "celix_errno.h"
+
+/**
+ * @brief The Configuration Admin service name
+ */
+#define CELIX_CONFIGURATION_ADMIN_SERVICE_NAME "celix_configuration_admin"
+
+/**
+ * @brief The Configuration Admin service version
+ */
+#define CELIX_CONFIGURATION_ADMIN_SERVICE_VERSION "1.0.0"
+#define CELIX_CONFIGURATION_ADMIN_SERVICE_USE_RANGE "[1.0.0,2)"
+
+/**
+ * @brief The configuration property containing the persistent identity (PID) of a configuration.
+ */
+#define CELIX_CONFIGURATION_SERVICE_PID "service.pid"
+
+/**
+ * @brief The configuration property containing the factory PID of a factory configuration.
+ */
+#define CELIX_CONFIGURATION_SERVICE_FACTORY_PID "service.factoryPid"
+
+/**
+ * @brief The Configuration Admin service.
+ *
+ * Configurations are stored persistently and are delivered to the managed services (celix_managed_service_t) and
+ * managed service factories (celix_managed_service_factory_t) with a matching PID or factory PID.
+ *
+ * Delivery is asynchronous and coalesced: if a configuration is updated multiple times before the managed service is
+ * called, the managed service is only called with the latest configuration.
+ *
+ * @see https://docs.osgi.org/specification/osgi.cmpn/7.0.0/service.cm.html
+ */
+typedef struct celix_configuration_admin_service {
+    void* handle;
+
+    /**
+     * @brief Get a copy of the configuration properties for the provided PID.
+     * @param[in] handle The handle as provided by the service registration.
+     * @param[in] pid The PID of the configuration.
+     * @param[out] properties A copy of the configuration properties or NULL if no configuration exists for the PID.
+     *                        The caller is owner of the properties.
+     * @return CELIX_SUCCESS if no errors are encountered, ENOMEM if the properties could not be copied.
+     */
+    celix_status_t (*getConfiguration)(void* handle, const char* pid, celix_properties_t** properties);
+
+    /**
+     * @brief Create or update the configuration for the provided PID.
+     *
+     * The CELIX_CONFIGURATION_SERVICE_PID (and for factory configurations CELIX_CONFIGURATION_SERVICE_FACTORY_PID)
+     * properties are set by the Configuration Admin.
+     *
+     * @param[in] handle The handle as provided by the service registration.
+     * @param[in] pid The PID of the configuration.
+     * @param[in] properties The new configuration properties. The properties are copied.
+     * @return CELIX_SUCCESS if no errors are encountered, CELIX_ILLEGAL_ARGUMENT if the pid or properties are invalid,
+     * CELIX_FILE_IO_EXCEPTION if the configuration could not be stored and ENOMEM if there is not enough memory.
+     */
+    celix_status_t (*updateConfiguration)(void* handle, const char* pid, const celix_properties_t* properties);
+
+    /**
+     * @brief Create a new factory configuration for the provided factory PID.
+     * @param[in] handle The handle as provided by the service registration.
+     * @param[in] factoryPid The factory PID.
+     * @param[in] properties The configuration properties. The properties are copied.
+     * @param[out] pid The generated PID of the new configuration. The caller is owner of the pid.
+     * @return CELIX_SUCCESS if no errors are encountered, CELIX_ILLEGAL_ARGUMENT if the factory pid or properties are
+     * invalid, CELIX_FILE_IO_EXCEPTION if the configuration could not be stored and ENOMEM if there is not enough memory.
+     */
+    celix_status_t (*createFactoryConfiguration)(void* handle, const char* factoryPid, const celix_properties_t* properties, char** pid);
+
+    /**
+     * @brief Delete the configuration for the provided PID.
+     * @param[in] handle The handle as provided by the service registration.
+     * @param[in] pid The PID of the configuration.
+     * @return CELIX_SUCCESS if no errors are encountered, CELIX_ILLEGAL_ARGUMENT if no configuration exists for the PID
+     * and CELIX_FILE_IO_EXCEPTION if the deletion could not be stored.
+     */
+    celix_status_t (*deleteConfiguration)(void* handle, const char* pid);
+
+    /**
+     * @brief List the PIDs of the configurations matching the provided filter.
+     * @param[in] handle The handle as provided by the service registration.
+     * @param[in] filter The filter to match the configuration properties against. If NULL all configurations match.
+     * @param[out] pids A string array list with the matching PIDs. The caller is owner of the list.
+     * @return CELIX_SUCCESS if no errors are encountered, CELIX_ILLEGAL_ARGUMENT if the filter is invalid and ENOMEM if
+     * there is not enough memory.
+     */
+    celix_status_t (*listConfigurations)(void* handle, const char* filter, celix_array_list_t** pids);
+} celix_configuration_admin_service_t;
+
+#ifdef __cplusplus
+}
+#endif
+#endif //CELIX_CONFIGURATION_ADMIN_SERVICE_H
@@ -0,0 +1,65 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_MANAGED_SERVICE_H
+#define CELIX_MANAGED_SERVICE_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "celix_properties.h"
+#include "celix_errno.h"
+
+/**
+ * @brief The Managed Service service name
+ *
+ * A managed service must be registered with the CELIX_CONFIGURATION_SERVICE_PID service property.
+ */
+#define CELIX_MANAGED_SERVICE_NAME "celix_managed_service"
+
+/**
+ * @brief The Managed Service service version
+ */
+#define CELIX_MANAGED_SERVICE_VERSION "1.0.0"
+#define CELIX_MANAGED_SERVICE_USE_RANGE "[1.0.0,2)"
+
+/**
+ * @brief A service that can receive the configuration for its PID from the Configuration Admin.
+ * @see https://docs.osgi.org/specification/osgi.cmpn/7.0.0/service.cm.html#org.osgi.service.cm.ManagedService
+ */
+typedef struct celix_managed_service {
+    void* handle;
+
+    /**
+     * @brief Update the configuration of the managed service.
+     *
+     * Called from a Configuration Admin thread when the managed service is added and every time the configuration
+     * for the PID is updated or deleted. Updates which are superseded before the call are not delivered.
+     *
+     * @param[in] handle The handle as provided by the service registration.
+     * @param[in] properties The configuration properties or NULL if there is no configuration for the PID.
+     *                       The properties are only valid during the call.
+     * @return CELIX_SUCCESS if the configuration is accepted.
+     */
+    celix_status_t (*updated)(void* handle, const celix_properties_t* properties);
+} celix_managed_service_t;
+
+#ifdef __cplusplus
+}
+#endif
+#endif //CELIX_MANAGED_SERVICE_H
@@ -0,0 +1,73 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_MANAGED_SERVICE_FACTORY_H
+#define CELIX_MANAGED_SERVICE_FACTORY_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "celix_properties.h"
+#include "celix_errno.h"
+
+/**
+ * @brief The Managed Service Factory service name
+ *
+ * A managed service factory must be registered with the CELIX_CONFIGURATION_SERVICE_FACTORY_PID service property.
+ */
+#define CELIX_MANAGED_SERVICE_FACTORY_NAME "celix_managed_service_factory"
+
+/**
+ * @brief The Managed Service Factory service version
+ */
+#define CELIX_MANAGED_SERVICE_FACTORY_VERSION "1.0.0"
+#define CELIX_MANAGED_SERVICE_FACTORY_USE_RANGE "[1.0.0,2)"
+
+/**
+ * @brief A service that can receive the factory configurations for its factory PID from the Configuration Admin.
+ * @see https://docs.osgi.org/specification/osgi.cmpn/7.0.0/service.cm.html#org.osgi.service.cm.ManagedServiceFactory
+ */
+typedef struct celix_managed_service_factory {
+    void* handle;
+
+    /**
+     * @brief Create or update the factory configuration with the provided PID.
+     *
+     * Called from a Configuration Admin thread for every existing factory configuration when the managed service
+     * factory is added and every time a factory configuration is created or updated. Updates which are superseded
+     * before the call are not delivered.
+     *
+     * @param[in] handle The handle as provided by the service registration.
+     * @param[in] pid The PID of the factory configuration.
+     * @param[in] properties The configuration properties. The properties are only valid during the call.
+     * @return CELIX_SUCCESS if the configuration is accepted.
+     */
+    celix_status_t (*updated)(void* handle, const char* pid, const celix_properties_t* properties);
+
+    /**
+     * @brief Called when the factory configuration with the provided PID is deleted.
+     * @param[in] handle The handle as provided by the service registration.
+     * @param[in] pid The PID of the deleted factory configuration.
+     */
+    void (*deleted)(void* handle, const char* pid);
+} celix_managed_service_factory_t;
+
+#ifdef __cplusplus
+}
+#endif
+#endif //CELIX_MANAGED_SERVICE_FACTORY_H
@@ -16,22 +16,6 @@
  * specific language governing permissions and limitations
  * under the License.
  */
-/**
- * framework_patch.h
- *
- *  \date       Aug 12, 2013
- *  \author    	<a href="mailto:dev@celix.apache.org">Apache Celix Project Team</a>
- *  \copyright	Apache License, Version 2.0
- */
-
-#ifndef BUNDLE_PATCH_H_
-#define BUNDLE_PATCH_H_
-
-/* celix.framework.public */
-#include "celix_errno.h"
-#include "bundle.h"
-#include "service_reference.h"
-
-celix_status_t bundle_getBundleLocation(bundle_pt bundle, const char **location);
+#include <benchmark/benchmark.h>
 
-#endif /* BUNDLE_PATCH_H_ */
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,181 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "celix_bundle_context.h"
+#include "celix_constants.h"
+#include "celix_event_admin.h"
+#include "celix_event_constants.h"
+#include "celix_event_handler_service.h"
+#include "celix_framework_factory.h"
+
+#ifdef __GLIBC__
+/**
+ * Counts the heap allocations of the process by interposing malloc, calloc and realloc.
+ * Used to report the number of allocations per posted event.
+ */
+static std::atomic<size_t> allocCount{0};
+
+extern "C" {
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t nmemb, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) {
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t nmemb, size_t size) {
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(nmemb, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+}
+
+static size_t getAllocCount() {
+    return allocCount.load(std::memory_order_relaxed);
+}
+#else
+static size_t getAllocCount() {
+    return 0;
+}
+#endif
+
+/**
+ * Benchmark to measure the time and the number of heap allocations needed to post or send an event to a
+ * event handler.
+ */
+class EventAdminBenchmark {
+public:
+    static constexpr const char* const TOPIC = "org/celix/benchmark";
+    static constexpr long MAX_PENDING_EVENTS = 256;
+
+    EventAdminBenchmark() {
+        auto* props = celix_properties_create();
+        celix_properties_set(props, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
+        celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, ".event_admin_benchmark_cache");
+        celix_properties_set(props, "CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "error");
+        fw = std::shared_ptr<celix_framework_t>{celix_frameworkFactory_createFramework(props),
+                                                [](celix_framework_t* f) { celix_frameworkFactory_destroyFramework(f); }};
+        ea = celix_eventAdmin_create(celix_framework_getFrameworkContext(fw.get()));
+        celix_eventAdmin_start(ea);
+
+        handler.handle = this;
+        handler.handleEvent = [](void* handle, const char*, const celix_properties_t*) {
+            auto* benchmark = static_cast<EventAdminBenchmark*>(handle);
+            benchmark->handledEvents.fetch_add(1, std::memory_order_release);
+            return CELIX_SUCCESS;
+        };
+        handlerProps = celix_properties_create();
+        celix_properties_set(handlerProps, CELIX_EVENT_TOPIC, TOPIC);
+        celix_properties_setLong(handlerProps, CELIX_FRAMEWORK_SERVICE_ID, 42);
+        celix_eventAdmin_addEventHandlerWithProperties(ea, &handler, handlerProps);
+    }
+
+    ~EventAdminBenchmark() {
+        celix_eventAdmin_removeEventHandlerWithProperties(ea, &handler, handlerProps);
+        celix_properties_destroy(handlerProps);
+        celix_eventAdmin_stop(ea);
+        celix_eventAdmin_destroy(ea);
+    }
+
+    void waitForHandledEvents(long nrOfEvents, long maxPending) {
+        while (nrOfEvents - handledEvents.load(std::memory_order_acquire) > maxPending) {
+            std::this_thread::yield();
+        }
+    }
+
+    std::shared_ptr<celix_framework_t> fw{};
+    celix_event_admin_t* ea{nullptr};
+    celix_event_handler_service_t handler{};
+    celix_properties_t* handlerProps{nullptr};
+    std::atomic<long> handledEvents{0};
+};
+
+static celix_properties_t* createEventProperties(int nrOfEntries) {
+    auto* props = celix_properties_create();
+    for (int i = 0; i < nrOfEntries; ++i) {
+        celix_properties_setLong(props, ("key" + std::to_string(i)).c_str(), i);
+    }
+    return props;
+}
+
+static void postEventTest(benchmark::State& state, bool freezeProperties) {
+    EventAdminBenchmark benchmark{};
+    celix_autoptr(celix_properties_t) props = createEventProperties((int)state.range(0));
+    if (freezeProperties) {
+        celix_properties_freeze(props);
+    }
+
+    long posted = 0;
+    size_t allocs = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        size_t startAllocs = getAllocCount();
+        celix_eventAdmin_postEvent(benchmark.ea, EventAdminBenchmark::TOPIC, props);
+        allocs += getAllocCount() - startAllocs;
+        ++posted;
+        benchmark.waitForHandledEvents(posted, EventAdminBenchmark::MAX_PENDING_EVENTS);
+    }
+    benchmark.waitForHandledEvents(posted, 0);
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["allocs/event"] = benchmark::Counter((double)allocs / (double)state.iterations());
+}
+
+static void EventAdminBenchmark_postEventWithMutableProperties(benchmark::State& state) {
+    postEventTest(state, false);
+}
+
+static void EventAdminBenchmark_postEventWithFrozenProperties(benchmark::State& state) {
+    postEventTest(state, true);
+}
+
+static void EventAdminBenchmark_sendEvent(benchmark::State& state) {
+    EventAdminBenchmark benchmark{};
+    celix_autoptr(celix_properties_t) props = createEventProperties((int)state.range(0));
+
+    size_t allocs = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        size_t startAllocs = getAllocCount();
+        celix_eventAdmin_sendEvent(benchmark.ea, EventAdminBenchmark::TOPIC, props);
+        allocs += getAllocCount() - startAllocs;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["allocs/event"] = benchmark::Counter((double)allocs / (double)state.iterations());
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMicrosecond)
+
+CELIX_BENCHMARK(EventAdminBenchmark_postEventWithMutableProperties)->RangeMultiplier(4)->Range(1, 64);
+CELIX_BENCHMARK(EventAdminBenchmark_postEventWithFrozenProperties)->RangeMultiplier(4)->Range(1, 64);
+CELIX_BENCHMARK(EventAdminBenchmark_sendEvent)->RangeMultiplier(4)->Range(1, 64);
@@ -23,6 +23,7 @@
 #include "celix_framework_factory.h"
 #include "celix_dm_component_ei.h"
 #include "celix_bundle_context_ei.h"
+#include "celix_properties_ei.h"
 #include "malloc_ei.h"
 #include <gtest/gtest.h>
 
@@ -46,6 +47,7 @@ public:
         celix_ei_expect_celix_dmComponent_addServiceDependency(nullptr, 0, 0);
         celix_ei_expect_celix_dmComponent_addInterface(nullptr, 0, 0);
         celix_ei_expect_celix_dependencyManager_addAsync(nullptr, 0, 0);
+        celix_ei_expect_celix_properties_create(nullptr, 0, nullptr);
     }
 
     void TestEventAdminActivator(void (testBody)(void *act, celix_bundle_context_t *ctx)) {
@@ -111,6 +113,30 @@ TEST_F(CelixEventAdminActTestSuite, FailedToAddEventAdminServiceToComponentTest)
     });
 }
 
+TEST_F(CelixEventAdminActTestSuite, FailedToCreateShellCommandPropertiesTest) {
+    TestEventAdminActivator([](void *act, celix_bundle_context_t *ctx) {
+        celix_ei_expect_celix_properties_create((void*)&celix_bundleActivator_start, 1, nullptr);
+        auto status = celix_bundleActivator_start(act, ctx);
+        ASSERT_EQ(CELIX_ENOMEM, status);
+    });
+}
+
+TEST_F(CelixEventAdminActTestSuite, FailedToCreateMetricsProviderPropertiesTest) {
+    TestEventAdminActivator([](void *act, celix_bundle_context_t *ctx) {
+        celix_ei_expect_celix_properties_create((void*)&celix_bundleActivator_start, 1, nullptr, 2);
+        auto status = celix_bundleActivator_start(act, ctx);
+        ASSERT_EQ(CELIX_ENOMEM, status);
+    });
+}
+
+TEST_F(CelixEventAdminActTestSuite, FailedToAddMetricsProviderServiceToComponentTest) {
+    TestEventAdminActivator([](void *act, celix_bundle_context_t *ctx) {
+        celix_ei_expect_celix_dmComponent_addInterface((void*)&celix_bundleActivator_start, 1, CELIX_ENOMEM, 3);
+        auto status = celix_bundleActivator_start(act, ctx);
+        ASSERT_EQ(CELIX_ENOMEM, status);
+    });
+}
+
 TEST_F(CelixEventAdminActTestSuite, FailedToCreateEventAdapterComponentTest) {
     TestEventAdminActivator([](void *act, celix_bundle_context_t *ctx) {
         celix_ei_expect_celix_dmComponent_create((void*)&celix_bundleActivator_start, 1, nullptr, 2);
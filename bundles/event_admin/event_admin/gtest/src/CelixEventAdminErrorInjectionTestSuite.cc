@@ -38,7 +38,7 @@ public:
     ~CelixEventAdminErrorInjectionTestSuite() override {
         celix_ei_expect_calloc(nullptr, 0, nullptr);
         celix_ei_expect_celix_logHelper_create(nullptr, 0, nullptr);
-        celix_ei_expect_celixThreadRwlock_create(nullptr, 0, 0);
+        celix_ei_expect_celixThreadRbRwlock_create(nullptr, 0, 0);
         celix_ei_expect_celixThreadMutex_create(nullptr, 0, 0);
         celix_ei_expect_celixThreadCondition_init(nullptr, 0, 0);
         celix_ei_expect_celix_arrayList_create(nullptr, 0, nullptr);
@@ -51,6 +51,7 @@ public:
         celix_ei_expect_celix_arrayList_addLong(nullptr, 0, 0);
         celix_ei_expect_celix_elapsedtime(nullptr, 0, 0);
         celix_ei_expect_celix_arrayList_createWithOptions(nullptr, 0, nullptr);
+        celix_ei_expect_celix_stringHashMap_createWithOptions(nullptr, 0, nullptr);
     }
 };
 
@@ -90,7 +91,7 @@ TEST_F(CelixEventAdminErrorInjectionTestSuite, FailedToCreateLogHelperForEventAd
 }
 
 TEST_F(CelixEventAdminErrorInjectionTestSuite, FailedToCreateLockForEventAdminTest) {
-    celix_ei_expect_celixThreadRwlock_create((void*)&celix_eventAdmin_create, 0, CELIX_ENOMEM);
+    celix_ei_expect_celixThreadRbRwlock_create((void*)&celix_eventAdmin_create, 0, CELIX_ENOMEM);
     auto ea = celix_eventAdmin_create(ctx.get());
     EXPECT_EQ(nullptr, ea);
 }
@@ -137,6 +138,18 @@ TEST_F(CelixEventAdminErrorInjectionTestSuite, FailedToCreateAsyncEventQueueForE
     EXPECT_EQ(nullptr, ea);
 }
 
+TEST_F(CelixEventAdminErrorInjectionTestSuite, FailedToCreateLowerPriorityAsyncEventQueueForEventAdminTest) {
+    celix_ei_expect_celix_arrayList_createWithOptions((void*)&celix_eventAdmin_create, 0, nullptr, 2);
+    auto ea = celix_eventAdmin_create(ctx.get());
+    EXPECT_EQ(nullptr, ea);
+}
+
+TEST_F(CelixEventAdminErrorInjectionTestSuite, FailedToCreateTopicStatisticsForEventAdminTest) {
+    celix_ei_expect_celix_stringHashMap_createWithOptions((void*)&celix_eventAdmin_create, 0, nullptr);
+    auto ea = celix_eventAdmin_create(ctx.get());
+    EXPECT_EQ(nullptr, ea);
+}
+
 
 TEST_F(CelixEventAdminErrorInjectionTestSuite, FailedToAllocMemoryForEventHandlerTest) {
     TestAddEventHandler([](void *handle, void *svc, const celix_properties_t *props) {
@@ -339,4 +352,21 @@ TEST_F(CelixEventAdminErrorInjectionTestSuite, PostEventToBlacklistHandlerTest)
         EXPECT_STRNE("org/celix/test1", topic);
         return CELIX_SUCCESS;
     });
-}
\ No newline at end of file
+}
+
+TEST_F(CelixEventAdminErrorInjectionTestSuite, FailedToAddTopicStatisticsTest) {
+    TestPublishEvent("org/celix/test", nullptr, [](celix_event_admin_t *ea) {
+        celix_ei_expect_celix_stringHashMap_put((void*)&celix_eventAdmin_postEvent, 3, CELIX_ENOMEM);
+        auto status = celix_eventAdmin_postEvent(ea, "org/celix/test", nullptr);
+        EXPECT_EQ(CELIX_SUCCESS, status);//event is delivered without statistics
+
+        celix_event_admin_topic_statistics_t stats{};
+        status = celix_eventAdmin_getTopicStatistics(ea, "org/celix/test", &stats);
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+    }, [](void *handle, const char *topic, const celix_properties_t *props) {
+        (void)handle;
+        (void)props;
+        EXPECT_STREQ("org/celix/test", topic);
+        return CELIX_SUCCESS;
+    });
+}
@@ -19,6 +19,11 @@
 #include <unistd.h>
 #include <semaphore.h>
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "CelixEventAdminTestSuiteBaseClass.h"
@@ -679,4 +684,162 @@ TEST_F(CelixEventAdminTestSuite, RemoveEventHandlerAfterEventAdminStopTest) {
     celix_eventAdmin_destroy(ea);
 
 
-}
\ No newline at end of file
+}
+
+TEST_F(CelixEventAdminTestSuite, AsyncEventQueueFullOfLowerPriorityTest) {
+    g_blockingHandlerCalled = true;
+    TestPublishEvent("org/celix/test", nullptr, [](celix_event_admin_t *ea) {
+        auto status = celix_eventAdmin_postEvent(ea, "org/celix/test", nullptr);//blocks the event handler
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        usleep(30000);
+        for (int i = 0; i < 512; ++i) {
+            status = celix_eventAdmin_postEvent(ea, "org/celix/test", nullptr);
+            EXPECT_EQ(CELIX_SUCCESS, status);
+        }
+        status = celix_eventAdmin_postEvent(ea, "org/celix/test", nullptr);
+        EXPECT_EQ(CELIX_ILLEGAL_STATE, status);
+
+        auto props = celix_properties_create();
+        celix_properties_setLong(props, CELIX_EVENT_PRIORITY, CELIX_EVENT_PRIORITY_HIGH);
+        status = celix_eventAdmin_postEvent(ea, "org/celix/test", props);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        celix_properties_destroy(props);
+
+        celix_event_admin_topic_statistics_t stats{};
+        status = celix_eventAdmin_getTopicStatistics(ea, "org/celix/test", &stats);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        EXPECT_EQ(1, stats.droppedEvents);
+        EXPECT_EQ(513, stats.queuedEvents);
+        g_blockingHandlerCalled = false;
+    }, [](void *handle, const char *topic, const celix_properties_t *props) {
+        (void)handle;
+        (void)props;
+        (void)topic;
+        while (g_blockingHandlerCalled) usleep(1000);
+        return CELIX_SUCCESS;
+    });
+}
+
+static std::vector<long> g_handledEventIds{};
+TEST_F(CelixEventAdminTestSuite, PostEventWithPriorityTest) {
+    g_blockingHandlerCalled = true;
+    g_handledEventIds.clear();
+    TestPublishEvent("org/celix/test", nullptr, [](celix_event_admin_t *ea) {
+        auto status = celix_eventAdmin_postEvent(ea, "org/celix/test", nullptr);//blocks the event handler
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        usleep(30000);
+        long priorities[] = {CELIX_EVENT_PRIORITY_LOW, CELIX_EVENT_PRIORITY_NORMAL, CELIX_EVENT_PRIORITY_HIGH, 100, -100};
+        for (long priority : priorities) {
+            auto props = celix_properties_create();
+            celix_properties_setLong(props, CELIX_EVENT_PRIORITY, priority);
+            celix_properties_setLong(props, "id", priority);
+            status = celix_eventAdmin_postEvent(ea, "org/celix/test", props);
+            EXPECT_EQ(CELIX_SUCCESS, status);
+            celix_properties_destroy(props);
+        }
+        g_blockingHandlerCalled = false;
+        for (int i = 0; i < 6; ++i) {
+            EXPECT_TRUE(WaitForEventDone(30));
+        }
+        std::vector<long> expected{-1, CELIX_EVENT_PRIORITY_HIGH, 100, CELIX_EVENT_PRIORITY_NORMAL, CELIX_EVENT_PRIORITY_LOW, -100};
+        EXPECT_EQ(expected, g_handledEventIds);
+    }, [](void *handle, const char *topic, const celix_properties_t *props) {
+        (void)handle;
+        (void)topic;
+        while (g_blockingHandlerCalled) usleep(1000);
+        g_handledEventIds.push_back(celix_properties_getAsLong(props, "id", -1));
+        HandleEventDone();
+        return CELIX_SUCCESS;
+    });
+}
+
+TEST_F(CelixEventAdminTestSuite, PostEventWithExpiredDeadlineTest) {
+    g_blockingHandlerCalled = true;
+    TestPublishEvent("org/celix/*", nullptr, [](celix_event_admin_t *ea) {
+        auto status = celix_eventAdmin_postEvent(ea, "org/celix/blocking", nullptr);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        usleep(30000);
+        auto props = celix_properties_create();
+        celix_properties_setLong(props, CELIX_EVENT_DEADLINE, 1);
+        status = celix_eventAdmin_postEvent(ea, "org/celix/expired", props);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        celix_properties_setLong(props, CELIX_EVENT_DEADLINE, 30000);
+        status = celix_eventAdmin_postEvent(ea, "org/celix/test", props);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        celix_properties_destroy(props);
+        usleep(10000);
+        g_blockingHandlerCalled = false;
+        EXPECT_TRUE(WaitForEventDone(30));
+
+        celix_event_admin_topic_statistics_t stats{};
+        status = celix_eventAdmin_getTopicStatistics(ea, "org/celix/expired", &stats);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        EXPECT_EQ(1, stats.expiredEvents);
+        EXPECT_EQ(0, stats.deliveredEvents);
+        EXPECT_EQ(0, stats.queuedEvents);
+    }, [](void *handle, const char *topic, const celix_properties_t *props) {
+        (void)handle;
+        (void)props;
+        EXPECT_STRNE("org/celix/expired", topic);
+        while (g_blockingHandlerCalled) usleep(1000);
+        if (strcmp(topic, "org/celix/test") == 0) {
+            HandleEventDone();
+        }
+        return CELIX_SUCCESS;
+    });
+}
+
+TEST_F(CelixEventAdminTestSuite, TopicStatisticsTest) {
+    TestPublishEvent("org/celix/test", nullptr, [](celix_event_admin_t *ea) {
+        celix_event_admin_topic_statistics_t stats{};
+        auto status = celix_eventAdmin_getTopicStatistics(ea, "org/celix/test", &stats);
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+
+        status = celix_eventAdmin_sendEvent(ea, "org/celix/test", nullptr);//sync delivery is not accounted
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        EXPECT_TRUE(WaitForEventDone(30));
+        for (int i = 0; i < 3; ++i) {
+            status = celix_eventAdmin_postEvent(ea, "org/celix/test", nullptr);
+            EXPECT_EQ(CELIX_SUCCESS, status);
+        }
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_TRUE(WaitForEventDone(30));
+        }
+
+        status = celix_eventAdmin_getTopicStatistics(ea, "org/celix/test", &stats);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        EXPECT_EQ(0, stats.queuedEvents);
+        EXPECT_LE(1, stats.maxQueuedEvents);
+        EXPECT_EQ(3, stats.deliveredEvents);
+        EXPECT_EQ(0, stats.droppedEvents);
+        EXPECT_EQ(0, stats.expiredEvents);
+        EXPECT_LE(stats.maxDeliveryLatency, stats.totalDeliveryLatency);
+
+        char* output = nullptr;
+        size_t outputSize = 0;
+        FILE* outStream = open_memstream(&output, &outputSize);
+        EXPECT_TRUE(celix_eventAdmin_executeCommand(ea, "celix::event_admin_stats", outStream, stderr));
+        fclose(outStream);
+        EXPECT_TRUE(strstr(output, "org/celix/test") != nullptr) << output;
+        free(output);
+
+        std::map<std::string, double> metrics{};
+        status = celix_eventAdmin_collectMetrics(ea, &metrics, [](void* handle, const celix_metric_t* metric) {
+            auto* map = static_cast<std::map<std::string, double>*>(handle);
+            auto key = std::string{metric->name} + "{" + (metric->labels ? metric->labels : "") + "}";
+            (*map)[key] = metric->type == CELIX_METRIC_TYPE_HISTOGRAM ? (double)metric->histogram->count : metric->value;
+        });
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        EXPECT_EQ(1, metrics["celix_event_admin_sync_deliveries_total{}"]);
+        EXPECT_EQ(3, metrics["celix_event_admin_async_delivery_latency_seconds{}"]);
+        EXPECT_EQ(3, metrics["celix_event_admin_async_deliveries_total{topic=\"org/celix/test\"}"]);
+        EXPECT_EQ(0, metrics["celix_event_admin_queued_events{topic=\"org/celix/test\"}"]);
+        EXPECT_EQ(0, metrics["celix_event_admin_dropped_events_total{topic=\"org/celix/test\"}"]);
+    }, [](void *handle, const char *topic, const celix_properties_t *props) {
+        (void)handle;
+        (void)props;
+        EXPECT_STREQ("org/celix/test", topic);
+        HandleEventDone();
+        return CELIX_SUCCESS;
+    });
+}
@@ -27,17 +27,17 @@ public:
     CelixEventErrorInjectionTestSuite() = default;
 
     ~CelixEventErrorInjectionTestSuite() override {
-        celix_ei_expect_celix_properties_copy(nullptr, 0, nullptr);
+        celix_ei_expect_celix_properties_share(nullptr, 0, nullptr);
         celix_ei_expect_calloc(nullptr, 0, nullptr);
         celix_ei_expect_celix_utils_strdup(nullptr, 0, nullptr);
     }
 };
 
-TEST_F(CelixEventErrorInjectionTestSuite, FailedToCopyEventPropertiesTest) {
+TEST_F(CelixEventErrorInjectionTestSuite, FailedToShareEventPropertiesTest) {
     std::unique_ptr<celix_properties_t, decltype(&celix_properties_destroy)> properties{celix_properties_create(),
                                                                                         celix_properties_destroy};
     celix_properties_set(properties.get(), "key", "value");
-    celix_ei_expect_celix_properties_copy((void*)&celix_event_create, 0, nullptr);
+    celix_ei_expect_celix_properties_share((void*)&celix_event_create, 0, nullptr);
     celix_event_t *event = celix_event_create("test_topic", properties.get());
     EXPECT_TRUE(event == nullptr);
 }
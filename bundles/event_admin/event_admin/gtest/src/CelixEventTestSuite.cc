@@ -43,3 +43,29 @@ TEST_F(CelixEventTestSuite, CreateEventWithoutPropertiesTest) {
     EXPECT_TRUE(celix_event_getProperties(event) == nullptr);
     celix_event_release(event);
 }
+
+TEST_F(CelixEventTestSuite, CreateEventWithFrozenPropertiesTest) {
+    std::unique_ptr<celix_properties_t, decltype(&celix_properties_destroy)> properties{celix_properties_create(), celix_properties_destroy};
+    celix_properties_set(properties.get(), "key", "value");
+    celix_properties_freeze(properties.get());
+    celix_event_t *event = celix_event_create("test_topic", properties.get());
+    EXPECT_TRUE(event != nullptr);
+    //frozen properties are shared with the event instead of copied
+    EXPECT_EQ(properties.get(), celix_event_getProperties(event));
+    EXPECT_TRUE(celix_properties_isShared(properties.get()));
+    properties.reset();
+    EXPECT_STREQ("value", celix_properties_get(celix_event_getProperties(event), "key", nullptr));
+    celix_event_release(event);
+}
+
+TEST_F(CelixEventTestSuite, CreateEventWithMutablePropertiesTest) {
+    std::unique_ptr<celix_properties_t, decltype(&celix_properties_destroy)> properties{celix_properties_create(), celix_properties_destroy};
+    celix_properties_set(properties.get(), "key", "value");
+    celix_event_t *event = celix_event_create("test_topic", properties.get());
+    EXPECT_TRUE(event != nullptr);
+    //mutable properties are copied, so that the caller can still modify them
+    EXPECT_NE(properties.get(), celix_event_getProperties(event));
+    celix_properties_set(properties.get(), "key", "value2");
+    EXPECT_STREQ("value", celix_properties_get(celix_event_getProperties(event), "key", nullptr));
+    celix_event_release(event);
+}
@@ -29,31 +29,32 @@
 struct celix_event {
     struct celix_ref ref;
     char* topic;
-    celix_properties_t* properties;
+    const celix_properties_t* properties;
 };
 
 celix_event_t* celix_event_create(const char* topic, const celix_properties_t* properties) {
+    //frozen properties are shared with the event, other properties are copied.
+    //note celix_properties_destroy only releases the reference returned by celix_properties_share
     celix_autoptr(celix_properties_t) props = NULL;
-    if (properties != NULL && (props = celix_properties_copy(properties)) == NULL) {
+    if (properties != NULL && (props = (celix_properties_t*)celix_properties_share(properties)) == NULL) {
         return NULL;
     }
     celix_autofree celix_event_t* event = calloc(1, sizeof(*event));
     if (event == NULL) {
         return NULL;
     }
-    event->properties = props;
     event->topic = celix_utils_strdup(topic);
     if (event->topic == NULL) {
         return NULL;
     }
+    event->properties = celix_steal_ptr(props);
     celix_ref_init(&event->ref);
-    celix_steal_ptr(props);
     return celix_steal_ptr(event);
 }
 
 static bool celix_event_releaseCb(struct celix_ref* ref) {
     celix_event_t* event = (celix_event_t*)ref;
-    celix_properties_destroy(event->properties);
+    celix_properties_release(event->properties);
     free(event->topic);
     free(event);
     return true;
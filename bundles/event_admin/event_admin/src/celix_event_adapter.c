@@ -24,6 +24,7 @@
 #include "celix_condition.h"
 #include "celix_constants.h"
 #include "celix_threads.h"
+#include "celix_lock_profiling.h"
 #include "celix_utils.h"
 #include "celix_stdlib_cleanup.h"
 #include "celix_event_constants.h"
@@ -64,6 +65,7 @@ celix_event_adapter_t* celix_eventAdapter_create(celix_bundle_context_t* ctx) {
         celix_logHelper_error(logHelper, "Error creating rwlock for event adapter");
         return NULL;
     }
+    celix_lockProfiling_setName(&adapter->lock, "celix::event_adapter");
 
     celix_steal_ptr(logHelper);
     return celix_steal_ptr(adapter);
@@ -144,6 +146,8 @@ celix_properties_t* celix_eventAdapter_createServiceEventProperties(const celix_
     if (pid != NULL && celix_properties_set(eventProps, CELIX_EVENT_SERVICE_PID, pid) != CELIX_SUCCESS) {
         return NULL;
     }
+    //frozen, so that the event admin can share the properties instead of copying them
+    celix_properties_freeze(eventProps);
     return celix_steal_ptr(eventProps);
 }
 
@@ -240,6 +244,7 @@ static void celix_eventAdapter_onBundleEvent(void* handle, const celix_bundle_ev
         celix_logHelper_error(adapter->logHelper, "Failed to set bundle version to bundle event.");
         return;
     }
+    celix_properties_freeze(props);
 
     celix_auto(celix_rwlock_rlock_guard_t) rLockGuard = celixRwlockRlockGuard_init(&adapter->lock);
     celix_event_admin_service_t *eventAdminService = adapter->eventAdminService;
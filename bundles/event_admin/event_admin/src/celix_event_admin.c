@@ -31,6 +31,8 @@
 #include "celix_filter.h"
 #include "celix_constants.h"
 #include "celix_threads.h"
+#include "celix_lock_profiling.h"
+#include "celix_metrics.h"
 #include "celix_utils.h"
 #include "celix_stdlib_cleanup.h"
 
@@ -40,7 +42,12 @@
 //Belows parameters are not configurable, consider its configurability until a real need arises.
 #define CELIX_EVENT_ADMIN_MAX_PARALLEL_EVENTS_OF_HANDLER(handlerThNr) ((handlerThNr)/3 + 1) //max parallel async event for a single handler
 #define CELIX_EVENT_ADMIN_MAX_HANDLE_EVENT_TIME 60 //seconds
-#define CELIX_EVENT_ADMIN_MAX_EVENT_QUEUE_SIZE 512 //events
+#define CELIX_EVENT_ADMIN_MAX_EVENT_QUEUE_SIZE 512 //events per priority
+#define CELIX_EVENT_ADMIN_MAX_TOPIC_STATISTICS 1024 //topics, events of further topics are not accounted
+
+#define CELIX_EVENT_ADMIN_PRIORITY_LEVELS (CELIX_EVENT_PRIORITY_HIGH - CELIX_EVENT_PRIORITY_LOW + 1)
+
+#define CELIX_EVENT_HANDLER_REMOVED_FLAG 0x80000000U //set in celix_event_handler_t::useCnt when the handler is removed
 
 typedef struct celix_event_handler {
     celix_event_handler_service_t* service;
@@ -50,6 +57,7 @@ typedef struct celix_event_handler {
     celix_filter_t* eventFilter;
     bool blackListed;//Blacklisted handlers must not be notified of any events.
     unsigned int handlingAsyncEventCnt;
+    unsigned int useCnt;//atomic, number of ongoing deliveries to the handler, which are done without holding the event admin lock
 }celix_event_handler_t;
 
 typedef struct celix_event_channel {
@@ -59,21 +67,29 @@ typedef struct celix_event_channel {
 typedef struct celix_event_entry {
     celix_event_t* event;
     celix_long_hash_map_t* eventHandlers;//key: event handler service id, value: null
+    struct timespec postTime;
+    bool hasDeadline;
+    struct timespec deadline;
+    celix_event_admin_topic_statistics_t* statistics;//can be NULL, owned by celix_event_admin_t::topicStatistics
 }celix_event_entry_t;
 
 struct celix_event_admin {
     celix_bundle_context_t* ctx;
     celix_log_helper_t* logHelper;
     unsigned int handlerThreadNr;
-    celix_thread_rwlock_t lock;//projects: channels,eventHandlers
+    celix_thread_rb_rwlock_t lock;//projects: channels,eventHandlers
     celix_event_channel_t channelMatchingAllEvents;
     celix_string_hash_map_t* channelsMatchingTopic; //key: topic, value: celix_event_channel_t *
     celix_string_hash_map_t* channelsMatchingPrefixTopic;//key:prefix topic, value: celix_event_channel_t *
     celix_long_hash_map_t* eventHandlers;//key: event handler service id, value: celix_event_handler_t*
     celix_thread_mutex_t eventsMutex;// protect belows
     celix_thread_cond_t eventsTriggerCond;
-    celix_array_list_t* asyncEventQueue;//array_list<celix_event_entry_t*>
+    celix_thread_cond_t handlerReleasedCond;//signaled when the last delivery to a removed event handler is done
+    celix_array_list_t* asyncEventQueues[CELIX_EVENT_ADMIN_PRIORITY_LEVELS];//array_list<celix_event_entry_t*>, indexed by event priority
+    celix_string_hash_map_t* topicStatistics;//key: topic, value: celix_event_admin_topic_statistics_t*
     bool threadsRunning;
+    unsigned long syncDeliveredEvents;//atomic, number of sync deliveries of an event to an event handler
+    celix_metrics_histogram_t deliveryLatency;//lock-free, time between posting an event and delivering it to an event handler
     celix_thread_t eventHandlerThreads[CELIX_EVENT_ADMIN_MAX_HANDLER_THREADS];
 };
 
@@ -97,12 +113,13 @@ celix_event_admin_t* celix_eventAdmin_create(celix_bundle_context_t* ctx) {
         celix_logHelper_error(logHelper, "CELIX_EVENT_ADMIN_HANDLER_THREADS is set to %i, but max is %i.", ea->handlerThreadNr, CELIX_EVENT_ADMIN_MAX_HANDLER_THREADS);
         return NULL;
     }
-    celix_status_t status = celixThreadRwlock_create(&ea->lock, NULL);
+    celix_status_t status = celixThreadRbRwlock_create(&ea->lock);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(logHelper, "Failed to create event admin lock.");
         return NULL;
     }
-    celix_autoptr(celix_thread_rwlock_t) lock = &ea->lock;
+    celix_autoptr(celix_thread_rb_rwlock_t) lock = &ea->lock;
+    celix_lockProfiling_setName(&ea->lock, "celix::event_admin");
     celix_autoptr(celix_array_list_t) channelMatchingAllEvents = ea->channelMatchingAllEvents.eventHandlerSvcIdList = celix_arrayList_create();
     if (channelMatchingAllEvents == NULL) {
         celix_logHelper_logTssErrors(logHelper, CELIX_LOG_LEVEL_ERROR);
@@ -134,24 +151,46 @@ celix_event_admin_t* celix_eventAdmin_create(celix_bundle_context_t* ctx) {
         return NULL;
     }
     celix_autoptr(celix_thread_mutex_t) mutex = &ea->eventsMutex;
+    celix_lockProfiling_setName(&ea->eventsMutex, "celix::event_admin::events");
     status = celixThreadCondition_init(&ea->eventsTriggerCond, NULL);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(logHelper, "Failed to create event admin events not empty condition.");
         return NULL;
     }
     celix_autoptr(celix_thread_cond_t) cond = &ea->eventsTriggerCond;
+    status = celixThreadCondition_init(&ea->handlerReleasedCond, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Failed to create event admin handler released condition.");
+        return NULL;
+    }
+    celix_autoptr(celix_thread_cond_t) handlerReleasedCond = &ea->handlerReleasedCond;
+
+    celix_string_hash_map_create_options_t statsOpts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    statsOpts.simpleRemovedCallback = free;
+    celix_autoptr(celix_string_hash_map_t) topicStatistics = ea->topicStatistics = celix_stringHashMap_createWithOptions(&statsOpts);
+    if (topicStatistics == NULL) {
+        celix_logHelper_logTssErrors(logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(logHelper, "Failed to create topic statistics map.");
+        return NULL;
+    }
 
     celix_array_list_create_options_t opts = CELIX_EMPTY_ARRAY_LIST_CREATE_OPTIONS;
     opts.elementType = CELIX_ARRAY_LIST_ELEMENT_TYPE_POINTER;
     opts.simpleRemovedCallback = onAsyncEventQueueRemoved;
-    celix_autoptr(celix_array_list_t) asyncEventQueue = ea->asyncEventQueue = celix_arrayList_createWithOptions(&opts);
-    if (asyncEventQueue == NULL) {
-        celix_logHelper_logTssErrors(logHelper, CELIX_LOG_LEVEL_ERROR);
-        celix_logHelper_error(logHelper, "Failed to create async event queue.");
-        return NULL;
+    for (int i = 0; i < CELIX_EVENT_ADMIN_PRIORITY_LEVELS; ++i) {
+        ea->asyncEventQueues[i] = celix_arrayList_createWithOptions(&opts);
+        if (ea->asyncEventQueues[i] == NULL) {
+            celix_logHelper_logTssErrors(logHelper, CELIX_LOG_LEVEL_ERROR);
+            celix_logHelper_error(logHelper, "Failed to create async event queue.");
+            for (int j = 0; j < i; ++j) {
+                celix_arrayList_destroy(ea->asyncEventQueues[j]);
+            }
+            return NULL;
+        }
     }
 
-    celix_steal_ptr(asyncEventQueue);
+    celix_steal_ptr(topicStatistics);
+    celix_steal_ptr(handlerReleasedCond);
     celix_steal_ptr(cond);
     celix_steal_ptr(mutex);
     celix_steal_ptr(eventHandlers);
@@ -201,7 +240,11 @@ int celix_eventAdmin_stop(celix_event_admin_t* ea) {
 
 void celix_eventAdmin_destroy(celix_event_admin_t* ea) {
     assert(ea != NULL);
-    celix_arrayList_destroy(ea->asyncEventQueue);
+    for (int i = 0; i < CELIX_EVENT_ADMIN_PRIORITY_LEVELS; ++i) {
+        celix_arrayList_destroy(ea->asyncEventQueues[i]);
+    }
+    celix_stringHashMap_destroy(ea->topicStatistics);
+    celixThreadCondition_destroy(&ea->handlerReleasedCond);
     celixThreadCondition_destroy(&ea->eventsTriggerCond);
     celixThreadMutex_destroy(&ea->eventsMutex);
     assert(celix_longHashMap_size(ea->eventHandlers) == 0);
@@ -211,7 +254,7 @@ void celix_eventAdmin_destroy(celix_event_admin_t* ea) {
     assert(celix_stringHashMap_size(ea->channelsMatchingTopic) == 0);
     celix_stringHashMap_destroy(ea->channelsMatchingTopic);
     celix_arrayList_destroy(ea->channelMatchingAllEvents.eventHandlerSvcIdList);
-    celixThreadRwlock_destroy(&ea->lock);
+    celixThreadRbRwlock_destroy(&ea->lock);
     celix_logHelper_destroy(ea->logHelper);
     free(ea);
     return;
@@ -334,6 +377,7 @@ int celix_eventAdmin_addEventHandlerWithProperties(void* handle, void* svc, cons
     handler->eventFilter = NULL;
     handler->blackListed = false;
     handler->handlingAsyncEventCnt = 0;
+    handler->useCnt = 0;
 
     celix_autofree char* topicsCopy = celix_utils_strdup(topics);
     if (topicsCopy == NULL) {
@@ -370,7 +414,7 @@ int celix_eventAdmin_addEventHandlerWithProperties(void* handle, void* svc, cons
         }
     }
 
-    celix_auto(celix_rwlock_wlock_guard_t) wLockGuard = celixRwlockWlockGuard_init(&ea->lock);
+    celix_auto(celix_rb_rwlock_wlock_guard_t) wLockGuard = celixRbRwlockWlockGuard_init(&ea->lock);
     celix_status_t status = celix_longHashMap_put(ea->eventHandlers, handler->serviceId, handler);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_logTssErrors(ea->logHelper, CELIX_LOG_LEVEL_ERROR);
@@ -402,19 +446,50 @@ int celix_eventAdmin_removeEventHandlerWithProperties(void* handle, void* svc, c
         return CELIX_ILLEGAL_ARGUMENT;
     }
 
-    celix_auto(celix_rwlock_wlock_guard_t) wLockGuard = celixRwlockWlockGuard_init(&ea->lock);
-    celix_event_handler_t *handler = celix_longHashMap_get(ea->eventHandlers, serviceId);
-    if (handler != NULL) {
+    celix_event_handler_t *handler = NULL;
+    {
+        celix_auto(celix_rb_rwlock_wlock_guard_t) wLockGuard = celixRbRwlockWlockGuard_init(&ea->lock);
+        handler = celix_longHashMap_get(ea->eventHandlers, serviceId);
+        if (handler == NULL) {
+            return CELIX_SUCCESS;
+        }
         celix_logHelper_debug(ea->logHelper, "Removing event handler(%s)", handler->serviceDescription);
         celix_eventAdmin_unsubscribeTopicFor(ea, handler);
         celix_longHashMap_remove(ea->eventHandlers, serviceId);
-        celix_filter_destroy(handler->eventFilter);
-        free(handler);
+        //no new deliveries can retain the handler, because it is no longer in the event handler map
+        __atomic_fetch_or(&handler->useCnt, CELIX_EVENT_HANDLER_REMOVED_FLAG, __ATOMIC_SEQ_CST);
+    }
+
+    //wait for the ongoing deliveries, the event handler service must not be used after it is removed
+    celixThreadMutex_lock(&ea->eventsMutex);
+    while (__atomic_load_n(&handler->useCnt, __ATOMIC_SEQ_CST) != CELIX_EVENT_HANDLER_REMOVED_FLAG) {
+        celixThreadCondition_wait(&ea->handlerReleasedCond, &ea->eventsMutex);
     }
+    celixThreadMutex_unlock(&ea->eventsMutex);
 
+    celix_filter_destroy(handler->eventFilter);
+    free(handler);
     return CELIX_SUCCESS;
 }
 
+/**
+ * Retains the event handler, so that it can be used without holding the event admin lock.
+ * Must be called with the event admin lock held.
+ */
+static void celix_eventAdmin_retainEventHandler(celix_event_handler_t* eventHandler) {
+    __atomic_add_fetch(&eventHandler->useCnt, 1, __ATOMIC_SEQ_CST);
+}
+
+static void celix_eventAdmin_releaseEventHandler(celix_event_admin_t* ea, celix_event_handler_t* eventHandler) {
+    //note the event handler can be freed as soon as useCnt is decremented, so only the previous value is used.
+    unsigned int useCnt = __atomic_fetch_sub(&eventHandler->useCnt, 1, __ATOMIC_SEQ_CST);
+    if (useCnt == (CELIX_EVENT_HANDLER_REMOVED_FLAG | 1U)) {
+        celixThreadMutex_lock(&ea->eventsMutex);
+        celixThreadCondition_broadcast(&ea->handlerReleasedCond);
+        celixThreadMutex_unlock(&ea->eventsMutex);
+    }
+}
+
 static void celix_eventAdmin_collectEventHandlers(celix_event_admin_t* ea, const char* eventTopic, const celix_properties_t* eventProperties,
                                                   celix_event_channel_t* channel, celix_long_hash_map_t* eventHandlers) {
     if (channel == NULL) {
@@ -457,7 +532,7 @@ static int celix_eventAdmin_deliverEvent(celix_event_admin_t* ea, const char* ev
     }
 
     {
-        celix_auto(celix_rwlock_rlock_guard_t) rLockGuard = celixRwlockRlockGuard_init(&ea->lock);
+        celix_auto(celix_rb_rwlock_rlock_guard_t) rLockGuard = celixRbRwlockRlockGuard_init(&ea->lock);
         // Add all handlers for matching everything
         celix_eventAdmin_collectEventHandlers(ea, eventTopic, eventProperties, &ea->channelMatchingAllEvents, eventHandlers);
 
@@ -517,14 +592,30 @@ static void celix_eventAdmin_deliverEventToHandler(celix_event_admin_t* ea, cons
 
 static int celix_eventAdmin_deliverEventSyncDo(celix_event_admin_t* ea, const char* topic, const celix_properties_t* props,
                                                celix_long_hash_map_t* eventHandlers, bool* stealEventHandlers) {
-    celix_auto(celix_rwlock_rlock_guard_t) rLockGuard = celixRwlockRlockGuard_init(&ea->lock);
-    CELIX_LONG_HASH_MAP_ITERATE(eventHandlers, iter) {
-        celix_event_handler_t* eventHandler = celix_longHashMap_get(ea->eventHandlers, iter.key);
-        if (eventHandler) {
-            celix_eventAdmin_deliverEventToHandler(ea, topic, props, eventHandler);
+    *stealEventHandlers = false;
+    //The handlers are called without holding the event admin lock, so that a handler which (indirectly) waits for
+    //another thread that uses the event admin cannot deadlock with a waiting writer of the event admin lock.
+    celix_autofree celix_event_handler_t** handlers = calloc(celix_longHashMap_size(eventHandlers), sizeof(*handlers));
+    if (handlers == NULL) {
+        celix_logHelper_error(ea->logHelper, "Failed to create event handlers snapshot for topic %s.", topic);
+        return CELIX_ENOMEM;
+    }
+    size_t handlerCnt = 0;
+    {
+        celix_auto(celix_rb_rwlock_rlock_guard_t) rLockGuard = celixRbRwlockRlockGuard_init(&ea->lock);
+        CELIX_LONG_HASH_MAP_ITERATE(eventHandlers, iter) {
+            celix_event_handler_t* eventHandler = celix_longHashMap_get(ea->eventHandlers, iter.key);
+            if (eventHandler) {
+                celix_eventAdmin_retainEventHandler(eventHandler);
+                handlers[handlerCnt++] = eventHandler;
+            }
         }
     }
-    *stealEventHandlers = false;
+    for (size_t i = 0; i < handlerCnt; ++i) {
+        celix_eventAdmin_deliverEventToHandler(ea, topic, props, handlers[i]);
+        __atomic_add_fetch(&ea->syncDeliveredEvents, 1, __ATOMIC_RELAXED);
+        celix_eventAdmin_releaseEventHandler(ea, handlers[i]);
+    }
     return CELIX_SUCCESS;
 }
 
@@ -536,6 +627,24 @@ celix_status_t celix_eventAdmin_sendEvent(void* handle, const char* topic, const
     return celix_eventAdmin_deliverEvent(ea, topic, props, celix_eventAdmin_deliverEventSyncDo);
 }
 
+static celix_event_admin_topic_statistics_t* celix_eventAdmin_getOrCreateTopicStatistics(celix_event_admin_t* ea, const char* topic) {
+    celix_event_admin_topic_statistics_t* stats = celix_stringHashMap_get(ea->topicStatistics, topic);
+    if (stats != NULL || celix_stringHashMap_size(ea->topicStatistics) >= CELIX_EVENT_ADMIN_MAX_TOPIC_STATISTICS) {
+        return stats;
+    }
+    celix_autofree celix_event_admin_topic_statistics_t* newStats = calloc(1, sizeof(*newStats));
+    if (newStats == NULL) {
+        celix_logHelper_warning(ea->logHelper, "Failed to alloc memory for statistics of topic %s.", topic);
+        return NULL;
+    }
+    if (celix_stringHashMap_put(ea->topicStatistics, topic, newStats) != CELIX_SUCCESS) {
+        celix_logHelper_logTssErrors(ea->logHelper, CELIX_LOG_LEVEL_WARNING);
+        celix_logHelper_warning(ea->logHelper, "Failed to add statistics of topic %s.", topic);
+        return NULL;
+    }
+    return celix_steal_ptr(newStats);
+}
+
 static int celix_eventAdmin_deliverEventAsyncDo(celix_event_admin_t* ea, const char* topic, const celix_properties_t* props,
                                                  celix_long_hash_map_t* eventHandlers, bool* stealEventHandlers) {
     celix_autofree celix_event_entry_t* entry = calloc(1, sizeof(*entry));
@@ -549,17 +658,36 @@ static int celix_eventAdmin_deliverEventAsyncDo(celix_event_admin_t* ea, const c
         return CELIX_ENOMEM;
     }
     entry->eventHandlers = eventHandlers;
+    entry->postTime = celix_gettime(CLOCK_MONOTONIC);
+    long deadline = celix_properties_getAsLong(props, CELIX_EVENT_DEADLINE, 0);
+    if (deadline > 0) {
+        entry->hasDeadline = true;
+        entry->deadline = celix_delayedTimespec(&entry->postTime, (double)deadline / 1000.0);
+    }
+    long priority = celix_properties_getAsLong(props, CELIX_EVENT_PRIORITY, CELIX_EVENT_PRIORITY_NORMAL);
+    priority = priority < CELIX_EVENT_PRIORITY_LOW ? CELIX_EVENT_PRIORITY_LOW : priority;
+    priority = priority > CELIX_EVENT_PRIORITY_HIGH ? CELIX_EVENT_PRIORITY_HIGH : priority;
+    celix_array_list_t* asyncEventQueue = ea->asyncEventQueues[priority - CELIX_EVENT_PRIORITY_LOW];
+
     celix_auto(celix_mutex_lock_guard_t) mutexGuard = celixMutexLockGuard_init(&ea->eventsMutex);
-    if (celix_arrayList_size(ea->asyncEventQueue) >= CELIX_EVENT_ADMIN_MAX_EVENT_QUEUE_SIZE) {
-        celix_logHelper_error(ea->logHelper, "Event queue is full. Dropping event %s.", topic);
+    celix_event_admin_topic_statistics_t* stats = entry->statistics = celix_eventAdmin_getOrCreateTopicStatistics(ea, topic);
+    if (celix_arrayList_size(asyncEventQueue) >= CELIX_EVENT_ADMIN_MAX_EVENT_QUEUE_SIZE) {
+        celix_logHelper_error(ea->logHelper, "Event queue of priority %ld is full. Dropping event %s.", priority, topic);
+        if (stats != NULL) {
+            stats->droppedEvents++;
+        }
         return CELIX_ILLEGAL_STATE;
     }
-    int status = celix_arrayList_add(ea->asyncEventQueue, entry);
+    int status = celix_arrayList_add(asyncEventQueue, entry);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_logTssErrors(ea->logHelper, CELIX_LOG_LEVEL_ERROR);
         celix_logHelper_error(ea->logHelper, "Failed to add event(%s) to event queue.", topic);
         return status;
     }
+    if (stats != NULL) {
+        stats->queuedEvents++;
+        stats->maxQueuedEvents = stats->queuedEvents > stats->maxQueuedEvents ? stats->queuedEvents : stats->maxQueuedEvents;
+    }
     *stealEventHandlers = true;
     celix_steal_ptr(event);
     celix_steal_ptr(entry);
@@ -576,14 +704,174 @@ celix_status_t celix_eventAdmin_postEvent(void* handle, const char* topic, const
     return celix_eventAdmin_deliverEvent(ea, topic, props, celix_eventAdmin_deliverEventAsyncDo);
 }
 
-static bool celix_eventAdmin_getPendingEvent(celix_event_admin_t* ea, celix_event_t** event, long* eventHandlerSvcId) {
+celix_status_t celix_eventAdmin_getTopicStatistics(celix_event_admin_t* ea, const char* topic, celix_event_admin_topic_statistics_t* stats) {
+    celix_auto(celix_mutex_lock_guard_t) mutexGuard = celixMutexLockGuard_init(&ea->eventsMutex);
+    const celix_event_admin_topic_statistics_t* found = celix_stringHashMap_get(ea->topicStatistics, topic);
+    if (found == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    *stats = *found;
+    return CELIX_SUCCESS;
+}
+
+bool celix_eventAdmin_executeCommand(void* handle, const char* commandLine, FILE* outStream, FILE* errorStream) {
+    (void)commandLine;
+    (void)errorStream;
+    celix_event_admin_t* ea = handle;
+    fprintf(outStream, "%-48s %8s %10s %12s %10s %10s %14s %14s\n", "Topic", "Queued", "MaxQueued", "Delivered", "Dropped",
+            "Expired", "AvgLatency(ms)", "MaxLatency(ms)");
+    celix_auto(celix_mutex_lock_guard_t) mutexGuard = celixMutexLockGuard_init(&ea->eventsMutex);
+    CELIX_STRING_HASH_MAP_ITERATE(ea->topicStatistics, iter) {
+        const celix_event_admin_topic_statistics_t* stats = iter.value.ptrValue;
+        double avgLatency = stats->deliveredEvents == 0 ? 0.0 : stats->totalDeliveryLatency / (double)stats->deliveredEvents;
+        fprintf(outStream, "%-48s %8zu %10zu %12lu %10lu %10lu %14.3f %14.3f\n", iter.key, stats->queuedEvents,
+                stats->maxQueuedEvents, stats->deliveredEvents, stats->droppedEvents, stats->expiredEvents,
+                avgLatency * 1000.0, stats->maxDeliveryLatency * 1000.0);
+    }
+    return true;
+}
+
+typedef struct celix_event_admin_topic_metrics {
+    char topicLabel[256];
+    celix_event_admin_topic_statistics_t stats;
+} celix_event_admin_topic_metrics_t;
+
+static void celix_eventAdmin_formatTopicLabel(char* label, size_t size, const char* topic) {
+    size_t len = (size_t)snprintf(label, size, "topic=\"");
+    for (const char* c = topic; *c != '\0' && len + 4 < size; ++c) {
+        if (*c == '"' || *c == '\\') {
+            label[len++] = '\\';
+        }
+        label[len++] = *c;
+    }
+    label[len++] = '"';
+    label[len] = '\0';
+}
+
+typedef enum celix_event_admin_topic_metric_field {
+    CELIX_EVENT_ADMIN_QUEUED_EVENTS,
+    CELIX_EVENT_ADMIN_MAX_QUEUED_EVENTS,
+    CELIX_EVENT_ADMIN_DELIVERED_EVENTS,
+    CELIX_EVENT_ADMIN_DROPPED_EVENTS,
+    CELIX_EVENT_ADMIN_EXPIRED_EVENTS,
+} celix_event_admin_topic_metric_field_e;
+
+static double celix_eventAdmin_topicMetricValue(const celix_event_admin_topic_statistics_t* stats, celix_event_admin_topic_metric_field_e field) {
+    switch (field) {
+    case CELIX_EVENT_ADMIN_QUEUED_EVENTS:
+        return (double)stats->queuedEvents;
+    case CELIX_EVENT_ADMIN_MAX_QUEUED_EVENTS:
+        return (double)stats->maxQueuedEvents;
+    case CELIX_EVENT_ADMIN_DELIVERED_EVENTS:
+        return (double)stats->deliveredEvents;
+    case CELIX_EVENT_ADMIN_DROPPED_EVENTS:
+        return (double)stats->droppedEvents;
+    default:
+        return (double)stats->expiredEvents;
+    }
+}
+
+static void celix_eventAdmin_provideTopicMetric(const celix_event_admin_topic_metrics_t* topics, size_t nrOfTopics, celix_metric_t* metric,
+                                                celix_event_admin_topic_metric_field_e field, void* callbackHandle, celix_metrics_callback_fp callback) {
+    for (size_t i = 0; i < nrOfTopics; ++i) {
+        metric->labels = topics[i].topicLabel;
+        metric->value = celix_eventAdmin_topicMetricValue(&topics[i].stats, field);
+        callback(callbackHandle, metric);
+    }
+}
+
+celix_status_t celix_eventAdmin_collectMetrics(void* handle, void* callbackHandle, celix_metrics_callback_fp callback) {
+    celix_event_admin_t* ea = handle;
+    celix_autofree celix_event_admin_topic_metrics_t* topics = NULL;
+    size_t nrOfTopics = 0;
+    {
+        celix_auto(celix_mutex_lock_guard_t) mutexGuard = celixMutexLockGuard_init(&ea->eventsMutex);
+        size_t size = celix_stringHashMap_size(ea->topicStatistics);
+        topics = size == 0 ? NULL : malloc(size * sizeof(*topics));
+        if (size > 0 && topics == NULL) {
+            return CELIX_ENOMEM;
+        }
+        CELIX_STRING_HASH_MAP_ITERATE(ea->topicStatistics, iter) {
+            celix_eventAdmin_formatTopicLabel(topics[nrOfTopics].topicLabel, sizeof(topics[nrOfTopics].topicLabel), iter.key);
+            topics[nrOfTopics].stats = *(const celix_event_admin_topic_statistics_t*)iter.value.ptrValue;
+            nrOfTopics++;
+        }
+    }
+
+    celix_metric_t metric = {0};
+    metric.name = "celix_event_admin_sync_deliveries_total";
+    metric.help = "Total number of sync deliveries of an event to an event handler.";
+    metric.type = CELIX_METRIC_TYPE_COUNTER;
+    metric.value = (double)__atomic_load_n(&ea->syncDeliveredEvents, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_event_admin_async_delivery_latency_seconds";
+    metric.help = "Time between posting an event and delivering it to an event handler.";
+    metric.type = CELIX_METRIC_TYPE_HISTOGRAM;
+    metric.histogram = &ea->deliveryLatency;
+    callback(callbackHandle, &metric);
+    metric.histogram = NULL;
+
+    metric.name = "celix_event_admin_queued_events";
+    metric.help = "Number of events currently in the async event queues.";
+    metric.type = CELIX_METRIC_TYPE_GAUGE;
+    celix_eventAdmin_provideTopicMetric(topics, nrOfTopics, &metric, CELIX_EVENT_ADMIN_QUEUED_EVENTS, callbackHandle, callback);
+    metric.name = "celix_event_admin_max_queued_events";
+    metric.help = "High-water mark of the number of queued events.";
+    celix_eventAdmin_provideTopicMetric(topics, nrOfTopics, &metric, CELIX_EVENT_ADMIN_MAX_QUEUED_EVENTS, callbackHandle, callback);
+    metric.name = "celix_event_admin_async_deliveries_total";
+    metric.help = "Total number of async deliveries of an event to an event handler.";
+    metric.type = CELIX_METRIC_TYPE_COUNTER;
+    celix_eventAdmin_provideTopicMetric(topics, nrOfTopics, &metric, CELIX_EVENT_ADMIN_DELIVERED_EVENTS, callbackHandle, callback);
+    metric.name = "celix_event_admin_dropped_events_total";
+    metric.help = "Total number of events dropped, because the async event queue was full.";
+    celix_eventAdmin_provideTopicMetric(topics, nrOfTopics, &metric, CELIX_EVENT_ADMIN_DROPPED_EVENTS, callbackHandle, callback);
+    metric.name = "celix_event_admin_expired_deliveries_total";
+    metric.help = "Total number of async deliveries dropped, because the event deadline expired.";
+    celix_eventAdmin_provideTopicMetric(topics, nrOfTopics, &metric, CELIX_EVENT_ADMIN_EXPIRED_EVENTS, callbackHandle, callback);
+    return CELIX_SUCCESS;
+}
+
+static void celix_eventAdmin_removePendingEventAt(celix_array_list_t* asyncEventQueue, int index) {
+    celix_event_entry_t* eventEntry = celix_arrayList_get(asyncEventQueue, index);
+    if (eventEntry->statistics != NULL) {
+        eventEntry->statistics->queuedEvents--;
+    }
+    celix_arrayList_removeAt(asyncEventQueue, index);
+}
+
+static void celix_eventAdmin_accountDelivery(celix_event_admin_t* ea, celix_event_entry_t* eventEntry, const struct timespec* now) {
+    double latency = celix_difftime(&eventEntry->postTime, now);
+    celix_metricsHistogram_record(&ea->deliveryLatency, latency > 0.0 ? (uint64_t)(latency * 1e9) : 0);
+    celix_event_admin_topic_statistics_t* stats = eventEntry->statistics;
+    if (stats == NULL) {
+        return;
+    }
+    stats->deliveredEvents++;
+    stats->totalDeliveryLatency += latency;
+    stats->maxDeliveryLatency = latency > stats->maxDeliveryLatency ? latency : stats->maxDeliveryLatency;
+}
+
+static bool celix_eventAdmin_getPendingEventFromQueue(celix_event_admin_t* ea, celix_array_list_t* asyncEventQueue,
+                                                      const struct timespec* now, celix_event_t** event, long* eventHandlerSvcId) {
     bool found = false;
-    size_t size = celix_arrayList_size(ea->asyncEventQueue);
+    size_t size = celix_arrayList_size(asyncEventQueue);
     for (int i = 0; (i < size) && !found; ++i) {
-        celix_event_entry_t* eventEntry = celix_arrayList_get(ea->asyncEventQueue, i);
+        celix_event_entry_t* eventEntry = celix_arrayList_get(asyncEventQueue, i);
+        if (eventEntry->hasDeadline && celix_compareTime(now, &eventEntry->deadline) > 0) {
+            celix_logHelper_debug(ea->logHelper, "Deadline of event %s expired, dropping it for %zu event handler(s).",
+                                  celix_event_getTopic(eventEntry->event), celix_longHashMap_size(eventEntry->eventHandlers));
+            if (eventEntry->statistics != NULL) {
+                eventEntry->statistics->expiredEvents += celix_longHashMap_size(eventEntry->eventHandlers);
+            }
+            celix_eventAdmin_removePendingEventAt(asyncEventQueue, i);
+            i--;
+            size--;
+            continue;
+        }
         celix_long_hash_map_iterator_t iter = celix_longHashMap_begin(eventEntry->eventHandlers);
         while (!celix_longHashMapIterator_isEnd(&iter) && !found) {
-            celix_auto(celix_rwlock_rlock_guard_t) rLockGuard = celixRwlockRlockGuard_init(&ea->lock);
+            celix_auto(celix_rb_rwlock_rlock_guard_t) rLockGuard = celixRbRwlockRlockGuard_init(&ea->lock);
             long handlerSvcId = iter.key;
             celix_event_handler_t* eventHandler = celix_longHashMap_get(ea->eventHandlers, handlerSvcId);
             if (eventHandler == NULL) {
@@ -594,6 +882,7 @@ static bool celix_eventAdmin_getPendingEvent(celix_event_admin_t* ea, celix_even
             if (handlingEventCnt == 0 || (!eventHandler->asyncOrdered && handlingEventCnt < CELIX_EVENT_ADMIN_MAX_PARALLEL_EVENTS_OF_HANDLER(ea->handlerThreadNr))) {
                 *event = celix_event_retain(eventEntry->event);
                 *eventHandlerSvcId = handlerSvcId;
+                celix_eventAdmin_accountDelivery(ea, eventEntry, now);
                 celix_longHashMapIterator_remove(&iter);
                 found = true;
                 continue;
@@ -603,7 +892,7 @@ static bool celix_eventAdmin_getPendingEvent(celix_event_admin_t* ea, celix_even
             celix_longHashMapIterator_next(&iter);
         }
         if (celix_longHashMap_size(eventEntry->eventHandlers) == 0) {
-            celix_arrayList_removeAt(ea->asyncEventQueue, i);
+            celix_eventAdmin_removePendingEventAt(asyncEventQueue, i);
             i--;
             size--;
         }
@@ -611,11 +900,25 @@ static bool celix_eventAdmin_getPendingEvent(celix_event_admin_t* ea, celix_even
     return found;
 }
 
+static bool celix_eventAdmin_getPendingEvent(celix_event_admin_t* ea, celix_event_t** event, long* eventHandlerSvcId) {
+    struct timespec now = celix_gettime(CLOCK_MONOTONIC);
+    for (int i = CELIX_EVENT_ADMIN_PRIORITY_LEVELS - 1; i >= 0; --i) {
+        if (celix_eventAdmin_getPendingEventFromQueue(ea, ea->asyncEventQueues[i], &now, event, eventHandlerSvcId)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 static void celix_eventAdmin_deliverPendingEvent(celix_event_admin_t* ea, const char* topic, const celix_properties_t* props, long eventHandlerSvcId) {
-    celix_auto(celix_rwlock_rlock_guard_t) rLockGuard = celixRwlockRlockGuard_init(&ea->lock);
-    celix_event_handler_t* eventHandler = celix_longHashMap_get(ea->eventHandlers, eventHandlerSvcId);
-    if(eventHandler == NULL) {
-        return;
+    celix_event_handler_t* eventHandler = NULL;
+    {
+        celix_auto(celix_rb_rwlock_rlock_guard_t) rLockGuard = celixRbRwlockRlockGuard_init(&ea->lock);
+        eventHandler = celix_longHashMap_get(ea->eventHandlers, eventHandlerSvcId);
+        if(eventHandler == NULL) {
+            return;
+        }
+        celix_eventAdmin_retainEventHandler(eventHandler);
     }
     if (__atomic_load_n(&eventHandler->blackListed, __ATOMIC_ACQUIRE)) {
         celix_logHelper_warning(ea->logHelper, "Skipping blacklisted event handler for topic %s, %s", topic,
@@ -624,6 +927,7 @@ static void celix_eventAdmin_deliverPendingEvent(celix_event_admin_t* ea, const
         celix_eventAdmin_deliverEventToHandler(ea, topic, props, eventHandler);
     }
     __atomic_fetch_sub(&eventHandler->handlingAsyncEventCnt, 1, __ATOMIC_SEQ_CST);
+    celix_eventAdmin_releaseEventHandler(ea, eventHandler);
     return;
 }
 
@@ -22,11 +22,28 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#include <stdio.h>
+#include <stdbool.h>
+
 #include "celix_bundle_context.h"
 #include "celix_errno.h"
+#include "celix_metrics_provider.h"
 
 typedef struct celix_event_admin celix_event_admin_t;
 
+/**
+ * @brief The asynchronous delivery statistics of a topic.
+ */
+typedef struct celix_event_admin_topic_statistics {
+    size_t queuedEvents; //number of events of the topic currently in the async event queues
+    size_t maxQueuedEvents; //high-water mark of queuedEvents
+    unsigned long deliveredEvents; //number of async deliveries of an event to an event handler
+    unsigned long droppedEvents; //number of events dropped, because the async event queue was full
+    unsigned long expiredEvents; //number of async deliveries dropped, because the event deadline expired
+    double totalDeliveryLatency; //sum of the time between posting an event and delivering it to an event handler, in seconds
+    double maxDeliveryLatency; //max of the time between posting an event and delivering it to an event handler, in seconds
+} celix_event_admin_topic_statistics_t;
+
 celix_event_admin_t* celix_eventAdmin_create(celix_bundle_context_t* ctx);
 
 void celix_eventAdmin_destroy(celix_event_admin_t* ea);
@@ -40,6 +57,23 @@ int celix_eventAdmin_removeEventHandlerWithProperties(void* handle, void* svc, c
 celix_status_t celix_eventAdmin_sendEvent(void* handle, const char* topic, const celix_properties_t* props);
 celix_status_t celix_eventAdmin_postEvent(void* handle, const char* topic, const celix_properties_t* props);
 
+/**
+ * @brief Get the async delivery statistics of a topic.
+ * @return CELIX_SUCCESS if found, CELIX_ILLEGAL_ARGUMENT if no event of the topic has been posted.
+ */
+celix_status_t celix_eventAdmin_getTopicStatistics(celix_event_admin_t* ea, const char* topic, celix_event_admin_topic_statistics_t* stats);
+
+/**
+ * @brief Shell command printing the async delivery statistics of all topics.
+ */
+bool celix_eventAdmin_executeCommand(void* handle, const char* commandLine, FILE* outStream, FILE* errorStream);
+
+/**
+ * @brief Metrics provider collecting the async delivery latency histogram and the per topic statistics,
+ * labeled with the topic.
+ */
+celix_status_t celix_eventAdmin_collectMetrics(void* handle, void* callbackHandle, celix_metrics_callback_fp callback);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,10 +26,14 @@
 #include "celix_event_admin_service.h"
 #include "celix_event_handler_service.h"
 #include "celix_event_constants.h"
+#include "celix_shell_command.h"
+#include "celix_metrics_provider.h"
 
 typedef struct celix_event_admin_activator {
     celix_event_admin_t *eventAdmin;
     celix_event_admin_service_t eventAdminService;
+    celix_shell_command_t cmdSvc;
+    celix_metrics_provider_t metricsSvc;
     celix_event_adapter_t *eventAdapter;
 } celix_event_admin_activator_t;
 
@@ -79,6 +83,36 @@ celix_status_t celix_eventAdminActivator_start(celix_event_admin_activator_t *ac
         return status;
     }
 
+    {
+        act->cmdSvc.handle = act->eventAdmin;
+        act->cmdSvc.executeCommand = celix_eventAdmin_executeCommand;
+        celix_autoptr(celix_properties_t) props = celix_properties_create();
+        if (props == NULL) {
+            return CELIX_ENOMEM;
+        }
+        celix_properties_set(props, CELIX_SHELL_COMMAND_NAME, "celix::event_admin_stats");
+        celix_properties_set(props, CELIX_SHELL_COMMAND_USAGE, "celix::event_admin_stats");
+        celix_properties_set(props, CELIX_SHELL_COMMAND_DESCRIPTION, "Show the queue depth and delivery latency of asynchronously delivered events per topic.");
+        status = celix_dmComponent_addInterface(adminCmp, CELIX_SHELL_COMMAND_SERVICE_NAME, CELIX_SHELL_COMMAND_SERVICE_VERSION, &act->cmdSvc, celix_steal_ptr(props));
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+
+    {
+        act->metricsSvc.handle = act->eventAdmin;
+        act->metricsSvc.collectMetrics = celix_eventAdmin_collectMetrics;
+        celix_autoptr(celix_properties_t) props = celix_properties_create();
+        if (props == NULL) {
+            return CELIX_ENOMEM;
+        }
+        celix_properties_set(props, CELIX_METRICS_PROVIDER_NAME, "event_admin");
+        status = celix_dmComponent_addInterface(adminCmp, CELIX_METRICS_PROVIDER_SERVICE_NAME, CELIX_METRICS_PROVIDER_SERVICE_VERSION, &act->metricsSvc, celix_steal_ptr(props));
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+
     celix_autoptr(celix_dm_component_t) adapterCmp = celix_dmComponent_create(ctx, "EVENT_ADAPTER_CMP");
     if (adapterCmp == NULL) {
         return CELIX_ENOMEM;
@@ -106,6 +106,50 @@ extern "C" {
  */
 #define CELIX_EVENT_TIMESTAMP "timestamp"
 
+/**
+ * @brief The uuid of the framework the event originates from. The type of the value for this event property is String.
+ *
+ * Set by event admin remote providers on events received from another framework. Remote providers do not forward
+ * events with this property, so that events are not echoed between frameworks.
+ */
+#define CELIX_EVENT_FRAMEWORK_UUID "celix.framework.uuid"
+
+/**
+ * @brief The delivery priority of an asynchronously delivered event. The type of the value for this event property is Long.
+ *
+ * Pending events with a higher priority are delivered before pending events with a lower priority. Values outside
+ * the range [CELIX_EVENT_PRIORITY_LOW, CELIX_EVENT_PRIORITY_HIGH] are clamped to this range.
+ * If not set, the priority of the event is CELIX_EVENT_PRIORITY_NORMAL. Ignored for synchronously delivered events.
+ */
+#define CELIX_EVENT_PRIORITY "event.priority"
+
+/**
+ * @brief Event priority value for bulk events, e.g. telemetry, which are delivered after all other pending events.
+ * @see CELIX_EVENT_PRIORITY
+ */
+#define CELIX_EVENT_PRIORITY_LOW 0
+
+/**
+ * @brief Default event priority value.
+ * @see CELIX_EVENT_PRIORITY
+ */
+#define CELIX_EVENT_PRIORITY_NORMAL 1
+
+/**
+ * @brief Event priority value for latency critical events, e.g. control events.
+ * @see CELIX_EVENT_PRIORITY
+ */
+#define CELIX_EVENT_PRIORITY_HIGH 2
+
+/**
+ * @brief The delivery deadline of an asynchronously delivered event, in milliseconds after the event is posted.
+ * The type of the value for this event property is Long.
+ *
+ * If the event is not delivered to an event handler before its deadline, the event is dropped for that event handler.
+ * If not set or not positive, the event has no deadline. Ignored for synchronously delivered events.
+ */
+#define CELIX_EVENT_DEADLINE "event.deadline"
+
 //end event constants
 
 #ifdef __cplusplus
@@ -0,0 +1,215 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "celix_bundle_context.h"
+#include "celix_constants.h"
+#include "celix_event_admin.h"
+#include "celix_event_admin_service.h"
+#include "celix_event_codec.h"
+#include "celix_event_constants.h"
+#include "celix_event_handler_service.h"
+#include "celix_event_remote_provider_shm.h"
+#include "celix_event_remote_provider_shm_constants.h"
+#include "celix_framework_factory.h"
+
+/**
+ * A framework with an event admin and a shared memory event remote provider, wired without the dependency manager.
+ * Two instances in one process exchange events over the same shared memory channel as two processes would.
+ */
+class ShmEventFramework {
+public:
+    ShmEventFramework(const std::string& name, const std::string& channel, const char* exportTopics,
+                      const char* importTopics) {
+        auto* props = celix_properties_create();
+        celix_properties_set(props, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
+        celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, (".event_remote_provider_shm_benchmark_cache_" + name).c_str());
+        celix_properties_set(props, "CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "error");
+        celix_properties_set(props, CELIX_EVENT_REMOTE_PROVIDER_SHM_CHANNEL, channel.c_str());
+        if (exportTopics != nullptr) {
+            celix_properties_set(props, CELIX_EVENT_REMOTE_PROVIDER_SHM_EXPORT_TOPICS, exportTopics);
+        }
+        if (importTopics != nullptr) {
+            celix_properties_set(props, CELIX_EVENT_REMOTE_PROVIDER_SHM_IMPORT_TOPICS, importTopics);
+        }
+        fw = std::shared_ptr<celix_framework_t>{celix_frameworkFactory_createFramework(props),
+                                                [](celix_framework_t* f) { celix_frameworkFactory_destroyFramework(f); }};
+        auto* ctx = celix_framework_getFrameworkContext(fw.get());
+
+        ea = celix_eventAdmin_create(ctx);
+        celix_eventAdmin_start(ea);
+        eaService.handle = ea;
+        eaService.postEvent = celix_eventAdmin_postEvent;
+        eaService.sendEvent = celix_eventAdmin_sendEvent;
+
+        provider = celix_eventRemoteProviderShm_create(ctx);
+        celix_eventRemoteProviderShm_setEventAdminService(provider, &eaService);
+        celix_eventRemoteProviderShm_start(provider);
+        if (exportTopics != nullptr) {
+            providerHandler.handle = provider;
+            providerHandler.handleEvent = celix_eventRemoteProviderShm_handleEvent;
+            addEventHandler(&providerHandler, exportTopics, "(!(" CELIX_EVENT_FRAMEWORK_UUID "=*))");
+        }
+    }
+
+    ~ShmEventFramework() {
+        for (auto& entry : handlers) {
+            celix_eventAdmin_removeEventHandlerWithProperties(ea, entry.first, entry.second);
+            celix_properties_destroy(entry.second);
+        }
+        celix_eventRemoteProviderShm_stop(provider);
+        celix_eventRemoteProviderShm_setEventAdminService(provider, nullptr);
+        celix_eventRemoteProviderShm_destroy(provider);
+        celix_eventAdmin_stop(ea);
+        celix_eventAdmin_destroy(ea);
+    }
+
+    void addEventHandler(celix_event_handler_service_t* handler, const char* topics, const char* filter = nullptr) {
+        auto* props = celix_properties_create();
+        celix_properties_set(props, CELIX_EVENT_TOPIC, topics);
+        celix_properties_set(props, CELIX_EVENT_DELIVERY, CELIX_EVENT_DELIVERY_ASYNC_ORDERED);
+        if (filter != nullptr) {
+            celix_properties_set(props, CELIX_EVENT_FILTER, filter);
+        }
+        celix_properties_setLong(props, CELIX_FRAMEWORK_SERVICE_ID, (long)handlers.size() + 1);
+        celix_eventAdmin_addEventHandlerWithProperties(ea, handler, props);
+        handlers.emplace_back(handler, props);
+    }
+
+    std::shared_ptr<celix_framework_t> fw{};
+    celix_event_admin_t* ea{nullptr};
+    celix_event_admin_service_t eaService{};
+    celix_event_remote_provider_shm_t* provider{nullptr};
+    celix_event_handler_service_t providerHandler{};
+    std::vector<std::pair<celix_event_handler_service_t*, celix_properties_t*>> handlers{};
+};
+
+static std::string benchmarkChannel() {
+    return "celix_event_remote_provider_shm_benchmark_" + std::to_string(getpid());
+}
+
+static celix_properties_t* createEventProperties(long nrOfProperties) {
+    auto* props = celix_properties_create();
+    for (long i = 0; i < nrOfProperties; ++i) {
+        std::string key = "key" + std::to_string(i);
+        if (i % 2 == 0) {
+            celix_properties_setLong(props, key.c_str(), i);
+        } else {
+            celix_properties_set(props, key.c_str(), "value");
+        }
+    }
+    return props;
+}
+
+static void waitForHandledEvents(const std::atomic<long>& handledEvents, long nrOfEvents, long maxPending) {
+    while (nrOfEvents - handledEvents.load(std::memory_order_acquire) > maxPending) {
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * Throughput of posting events to an event handler in another framework, with a bounded number of events in flight.
+ */
+static void RemoteProviderShm_PostEventToOtherFramework(benchmark::State& state) {
+    constexpr const char* topic = "org/celix/benchmark";
+    constexpr long maxPendingEvents = 256;
+    auto channel = benchmarkChannel();
+    ShmEventFramework publisher{"publisher", channel, topic, nullptr};
+    ShmEventFramework subscriber{"subscriber", channel, nullptr, topic};
+
+    std::atomic<long> handledEvents{0};
+    celix_event_handler_service_t handler{};
+    handler.handle = &handledEvents;
+    handler.handleEvent = [](void* handle, const char*, const celix_properties_t*) {
+        static_cast<std::atomic<long>*>(handle)->fetch_add(1, std::memory_order_release);
+        return CELIX_SUCCESS;
+    };
+    subscriber.addEventHandler(&handler, topic);
+
+    celix_autoptr(celix_properties_t) props = createEventProperties(state.range(0));
+    celix_properties_freeze(props);
+    long posted = 0;
+    for (auto _ : state) {
+        celix_eventAdmin_postEvent(publisher.ea, topic, props);
+        waitForHandledEvents(handledEvents, ++posted, maxPendingEvents);
+    }
+    waitForHandledEvents(handledEvents, posted, 0);
+    state.SetItemsProcessed(posted);
+    state.counters["encodedBytes"] = (double)celix_eventCodec_encode("00000000-0000-0000-0000-000000000000", topic,
+                                                                     props, nullptr, 0);
+}
+
+/**
+ * Round trip latency: an event posted in one framework is answered by an event handler in another framework.
+ */
+static void RemoteProviderShm_RoundTrip(benchmark::State& state) {
+    auto channel = benchmarkChannel();
+    ShmEventFramework pinger{"pinger", channel, "org/celix/ping", "org/celix/pong"};
+    ShmEventFramework ponger{"ponger", channel, "org/celix/pong", "org/celix/ping"};
+
+    celix_event_handler_service_t pingHandler{};
+    pingHandler.handle = ponger.ea;
+    pingHandler.handleEvent = [](void* handle, const char*, const celix_properties_t*) {
+        return celix_eventAdmin_postEvent(handle, "org/celix/pong", nullptr);
+    };
+    ponger.addEventHandler(&pingHandler, "org/celix/ping", "(" CELIX_EVENT_FRAMEWORK_UUID "=*)");
+
+    std::atomic<long> pongs{0};
+    celix_event_handler_service_t pongHandler{};
+    pongHandler.handle = &pongs;
+    pongHandler.handleEvent = [](void* handle, const char*, const celix_properties_t*) {
+        static_cast<std::atomic<long>*>(handle)->fetch_add(1, std::memory_order_release);
+        return CELIX_SUCCESS;
+    };
+    pinger.addEventHandler(&pongHandler, "org/celix/pong", "(" CELIX_EVENT_FRAMEWORK_UUID "=*)");
+
+    long pings = 0;
+    for (auto _ : state) {
+        celix_eventAdmin_postEvent(pinger.ea, "org/celix/ping", nullptr);
+        waitForHandledEvents(pongs, ++pings, 0);
+    }
+}
+
+static void RemoteProviderShm_EncodeDecodeEvent(benchmark::State& state) {
+    celix_autoptr(celix_properties_t) props = createEventProperties(state.range(0));
+    char buf[4096];
+    size_t size = 0;
+    for (auto _ : state) {
+        size = celix_eventCodec_encode("00000000-0000-0000-0000-000000000000", "org/celix/benchmark", props, buf,
+                                       sizeof(buf));
+        const char* originId;
+        const char* topic;
+        celix_properties_t* decoded = nullptr;
+        celix_eventCodec_decode(buf, size, &originId, &topic, &decoded);
+        celix_properties_destroy(decoded);
+    }
+    state.counters["encodedBytes"] = (double)size;
+}
+
+BENCHMARK(RemoteProviderShm_PostEventToOtherFramework)->Arg(0)->Arg(8)->Arg(32)->UseRealTime();
+BENCHMARK(RemoteProviderShm_RoundTrip)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(RemoteProviderShm_EncodeDecodeEvent)->Arg(0)->Arg(8)->Arg(32);
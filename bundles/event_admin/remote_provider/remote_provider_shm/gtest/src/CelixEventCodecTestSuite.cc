@@ -0,0 +1,136 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "celix_array_list.h"
+#include "celix_err.h"
+#include "celix_event_codec.h"
+#include "celix_version.h"
+
+class CelixEventCodecTestSuite : public ::testing::Test {
+public:
+    CelixEventCodecTestSuite() = default;
+    ~CelixEventCodecTestSuite() override { celix_err_resetErrors(); }
+
+    static std::vector<uint8_t> encode(const char* topic, const celix_properties_t* props) {
+        size_t size = celix_eventCodec_encode("origin", topic, props, nullptr, 0);
+        std::vector<uint8_t> buf(size);
+        EXPECT_EQ(size, celix_eventCodec_encode("origin", topic, props, buf.data(), buf.size()));
+        return buf;
+    }
+};
+
+TEST_F(CelixEventCodecTestSuite, EncodeDecodeAllValueTypesTest) {
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "string", "value");
+    celix_properties_setLong(props, "long", -123456789L);
+    celix_properties_setLong(props, "smallLong", -1L);
+    celix_properties_setDouble(props, "double", 3.14);
+    celix_properties_setBool(props, "bool", true);
+    celix_properties_assignVersion(props, "version", celix_version_create(1, 2, 3, "qualifier"));
+    celix_array_list_t* longs = celix_arrayList_createLongArray();
+    celix_arrayList_addLong(longs, 1);
+    celix_arrayList_addLong(longs, -2);
+    celix_properties_assignArrayList(props, "longs", longs);
+    celix_array_list_t* strings = celix_arrayList_createStringArray();
+    celix_arrayList_addString(strings, "a");
+    celix_arrayList_addString(strings, "");
+    celix_properties_assignArrayList(props, "strings", strings);
+    celix_array_list_t* versions = celix_arrayList_createVersionArray();
+    celix_arrayList_assignVersion(versions, celix_version_create(4, 5, 6, ""));
+    celix_properties_assignArrayList(props, "versions", versions);
+    celix_array_list_t* bools = celix_arrayList_createBoolArray();
+    celix_arrayList_addBool(bools, false);
+    celix_properties_assignArrayList(props, "bools", bools);
+    celix_array_list_t* doubles = celix_arrayList_createDoubleArray();
+    celix_arrayList_addDouble(doubles, -0.5);
+    celix_properties_assignArrayList(props, "doubles", doubles);
+
+    auto buf = encode("org/celix/test", props);
+
+    const char* originId = nullptr;
+    const char* topic = nullptr;
+    celix_autoptr(celix_properties_t) decoded = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_eventCodec_decode(buf.data(), buf.size(), &originId, &topic, &decoded));
+    EXPECT_STREQ("origin", originId);
+    EXPECT_STREQ("org/celix/test", topic);
+    EXPECT_TRUE(celix_properties_equals(props, decoded));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_LONG, celix_properties_getType(decoded, "smallLong"));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_VERSION, celix_properties_getType(decoded, "version"));
+}
+
+TEST_F(CelixEventCodecTestSuite, EncodeWithoutPropertiesTest) {
+    auto buf = encode("topic", nullptr);
+    //format version, origin, topic and number of entries
+    EXPECT_EQ(1 + (1 + 7) + (1 + 6) + 1, buf.size());
+
+    const char* originId = nullptr;
+    const char* topic = nullptr;
+    celix_autoptr(celix_properties_t) decoded = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_eventCodec_decode(buf.data(), buf.size(), &originId, &topic, &decoded));
+    EXPECT_STREQ("topic", topic);
+    EXPECT_EQ(0, celix_properties_size(decoded));
+}
+
+TEST_F(CelixEventCodecTestSuite, EncodeInTooSmallBufferTest) {
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+    uint8_t buf[8];
+    memset(buf, 0xAB, sizeof(buf));
+    size_t size = celix_eventCodec_encode("origin", "topic", props, buf, sizeof(buf));
+    EXPECT_GT(size, sizeof(buf));
+    //nothing beyond the buffer is written and the returned size is enough to encode the event
+    std::vector<uint8_t> fullBuf(size);
+    EXPECT_EQ(size, celix_eventCodec_encode("origin", "topic", props, fullBuf.data(), fullBuf.size()));
+}
+
+TEST_F(CelixEventCodecTestSuite, DecodeInvalidDataTest) {
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "string", "value");
+    celix_properties_setLong(props, "long", 42);
+    celix_properties_assignVersion(props, "version", celix_version_create(1, 2, 3, "q"));
+    auto buf = encode("topic", props);
+
+    const char* originId = nullptr;
+    const char* topic = nullptr;
+    //every truncation of a valid encoded event is rejected
+    for (size_t len = 0; len < buf.size(); ++len) {
+        celix_properties_t* decoded = nullptr;
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_eventCodec_decode(buf.data(), len, &originId, &topic, &decoded))
+            << "len " << len;
+        EXPECT_EQ(nullptr, decoded);
+        celix_err_resetErrors();
+    }
+
+    //trailing data
+    auto trailing = buf;
+    trailing.push_back(0);
+    celix_properties_t* decoded = nullptr;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_eventCodec_decode(trailing.data(), trailing.size(), &originId, &topic, &decoded));
+
+    //unknown format version
+    auto unknownVersion = buf;
+    unknownVersion[0] = 42;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT,
+              celix_eventCodec_decode(unknownVersion.data(), unknownVersion.size(), &originId, &topic, &decoded));
+    EXPECT_EQ(nullptr, decoded);
+}
@@ -0,0 +1,103 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+#include "celix_bundle_context.h"
+#include "celix_constants.h"
+#include "celix_event_admin_service.h"
+#include "celix_event_constants.h"
+#include "celix_event_handler_service.h"
+#include "celix_framework_factory.h"
+
+class CelixEventRemoteProviderShmIntegrationTestSuite : public ::testing::Test {
+public:
+    CelixEventRemoteProviderShmIntegrationTestSuite() {
+        std::string channel = "celix_event_remote_provider_shm_it_" + std::to_string(getpid());
+        publisherFw = createFramework(channel, "CELIX_EVENT_REMOTE_PROVIDER_SHM_EXPORT_TOPICS", "org/celix/*");
+        subscriberFw = createFramework(channel, "CELIX_EVENT_REMOTE_PROVIDER_SHM_IMPORT_TOPICS", "org/celix/remote");
+    }
+
+    static std::shared_ptr<celix_framework_t> createFramework(const std::string& channel, const char* topicsKey,
+                                                              const char* topics) {
+        auto props = celix_properties_create();
+        celix_properties_set(props, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
+        celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, (".event_remote_provider_shm_it_cache_" + std::string{topicsKey}).c_str());
+        celix_properties_set(props, "CELIX_EVENT_REMOTE_PROVIDER_SHM_CHANNEL", channel.c_str());
+        celix_properties_set(props, topicsKey, topics);
+        std::shared_ptr<celix_framework_t> fw{celix_frameworkFactory_createFramework(props),
+                                              [](celix_framework_t* f) { celix_frameworkFactory_destroyFramework(f); }};
+        auto ctx = celix_framework_getFrameworkContext(fw.get());
+        EXPECT_GE(celix_bundleContext_installBundle(ctx, EVENT_ADMIN_BUNDLE, true), 0);
+        EXPECT_GE(celix_bundleContext_installBundle(ctx, EVENT_ADMIN_REMOTE_PROVIDER_SHM_BUNDLE, true), 0);
+        celix_bundleContext_waitForEvents(ctx);
+        return fw;
+    }
+
+    std::shared_ptr<celix_framework_t> publisherFw{};
+    std::shared_ptr<celix_framework_t> subscriberFw{};
+};
+
+TEST_F(CelixEventRemoteProviderShmIntegrationTestSuite, PostEventToOtherFrameworkTest) {
+    auto subscriberCtx = celix_framework_getFrameworkContext(subscriberFw.get());
+    static std::atomic<int> received{0};
+    received = 0;
+    celix_event_handler_service_t handler{};
+    handler.handleEvent = [](void*, const char* topic, const celix_properties_t* props) {
+        EXPECT_STREQ("org/celix/remote", topic);
+        EXPECT_STREQ("value", celix_properties_get(props, "key", nullptr));
+        EXPECT_NE(nullptr, celix_properties_get(props, CELIX_EVENT_FRAMEWORK_UUID, nullptr));
+        received++;
+        return CELIX_SUCCESS;
+    };
+    auto handlerProps = celix_properties_create();
+    celix_properties_set(handlerProps, CELIX_EVENT_TOPIC, "org/celix/*");
+    long handlerSvcId = celix_bundleContext_registerService(subscriberCtx, &handler, CELIX_EVENT_HANDLER_SERVICE_NAME, handlerProps);
+    ASSERT_GE(handlerSvcId, 0);
+
+    auto publisherCtx = celix_framework_getFrameworkContext(publisherFw.get());
+    celix_service_use_options_t opts{};
+    opts.filter.serviceName = CELIX_EVENT_ADMIN_SERVICE_NAME;
+    opts.callbackHandle = nullptr;
+    opts.use = [](void*, void* svc) {
+        auto ea = static_cast<celix_event_admin_service_t*>(svc);
+        celix_autoptr(celix_properties_t) props = celix_properties_create();
+        celix_properties_set(props, "key", "value");
+        EXPECT_EQ(CELIX_SUCCESS, ea->postEvent(ea->handle, "org/celix/remote", props));
+        //not imported by the subscriber framework
+        EXPECT_EQ(CELIX_SUCCESS, ea->postEvent(ea->handle, "org/celix/local", props));
+    };
+    opts.waitTimeoutInSeconds = 5;
+    ASSERT_TRUE(celix_bundleContext_useServiceWithOptions(publisherCtx, &opts));
+
+    for (int i = 0; i < 500 && received == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_EQ(1, received);
+
+    celix_bundleContext_unregisterService(subscriberCtx, handlerSvcId);
+}
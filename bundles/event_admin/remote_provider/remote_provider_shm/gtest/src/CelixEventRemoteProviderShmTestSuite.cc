@@ -0,0 +1,179 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "celix_bundle_context.h"
+#include "celix_constants.h"
+#include "celix_event_admin_service.h"
+#include "celix_event_constants.h"
+#include "celix_event_remote_provider_shm.h"
+#include "celix_event_remote_provider_shm_constants.h"
+#include "celix_framework_factory.h"
+
+struct ReceivedEvent {
+    std::string topic;
+    std::shared_ptr<const celix_properties_t> props;
+};
+
+/**
+ * @brief A framework with an event remote provider and a fake event admin, capturing the posted remote events.
+ */
+class RemoteProviderTestFramework {
+public:
+    RemoteProviderTestFramework(const std::string& channel, const char* exportTopics, const char* importTopics) {
+        auto props = celix_properties_create();
+        celix_properties_set(props, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
+        celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, ".event_remote_provider_shm_test_cache");
+        celix_properties_set(props, CELIX_EVENT_REMOTE_PROVIDER_SHM_CHANNEL, channel.c_str());
+        if (exportTopics != nullptr) {
+            celix_properties_set(props, CELIX_EVENT_REMOTE_PROVIDER_SHM_EXPORT_TOPICS, exportTopics);
+        }
+        if (importTopics != nullptr) {
+            celix_properties_set(props, CELIX_EVENT_REMOTE_PROVIDER_SHM_IMPORT_TOPICS, importTopics);
+        }
+        fw = std::shared_ptr<celix_framework_t>{celix_frameworkFactory_createFramework(props),
+                                                [](celix_framework_t* f) { celix_frameworkFactory_destroyFramework(f); }};
+        ctx = celix_framework_getFrameworkContext(fw.get());
+
+        eventAdminService.handle = this;
+        eventAdminService.postEvent = [](void* handle, const char* topic, const celix_properties_t* props) {
+            auto self = static_cast<RemoteProviderTestFramework*>(handle);
+            EXPECT_TRUE(celix_properties_isFrozen(props));
+            std::lock_guard<std::mutex> lock{self->mutex};
+            self->received.push_back({topic, std::shared_ptr<const celix_properties_t>{
+                                                 celix_properties_retain(props), celix_properties_release}});
+            self->cond.notify_all();
+            return CELIX_SUCCESS;
+        };
+        eventAdminService.sendEvent = nullptr;
+
+        provider = celix_eventRemoteProviderShm_create(ctx);
+        EXPECT_NE(nullptr, provider);
+        celix_eventRemoteProviderShm_setEventAdminService(provider, &eventAdminService);
+        EXPECT_EQ(CELIX_SUCCESS, celix_eventRemoteProviderShm_start(provider));
+    }
+
+    ~RemoteProviderTestFramework() {
+        celix_eventRemoteProviderShm_stop(provider);
+        celix_eventRemoteProviderShm_setEventAdminService(provider, nullptr);
+        celix_eventRemoteProviderShm_destroy(provider);
+    }
+
+    std::string uuid() const { return celix_bundleContext_getProperty(ctx, CELIX_FRAMEWORK_UUID, ""); }
+
+    bool waitForEvents(size_t count, std::chrono::milliseconds timeout = std::chrono::seconds{5}) {
+        std::unique_lock<std::mutex> lock{mutex};
+        return cond.wait_for(lock, timeout, [&] { return received.size() >= count; });
+    }
+
+    size_t receivedCount() {
+        std::lock_guard<std::mutex> lock{mutex};
+        return received.size();
+    }
+
+    std::shared_ptr<celix_framework_t> fw{};
+    celix_bundle_context_t* ctx{};
+    celix_event_admin_service_t eventAdminService{};
+    celix_event_remote_provider_shm_t* provider{};
+    std::mutex mutex{};
+    std::condition_variable cond{};
+    std::vector<ReceivedEvent> received{};
+};
+
+class CelixEventRemoteProviderShmTestSuite : public ::testing::Test {
+public:
+    CelixEventRemoteProviderShmTestSuite() : channel{"celix_event_remote_provider_shm_test_" + std::to_string(getpid())} {}
+
+    const std::string channel;
+};
+
+TEST_F(CelixEventRemoteProviderShmTestSuite, ForwardEventTest) {
+    RemoteProviderTestFramework publisher{channel, "test/*", nullptr};
+    RemoteProviderTestFramework subscriber{channel, nullptr, "test/*, other"};
+    EXPECT_STREQ("test/*", celix_eventRemoteProviderShm_getExportTopics(publisher.provider));
+    EXPECT_EQ(nullptr, celix_eventRemoteProviderShm_getExportTopics(subscriber.provider));
+
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+    celix_properties_setLong(props, "long", 42);
+    EXPECT_EQ(CELIX_SUCCESS, celix_eventRemoteProviderShm_handleEvent(publisher.provider, "test/event", props));
+    EXPECT_EQ(CELIX_SUCCESS, celix_eventRemoteProviderShm_handleEvent(publisher.provider, "other", nullptr));
+
+    ASSERT_TRUE(subscriber.waitForEvents(2));
+    EXPECT_EQ("test/event", subscriber.received[0].topic);
+    auto received = subscriber.received[0].props.get();
+    EXPECT_STREQ("value", celix_properties_get(received, "key", nullptr));
+    EXPECT_EQ(42, celix_properties_getLong(received, "long", 0));
+    EXPECT_EQ(publisher.uuid(), celix_properties_get(received, CELIX_EVENT_FRAMEWORK_UUID, ""));
+    EXPECT_EQ("other", subscriber.received[1].topic);
+    EXPECT_EQ(0, publisher.receivedCount());
+}
+
+TEST_F(CelixEventRemoteProviderShmTestSuite, PublisherSideTopicFilteringTest) {
+    RemoteProviderTestFramework publisher{channel, "*", "*"};
+    RemoteProviderTestFramework subscriber1{channel, nullptr, "a/*"};
+
+    //not matching any remote subscription, not forwarded. The own subscription is ignored.
+    EXPECT_EQ(CELIX_SUCCESS, celix_eventRemoteProviderShm_handleEvent(publisher.provider, "b", nullptr));
+    EXPECT_EQ(CELIX_SUCCESS, celix_eventRemoteProviderShm_handleEvent(publisher.provider, "a", nullptr));
+    EXPECT_EQ(CELIX_SUCCESS, celix_eventRemoteProviderShm_handleEvent(publisher.provider, "a/b/c", nullptr));
+    ASSERT_TRUE(subscriber1.waitForEvents(1));
+    EXPECT_EQ("a/b/c", subscriber1.received[0].topic);
+
+    //a new subscription invalidates the cached target masks of the publisher
+    RemoteProviderTestFramework subscriber2{channel, nullptr, "b"};
+    EXPECT_EQ(CELIX_SUCCESS, celix_eventRemoteProviderShm_handleEvent(publisher.provider, "b", nullptr));
+    ASSERT_TRUE(subscriber2.waitForEvents(1));
+    EXPECT_EQ("b", subscriber2.received[0].topic);
+
+    //events received from another framework are not forwarded again
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, CELIX_EVENT_FRAMEWORK_UUID, "remote");
+    EXPECT_EQ(CELIX_SUCCESS, celix_eventRemoteProviderShm_handleEvent(publisher.provider, "a/b", props));
+
+    EXPECT_FALSE(subscriber1.waitForEvents(2, std::chrono::milliseconds{100}));
+    EXPECT_EQ(1, subscriber2.receivedCount());
+    EXPECT_EQ(0, publisher.receivedCount());
+}
+
+TEST_F(CelixEventRemoteProviderShmTestSuite, LargeEventTest) {
+    RemoteProviderTestFramework publisher{channel, "*", nullptr};
+    RemoteProviderTestFramework subscriber{channel, nullptr, "*"};
+
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    std::string largeValue(10000, 'x');//larger than the encode buffer on the stack
+    celix_properties_set(props, "large", largeValue.c_str());
+    EXPECT_EQ(CELIX_SUCCESS, celix_eventRemoteProviderShm_handleEvent(publisher.provider, "large", props));
+    ASSERT_TRUE(subscriber.waitForEvents(1));
+    EXPECT_EQ(largeValue, celix_properties_get(subscriber.received[0].props.get(), "large", ""));
+
+    //events larger than the max record size of the ring are rejected
+    std::string tooLargeValue(CELIX_EVENT_REMOTE_PROVIDER_SHM_RING_SIZE_DEFAULT / 2, 'x');
+    celix_properties_set(props, "large", tooLargeValue.c_str());
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_eventRemoteProviderShm_handleEvent(publisher.provider, "large", props));
+}
@@ -0,0 +1,298 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cerrno>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "celix_err.h"
+#include "celix_shm_event_ring.h"
+
+#define RING_TIMEOUT CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, ETIMEDOUT)
+
+class ShmEventRingTestSuite : public ::testing::Test {
+public:
+    ShmEventRingTestSuite() : name{"celix_shm_event_ring_test_" + std::to_string(getpid())} {}
+    ~ShmEventRingTestSuite() override {
+        shm_unlink(("/" + name).c_str()); //in case a test left an attached ring behind
+        celix_err_resetErrors();
+    }
+
+    static std::string readRecord(celix_shm_event_ring_t* ring, int timeoutInMs = 0) {
+        const void* data = nullptr;
+        size_t len = 0;
+        celix_status_t status = celix_shmEventRing_read(ring, timeoutInMs, &data, &len);
+        if (status != CELIX_SUCCESS) {
+            return "status " + std::to_string(status);
+        }
+        return std::string{static_cast<const char*>(data), len};
+    }
+
+    static void writeRecord(celix_shm_event_ring_t* ring, uint64_t mask, const std::string& record) {
+        EXPECT_EQ(CELIX_SUCCESS, celix_shmEventRing_write(ring, mask, record.data(), record.size()));
+    }
+
+    const std::string name;
+};
+
+TEST_F(ShmEventRingTestSuite, OpenCloseTest) {
+    celix_shm_event_ring_t* ring1 = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 5000, &ring1));
+    EXPECT_EQ(5056, celix_shmEventRing_getCapacity(ring1)); //rounded up to a multiple of 64
+    EXPECT_EQ(5056 / 4 - 16, celix_shmEventRing_getMaxPayloadSize(ring1));
+
+    //an existing ring is attached, the capacity of the existing ring is used
+    celix_shm_event_ring_t* ring2 = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(("/" + name).c_str(), 100000, &ring2));
+    EXPECT_EQ(5056, celix_shmEventRing_getCapacity(ring2));
+
+    celix_shmEventRing_close(ring1);
+    int fd = shm_open(("/" + name).c_str(), O_RDONLY, 0);
+    EXPECT_GE(fd, 0);
+    close(fd);
+
+    //the last close removes the shared memory object
+    celix_shmEventRing_close(ring2);
+    fd = shm_open(("/" + name).c_str(), O_RDONLY, 0);
+    EXPECT_EQ(-1, fd);
+    EXPECT_EQ(ENOENT, errno);
+}
+
+TEST_F(ShmEventRingTestSuite, OpenWithInvalidArgumentsTest) {
+    celix_shm_event_ring_t* ring = nullptr;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_shmEventRing_open("", 4096, &ring));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_shmEventRing_open("a/b", 4096, &ring));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_shmEventRing_open(name.c_str(), 100, &ring));
+    EXPECT_EQ(nullptr, ring);
+}
+
+TEST_F(ShmEventRingTestSuite, WriteReadTargetedRecordsTest) {
+    celix_autoptr(celix_shm_event_ring_t) publisher = nullptr;
+    celix_autoptr(celix_shm_event_ring_t) reader1 = nullptr;
+    celix_autoptr(celix_shm_event_ring_t) reader2 = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 4096, &publisher));
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 4096, &reader1));
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 4096, &reader2));
+
+    uint64_t generation = celix_shmEventRing_getSubscriptionsGeneration(publisher);
+    int slot1 = -1;
+    int slot2 = -1;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_subscribe(reader1, "reader1", "a/*", &slot1));
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_subscribe(reader2, "reader2", "b", &slot2));
+    EXPECT_NE(slot1, slot2);
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_shmEventRing_subscribe(reader2, "reader2", "b", &slot2));
+    EXPECT_EQ(generation + 2, celix_shmEventRing_getSubscriptionsGeneration(publisher));
+
+    std::vector<celix_shm_event_ring_subscription_t> subs{CELIX_SHM_EVENT_RING_MAX_SUBSCRIBERS};
+    ASSERT_EQ(2, celix_shmEventRing_getSubscriptions(publisher, subs.data(), &generation));
+    EXPECT_EQ(generation, celix_shmEventRing_getSubscriptionsGeneration(publisher));
+    EXPECT_STREQ("reader1", subs[0].id);
+    EXPECT_STREQ("a/*", subs[0].topics);
+    EXPECT_EQ(slot1, subs[0].slot);
+
+    uint64_t bit1 = UINT64_C(1) << slot1;
+    uint64_t bit2 = UINT64_C(1) << slot2;
+    writeRecord(publisher, bit1, "for reader1");
+    writeRecord(publisher, bit2, "for reader2");
+    writeRecord(publisher, bit1 | bit2, "for both");
+    writeRecord(publisher, 0, "for none");
+
+    EXPECT_EQ("for reader1", readRecord(reader1));
+    EXPECT_EQ("for both", readRecord(reader1));
+    EXPECT_EQ("status " + std::to_string(RING_TIMEOUT), readRecord(reader1));
+    EXPECT_EQ("for reader2", readRecord(reader2));
+    EXPECT_EQ("for both", readRecord(reader2));
+    EXPECT_EQ("status " + std::to_string(RING_TIMEOUT), readRecord(reader2));
+
+    //a handle without subscription cannot read
+    const void* data;
+    size_t len;
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_shmEventRing_read(publisher, 0, &data, &len));
+
+    //records larger than the max payload size are rejected
+    std::string tooLarge(celix_shmEventRing_getMaxPayloadSize(publisher) + 1, 'x');
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_shmEventRing_write(publisher, bit1, tooLarge.data(), tooLarge.size()));
+}
+
+TEST_F(ShmEventRingTestSuite, WrapAroundTest) {
+    celix_autoptr(celix_shm_event_ring_t) ring = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 4096, &ring));
+    int slot;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_subscribe(ring, "reader", "*", &slot));
+
+    //records of varying sizes, so that padding records are needed at the end of the ring
+    for (int i = 0; i < 1000; ++i) {
+        std::string record(1 + (i * 37) % 700, static_cast<char>('a' + i % 26));
+        writeRecord(ring, UINT64_C(1) << slot, record);
+        ASSERT_EQ(record, readRecord(ring)) << "record " << i;
+    }
+    EXPECT_EQ(0, celix_shmEventRing_getOverrunCount(ring));
+}
+
+TEST_F(ShmEventRingTestSuite, OverrunTest) {
+    celix_autoptr(celix_shm_event_ring_t) publisher = nullptr;
+    celix_autoptr(celix_shm_event_ring_t) reader = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 4096, &publisher));
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 4096, &reader));
+    int slot;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_subscribe(reader, "reader", "*", &slot));
+
+    //a publisher never waits for a slow reader, the oldest records are overwritten
+    for (int i = 0; i < 100; ++i) {
+        writeRecord(publisher, UINT64_C(1) << slot, std::string(100, 'a') + std::to_string(i));
+    }
+    std::string record = readRecord(reader);
+    EXPECT_EQ(1, celix_shmEventRing_getOverrunCount(reader));
+    EXPECT_NE(std::string(100, 'a') + "0", record);
+
+    //the reader continues with the oldest record still available, up to the last record
+    std::string last = record;
+    for (std::string next = readRecord(reader); next.rfind("status", 0) != 0; next = readRecord(reader)) {
+        last = next;
+    }
+    EXPECT_EQ(std::string(100, 'a') + "99", last);
+    EXPECT_EQ(1, celix_shmEventRing_getOverrunCount(reader));
+}
+
+TEST_F(ShmEventRingTestSuite, BlockingReadAndInterruptTest) {
+    celix_autoptr(celix_shm_event_ring_t) publisher = nullptr;
+    celix_autoptr(celix_shm_event_ring_t) reader = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 4096, &publisher));
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 4096, &reader));
+    int slot;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_subscribe(reader, "reader", "*", &slot));
+
+    std::thread writer{[&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        writeRecord(publisher, UINT64_C(1) << slot, "wakeup");
+    }};
+    EXPECT_EQ("wakeup", readRecord(reader, 5000));
+    writer.join();
+
+    std::thread interrupter{[&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        celix_shmEventRing_interrupt(reader);
+    }};
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ("status " + std::to_string(RING_TIMEOUT), readRecord(reader, 5000));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds{4});
+    interrupter.join();
+}
+
+TEST_F(ShmEventRingTestSuite, ConcurrentWritersTest) {
+    celix_autoptr(celix_shm_event_ring_t) reader = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 1024 * 1024, &reader));
+    int slot;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_subscribe(reader, "reader", "*", &slot));
+
+    constexpr int nrOfWriters = 4;
+    constexpr int nrOfRecords = 1000;
+    std::vector<std::thread> writers{};
+    for (int w = 0; w < nrOfWriters; ++w) {
+        writers.emplace_back([&, w] {
+            celix_shm_event_ring_t* ring = nullptr;
+            ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 4096, &ring));
+            for (int i = 0; i < nrOfRecords; ++i) {
+                writeRecord(ring, UINT64_C(1) << slot, std::to_string(w) + ":" + std::to_string(i));
+            }
+            celix_shmEventRing_close(ring);
+        });
+    }
+
+    //records of a single writer are read in order
+    std::vector<int> next(nrOfWriters, 0);
+    for (int i = 0; i < nrOfWriters * nrOfRecords; ++i) {
+        std::string record = readRecord(reader, 5000);
+        auto sep = record.find(':');
+        ASSERT_NE(std::string::npos, sep) << record;
+        int w = std::stoi(record.substr(0, sep));
+        EXPECT_EQ(next[w]++, std::stoi(record.substr(sep + 1)));
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    EXPECT_EQ(0, celix_shmEventRing_getOverrunCount(reader));
+}
+
+TEST_F(ShmEventRingTestSuite, SubscriberSlotsTest) {
+    celix_autoptr(celix_shm_event_ring_t) ring = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 4096, &ring));
+    std::vector<celix_shm_event_ring_t*> handles{};
+    for (int i = 0; i < CELIX_SHM_EVENT_RING_MAX_SUBSCRIBERS; ++i) {
+        celix_shm_event_ring_t* handle = nullptr;
+        ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 4096, &handle));
+        int slot;
+        EXPECT_EQ(CELIX_SUCCESS, celix_shmEventRing_subscribe(handle, "sub", "*", &slot));
+        EXPECT_EQ(i, slot);
+        handles.push_back(handle);
+    }
+    int slot;
+    EXPECT_EQ(CELIX_ENOMEM, celix_shmEventRing_subscribe(ring, "sub", "*", &slot));
+
+    //closing a handle frees its slot
+    celix_shmEventRing_close(handles[10]);
+    handles.erase(handles.begin() + 10);
+    EXPECT_EQ(CELIX_SUCCESS, celix_shmEventRing_subscribe(ring, "sub", "*", &slot));
+    EXPECT_EQ(10, slot);
+
+    std::string tooLong(CELIX_SHM_EVENT_RING_MAX_TOPICS_LENGTH, 'x');
+    celix_shmEventRing_unsubscribe(ring);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_shmEventRing_subscribe(ring, "sub", tooLong.c_str(), &slot));
+
+    for (auto* handle : handles) {
+        celix_shmEventRing_close(handle);
+    }
+}
+
+TEST_F(ShmEventRingTestSuite, SubscriberOfTerminatedProcessIsReclaimedTest) {
+    celix_autoptr(celix_shm_event_ring_t) ring = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_open(name.c_str(), 4096, &ring));
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        celix_shm_event_ring_t* childRing = nullptr;
+        int childSlot;
+        bool ok = celix_shmEventRing_open(name.c_str(), 4096, &childRing) == CELIX_SUCCESS &&
+                  celix_shmEventRing_subscribe(childRing, "child", "*", &childSlot) == CELIX_SUCCESS;
+        _exit(ok ? 0 : 1); //terminate without closing the ring
+    }
+    int childStatus = -1;
+    ASSERT_EQ(child, waitpid(child, &childStatus, 0));
+    ASSERT_EQ(0, childStatus);
+
+    uint64_t generation;
+    std::vector<celix_shm_event_ring_subscription_t> subs{CELIX_SHM_EVENT_RING_MAX_SUBSCRIBERS};
+    ASSERT_EQ(1, celix_shmEventRing_getSubscriptions(ring, subs.data(), &generation));
+    EXPECT_STREQ("child", subs[0].id);
+
+    //the slot of the terminated child is reclaimed
+    int slot;
+    ASSERT_EQ(CELIX_SUCCESS, celix_shmEventRing_subscribe(ring, "parent", "*", &slot));
+    EXPECT_EQ(0, slot);
+    ASSERT_EQ(1, celix_shmEventRing_getSubscriptions(ring, subs.data(), &generation));
+    EXPECT_STREQ("parent", subs[0].id);
+}
@@ -0,0 +1,358 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "celix_event_codec.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "celix_array_list.h"
+#include "celix_err.h"
+#include "celix_version.h"
+
+#define CELIX_EVENT_CODEC_FORMAT_VERSION 1
+
+typedef struct celix_event_encoder {
+    uint8_t* buf;
+    size_t size;
+    size_t pos;//can exceed size, in that case nothing is written anymore
+} celix_event_encoder_t;
+
+typedef struct celix_event_decoder {
+    const uint8_t* data;
+    size_t len;
+    size_t pos;
+} celix_event_decoder_t;
+
+static void celix_eventCodec_writeBytes(celix_event_encoder_t* enc, const void* bytes, size_t n) {
+    if (enc->pos + n <= enc->size) {
+        memcpy(enc->buf + enc->pos, bytes, n);
+    }
+    enc->pos += n;
+}
+
+static void celix_eventCodec_writeByte(celix_event_encoder_t* enc, uint8_t byte) {
+    celix_eventCodec_writeBytes(enc, &byte, 1);
+}
+
+static void celix_eventCodec_writeVarint(celix_event_encoder_t* enc, uint64_t val) {
+    uint8_t bytes[10];
+    size_t n = 0;
+    do {
+        uint8_t byte = val & 0x7F;
+        val >>= 7;
+        bytes[n++] = val != 0 ? (byte | 0x80) : byte;
+    } while (val != 0);
+    celix_eventCodec_writeBytes(enc, bytes, n);
+}
+
+static void celix_eventCodec_writeLong(celix_event_encoder_t* enc, long val) {
+    int64_t v = val;
+    celix_eventCodec_writeVarint(enc, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));//zigzag, small negative numbers stay small
+}
+
+static void celix_eventCodec_writeString(celix_event_encoder_t* enc, const char* str) {
+    size_t len = strlen(str);
+    celix_eventCodec_writeVarint(enc, len);
+    celix_eventCodec_writeBytes(enc, str, len + 1);
+}
+
+static void celix_eventCodec_writeVersion(celix_event_encoder_t* enc, const celix_version_t* version) {
+    celix_eventCodec_writeVarint(enc, (uint64_t)celix_version_getMajor(version));
+    celix_eventCodec_writeVarint(enc, (uint64_t)celix_version_getMinor(version));
+    celix_eventCodec_writeVarint(enc, (uint64_t)celix_version_getMicro(version));
+    celix_eventCodec_writeString(enc, celix_version_getQualifier(version));
+}
+
+static void celix_eventCodec_writeArrayList(celix_event_encoder_t* enc, const celix_array_list_t* list) {
+    celix_array_list_element_type_t elType = celix_arrayList_getElementType(list);
+    int size = celix_arrayList_size(list);
+    celix_eventCodec_writeByte(enc, (uint8_t)elType);
+    celix_eventCodec_writeVarint(enc, (uint64_t)size);
+    for (int i = 0; i < size; ++i) {
+        switch (elType) {
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING:
+            celix_eventCodec_writeString(enc, celix_arrayList_getString(list, i));
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG:
+            celix_eventCodec_writeLong(enc, celix_arrayList_getLong(list, i));
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE: {
+            double d = celix_arrayList_getDouble(list, i);
+            celix_eventCodec_writeBytes(enc, &d, sizeof(d));
+            break;
+        }
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL:
+            celix_eventCodec_writeByte(enc, celix_arrayList_getBool(list, i) ? 1 : 0);
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION:
+            celix_eventCodec_writeVersion(enc, celix_arrayList_getVersion(list, i));
+            break;
+        default:
+            //properties only contain string, long, double, bool and version array lists
+            break;
+        }
+    }
+}
+
+size_t celix_eventCodec_encode(const char* originId, const char* topic, const celix_properties_t* props, void* buf,
+                               size_t bufSize) {
+    celix_event_encoder_t enc = {.buf = buf, .size = bufSize, .pos = 0};
+    celix_eventCodec_writeByte(&enc, CELIX_EVENT_CODEC_FORMAT_VERSION);
+    celix_eventCodec_writeString(&enc, originId);
+    celix_eventCodec_writeString(&enc, topic);
+    celix_eventCodec_writeVarint(&enc, props == NULL ? 0 : celix_properties_size(props));
+    if (props == NULL) {
+        return enc.pos;
+    }
+    CELIX_PROPERTIES_ITERATE(props, iter) {
+        celix_eventCodec_writeString(&enc, iter.key);
+        celix_eventCodec_writeByte(&enc, (uint8_t)iter.entry.valueType);
+        switch (iter.entry.valueType) {
+        case CELIX_PROPERTIES_VALUE_TYPE_LONG:
+            celix_eventCodec_writeLong(&enc, iter.entry.typed.longValue);
+            break;
+        case CELIX_PROPERTIES_VALUE_TYPE_DOUBLE:
+            celix_eventCodec_writeBytes(&enc, &iter.entry.typed.doubleValue, sizeof(double));
+            break;
+        case CELIX_PROPERTIES_VALUE_TYPE_BOOL:
+            celix_eventCodec_writeByte(&enc, iter.entry.typed.boolValue ? 1 : 0);
+            break;
+        case CELIX_PROPERTIES_VALUE_TYPE_VERSION:
+            celix_eventCodec_writeVersion(&enc, iter.entry.typed.versionValue);
+            break;
+        case CELIX_PROPERTIES_VALUE_TYPE_ARRAY_LIST:
+            celix_eventCodec_writeArrayList(&enc, iter.entry.typed.arrayValue);
+            break;
+        default:
+            celix_eventCodec_writeString(&enc, iter.entry.value);
+            break;
+        }
+    }
+    return enc.pos;
+}
+
+static bool celix_eventCodec_readByte(celix_event_decoder_t* dec, uint8_t* byte) {
+    if (dec->pos >= dec->len) {
+        return false;
+    }
+    *byte = dec->data[dec->pos++];
+    return true;
+}
+
+static bool celix_eventCodec_readVarint(celix_event_decoder_t* dec, uint64_t* val) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte;
+        if (!celix_eventCodec_readByte(dec, &byte)) {
+            return false;
+        }
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *val = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool celix_eventCodec_readLong(celix_event_decoder_t* dec, long* val) {
+    uint64_t v;
+    if (!celix_eventCodec_readVarint(dec, &v)) {
+        return false;
+    }
+    *val = (long)(int64_t)((v >> 1) ^ (~(v & 1) + 1));
+    return true;
+}
+
+static bool celix_eventCodec_readInt(celix_event_decoder_t* dec, int* val) {
+    uint64_t v;
+    if (!celix_eventCodec_readVarint(dec, &v) || v > INT32_MAX) {
+        return false;
+    }
+    *val = (int)v;
+    return true;
+}
+
+static bool celix_eventCodec_readDouble(celix_event_decoder_t* dec, double* val) {
+    if (dec->len - dec->pos < sizeof(*val)) {
+        return false;
+    }
+    memcpy(val, dec->data + dec->pos, sizeof(*val));
+    dec->pos += sizeof(*val);
+    return true;
+}
+
+static bool celix_eventCodec_readString(celix_event_decoder_t* dec, const char** str) {
+    uint64_t len;
+    if (!celix_eventCodec_readVarint(dec, &len) || len >= dec->len - dec->pos || dec->data[dec->pos + len] != '\0') {
+        return false;
+    }
+    *str = (const char*)(dec->data + dec->pos);
+    dec->pos += len + 1;
+    return true;
+}
+
+static celix_version_t* celix_eventCodec_readVersion(celix_event_decoder_t* dec, celix_status_t* status) {
+    int major, minor, micro;
+    const char* qualifier;
+    if (!celix_eventCodec_readInt(dec, &major) || !celix_eventCodec_readInt(dec, &minor) ||
+        !celix_eventCodec_readInt(dec, &micro) || !celix_eventCodec_readString(dec, &qualifier)) {
+        *status = CELIX_ILLEGAL_ARGUMENT;
+        return NULL;
+    }
+    celix_version_t* version = celix_version_create(major, minor, micro, qualifier);
+    *status = version == NULL ? CELIX_ENOMEM : CELIX_SUCCESS;
+    return version;
+}
+
+static celix_array_list_t* celix_eventCodec_readArrayList(celix_event_decoder_t* dec, celix_status_t* status) {
+    uint8_t elType;
+    uint64_t size;
+    if (!celix_eventCodec_readByte(dec, &elType) || !celix_eventCodec_readVarint(dec, &size) ||
+        size > dec->len - dec->pos) {//every element takes at least one byte
+        *status = CELIX_ILLEGAL_ARGUMENT;
+        return NULL;
+    }
+    celix_autoptr(celix_array_list_t) list = NULL;
+    switch (elType) {
+    case CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING:
+        list = celix_arrayList_createStringArray();
+        break;
+    case CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG:
+        list = celix_arrayList_createLongArray();
+        break;
+    case CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE:
+        list = celix_arrayList_createDoubleArray();
+        break;
+    case CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL:
+        list = celix_arrayList_createBoolArray();
+        break;
+    case CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION:
+        list = celix_arrayList_createVersionArray();
+        break;
+    default:
+        *status = CELIX_ILLEGAL_ARGUMENT;
+        return NULL;
+    }
+    if (list == NULL) {
+        *status = CELIX_ENOMEM;
+        return NULL;
+    }
+    *status = CELIX_SUCCESS;
+    for (uint64_t i = 0; i < size && *status == CELIX_SUCCESS; ++i) {
+        switch (elType) {
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING: {
+            const char* str;
+            *status = celix_eventCodec_readString(dec, &str) ? celix_arrayList_addString(list, str) : CELIX_ILLEGAL_ARGUMENT;
+            break;
+        }
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG: {
+            long l;
+            *status = celix_eventCodec_readLong(dec, &l) ? celix_arrayList_addLong(list, l) : CELIX_ILLEGAL_ARGUMENT;
+            break;
+        }
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE: {
+            double d;
+            *status = celix_eventCodec_readDouble(dec, &d) ? celix_arrayList_addDouble(list, d) : CELIX_ILLEGAL_ARGUMENT;
+            break;
+        }
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL: {
+            uint8_t b;
+            *status = celix_eventCodec_readByte(dec, &b) ? celix_arrayList_addBool(list, b != 0) : CELIX_ILLEGAL_ARGUMENT;
+            break;
+        }
+        default: {
+            celix_version_t* version = celix_eventCodec_readVersion(dec, status);
+            if (version != NULL) {
+                *status = celix_arrayList_assignVersion(list, version);
+            }
+            break;
+        }
+        }
+    }
+    return *status == CELIX_SUCCESS ? celix_steal_ptr(list) : NULL;
+}
+
+static celix_status_t celix_eventCodec_readEntry(celix_event_decoder_t* dec, celix_properties_t* props) {
+    const char* key;
+    uint8_t type;
+    if (!celix_eventCodec_readString(dec, &key) || !celix_eventCodec_readByte(dec, &type)) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_status_t status = CELIX_SUCCESS;
+    switch (type) {
+    case CELIX_PROPERTIES_VALUE_TYPE_STRING: {
+        const char* str;
+        return celix_eventCodec_readString(dec, &str) ? celix_properties_set(props, key, str) : CELIX_ILLEGAL_ARGUMENT;
+    }
+    case CELIX_PROPERTIES_VALUE_TYPE_LONG: {
+        long l;
+        return celix_eventCodec_readLong(dec, &l) ? celix_properties_setLong(props, key, l) : CELIX_ILLEGAL_ARGUMENT;
+    }
+    case CELIX_PROPERTIES_VALUE_TYPE_DOUBLE: {
+        double d;
+        return celix_eventCodec_readDouble(dec, &d) ? celix_properties_setDouble(props, key, d) : CELIX_ILLEGAL_ARGUMENT;
+    }
+    case CELIX_PROPERTIES_VALUE_TYPE_BOOL: {
+        uint8_t b;
+        return celix_eventCodec_readByte(dec, &b) ? celix_properties_setBool(props, key, b != 0) : CELIX_ILLEGAL_ARGUMENT;
+    }
+    case CELIX_PROPERTIES_VALUE_TYPE_VERSION: {
+        celix_version_t* version = celix_eventCodec_readVersion(dec, &status);
+        return version != NULL ? celix_properties_assignVersion(props, key, version) : status;
+    }
+    case CELIX_PROPERTIES_VALUE_TYPE_ARRAY_LIST: {
+        celix_array_list_t* list = celix_eventCodec_readArrayList(dec, &status);
+        return list != NULL ? celix_properties_assignArrayList(props, key, list) : status;
+    }
+    default:
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+}
+
+celix_status_t celix_eventCodec_decode(const void* data, size_t len, const char** originId, const char** topic,
+                                       celix_properties_t** props) {
+    celix_event_decoder_t dec = {.data = data, .len = len, .pos = 0};
+    uint8_t formatVersion;
+    uint64_t nrOfEntries;
+    if (!celix_eventCodec_readByte(&dec, &formatVersion) || formatVersion != CELIX_EVENT_CODEC_FORMAT_VERSION ||
+        !celix_eventCodec_readString(&dec, originId) || !celix_eventCodec_readString(&dec, topic) ||
+        !celix_eventCodec_readVarint(&dec, &nrOfEntries)) {
+        celix_err_push("Invalid encoded event header.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_autoptr(celix_properties_t) result = celix_properties_create();
+    if (result == NULL) {
+        return CELIX_ENOMEM;
+    }
+    for (uint64_t i = 0; i < nrOfEntries; ++i) {
+        celix_status_t status = celix_eventCodec_readEntry(&dec, result);
+        if (status != CELIX_SUCCESS) {
+            celix_err_push("Invalid encoded event property.");
+            return status;
+        }
+    }
+    if (dec.pos != dec.len) {
+        celix_err_push("Trailing data after encoded event.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    *props = celix_steal_ptr(result);
+    return CELIX_SUCCESS;
+}
@@ -0,0 +1,70 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_EVENT_CODEC_H
+#define CELIX_EVENT_CODEC_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#include "celix_errno.h"
+#include "celix_properties.h"
+
+/**
+ * @brief Encodes an event into the compact binary event format used by the shared memory remote provider.
+ *
+ * The format is host specific (native byte order) and only meant to be exchanged between processes on the same host.
+ * Strings are written as a varint length followed by the string bytes and a terminating '\0', integers are written as
+ * (zigzag) varints and doubles as their native 8 bytes representation. All property value types are supported.
+ *
+ * Behaves like snprintf: the encoded event is only written if it fits in the provided buffer, but the returned size is
+ * always the size of the encoded event.
+ *
+ * @param[in] originId The id of the framework publishing the event.
+ * @param[in] topic The topic of the event.
+ * @param[in] props The properties of the event. Can be NULL.
+ * @param[out] buf The buffer to encode the event in. Can be NULL if bufSize is 0.
+ * @param[in] bufSize The size of the buffer.
+ * @return The size of the encoded event.
+ */
+size_t celix_eventCodec_encode(const char* originId, const char* topic, const celix_properties_t* props, void* buf,
+                               size_t bufSize);
+
+/**
+ * @brief Decodes an event encoded with celix_eventCodec_encode.
+ *
+ * The returned originId and topic point into the provided data and are only valid as long as the data is valid.
+ *
+ * @param[in] data The encoded event.
+ * @param[in] len The size of the encoded event.
+ * @param[out] originId The id of the framework that published the event.
+ * @param[out] topic The topic of the event.
+ * @param[out] props The decoded event properties. The caller is the owner.
+ * @return CELIX_SUCCESS, CELIX_ILLEGAL_ARGUMENT if the data is not a valid encoded event or CELIX_ENOMEM.
+ */
+celix_status_t celix_eventCodec_decode(const void* data, size_t len, const char** originId, const char** topic,
+                                       celix_properties_t** props);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //CELIX_EVENT_CODEC_H
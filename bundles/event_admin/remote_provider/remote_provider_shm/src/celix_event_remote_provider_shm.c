@@ -0,0 +1,361 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "celix_event_remote_provider_shm.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "celix_constants.h"
+#include "celix_event_admin_service.h"
+#include "celix_event_codec.h"
+#include "celix_event_constants.h"
+#include "celix_event_remote_provider_shm_constants.h"
+#include "celix_log_helper.h"
+#include "celix_shm_event_ring.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_string_hash_map.h"
+#include "celix_threads.h"
+#include "celix_utils.h"
+
+#define CELIX_EVENT_REMOTE_PROVIDER_SHM_READ_TIMEOUT_IN_MS 200
+#define CELIX_EVENT_REMOTE_PROVIDER_SHM_ENCODE_BUFFER_SIZE 1024
+#define CELIX_EVENT_REMOTE_PROVIDER_SHM_MAX_CACHED_TOPICS 1024
+
+struct celix_event_remote_provider_shm {
+    celix_bundle_context_t* ctx;
+    celix_log_helper_t* logHelper;
+    char* fwUUID;
+    char* channel;
+    char* exportTopics;
+    char* importTopics;
+    celix_shm_event_ring_t* ring;
+    celix_thread_rwlock_t lock;//protects eventAdminService
+    celix_event_admin_service_t* eventAdminService;
+    celix_thread_mutex_t targetsMutex;//protects below
+    uint64_t subscriptionsGeneration;
+    size_t nrOfSubscriptions;
+    celix_shm_event_ring_subscription_t* subscriptions;
+    celix_string_hash_map_t* targetMasks;//key: topic, value: target mask of the remote subscribers
+    bool receiving;//atomic
+    celix_thread_t receiveThread;
+};
+
+static char* celix_eventRemoteProviderShm_dupProperty(celix_event_remote_provider_shm_t* provider, const char* key,
+                                                      const char* defaultValue, bool* failed) {
+    const char* value = celix_bundleContext_getProperty(provider->ctx, key, defaultValue);
+    if (value == NULL) {
+        return NULL;
+    }
+    char* result = celix_utils_strdup(value);
+    if (result == NULL) {
+        celix_logHelper_error(provider->logHelper, "Failed to dup property %s.", key);
+        *failed = true;
+    }
+    return result;
+}
+
+celix_event_remote_provider_shm_t* celix_eventRemoteProviderShm_create(celix_bundle_context_t* ctx) {
+    celix_autoptr(celix_log_helper_t) logHelper = celix_logHelper_create(ctx, "CelixEventRemoteProviderShm");
+    if (logHelper == NULL) {
+        return NULL;
+    }
+    celix_autofree celix_event_remote_provider_shm_t* provider = calloc(1, sizeof(*provider));
+    if (provider == NULL) {
+        celix_logHelper_error(logHelper, "Failed to allocate memory for event remote provider.");
+        return NULL;
+    }
+    provider->ctx = ctx;
+    provider->logHelper = logHelper;
+
+    bool failed = false;
+    celix_autofree char* fwUUID = provider->fwUUID =
+        celix_eventRemoteProviderShm_dupProperty(provider, CELIX_FRAMEWORK_UUID, "", &failed);
+    celix_autofree char* channel = provider->channel = celix_eventRemoteProviderShm_dupProperty(
+        provider, CELIX_EVENT_REMOTE_PROVIDER_SHM_CHANNEL, CELIX_EVENT_REMOTE_PROVIDER_SHM_CHANNEL_DEFAULT, &failed);
+    celix_autofree char* exportTopics = provider->exportTopics =
+        celix_eventRemoteProviderShm_dupProperty(provider, CELIX_EVENT_REMOTE_PROVIDER_SHM_EXPORT_TOPICS, NULL, &failed);
+    celix_autofree char* importTopics = provider->importTopics =
+        celix_eventRemoteProviderShm_dupProperty(provider, CELIX_EVENT_REMOTE_PROVIDER_SHM_IMPORT_TOPICS, NULL, &failed);
+    if (failed) {
+        return NULL;
+    }
+    if (exportTopics == NULL && importTopics == NULL) {
+        celix_logHelper_warning(logHelper, "Neither %s nor %s is configured, no events will be exchanged.",
+                                CELIX_EVENT_REMOTE_PROVIDER_SHM_EXPORT_TOPICS,
+                                CELIX_EVENT_REMOTE_PROVIDER_SHM_IMPORT_TOPICS);
+    }
+
+    celix_autofree celix_shm_event_ring_subscription_t* subscriptions = provider->subscriptions =
+        calloc(CELIX_SHM_EVENT_RING_MAX_SUBSCRIBERS, sizeof(*subscriptions));
+    if (subscriptions == NULL) {
+        celix_logHelper_error(logHelper, "Failed to allocate memory for subscriptions.");
+        return NULL;
+    }
+    celix_autoptr(celix_string_hash_map_t) targetMasks = provider->targetMasks = celix_stringHashMap_create();
+    if (targetMasks == NULL) {
+        celix_logHelper_logTssErrors(logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(logHelper, "Failed to create target masks map.");
+        return NULL;
+    }
+
+    long ringSize = celix_bundleContext_getPropertyAsLong(ctx, CELIX_EVENT_REMOTE_PROVIDER_SHM_RING_SIZE,
+                                                          CELIX_EVENT_REMOTE_PROVIDER_SHM_RING_SIZE_DEFAULT);
+    celix_status_t status = celix_shmEventRing_open(channel, ringSize < 0 ? 0 : (size_t)ringSize, &provider->ring);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_logTssErrors(logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(logHelper, "Failed to open shm event channel %s.", channel);
+        return NULL;
+    }
+    celix_autoptr(celix_shm_event_ring_t) ring = provider->ring;
+    if (celix_shmEventRing_getCapacity(ring) < (size_t)ringSize) {
+        celix_logHelper_warning(logHelper, "Shm event channel %s already exists with a smaller size of %zu bytes.",
+                                channel, celix_shmEventRing_getCapacity(ring));
+    }
+
+    status = celixThreadRwlock_create(&provider->lock, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Failed to create event remote provider lock.");
+        return NULL;
+    }
+    celix_autoptr(celix_thread_rwlock_t) lock = &provider->lock;
+    status = celixThreadMutex_create(&provider->targetsMutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Failed to create event remote provider targets mutex.");
+        return NULL;
+    }
+    //ensure the subscriptions are loaded for the first event
+    provider->subscriptionsGeneration = celix_shmEventRing_getSubscriptionsGeneration(ring) - 1;
+
+    celix_steal_ptr(lock);
+    celix_steal_ptr(ring);
+    celix_steal_ptr(targetMasks);
+    celix_steal_ptr(subscriptions);
+    celix_steal_ptr(importTopics);
+    celix_steal_ptr(exportTopics);
+    celix_steal_ptr(channel);
+    celix_steal_ptr(fwUUID);
+    celix_steal_ptr(logHelper);
+    return celix_steal_ptr(provider);
+}
+
+void celix_eventRemoteProviderShm_destroy(celix_event_remote_provider_shm_t* provider) {
+    if (provider == NULL) {
+        return;
+    }
+    celixThreadMutex_destroy(&provider->targetsMutex);
+    celixThreadRwlock_destroy(&provider->lock);
+    celix_shmEventRing_close(provider->ring);
+    celix_stringHashMap_destroy(provider->targetMasks);
+    free(provider->subscriptions);
+    free(provider->importTopics);
+    free(provider->exportTopics);
+    free(provider->channel);
+    free(provider->fwUUID);
+    celix_logHelper_destroy(provider->logHelper);
+    free(provider);
+}
+
+const char* celix_eventRemoteProviderShm_getExportTopics(const celix_event_remote_provider_shm_t* provider) {
+    return provider->exportTopics;
+}
+
+int celix_eventRemoteProviderShm_setEventAdminService(void* handle, void* eventAdminService) {
+    celix_event_remote_provider_shm_t* provider = handle;
+    celixThreadRwlock_writeLock(&provider->lock);
+    provider->eventAdminService = eventAdminService;
+    celixThreadRwlock_unlock(&provider->lock);
+    return CELIX_SUCCESS;
+}
+
+static void celix_eventRemoteProviderShm_deliverRecord(celix_event_remote_provider_shm_t* provider, const void* data,
+                                                       size_t len) {
+    const char* originId = NULL;
+    const char* topic = NULL;
+    celix_autoptr(celix_properties_t) props = NULL;
+    celix_status_t status = celix_eventCodec_decode(data, len, &originId, &topic, &props);
+    if (status == CELIX_SUCCESS) {
+        status = celix_properties_set(props, CELIX_EVENT_FRAMEWORK_UUID, originId);
+    }
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_logTssErrors(provider->logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(provider->logHelper, "Failed to decode event from channel %s.", provider->channel);
+        return;
+    }
+    //frozen properties are shared with the event admin instead of being copied for the async delivery
+    celix_properties_freeze(props);
+    celix_auto(celix_rwlock_rlock_guard_t) rLockGuard = celixRwlockRlockGuard_init(&provider->lock);
+    if (provider->eventAdminService != NULL) {
+        status = provider->eventAdminService->postEvent(provider->eventAdminService->handle, topic, props);
+        if (status != CELIX_SUCCESS) {
+            celix_logHelper_error(provider->logHelper, "Failed to post remote event %s, %d.", topic, status);
+        }
+    }
+}
+
+static void* celix_eventRemoteProviderShm_receiveThread(void* data) {
+    celix_event_remote_provider_shm_t* provider = data;
+    uint64_t overruns = 0;
+    while (__atomic_load_n(&provider->receiving, __ATOMIC_ACQUIRE)) {
+        const void* record = NULL;
+        size_t len = 0;
+        celix_status_t status = celix_shmEventRing_read(provider->ring, CELIX_EVENT_REMOTE_PROVIDER_SHM_READ_TIMEOUT_IN_MS,
+                                                        &record, &len);
+        if (status == CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, ETIMEDOUT)) {
+            continue;
+        } else if (status != CELIX_SUCCESS) {
+            celix_logHelper_logTssErrors(provider->logHelper, CELIX_LOG_LEVEL_ERROR);
+            celix_logHelper_error(provider->logHelper, "Failed to read from channel %s, %d.", provider->channel, status);
+            continue;
+        }
+        uint64_t currentOverruns = celix_shmEventRing_getOverrunCount(provider->ring);
+        if (currentOverruns != overruns) {
+            celix_logHelper_warning(provider->logHelper,
+                                    "Events of channel %s were overwritten before they could be received (%lu overruns).",
+                                    provider->channel, (unsigned long)currentOverruns);
+            overruns = currentOverruns;
+        }
+        celix_eventRemoteProviderShm_deliverRecord(provider, record, len);
+    }
+    return NULL;
+}
+
+int celix_eventRemoteProviderShm_start(celix_event_remote_provider_shm_t* provider) {
+    if (provider->importTopics == NULL) {
+        return CELIX_SUCCESS;
+    }
+    int slot;
+    celix_status_t status = celix_shmEventRing_subscribe(provider->ring, provider->fwUUID, provider->importTopics, &slot);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_logTssErrors(provider->logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(provider->logHelper, "Failed to subscribe to channel %s.", provider->channel);
+        return status;
+    }
+    __atomic_store_n(&provider->receiving, true, __ATOMIC_RELEASE);
+    status = celixThread_create(&provider->receiveThread, NULL, celix_eventRemoteProviderShm_receiveThread, provider);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(provider->logHelper, "Failed to create receive thread for channel %s.", provider->channel);
+        __atomic_store_n(&provider->receiving, false, __ATOMIC_RELEASE);
+        celix_shmEventRing_unsubscribe(provider->ring);
+        return status;
+    }
+    celixThread_setName(&provider->receiveThread, "CelixEventShm");
+    celix_logHelper_debug(provider->logHelper, "Receiving %s events from channel %s in slot %i.",
+                          provider->importTopics, provider->channel, slot);
+    return CELIX_SUCCESS;
+}
+
+int celix_eventRemoteProviderShm_stop(celix_event_remote_provider_shm_t* provider) {
+    if (__atomic_exchange_n(&provider->receiving, false, __ATOMIC_ACQ_REL)) {
+        celix_shmEventRing_interrupt(provider->ring);
+        celixThread_join(provider->receiveThread, NULL);
+        celix_shmEventRing_unsubscribe(provider->ring);
+    }
+    return CELIX_SUCCESS;
+}
+
+static bool celix_eventRemoteProviderShm_topicMatches(const char* pattern, const char* topic) {
+    size_t patternLen = strlen(pattern);
+    if (patternLen == 1 && pattern[0] == '*') {
+        return true;
+    } else if (patternLen > 2 && pattern[patternLen - 1] == '*' && pattern[patternLen - 2] == '/') {
+        //"com/acme/*" matches all topics below "com/acme", including the slash in the compared prefix
+        return strlen(topic) >= patternLen && strncmp(pattern, topic, patternLen - 1) == 0;
+    }
+    return strcmp(pattern, topic) == 0;
+}
+
+static bool celix_eventRemoteProviderShm_topicsMatch(const char* topics, const char* topic) {
+    char topicsCopy[CELIX_SHM_EVENT_RING_MAX_TOPICS_LENGTH];
+    snprintf(topicsCopy, sizeof(topicsCopy), "%s", topics);
+    char* savePtr = NULL;
+    for (char* token = strtok_r(topicsCopy, ",", &savePtr); token != NULL; token = strtok_r(NULL, ",", &savePtr)) {
+        if (celix_eventRemoteProviderShm_topicMatches(celix_utils_trimInPlace(token), topic)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Returns the mask of the remote subscribers interested in the topic.
+ *
+ * The topic filters of the subscribers are evaluated on the publisher side, once per topic and subscriptions
+ * generation, so that events without remote subscribers are not even encoded.
+ */
+static uint64_t celix_eventRemoteProviderShm_getTargetMask(celix_event_remote_provider_shm_t* provider,
+                                                           const char* topic) {
+    uint64_t generation = celix_shmEventRing_getSubscriptionsGeneration(provider->ring);
+    celix_auto(celix_mutex_lock_guard_t) lockGuard = celixMutexLockGuard_init(&provider->targetsMutex);
+    if (generation != provider->subscriptionsGeneration) {
+        provider->nrOfSubscriptions = celix_shmEventRing_getSubscriptions(provider->ring, provider->subscriptions,
+                                                                          &provider->subscriptionsGeneration);
+        celix_stringHashMap_clear(provider->targetMasks);
+    }
+    if (celix_stringHashMap_hasKey(provider->targetMasks, topic)) {
+        return (uint64_t)celix_stringHashMap_getLong(provider->targetMasks, topic, 0);
+    }
+    uint64_t mask = 0;
+    for (size_t i = 0; i < provider->nrOfSubscriptions; ++i) {
+        const celix_shm_event_ring_subscription_t* sub = &provider->subscriptions[i];
+        if (strcmp(sub->id, provider->fwUUID) != 0 && celix_eventRemoteProviderShm_topicsMatch(sub->topics, topic)) {
+            mask |= UINT64_C(1) << sub->slot;
+        }
+    }
+    if (celix_stringHashMap_size(provider->targetMasks) >= CELIX_EVENT_REMOTE_PROVIDER_SHM_MAX_CACHED_TOPICS) {
+        celix_stringHashMap_clear(provider->targetMasks);
+    }
+    if (celix_stringHashMap_putLong(provider->targetMasks, topic, (long)mask) != CELIX_SUCCESS) {
+        celix_logHelper_logTssErrors(provider->logHelper, CELIX_LOG_LEVEL_WARNING);
+    }
+    return mask;
+}
+
+celix_status_t celix_eventRemoteProviderShm_handleEvent(void* handle, const char* topic, const celix_properties_t* props) {
+    celix_event_remote_provider_shm_t* provider = handle;
+    assert(provider != NULL);
+    if (celix_properties_get(props, CELIX_EVENT_FRAMEWORK_UUID, NULL) != NULL) {
+        return CELIX_SUCCESS;//received from another framework, do not echo it
+    }
+    uint64_t targetMask = celix_eventRemoteProviderShm_getTargetMask(provider, topic);
+    if (targetMask == 0) {
+        return CELIX_SUCCESS;
+    }
+
+    char stackBuf[CELIX_EVENT_REMOTE_PROVIDER_SHM_ENCODE_BUFFER_SIZE];
+    void* buf = stackBuf;
+    celix_autofree void* heapBuf = NULL;
+    size_t size = celix_eventCodec_encode(provider->fwUUID, topic, props, stackBuf, sizeof(stackBuf));
+    if (size > sizeof(stackBuf)) {
+        buf = heapBuf = malloc(size);
+        if (heapBuf == NULL) {
+            celix_logHelper_error(provider->logHelper, "Failed to allocate memory to encode event %s.", topic);
+            return CELIX_ENOMEM;
+        }
+        celix_eventCodec_encode(provider->fwUUID, topic, props, buf, size);
+    }
+    celix_status_t status = celix_shmEventRing_write(provider->ring, targetMask, buf, size);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_logTssErrors(provider->logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(provider->logHelper, "Failed to forward event %s to channel %s.", topic, provider->channel);
+    }
+    return status;
+}
@@ -0,0 +1,53 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_EVENT_REMOTE_PROVIDER_SHM_H
+#define CELIX_EVENT_REMOTE_PROVIDER_SHM_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "celix_bundle_context.h"
+#include "celix_errno.h"
+#include "celix_properties.h"
+
+typedef struct celix_event_remote_provider_shm celix_event_remote_provider_shm_t;
+
+celix_event_remote_provider_shm_t* celix_eventRemoteProviderShm_create(celix_bundle_context_t* ctx);
+
+void celix_eventRemoteProviderShm_destroy(celix_event_remote_provider_shm_t* provider);
+
+int celix_eventRemoteProviderShm_start(celix_event_remote_provider_shm_t* provider);
+
+int celix_eventRemoteProviderShm_stop(celix_event_remote_provider_shm_t* provider);
+
+/**
+ * @brief Returns the configured export topics, or NULL if no events are forwarded.
+ */
+const char* celix_eventRemoteProviderShm_getExportTopics(const celix_event_remote_provider_shm_t* provider);
+
+int celix_eventRemoteProviderShm_setEventAdminService(void* handle, void* eventAdminService);
+
+celix_status_t celix_eventRemoteProviderShm_handleEvent(void* handle, const char* topic, const celix_properties_t* props);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //CELIX_EVENT_REMOTE_PROVIDER_SHM_H
@@ -0,0 +1,113 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <assert.h>
+
+#include "celix_errno.h"
+#include "celix_bundle_activator.h"
+#include "celix_event_admin_service.h"
+#include "celix_event_constants.h"
+#include "celix_event_handler_service.h"
+#include "celix_event_remote_provider_shm.h"
+
+typedef struct celix_event_remote_provider_shm_activator {
+    celix_event_remote_provider_shm_t* provider;
+    celix_event_handler_service_t eventHandlerService;
+} celix_event_remote_provider_shm_activator_t;
+
+static celix_status_t celix_eventRemoteProviderShmActivator_addEventHandlerInterface(
+    celix_event_remote_provider_shm_activator_t* act, celix_dm_component_t* cmp) {
+    act->eventHandlerService.handle = act->provider;
+    act->eventHandlerService.handleEvent = celix_eventRemoteProviderShm_handleEvent;
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    if (props == NULL) {
+        return CELIX_ENOMEM;
+    }
+    celix_status_t status = celix_properties_set(props, CELIX_EVENT_TOPIC,
+                                                 celix_eventRemoteProviderShm_getExportTopics(act->provider));
+    //in order forwarding, and events received from other frameworks are not forwarded again
+    status = CELIX_DO_IF(status, celix_properties_set(props, CELIX_EVENT_DELIVERY, CELIX_EVENT_DELIVERY_ASYNC_ORDERED));
+    status = CELIX_DO_IF(status, celix_properties_set(props, CELIX_EVENT_FILTER, "(!("CELIX_EVENT_FRAMEWORK_UUID"=*))"));
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    return celix_dmComponent_addInterface(cmp, CELIX_EVENT_HANDLER_SERVICE_NAME, CELIX_EVENT_HANDLER_SERVICE_VERSION,
+                                          &act->eventHandlerService, celix_steal_ptr(props));
+}
+
+celix_status_t celix_eventRemoteProviderShmActivator_start(celix_event_remote_provider_shm_activator_t* act,
+                                                           celix_bundle_context_t* ctx) {
+    assert(act != NULL);
+    assert(ctx != NULL);
+    celix_autoptr(celix_dm_component_t) cmp = celix_dmComponent_create(ctx, "EVENT_REMOTE_PROVIDER_SHM_CMP");
+    if (cmp == NULL) {
+        return CELIX_ENOMEM;
+    }
+    act->provider = celix_eventRemoteProviderShm_create(ctx);
+    if (act->provider == NULL) {
+        return CELIX_BUNDLE_EXCEPTION;
+    }
+    celix_dmComponent_setImplementation(cmp, act->provider);
+    CELIX_DM_COMPONENT_SET_CALLBACKS(cmp, celix_event_remote_provider_shm_t, NULL, celix_eventRemoteProviderShm_start,
+                                     celix_eventRemoteProviderShm_stop, NULL);
+    CELIX_DM_COMPONENT_SET_IMPLEMENTATION_DESTROY_FUNCTION(cmp, celix_event_remote_provider_shm_t,
+                                                           celix_eventRemoteProviderShm_destroy);
+
+    celix_status_t status = CELIX_SUCCESS;
+    {
+        celix_autoptr(celix_dm_service_dependency_t) eventAdminDep = celix_dmServiceDependency_create();
+        if (eventAdminDep == NULL) {
+            return CELIX_ENOMEM;
+        }
+        status = celix_dmServiceDependency_setService(eventAdminDep, CELIX_EVENT_ADMIN_SERVICE_NAME,
+                                                      CELIX_EVENT_ADMIN_SERVICE_USE_RANGE, NULL);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        celix_dmServiceDependency_setRequired(eventAdminDep, true);
+        celix_dmServiceDependency_setStrategy(eventAdminDep, DM_SERVICE_DEPENDENCY_STRATEGY_LOCKING);
+        celix_dm_service_dependency_callback_options_t opts = CELIX_EMPTY_DM_SERVICE_DEPENDENCY_CALLBACK_OPTIONS;
+        opts.set = celix_eventRemoteProviderShm_setEventAdminService;
+        celix_dmServiceDependency_setCallbacksWithOptions(eventAdminDep, &opts);
+        status = celix_dmComponent_addServiceDependency(cmp, eventAdminDep);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        celix_steal_ptr(eventAdminDep);
+    }
+
+    if (celix_eventRemoteProviderShm_getExportTopics(act->provider) != NULL) {
+        status = celix_eventRemoteProviderShmActivator_addEventHandlerInterface(act, cmp);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+
+    celix_dependency_manager_t* mng = celix_bundleContext_getDependencyManager(ctx);
+    if (mng == NULL) {
+        return CELIX_ENOMEM;
+    }
+    status = celix_dependencyManager_addAsync(mng, cmp);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    celix_steal_ptr(cmp);
+    return CELIX_SUCCESS;
+}
+
+CELIX_GEN_BUNDLE_ACTIVATOR(celix_event_remote_provider_shm_activator_t, celix_eventRemoteProviderShmActivator_start, NULL)
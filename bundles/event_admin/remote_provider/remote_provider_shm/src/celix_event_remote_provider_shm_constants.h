@@ -0,0 +1,54 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_EVENT_REMOTE_PROVIDER_SHM_CONSTANTS_H
+#define CELIX_EVENT_REMOTE_PROVIDER_SHM_CONSTANTS_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The name of the shared memory channel. Frameworks using the same channel exchange events.
+ */
+#define CELIX_EVENT_REMOTE_PROVIDER_SHM_CHANNEL "CELIX_EVENT_REMOTE_PROVIDER_SHM_CHANNEL"
+#define CELIX_EVENT_REMOTE_PROVIDER_SHM_CHANNEL_DEFAULT "celix_event_admin"
+
+/**
+ * @brief The topics of local events that are forwarded to other frameworks, using the CELIX_EVENT_TOPIC grammar.
+ * If not set, no events are forwarded.
+ */
+#define CELIX_EVENT_REMOTE_PROVIDER_SHM_EXPORT_TOPICS "CELIX_EVENT_REMOTE_PROVIDER_SHM_EXPORT_TOPICS"
+
+/**
+ * @brief The topics of events of other frameworks that are posted to the local event admin, using the
+ * CELIX_EVENT_TOPIC grammar. If not set, no events are received.
+ */
+#define CELIX_EVENT_REMOTE_PROVIDER_SHM_IMPORT_TOPICS "CELIX_EVENT_REMOTE_PROVIDER_SHM_IMPORT_TOPICS"
+
+/**
+ * @brief The size in bytes of the shared memory ring of a channel. Only used by the framework creating the channel.
+ */
+#define CELIX_EVENT_REMOTE_PROVIDER_SHM_RING_SIZE "CELIX_EVENT_REMOTE_PROVIDER_SHM_RING_SIZE"
+#define CELIX_EVENT_REMOTE_PROVIDER_SHM_RING_SIZE_DEFAULT (1024 * 1024)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //CELIX_EVENT_REMOTE_PROVIDER_SHM_CONSTANTS_H
@@ -0,0 +1,551 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "celix_shm_event_ring.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "celix_err.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_utils.h"
+
+#define CELIX_SHM_EVENT_RING_MAGIC 0x43455652 /* "CEVR" */
+#define CELIX_SHM_EVENT_RING_LAYOUT_VERSION 1
+#define CELIX_SHM_EVENT_RING_MIN_CAPACITY 4096
+#define CELIX_SHM_EVENT_RING_RECORD_ALIGNMENT 16
+#define CELIX_SHM_EVENT_RING_RECORD_PADDING 0x1
+#define CELIX_SHM_EVENT_RING_OPEN_ATTEMPTS 10
+#define CELIX_SHM_EVENT_RING_INIT_TIMEOUT_IN_SECONDS 1.0
+
+#define CELIX_SHM_EVENT_RING_TIMEOUT CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, ETIMEDOUT)
+#define CELIX_SHM_EVENT_RING_RETRY CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, EAGAIN)
+
+typedef struct celix_shm_event_ring_record_header {
+    uint32_t len;           //payload length
+    uint32_t flags;
+    uint64_t targetMask;
+} celix_shm_event_ring_record_header_t;
+
+typedef struct celix_shm_event_ring_subscriber {
+    bool active;
+    pid_t pid;
+    char id[CELIX_SHM_EVENT_RING_MAX_ID_LENGTH];
+    char topics[CELIX_SHM_EVENT_RING_MAX_TOPICS_LENGTH];
+} celix_shm_event_ring_subscriber_t;
+
+/**
+ * @brief The layout of the shared memory object.
+ *
+ * Records are written at monotonically increasing 64-bit positions, the position modulo the capacity is the offset
+ * in the data area. A record never wraps around the end of the data area, a padding record is used instead.
+ */
+typedef struct celix_shm_event_ring_shared {
+    uint32_t magic;                 //set (release) after the ring is initialized
+    uint32_t layoutVersion;
+    uint64_t capacity;
+    pthread_mutex_t mutex;          //process-shared and robust, serializes writers and protects the fields below
+    pthread_cond_t cond;            //process-shared, broadcast if a record is written and readers are waiting
+    uint32_t attachCount;
+    uint32_t waitingReaders;
+    bool unlinked;
+    uint64_t subscriptionsGeneration; //atomic
+    celix_shm_event_ring_subscriber_t subscribers[CELIX_SHM_EVENT_RING_MAX_SUBSCRIBERS];
+    uint64_t head __attribute__((aligned(64)));  //atomic, the position after the last completely written record
+    uint64_t tail __attribute__((aligned(64)));  //atomic, the position of the oldest record not being overwritten
+    uint8_t data[] __attribute__((aligned(64)));
+} celix_shm_event_ring_shared_t;
+
+struct celix_shm_event_ring {
+    char name[NAME_MAX];
+    int fd;
+    size_t mappedSize;
+    celix_shm_event_ring_shared_t* shared;
+    int slot;                   //-1 if not subscribed
+    uint64_t readPos;
+    uint64_t overruns;          //atomic
+    uint8_t* readBuf;
+    size_t readBufSize;
+    bool interrupted;           //atomic
+};
+
+static size_t celix_shmEventRing_recordSize(size_t payloadLen) {
+    size_t size = sizeof(celix_shm_event_ring_record_header_t) + payloadLen;
+    return (size + CELIX_SHM_EVENT_RING_RECORD_ALIGNMENT - 1) & ~((size_t)CELIX_SHM_EVENT_RING_RECORD_ALIGNMENT - 1);
+}
+
+static void celix_shmEventRing_lock(celix_shm_event_ring_shared_t* shared) {
+    if (pthread_mutex_lock(&shared->mutex) == EOWNERDEAD) {
+        //A process died while holding the lock. The ring is still consistent, because the head is only moved after
+        //a record is completely written.
+        pthread_mutex_consistent(&shared->mutex);
+    }
+}
+
+static void celix_shmEventRing_unlock(celix_shm_event_ring_shared_t* shared) {
+    pthread_mutex_unlock(&shared->mutex);
+}
+
+static celix_status_t celix_shmEventRing_initSync(celix_shm_event_ring_shared_t* shared) {
+    pthread_mutexattr_t mutexAttr;
+    pthread_mutexattr_init(&mutexAttr);
+    pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&mutexAttr, PTHREAD_MUTEX_ROBUST);
+    int rc = pthread_mutex_init(&shared->mutex, &mutexAttr);
+    pthread_mutexattr_destroy(&mutexAttr);
+    if (rc != 0) {
+        celix_err_pushf("Shm event ring: Error creating process-shared mutex, %d.", rc);
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, rc);
+    }
+
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    rc = pthread_cond_init(&shared->cond, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+    if (rc != 0) {
+        pthread_mutex_destroy(&shared->mutex);
+        celix_err_pushf("Shm event ring: Error creating process-shared condition, %d.", rc);
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, rc);
+    }
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_shmEventRing_create(celix_shm_event_ring_t* ring, size_t capacity) {
+    int fd = shm_open(ring->name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd == -1) {
+        if (errno != EEXIST) {
+            celix_err_pushf("Shm event ring: Error creating shm %s, %d.", ring->name, errno);
+        }
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    }
+    celix_status_t status = CELIX_SUCCESS;
+    size_t size = sizeof(celix_shm_event_ring_shared_t) + capacity;
+    void* addr = MAP_FAILED;
+    if (ftruncate(fd, (off_t)size) == -1 ||
+        (addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+        celix_err_pushf("Shm event ring: Error mapping shm %s, %d.", ring->name, errno);
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    } else {
+        celix_shm_event_ring_shared_t* shared = addr;
+        status = celix_shmEventRing_initSync(shared);
+        if (status == CELIX_SUCCESS) {
+            shared->layoutVersion = CELIX_SHM_EVENT_RING_LAYOUT_VERSION;
+            shared->capacity = capacity;
+            shared->attachCount = 1;
+            __atomic_store_n(&shared->magic, CELIX_SHM_EVENT_RING_MAGIC, __ATOMIC_RELEASE);
+        } else {
+            munmap(addr, size);
+        }
+    }
+    if (status != CELIX_SUCCESS) {
+        shm_unlink(ring->name);
+        close(fd);
+        return status;
+    }
+    ring->fd = fd;
+    ring->mappedSize = size;
+    ring->shared = addr;
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_shmEventRing_attach(celix_shm_event_ring_t* ring) {
+    int fd = shm_open(ring->name, O_RDWR, 0);
+    if (fd == -1) {
+        if (errno == ENOENT) {
+            return CELIX_SHM_EVENT_RING_RETRY; //removed in the meantime
+        }
+        celix_err_pushf("Shm event ring: Error opening shm %s, %d.", ring->name, errno);
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    }
+
+    //wait until the creator has sized and initialized the shared memory
+    struct timespec start = celix_gettime(CLOCK_MONOTONIC);
+    struct timespec pollDelay = {0, 1000 * 1000};
+    struct stat st;
+    while (fstat(fd, &st) == 0 && (size_t)st.st_size < sizeof(celix_shm_event_ring_shared_t) &&
+           celix_elapsedtime(CLOCK_MONOTONIC, start) < CELIX_SHM_EVENT_RING_INIT_TIMEOUT_IN_SECONDS) {
+        nanosleep(&pollDelay, NULL);
+    }
+    size_t size = (size_t)st.st_size;
+    void* addr = size < sizeof(celix_shm_event_ring_shared_t)
+                     ? MAP_FAILED
+                     : mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        celix_err_pushf("Shm event ring: Error mapping shm %s.", ring->name);
+        close(fd);
+        return CELIX_ILLEGAL_STATE;
+    }
+    celix_shm_event_ring_shared_t* shared = addr;
+    while (__atomic_load_n(&shared->magic, __ATOMIC_ACQUIRE) != CELIX_SHM_EVENT_RING_MAGIC &&
+           celix_elapsedtime(CLOCK_MONOTONIC, start) < CELIX_SHM_EVENT_RING_INIT_TIMEOUT_IN_SECONDS) {
+        nanosleep(&pollDelay, NULL);
+    }
+    if (__atomic_load_n(&shared->magic, __ATOMIC_ACQUIRE) != CELIX_SHM_EVENT_RING_MAGIC ||
+        shared->layoutVersion != CELIX_SHM_EVENT_RING_LAYOUT_VERSION ||
+        sizeof(celix_shm_event_ring_shared_t) + shared->capacity != size) {
+        celix_err_pushf("Shm event ring: Shm %s is not an initialized event ring.", ring->name);
+        munmap(addr, size);
+        close(fd);
+        return CELIX_ILLEGAL_STATE;
+    }
+
+    celix_shmEventRing_lock(shared);
+    bool unlinked = shared->unlinked;
+    if (!unlinked) {
+        shared->attachCount += 1;
+    }
+    celix_shmEventRing_unlock(shared);
+    if (unlinked) {
+        //the last user closed the ring while it was being attached, open a new ring instead
+        munmap(addr, size);
+        close(fd);
+        return CELIX_SHM_EVENT_RING_RETRY;
+    }
+    ring->fd = fd;
+    ring->mappedSize = size;
+    ring->shared = shared;
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_shmEventRing_open(const char* name, size_t capacity, celix_shm_event_ring_t** ring) {
+    if (name == NULL || name[0] == '\0' || strchr(name + 1, '/') != NULL || strlen(name) + 2 > NAME_MAX) {
+        celix_err_pushf("Shm event ring: Invalid ring name %s.", name == NULL ? "null" : name);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (capacity < CELIX_SHM_EVENT_RING_MIN_CAPACITY || capacity > UINT32_MAX) {
+        celix_err_pushf("Shm event ring: Invalid capacity %zu, must be in range [%i, %u].", capacity,
+                        CELIX_SHM_EVENT_RING_MIN_CAPACITY, UINT32_MAX);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    capacity = (capacity + 63) & ~(size_t)63;
+
+    celix_autofree celix_shm_event_ring_t* result = calloc(1, sizeof(*result));
+    if (result == NULL) {
+        return CELIX_ENOMEM;
+    }
+    result->fd = -1;
+    result->slot = -1;
+    snprintf(result->name, sizeof(result->name), "%s%s", name[0] == '/' ? "" : "/", name);
+
+    celix_status_t status = CELIX_SHM_EVENT_RING_RETRY;
+    for (int i = 0; i < CELIX_SHM_EVENT_RING_OPEN_ATTEMPTS && status == CELIX_SHM_EVENT_RING_RETRY; ++i) {
+        status = celix_shmEventRing_create(result, capacity);
+        if (status == CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, EEXIST)) {
+            status = celix_shmEventRing_attach(result);
+        }
+    }
+    if (status != CELIX_SUCCESS) {
+        if (status == CELIX_SHM_EVENT_RING_RETRY) {
+            celix_err_pushf("Shm event ring: Failed to open %s, it is repeatedly removed while opening.", result->name);
+        }
+        return status;
+    }
+    *ring = celix_steal_ptr(result);
+    return CELIX_SUCCESS;
+}
+
+void celix_shmEventRing_close(celix_shm_event_ring_t* ring) {
+    if (ring == NULL) {
+        return;
+    }
+    celix_shmEventRing_unsubscribe(ring);
+    celix_shm_event_ring_shared_t* shared = ring->shared;
+    celix_shmEventRing_lock(shared);
+    shared->attachCount -= 1;
+    if (shared->attachCount == 0) {
+        //unlink while holding the lock, so that attaching processes can detect it
+        shared->unlinked = true;
+        shm_unlink(ring->name);
+    }
+    celix_shmEventRing_unlock(shared);
+    munmap(shared, ring->mappedSize);
+    close(ring->fd);
+    free(ring->readBuf);
+    free(ring);
+}
+
+size_t celix_shmEventRing_getCapacity(const celix_shm_event_ring_t* ring) {
+    return ring->shared->capacity;
+}
+
+size_t celix_shmEventRing_getMaxPayloadSize(const celix_shm_event_ring_t* ring) {
+    //limit a record to a quarter of the ring, so that a burst of records does not immediately lap the readers
+    return ring->shared->capacity / 4 - sizeof(celix_shm_event_ring_record_header_t);
+}
+
+static celix_shm_event_ring_record_header_t* celix_shmEventRing_recordAt(celix_shm_event_ring_shared_t* shared,
+                                                                         uint64_t pos) {
+    return (celix_shm_event_ring_record_header_t*)(shared->data + pos % shared->capacity);
+}
+
+/**
+ * @brief Moves the tail, so that size bytes can be written at head. Called with the lock held.
+ */
+static void celix_shmEventRing_reserve(celix_shm_event_ring_shared_t* shared, uint64_t head, size_t size) {
+    uint64_t tail = __atomic_load_n(&shared->tail, __ATOMIC_RELAXED);
+    uint64_t newTail = tail;
+    while (head + size - newTail > shared->capacity) {
+        newTail += celix_shmEventRing_recordSize(celix_shmEventRing_recordAt(shared, newTail)->len);
+    }
+    if (newTail != tail) {
+        __atomic_store_n(&shared->tail, newTail, __ATOMIC_RELAXED);
+        //the new tail must be visible before the records behind it are overwritten, see celix_shmEventRing_read
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    }
+}
+
+celix_status_t celix_shmEventRing_write(celix_shm_event_ring_t* ring, uint64_t targetMask, const void* data, size_t len) {
+    if (len > celix_shmEventRing_getMaxPayloadSize(ring)) {
+        celix_err_pushf("Shm event ring: Record of %zu bytes exceeds the max payload size of %zu bytes.", len,
+                        celix_shmEventRing_getMaxPayloadSize(ring));
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_shm_event_ring_shared_t* shared = ring->shared;
+    size_t recordSize = celix_shmEventRing_recordSize(len);
+    celix_shmEventRing_lock(shared);
+    uint64_t head = __atomic_load_n(&shared->head, __ATOMIC_RELAXED);
+    size_t offset = head % shared->capacity;
+    if (offset + recordSize > shared->capacity) {
+        size_t paddingSize = shared->capacity - offset;
+        celix_shmEventRing_reserve(shared, head, paddingSize);
+        celix_shm_event_ring_record_header_t* padding = celix_shmEventRing_recordAt(shared, head);
+        padding->len = (uint32_t)(paddingSize - sizeof(*padding));
+        padding->flags = CELIX_SHM_EVENT_RING_RECORD_PADDING;
+        padding->targetMask = 0;
+        head += paddingSize;
+    }
+    celix_shmEventRing_reserve(shared, head, recordSize);
+    celix_shm_event_ring_record_header_t* record = celix_shmEventRing_recordAt(shared, head);
+    record->len = (uint32_t)len;
+    record->flags = 0;
+    record->targetMask = targetMask;
+    memcpy(record + 1, data, len);
+    __atomic_store_n(&shared->head, head + recordSize, __ATOMIC_RELEASE);
+    if (shared->waitingReaders > 0) {
+        pthread_cond_broadcast(&shared->cond);
+    }
+    celix_shmEventRing_unlock(shared);
+    return CELIX_SUCCESS;
+}
+
+static bool celix_shmEventRing_isPidAlive(pid_t pid) {
+    return kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+celix_status_t celix_shmEventRing_subscribe(celix_shm_event_ring_t* ring, const char* id, const char* topics, int* slot) {
+    if (strlen(id) >= CELIX_SHM_EVENT_RING_MAX_ID_LENGTH || strlen(topics) >= CELIX_SHM_EVENT_RING_MAX_TOPICS_LENGTH) {
+        celix_err_push("Shm event ring: Subscriber id or topics too long.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (ring->slot >= 0) {
+        celix_err_push("Shm event ring: Ring handle already has a subscription.");
+        return CELIX_ILLEGAL_STATE;
+    }
+    celix_shm_event_ring_shared_t* shared = ring->shared;
+    pid_t pid = getpid();
+    celix_shmEventRing_lock(shared);
+    int freeSlot = -1;
+    for (int i = 0; i < CELIX_SHM_EVENT_RING_MAX_SUBSCRIBERS; ++i) {
+        celix_shm_event_ring_subscriber_t* sub = &shared->subscribers[i];
+        if (sub->active && sub->pid != pid && !celix_shmEventRing_isPidAlive(sub->pid)) {
+            sub->active = false; //reclaim the slot of a terminated process
+        }
+        if (!sub->active && freeSlot == -1) {
+            freeSlot = i;
+        }
+    }
+    if (freeSlot >= 0) {
+        celix_shm_event_ring_subscriber_t* sub = &shared->subscribers[freeSlot];
+        sub->active = true;
+        sub->pid = pid;
+        snprintf(sub->id, sizeof(sub->id), "%s", id);
+        snprintf(sub->topics, sizeof(sub->topics), "%s", topics);
+        ring->slot = freeSlot;
+        ring->readPos = __atomic_load_n(&shared->head, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&shared->subscriptionsGeneration, 1, __ATOMIC_RELEASE);
+    }
+    celix_shmEventRing_unlock(shared);
+    if (freeSlot < 0) {
+        celix_err_pushf("Shm event ring: All %i subscriber slots of %s are in use.", CELIX_SHM_EVENT_RING_MAX_SUBSCRIBERS,
+                        ring->name);
+        return CELIX_ENOMEM;
+    }
+    *slot = freeSlot;
+    return CELIX_SUCCESS;
+}
+
+void celix_shmEventRing_unsubscribe(celix_shm_event_ring_t* ring) {
+    if (ring->slot < 0) {
+        return;
+    }
+    celix_shm_event_ring_shared_t* shared = ring->shared;
+    celix_shmEventRing_lock(shared);
+    shared->subscribers[ring->slot].active = false;
+    __atomic_add_fetch(&shared->subscriptionsGeneration, 1, __ATOMIC_RELEASE);
+    celix_shmEventRing_unlock(shared);
+    ring->slot = -1;
+}
+
+uint64_t celix_shmEventRing_getSubscriptionsGeneration(const celix_shm_event_ring_t* ring) {
+    return __atomic_load_n(&ring->shared->subscriptionsGeneration, __ATOMIC_ACQUIRE);
+}
+
+size_t celix_shmEventRing_getSubscriptions(celix_shm_event_ring_t* ring,
+                                           celix_shm_event_ring_subscription_t* subscriptions,
+                                           uint64_t* generation) {
+    celix_shm_event_ring_shared_t* shared = ring->shared;
+    size_t count = 0;
+    celix_shmEventRing_lock(shared);
+    *generation = __atomic_load_n(&shared->subscriptionsGeneration, __ATOMIC_RELAXED);
+    for (int i = 0; i < CELIX_SHM_EVENT_RING_MAX_SUBSCRIBERS; ++i) {
+        celix_shm_event_ring_subscriber_t* sub = &shared->subscribers[i];
+        if (sub->active) {
+            subscriptions[count].slot = i;
+            memcpy(subscriptions[count].id, sub->id, sizeof(sub->id));
+            memcpy(subscriptions[count].topics, sub->topics, sizeof(sub->topics));
+            count++;
+        }
+    }
+    celix_shmEventRing_unlock(shared);
+    return count;
+}
+
+/**
+ * @brief Waits until a record is written after readPos, the wait is interrupted or the deadline expired.
+ * @return Whether a new record is available.
+ */
+static bool celix_shmEventRing_waitForRecord(celix_shm_event_ring_t* ring, const struct timespec* deadline) {
+    celix_shm_event_ring_shared_t* shared = ring->shared;
+    bool available;
+    celix_shmEventRing_lock(shared);
+    shared->waitingReaders += 1;
+    while (!(available = __atomic_load_n(&shared->head, __ATOMIC_ACQUIRE) != ring->readPos) &&
+           !__atomic_load_n(&ring->interrupted, __ATOMIC_ACQUIRE)) {
+        int rc = pthread_cond_timedwait(&shared->cond, &shared->mutex, deadline);
+        if (rc == EOWNERDEAD) {
+            pthread_mutex_consistent(&shared->mutex);
+        } else if (rc == ETIMEDOUT) {
+            available = __atomic_load_n(&shared->head, __ATOMIC_ACQUIRE) != ring->readPos;
+            break;
+        }
+    }
+    shared->waitingReaders -= 1;
+    celix_shmEventRing_unlock(shared);
+    return available;
+}
+
+/**
+ * @brief Checks whether the record at readPos could have been overwritten while it was being copied.
+ */
+static bool celix_shmEventRing_isOverrun(celix_shm_event_ring_t* ring) {
+    //pairs with the fence in celix_shmEventRing_reserve: the copied data must be read before the tail is checked
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    uint64_t tail = __atomic_load_n(&ring->shared->tail, __ATOMIC_RELAXED);
+    if (tail > ring->readPos) {
+        __atomic_add_fetch(&ring->overruns, 1, __ATOMIC_RELAXED);
+        ring->readPos = tail;
+        return true;
+    }
+    return false;
+}
+
+celix_status_t celix_shmEventRing_read(celix_shm_event_ring_t* ring, int timeoutInMs, const void** data, size_t* len) {
+    if (ring->slot < 0) {
+        celix_err_push("Shm event ring: Ring handle has no subscription.");
+        return CELIX_ILLEGAL_STATE;
+    }
+    celix_shm_event_ring_shared_t* shared = ring->shared;
+    uint64_t slotBit = UINT64_C(1) << ring->slot;
+    struct timespec deadline = celix_delayedTimespec(NULL, 0);
+    bool deadlineSet = false;
+    for (;;) {
+        uint64_t head = __atomic_load_n(&shared->head, __ATOMIC_ACQUIRE);
+        if (ring->readPos == head) {
+            if (__atomic_exchange_n(&ring->interrupted, false, __ATOMIC_ACQ_REL)) {
+                return CELIX_SHM_EVENT_RING_TIMEOUT;
+            }
+            if (!deadlineSet) {
+                struct timespec now = celix_gettime(CLOCK_MONOTONIC);
+                deadline = celix_delayedTimespec(&now, timeoutInMs / 1000.0);
+                deadlineSet = true;
+            }
+            if (!celix_shmEventRing_waitForRecord(ring, &deadline)) {
+                __atomic_store_n(&ring->interrupted, false, __ATOMIC_RELEASE);
+                return CELIX_SHM_EVENT_RING_TIMEOUT;
+            }
+            continue;
+        }
+        if (__atomic_load_n(&shared->tail, __ATOMIC_ACQUIRE) > ring->readPos) {
+            celix_shmEventRing_isOverrun(ring);
+            continue;
+        }
+
+        celix_shm_event_ring_record_header_t header;
+        memcpy(&header, celix_shmEventRing_recordAt(shared, ring->readPos), sizeof(header));
+        if (celix_shmEventRing_isOverrun(ring)) {
+            continue;
+        }
+        size_t recordSize = celix_shmEventRing_recordSize(header.len);
+        if ((header.flags & CELIX_SHM_EVENT_RING_RECORD_PADDING) != 0 || (header.targetMask & slotBit) == 0) {
+            ring->readPos += recordSize; //skip without copying the payload
+            continue;
+        }
+        if (ring->readBufSize < header.len) {
+            uint8_t* buf = realloc(ring->readBuf, header.len);
+            if (buf == NULL) {
+                celix_err_push("Shm event ring: Error allocating read buffer.");
+                return CELIX_ENOMEM;
+            }
+            ring->readBuf = buf;
+            ring->readBufSize = header.len;
+        }
+        memcpy(ring->readBuf, celix_shmEventRing_recordAt(shared, ring->readPos) + 1, header.len);
+        if (celix_shmEventRing_isOverrun(ring)) {
+            continue;
+        }
+        ring->readPos += recordSize;
+        *data = ring->readBuf;
+        *len = header.len;
+        return CELIX_SUCCESS;
+    }
+}
+
+void celix_shmEventRing_interrupt(celix_shm_event_ring_t* ring) {
+    celix_shm_event_ring_shared_t* shared = ring->shared;
+    celix_shmEventRing_lock(shared);
+    __atomic_store_n(&ring->interrupted, true, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&shared->cond);
+    celix_shmEventRing_unlock(shared);
+}
+
+uint64_t celix_shmEventRing_getOverrunCount(const celix_shm_event_ring_t* ring) {
+    return __atomic_load_n(&ring->overruns, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,182 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_SHM_EVENT_RING_H
+#define CELIX_SHM_EVENT_RING_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "celix_cleanup.h"
+#include "celix_errno.h"
+
+/**
+ * @file celix_shm_event_ring.h
+ * @brief A multi-producer, multicast ring buffer in POSIX shared memory.
+ *
+ * All processes that open a ring with the same name share the ring. Writers serialize on a process-shared robust
+ * mutex and never wait for readers: if the ring is full, the oldest records are overwritten. Readers do not take
+ * any lock to read a record, they validate after copying a record that the record was not overwritten in the
+ * meantime (seqlock style). A reader that is lapped by the writers skips the overwritten records and counts this as
+ * an overrun.
+ *
+ * Readers register as subscriber with a topics description. Every record carries a target mask of subscriber slots,
+ * so that a publisher can evaluate the subscriber topics before writing and readers can skip records that are not
+ * meant for them without copying them.
+ *
+ * The shared memory object is removed when the last process closes the ring.
+ */
+
+/**
+ * @brief The maximum number of subscribers of a ring.
+ */
+#define CELIX_SHM_EVENT_RING_MAX_SUBSCRIBERS 64
+
+/**
+ * @brief The maximum length (including the terminating '\0') of a subscriber id.
+ */
+#define CELIX_SHM_EVENT_RING_MAX_ID_LENGTH 64
+
+/**
+ * @brief The maximum length (including the terminating '\0') of the topics of a subscriber.
+ */
+#define CELIX_SHM_EVENT_RING_MAX_TOPICS_LENGTH 1024
+
+typedef struct celix_shm_event_ring celix_shm_event_ring_t;
+
+/**
+ * @brief A copy of a subscription of a ring.
+ */
+typedef struct celix_shm_event_ring_subscription {
+    int slot;                                           /**< The slot of the subscriber, used in target masks. */
+    char id[CELIX_SHM_EVENT_RING_MAX_ID_LENGTH];         /**< The id of the subscriber. */
+    char topics[CELIX_SHM_EVENT_RING_MAX_TOPICS_LENGTH]; /**< The topics of interest of the subscriber. */
+} celix_shm_event_ring_subscription_t;
+
+/**
+ * @brief Opens the ring with the provided name, creating it if it does not exist yet.
+ *
+ * Errors are reported to celix_err.
+ *
+ * @param[in] name The name of the ring, used as POSIX shared memory object name.
+ * @param[in] capacity The data capacity in bytes of the ring if it is created. Rounded up to a multiple of 64.
+ * Ignored if the ring already exists, see celix_shmEventRing_getCapacity.
+ * @param[out] ring The opened ring.
+ * @return CELIX_SUCCESS, CELIX_ILLEGAL_ARGUMENT if the name or capacity is invalid, CELIX_ENOMEM,
+ * CELIX_ILLEGAL_STATE if an existing ring is not initialized in time or has an incompatible layout, or an errno
+ * based status if the shared memory could not be opened.
+ */
+celix_status_t celix_shmEventRing_open(const char* name, size_t capacity, celix_shm_event_ring_t** ring);
+
+/**
+ * @brief Closes the ring. The ring must not have an active subscription.
+ */
+void celix_shmEventRing_close(celix_shm_event_ring_t* ring);
+
+CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(celix_shm_event_ring_t, celix_shmEventRing_close);
+
+/**
+ * @brief Returns the data capacity in bytes of the ring.
+ */
+size_t celix_shmEventRing_getCapacity(const celix_shm_event_ring_t* ring);
+
+/**
+ * @brief Returns the maximum size of a record payload that can be written to the ring.
+ */
+size_t celix_shmEventRing_getMaxPayloadSize(const celix_shm_event_ring_t* ring);
+
+/**
+ * @brief Writes a record to the ring and wakes up waiting readers.
+ *
+ * @param[in] targetMask The subscriber slots the record is meant for, see celix_shm_event_ring_subscription_t.
+ * @param[in] data The payload of the record.
+ * @param[in] len The size of the payload.
+ * @return CELIX_SUCCESS or CELIX_ILLEGAL_ARGUMENT if len exceeds celix_shmEventRing_getMaxPayloadSize.
+ */
+celix_status_t celix_shmEventRing_write(celix_shm_event_ring_t* ring, uint64_t targetMask, const void* data, size_t len);
+
+/**
+ * @brief Subscribes the ring handle to records targeted at the returned subscriber slot.
+ *
+ * A ring handle can have at most one subscription. Slots of subscribers of terminated processes are reclaimed.
+ * Reading starts at the records written after the subscription.
+ *
+ * @param[in] id The id of the subscriber, used by publishers to skip their own subscription.
+ * @param[in] topics The topics of interest of the subscriber.
+ * @param[out] slot The subscriber slot.
+ * @return CELIX_SUCCESS, CELIX_ILLEGAL_ARGUMENT if the id or topics are too long, CELIX_ILLEGAL_STATE if the
+ * handle already has a subscription or CELIX_ENOMEM if all subscriber slots are in use.
+ */
+celix_status_t celix_shmEventRing_subscribe(celix_shm_event_ring_t* ring, const char* id, const char* topics, int* slot);
+
+/**
+ * @brief Removes the subscription of the ring handle, if any.
+ */
+void celix_shmEventRing_unsubscribe(celix_shm_event_ring_t* ring);
+
+/**
+ * @brief Returns the generation of the subscriptions of the ring, which changes when a subscription is added or
+ * removed.
+ */
+uint64_t celix_shmEventRing_getSubscriptionsGeneration(const celix_shm_event_ring_t* ring);
+
+/**
+ * @brief Copies the subscriptions of the ring.
+ *
+ * @param[out] subscriptions An array of CELIX_SHM_EVENT_RING_MAX_SUBSCRIBERS subscriptions.
+ * @param[out] generation The subscriptions generation of the copied subscriptions.
+ * @return The number of copied subscriptions.
+ */
+size_t celix_shmEventRing_getSubscriptions(celix_shm_event_ring_t* ring,
+                                           celix_shm_event_ring_subscription_t* subscriptions,
+                                           uint64_t* generation);
+
+/**
+ * @brief Reads the next record targeted at the subscription of the ring handle.
+ *
+ * Must not be called concurrently for the same ring handle.
+ *
+ * @param[in] timeoutInMs The max time to wait for a record.
+ * @param[out] data The payload of the read record, valid until the next read call on the ring handle.
+ * @param[out] len The size of the payload.
+ * @return CELIX_SUCCESS, CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, ETIMEDOUT) if no record was read before the timeout
+ * or the wait was interrupted, CELIX_ILLEGAL_STATE if the ring handle has no subscription or CELIX_ENOMEM.
+ */
+celix_status_t celix_shmEventRing_read(celix_shm_event_ring_t* ring, int timeoutInMs, const void** data, size_t* len);
+
+/**
+ * @brief Interrupts a celix_shmEventRing_read call of the ring handle waiting for records.
+ */
+void celix_shmEventRing_interrupt(celix_shm_event_ring_t* ring);
+
+/**
+ * @brief Returns the number of times the reader of the ring handle was lapped by the writers.
+ *
+ * Every overrun means that one or more records were overwritten before they could be read.
+ */
+uint64_t celix_shmEventRing_getOverrunCount(const celix_shm_event_ring_t* ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //CELIX_SHM_EVENT_RING_H
@@ -29,6 +29,7 @@
 #include "celix_log_service.h"
 #include "celix_shell_command.h"
 #include "celix_constants.h"
+#include "celix_metrics_provider.h"
 
 class LogBundleTestSuite : public ::testing::Test {
 public:
@@ -590,4 +591,54 @@ TEST_F(LogBundleTestSuite, LogAdminCmd) {
     };
     called = celix_bundleContext_useServiceWithOptions(ctx.get(), &opts);
     EXPECT_TRUE(called);
-}
\ No newline at end of file
+}
+TEST_F(LogBundleTestSuite, LogAdminMetrics) {
+    //request a 'test::Log1' log service
+    long trkId;
+    {
+        celix_service_tracking_options_t opts{};
+        opts.filter.serviceName = CELIX_LOG_SERVICE_NAME;
+        opts.filter.filter = "(name=test::Log1)";
+        trkId = celix_bundleContext_trackServicesWithOptions(ctx.get(), &opts);
+    }
+
+    {
+        celix_service_use_options_t opts{};
+        opts.filter.serviceName = CELIX_LOG_SERVICE_NAME;
+        opts.filter.filter = "(name=test::Log1)";
+        opts.waitTimeoutInSeconds = 5;
+        opts.use = [](void*, void *svc) {
+            auto* logSvc = static_cast<celix_log_service_t*>(svc);
+            logSvc->error(logSvc->handle, "error %i", 1);
+            logSvc->error(logSvc->handle, "error %i", 2);
+            logSvc->warning(logSvc->handle, "warning");
+            logSvc->debug(logSvc->handle, "filtered, because default active log level is info");
+        };
+        bool called = celix_bundleContext_useServiceWithOptions(ctx.get(), &opts);
+        EXPECT_TRUE(called);
+    }
+
+    celix_service_use_options_t opts{};
+    opts.filter.serviceName = CELIX_METRICS_PROVIDER_SERVICE_NAME;
+    opts.filter.filter = "(" CELIX_METRICS_PROVIDER_NAME "=log_admin)";
+    opts.use = [](void*, void *svc) {
+        auto* provider = static_cast<celix_metrics_provider_t*>(svc);
+        char* result = nullptr;
+        size_t resultLen;
+        FILE* stream = open_memstream(&result, &resultLen);
+        auto status = provider->collectMetrics(provider->handle, stream, [](void* handle, const celix_metric_t* metric) {
+            celix_metrics_writePrometheus(static_cast<FILE*>(handle), metric, false);
+        });
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        fclose(stream);
+        EXPECT_TRUE(strstr(result, "celix_log_admin_messages_total{level=\"error\"} 2") != nullptr) << result;
+        EXPECT_TRUE(strstr(result, "celix_log_admin_messages_total{level=\"warning\"} 1") != nullptr) << result;
+        EXPECT_TRUE(strstr(result, "celix_log_admin_filtered_messages_total 1") != nullptr) << result;
+        EXPECT_TRUE(strstr(result, "celix_log_admin_log_services 2") != nullptr) << result;
+        free(result);
+    };
+    bool called = celix_bundleContext_useServiceWithOptions(ctx.get(), &opts);
+    EXPECT_TRUE(called);
+
+    celix_bundleContext_stopTracker(ctx.get(), trkId);
+}
@@ -33,6 +33,7 @@
 #include "celix_utils.h"
 #include "celix_log_utils.h"
 #include "celix_log_constants.h"
+#include "celix_metrics_provider.h"
 #include "celix_shell_command.h"
 #include "celix_threads.h"
 #include "hash_map.h"
@@ -56,6 +57,12 @@ struct celix_log_admin {
     celix_shell_command_t cmdSvc;
     long cmdSvcId;
 
+    celix_metrics_provider_t metricsSvc;
+    long metricsSvcId;
+
+    unsigned long logMessages[CELIX_LOG_LEVEL_DISABLED]; //atomic, nr of emitted log messages per log level
+    unsigned long filteredMessages; //atomic, nr of log messages below the active log level
+
     celix_thread_rwlock_t lock; //protects below
     hash_map_t *loggers; //key = name, value = celix_log_service_instance_t
     hash_map_t* sinks; //key = name, value = celix_log_sink_t
@@ -92,6 +99,7 @@ static void celix_logAdmin_vlogDetails(void *handle, celix_log_level_e level, co
 
     celixThreadRwlock_readLock(&entry->admin->lock);
     if (level >= entry->activeLogLevel) {
+        __atomic_fetch_add(&entry->admin->logMessages[level], 1, __ATOMIC_RELAXED);
         int nrOfLogWriters = hashMap_size(entry->admin->sinks);
         hash_map_iterator_t iter = hashMapIterator_construct(entry->admin->sinks);
         while (hashMapIterator_hasNext(&iter)) {
@@ -114,6 +122,8 @@ static void celix_logAdmin_vlogDetails(void *handle, celix_log_level_e level, co
                                                entry->detailed ? line : 0,
                                                format, formatArgs);
         }
+    } else {
+        __atomic_fetch_add(&entry->admin->filteredMessages, 1, __ATOMIC_RELAXED);
     }
     celixThreadRwlock_unlock(&entry->admin->lock);
 }
@@ -642,6 +652,40 @@ static bool celix_logAdmin_executeCommand(void *handle, const char *commandLine,
     return true;
 }
 
+static celix_status_t celix_logAdmin_collectMetrics(void* handle, void* callbackHandle, celix_metrics_callback_fp callback) {
+    celix_log_admin_t* admin = handle;
+    celix_metric_t metric = {0};
+    char labels[32];
+
+    metric.name = "celix_log_admin_messages_total";
+    metric.help = "Total nr of log messages forwarded to the log sinks, per log level.";
+    metric.type = CELIX_METRIC_TYPE_COUNTER;
+    metric.labels = labels;
+    for (int level = CELIX_LOG_LEVEL_TRACE; level < CELIX_LOG_LEVEL_DISABLED; ++level) {
+        snprintf(labels, sizeof(labels), "level=\"%s\"", celix_logLevel_toString((celix_log_level_e)level));
+        metric.value = (double)__atomic_load_n(&admin->logMessages[level], __ATOMIC_RELAXED);
+        callback(callbackHandle, &metric);
+    }
+    metric.labels = NULL;
+
+    metric.name = "celix_log_admin_filtered_messages_total";
+    metric.help = "Total nr of log messages dropped, because they were below the active log level.";
+    metric.value = (double)__atomic_load_n(&admin->filteredMessages, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_log_admin_log_services";
+    metric.help = "Nr of currently provided log services.";
+    metric.type = CELIX_METRIC_TYPE_GAUGE;
+    metric.value = (double)celix_logAdmin_nrOfLogServices(admin, NULL);
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_log_admin_log_sinks";
+    metric.help = "Nr of currently tracked log sinks.";
+    metric.value = (double)celix_logAdmin_nrOfSinks(admin, NULL);
+    callback(callbackHandle, &metric);
+    return CELIX_SUCCESS;
+}
+
 celix_log_admin_t* celix_logAdmin_create(celix_bundle_context_t *ctx) {
     celix_log_admin_t* admin = calloc(1, sizeof(*admin));
     admin->ctx = ctx;
@@ -712,6 +756,21 @@ celix_log_admin_t* celix_logAdmin_create(celix_bundle_context_t *ctx) {
         admin->cmdSvcId = celix_bundleContext_registerServiceWithOptionsAsync(ctx, &opts);
     }
 
+    {
+        admin->metricsSvc.handle = admin;
+        admin->metricsSvc.collectMetrics = celix_logAdmin_collectMetrics;
+
+        celix_properties_t* props = celix_properties_create();
+        celix_properties_set(props, CELIX_METRICS_PROVIDER_NAME, "log_admin");
+
+        celix_service_registration_options_t opts = CELIX_EMPTY_SERVICE_REGISTRATION_OPTIONS;
+        opts.serviceName = CELIX_METRICS_PROVIDER_SERVICE_NAME;
+        opts.serviceVersion = CELIX_METRICS_PROVIDER_SERVICE_VERSION;
+        opts.properties = props;
+        opts.svc = &admin->metricsSvc;
+        admin->metricsSvcId = celix_bundleContext_registerServiceWithOptionsAsync(ctx, &opts);
+    }
+
     //add log service for the framework
     celix_logAdmin_addLogSvcForName(admin, CELIX_LOG_ADMIN_FRAMEWORK_LOG_NAME);
     return admin;
@@ -721,6 +780,7 @@ void celix_logAdmin_destroy(celix_log_admin_t *admin) {
     if (admin != NULL) {
         celix_logAdmin_remLogSvcForName(admin, CELIX_LOG_ADMIN_FRAMEWORK_LOG_NAME);
 
+        celix_bundleContext_unregisterServiceAsync(admin->ctx, admin->metricsSvcId, NULL, NULL);
         celix_bundleContext_unregisterServiceAsync(admin->ctx, admin->cmdSvcId, NULL, NULL);
         celix_bundleContext_unregisterServiceAsync(admin->ctx, admin->controlSvcId, NULL, NULL);
         celix_bundleContext_stopTrackerAsync(admin->ctx, admin->logServiceMetaTrackerId, NULL, NULL);
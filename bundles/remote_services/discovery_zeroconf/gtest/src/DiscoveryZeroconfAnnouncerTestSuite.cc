@@ -45,11 +45,42 @@ extern "C" {
 #include <cstring>
 #include <unistd.h>
 #include <cstdlib>
+#include <string>
 
 #define DZC_TEST_CONFIG_TYPE "celix.config_type.test"
 
 static int GetLoopBackIfIndex(void);
 
+/**
+ * Sets an environment variable for the lifetime of the guard and restores the previous value afterwards.
+ */
+class ScopedEnvGuard {
+public:
+    ScopedEnvGuard(const char* name, const char* value) : name{name} {
+        const char* prev = getenv(name);
+        if (prev != nullptr) {
+            prevValue = prev;
+            hadPrevValue = true;
+        }
+        setenv(name, value, 1);
+    }
+
+    ~ScopedEnvGuard() {
+        if (hadPrevValue) {
+            setenv(name.c_str(), prevValue.c_str(), 1);
+        } else {
+            unsetenv(name.c_str());
+        }
+    }
+
+    ScopedEnvGuard(const ScopedEnvGuard&) = delete;
+    ScopedEnvGuard& operator=(const ScopedEnvGuard&) = delete;
+private:
+    const std::string name;
+    std::string prevValue{};
+    bool hadPrevValue{false};
+};
+
 class DiscoveryZeroconfAnnouncerTestSuite : public ::testing::Test {
 public:
     static void SetUpTestCase() {
@@ -187,7 +218,6 @@ static void OnServiceResolveCallback(DNSServiceRef sdRef, DNSServiceFlags flags,
 
 static void OnServiceBrowseCallback(DNSServiceRef sdRef, DNSServiceFlags flags, uint32_t interfaceIndex, DNSServiceErrorType errorCode, const char *instanceName, const char *regtype, const char *replyDomain, void *context) {
     EXPECT_NE(nullptr, sdRef);
-    (void)context;
     EXPECT_EQ(errorCode, kDNSServiceErr_NoError);
     if ((flags & kDNSServiceFlagsAdd) && (strstr(instanceName, "dzc_test_service") != nullptr)) {
         DNSServiceRef dsRef{};
@@ -198,12 +228,22 @@ static void OnServiceBrowseCallback(DNSServiceRef sdRef, DNSServiceFlags flags,
         //The txt record should not include ifname and port key
         EXPECT_EQ(nullptr, celix_properties_get(prop, CELIX_RSA_EXPORTED_ENDPOINT_EXPOSURE_INTERFACE, nullptr));
         EXPECT_EQ(nullptr, celix_properties_get(prop, CELIX_RSA_PORT, nullptr));
+        //The txt record should use the expected encoding
+        auto compactTxtRecord = *static_cast<bool*>(context);
+        EXPECT_STREQ(compactTxtRecord ? DZC_COMPACT_TXT_RECORD_VERSION : DZC_CURRENT_TXT_RECORD_VERSION,
+                     celix_properties_get(prop, DZC_TXT_RECORD_VERSION_KEY, nullptr));
+        if (compactTxtRecord) {
+            EXPECT_STREQ("dzc_test_service", celix_properties_get(prop, "~c", nullptr));
+            EXPECT_EQ(nullptr, celix_properties_get(prop, CELIX_FRAMEWORK_SERVICE_NAME, nullptr));
+        } else {
+            EXPECT_STREQ("dzc_test_service", celix_properties_get(prop, CELIX_FRAMEWORK_SERVICE_NAME, nullptr));
+        }
         DNSServiceRefDeallocate(dsRef);
         celix_properties_destroy(prop);
     }
 }
 
-static void TestAddEndpoint(celix_bundle_context *ctx, discovery_zeroconf_announcer_t *announcer, int ifIndex) {
+static void TestAddEndpoint(celix_bundle_context *ctx, discovery_zeroconf_announcer_t *announcer, int ifIndex, bool compactTxtRecord = false) {
     const char *fwUuid = celix_bundleContext_getProperty(ctx, CELIX_FRAMEWORK_UUID, nullptr);
     celix_properties_t *properties = celix_properties_create();
     if (ifIndex == kDNSServiceInterfaceIndexAny) {
@@ -232,7 +272,7 @@ static void TestAddEndpoint(celix_bundle_context *ctx, discovery_zeroconf_announ
     }
     DNSServiceRef dsRef{nullptr};
     DNSServiceErrorType dnsErr = DNSServiceBrowse(&dsRef, 0, ifIndex, DZC_SERVICE_PRIMARY_TYPE, "local.", OnServiceBrowseCallback,
-                                                  nullptr);
+                                                  &compactTxtRecord);
     EXPECT_EQ(dnsErr, kDNSServiceErr_NoError);
     DNSServiceProcessResult(dsRef);
     DNSServiceRefDeallocate(dsRef);
@@ -259,6 +299,15 @@ TEST_F(DiscoveryZeroconfAnnouncerTestSuite, AddAndRemoveLocalOnlyEndpoint) {
     discoveryZeroconfAnnouncer_destroy(announcer);
 }
 
+TEST_F(DiscoveryZeroconfAnnouncerTestSuite, AddAndRemoveEndpointWithCompactTxtRecord) {
+    ScopedEnvGuard compactTxtRecordEnv{DZC_COMPACT_TXT_RECORD, "true"};
+    discovery_zeroconf_announcer_t *announcer{};
+    auto status = discoveryZeroconfAnnouncer_create(ctx.get(), logHelper.get(), &announcer);
+    EXPECT_EQ(status, CELIX_SUCCESS);
+    TestAddEndpoint(ctx.get(), announcer, kDNSServiceInterfaceIndexAny, true);
+    discoveryZeroconfAnnouncer_destroy(announcer);
+}
+
 TEST_F(DiscoveryZeroconfAnnouncerTestSuite, AddAndRemoveEndpointOnSpecificInterface) {
     discovery_zeroconf_announcer_t *announcer{};
     auto status = discoveryZeroconfAnnouncer_create(ctx.get(), logHelper.get(), &announcer);
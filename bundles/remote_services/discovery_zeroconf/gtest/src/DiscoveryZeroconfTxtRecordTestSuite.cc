@@ -0,0 +1,78 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "discovery_zeroconf_txt_record.h"
+#include "discovery_zeroconf_constants.h"
+#include "remote_constants.h"
+#include "celix_constants.h"
+#include "celix_properties.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+class DiscoveryZeroconfTxtRecordTestSuite : public ::testing::Test {
+public:
+    static std::string compactAndExpand(const char* key) {
+        char buf[UINT8_MAX+1];
+        const char* compactKey = discoveryZeroconf_compactTxtRecordKey(key, buf, sizeof(buf));
+        EXPECT_NE(nullptr, compactKey);
+        return compactKey == nullptr ? std::string{} : discoveryZeroconf_expandTxtRecordKey(compactKey);
+    }
+};
+
+TEST_F(DiscoveryZeroconfTxtRecordTestSuite, CompactAndExpandKeys) {
+    std::vector<const char*> keys = {
+        CELIX_FRAMEWORK_SERVICE_NAME,
+        CELIX_FRAMEWORK_SERVICE_VERSION,
+        CELIX_RSA_ENDPOINT_ID,
+        CELIX_RSA_ENDPOINT_FRAMEWORK_UUID,
+        DZC_SERVICE_PROPERTIES_SIZE_KEY,
+        "custom.key",
+        "~c", //same as a compact key
+        "~custom",
+        "~~",
+        "~",
+    };
+    for (const auto* key : keys) {
+        EXPECT_EQ(key, compactAndExpand(key));
+    }
+
+    //common keys are compacted, keys starting with the prefix are escaped
+    char buf[UINT8_MAX+1];
+    EXPECT_STREQ("~c", discoveryZeroconf_compactTxtRecordKey(CELIX_FRAMEWORK_SERVICE_NAME, buf, sizeof(buf)));
+    EXPECT_STREQ("~~c", discoveryZeroconf_compactTxtRecordKey("~c", buf, sizeof(buf)));
+    EXPECT_STREQ("custom.key", discoveryZeroconf_compactTxtRecordKey("custom.key", buf, sizeof(buf)));
+
+    //an escaped key that does not fit in the buffer
+    EXPECT_EQ(nullptr, discoveryZeroconf_compactTxtRecordKey("~c", buf, 3));
+}
+
+TEST_F(DiscoveryZeroconfTxtRecordTestSuite, ExpandTxtRecord) {
+    celix_autoptr(celix_properties_t) txtRecord = celix_properties_create();
+    celix_properties_set(txtRecord, "~c", "dzc_test_service");
+    celix_properties_set(txtRecord, "~~c", "escaped");
+    celix_properties_set(txtRecord, "custom.key", "value");
+
+    celix_autoptr(celix_properties_t) expanded = discoveryZeroconf_expandTxtRecord(txtRecord);
+    ASSERT_NE(nullptr, expanded);
+    EXPECT_EQ(3, celix_properties_size(expanded));
+    EXPECT_STREQ("dzc_test_service", celix_properties_get(expanded, CELIX_FRAMEWORK_SERVICE_NAME, nullptr));
+    EXPECT_STREQ("escaped", celix_properties_get(expanded, "~c", nullptr));
+    EXPECT_STREQ("value", celix_properties_get(expanded, "custom.key", nullptr));
+}
@@ -43,6 +43,7 @@
 #include <semaphore.h>
 #include <ctime>
 #include <cstdlib>
+#include <vector>
 #include <gtest/gtest.h>
 #include <ifaddrs.h>
 #include <netdb.h>
@@ -585,6 +586,38 @@ TEST_F(DiscoveryZeroconfWatcherTestSuite, AddAndRemoveEndpoint) {
     });
 }
 
+TEST_F(DiscoveryZeroconfWatcherTestSuite, AddMoreEndpointsThanInFlightResolves) {
+    discovery_zeroconf_watcher_t *watcher;
+    celix_status_t status = discoveryZeroconfWatcher_create(ctx.get(), logHelper.get(), &watcher);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    auto eplTrkId = TrackEndpointListenerService(watcher);
+    auto rsaTrkId = TrackRsaService(watcher);
+
+    ExpectMsgOutPut("Endpoint added: %s.");
+    //more services than the max count of in-flight resolves, the others are queued
+    const int serviceCnt = 40;
+    std::vector<DNSServiceRef> dsRefs{};
+    for (int i = 0; i < serviceCnt; ++i) {
+        char endpointId[64]{};
+        snprintf(endpointId, sizeof(endpointId), "60f49d89-d105-430c-b12b-93fbb54b%04x", i);
+        char serviceId[16]{};
+        snprintf(serviceId, sizeof(serviceId), "%d", 200 + i);
+        dsRefs.push_back(RegisterTestService(kDNSServiceInterfaceIndexLocalOnly, endpointId, serviceId));
+    }
+
+    for (int i = 0; i < serviceCnt; ++i) {
+        auto timeOut = CheckMsgWithTimeOutInS(30);
+        EXPECT_FALSE(timeOut);
+    }
+
+    for (auto dsRef : dsRefs) {
+        DNSServiceRefDeallocate(dsRef);
+    }
+    celix_bundleContext_stopTracker(ctx.get(), rsaTrkId);
+    celix_bundleContext_stopTracker(ctx.get(), eplTrkId);
+    discoveryZeroconfWatcher_destroy(watcher);
+}
+
 TEST_F(DiscoveryZeroconfWatcherTestSuite, FailedToCopyEndpointProperties) {
     TestAddEndpoint([](){
         celix_ei_expect_celix_properties_copy(CELIX_EI_UNKNOWN_CALLER, 0, nullptr);
@@ -1141,4 +1174,26 @@ TEST_F(DiscoveryZeroconfWatcherWatchServiceTestSuite, AddMultiEndpoint) {
         timeOut  = CheckMsgWithTimeOutInS(30);
         EXPECT_FALSE(timeOut);
     });
-}
\ No newline at end of file
+}
+
+TEST_F(DiscoveryZeroconfWatcherWatchServiceTestSuite, ReuseCachedHostAddresses) {
+    auto eplTrkId = TrackEndpointListenerService(watcher.get());
+    ExpectMsgOutPut("Endpoint added: %s.");
+    auto rsaTrkId = TrackRsaService(watcher.get());
+    auto timeOut = CheckMsgWithTimeOutInS(30);
+    EXPECT_FALSE(timeOut);
+
+    //no service uses the host, the ip addresses of the host are cached
+    ExpectMsgOutPut("Endpoint removed: %s.");
+    celix_bundleContext_stopTracker(ctx.get(), rsaTrkId);
+    timeOut = CheckMsgWithTimeOutInS(30);
+    EXPECT_FALSE(timeOut);
+
+    ExpectMsgOutPut("Watcher: Reuse cached ip addresses of host %s on %d.");
+    rsaTrkId = TrackRsaService(watcher.get());
+    timeOut = CheckMsgWithTimeOutInS(30);
+    EXPECT_FALSE(timeOut);
+
+    celix_bundleContext_stopTracker(ctx.get(), rsaTrkId);
+    celix_bundleContext_stopTracker(ctx.get(), eplTrkId);
+}
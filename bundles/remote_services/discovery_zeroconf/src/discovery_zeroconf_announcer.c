@@ -18,8 +18,10 @@
  */
 #include "discovery_zeroconf_announcer.h"
 #include "discovery_zeroconf_constants.h"
+#include "discovery_zeroconf_txt_record.h"
 #include "endpoint_listener.h"
 #include "remote_constants.h"
+#include "celix_bundle_context.h"
 #include "celix_utils.h"
 #include "celix_properties.h"
 #include "celix_constants.h"
@@ -57,10 +59,14 @@
 //It is enough to store three subtypes.
 #define DZC_MAX_SERVICE_TYPE_LEN 256
 
+//Max count of services registered to mDNS daemon per second. Every registration is probed and announced by the mDNS daemon, so it bounds the multicast traffic of announcing many endpoints.
+#define DZC_MAX_REGISTRATIONS_PER_SECOND 50
+
 struct discovery_zeroconf_announcer {
     celix_bundle_context_t *ctx;
     celix_log_helper_t *logHelper;
     pid_t pid;
+    bool compactTxtRecord;
     DNSServiceRef sharedRef;
     int eventFd;
     celix_thread_t refreshEPThread;
@@ -97,6 +103,7 @@ celix_status_t discoveryZeroconfAnnouncer_create(celix_bundle_context_t *ctx, ce
     announcer->ctx = ctx;
     announcer->logHelper = logHelper;
     announcer->pid = getpid();
+    announcer->compactTxtRecord = celix_bundleContext_getPropertyAsBool(ctx, DZC_COMPACT_TXT_RECORD, DZC_COMPACT_TXT_RECORD_DEFAULT);
     announcer->sharedRef = NULL;
 
     announcer->eventFd = eventfd(0, 0);
@@ -425,6 +432,35 @@ static void OnDNSServiceRegisterCallback(DNSServiceRef sdRef, DNSServiceFlags fl
 }
 
 
+static bool endpointEntry_isSameRegistration(announce_endpoint_entry_t *entry1, announce_endpoint_entry_t *entry2) {
+    return entry1->ifIndex == entry2->ifIndex && entry1->port == entry2->port && entry1->conflictCnt == entry2->conflictCnt
+           && strcmp(entry1->serviceType, entry2->serviceType) == 0 && celix_properties_equals(entry1->properties, entry2->properties);
+}
+
+/**
+ * If a revoked endpoint is added again without changes(e.g. the topology manager re-exports a service), the endpoint
+ * keeps the registration of the revoked endpoint, so that the mDNS daemon does not send goodbye, probe and announce messages for it.
+ * Must be called with the announcer mutex locked.
+ */
+static void discoveryZeroconfAnnouncer_keepUnchangedRegistrations(discovery_zeroconf_announcer_t *announcer, celix_array_list_t *revokedEndpoints) {
+    int size = celix_arrayList_size(revokedEndpoints);
+    for (int i = 0; i < size; ++i) {
+        announce_endpoint_entry_t *revokedEntry = celix_arrayList_get(revokedEndpoints, i);
+        if (revokedEntry->registerRef == NULL) {
+            continue;
+        }
+        const char *endpointId = celix_properties_get(revokedEntry->properties, CELIX_RSA_ENDPOINT_ID, NULL);
+        announce_endpoint_entry_t *entry = endpointId == NULL ? NULL : celix_stringHashMap_get(announcer->endpoints, endpointId);
+        if (entry != NULL && !entry->announced && entry->registerRef == NULL && endpointEntry_isSameRegistration(entry, revokedEntry)) {
+            celix_logHelper_debug(announcer->logHelper, "Announcer: Keep registration of service %s on interface %d.", entry->serviceName, entry->ifIndex);
+            entry->registerRef = revokedEntry->registerRef;
+            entry->announced = true;
+            revokedEntry->registerRef = NULL;
+        }
+    }
+    return;
+}
+
 static void discoveryZeroconfAnnouncer_revokeEndpoints(discovery_zeroconf_announcer_t *announcer, celix_array_list_t *endpoints) {
     (void)announcer;//unused
     announce_endpoint_entry_t *entry = NULL;
@@ -443,9 +479,17 @@ static void discoveryZeroconfAnnouncer_revokeEndpoints(discovery_zeroconf_announ
 static bool discoveryZeroconfAnnouncer_copyPropertiesToTxtRecord(discovery_zeroconf_announcer_t *announcer, celix_properties_iterator_t *propIter, TXTRecordRef *txtRecord, uint16_t maxTxtLen, bool splitTxtRecord) {
     const char *key;
     const char *val;
+    char keyBuf[UINT8_MAX+1];
     while (!celix_propertiesIterator_isEnd(propIter)) {
         key = propIter->key;
         val = propIter->entry.value;
+        if (key && announcer->compactTxtRecord) {
+            key = discoveryZeroconf_compactTxtRecordKey(key, keyBuf, sizeof(keyBuf));
+            if (key == NULL) {
+                celix_logHelper_error(announcer->logHelper, "Announcer: Txt record key %s is too long.", propIter->key);
+                return false;
+            }
+        }
         if (key) {
             DNSServiceErrorType err = TXTRecordSetValue(txtRecord, key, strlen(val), val);
             if (err != kDNSServiceErr_NoError) {
@@ -478,10 +522,13 @@ static void discoveryZeroconfAnnouncer_announceEndpoints(discovery_zeroconf_anno
         celix_properties_iterator_t propIter = celix_properties_begin(entry->properties);
 
         TXTRecordCreate(&txtRecord, sizeof(txtBuf), txtBuf);
-        (void)TXTRecordSetValue(&txtRecord, DZC_TXT_RECORD_VERSION_KEY, sizeof(DZC_CURRENT_TXT_RECORD_VERSION)-1, DZC_CURRENT_TXT_RECORD_VERSION);
+        const char *txtVersion = announcer->compactTxtRecord ? DZC_COMPACT_TXT_RECORD_VERSION : DZC_CURRENT_TXT_RECORD_VERSION;
+        (void)TXTRecordSetValue(&txtRecord, DZC_TXT_RECORD_VERSION_KEY, strlen(txtVersion), txtVersion);
         char propSizeStr[16]= {0};
         sprintf(propSizeStr, "%zu", celix_properties_size(entry->properties) + 2/*size and version*/);
-        (void)TXTRecordSetValue(&txtRecord, DZC_SERVICE_PROPERTIES_SIZE_KEY, strlen(propSizeStr), propSizeStr);
+        char keyBuf[UINT8_MAX+1];
+        const char *propSizeKey = announcer->compactTxtRecord ? discoveryZeroconf_compactTxtRecordKey(DZC_SERVICE_PROPERTIES_SIZE_KEY, keyBuf, sizeof(keyBuf)) : DZC_SERVICE_PROPERTIES_SIZE_KEY;
+        (void)TXTRecordSetValue(&txtRecord, propSizeKey, strlen(propSizeStr), propSizeStr);
         if (!discoveryZeroconfAnnouncer_copyPropertiesToTxtRecord(announcer, &propIter, &txtRecord, sizeof(txtBuf), splitTxtRecord)) {
             TXTRecordDeallocate(&txtRecord);
             continue;
@@ -572,6 +619,9 @@ static void *discoveryZeroconfAnnouncer_refreshEndpointThread(void *data) {
     struct timeval *timeout = NULL;
     struct timeval timeVal;
     bool running = announcer->running;
+    bool announcePending = false;//there are endpoints waiting for the registration budget of next second
+    struct timespec registrationTime = {0, 0};//start time of the current registration budget
+    int registrationCnt = 0;
     while (running) {
         if (announcer->sharedRef == NULL) {
             dnsErr = DNSServiceCreateConnection(&announcer->sharedRef);
@@ -590,7 +640,13 @@ static void *discoveryZeroconfAnnouncer_refreshEndpointThread(void *data) {
             assert(dsFd >= 0);
             FD_SET(dsFd, &readfds);
             maxFd = MAX(maxFd, dsFd);
-            timeout = NULL;
+            if (announcePending) {
+                timeVal.tv_sec = 1;//announce the pending endpoints with the registration budget of next second
+                timeVal.tv_usec = 0;
+                timeout = &timeVal;
+            } else {
+                timeout = NULL;
+            }
         } else {
             dsFd = -1;
             timeVal.tv_sec = 5;//If the connection fails to be created, reconnect it after 5 seconds
@@ -599,9 +655,18 @@ static void *discoveryZeroconfAnnouncer_refreshEndpointThread(void *data) {
         }
 
         int result = select(maxFd+1, &readfds, NULL, NULL, timeout);
-        if (result > 0) {
-            if (FD_ISSET(announcer->eventFd, &readfds)) {
+        if (result >= 0) {
+            bool eventNotified = result > 0 && FD_ISSET(announcer->eventFd, &readfds);
+            if (eventNotified) {
                 eventfd_read(announcer->eventFd, &val);
+            }
+            if (eventNotified || announcePending) {
+                struct timespec now = celix_gettime(CLOCK_MONOTONIC);
+                if (celix_difftime(&registrationTime, &now) >= 1.0) {
+                    registrationTime = now;
+                    registrationCnt = 0;
+                }
+                announcePending = false;
 
                 celixThreadMutex_lock(&announcer->mutex);
                 int size = celix_arrayList_size(announcer->revokedEndpoints);
@@ -609,12 +674,18 @@ static void *discoveryZeroconfAnnouncer_refreshEndpointThread(void *data) {
                     celix_arrayList_add(revokedEndpoints, celix_arrayList_get(announcer->revokedEndpoints, i));
                 }
                 celix_arrayList_clear(announcer->revokedEndpoints);
+                discoveryZeroconfAnnouncer_keepUnchangedRegistrations(announcer, revokedEndpoints);
 
                 if (announcer->sharedRef != NULL) {
                     CELIX_STRING_HASH_MAP_ITERATE(announcer->endpoints, iter) {
                         announce_endpoint_entry_t *entry = (announce_endpoint_entry_t *) iter.value.ptrValue;
                         if (entry->announced == false && entry->registerRef == NULL) {
+                            if (registrationCnt >= DZC_MAX_REGISTRATIONS_PER_SECOND) {
+                                announcePending = true;
+                                break;
+                            }
                             celix_arrayList_add(announcedEndpoints, entry);
+                            registrationCnt++;
                         }
                     }
                 }
@@ -629,7 +700,7 @@ static void *discoveryZeroconfAnnouncer_refreshEndpointThread(void *data) {
             if (dsFd >= 0 && FD_ISSET(dsFd, &readfds)) {
                 discoveryZeroconfAnnouncer_handleMDNSEvent(announcer);
             }
-        } else if (result == -1 && errno != EINTR) {
+        } else if (errno != EINTR) {
             celix_logHelper_error(announcer->logHelper, "Announcer: Error Selecting event, %d.", errno);
             sleep(1);//avoid busy loop
         }
@@ -60,6 +60,23 @@ extern "C" {
 #define DZC_TXT_RECORD_VERSION_KEY "txtvers"
 #define DZC_CURRENT_TXT_RECORD_VERSION "1"
 
+/**
+ * The version of mDNS txt record in the compact encoding.
+ *
+ * In the compact encoding, the common service property keys are replaced by short keys.
+ * @see DZC_COMPACT_TXT_RECORD
+ */
+#define DZC_COMPACT_TXT_RECORD_VERSION "2"
+
+/**
+ * Config property to announce endpoints using the compact txt record encoding. The type of the value is bool.
+ *
+ * The compact encoding reduces the size of the txt records of an endpoint, and so the multicast traffic of announcing.
+ * Discovery zeroconf of older versions can not resolve endpoints announced using the compact encoding.
+ */
+#define DZC_COMPACT_TXT_RECORD "CELIX_RSA_DISCOVERY_ZEROCONF_COMPACT_TXT_RECORD"
+#define DZC_COMPACT_TXT_RECORD_DEFAULT false
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,86 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "discovery_zeroconf_txt_record.h"
+#include "discovery_zeroconf_constants.h"
+#include "remote_constants.h"
+#include "celix_constants.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct discovery_zeroconf_txt_key {
+    const char* compactKey;
+    const char* key;
+} discovery_zeroconf_txt_key_t;
+
+//The service property keys that are set for every endpoint, or for most endpoints
+static const discovery_zeroconf_txt_key_t dzc_txtKeyDictionary[] = {
+    {"~c", CELIX_FRAMEWORK_SERVICE_NAME},
+    {"~v", CELIX_FRAMEWORK_SERVICE_VERSION},
+    {"~r", CELIX_FRAMEWORK_SERVICE_RANKING},
+    {"~i", CELIX_RSA_ENDPOINT_ID},
+    {"~s", CELIX_RSA_ENDPOINT_SERVICE_ID},
+    {"~f", CELIX_RSA_ENDPOINT_FRAMEWORK_UUID},
+    {"~m", CELIX_RSA_SERVICE_IMPORTED},
+    {"~g", CELIX_RSA_SERVICE_IMPORTED_CONFIGS},
+    {"~e", CELIX_RSA_SERVICE_EXPORTED_INTERFACES},
+    {"~x", CELIX_RSA_SERVICE_EXPORTED_CONFIGS},
+    {"~a", CELIX_RSA_IP_ADDRESSES},
+    {"~n", DZC_SERVICE_PROPERTIES_SIZE_KEY},
+};
+
+const char* discoveryZeroconf_compactTxtRecordKey(const char* key, char* buf, size_t bufSize) {
+    for (size_t i = 0; i < sizeof(dzc_txtKeyDictionary) / sizeof(dzc_txtKeyDictionary[0]); ++i) {
+        if (strcmp(key, dzc_txtKeyDictionary[i].key) == 0) {
+            return dzc_txtKeyDictionary[i].compactKey;
+        }
+    }
+    if (key[0] != DZC_COMPACT_TXT_RECORD_KEY_PREFIX) {
+        return key;
+    }
+    int bytes = snprintf(buf, bufSize, "%c%s", DZC_COMPACT_TXT_RECORD_KEY_PREFIX, key);
+    return (bytes >= 0 && (size_t)bytes < bufSize) ? buf : NULL;
+}
+
+const char* discoveryZeroconf_expandTxtRecordKey(const char* txtKey) {
+    if (txtKey[0] != DZC_COMPACT_TXT_RECORD_KEY_PREFIX) {
+        return txtKey;
+    }
+    if (txtKey[1] == DZC_COMPACT_TXT_RECORD_KEY_PREFIX) {
+        return txtKey + 1;//escaped key
+    }
+    for (size_t i = 0; i < sizeof(dzc_txtKeyDictionary) / sizeof(dzc_txtKeyDictionary[0]); ++i) {
+        if (strcmp(txtKey, dzc_txtKeyDictionary[i].compactKey) == 0) {
+            return dzc_txtKeyDictionary[i].key;
+        }
+    }
+    return txtKey;
+}
+
+celix_properties_t* discoveryZeroconf_expandTxtRecord(const celix_properties_t* txtRecord) {
+    celix_autoptr(celix_properties_t) expanded = celix_properties_create();
+    if (expanded == NULL) {
+        return NULL;
+    }
+    CELIX_PROPERTIES_ITERATE(txtRecord, iter) {
+        if (celix_properties_set(expanded, discoveryZeroconf_expandTxtRecordKey(iter.key), iter.entry.value) != CELIX_SUCCESS) {
+            return NULL;
+        }
+    }
+    return celix_steal_ptr(expanded);
+}
@@ -0,0 +1,71 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef CELIX_DISCOVERY_ZEROCONF_TXT_RECORD_H
+#define CELIX_DISCOVERY_ZEROCONF_TXT_RECORD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stddef.h>
+#include "celix_properties.h"
+
+/**
+ * The prefix of the compact txt record keys.
+ *
+ * In the compact txt record encoding, the common service property keys(e.g. "objectClass", "endpoint.id") are replaced
+ * by DZC_COMPACT_TXT_RECORD_KEY_PREFIX + one character. Service property keys starting with the prefix are escaped by
+ * doubling the prefix.
+ */
+#define DZC_COMPACT_TXT_RECORD_KEY_PREFIX '~'
+
+/**
+ * @brief Get the txt record key of a service property key in the compact txt record encoding.
+ *
+ * @param[in] key The service property key.
+ * @param[in] buf The buffer for an escaped key.
+ * @param[in] bufSize The size of the buffer.
+ * @return The compact txt record key, or NULL if the escaped key does not fit in the buffer.
+ */
+const char* discoveryZeroconf_compactTxtRecordKey(const char* key, char* buf, size_t bufSize);
+
+/**
+ * @brief Get the service property key of a txt record key.
+ *
+ * Txt record keys of the compact txt record encoding are expanded, other keys are returned as is.
+ * Must only be used for txt records in the compact encoding (DZC_COMPACT_TXT_RECORD_VERSION), in the other encodings
+ * "~" has no special meaning.
+ *
+ * @param[in] txtKey The txt record key.
+ * @return The service property key.
+ */
+const char* discoveryZeroconf_expandTxtRecordKey(const char* txtKey);
+
+/**
+ * @brief Create the service properties of a complete txt record in the compact txt record encoding.
+ *
+ * @param[in] txtRecord The txt record items, keyed by txt record key.
+ * @return The txt record items keyed by service property key, or NULL if out of memory.
+ */
+celix_properties_t* discoveryZeroconf_expandTxtRecord(const celix_properties_t* txtRecord);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //CELIX_DISCOVERY_ZEROCONF_TXT_RECORD_H
@@ -18,6 +18,7 @@
  */
 #include "discovery_zeroconf_watcher.h"
 #include "discovery_zeroconf_constants.h"
+#include "discovery_zeroconf_txt_record.h"
 #include "endpoint_listener.h"
 #include "remote_constants.h"
 #include "celix_bundle_context.h"
@@ -34,6 +35,7 @@
 #include <sys/eventfd.h>
 #include <sys/select.h>
 #include <sys/param.h>
+#include <sys/queue.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <stdlib.h>
@@ -44,15 +46,23 @@
 #include <assert.h>
 #include <errno.h>
 #include <arpa/inet.h>
+#include <poll.h>
 
 #define DZC_EP_JITTER_INTERVAL 5//The jitter interval for endpoint.Avoid updating endpoint description on all network interfaces when only one network interface is updated.The endpoint description will be removed when the service is removed for 5 seconds.
 #define DZC_MAX_RESOLVED_CNT 10 //Max resolved count for each service when resolve service failed
 #define DZC_MAX_RETRY_INTERVAL 5 //Max retry interval when resolve service failed
+#define DZC_MAX_IN_FLIGHT_RESOLVES 32 //Max count of services resolved at the same time, the others wait in the resolve queue
+#define DZC_RESOLVE_TIMEOUT 10 //Timeout(in seconds) of a service resolve, a timed out resolve is moved to the end of the resolve queue
+#define DZC_MAX_HOST_CACHE_TTL 120 //Max time(in seconds) the ip addresses of a host are cached after no service uses the host
 
 #define DZC_MAX_HOSTNAME_LEN 255 //The fully qualified domain name of the host, eg: "MyComputer.local". RFC 1034 specifies that this name is limited to 255 bytes.
 
 #define DZC_MAX_SERVICE_INSTANCE_NAME_LEN 64 //The instanceName must be 1-63 bytes, + 1 for '\0'
 
+typedef struct watched_service_entry watched_service_entry_t;
+
+TAILQ_HEAD(watched_service_list, watched_service_entry);
+
 struct discovery_zeroconf_watcher {
     celix_bundle_context_t *ctx;
     celix_log_helper_t *logHelper;
@@ -60,8 +70,19 @@ struct discovery_zeroconf_watcher {
     DNSServiceRef sharedRef;
     int eventFd;
     celix_thread_t watchEPThread;
+    //The fields below are only used in watchEPThread
     celix_string_hash_map_t *watchedServices;//key:instanceName+'/'+interfaceIndex, val:watched_service_entry_t*
     celix_string_hash_map_t *watchedHosts;//key:hostname+interfaceIndex, val:watched_host_entry_t*
+    struct watched_service_list queuedResolves;//services waiting for resolve, in FIFO order
+    struct watched_service_list inFlightResolves;//services being resolved
+    struct watched_service_list resolvedServices;//resolved services, their resolve stays open to receive txt record, host and port updates
+    int inFlightResolveCnt;
+    int cachedHostCnt;
+    bool moreComing;//more mDNS results are queued on the shared connection
+    bool servicesChanged;//the browsed services changed, watched services need to be refreshed
+    bool hostsChanged;//the hostnames of watched services changed, watched hosts need to be refreshed
+    bool endpointsChanged;//the watched services or host ip addresses changed, endpoints need to be refreshed
+    struct timespec endpointsExpiredTime;//the earliest expired time of watched endpoints
     celix_thread_mutex_t mutex;//projects below
     bool running;
     celix_string_hash_map_t *watchedEndpoints;//key:endpoint id, val:watched_endpoint_entry_t*
@@ -77,9 +98,18 @@ typedef struct watched_endpoint_entry {
     struct timespec expiredTime;
 }watched_endpoint_entry_t;
 
-typedef struct watched_service_entry {
+typedef enum watched_service_resolve_state {
+    DZC_RESOLVE_STATE_IDLE,
+    DZC_RESOLVE_STATE_QUEUED,
+    DZC_RESOLVE_STATE_IN_FLIGHT,
+    DZC_RESOLVE_STATE_RESOLVED,
+} watched_service_resolve_state_e;
+
+struct watched_service_entry {
+    discovery_zeroconf_watcher_t *watcher;
     celix_log_helper_t *logHelper;
-    celix_properties_t *txtRecord;
+    celix_properties_t *txtRecord;//the txt record items as received
+    celix_properties_t *properties;//the endpoint properties of the complete txt record, NULL if not yet complete
     const char *endpointId;
     int ifIndex;
     char instanceName[DZC_MAX_SERVICE_INSTANCE_NAME_LEN];
@@ -88,9 +118,14 @@ typedef struct watched_service_entry {
     bool resolved;
     int resolvedCnt;
     DNSServiceRef resolveRef;
+    watched_service_resolve_state_e resolveState;
+    struct timespec resolveStartTime;
+    TAILQ_ENTRY(watched_service_entry) resolveEntry;//entry of queuedResolves, inFlightResolves or resolvedServices
     bool reResolve;
+    bool updated;//the properties, host or port changed after the service was resolved, the endpoint must be recreated
+    int createEndpointFailedCnt;
     bool markDeleted;
-}watched_service_entry_t;
+};
 
 typedef struct watched_epl_entry {
     endpoint_listener_t *epl;
@@ -98,6 +133,7 @@ typedef struct watched_epl_entry {
 }watched_epl_entry_t;
 
 typedef struct service_browser_entry {
+    discovery_zeroconf_watcher_t *watcher;
     DNSServiceRef browseRef;
     celix_log_helper_t *logHelper;
     celix_string_hash_map_t *watchedServices;//key:instanceName+'/'+interfaceIndex, val:interfaceIndex
@@ -107,14 +143,19 @@ typedef struct service_browser_entry {
 }service_browser_entry_t;
 
 typedef struct watched_host_entry {
+    discovery_zeroconf_watcher_t *watcher;
     DNSServiceRef sdRef;
     celix_log_helper_t *logHelper;
     char *hostname;
     int ifIndex;
     celix_string_hash_map_t  *ipAddresses;//key:ip address, val:true(ipv4)/false(ipv6)
+    uint32_t ttl;//time to live(in seconds) of the ip addresses
     bool resolved;
     int resolvedCnt;
     bool markDeleted;
+    bool cached;//no service uses the host, the ip addresses are kept until expiredTime
+    bool staleAddresses;//the ip addresses are reused from cache, they are replaced by the first result of the new query
+    struct timespec expiredTime;
 }watched_host_entry_t;
 
 static void OnServiceResolveCallback(DNSServiceRef sdRef, DNSServiceFlags flags, uint32_t interfaceIndex, DNSServiceErrorType errorCode, const char *fullname, const char *host, uint16_t port, uint16_t txtLen, const unsigned char *txtRecord, void *context);
@@ -131,6 +172,17 @@ celix_status_t discoveryZeroconfWatcher_create(celix_bundle_context_t *ctx, celi
     watcher->logHelper = logHelper;
     watcher->ctx = ctx;
     watcher->sharedRef = NULL;
+    TAILQ_INIT(&watcher->queuedResolves);
+    TAILQ_INIT(&watcher->inFlightResolves);
+    TAILQ_INIT(&watcher->resolvedServices);
+    watcher->inFlightResolveCnt = 0;
+    watcher->cachedHostCnt = 0;
+    watcher->moreComing = false;
+    watcher->servicesChanged = false;
+    watcher->hostsChanged = false;
+    watcher->endpointsChanged = false;
+    watcher->endpointsExpiredTime.tv_sec = INT_MAX;
+    watcher->endpointsExpiredTime.tv_nsec = 0;
     watcher->eventFd = eventfd(0, 0);
     if (watcher->eventFd < 0) {
         celix_logHelper_error(logHelper, "Watcher: Failed to open event fd, %d.", errno);
@@ -343,6 +395,7 @@ int discoveryZeroConfWatcher_addRSA(void *handle, void *svc, const celix_propert
                 celix_logHelper_error(watcher->logHelper, "Watcher: Failed to create watched services map.");
                 break;
             }
+            browserEntry->watcher = watcher;
             browserEntry->refCnt = 1;
             browserEntry->resolvedCnt = 0;
             browserEntry->browseRef = NULL;
@@ -406,13 +459,36 @@ int discoveryZeroConfWatcher_removeRSA(void *handle, void *svc, const celix_prop
     return CELIX_SUCCESS;
 }
 
+/**
+ * Creates the endpoint properties of a complete txt record, i.e. the txt record items with expanded keys
+ * and without the txt record version and properties size items.
+ */
+static celix_properties_t* discoveryZeroconfWatcher_createServiceProperties(const celix_properties_t *txtRecord, bool compactTxtRecord) {
+    celix_autoptr(celix_properties_t) props = NULL;
+    if (compactTxtRecord) {
+        props = discoveryZeroconf_expandTxtRecord(txtRecord);
+    } else {
+        props = celix_properties_create();
+        CELIX_PROPERTIES_ITERATE(txtRecord, iter) {
+            if (props != NULL && celix_properties_set(props, iter.key, iter.entry.value) != CELIX_SUCCESS) {
+                return NULL;
+            }
+        }
+    }
+    if (props == NULL) {
+        return NULL;
+    }
+    celix_properties_unset(props, DZC_SERVICE_PROPERTIES_SIZE_KEY);//Service endpoint do not need it
+    celix_properties_unset(props, DZC_TXT_RECORD_VERSION_KEY);//Service endpoint do not need it
+    return celix_steal_ptr(props);
+}
+
 static void OnServiceResolveCallback(DNSServiceRef sdRef, DNSServiceFlags flags, uint32_t interfaceIndex, DNSServiceErrorType errorCode, const char *fullname, const char *host, uint16_t port, uint16_t txtLen, const unsigned char *txtRecord, void *context) {
     (void)sdRef;//unused
-    (void)flags;//unused
-    (void)port;//unused
     (void)fullname;//unused
     watched_service_entry_t *svcEntry = (watched_service_entry_t *)context;
     assert(svcEntry != NULL);
+    svcEntry->watcher->moreComing = (flags & kDNSServiceFlagsMoreComing);
     if (errorCode != kDNSServiceErr_NoError || strlen(host) > DZC_MAX_HOSTNAME_LEN) {
         celix_logHelper_error(svcEntry->logHelper, "Watcher: Failed to resolve service, or hostname invalid, %d.", errorCode);
         return;
@@ -434,6 +510,7 @@ static void OnServiceResolveCallback(DNSServiceRef sdRef, DNSServiceFlags flags,
         }
         assert(valLen <= UINT8_MAX);
         memcpy(val, valPtr, valLen);
+        //note keys are stored as is, because the txt record version (and so the key encoding) can be in a later txt record
         int status = celix_properties_set(properties, key, val);
         if (status != CELIX_SUCCESS) {
             celix_logHelper_logTssErrors(svcEntry->logHelper, CELIX_LOG_LEVEL_ERROR);
@@ -442,25 +519,53 @@ static void OnServiceResolveCallback(DNSServiceRef sdRef, DNSServiceFlags flags,
             return;
         }
     }
-    svcEntry->endpointId = celix_properties_get(properties, CELIX_RSA_ENDPOINT_ID, NULL);
 
-    long propSize = celix_properties_getAsLong(properties, DZC_SERVICE_PROPERTIES_SIZE_KEY, 0);
     const char *version = celix_properties_get(properties, DZC_TXT_RECORD_VERSION_KEY, "");
-    if (propSize == celix_properties_size(properties) && strcmp(DZC_CURRENT_TXT_RECORD_VERSION, version) == 0) {
-        svcEntry->port = ntohs(port);
-        if (celix_properties_get(properties, CELIX_RSA_IP_ADDRESSES, NULL) != NULL) {//If no need fill in dynamic ip address, no need to resolve ip address
-            free(svcEntry->hostname);//free old hostname
-            svcEntry->hostname = celix_utils_strdup(host);
-            if (svcEntry->hostname == NULL) {
-                celix_logHelper_error(svcEntry->logHelper, "Watcher: Failed to dup hostname.");
-                svcEntry->reResolve = true;
-                return;
-            }
+    bool compactTxtRecord = strcmp(DZC_COMPACT_TXT_RECORD_VERSION, version) == 0;
+    bool supportedVersion = strcmp(DZC_CURRENT_TXT_RECORD_VERSION, version) == 0 || compactTxtRecord;
+    char keyBuf[UINT8_MAX+1];
+    const char *propSizeKey = compactTxtRecord ? discoveryZeroconf_compactTxtRecordKey(DZC_SERVICE_PROPERTIES_SIZE_KEY, keyBuf, sizeof(keyBuf)) : DZC_SERVICE_PROPERTIES_SIZE_KEY;
+    long propSize = celix_properties_getAsLong(properties, propSizeKey, 0);
+    if (propSize != celix_properties_size(properties) || !supportedVersion) {
+        return;//wait for the other txt records
+    }
+
+    celix_autoptr(celix_properties_t) svcProps = discoveryZeroconfWatcher_createServiceProperties(properties, compactTxtRecord);
+    if (svcProps == NULL) {
+        celix_logHelper_logTssErrors(svcEntry->logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(svcEntry->logHelper, "Watcher: Failed to create endpoint properties of %s.", svcEntry->instanceName);
+        svcEntry->reResolve = true;
+        return;
+    }
+    celix_autofree char *hostname = NULL;
+    if (celix_properties_get(svcProps, CELIX_RSA_IP_ADDRESSES, NULL) != NULL) {//If no need fill in dynamic ip address, no need to resolve ip address
+        hostname = celix_utils_strdup(host);
+        if (hostname == NULL) {
+            celix_logHelper_error(svcEntry->logHelper, "Watcher: Failed to dup hostname.");
+            svcEntry->reResolve = true;
+            return;
         }
+    }
 
-        celix_properties_unset(properties, DZC_SERVICE_PROPERTIES_SIZE_KEY);//Service endpoint do not need it
-        celix_properties_unset(properties, DZC_TXT_RECORD_VERSION_KEY);//Service endpoint do not need it
-        svcEntry->resolved = true;
+    bool hostChanged = (hostname == NULL) != (svcEntry->hostname == NULL) || (hostname != NULL && strcmp(hostname, svcEntry->hostname) != 0);
+    if (svcEntry->properties != NULL && !hostChanged && svcEntry->port == ntohs(port) && celix_properties_equals(svcEntry->properties, svcProps)) {
+        return;//nothing changed
+    }
+    bool updated = svcEntry->properties != NULL;
+    celix_properties_destroy(svcEntry->properties);
+    svcEntry->properties = celix_steal_ptr(svcProps);
+    free(svcEntry->hostname);
+    svcEntry->hostname = celix_steal_ptr(hostname);
+    svcEntry->port = ntohs(port);
+    svcEntry->endpointId = celix_properties_get(svcEntry->properties, CELIX_RSA_ENDPOINT_ID, NULL);
+    svcEntry->resolved = true;
+    svcEntry->createEndpointFailedCnt = 0;
+    if (updated) {
+        celix_logHelper_debug(svcEntry->logHelper, "Watcher: Updated service %s on %u.", svcEntry->instanceName, interfaceIndex);
+        svcEntry->updated = true;
+        svcEntry->watcher->hostsChanged = svcEntry->watcher->hostsChanged || hostChanged;
+        svcEntry->watcher->endpointsChanged = true;
+    } else {
         celix_logHelper_trace(svcEntry->logHelper, "Watcher: Resolved service %s on %u.", svcEntry->instanceName, interfaceIndex);
     }
     return;
@@ -472,6 +577,7 @@ static void OnServiceBrowseCallback(DNSServiceRef sdRef, DNSServiceFlags flags,
     (void)replyDomain;//unused
     service_browser_entry_t *browser = (service_browser_entry_t *)context;
     assert(browser != NULL);
+    browser->watcher->moreComing = (flags & kDNSServiceFlagsMoreComing);
     if (errorCode != kDNSServiceErr_NoError) {
         celix_logHelper_error(browser->logHelper, "Watcher: Failed to browse service, %d.", errorCode);
         return;
@@ -486,6 +592,7 @@ static void OnServiceBrowseCallback(DNSServiceRef sdRef, DNSServiceFlags flags,
 
     char key[128]={0};
     (void)snprintf(key, sizeof(key), "%s/%d", instanceName, (int)interfaceIndex);
+    browser->watcher->servicesChanged = true;
     if (flags & kDNSServiceFlagsAdd) {
         int status = celix_stringHashMap_putLong(browser->watchedServices, key, interfaceIndex);
         if (status != CELIX_SUCCESS) {
@@ -535,6 +642,7 @@ static void discoveryZeroconfWatcher_pickUpdatedServiceBrowsers(discovery_zeroco
         service_browser_entry_t *browserEntry = (service_browser_entry_t *)iter2.value.ptrValue;
         if (browserEntry->markDeleted) {
             celix_logHelper_trace(watcher->logHelper, "Watcher: Stop to browse service type %s,%s.", DZC_SERVICE_PRIMARY_TYPE, iter2.key);
+            watcher->servicesChanged = true;
             celix_stringHashMapIterator_remove(&iter2);
             if (browserEntry->browseRef) {
                 DNSServiceRefDeallocate(browserEntry->browseRef);
@@ -572,34 +680,151 @@ static void discoveryZeroconfWatcher_browseServices(discovery_zeroconf_watcher_t
     return;
 }
 
-static void discoveryZeroconfWatcher_resolveServices(discovery_zeroconf_watcher_t *watcher, unsigned int *pNextWorkIntervalTime) {
+static void watchedServiceEntry_stopResolve(discovery_zeroconf_watcher_t *watcher, watched_service_entry_t *svcEntry) {
+    if (svcEntry->resolveState == DZC_RESOLVE_STATE_QUEUED) {
+        TAILQ_REMOVE(&watcher->queuedResolves, svcEntry, resolveEntry);
+    } else if (svcEntry->resolveState == DZC_RESOLVE_STATE_IN_FLIGHT) {
+        TAILQ_REMOVE(&watcher->inFlightResolves, svcEntry, resolveEntry);
+        watcher->inFlightResolveCnt--;
+    } else if (svcEntry->resolveState == DZC_RESOLVE_STATE_RESOLVED) {
+        TAILQ_REMOVE(&watcher->resolvedServices, svcEntry, resolveEntry);
+    }
+    svcEntry->resolveState = DZC_RESOLVE_STATE_IDLE;
+    if (svcEntry->resolveRef) {
+        DNSServiceRefDeallocate(svcEntry->resolveRef);
+        svcEntry->resolveRef = NULL;
+    }
+    return;
+}
+
+static void watchedServiceEntry_queueResolve(discovery_zeroconf_watcher_t *watcher, watched_service_entry_t *svcEntry) {
+    assert(svcEntry->resolveState == DZC_RESOLVE_STATE_IDLE);
+    svcEntry->resolveState = DZC_RESOLVE_STATE_QUEUED;
+    TAILQ_INSERT_TAIL(&watcher->queuedResolves, svcEntry, resolveEntry);
+    return;
+}
+
+static void watchedServiceEntry_destroy(discovery_zeroconf_watcher_t *watcher, watched_service_entry_t *svcEntry) {
+    watchedServiceEntry_stopResolve(watcher, svcEntry);
+    celix_properties_destroy(svcEntry->properties);
+    celix_properties_destroy(svcEntry->txtRecord);
+    free(svcEntry->hostname);
+    free(svcEntry);
+    return;
+}
+
+static bool discoveryZeroconfWatcher_removeSameFrameworkService(discovery_zeroconf_watcher_t *watcher, watched_service_entry_t *svcEntry) {
+    const char *epFwUuid = celix_properties_get(svcEntry->properties, CELIX_RSA_ENDPOINT_FRAMEWORK_UUID, NULL);
+    if (epFwUuid == NULL || strcmp(epFwUuid, watcher->fwUuid) != 0) {
+        return false;
+    }
+    celix_logHelper_debug(watcher->logHelper, "Watcher: Ignore self endpoint for %s.", celix_properties_get(svcEntry->properties, CELIX_FRAMEWORK_SERVICE_NAME, "unknown"));
+
+    //remove service instance name from service browser
+    char instanceNameKey[128]={0};
+    (void)snprintf(instanceNameKey, sizeof(instanceNameKey), "%s/%d", svcEntry->instanceName, svcEntry->ifIndex);
+    celixThreadMutex_lock(&watcher->mutex);
+    CELIX_STRING_HASH_MAP_ITERATE(watcher->serviceBrowsers, iter) {
+        service_browser_entry_t *browserEntry = (service_browser_entry_t *)iter.value.ptrValue;
+        celix_stringHashMap_remove(browserEntry->watchedServices, instanceNameKey);
+    }
+    celixThreadMutex_unlock(&watcher->mutex);
+
+    celix_stringHashMap_remove(watcher->watchedServices, instanceNameKey);
+    watchedServiceEntry_destroy(watcher, svcEntry);
+    return true;
+}
+
+static void discoveryZeroconfWatcher_completeResolves(discovery_zeroconf_watcher_t *watcher, const struct timespec *now, unsigned int *pNextWorkIntervalTime) {
     unsigned int nextWorkIntervalTime = *pNextWorkIntervalTime;
 
-    CELIX_STRING_HASH_MAP_ITERATE(watcher->watchedServices, iter) {
-        watched_service_entry_t *svcEntry = (watched_service_entry_t *)iter.value.ptrValue;
-        if (watcher->sharedRef && svcEntry->resolveRef == NULL && svcEntry->resolvedCnt < DZC_MAX_RESOLVED_CNT) {
-            celix_logHelper_trace(watcher->logHelper, "Watcher: Start to resolve service %s on %d.", svcEntry->instanceName, svcEntry->ifIndex);
-            svcEntry->resolveRef = watcher->sharedRef;
-            DNSServiceErrorType dnsErr = DNSServiceResolve(&svcEntry->resolveRef, kDNSServiceFlagsShareConnection , svcEntry->ifIndex, svcEntry->instanceName, DZC_SERVICE_PRIMARY_TYPE, "local", OnServiceResolveCallback, svcEntry);
-            if (dnsErr != kDNSServiceErr_NoError) {
-                svcEntry->resolveRef = NULL;
-                celix_logHelper_error(watcher->logHelper, "Watcher: Failed to resolve %s on %d, %d.", svcEntry->instanceName, svcEntry->ifIndex, dnsErr);
-                nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry resolve after 5 seconds
+    watched_service_entry_t *svcEntry = TAILQ_FIRST(&watcher->inFlightResolves);
+    while (svcEntry != NULL) {
+        watched_service_entry_t *nextEntry = TAILQ_NEXT(svcEntry, resolveEntry);
+        if (svcEntry->reResolve) {//release resolveRef and retry resolve service after 5 seconds
+            svcEntry->reResolve = false;
+            watchedServiceEntry_stopResolve(watcher, svcEntry);
+            svcEntry->resolvedCnt = 0;
+            svcEntry->resolved = false;
+            watchedServiceEntry_queueResolve(watcher, svcEntry);
+            nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry resolve after 5 seconds
+        } else if (svcEntry->resolved) {
+            //The txt record is complete, release the in-flight slot for the queued services.
+            //The resolve stays open, so that later txt record, host and port changes are still received.
+            TAILQ_REMOVE(&watcher->inFlightResolves, svcEntry, resolveEntry);
+            watcher->inFlightResolveCnt--;
+            svcEntry->resolveState = DZC_RESOLVE_STATE_RESOLVED;
+            TAILQ_INSERT_TAIL(&watcher->resolvedServices, svcEntry, resolveEntry);
+            if (!discoveryZeroconfWatcher_removeSameFrameworkService(watcher, svcEntry)) {
+                watcher->hostsChanged = watcher->hostsChanged || svcEntry->hostname != NULL;
+                watcher->endpointsChanged = true;
+            }
+        } else {
+            int elapsed = (int)celix_difftime(&svcEntry->resolveStartTime, now);
+            if (elapsed >= DZC_RESOLVE_TIMEOUT) {
+                celix_logHelper_debug(watcher->logHelper, "Watcher: Resolve service %s on %d timeout.", svcEntry->instanceName, svcEntry->ifIndex);
+                watchedServiceEntry_stopResolve(watcher, svcEntry);
+                if (svcEntry->resolvedCnt < DZC_MAX_RESOLVED_CNT) {
+                    watchedServiceEntry_queueResolve(watcher, svcEntry);
+                }
+            } else {
+                nextWorkIntervalTime = MIN(nextWorkIntervalTime, (unsigned int)(DZC_RESOLVE_TIMEOUT - elapsed));
             }
-            svcEntry->resolvedCnt ++;
         }
+        svcEntry = nextEntry;
+    }
 
-        if (svcEntry->reResolve) {//release resolveRef and retry resolve service after 5 seconds
+    svcEntry = TAILQ_FIRST(&watcher->resolvedServices);
+    while (svcEntry != NULL) {
+        watched_service_entry_t *nextEntry = TAILQ_NEXT(svcEntry, resolveEntry);
+        if (svcEntry->reResolve) {//failed to handle an update, resolve the service again. The current endpoint stays until the update is handled.
             svcEntry->reResolve = false;
-            if (svcEntry->resolveRef) {
-                DNSServiceRefDeallocate(svcEntry->resolveRef);
-                svcEntry->resolveRef = NULL;
-            }
+            watchedServiceEntry_stopResolve(watcher, svcEntry);
             svcEntry->resolvedCnt = 0;
-            svcEntry->resolved = false;
+            watchedServiceEntry_queueResolve(watcher, svcEntry);
             nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry resolve after 5 seconds
         }
+        svcEntry = nextEntry;
     }
+
+    *pNextWorkIntervalTime = nextWorkIntervalTime;
+    return;
+}
+
+static void discoveryZeroconfWatcher_resolveServices(discovery_zeroconf_watcher_t *watcher, unsigned int *pNextWorkIntervalTime) {
+    unsigned int nextWorkIntervalTime = *pNextWorkIntervalTime;
+    struct watched_service_list failedResolves = TAILQ_HEAD_INITIALIZER(failedResolves);
+    struct timespec now = celix_gettime(CLOCK_MONOTONIC);
+
+    discoveryZeroconfWatcher_completeResolves(watcher, &now, &nextWorkIntervalTime);
+
+    watched_service_entry_t *svcEntry = NULL;
+    while (watcher->sharedRef && watcher->inFlightResolveCnt < DZC_MAX_IN_FLIGHT_RESOLVES
+           && (svcEntry = TAILQ_FIRST(&watcher->queuedResolves)) != NULL) {
+        TAILQ_REMOVE(&watcher->queuedResolves, svcEntry, resolveEntry);
+        svcEntry->resolveState = DZC_RESOLVE_STATE_IDLE;
+        celix_logHelper_trace(watcher->logHelper, "Watcher: Start to resolve service %s on %d.", svcEntry->instanceName, svcEntry->ifIndex);
+        svcEntry->resolveRef = watcher->sharedRef;
+        DNSServiceErrorType dnsErr = DNSServiceResolve(&svcEntry->resolveRef, kDNSServiceFlagsShareConnection , svcEntry->ifIndex, svcEntry->instanceName, DZC_SERVICE_PRIMARY_TYPE, "local", OnServiceResolveCallback, svcEntry);
+        svcEntry->resolvedCnt ++;
+        if (dnsErr != kDNSServiceErr_NoError) {
+            svcEntry->resolveRef = NULL;
+            celix_logHelper_error(watcher->logHelper, "Watcher: Failed to resolve %s on %d, %d.", svcEntry->instanceName, svcEntry->ifIndex, dnsErr);
+            nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry resolve after 5 seconds
+            if (svcEntry->resolvedCnt < DZC_MAX_RESOLVED_CNT) {
+                svcEntry->resolveState = DZC_RESOLVE_STATE_QUEUED;
+                TAILQ_INSERT_TAIL(&failedResolves, svcEntry, resolveEntry);
+            }
+            continue;
+        }
+        svcEntry->resolveState = DZC_RESOLVE_STATE_IN_FLIGHT;
+        svcEntry->resolveStartTime = now;
+        TAILQ_INSERT_TAIL(&watcher->inFlightResolves, svcEntry, resolveEntry);
+        watcher->inFlightResolveCnt++;
+        nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_RESOLVE_TIMEOUT);
+    }
+    TAILQ_CONCAT(&watcher->queuedResolves, &failedResolves, resolveEntry);
+
     *pNextWorkIntervalTime = nextWorkIntervalTime;
     return;
 }
@@ -607,6 +832,13 @@ static void discoveryZeroconfWatcher_resolveServices(discovery_zeroconf_watcher_
 static void discoveryZeroconfWatcher_refreshWatchedServices(discovery_zeroconf_watcher_t *watcher, unsigned int *pNextWorkIntervalTime) {
     unsigned int nextWorkIntervalTime = *pNextWorkIntervalTime;
 
+    if (!watcher->servicesChanged) {
+        discoveryZeroconfWatcher_resolveServices(watcher, &nextWorkIntervalTime);
+        *pNextWorkIntervalTime = nextWorkIntervalTime;
+        return;
+    }
+    watcher->servicesChanged = false;
+
     //mark deleted status for all watched services
     CELIX_STRING_HASH_MAP_ITERATE(watcher->watchedServices, iter) {
         watched_service_entry_t *svcEntry = (watched_service_entry_t *)iter.value.ptrValue;
@@ -633,6 +865,7 @@ static void discoveryZeroconfWatcher_refreshWatchedServices(discovery_zeroconf_w
             svcEntry = (watched_service_entry_t *)calloc(1, sizeof(*svcEntry));
             if (svcEntry == NULL) {
                 celix_logHelper_error(watcher->logHelper, "Watcher: Failed to alloc service entry.");
+                watcher->servicesChanged = true;
                 nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry browse after 5 seconds
                 continue;
             }
@@ -641,9 +874,11 @@ static void discoveryZeroconfWatcher_refreshWatchedServices(discovery_zeroconf_w
             if (svcEntry->txtRecord == NULL) {
                 celix_logHelper_logTssErrors(watcher->logHelper, CELIX_LOG_LEVEL_ERROR);
                 celix_logHelper_error(watcher->logHelper, "Watcher: Failed to create txt record for service entry.");
+                watcher->servicesChanged = true;
                 nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry browse after 5 seconds
                 continue;
             }
+            svcEntry->properties = NULL;
             svcEntry->endpointId = NULL;
             svcEntry->resolved = false;
             strncpy(svcEntry->instanceName, key, instanceNameEnd-key);
@@ -651,18 +886,23 @@ static void discoveryZeroconfWatcher_refreshWatchedServices(discovery_zeroconf_w
             svcEntry->hostname = NULL;
             svcEntry->ifIndex = interfaceIndex;
             svcEntry->resolvedCnt = 0;
+            svcEntry->resolveState = DZC_RESOLVE_STATE_IDLE;
             svcEntry->reResolve = false;
+            svcEntry->updated = false;
+            svcEntry->createEndpointFailedCnt = 0;
             svcEntry->markDeleted = false;
             svcEntry->logHelper = watcher->logHelper;
+            svcEntry->watcher = watcher;
             int status = celix_stringHashMap_put(watcher->watchedServices, key, svcEntry);
             if (status != CELIX_SUCCESS) {
                 celix_properties_destroy(svcEntry->txtRecord);
                 celix_logHelper_logTssErrors(watcher->logHelper, CELIX_LOG_LEVEL_ERROR);
                 celix_logHelper_error(watcher->logHelper, "Watcher: Failed to put service entry, %d.", status);
+                watcher->servicesChanged = true;
                 nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry browse after 5 seconds
                 continue;
             }
-            celix_steal_ptr(svcEntry);
+            watchedServiceEntry_queueResolve(watcher, celix_steal_ptr(svcEntry));
         }
     }
     celixThreadMutex_unlock(&watcher->mutex);
@@ -674,12 +914,9 @@ static void discoveryZeroconfWatcher_refreshWatchedServices(discovery_zeroconf_w
         if (svcEntry->markDeleted) {
             celix_logHelper_trace(watcher->logHelper, "Watcher: Stop to resolve service %s on %d.", svcEntry->instanceName, svcEntry->ifIndex);
             celix_stringHashMapIterator_remove(&iter);
-            if (svcEntry->resolveRef) {
-                DNSServiceRefDeallocate(svcEntry->resolveRef);
-            }
-            celix_properties_destroy(svcEntry->txtRecord);
-            free(svcEntry->hostname);
-            free(svcEntry);
+            watcher->hostsChanged = watcher->hostsChanged || svcEntry->hostname != NULL;
+            watcher->endpointsChanged = true;
+            watchedServiceEntry_destroy(watcher, svcEntry);
         } else {
             celix_stringHashMapIterator_next(&iter);
         }
@@ -694,11 +931,11 @@ static void discoveryZeroconfWatcher_refreshWatchedServices(discovery_zeroconf_w
 static void onGetAddrInfoCb (DNSServiceRef sdRef, DNSServiceFlags flags, uint32_t ifIndex, DNSServiceErrorType errorCode,
                              const char *hostname, const struct sockaddr *address, uint32_t ttl, void *context) {
     (void)sdRef;//unused
-    (void)ttl;//unused
     (void)hostname;//unused
     int status = CELIX_SUCCESS;
     watched_host_entry_t *hostEntry = (watched_host_entry_t *)context;
     assert(hostEntry != NULL);
+    hostEntry->watcher->moreComing = (flags & kDNSServiceFlagsMoreComing);
     if (errorCode != kDNSServiceErr_NoError || address == NULL || (address->sa_family != AF_INET && address->sa_family != AF_INET6)) {
         celix_logHelper_error(hostEntry->logHelper, "Watcher: Failed to resolve host %s on %d, %d.", hostEntry->hostname, hostEntry->ifIndex, errorCode);
         return;
@@ -714,7 +951,14 @@ static void onGetAddrInfoCb (DNSServiceRef sdRef, DNSServiceFlags flags, uint32_
         inet_ntop(AF_INET6, &((struct sockaddr_in6 *)address)->sin6_addr, ip, sizeof(ip));
     }
 
+    if (hostEntry->staleAddresses) {//replace the ip addresses reused from cache by the result of the new query
+        hostEntry->staleAddresses = false;
+        celix_stringHashMap_clear(hostEntry->ipAddresses);
+    }
+    hostEntry->watcher->endpointsChanged = true;
+
     if (flags & kDNSServiceFlagsAdd) {
+        hostEntry->ttl = ttl;
         status = celix_stringHashMap_putBool(hostEntry->ipAddresses, ip, address->sa_family == AF_INET);
         if (status != CELIX_SUCCESS) {
             celix_logHelper_logTssErrors(hostEntry->logHelper, CELIX_LOG_LEVEL_ERROR);
@@ -737,6 +981,16 @@ static watched_host_entry_t *discoveryZeroconfWatcher_getHostEntry(discovery_zer
     return (watched_host_entry_t *)celix_stringHashMap_get(watcher->watchedHosts, key);
 }
 
+static void watchedHostEntry_destroy(watched_host_entry_t *hostEntry) {
+    if (hostEntry->sdRef) {
+        DNSServiceRefDeallocate(hostEntry->sdRef);
+    }
+    celix_stringHashMap_destroy(hostEntry->ipAddresses);
+    free(hostEntry->hostname);
+    free(hostEntry);
+    return;
+}
+
 static void discoveryZeroconfWatcher_updateWatchedHosts(discovery_zeroconf_watcher_t *watcher, unsigned int *pNextWorkIntervalTime) {
     unsigned int nextWorkIntervalTime = *pNextWorkIntervalTime;
     //mark deleted hosts
@@ -752,35 +1006,50 @@ static void discoveryZeroconfWatcher_updateWatchedHosts(discovery_zeroconf_watch
             celix_autofree watched_host_entry_t *hostEntry = discoveryZeroconfWatcher_getHostEntry(watcher, svcEntry->hostname, svcEntry->ifIndex);
             if (hostEntry != NULL) {
                 hostEntry->markDeleted = false;
+                if (hostEntry->cached) {
+                    celix_logHelper_trace(watcher->logHelper, "Watcher: Reuse cached ip addresses of host %s on %d.", hostEntry->hostname, hostEntry->ifIndex);
+                    hostEntry->cached = false;
+                    hostEntry->staleAddresses = true;
+                    hostEntry->resolvedCnt = 0;
+                    watcher->cachedHostCnt--;
+                }
                 celix_steal_ptr(hostEntry);
             } else {
                 hostEntry = (watched_host_entry_t *)calloc(1, sizeof(*hostEntry));
                 if (hostEntry == NULL) {
+                    watcher->hostsChanged = true;
                     nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry after 5 seconds
                     celix_logHelper_error(watcher->logHelper, "Watcher: Failed to alloc host entry for %s.", svcEntry->instanceName);
                     continue;
                 }
                 celix_autoptr(celix_string_hash_map_t) ipAddresses = hostEntry->ipAddresses = celix_stringHashMap_create();
                 if (ipAddresses == NULL) {
+                    watcher->hostsChanged = true;
                     nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry after 5 seconds
                     celix_logHelper_error(watcher->logHelper, "Watcher: Failed to alloc ip address list for %s.", svcEntry->instanceName);
                     continue;
                 }
                 celix_autofree char *hostname = hostEntry->hostname = celix_utils_strdup(svcEntry->hostname);
                 if (hostname == NULL) {
+                    watcher->hostsChanged = true;
                     nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry after 5 seconds
                     celix_logHelper_error(watcher->logHelper, "Watcher: Failed to dup hostname for %s.", svcEntry->instanceName);
                     continue;
                 }
                 hostEntry->sdRef = NULL;
+                hostEntry->watcher = watcher;
                 hostEntry->logHelper = watcher->logHelper;
                 hostEntry->resolved = false;
                 hostEntry->ifIndex = svcEntry->ifIndex;
+                hostEntry->ttl = 0;
                 hostEntry->resolvedCnt = 0;
                 hostEntry->markDeleted = false;
+                hostEntry->cached = false;
+                hostEntry->staleAddresses = false;
                 char key[256 + 10] = {0};//max hostname length is 255, ifIndex is int
                 (void)snprintf(key, sizeof(key), "%s%d", svcEntry->hostname, svcEntry->ifIndex);
                 if (celix_stringHashMap_put(watcher->watchedHosts, key, hostEntry) != CELIX_SUCCESS) {
+                    watcher->hostsChanged = true;
                     nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry after 5 seconds
                     celix_logHelper_logTssErrors(watcher->logHelper, CELIX_LOG_LEVEL_ERROR);
                     celix_logHelper_error(watcher->logHelper, "Watcher: Failed to add host entry for %s.", svcEntry->instanceName);
@@ -793,42 +1062,84 @@ static void discoveryZeroconfWatcher_updateWatchedHosts(discovery_zeroconf_watch
         }
     }
 
-    //delete hosts
+    //stop to resolve unused hosts, and cache their ip addresses until the ttl expires
+    struct timespec now = celix_gettime(CLOCK_MONOTONIC);
     celix_string_hash_map_iterator_t iter = celix_stringHashMap_begin(watcher->watchedHosts);
     while (!celix_stringHashMapIterator_isEnd(&iter)) {
         watched_host_entry_t *hostEntry = (watched_host_entry_t *)iter.value.ptrValue;
-        if (hostEntry->markDeleted) {
+        if (hostEntry->markDeleted && !hostEntry->cached) {
             celix_logHelper_trace(watcher->logHelper, "Watcher: Stop to resolve host %s on %d.", hostEntry->hostname, hostEntry->ifIndex);
-            celix_stringHashMapIterator_remove(&iter);
-            if (hostEntry->sdRef) {
-                DNSServiceRefDeallocate(hostEntry->sdRef);
+            if (hostEntry->resolved && celix_stringHashMap_size(hostEntry->ipAddresses) > 0 && hostEntry->ttl > 0) {
+                if (hostEntry->sdRef) {
+                    DNSServiceRefDeallocate(hostEntry->sdRef);
+                    hostEntry->sdRef = NULL;
+                }
+                hostEntry->cached = true;
+                hostEntry->staleAddresses = false;
+                hostEntry->expiredTime = now;
+                hostEntry->expiredTime.tv_sec += MIN(hostEntry->ttl, DZC_MAX_HOST_CACHE_TTL);
+                watcher->cachedHostCnt++;
+            } else {
+                celix_stringHashMapIterator_remove(&iter);
+                watchedHostEntry_destroy(hostEntry);
+                continue;
             }
-            celix_stringHashMap_destroy(hostEntry->ipAddresses);
-            free(hostEntry->hostname);
-            free(hostEntry);
-        } else {
-            celix_stringHashMapIterator_next(&iter);
         }
+        celix_stringHashMapIterator_next(&iter);
     }
 
     *pNextWorkIntervalTime = nextWorkIntervalTime;
     return;
 }
 
+static void discoveryZeroconfWatcher_removeExpiredHosts(discovery_zeroconf_watcher_t *watcher, unsigned int *pNextWorkIntervalTime) {
+    unsigned int nextWorkIntervalTime = *pNextWorkIntervalTime;
+    struct timespec now = celix_gettime(CLOCK_MONOTONIC);
+    celix_string_hash_map_iterator_t iter = celix_stringHashMap_begin(watcher->watchedHosts);
+    while (watcher->cachedHostCnt > 0 && !celix_stringHashMapIterator_isEnd(&iter)) {
+        watched_host_entry_t *hostEntry = (watched_host_entry_t *)iter.value.ptrValue;
+        if (hostEntry->cached) {
+            if (celix_compareTime(&now, &hostEntry->expiredTime) >= 0) {
+                celix_logHelper_trace(watcher->logHelper, "Watcher: Remove cached host %s on %d.", hostEntry->hostname, hostEntry->ifIndex);
+                celix_stringHashMapIterator_remove(&iter);
+                watcher->cachedHostCnt--;
+                watchedHostEntry_destroy(hostEntry);
+                continue;
+            }
+            int timeOut = celix_difftime(&now, &hostEntry->expiredTime) + 1;
+            nextWorkIntervalTime = MIN(nextWorkIntervalTime, timeOut);
+        }
+        celix_stringHashMapIterator_next(&iter);
+    }
+    *pNextWorkIntervalTime = nextWorkIntervalTime;
+    return;
+}
+
 static void discoveryZeroconfWatcher_refreshHostsInfo(discovery_zeroconf_watcher_t *watcher, unsigned int *pNextWorkIntervalTime) {
     unsigned int nextWorkIntervalTime = *pNextWorkIntervalTime;
 
+    if (watcher->cachedHostCnt > 0) {
+        discoveryZeroconfWatcher_removeExpiredHosts(watcher, &nextWorkIntervalTime);
+    }
+
+    if (!watcher->hostsChanged) {
+        *pNextWorkIntervalTime = nextWorkIntervalTime;
+        return;
+    }
+    watcher->hostsChanged = false;
+
     discoveryZeroconfWatcher_updateWatchedHosts(watcher, &nextWorkIntervalTime);
 
     //resolve hosts
     CELIX_STRING_HASH_MAP_ITERATE(watcher->watchedHosts, iter1) {
         watched_host_entry_t *hostEntry = (watched_host_entry_t *)iter1.value.ptrValue;
-        if (watcher->sharedRef && hostEntry->sdRef == NULL && hostEntry->resolvedCnt < DZC_MAX_RESOLVED_CNT) {
+        if (watcher->sharedRef && !hostEntry->cached && hostEntry->sdRef == NULL && hostEntry->resolvedCnt < DZC_MAX_RESOLVED_CNT) {
             celix_logHelper_trace(watcher->logHelper, "Watcher: Start to resolve host %s on %d.", hostEntry->hostname, hostEntry->ifIndex);
             hostEntry->sdRef = watcher->sharedRef;
             DNSServiceErrorType dnsErr = DNSServiceGetAddrInfo(&hostEntry->sdRef, kDNSServiceFlagsShareConnection, hostEntry->ifIndex, kDNSServiceProtocol_IPv4 | kDNSServiceProtocol_IPv6, hostEntry->hostname, onGetAddrInfoCb, hostEntry);
             if (dnsErr != kDNSServiceErr_NoError) {
                 hostEntry->sdRef = NULL;
+                watcher->hostsChanged = true;
                 celix_logHelper_error(watcher->logHelper, "Watcher: Failed to get address info for %s on %d, %d.", hostEntry->hostname, hostEntry->ifIndex, dnsErr);
                 nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry resolve after 5 seconds
             }
@@ -886,7 +1197,7 @@ static int discoveryZeroConfWatcher_getHostIpAddresses(discovery_zeroconf_watche
 }
 
 static int discoveryZeroConfWatcher_createEndpointEntryForService(discovery_zeroconf_watcher_t *watcher, watched_service_entry_t *svcEntry, watched_endpoint_entry_t **epOut) {
-    celix_autoptr(celix_properties_t) properties = celix_properties_copy(svcEntry->txtRecord);
+    celix_autoptr(celix_properties_t) properties = celix_properties_copy(svcEntry->properties);
     if (properties == NULL) {
         celix_logHelper_error(watcher->logHelper, "Watcher: Failed to copy endpoint properties.");
         return CELIX_ENOMEM;
@@ -971,41 +1282,6 @@ static void discoveryZeroConfWatcher_informEPLs(discovery_zeroconf_watcher_t *wa
     return;
 }
 
-static void discoveryZeroconfWatcher_filterSameFrameWorkServices(discovery_zeroconf_watcher_t *watcher) {
-    celix_string_hash_map_iterator_t iter = celix_stringHashMap_begin(watcher->watchedServices);
-    while (!celix_stringHashMapIterator_isEnd(&iter)) {
-        watched_service_entry_t *svcEntry = (watched_service_entry_t *)iter.value.ptrValue;
-        if (svcEntry->resolved) {
-            const char *epFwUuid = celix_properties_get(svcEntry->txtRecord, CELIX_RSA_ENDPOINT_FRAMEWORK_UUID, NULL);
-            if (epFwUuid != NULL && strcmp(epFwUuid, watcher->fwUuid) == 0) {
-                celix_logHelper_debug(watcher->logHelper, "Watcher: Ignore self endpoint for %s.", celix_properties_get(svcEntry->txtRecord, CELIX_FRAMEWORK_SERVICE_NAME, "unknown"));
-                celix_stringHashMapIterator_remove(&iter);
-
-                //remove service instance name from service browser
-                char instanceNameKey[128]={0};
-                (void)snprintf(instanceNameKey, sizeof(instanceNameKey), "%s/%d", svcEntry->instanceName, svcEntry->ifIndex);
-                celixThreadMutex_lock(&watcher->mutex);
-                CELIX_STRING_HASH_MAP_ITERATE(watcher->serviceBrowsers, iter2) {
-                    service_browser_entry_t *browserEntry = (service_browser_entry_t *)iter2.value.ptrValue;
-                    celix_stringHashMap_remove(browserEntry->watchedServices, instanceNameKey);
-                }
-                celixThreadMutex_unlock(&watcher->mutex);
-
-                //release service info
-                if (svcEntry->resolveRef) {
-                    DNSServiceRefDeallocate(svcEntry->resolveRef);
-                }
-                celix_properties_destroy(svcEntry->txtRecord);
-                free(svcEntry->hostname);
-                free(svcEntry);
-                continue;
-            }
-        }
-        celix_stringHashMapIterator_next(&iter);
-    }
-    return;
-}
-
 static bool discoveryZeroconfWatcher_checkEndpointIpAddressesChanged(discovery_zeroconf_watcher_t *watcher, watched_endpoint_entry_t *endpointEntry) {
     if (endpointEntry->hostname == NULL || endpointEntry->ifIndex == kDNSServiceInterfaceIndexLocalOnly) {
         return false;
@@ -1058,10 +1334,20 @@ static void discoveryZeroconfWatcher_refreshEndpoints(discovery_zeroconf_watcher
     watched_endpoint_entry_t *epEntry = NULL;
     watched_service_entry_t *svcEntry = NULL;
     unsigned int nextWorkIntervalTime = *pNextWorkIntervalTime;
+    struct timespec now = celix_gettime(CLOCK_MONOTONIC);
+
+    if (!watcher->endpointsChanged && celix_compareTime(&now, &watcher->endpointsExpiredTime) < 0) {
+        if (watcher->endpointsExpiredTime.tv_sec != INT_MAX) {
+            int timeOut = celix_difftime(&now, &watcher->endpointsExpiredTime) + 1;
+            nextWorkIntervalTime = MIN(nextWorkIntervalTime, timeOut);
+        }
+        *pNextWorkIntervalTime = nextWorkIntervalTime;
+        return;
+    }
+    watcher->endpointsChanged = false;
 
     celix_auto(celix_mutex_lock_guard_t) lockGuard = celixMutexLockGuard_init(&watcher->mutex);
 
-    struct timespec now = celix_gettime(CLOCK_MONOTONIC);
     //remove the endpoint which ip address list changed and expired endpoint, and mark expired time of the endpoint.
     celix_string_hash_map_iterator_t epIter = celix_stringHashMap_begin(watcher->watchedEndpoints);
     while (!celix_stringHashMapIterator_isEnd(&epIter)) {
@@ -1086,15 +1372,25 @@ static void discoveryZeroconfWatcher_refreshEndpoints(discovery_zeroconf_watcher
         svcEntry = (watched_service_entry_t *)iter.value.ptrValue;
         if (svcEntry->endpointId != NULL && svcEntry->resolved) {
             epEntry = (watched_endpoint_entry_t *)celix_stringHashMap_get(watcher->watchedEndpoints, svcEntry->endpointId);
+            if (epEntry != NULL && svcEntry->updated && epEntry->ifIndex == svcEntry->ifIndex) {
+                //The txt record, host or port of the service changed, replace the endpoint
+                celix_logHelper_debug(watcher->logHelper, "Watcher: Remove updated endpoint for %s on %d.", epEntry->endpoint->serviceName, epEntry->ifIndex);
+                celix_stringHashMap_remove(watcher->watchedEndpoints, svcEntry->endpointId);
+                discoveryZeroConfWatcher_informEPLs(watcher, epEntry->endpoint, false);
+                endpointEntry_destroy(epEntry);
+                epEntry = NULL;
+            }
+            svcEntry->updated = false;
             if (epEntry == NULL && discoveryZeroConfWatcher_isHostResolved(watcher, svcEntry->hostname, svcEntry->ifIndex)) {
                 celix_status_t status = discoveryZeroConfWatcher_createEndpointEntryForService(watcher, svcEntry, &epEntry);
                 if (status != CELIX_SUCCESS) {
                     // If properties invalid,endpointDescription_create will return error.
-                    // Avoid create endpointDescription again, set svcEntry->resolved false.
-                    if (status != CELIX_ENOMEM) {
-                        svcEntry->resolved = false;
-                    } else {
+                    // Retry a limited number of times, after that wait for a txt record update of the service.
+                    if (status == CELIX_ENOMEM || ++svcEntry->createEndpointFailedCnt < DZC_MAX_RESOLVED_CNT) {
+                        watcher->endpointsChanged = true;
                         nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry after 5 seconds
+                    } else {
+                        svcEntry->resolved = false;
                     }
                     celix_logHelper_error(watcher->logHelper, "Watcher: Failed to create endpoint for %s. %d.", svcEntry->instanceName, status);
                     continue;
@@ -1106,6 +1402,7 @@ static void discoveryZeroconfWatcher_refreshEndpoints(discovery_zeroconf_watcher
                     celix_logHelper_logTssErrors(watcher->logHelper, CELIX_LOG_LEVEL_ERROR);
                     celix_logHelper_error(watcher->logHelper, "Watcher: Failed to add endpoint for %s.", epEntry->endpoint->serviceName);
                     endpointEntry_destroy(epEntry);
+                    watcher->endpointsChanged = true;
                     nextWorkIntervalTime = MIN(nextWorkIntervalTime, DZC_MAX_RETRY_INTERVAL);//retry after 5 seconds
                 }
             } else if (epEntry != NULL && endpointEntry_matchServiceEntry(epEntry, svcEntry)) {
@@ -1116,12 +1413,17 @@ static void discoveryZeroconfWatcher_refreshEndpoints(discovery_zeroconf_watcher
     }
 
     //calculate next work time
+    watcher->endpointsExpiredTime.tv_sec = INT_MAX;
+    watcher->endpointsExpiredTime.tv_nsec = 0;
     CELIX_STRING_HASH_MAP_ITERATE(watcher->watchedEndpoints, iter) {
         epEntry = (watched_endpoint_entry_t *)iter.value.ptrValue;
         if (epEntry->expiredTime.tv_sec != INT_MAX) {
             int timeOut = celix_difftime(&now, &epEntry->expiredTime) + 1;
             assert(timeOut >= 0);//We have removed expired endpoint before.
             nextWorkIntervalTime = MIN(nextWorkIntervalTime, timeOut);
+            if (celix_compareTime(&epEntry->expiredTime, &watcher->endpointsExpiredTime) < 0) {
+                watcher->endpointsExpiredTime = epEntry->expiredTime;
+            }
         }
     }
 
@@ -1159,11 +1461,16 @@ static void discoveryZeroconfWatcher_closeMDNSConnection(discovery_zeroconf_watc
     CELIX_STRING_HASH_MAP_ITERATE(watcher->watchedServices, iter) {
         watched_service_entry_t *svcEntry = (watched_service_entry_t *) iter.value.ptrValue;
         //no need free svcEntry->resolveRef, 'DNSServiceRefDeallocate(watcher->sharedRef)' has done it.
+        celix_properties_destroy(svcEntry->properties);
         celix_properties_destroy(svcEntry->txtRecord);
         free(svcEntry->hostname);
         free(svcEntry);
     }
     celix_stringHashMap_clear(watcher->watchedServices);
+    TAILQ_INIT(&watcher->queuedResolves);
+    TAILQ_INIT(&watcher->inFlightResolves);
+    TAILQ_INIT(&watcher->resolvedServices);
+    watcher->inFlightResolveCnt = 0;
     CELIX_STRING_HASH_MAP_ITERATE(watcher->watchedHosts, iter) {
         watched_host_entry_t *hostEntry = (watched_host_entry_t *) iter.value.ptrValue;
         //no need free hostEntry->sdRef, 'DNSServiceRefDeallocate(watcher->sharedRef)' has done it.
@@ -1172,11 +1479,29 @@ static void discoveryZeroconfWatcher_closeMDNSConnection(discovery_zeroconf_watc
         free(hostEntry);
     }
     celix_stringHashMap_clear(watcher->watchedHosts);
+    watcher->cachedHostCnt = 0;
+    watcher->moreComing = false;
+    watcher->servicesChanged = false;
+    watcher->hostsChanged = false;
+    watcher->endpointsChanged = true;//the endpoints of the removed services will be expired
     return;
 }
 
+static bool discoveryZeroconfWatcher_hasMoreMDNSResult(discovery_zeroconf_watcher_t *watcher) {
+    if (!watcher->moreComing) {
+        return false;
+    }
+    struct pollfd pfd = {.fd = DNSServiceRefSockFD(watcher->sharedRef), .events = POLLIN, .revents = 0};
+    return poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN);
+}
+
 static void discoveryZeroconfWatcher_handleMDNSEvent(discovery_zeroconf_watcher_t *watcher) {
-    DNSServiceErrorType dnsErr = DNSServiceProcessResult(watcher->sharedRef);
+    DNSServiceErrorType dnsErr;
+    //Process a burst of results at once, so that the watched entries are refreshed once per burst rather than once per result
+    do {
+        watcher->moreComing = false;
+        dnsErr = DNSServiceProcessResult(watcher->sharedRef);
+    } while (dnsErr == kDNSServiceErr_NoError && discoveryZeroconfWatcher_hasMoreMDNSResult(watcher));
     if (dnsErr == kDNSServiceErr_ServiceNotRunning || dnsErr == kDNSServiceErr_DefunctConnection) {
         celix_logHelper_error(watcher->logHelper, "Watcher: mDNS connection may be broken, %d.", dnsErr);
         discoveryZeroconfWatcher_closeMDNSConnection(watcher);
@@ -1260,7 +1585,6 @@ static void *discoveryZeroconfWatcher_watchEPThread(void *data) {
             celix_stringHashMap_clear(updatedBrowsers);
         }
         discoveryZeroconfWatcher_refreshWatchedServices(watcher, &timeoutInS);
-        discoveryZeroconfWatcher_filterSameFrameWorkServices(watcher);
         discoveryZeroconfWatcher_refreshHostsInfo(watcher, &timeoutInS);
         discoveryZeroconfWatcher_refreshEndpoints(watcher, &timeoutInS);
 
@@ -41,7 +41,7 @@ struct export_registration {
     celix_bundle_context_t * context;
     struct export_reference exportReference;
     char *servId;
-    dyn_interface_type *intf; //owner
+    const dyn_interface_type *intf; //shared descriptor, released with dfi_releaseInterfaceDescriptor
     char filter[32];
 
 
@@ -60,7 +60,6 @@ struct export_registration {
     FILE *logFile;
 };
 
-static celix_status_t exportRegistration_findAndParseInterfaceDescriptor(celix_log_helper_t *helper, celix_bundle_context_t * const context, celix_bundle_t * const bundle, char const * const name, dyn_interface_type **out);
 static void exportRegistration_addServ(void *data, void *service);
 static void exportRegistration_removeServ(void *data, void *service);
 
@@ -106,7 +105,7 @@ celix_status_t exportRegistration_create(celix_log_helper_t *helper, service_ref
     CELIX_DO_IF(status, serviceReference_getBundle(reference, &bundle));
 
     if (status == CELIX_SUCCESS) {
-        status = exportRegistration_findAndParseInterfaceDescriptor(helper, context, bundle, exports, &reg->intf);
+        status = dfi_acquireInterfaceDescriptor(helper, context, bundle, exports, &reg->intf);
     }
 
     if (status == CELIX_SUCCESS) {
@@ -206,31 +205,12 @@ celix_status_t exportRegistration_call(export_registration_t *export, char *data
     return status;
 }
 
-static celix_status_t exportRegistration_findAndParseInterfaceDescriptor(celix_log_helper_t *helper, celix_bundle_context_t * const context, celix_bundle_t * const bundle, char const * const name, dyn_interface_type **out) {
-    FILE* descriptor = NULL;
-
-    celix_status_t status = dfi_findDescriptor(context, bundle, name, &descriptor);
-    if (status == CELIX_SUCCESS && descriptor != NULL) {
-        int rc = dynInterface_parse(descriptor, out);
-        fclose(descriptor);
-        if (rc != 0) {
-            celix_logHelper_logTssErrors(helper, CELIX_LOG_LEVEL_WARNING);
-            celix_logHelper_warning(helper, "RSA_DFI: Error parsing service descriptor for \"%s\", return code is %d.", name, rc);
-            status = CELIX_BUNDLE_EXCEPTION;
-        }
-        return status;
-    }
-
-    celix_logHelper_log(helper, CELIX_LOG_LEVEL_WARNING, "RSA: Error finding service descriptor for '%s'", name);
-    return CELIX_BUNDLE_EXCEPTION;
-}
-
 static void exportRegistration_destroyCallback(void* data) {
     export_registration_t* reg = data;
     if (reg->intf != NULL) {
-        dyn_interface_type *intf = reg->intf;
+        const dyn_interface_type *intf = reg->intf;
         reg->intf = NULL;
-        dynInterface_destroy(intf);
+        dfi_releaseInterfaceDescriptor(intf);
     }
 
     if (reg->exportReference.endpoint != NULL) {
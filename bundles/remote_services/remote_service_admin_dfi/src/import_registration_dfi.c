@@ -35,6 +35,7 @@
 
 struct import_registration {
     celix_bundle_context_t *context;
+    celix_log_helper_t *helper;
     endpoint_description_t * endpoint; //TODO owner? -> free when destroyed
     const char *classObject; //NOTE owned by endpoint
     celix_version_t* version;
@@ -54,13 +55,11 @@ struct import_registration {
 };
 
 struct service_proxy {
-    dyn_interface_type *intf;
+    const dyn_interface_type *intf; //shared descriptor, released with dfi_releaseInterfaceDescriptor
     void *service;
     size_t count;
 };
 
-static celix_status_t importRegistration_findAndParseInterfaceDescriptor(celix_bundle_context_t * const context, celix_bundle_t * const bundle, char const * const name, dyn_interface_type **out);
-
 static celix_status_t importRegistration_createProxy(import_registration_t *import, celix_bundle_t *bundle,
                                               struct service_proxy **proxy);
 static void importRegistration_proxyFunc(void *userData, void *args[], void *returnVal);
@@ -73,6 +72,7 @@ void importRegistration_ungetService(void *handle, const celix_bundle_t *request
 
 celix_status_t importRegistration_create(
         celix_bundle_context_t *context,
+        celix_log_helper_t *helper,
         endpoint_description_t *endpoint,
         const char *classObject,
         const char* serviceVersion,
@@ -83,6 +83,7 @@ celix_status_t importRegistration_create(
     celix_status_t status = CELIX_SUCCESS;
     import_registration_t *reg = calloc(1, sizeof(*reg));
     reg->context = context;
+    reg->helper = helper;
     reg->endpoint = endpoint;
     reg->classObject = classObject;
     reg->send = sendFn;
@@ -216,27 +217,9 @@ void importRegistration_ungetService(void *handle, const celix_bundle_t *request
     pthread_mutex_unlock(&import->proxiesMutex);
 }
 
-static celix_status_t importRegistration_findAndParseInterfaceDescriptor(celix_bundle_context_t * const context, celix_bundle_t * const bundle, char const * const name, dyn_interface_type **out) {
-    celix_status_t status = CELIX_SUCCESS;
-    FILE* descriptor = NULL;
-    status = dfi_findDescriptor(context, bundle, name, &descriptor);
-    if (status == CELIX_SUCCESS && descriptor != NULL) {
-        int rc = dynInterface_parse(descriptor, out);
-        fclose(descriptor);
-        if (rc != 0) {
-            fprintf(stderr, "RSA_DFI: Cannot parse dfi descriptor for '%s'", name);
-            status = CELIX_BUNDLE_EXCEPTION;
-        }
-        return status;
-    }
-
-    fprintf(stdout, "RSA: Cannot find/open any valid descriptor files for '%s'", name);
-    return CELIX_BUNDLE_EXCEPTION;
-}
-
 static celix_status_t importRegistration_createProxy(import_registration_t *import, celix_bundle_t *bundle, struct service_proxy **out) {
-    dyn_interface_type* intf = NULL;
-    celix_status_t  status = importRegistration_findAndParseInterfaceDescriptor(import->context, bundle, import->classObject, &intf);
+    const dyn_interface_type* intf = NULL;
+    celix_status_t  status = dfi_acquireInterfaceDescriptor(import->helper, import->context, bundle, import->classObject, &intf);
 
     if (status != CELIX_SUCCESS) {
         return status;
@@ -254,7 +237,7 @@ static celix_status_t importRegistration_createProxy(import_registration_t *impo
         pVerString = import->version != NULL ? celix_version_toString(import->version) : NULL;
         printf("Service version mismatch: consumer has %s, provider has %s. NOT creating proxy.\n",
                cVerString,pVerString != NULL ? pVerString : "NA");
-        dynInterface_destroy(intf);
+        dfi_releaseInterfaceDescriptor(intf);
         status = CELIX_SERVICE_EXCEPTION;
     }
 
@@ -262,6 +245,7 @@ static celix_status_t importRegistration_createProxy(import_registration_t *impo
     if (status == CELIX_SUCCESS) {
         proxy = calloc(1, sizeof(*proxy));
         if (proxy == NULL) {
+            dfi_releaseInterfaceDescriptor(intf);
             status = CELIX_ENOMEM;
         }
     }
@@ -278,20 +262,10 @@ static celix_status_t importRegistration_createProxy(import_registration_t *impo
     if (status == CELIX_SUCCESS) {
         void **serv = proxy->service;
         serv[0] = import;
-
-        const struct methods_head* list = dynInterface_methods(proxy->intf);
-        struct method_entry *entry = NULL;
-        void (*fn)(void) = NULL;
-        int index = 0;
-        TAILQ_FOREACH(entry, list, entries) {
-            int rc = dynFunction_createClosure(entry->dynFunc, importRegistration_proxyFunc, entry, &fn);
-            serv[index + 1] = fn;
-            index += 1;
-
-            if (rc != 0) {
-                status = CELIX_BUNDLE_EXCEPTION;
-                break;
-            }
+        //closures are shared by all proxies of the same descriptor, the import is retrieved from the service handle
+        status = dfi_createInterfaceClosures(proxy->intf, importRegistration_proxyFunc, serv);
+        if (status != CELIX_SUCCESS) {
+            status = CELIX_BUNDLE_EXCEPTION;
         }
     }
 
@@ -299,7 +273,7 @@ static celix_status_t importRegistration_createProxy(import_registration_t *impo
         *out = proxy;
     } else if (proxy != NULL) {
         if (proxy->intf != NULL) {
-            dynInterface_destroy(proxy->intf);
+            dfi_releaseInterfaceDescriptor(proxy->intf);
             proxy->intf = NULL;
         }
         free(proxy->service);
@@ -384,7 +358,7 @@ static void importRegistration_proxyFunc(void *userData, void *args[], void *ret
 static void importRegistration_destroyProxy(struct service_proxy *proxy) {
     if (proxy != NULL) {
         if (proxy->intf != NULL) {
-            dynInterface_destroy(proxy->intf);
+            dfi_releaseInterfaceDescriptor(proxy->intf);
         }
         if (proxy->service != NULL) {
             free(proxy->service);
@@ -30,6 +30,7 @@ typedef celix_status_t (*send_func_type)(void *handle, endpoint_description_t *e
 
 celix_status_t importRegistration_create(
         celix_bundle_context_t *context,
+        celix_log_helper_t *helper,
         endpoint_description_t *description,
         const char *classObject,
         const char* serviceVersion,
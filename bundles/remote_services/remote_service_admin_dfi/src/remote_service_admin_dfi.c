@@ -911,7 +911,7 @@ celix_status_t remoteServiceAdmin_importService(remote_service_admin_t *admin, e
                       objectClass);
 
         if (objectClass != NULL) {
-            status = importRegistration_create(admin->context, endpointDescription, objectClass, serviceVersion,
+            status = importRegistration_create(admin->context, admin->loghelper, endpointDescription, objectClass, serviceVersion,
                                                (send_func_type )remoteServiceAdmin_send, admin,
                                                admin->logFile,
                                                &import);
@@ -42,6 +42,7 @@ public:
         celix_ei_expect_celix_logHelper_create(nullptr, 0, nullptr);
         celix_ei_expect_calloc(nullptr, 0, nullptr);
         celix_ei_expect_celix_bundleContext_registerServiceAsync(nullptr, 0, 0);
+        celix_ei_expect_celix_bundleContext_registerServiceWithOptionsAsync(nullptr, 0, 0);
         celix_ei_expect_celix_properties_create(nullptr, 0, nullptr);
         celix_ei_expect_celix_properties_set(nullptr, 0, 0);
     }
@@ -128,3 +129,15 @@ TEST_F(RsaShmActivatorUnitTestSuite, RsaShmActivatorStartWithRegisteringRsaServi
     status = celix_bundleActivator_destroy(userData, ctx.get());
     EXPECT_EQ(status, CELIX_SUCCESS);
 }
+
+TEST_F(RsaShmActivatorUnitTestSuite, RsaShmActivatorStartWithRegisteringMetricsProviderError) {
+    void *userData = nullptr;
+    auto status = celix_bundleActivator_create(ctx.get(), &userData);
+    EXPECT_EQ(status, CELIX_SUCCESS);
+    celix_ei_expect_celix_bundleContext_registerServiceWithOptionsAsync((void*)&celix_bundleActivator_start, 1, -1);
+    status = celix_bundleActivator_start(userData, ctx.get());
+    EXPECT_EQ(status, CELIX_BUNDLE_EXCEPTION);
+
+    status = celix_bundleActivator_destroy(userData, ctx.get());
+    EXPECT_EQ(status, CELIX_SUCCESS);
+}
@@ -23,6 +23,7 @@
 #include "remote_constants.h"
 #include "remote_service_admin.h"
 #include "celix_log_helper.h"
+#include "celix_metrics_provider.h"
 #include "celix_api.h"
 #include <assert.h>
 
@@ -30,6 +31,8 @@ typedef struct rsa_shm_activator {
     rsa_shm_t *admin;
     remote_service_admin_service_t adminService;
     long adminSvcId;
+    celix_metrics_provider_t metricsProvider;
+    long metricsSvcId;
     celix_log_helper_t *logHelper;
 }rsa_shm_activator_t;
 
@@ -84,6 +87,24 @@ celix_status_t rsaShmActivator_start(rsa_shm_activator_t *activator, celix_bundl
     if (activator->adminSvcId < 0) {
         return CELIX_BUNDLE_EXCEPTION;
     }
+
+    activator->metricsProvider.handle = admin;
+    activator->metricsProvider.collectMetrics = rsaShm_collectMetrics;
+    celix_service_registration_options_t opts = CELIX_EMPTY_SERVICE_REGISTRATION_OPTIONS;
+    opts.svc = &activator->metricsProvider;
+    opts.serviceName = CELIX_METRICS_PROVIDER_SERVICE_NAME;
+    opts.serviceVersion = CELIX_METRICS_PROVIDER_SERVICE_VERSION;
+    opts.properties = celix_properties_create();
+    if (opts.properties == NULL || celix_properties_set(opts.properties, CELIX_METRICS_PROVIDER_NAME, "rsa_shm") != CELIX_SUCCESS) {
+        celix_properties_destroy(opts.properties);
+        celix_bundleContext_unregisterService(context, activator->adminSvcId);
+        return CELIX_ENOMEM;
+    }
+    activator->metricsSvcId = celix_bundleContext_registerServiceWithOptionsAsync(context, &opts);
+    if (activator->metricsSvcId < 0) {
+        celix_bundleContext_unregisterService(context, activator->adminSvcId);
+        return CELIX_BUNDLE_EXCEPTION;
+    }
     activator->logHelper = celix_steal_ptr(logger);
     activator->admin = celix_steal_ptr(admin);
     return CELIX_SUCCESS;
@@ -93,6 +114,7 @@ celix_status_t rsaShmActivator_stop(rsa_shm_activator_t *activator, celix_bundle
     assert(activator != NULL);
     assert(context != NULL);
 
+    celix_bundleContext_unregisterServiceAsync(context, activator->metricsSvcId, NULL, NULL);
     celix_bundleContext_unregisterServiceAsync(context, activator->adminSvcId, NULL, NULL);
     celix_bundleContext_waitForEvents(context);//Ensure that no events use admin
     rsaShm_destroy(activator->admin);
@@ -21,6 +21,7 @@
 #include "rsa_shm_msg.h"
 #include "rsa_shm_constants.h"
 #include "celix_log_helper.h"
+#include "celix_metrics.h"
 #include "shm_pool.h"
 #include "celix_long_hash_map.h"
 #include "celix_stdlib_cleanup.h"
@@ -37,6 +38,8 @@
 #include <assert.h>
 #include <stdbool.h>
 #include <errno.h>
+#include <string.h>
+#include <time.h>
 
 
 struct rsa_shm_client_manager {
@@ -52,6 +55,9 @@ struct rsa_shm_client_manager {
     celix_array_list_t *exceptionMsgList;
     celix_thread_t msgExceptionHandlerThread;
     bool threadActive;
+    unsigned long sentRequests;//atomic, number of requests sent to a remote service
+    unsigned long failedRequests;//atomic, number of sent requests without a valid response
+    celix_metrics_histogram_t requestLatency;//lock-free, time between sending a request and receiving its response
 };
 
 struct service_diagnostic_info {
@@ -123,6 +129,9 @@ celix_status_t rsaShmClientManager_create(celix_bundle_context_t *ctx,
 
     clientManager->ctx = ctx;
     clientManager->logHelper = loghelper;
+    clientManager->sentRequests = 0;
+    clientManager->failedRequests = 0;
+    memset(&clientManager->requestLatency, 0, sizeof(clientManager->requestLatency));
     clientManager->maxConcurrentNum = celix_bundleContext_getPropertyAsLong(ctx,
             RSA_SHM_MAX_CONCURRENT_INVOCATIONS_KEY, RSA_SHM_MAX_CONCURRENT_INVOCATIONS_DEFAULT);
     clientManager->msgTimeOutInSec = celix_bundleContext_getPropertyAsLong(ctx,
@@ -260,6 +269,8 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
     size_t metadataStringSize = 0;
     FILE *fp = NULL;
     rsa_shm_msg_control_t *msgCtrl = NULL;
+    struct timespec startTime;
+    (void)clock_gettime(CLOCK_MONOTONIC, &startTime);
 
     celix_autoptr(rsa_shm_client_t) client = rsaShmClientManager_getClient(clientManager, peerServerName);
     if (client == NULL) {
@@ -340,12 +351,17 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
         }
     };
 
+    __atomic_add_fetch(&clientManager->sentRequests, 1, __ATOMIC_RELAXED);
+
     bool replied = false;
     status = rsaShmClientManager_receiveResponse(clientManager, msgCtrl, msgBody,
             msgBodySize, response, &replied);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error receiving response. %d.", status);
         rsaShmClientManager_markSvcCallFailed(clientManager, peerServerName, serviceId);
+        __atomic_add_fetch(&clientManager->failedRequests, 1, __ATOMIC_RELAXED);
+    } else {
+        celix_metricsHistogram_recordSince(&clientManager->requestLatency, &startTime);
     }
 
     if (replied) {
@@ -366,6 +382,53 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
     return status;
 }
 
+void rsaShmClientManager_collectMetrics(rsa_shm_client_manager_t *clientManager, void *callbackHandle,
+        celix_metrics_callback_fp callback) {
+    shm_pool_statistics_t poolStats;
+    memset(&poolStats, 0, sizeof(poolStats));
+    shmPool_getStatistics(clientManager->shmPool, &poolStats);
+
+    celix_metric_t metric = {0};
+    metric.name = "celix_rsa_shm_sent_requests_total";
+    metric.help = "Total number of requests sent to remote services.";
+    metric.type = CELIX_METRIC_TYPE_COUNTER;
+    metric.value = (double)__atomic_load_n(&clientManager->sentRequests, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+    metric.name = "celix_rsa_shm_failed_requests_total";
+    metric.help = "Total number of sent requests without a valid response, e.g. because of a timeout.";
+    metric.value = (double)__atomic_load_n(&clientManager->failedRequests, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+    metric.name = "celix_rsa_shm_pool_failed_allocations_total";
+    metric.help = "Total number of failed shared memory pool allocations.";
+    metric.value = (double)poolStats.failedAllocations;
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_rsa_shm_request_latency_seconds";
+    metric.help = "Time between sending a request and receiving its response.";
+    metric.type = CELIX_METRIC_TYPE_HISTOGRAM;
+    metric.histogram = &clientManager->requestLatency;
+    callback(callbackHandle, &metric);
+    metric.histogram = NULL;
+
+    metric.type = CELIX_METRIC_TYPE_GAUGE;
+    metric.name = "celix_rsa_shm_pool_size_bytes";
+    metric.help = "Size of the shared memory pool.";
+    metric.value = (double)poolStats.size;
+    callback(callbackHandle, &metric);
+    metric.name = "celix_rsa_shm_pool_used_bytes";
+    metric.help = "Number of allocated bytes in the shared memory pool.";
+    metric.value = (double)poolStats.usedSize;
+    callback(callbackHandle, &metric);
+    metric.name = "celix_rsa_shm_pool_max_used_bytes";
+    metric.help = "High-water mark of the number of allocated bytes in the shared memory pool.";
+    metric.value = (double)poolStats.maxUsedSize;
+    callback(callbackHandle, &metric);
+    metric.name = "celix_rsa_shm_pool_allocations";
+    metric.help = "Number of current shared memory pool allocations.";
+    metric.value = (double)poolStats.allocations;
+    callback(callbackHandle, &metric);
+}
+
 static celix_status_t rsaShmClientManager_createClient(rsa_shm_client_manager_t *clientManager,
         const char *peerServerName, rsa_shm_client_t **clientOut) {
     celix_status_t status = CELIX_SUCCESS;
@@ -28,6 +28,7 @@ extern "C" {
 #include "celix_types.h"
 #include "celix_properties.h"
 #include "celix_errno.h"
+#include "celix_metrics_provider.h"
 #include <sys/uio.h>
 
 
@@ -51,6 +52,12 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
         const char *peerServerName, long serviceId, celix_properties_t *metadata,
         const struct iovec *request, struct iovec *response);
 
+/**
+ * @brief Collect the request counters, the request latency histogram and the shared memory pool usage.
+ */
+void rsaShmClientManager_collectMetrics(rsa_shm_client_manager_t *clientManager, void *callbackHandle,
+        celix_metrics_callback_fp callback);
+
 #ifdef __cplusplus
 }
 #endif
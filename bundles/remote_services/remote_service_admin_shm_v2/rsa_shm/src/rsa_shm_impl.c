@@ -51,6 +51,8 @@ struct rsa_shm {
     char *shmServerName;
     rsa_request_sender_service_t reqSenderService;
     long reqSenderSvcId;
+    unsigned long receivedRequests;//atomic, number of requests received for exported services
+    unsigned long failedReceivedRequests;//atomic, number of received requests which could not be handled
 };
 
 
@@ -187,22 +189,26 @@ static celix_status_t rsaShm_receiveMsgCB(void *handle, rsa_shm_server_t *shmSer
         return CELIX_ILLEGAL_ARGUMENT;
     }
     rsa_shm_t *admin = handle;
+    __atomic_add_fetch(&admin->receivedRequests, 1, __ATOMIC_RELAXED);
 
     long serviceId = celix_properties_getAsLong(metadata, CELIX_RSA_ENDPOINT_SERVICE_ID, -1);
     if (serviceId < 0) {
         celix_logHelper_error(admin->logHelper, "Service id is invalid.");
-        return CELIX_ILLEGAL_ARGUMENT;
-    }
-
-    celix_autoptr(export_registration_t) export = rsaShm_getExportService(admin, serviceId);
-    if (export == NULL) {
-        celix_logHelper_error(admin->logHelper, "No export registration found for service id %ld", serviceId);
-        return CELIX_ILLEGAL_STATE;
+        status = CELIX_ILLEGAL_ARGUMENT;
+    } else {
+        celix_autoptr(export_registration_t) export = rsaShm_getExportService(admin, serviceId);
+        if (export == NULL) {
+            celix_logHelper_error(admin->logHelper, "No export registration found for service id %ld", serviceId);
+            status = CELIX_ILLEGAL_STATE;
+        } else {
+            status = exportRegistration_call(export, metadata, request, response);
+            if (status != CELIX_SUCCESS) {
+                celix_logHelper_error(admin->logHelper,"Export registration call service failed, error code is %d", status);
+            }
+        }
     }
-
-    status = exportRegistration_call(export, metadata, request, response);
     if (status != CELIX_SUCCESS) {
-        celix_logHelper_error(admin->logHelper,"Export registration call service failed, error code is %d", status);
+        __atomic_add_fetch(&admin->failedReceivedRequests, 1, __ATOMIC_RELAXED);
     }
     return status;
 }
@@ -606,3 +612,43 @@ celix_status_t rsaShm_removeImportedService(rsa_shm_t *admin, import_registratio
 
     return CELIX_SUCCESS;
 }
+
+celix_status_t rsaShm_collectMetrics(void *handle, void *callbackHandle, celix_metrics_callback_fp callback) {
+    rsa_shm_t *admin = handle;
+    size_t nrOfExports = 0;
+    size_t nrOfImports = 0;
+    {
+        celix_auto(celix_mutex_lock_guard_t) lock = celixMutexLockGuard_init(&admin->exportedServicesLock);
+        CELIX_LONG_HASH_MAP_ITERATE(admin->exportedServices, iter) {
+            nrOfExports += celix_arrayList_size(iter.value.ptrValue);
+        }
+    }
+    {
+        celix_auto(celix_mutex_lock_guard_t) lock = celixMutexLockGuard_init(&admin->importedServicesLock);
+        nrOfImports = celix_arrayList_size(admin->importedServices);
+    }
+
+    celix_metric_t metric = {0};
+    metric.name = "celix_rsa_shm_exported_services";
+    metric.help = "Number of export registrations.";
+    metric.type = CELIX_METRIC_TYPE_GAUGE;
+    metric.value = (double)nrOfExports;
+    callback(callbackHandle, &metric);
+    metric.name = "celix_rsa_shm_imported_services";
+    metric.help = "Number of import registrations.";
+    metric.value = (double)nrOfImports;
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_rsa_shm_received_requests_total";
+    metric.help = "Total number of requests received for exported services.";
+    metric.type = CELIX_METRIC_TYPE_COUNTER;
+    metric.value = (double)__atomic_load_n(&admin->receivedRequests, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+    metric.name = "celix_rsa_shm_failed_received_requests_total";
+    metric.help = "Total number of received requests which could not be handled.";
+    metric.value = (double)__atomic_load_n(&admin->failedReceivedRequests, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+
+    rsaShmClientManager_collectMetrics(admin->shmClientManager, callbackHandle, callback);
+    return CELIX_SUCCESS;
+}
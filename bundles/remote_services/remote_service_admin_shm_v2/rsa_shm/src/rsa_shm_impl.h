@@ -31,6 +31,7 @@ extern "C" {
 #include "celix_types.h"
 #include "celix_properties.h"
 #include "celix_errno.h"
+#include "celix_metrics_provider.h"
 
 
 typedef struct rsa_shm rsa_shm_t;
@@ -59,6 +60,12 @@ celix_status_t rsaShm_importService(rsa_shm_t *admin, endpoint_description_t *en
 
 celix_status_t rsaShm_removeImportedService(rsa_shm_t *admin, import_registration_t *registration);
 
+/**
+ * @brief Metrics provider collecting the number of exported and imported services, the received request counters
+ * and the metrics of the shm client (sent requests, request latency and shared memory pool usage).
+ */
+celix_status_t rsaShm_collectMetrics(void *handle, void *callbackHandle, celix_metrics_callback_fp callback);
+
 #ifdef __cplusplus
 }
 #endif
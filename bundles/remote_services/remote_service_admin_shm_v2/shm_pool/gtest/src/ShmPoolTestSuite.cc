@@ -133,6 +133,37 @@ TEST_F(ShmPoolTestSuite, MallocMemoryFailedDueToRequestingSizeTooLarge) {
     shmPool_destroy(shmPool);
 }
 
+TEST_F(ShmPoolTestSuite, GetStatistics) {
+    shm_pool_t *shmPool = nullptr;
+    celix_status_t status = shmPool_create(8192, &shmPool);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    shm_pool_statistics_t stats{};
+    shmPool_getStatistics(shmPool, &stats);
+    EXPECT_EQ(8192, stats.size);
+    EXPECT_EQ(0, stats.usedSize);
+    EXPECT_EQ(0, stats.allocations);
+
+    void *addr1 = shmPool_malloc(shmPool, 128);
+    void *addr2 = shmPool_malloc(shmPool, 256);
+    EXPECT_TRUE(shmPool_malloc(shmPool, 10240) == NULL);
+    shmPool_getStatistics(shmPool, &stats);
+    EXPECT_LE(128 + 256, stats.usedSize);
+    EXPECT_EQ(stats.usedSize, stats.maxUsedSize);
+    EXPECT_EQ(2, stats.allocations);
+    EXPECT_EQ(1, stats.failedAllocations);
+
+    size_t maxUsedSize = stats.maxUsedSize;
+    shmPool_free(shmPool, addr1);
+    shmPool_free(shmPool, addr2);
+    shmPool_getStatistics(shmPool, &stats);
+    EXPECT_EQ(0, stats.usedSize);
+    EXPECT_EQ(maxUsedSize, stats.maxUsedSize);
+    EXPECT_EQ(0, stats.allocations);
+
+    shmPool_getStatistics(nullptr, &stats);//no-op
+    shmPool_destroy(shmPool);
+}
+
 TEST_F(ShmPoolTestSuite, MallocMemoryForNullPool) {
     void *addr = shmPool_malloc(nullptr, 128);
     EXPECT_TRUE(addr == NULL);
@@ -76,6 +76,25 @@ void *shmPool_malloc(shm_pool_t *pool, size_t size);
  */
 void shmPool_free(shm_pool_t *pool, void *ptr);
 
+/**
+ * @brief Shared memory pool usage statistics.
+ */
+typedef struct shm_pool_statistics {
+    size_t size;//The size of the shared memory pool in bytes
+    size_t usedSize;//The number of bytes currently allocated
+    size_t maxUsedSize;//High-water mark of the number of allocated bytes
+    size_t allocations;//The number of current allocations
+    size_t failedAllocations;//The total number of failed allocations
+} shm_pool_statistics_t;
+
+/**
+ * @brief Get the usage statistics of the shared memory pool
+ *
+ * @param[in] pool The shared memory pool instance
+ * @param[out] stats The usage statistics
+ */
+void shmPool_getStatistics(shm_pool_t *pool, shm_pool_statistics_t *stats);
+
 /**
  * @brief Get the memory offset in shared memory
  *
@@ -24,6 +24,8 @@
 #include <tlsf.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <sys/param.h>
 #include <sys/ipc.h>
 #include <sys/shm.h>
 #include <errno.h>
@@ -39,6 +41,7 @@ struct shm_pool{
     bool heartbeatThreadActive;
     celix_thread_cond_t heartbeatThreadStoped;
     tlsf_t allocator;
+    shm_pool_statistics_t stats;
 };
 
 static void *shmPool_heartbeatThread(void *data);
@@ -80,6 +83,9 @@ celix_status_t shmPool_create(size_t size, shm_pool_t **pool) {
         goto err_attaching_shm;
     }
 
+    memset(&shmPool->stats, 0, sizeof(shmPool->stats));
+    shmPool->stats.size = size;
+
     shmPool->sharedInfo = (struct shm_pool_shared_info *)shmPool->shmStartAddr;
     shmPool->sharedInfo->heartbeatCnt = 1;
     shmPool->sharedInfo->size = sizeof(struct shm_pool_shared_info);
@@ -155,6 +161,13 @@ void *shmPool_malloc(shm_pool_t *pool, size_t size) {
         void *addr = NULL;
         celixThreadMutex_lock(&pool->mutex);
         addr = tlsf_malloc(pool->allocator, size);
+        if (addr != NULL) {
+            pool->stats.usedSize += tlsf_block_size(addr);
+            pool->stats.allocations++;
+            pool->stats.maxUsedSize = MAX(pool->stats.maxUsedSize, pool->stats.usedSize);
+        } else {
+            pool->stats.failedAllocations++;
+        }
         celixThreadMutex_unlock(&pool->mutex);
         return addr;
     }
@@ -164,12 +177,23 @@ void *shmPool_malloc(shm_pool_t *pool, size_t size) {
 void shmPool_free(shm_pool_t *pool, void *ptr) {
     if (pool != NULL && ptr != NULL) {
         celixThreadMutex_lock(&pool->mutex);
+        pool->stats.usedSize -= tlsf_block_size(ptr);
+        pool->stats.allocations--;
         tlsf_free(pool->allocator, ptr);
         celixThreadMutex_unlock(&pool->mutex);
     }
     return ;
 }
 
+void shmPool_getStatistics(shm_pool_t *pool, shm_pool_statistics_t *stats) {
+    if (pool != NULL && stats != NULL) {
+        celixThreadMutex_lock(&pool->mutex);
+        *stats = pool->stats;
+        celixThreadMutex_unlock(&pool->mutex);
+    }
+    return ;
+}
+
 ssize_t shmPool_getMemoryOffset(shm_pool_t *pool, void *ptr) {
     if (pool != NULL && ptr != NULL) {
         return ptr - pool->shmStartAddr;
@@ -83,4 +83,67 @@ TEST_F(DfiUtilsTestSuite, DescriptorFileNoExist) {
     curTestDescFile = "nonexistent-file";
     bool found = celix_bundleContext_useBundle(ctx.get(), descBundleId, this, useBundleCallbackForPasreNonexistentFile);
     EXPECT_TRUE(found);
-}
\ No newline at end of file
+}
+static void useBundleCallbackForSharedDescriptor(void *handle, const celix_bundle_t *bundle) {
+    DfiUtilsTestSuite *testSuite = static_cast<DfiUtilsTestSuite *>(handle);
+    const dyn_interface_type *intf1{nullptr};
+    const dyn_interface_type *intf2{nullptr};
+    auto status = dfi_acquireInterfaceDescriptor(testSuite->logHelper.get(), testSuite->ctx.get(), bundle, testSuite->curTestDescFile.c_str(), &intf1);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_TRUE(intf1 != nullptr);
+    status = dfi_acquireInterfaceDescriptor(testSuite->logHelper.get(), testSuite->ctx.get(), bundle, testSuite->curTestDescFile.c_str(), &intf2);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    //same descriptor content, so the parsed descriptor is shared
+    EXPECT_EQ(intf1, intf2);
+    dfi_releaseInterfaceDescriptor(intf2);
+    dfi_releaseInterfaceDescriptor(intf1);
+
+    //after the last release, a new acquire parses the descriptor again
+    const dyn_interface_type *intf3{nullptr};
+    status = dfi_acquireInterfaceDescriptor(testSuite->logHelper.get(), testSuite->ctx.get(), bundle, testSuite->curTestDescFile.c_str(), &intf3);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_TRUE(intf3 != nullptr);
+    dfi_releaseInterfaceDescriptor(intf3);
+}
+
+TEST_F(DfiUtilsTestSuite, SharedDescriptor) {
+    curTestDescFile = "rsa_dfi_utils_test";
+    bool found = celix_bundleContext_useBundle(ctx.get(), descBundleId, this, useBundleCallbackForSharedDescriptor);
+    EXPECT_TRUE(found);
+}
+
+TEST_F(DfiUtilsTestSuite, SharedDescriptorIsSharedBetweenBundles) {
+    curTestDescFile = "rsa_dfi_utils_test";
+    struct UseData {
+        DfiUtilsTestSuite* suite;
+        const dyn_interface_type* intf;
+    };
+    UseData fwData{this, nullptr};
+    UseData bndData{this, nullptr};
+    auto acquire = [](void *handle, const celix_bundle_t *bundle) {
+        auto* data = static_cast<UseData*>(handle);
+        auto status = dfi_acquireInterfaceDescriptor(data->suite->logHelper.get(), data->suite->ctx.get(), bundle,
+                                                     data->suite->curTestDescFile.c_str(), &data->intf);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+    };
+    EXPECT_TRUE(celix_bundleContext_useBundle(ctx.get(), 0, &fwData, acquire));
+    EXPECT_TRUE(celix_bundleContext_useBundle(ctx.get(), descBundleId, &bndData, acquire));
+    //the framework and the bundle descriptor files have the same content
+    EXPECT_EQ(fwData.intf, bndData.intf);
+    dfi_releaseInterfaceDescriptor(fwData.intf);
+    dfi_releaseInterfaceDescriptor(bndData.intf);
+}
+
+static void useBundleCallbackForAcquireNonexistentFile(void *handle, const celix_bundle_t *bundle) {
+    DfiUtilsTestSuite *testSuite = static_cast<DfiUtilsTestSuite *>(handle);
+    const dyn_interface_type *intf{nullptr};
+    auto status = dfi_acquireInterfaceDescriptor(testSuite->logHelper.get(), testSuite->ctx.get(), bundle, testSuite->curTestDescFile.c_str(), &intf);
+    EXPECT_EQ(CELIX_BUNDLE_EXCEPTION, status);
+    EXPECT_TRUE(intf == nullptr);
+}
+
+TEST_F(DfiUtilsTestSuite, AcquireDescriptorFileNoExist) {
+    curTestDescFile = "nonexistent-file";
+    bool found = celix_bundleContext_useBundle(ctx.get(), descBundleId, this, useBundleCallbackForAcquireNonexistentFile);
+    EXPECT_TRUE(found);
+}
@@ -38,6 +38,54 @@ celix_status_t dfi_findAndParseInterfaceDescriptor(celix_log_helper_t *logHelper
         celix_bundle_context_t *ctx, const celix_bundle_t *svcOwner, const char *name,
         dyn_interface_type **intfOut);
 
+/**
+ * @brief Finds and parses the interface descriptor for the provided name and returns a shared, read-only instance.
+ *
+ * Parsed descriptors are cached and refcounted, keyed by interface name and a hash of the descriptor content.
+ * The cache is per bundle: rsa_dfi_utils is a static library with hidden symbols, so every bundle linking it (e.g.
+ * the DFI RSA and the JSON-RPC factory) has its own cache. Descriptors are shared between the exports and imports of
+ * a bundle, not between bundles.
+ * The descriptor file is still located and read for every call, so a changed descriptor results in a new entry,
+ * but the parse cost is only paid once per distinct descriptor.
+ *
+ * The returned interface must be released with dfi_releaseInterfaceDescriptor and must not be destroyed with
+ * dynInterface_destroy.
+ *
+ * @param[in] logHelper The log helper used to log errors.
+ * @param[in] ctx The bundle context.
+ * @param[in] svcOwner The bundle used to find the descriptor file.
+ * @param[in] name The interface name.
+ * @param[out] intfOut The shared interface descriptor.
+ * @return CELIX_SUCCESS if the descriptor is found and parsed, CELIX_BUNDLE_EXCEPTION if the descriptor cannot be
+ * found or parsed, CELIX_ENOMEM if out of memory.
+ */
+celix_status_t dfi_acquireInterfaceDescriptor(celix_log_helper_t *logHelper,
+        celix_bundle_context_t *ctx, const celix_bundle_t *svcOwner, const char *name,
+        const dyn_interface_type **intfOut);
+
+/**
+ * @brief Releases an interface descriptor acquired with dfi_acquireInterfaceDescriptor.
+ *
+ * The descriptor is destroyed when the last user releases it. Releasing NULL is a no-op.
+ */
+void dfi_releaseInterfaceDescriptor(const dyn_interface_type* intf);
+
+/**
+ * @brief Fills the service function table with ffi closures for all methods of a shared interface descriptor.
+ *
+ * The closures are created once per cached descriptor and are shared by all proxies using it. The bind function
+ * receives the method_entry as user data and must retrieve its per proxy state from the service handle (args[0]).
+ * All proxies of a cached descriptor must use the same bind function.
+ *
+ * @param[in] intf A shared interface descriptor acquired with dfi_acquireInterfaceDescriptor.
+ * @param[in] bind The bind function of the closures.
+ * @param[in,out] service The service function table. Method i is stored at index i + 1, index 0 is the handle.
+ * @return CELIX_SUCCESS if successful, CELIX_ILLEGAL_STATE if closures with a different bind function already exist,
+ * CELIX_SERVICE_EXCEPTION if a closure cannot be created.
+ */
+celix_status_t dfi_createInterfaceClosures(const dyn_interface_type* intf, void (*bind)(void*, void**, void*),
+                                           void** service);
+
 #ifdef __cplusplus
 }
 #endif
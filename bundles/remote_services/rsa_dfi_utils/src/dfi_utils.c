@@ -18,9 +18,41 @@
  */
 
 #include "dfi_utils.h"
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include "celix_bundle_context.h"
+#include "celix_long_hash_map.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_string_hash_map.h"
+#include "celix_threads.h"
+#include "celix_utils.h"
+
+/**
+ * @brief A parsed interface descriptor shared by all exports and imports of the same descriptor content.
+ */
+typedef struct dfi_descriptor_cache_entry {
+    char* key; //name + content hash
+    char* content; //descriptor content, used to rule out hash collisions
+    size_t contentLen;
+    dyn_interface_type* intf;
+    void (*bind)(void*, void**, void*); //bind function of the created closures, NULL if no closures are created yet
+    size_t refCount;
+} dfi_descriptor_cache_entry_t;
+
+/**
+ * @brief Per bundle cache of parsed interface descriptors.
+ *
+ * This is a static in a static library with hidden symbols, so each linking bundle has its own cache. This is
+ * intended: the cached closures call a bind function of the linking bundle and must not outlive it.
+ * The maps are created on first use and destroyed when the last descriptor is released.
+ */
+static struct {
+    celix_thread_mutex_t mutex;
+    celix_string_hash_map_t* entriesByKey; //key = name + content hash, value = dfi_descriptor_cache_entry_t*
+    celix_long_hash_map_t* entriesByIntf; //key = dyn_interface_type*, value = dfi_descriptor_cache_entry_t*
+} dfi_descriptorCache = {CELIX_THREAD_MUTEX_INITIALIZER, NULL, NULL};
 
 static celix_status_t dfi_findFileForFramework(celix_bundle_context_t *context, const char *fileName, FILE **out) {
     celix_status_t  status = CELIX_SUCCESS;
@@ -123,3 +155,212 @@ celix_status_t dfi_findAndParseInterfaceDescriptor(celix_log_helper_t *logHelper
     return CELIX_BUNDLE_EXCEPTION;
 }
 
+
+static celix_status_t dfi_readDescriptorContent(FILE* descriptor, char** contentOut, size_t* lenOut) {
+    celix_autofree char* content = NULL;
+    size_t len = 0;
+    size_t cap = 0;
+    char buf[1024];
+    size_t read;
+    while ((read = fread(buf, 1, sizeof(buf), descriptor)) > 0) {
+        if (len + read + 1 > cap) {
+            size_t newCap = cap == 0 ? 2 * sizeof(buf) : 2 * cap;
+            while (newCap < len + read + 1) {
+                newCap *= 2;
+            }
+            char* newContent = realloc(content, newCap);
+            if (newContent == NULL) {
+                return CELIX_ENOMEM;
+            }
+            content = newContent;
+            cap = newCap;
+        }
+        memcpy(content + len, buf, read);
+        len += read;
+    }
+    if (ferror(descriptor) || content == NULL) {
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+    content[len] = '\0';
+    *contentOut = celix_steal_ptr(content);
+    *lenOut = len;
+    return CELIX_SUCCESS;
+}
+
+static uint64_t dfi_hashDescriptorContent(const char* content, size_t len) {
+    //FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= (unsigned char)content[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void dfi_destroyCacheEntry(dfi_descriptor_cache_entry_t* entry) {
+    if (entry != NULL) {
+        dynInterface_destroy(entry->intf);
+        free(entry->content);
+        free(entry->key);
+        free(entry);
+    }
+}
+
+static dfi_descriptor_cache_entry_t* dfi_createCacheEntry(const char* key, char* content, size_t contentLen) {
+    celix_autofree dfi_descriptor_cache_entry_t* entry = calloc(1, sizeof(*entry));
+    celix_autofree char* keyCopy = celix_utils_strdup(key);
+    if (entry == NULL || keyCopy == NULL) {
+        return NULL;
+    }
+    FILE* stream = fmemopen(content, contentLen, "r");
+    if (stream == NULL) {
+        return NULL;
+    }
+    int rc = dynInterface_parse(stream, &entry->intf);
+    fclose(stream);
+    if (rc != 0) {
+        return NULL;
+    }
+    entry->key = celix_steal_ptr(keyCopy);
+    entry->content = content;
+    entry->contentLen = contentLen;
+    entry->refCount = 1;
+    return celix_steal_ptr(entry);
+}
+
+static celix_status_t dfi_ensureCacheMapsLocked(void) {
+    if (dfi_descriptorCache.entriesByKey == NULL) {
+        dfi_descriptorCache.entriesByKey = celix_stringHashMap_create();
+    }
+    if (dfi_descriptorCache.entriesByIntf == NULL) {
+        dfi_descriptorCache.entriesByIntf = celix_longHashMap_create();
+    }
+    return dfi_descriptorCache.entriesByKey != NULL && dfi_descriptorCache.entriesByIntf != NULL ? CELIX_SUCCESS : CELIX_ENOMEM;
+}
+
+static void dfi_destroyCacheMapsIfEmptyLocked(void) {
+    if (dfi_descriptorCache.entriesByKey != NULL && celix_stringHashMap_size(dfi_descriptorCache.entriesByKey) == 0) {
+        celix_stringHashMap_destroy(dfi_descriptorCache.entriesByKey);
+        dfi_descriptorCache.entriesByKey = NULL;
+    }
+    if (dfi_descriptorCache.entriesByIntf != NULL && celix_longHashMap_size(dfi_descriptorCache.entriesByIntf) == 0) {
+        celix_longHashMap_destroy(dfi_descriptorCache.entriesByIntf);
+        dfi_descriptorCache.entriesByIntf = NULL;
+    }
+}
+
+celix_status_t dfi_acquireInterfaceDescriptor(celix_log_helper_t *logHelper,
+        celix_bundle_context_t *ctx, const celix_bundle_t *svcOwner, const char *name,
+        const dyn_interface_type **intfOut) {
+    if (logHelper == NULL || ctx == NULL || svcOwner == NULL || name == NULL || intfOut == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    FILE* descriptor = NULL;
+    celix_status_t status = dfi_findDescriptor(ctx, svcOwner, name, &descriptor);
+    if (status != CELIX_SUCCESS || descriptor == NULL) {
+        celix_logHelper_error(logHelper, "Cannot find/open any valid descriptor files for '%s'", name);
+        return CELIX_BUNDLE_EXCEPTION;
+    }
+    celix_autofree char* content = NULL;
+    size_t contentLen = 0;
+    status = dfi_readDescriptorContent(descriptor, &content, &contentLen);
+    fclose(descriptor);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Cannot read descriptor file for '%s'", name);
+        return status;
+    }
+
+    //note the descriptor header (and therefore the interface version) is part of the hashed content
+    char key[256];
+    snprintf(key, sizeof(key), "%s:%016llx:%zu", name,
+             (unsigned long long)dfi_hashDescriptorContent(content, contentLen), contentLen);
+
+    celix_auto(celix_mutex_lock_guard_t) lock = celixMutexLockGuard_init(&dfi_descriptorCache.mutex);
+    status = dfi_ensureCacheMapsLocked();
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Cannot create dfi descriptor cache");
+        dfi_destroyCacheMapsIfEmptyLocked();
+        return status;
+    }
+    dfi_descriptor_cache_entry_t* entry = celix_stringHashMap_get(dfi_descriptorCache.entriesByKey, key);
+    if (entry != NULL && entry->contentLen == contentLen && memcmp(entry->content, content, contentLen) == 0) {
+        entry->refCount += 1;
+        *intfOut = entry->intf;
+        return CELIX_SUCCESS;
+    } else if (entry != NULL) {
+        //hash collision, parse the descriptor without caching it
+        celix_logHelper_warning(logHelper, "Descriptor cache collision for '%s', descriptor is not shared", name);
+        snprintf(key, sizeof(key), "%s:%p", name, (void*)content);
+    }
+
+    entry = dfi_createCacheEntry(key, content, contentLen);
+    if (entry == NULL) {
+        celix_logHelper_logTssErrors(logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(logHelper, "Cannot parse dfi descriptor for '%s'", name);
+        dfi_destroyCacheMapsIfEmptyLocked();
+        return CELIX_BUNDLE_EXCEPTION;
+    }
+    celix_steal_ptr(content); //owned by the entry
+    if (celix_stringHashMap_put(dfi_descriptorCache.entriesByKey, entry->key, entry) != CELIX_SUCCESS ||
+        celix_longHashMap_put(dfi_descriptorCache.entriesByIntf, (long)entry->intf, entry) != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Cannot add dfi descriptor for '%s' to the descriptor cache", name);
+        celix_stringHashMap_remove(dfi_descriptorCache.entriesByKey, entry->key);
+        dfi_destroyCacheEntry(entry);
+        dfi_destroyCacheMapsIfEmptyLocked();
+        return CELIX_ENOMEM;
+    }
+    *intfOut = entry->intf;
+    return CELIX_SUCCESS;
+}
+
+void dfi_releaseInterfaceDescriptor(const dyn_interface_type* intf) {
+    if (intf == NULL) {
+        return;
+    }
+    celix_auto(celix_mutex_lock_guard_t) lock = celixMutexLockGuard_init(&dfi_descriptorCache.mutex);
+    dfi_descriptor_cache_entry_t* entry = dfi_descriptorCache.entriesByIntf == NULL ? NULL :
+            celix_longHashMap_get(dfi_descriptorCache.entriesByIntf, (long)intf);
+    if (entry == NULL) {
+        return;
+    }
+    entry->refCount -= 1;
+    if (entry->refCount == 0) {
+        celix_longHashMap_remove(dfi_descriptorCache.entriesByIntf, (long)intf);
+        celix_stringHashMap_remove(dfi_descriptorCache.entriesByKey, entry->key);
+        dfi_destroyCacheEntry(entry);
+        dfi_destroyCacheMapsIfEmptyLocked();
+    }
+}
+
+celix_status_t dfi_createInterfaceClosures(const dyn_interface_type* intf, void (*bind)(void*, void**, void*),
+                                           void** service) {
+    if (intf == NULL || bind == NULL || service == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_auto(celix_mutex_lock_guard_t) lock = celixMutexLockGuard_init(&dfi_descriptorCache.mutex);
+    dfi_descriptor_cache_entry_t* entry = dfi_descriptorCache.entriesByIntf == NULL ? NULL :
+            celix_longHashMap_get(dfi_descriptorCache.entriesByIntf, (long)intf);
+    if (entry == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (entry->bind != NULL && entry->bind != bind) {
+        //closures are bound to a single bind function
+        return CELIX_ILLEGAL_STATE;
+    }
+    const struct methods_head* list = dynInterface_methods(intf);
+    struct method_entry* method = NULL;
+    int index = 0;
+    TAILQ_FOREACH(method, list, entries) {
+        void (*fn)(void) = NULL;
+        if (dynFunction_getFnPointer(method->dynFunc, &fn) != 0) {
+            int rc = dynFunction_createClosure(method->dynFunc, bind, method, &fn);
+            if (rc != 0) {
+                return CELIX_SERVICE_EXCEPTION;
+            }
+            entry->bind = bind;
+        }
+        service[++index] = fn;
+    }
+    return CELIX_SUCCESS;
+}
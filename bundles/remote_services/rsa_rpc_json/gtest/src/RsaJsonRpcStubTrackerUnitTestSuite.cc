@@ -0,0 +1,148 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "rsa_json_rpc_stub_tracker.h"
+#include "json_rpc_stub.h"
+#include "dyn_interface.h"
+#include "celix_properties.h"
+#include "celix_types.h"
+#include "celix_framework.h"
+#include "celix_bundle_context.h"
+#include "celix_framework_factory.h"
+#include "celix_constants.h"
+#include "celix_threads_ei.h"
+#include "celix_bundle_context_ei.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+
+class RsaJsonRpcStubTrackerUnitTestSuite : public ::testing::Test {
+public:
+    RsaJsonRpcStubTrackerUnitTestSuite() {
+        auto* props = celix_properties_create();
+        celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, ".rsa_json_rpc_impl_cache");
+        auto* fwPtr = celix_frameworkFactory_createFramework(props);
+        auto* ctxPtr = celix_framework_getFrameworkContext(fwPtr);
+        fw = std::shared_ptr<celix_framework_t>{fwPtr, [](auto* f) {celix_frameworkFactory_destroyFramework(f);}};
+        ctx = std::shared_ptr<celix_bundle_context_t>{ctxPtr, [](auto*){/*nop*/}};
+        auto* logHelperPtr = celix_logHelper_create(ctxPtr,"RsaJsonRpc");
+        logHelper = std::shared_ptr<celix_log_helper_t>{logHelperPtr, [](auto*l){ celix_logHelper_destroy(l);}};
+
+        FILE* desc = fopen(RESOURCES_DIR "/org.apache.celix.test.api.rpc_json.descriptor", "r");
+        EXPECT_NE(nullptr, desc);
+        dyn_interface_type* intfPtr = nullptr;
+        EXPECT_EQ(0, dynInterface_parse(desc, &intfPtr));
+        fclose(desc);
+        intf = std::shared_ptr<dyn_interface_type>{intfPtr, [](auto* i) {dynInterface_destroy(i);}};
+
+        stub.interfaceName = "calculator";
+        stub.interfaceVersion = "1.0.0";
+        stub.nrOfMethods = 1;
+    }
+
+    ~RsaJsonRpcStubTrackerUnitTestSuite() override {
+        celix_ei_expect_celixThreadRwlock_create(nullptr, 0, 0);
+        celix_ei_expect_celix_bundleContext_trackServicesWithOptionsAsync(nullptr, 0, 0);
+    }
+
+    long registerStub(json_rpc_stub_t* svc) {
+        auto* props = celix_properties_create();
+        celix_properties_set(props, JSON_RPC_STUB_INTERFACE_NAME, svc->interfaceName);
+        celix_properties_set(props, JSON_RPC_STUB_INTERFACE_VERSION, svc->interfaceVersion);
+        celix_service_registration_options_t opts{};
+        opts.serviceName = JSON_RPC_STUB_SERVICE_NAME;
+        opts.serviceVersion = JSON_RPC_STUB_SERVICE_VERSION;
+        opts.svc = svc;
+        opts.properties = props;
+        long svcId = celix_bundleContext_registerServiceWithOptions(ctx.get(), &opts);
+        EXPECT_NE(-1, svcId);
+        return svcId;
+    }
+
+    std::shared_ptr<celix_framework_t> fw{};
+    std::shared_ptr<celix_bundle_context_t> ctx{};
+    std::shared_ptr<celix_log_helper_t> logHelper{};
+    std::shared_ptr<dyn_interface_type> intf{};
+    json_rpc_stub_t stub{};
+};
+
+TEST_F(RsaJsonRpcStubTrackerUnitTestSuite, CreateRsaJsonRpcStubTracker) {
+    rsa_json_rpc_stub_tracker_t *tracker = nullptr;
+    auto status = rsaJsonRpcStubTracker_create(ctx.get(), logHelper.get(), &tracker);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    rsaJsonRpcStubTracker_destroy(tracker);
+}
+
+TEST_F(RsaJsonRpcStubTrackerUnitTestSuite, CreateRsaJsonRpcStubTrackerWithInvalidParams) {
+    rsa_json_rpc_stub_tracker_t *tracker = nullptr;
+    auto status = rsaJsonRpcStubTracker_create(nullptr, logHelper.get(), &tracker);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+
+    status = rsaJsonRpcStubTracker_create(ctx.get(), nullptr, &tracker);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+
+    status = rsaJsonRpcStubTracker_create(ctx.get(), logHelper.get(), nullptr);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+}
+
+TEST_F(RsaJsonRpcStubTrackerUnitTestSuite, FailedToCreateRsaJsonRpcStubTrackerLock) {
+    rsa_json_rpc_stub_tracker_t *tracker = nullptr;
+    celix_ei_expect_celixThreadRwlock_create((void*)&rsaJsonRpcStubTracker_create, 0, CELIX_ENOMEM);
+    auto status = rsaJsonRpcStubTracker_create(ctx.get(), logHelper.get(), &tracker);
+    EXPECT_EQ(CELIX_ENOMEM, status);
+}
+
+TEST_F(RsaJsonRpcStubTrackerUnitTestSuite, FailedToTrackRsaJsonRpcStubService) {
+    rsa_json_rpc_stub_tracker_t *tracker = nullptr;
+    celix_ei_expect_celix_bundleContext_trackServicesWithOptionsAsync((void*)&rsaJsonRpcStubTracker_create, 0, -1);
+    auto status = rsaJsonRpcStubTracker_create(ctx.get(), logHelper.get(), &tracker);
+    EXPECT_EQ(CELIX_SERVICE_EXCEPTION, status);
+}
+
+TEST_F(RsaJsonRpcStubTrackerUnitTestSuite, FindStub) {
+    rsa_json_rpc_stub_tracker_t *tracker = nullptr;
+    auto status = rsaJsonRpcStubTracker_create(ctx.get(), logHelper.get(), &tracker);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    celix_bundleContext_waitForEvents(ctx.get());
+    EXPECT_EQ(nullptr, rsaJsonRpcStubTracker_findStub(tracker, intf.get(), CELIX_FRAMEWORK_BUNDLE_ID));
+
+    long svcId = registerStub(&stub);
+    celix_bundleContext_waitForEvents(ctx.get());
+    EXPECT_EQ(&stub, rsaJsonRpcStubTracker_findStub(tracker, intf.get(), CELIX_FRAMEWORK_BUNDLE_ID));
+    //stubs are only used for the bundle that registered them
+    EXPECT_EQ(nullptr, rsaJsonRpcStubTracker_findStub(tracker, intf.get(), CELIX_FRAMEWORK_BUNDLE_ID + 1));
+
+    celix_bundleContext_unregisterService(ctx.get(), svcId);
+    celix_bundleContext_waitForEvents(ctx.get());
+    EXPECT_EQ(nullptr, rsaJsonRpcStubTracker_findStub(tracker, intf.get(), CELIX_FRAMEWORK_BUNDLE_ID));
+
+    rsaJsonRpcStubTracker_destroy(tracker);
+}
+
+TEST_F(RsaJsonRpcStubTrackerUnitTestSuite, FindStubWithMismatchedMethods) {
+    rsa_json_rpc_stub_tracker_t *tracker = nullptr;
+    auto status = rsaJsonRpcStubTracker_create(ctx.get(), logHelper.get(), &tracker);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    stub.nrOfMethods = 2;
+    long svcId = registerStub(&stub);
+    celix_bundleContext_waitForEvents(ctx.get());
+    EXPECT_EQ(nullptr, rsaJsonRpcStubTracker_findStub(tracker, intf.get(), CELIX_FRAMEWORK_BUNDLE_ID));
+
+    celix_bundleContext_unregisterService(ctx.get(), svcId);
+    rsaJsonRpcStubTracker_destroy(tracker);
+}
@@ -38,12 +38,14 @@ struct rsa_json_rpc_endpoint {
     endpoint_description_t *endpointDesc;
     unsigned int serialProtoId;
     remote_interceptors_handler_t *interceptorsHandler;
+    rsa_json_rpc_stub_tracker_t *stubTracker;
     rsa_request_handler_service_t reqHandlerSvc;
     long reqHandlerSvcId;
     long svcTrackerId;
     celix_thread_rwlock_t lock; //projects below
     void *service;
-    dyn_interface_type *intfType;
+    const dyn_interface_type *intfType; //shared descriptor, released with dfi_releaseInterfaceDescriptor
+    const json_rpc_stub_t *stub; //generated stub of the service owner, NULL if the dynamic (libffi) path is used
 };
 
 static void rsaJsonRpcEndpoint_stopSvcTrackerDone(void *data);
@@ -56,12 +58,13 @@ static celix_status_t rsaJsonRpcEndpoint_handleRequest(void *handle, celix_prope
 
 celix_status_t rsaJsonRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
         FILE *logFile, remote_interceptors_handler_t *interceptorsHandler,
-        const endpoint_description_t *endpointDesc, unsigned int serialProtoId,
-        rsa_json_rpc_endpoint_t **endpointOut) {
+        const endpoint_description_t *endpointDesc, rsa_json_rpc_stub_tracker_t *stubTracker,
+        unsigned int serialProtoId, rsa_json_rpc_endpoint_t **endpointOut) {
     assert(ctx != NULL);
     assert(logHelper != NULL);
     assert(interceptorsHandler != NULL);
     assert(endpointDesc != NULL);
+    assert(stubTracker != NULL);
     assert(endpointOut != NULL);
     celix_status_t status = CELIX_SUCCESS;
     celix_autofree rsa_json_rpc_endpoint_t* endpoint = calloc(1, sizeof(*endpoint));
@@ -80,8 +83,10 @@ celix_status_t rsaJsonRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_
     }
 
     endpoint->interceptorsHandler = interceptorsHandler;
+    endpoint->stubTracker = stubTracker;
     endpoint->service = NULL;
     endpoint->intfType = NULL;
+    endpoint->stub = NULL;
     status = celixThreadRwlock_create(&endpoint->lock, NULL);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(logHelper, "RSA json rpc endpoint: Error initilizing lock for %s. %d.",
@@ -160,12 +165,12 @@ static void rsaJsonRpcEndpoint_addSvcWithOwner(void *handle, void *service,
     assert(svcOwner != NULL);
     celix_status_t status = CELIX_SUCCESS;
     rsa_json_rpc_endpoint_t *endpoint = (rsa_json_rpc_endpoint_t *)handle;
-    celix_autoptr(dyn_interface_type) intfType = NULL;
+    const dyn_interface_type *intfType = NULL;
     const char *serviceName = celix_properties_get(endpoint->endpointDesc->properties, CELIX_FRAMEWORK_SERVICE_NAME, "unknown-service");
 
     celix_auto(celix_rwlock_wlock_guard_t) lock = celixRwlockWlockGuard_init(&endpoint->lock);
 
-    status = dfi_findAndParseInterfaceDescriptor(endpoint->logHelper,endpoint->ctx,
+    status = dfi_acquireInterfaceDescriptor(endpoint->logHelper,endpoint->ctx,
             svcOwner, endpoint->endpointDesc->serviceName, &intfType);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(endpoint->logHelper, "Endpoint: Error Parsing service descriptor for %s.", serviceName);
@@ -177,15 +182,21 @@ static void rsaJsonRpcEndpoint_addSvcWithOwner(void *handle, void *service,
     const char *serviceVersion = celix_properties_get(endpoint->endpointDesc->properties,CELIX_FRAMEWORK_SERVICE_VERSION, NULL);
     if (serviceVersion == NULL) {
         celix_logHelper_error(endpoint->logHelper, "Endpoint: Error getting service version for %s.", serviceName);
+        dfi_releaseInterfaceDescriptor(intfType);
         return;
     }
     if(strcmp(serviceVersion, intfVersion)!=0){
         celix_logHelper_error(endpoint->logHelper, "Endpoint: %s version (%s) and interface version from the descriptor (%s) are not the same!", serviceName, serviceVersion,intfVersion);
+        dfi_releaseInterfaceDescriptor(intfType);
         return;
     }
 
     endpoint->service = service;
-    endpoint->intfType = celix_steal_ptr(intfType);
+    endpoint->intfType = intfType;
+    endpoint->stub = rsaJsonRpcStubTracker_findStub(endpoint->stubTracker, intfType, celix_bundle_getId(svcOwner));
+    if (endpoint->stub != NULL) {
+        celix_logHelper_debug(endpoint->logHelper, "Endpoint: Using generated json rpc stub for %s.", serviceName);
+    }
     return;
 }
 
@@ -198,7 +209,8 @@ static void rsaJsonRpcEndpoint_removeSvcWithOwner(void *handle, void *service,
     celix_auto(celix_rwlock_wlock_guard_t) lock = celixRwlockWlockGuard_init(&endpoint->lock);
     if (endpoint->service == service) {
         endpoint->service = NULL;
-        dynInterface_destroy(endpoint->intfType);
+        endpoint->stub = NULL;
+        dfi_releaseInterfaceDescriptor(endpoint->intfType);
         endpoint->intfType = NULL;
     }
     return;
@@ -240,7 +252,9 @@ static celix_status_t rsaJsonRpcEndpoint_handleRequest(void *handle, celix_prope
     if (cont) {
         celixThreadRwlock_readLock(&endpoint->lock);
         if (endpoint->service != NULL) {
-            int rc1 = jsonRpc_call(endpoint->intfType, endpoint->service, (char *)request->iov_base, &szResponse);
+            int rc1 = endpoint->stub != NULL ?
+                    endpoint->stub->call(endpoint->service, (char *)request->iov_base, &szResponse) :
+                    jsonRpc_call(endpoint->intfType, endpoint->service, (char *)request->iov_base, &szResponse);
             status = (rc1 != 0) ? CELIX_SERVICE_EXCEPTION : CELIX_SUCCESS;
             if (rc1 != 0) {
                 celix_logHelper_logTssErrors(endpoint->logHelper, CELIX_LOG_LEVEL_ERROR);
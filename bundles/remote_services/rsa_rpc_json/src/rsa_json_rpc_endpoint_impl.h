@@ -25,6 +25,7 @@ extern "C" {
 #endif
 #include "endpoint_description.h"
 #include "remote_interceptors_handler.h"
+#include "rsa_json_rpc_stub_tracker.h"
 #include "celix_log_helper.h"
 #include "celix_types.h"
 #include "celix_errno.h"
@@ -34,8 +35,8 @@ typedef struct rsa_json_rpc_endpoint rsa_json_rpc_endpoint_t;
 
 celix_status_t rsaJsonRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
         FILE *logFile, remote_interceptors_handler_t *interceptorsHandler,
-        const endpoint_description_t *endpointDesc, unsigned int serialProtoId,
-        rsa_json_rpc_endpoint_t **endpointOut);
+        const endpoint_description_t *endpointDesc, rsa_json_rpc_stub_tracker_t *stubTracker,
+        unsigned int serialProtoId, rsa_json_rpc_endpoint_t **endpointOut);
 
 void rsaJsonRpcEndpoint_destroy(rsa_json_rpc_endpoint_t *endpoint);
 
@@ -21,6 +21,7 @@
 #include "rsa_json_rpc_constants.h"
 #include "rsa_json_rpc_endpoint_impl.h"
 #include "rsa_json_rpc_proxy_impl.h"
+#include "rsa_json_rpc_stub_tracker.h"
 #include "remote_interceptors_handler.h"
 #include "endpoint_description.h"
 #include "celix_long_hash_map.h"
@@ -46,6 +47,7 @@ struct rsa_json_rpc {
     celix_long_hash_map_t *svcEndpoints;// Key:request handler service id, Value: rsa_json_rpc_endpoint_t
     remote_interceptors_handler_t *interceptorsHandler;
     rsa_request_sender_tracker_t *reqSenderTracker;
+    rsa_json_rpc_stub_tracker_t *stubTracker;
     unsigned int serialProtoId; //Serialization protocol ID
     FILE *callsLogFile;
 };
@@ -107,6 +109,13 @@ celix_status_t rsaJsonRpc_create(celix_bundle_context_t* ctx, celix_log_helper_t
         return status;
     }
 
+    status = rsaJsonRpcStubTracker_create(ctx, logHelper, &rpc->stubTracker);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Error creating json rpc stub tracker. %d.", status);
+        rsaRequestSenderTracker_destroy(rpc->reqSenderTracker);
+        return status;
+    }
+
     bool logCalls = celix_bundleContext_getPropertyAsBool(ctx, RSA_JSON_RPC_LOG_CALLS_KEY, RSA_JSON_RPC_LOG_CALLS_DEFAULT);
     if (logCalls) {
         const char *f = celix_bundleContext_getProperty(ctx, RSA_JSON_RPC_LOG_CALLS_FILE_KEY, RSA_JSON_RPC_LOG_CALLS_FILE_DEFAULT);
@@ -132,6 +141,7 @@ void rsaJsonRpc_destroy(rsa_json_rpc_t *jsonRpc) {
         if (jsonRpc->callsLogFile != NULL && jsonRpc->callsLogFile != stdout) {
             fclose(jsonRpc->callsLogFile);
         }
+        rsaJsonRpcStubTracker_destroy(jsonRpc->stubTracker);
         rsaRequestSenderTracker_destroy(jsonRpc->reqSenderTracker);
         remoteInterceptorsHandler_destroy(jsonRpc->interceptorsHandler);
         assert(celix_longHashMap_size(jsonRpc->svcEndpoints) == 0);
@@ -158,7 +168,7 @@ celix_status_t rsaJsonRpc_createProxy(void *handle, const endpoint_description_t
     rsa_json_rpc_proxy_factory_t *proxyFactory = NULL;
     status = rsaJsonRpcProxy_factoryCreate(jsonRpc->ctx, jsonRpc->logHelper,
             jsonRpc->callsLogFile, jsonRpc->interceptorsHandler, endpointDesc,
-            jsonRpc->reqSenderTracker, requestSenderSvcId, jsonRpc->serialProtoId, &proxyFactory);
+            jsonRpc->reqSenderTracker, requestSenderSvcId, jsonRpc->stubTracker, jsonRpc->serialProtoId, &proxyFactory);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(jsonRpc->logHelper, "Error creating proxy factory for %s.", endpointDesc->serviceName);
         return status;
@@ -200,7 +210,7 @@ celix_status_t rsaJsonRpc_createEndpoint(void *handle, const endpoint_descriptio
 
     rsa_json_rpc_endpoint_t *endpoint = NULL;
     status = rsaJsonRpcEndpoint_create(jsonRpc->ctx, jsonRpc->logHelper, jsonRpc->callsLogFile,
-            jsonRpc->interceptorsHandler, endpointDesc, jsonRpc->serialProtoId, &endpoint);
+            jsonRpc->interceptorsHandler, endpointDesc, jsonRpc->stubTracker, jsonRpc->serialProtoId, &endpoint);
     if (status != CELIX_SUCCESS) {
         return status;
     }
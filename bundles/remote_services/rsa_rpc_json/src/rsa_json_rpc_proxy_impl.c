@@ -48,11 +48,13 @@ struct rsa_json_rpc_proxy_factory {
     remote_interceptors_handler_t *interceptorsHandler;
     rsa_request_sender_tracker_t *reqSenderTracker;
     long reqSenderSvcId;
+    rsa_json_rpc_stub_tracker_t *stubTracker;
 };
 
 typedef struct rsa_json_rpc_proxy {
     rsa_json_rpc_proxy_factory_t *proxyFactory;
-    dyn_interface_type *intfType;
+    const dyn_interface_type *intfType; //shared descriptor, released with dfi_releaseInterfaceDescriptor
+    json_rpc_stub_proxy_t stubProxy; //service handle if the generated stub of the requesting bundle is used
     void *service;
     unsigned int useCnt;
 }rsa_json_rpc_proxy_t;
@@ -80,6 +82,7 @@ celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx,
                                              const endpoint_description_t* endpointDesc,
                                              rsa_request_sender_tracker_t* reqSenderTracker,
                                              long requestSenderSvcId,
+                                             rsa_json_rpc_stub_tracker_t* stubTracker,
                                              unsigned int serialProtoId,
                                              rsa_json_rpc_proxy_factory_t** proxyFactoryOut) {
     assert(ctx != NULL);
@@ -88,6 +91,7 @@ celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx,
     assert(endpointDesc != NULL);
     assert(reqSenderTracker != NULL);
     assert(requestSenderSvcId > 0);
+    assert(stubTracker != NULL);
     assert(proxyFactoryOut != NULL);
     celix_autofree rsa_json_rpc_proxy_factory_t* proxyFactory =
         (rsa_json_rpc_proxy_factory_t*)calloc(1, sizeof(*proxyFactory));
@@ -100,6 +104,7 @@ celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx,
     proxyFactory->interceptorsHandler = interceptorsHandler;
     proxyFactory->reqSenderTracker = reqSenderTracker;
     proxyFactory->reqSenderSvcId = requestSenderSvcId;
+    proxyFactory->stubTracker = stubTracker;
     proxyFactory->serialProtoId = serialProtoId;
 
     CELIX_BUILD_ASSERT(sizeof(long) == sizeof(void*)); // The hash_map uses the pointer as key, so this should be true
@@ -207,76 +212,32 @@ static celix_status_t rsaJsonRpcProxy_useReqSenderSvcCallback(void *handle, rsa_
             data->request, data->response);
 }
 
-static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *returnVal) {
-    celix_status_t  status = CELIX_SUCCESS;
-    if (returnVal == NULL) {
-        return;
-    }
-    if ((args == NULL) || (*((void **)args[0]) == NULL)) {
-        *(celix_status_t *)returnVal = CELIX_ILLEGAL_ARGUMENT;
-        return;
-    }
-    assert(userData != NULL);
-    struct method_entry *entry = userData;
-    rsa_json_rpc_proxy_t *proxy = *((void **)args[0]);
-    rsa_json_rpc_proxy_factory_t *proxyFactory = proxy->proxyFactory;
-    assert(proxyFactory != NULL);
-
-    char *invokeRequest = NULL;
-    int rc = jsonRpc_prepareInvokeRequest(entry->dynFunc, entry->id, args, &invokeRequest);
-    if (rc != 0) {
-        celix_logHelper_logTssErrors(proxyFactory->logHelper, CELIX_LOG_LEVEL_ERROR);
-        celix_logHelper_error(proxyFactory->logHelper, "Error preparing invoke request for %s",
-                              dynFunction_getName(entry->dynFunc));
-        *(celix_status_t *)returnVal = CELIX_SERVICE_EXCEPTION;
-        return;
-    }
-
-    struct iovec replyIovec = {NULL,0};
+static celix_status_t rsaJsonRpcProxy_sendRequest(rsa_json_rpc_proxy_factory_t *proxyFactory, const char *methodName,
+        const char *invokeRequest, struct iovec *replyIovec) {
+    celix_status_t status = CELIX_SUCCESS;
     celix_properties_t *metadata = celix_properties_create();
     if (metadata == NULL) {
-        celix_logHelper_error(proxyFactory->logHelper,"Error creating metadata for %s",
-                              dynFunction_getName(entry->dynFunc));
-        free(invokeRequest);
-        *(celix_status_t *)returnVal = CELIX_ENOMEM;
-        return;
+        celix_logHelper_error(proxyFactory->logHelper,"Error creating metadata for %s", methodName);
+        return CELIX_ENOMEM;
     }
     celix_properties_setLong(metadata, "SerialProtocolId", proxyFactory->serialProtoId);
     bool cont = remoteInterceptorHandler_invokePreProxyCall(proxyFactory->interceptorsHandler,
-            proxyFactory->endpointDesc->properties, dynFunction_getName(entry->dynFunc), &metadata);
+            proxyFactory->endpointDesc->properties, methodName, &metadata);
     if (cont) {
-        struct iovec requestIovec = {invokeRequest,strlen(invokeRequest) + 1};
+        struct iovec requestIovec = {(void *)invokeRequest,strlen(invokeRequest) + 1};
         struct rsa_request_sender_callback_data data= {
                 .endpointDesc = proxyFactory->endpointDesc,
                 .metadata = metadata,
                 .request = &requestIovec,
-                .response = &replyIovec
+                .response = replyIovec
         };
         status = rsaRequestSenderTracker_useService(proxyFactory->reqSenderTracker, proxyFactory->reqSenderSvcId,
                 &data, rsaJsonRpcProxy_useReqSenderSvcCallback);
-        if (status == CELIX_SUCCESS && dynFunction_hasReturn(entry->dynFunc)) {
-            if (replyIovec.iov_base != NULL) {
-                int rsErrno = CELIX_SUCCESS;
-                int retVal = jsonRpc_handleReply(entry->dynFunc,
-                        (const char *)replyIovec.iov_base , args, &rsErrno);
-                if(retVal != 0) {
-                    status = CELIX_SERVICE_EXCEPTION;
-                    celix_logHelper_logTssErrors(proxyFactory->logHelper, CELIX_LOG_LEVEL_ERROR);
-                    celix_logHelper_error(proxyFactory->logHelper, "Error handling reply for %s",
-                                          dynFunction_getName(entry->dynFunc));
-                } else if (rsErrno != CELIX_SUCCESS) {
-                    //return the invocation error of remote service function
-                    status = rsErrno;
-                }
-            } else {
-                celix_logHelper_error(proxyFactory->logHelper,"Expect service proxy has return, but reply is empty.");
-                status = CELIX_ILLEGAL_ARGUMENT;
-            }
-        } else if (status != CELIX_SUCCESS) {
+        if (status != CELIX_SUCCESS) {
             celix_logHelper_error(proxyFactory->logHelper,"Service proxy send request failed. %d", status);
         }
         remoteInterceptorHandler_invokePostProxyCall(proxyFactory->interceptorsHandler,
-                proxyFactory->endpointDesc->properties, dynFunction_getName(entry->dynFunc), metadata);
+                proxyFactory->endpointDesc->properties, methodName, metadata);
     } else {
         celix_logHelper_error(proxyFactory->logHelper, "%s has been intercepted.", proxyFactory->endpointDesc->serviceName);
         status = CELIX_INTERCEPTOR_EXCEPTION;
@@ -286,13 +247,66 @@ static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *retu
     if(metadata != NULL) {
         celix_properties_destroy(metadata);
     }
+    return status;
+}
 
+static void rsaJsonRpcProxy_logCall(rsa_json_rpc_proxy_factory_t *proxyFactory, const char *invokeRequest,
+        const char *reply, celix_status_t status) {
     if (proxyFactory->callsLogFile != NULL) {
         fprintf(proxyFactory->callsLogFile, "PROXY REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\trequest_payload=%s\n\trequest_response=%s\n\tstatus=%i\n",
-                proxyFactory->endpointDesc->serviceName, proxyFactory->endpointDesc->serviceId, invokeRequest, (char *)replyIovec.iov_base, status);
+                proxyFactory->endpointDesc->serviceName, proxyFactory->endpointDesc->serviceId, invokeRequest, reply, status);
         fflush(proxyFactory->callsLogFile);
     }
+}
 
+static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *returnVal) {
+    celix_status_t  status = CELIX_SUCCESS;
+    if (returnVal == NULL) {
+        return;
+    }
+    if ((args == NULL) || (*((void **)args[0]) == NULL)) {
+        *(celix_status_t *)returnVal = CELIX_ILLEGAL_ARGUMENT;
+        return;
+    }
+    assert(userData != NULL);
+    struct method_entry *entry = userData;
+    rsa_json_rpc_proxy_t *proxy = *((void **)args[0]);
+    rsa_json_rpc_proxy_factory_t *proxyFactory = proxy->proxyFactory;
+    assert(proxyFactory != NULL);
+
+    char *invokeRequest = NULL;
+    int rc = jsonRpc_prepareInvokeRequest(entry->dynFunc, entry->id, args, &invokeRequest);
+    if (rc != 0) {
+        celix_logHelper_logTssErrors(proxyFactory->logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(proxyFactory->logHelper, "Error preparing invoke request for %s",
+                              dynFunction_getName(entry->dynFunc));
+        *(celix_status_t *)returnVal = CELIX_SERVICE_EXCEPTION;
+        return;
+    }
+
+    struct iovec replyIovec = {NULL,0};
+    status = rsaJsonRpcProxy_sendRequest(proxyFactory, dynFunction_getName(entry->dynFunc), invokeRequest, &replyIovec);
+    if (status == CELIX_SUCCESS && dynFunction_hasReturn(entry->dynFunc)) {
+        if (replyIovec.iov_base != NULL) {
+            int rsErrno = CELIX_SUCCESS;
+            int retVal = jsonRpc_handleReply(entry->dynFunc,
+                    (const char *)replyIovec.iov_base , args, &rsErrno);
+            if(retVal != 0) {
+                status = CELIX_SERVICE_EXCEPTION;
+                celix_logHelper_logTssErrors(proxyFactory->logHelper, CELIX_LOG_LEVEL_ERROR);
+                celix_logHelper_error(proxyFactory->logHelper, "Error handling reply for %s",
+                                      dynFunction_getName(entry->dynFunc));
+            } else if (rsErrno != CELIX_SUCCESS) {
+                //return the invocation error of remote service function
+                status = rsErrno;
+            }
+        } else {
+            celix_logHelper_error(proxyFactory->logHelper,"Expect service proxy has return, but reply is empty.");
+            status = CELIX_ILLEGAL_ARGUMENT;
+        }
+    }
+
+    rsaJsonRpcProxy_logCall(proxyFactory, invokeRequest, (char *)replyIovec.iov_base, status);
 
     free(invokeRequest); //Allocated by json_dumps in jsonRpc_prepareInvokeRequest
     if (replyIovec.iov_base) {
@@ -304,23 +318,21 @@ static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *retu
     return;
 }
 
-static celix_status_t rsaJsonRpcProxy_create(rsa_json_rpc_proxy_factory_t *proxyFactory,
-        const celix_bundle_t *requestingBundle, rsa_json_rpc_proxy_t **proxyOut) {
-    celix_status_t status = CELIX_SUCCESS;
-    celix_autofree rsa_json_rpc_proxy_t *proxy = calloc(1, sizeof(*proxy));
-    if (proxy == NULL) {
-        return CELIX_ENOMEM;
-    }
-    proxy->proxyFactory = proxyFactory;
-    proxy->useCnt = 0;
+static celix_status_t rsaJsonRpcProxy_stubSend(void *handle, const char *methodName, const char *request,
+        char **reply) {
+    rsa_json_rpc_proxy_t *proxy = handle;
+    rsa_json_rpc_proxy_factory_t *proxyFactory = proxy->proxyFactory;
+    struct iovec replyIovec = {NULL,0};
+    celix_status_t status = rsaJsonRpcProxy_sendRequest(proxyFactory, methodName, request, &replyIovec);
+    rsaJsonRpcProxy_logCall(proxyFactory, request, (char *)replyIovec.iov_base, status);
+    *reply = replyIovec.iov_base;
+    return status;
+}
 
-    celix_autoptr(dyn_interface_type) intfType = NULL;
-    status = dfi_findAndParseInterfaceDescriptor(proxyFactory->logHelper,
-            proxyFactory->ctx, requestingBundle, proxyFactory->endpointDesc->serviceName, &intfType);
-    if (status != CELIX_SUCCESS) {
-        return status;
-    }
-    proxy->intfType = intfType;
+static celix_status_t rsaJsonRpcProxy_initService(rsa_json_rpc_proxy_t *proxy, const celix_bundle_t *requestingBundle) {
+    celix_status_t status = CELIX_SUCCESS;
+    rsa_json_rpc_proxy_factory_t *proxyFactory = proxy->proxyFactory;
+    const dyn_interface_type *intfType = proxy->intfType;
 
     //Check service version
     const char *providerVerStr = celix_properties_get(proxyFactory->endpointDesc->properties,CELIX_FRAMEWORK_SERVICE_VERSION, NULL);
@@ -345,29 +357,58 @@ static celix_status_t rsaJsonRpcProxy_create(rsa_json_rpc_proxy_factory_t *proxy
     }
 
     size_t intfMethodNb = dynInterface_nrOfMethods(intfType);
-    proxy->service = calloc(1 + intfMethodNb, sizeof(void *));//The interface includes 'void *handle' and its methods
-    if (proxy->service == NULL) {
+    celix_autofree void **service = calloc(1 + intfMethodNb, sizeof(void *));//The interface includes 'void *handle' and its methods
+    if (service == NULL) {
         celix_logHelper_error(proxyFactory->logHelper, "Proxy: Failed to allocate memory for service.");
         return CELIX_ENOMEM;
     }
-    celix_autofree void **service = (void **)proxy->service;
-    service[0] = proxy;
-    const struct methods_head* list = dynInterface_methods(intfType);
-    struct method_entry *entry = NULL;
-    void (*fn)(void) = NULL;
-    int index = 0;
-    TAILQ_FOREACH(entry, list, entries) {
-        int rc = dynFunction_createClosure(entry->dynFunc, rsaJsonRpcProxy_serviceFunc, entry, &fn);
-        if (rc != 0) {
-            celix_logHelper_error(proxyFactory->logHelper, "Proxy: Failed to create closure for service function %s.",
-                                  dynFunction_getName(entry->dynFunc));
+    const json_rpc_stub_t *stub = rsaJsonRpcStubTracker_findStub(proxyFactory->stubTracker, intfType,
+            celix_bundle_getId(requestingBundle));
+    if (stub != NULL) {
+        //generated stub of the requesting bundle, no libffi closures needed
+        proxy->stubProxy.handle = proxy;
+        proxy->stubProxy.send = rsaJsonRpcProxy_stubSend;
+        service[0] = &proxy->stubProxy;
+        for (size_t i = 0; i < intfMethodNb; ++i) {
+            service[i + 1] = (void *)stub->proxyMethods[i];
+        }
+    } else {
+        service[0] = proxy;
+        //closures are shared by all proxies of the same descriptor, the proxy is retrieved from the service handle
+        status = dfi_createInterfaceClosures(intfType, rsaJsonRpcProxy_serviceFunc, service);
+        if (status != CELIX_SUCCESS) {
+            celix_logHelper_error(proxyFactory->logHelper, "Proxy: Failed to create closures for service %s. %d.",
+                                  proxyFactory->endpointDesc->serviceName, status);
             return CELIX_SERVICE_EXCEPTION;
         }
-        service[++index] = fn;
     }
 
-    celix_steal_ptr(service);
-    celix_steal_ptr(intfType);
+    proxy->service = celix_steal_ptr(service);
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t rsaJsonRpcProxy_create(rsa_json_rpc_proxy_factory_t *proxyFactory,
+        const celix_bundle_t *requestingBundle, rsa_json_rpc_proxy_t **proxyOut) {
+    celix_status_t status = CELIX_SUCCESS;
+    celix_autofree rsa_json_rpc_proxy_t *proxy = calloc(1, sizeof(*proxy));
+    if (proxy == NULL) {
+        return CELIX_ENOMEM;
+    }
+    proxy->proxyFactory = proxyFactory;
+    proxy->useCnt = 0;
+
+    status = dfi_acquireInterfaceDescriptor(proxyFactory->logHelper,
+            proxyFactory->ctx, requestingBundle, proxyFactory->endpointDesc->serviceName, &proxy->intfType);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+
+    status = rsaJsonRpcProxy_initService(proxy, requestingBundle);
+    if (status != CELIX_SUCCESS) {
+        dfi_releaseInterfaceDescriptor(proxy->intfType);
+        return status;
+    }
+
     *proxyOut = celix_steal_ptr(proxy);
 
     return CELIX_SUCCESS;
@@ -375,7 +416,7 @@ static celix_status_t rsaJsonRpcProxy_create(rsa_json_rpc_proxy_factory_t *proxy
 
 static void rsaJsonRpcProxy_destroy(rsa_json_rpc_proxy_t *proxy) {
     free(proxy->service);
-    dynInterface_destroy(proxy->intfType);
+    dfi_releaseInterfaceDescriptor(proxy->intfType);
     free(proxy);
     return;
 }
@@ -25,6 +25,7 @@ extern "C" {
 #endif
 #include "remote_interceptors_handler.h"
 #include "rsa_request_sender_tracker.h"
+#include "rsa_json_rpc_stub_tracker.h"
 #include "endpoint_description.h"
 #include "celix_log_helper.h"
 #include "celix_types.h"
@@ -36,7 +37,8 @@ typedef struct rsa_json_rpc_proxy_factory rsa_json_rpc_proxy_factory_t;
 celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
         FILE *logFile, remote_interceptors_handler_t *interceptorsHandler,
         const endpoint_description_t *endpointDesc, rsa_request_sender_tracker_t *reqSenderTracker,
-        long requestSenderSvcId, unsigned int serialProtoId, rsa_json_rpc_proxy_factory_t **proxyFactoryOut);
+        long requestSenderSvcId, rsa_json_rpc_stub_tracker_t *stubTracker, unsigned int serialProtoId,
+        rsa_json_rpc_proxy_factory_t **proxyFactoryOut);
 
 void rsaJsonRpcProxy_factoryDestroy(rsa_json_rpc_proxy_factory_t *proxyFactory);
 
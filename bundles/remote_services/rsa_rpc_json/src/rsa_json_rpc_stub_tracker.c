@@ -0,0 +1,174 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "rsa_json_rpc_stub_tracker.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_string_hash_map.h"
+#include "celix_threads.h"
+#include "celix_constants.h"
+#include "celix_bundle_context.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+struct rsa_json_rpc_stub_tracker {
+    celix_bundle_context_t *ctx;
+    celix_log_helper_t *logHelper;
+    long stubTrkId;
+    celix_thread_rwlock_t lock;//projects below
+    celix_string_hash_map_t *stubs;//Key:"<interface name>:<interface version>:<bundle id>", Value:json_rpc_stub_t*
+};
+
+static void rsaJsonRpcStubTracker_addServiceWithProperties(void *handle, void *svc,
+        const celix_properties_t *props);
+static void rsaJsonRpcStubTracker_removeServiceWithProperties(void *handle, void *svc,
+        const celix_properties_t *props);
+
+celix_status_t rsaJsonRpcStubTracker_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
+        rsa_json_rpc_stub_tracker_t **trackerOut) {
+    celix_status_t status = CELIX_SUCCESS;
+    if (ctx == NULL || logHelper == NULL || trackerOut == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_autofree rsa_json_rpc_stub_tracker_t *tracker = calloc(1, sizeof(*tracker));
+    if (tracker == NULL) {
+        return CELIX_ENOMEM;
+    }
+    tracker->ctx = ctx;
+    tracker->logHelper = logHelper;
+    status = celixThreadRwlock_create(&tracker->lock, NULL);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    celix_autoptr(celix_thread_rwlock_t) lock = &tracker->lock;
+    celix_autoptr(celix_string_hash_map_t) stubs = tracker->stubs = celix_stringHashMap_create();
+    if (tracker->stubs == NULL) {
+        return CELIX_ENOMEM;
+    }
+    celix_service_tracking_options_t opts = CELIX_EMPTY_SERVICE_TRACKING_OPTIONS;
+    opts.filter.serviceName = JSON_RPC_STUB_SERVICE_NAME;
+    opts.callbackHandle = tracker;
+    opts.addWithProperties = rsaJsonRpcStubTracker_addServiceWithProperties;
+    opts.removeWithProperties = rsaJsonRpcStubTracker_removeServiceWithProperties;
+    tracker->stubTrkId = celix_bundleContext_trackServicesWithOptionsAsync(ctx, &opts);
+    if (tracker->stubTrkId < 0) {
+        celix_logHelper_error(tracker->logHelper, "Error tracking json rpc stub service.");
+        return CELIX_SERVICE_EXCEPTION;
+    }
+    celix_steal_ptr(stubs);
+    celix_steal_ptr(lock);
+    *trackerOut = celix_steal_ptr(tracker);
+    return CELIX_SUCCESS;
+}
+
+static char* rsaJsonRpcStubTracker_createKey(const char *intfName, const char *intfVersion, long bundleId) {
+    char *key = NULL;
+    if (asprintf(&key, "%s:%s:%ld", intfName, intfVersion, bundleId) < 0) {
+        return NULL;
+    }
+    return key;
+}
+
+static char* rsaJsonRpcStubTracker_createKeyFromProperties(rsa_json_rpc_stub_tracker_t *tracker, void *svc,
+        const celix_properties_t *props) {
+    const json_rpc_stub_t *stub = svc;
+    const char *intfName = celix_properties_get(props, JSON_RPC_STUB_INTERFACE_NAME, stub->interfaceName);
+    const char *intfVersion = celix_properties_get(props, JSON_RPC_STUB_INTERFACE_VERSION, stub->interfaceVersion);
+    long bundleId = celix_properties_getAsLong(props, CELIX_FRAMEWORK_SERVICE_BUNDLE_ID, -1);
+    if (intfName == NULL || intfVersion == NULL || bundleId < 0) {
+        celix_logHelper_error(tracker->logHelper, "Error getting interface name, version or bundle id of json rpc stub.");
+        return NULL;
+    }
+    char *key = rsaJsonRpcStubTracker_createKey(intfName, intfVersion, bundleId);
+    if (key == NULL) {
+        celix_logHelper_error(tracker->logHelper, "Error creating key for json rpc stub %s.", intfName);
+    }
+    return key;
+}
+
+static void rsaJsonRpcStubTracker_addServiceWithProperties(void *handle, void *svc,
+        const celix_properties_t *props) {
+    assert(handle != NULL);
+    assert(svc != NULL);
+    assert(props != NULL);
+    rsa_json_rpc_stub_tracker_t *tracker = (rsa_json_rpc_stub_tracker_t *)handle;
+    celix_autofree char *key = rsaJsonRpcStubTracker_createKeyFromProperties(tracker, svc, props);
+    if (key == NULL) {
+        return;
+    }
+    celixThreadRwlock_writeLock(&tracker->lock);
+    if (!celix_stringHashMap_hasKey(tracker->stubs, key)) {
+        (void)celix_stringHashMap_put(tracker->stubs, key, svc);
+    }
+    celixThreadRwlock_unlock(&tracker->lock);
+    return;
+}
+
+static void rsaJsonRpcStubTracker_removeServiceWithProperties(void *handle, void *svc,
+        const celix_properties_t *props) {
+    assert(handle != NULL);
+    assert(svc != NULL);
+    assert(props != NULL);
+    rsa_json_rpc_stub_tracker_t *tracker = (rsa_json_rpc_stub_tracker_t *)handle;
+    celix_autofree char *key = rsaJsonRpcStubTracker_createKeyFromProperties(tracker, svc, props);
+    if (key == NULL) {
+        return;
+    }
+    celixThreadRwlock_writeLock(&tracker->lock);
+    if (celix_stringHashMap_get(tracker->stubs, key) == svc) {
+        (void)celix_stringHashMap_remove(tracker->stubs, key);
+    }
+    celixThreadRwlock_unlock(&tracker->lock);
+    return;
+}
+
+static void rsaJsonRpcStubTracker_stopDone(void *data) {
+    assert(data != NULL);
+    rsa_json_rpc_stub_tracker_t *tracker = (rsa_json_rpc_stub_tracker_t *)data;
+    assert(celix_stringHashMap_size(tracker->stubs) == 0);
+    celix_stringHashMap_destroy(tracker->stubs);
+    (void)celixThreadRwlock_destroy(&tracker->lock);
+    free(tracker);
+    return;
+}
+
+void rsaJsonRpcStubTracker_destroy(rsa_json_rpc_stub_tracker_t *tracker) {
+    if (tracker != NULL) {
+        celix_bundleContext_stopTrackerAsync(tracker->ctx, tracker->stubTrkId, tracker, rsaJsonRpcStubTracker_stopDone);
+    }
+    return;
+}
+
+const json_rpc_stub_t* rsaJsonRpcStubTracker_findStub(rsa_json_rpc_stub_tracker_t *tracker,
+        const dyn_interface_type *intf, long bundleId) {
+    celix_autofree char *key = rsaJsonRpcStubTracker_createKey(dynInterface_getName(intf),
+            dynInterface_getVersionString(intf), bundleId);
+    if (key == NULL) {
+        return NULL;
+    }
+    celixThreadRwlock_readLock(&tracker->lock);
+    const json_rpc_stub_t *stub = celix_stringHashMap_get(tracker->stubs, key);
+    celixThreadRwlock_unlock(&tracker->lock);
+    if (stub != NULL && stub->nrOfMethods != (size_t)dynInterface_nrOfMethods(intf)) {
+        celix_logHelper_warning(tracker->logHelper, "Ignoring json rpc stub for %s, the number of methods does not match the descriptor.",
+                dynInterface_getName(intf));
+        return NULL;
+    }
+    return stub;
+}
@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _RSA_JSON_RPC_STUB_TRACKER_H_
+#define _RSA_JSON_RPC_STUB_TRACKER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "json_rpc_stub.h"
+#include "dyn_interface.h"
+#include "celix_log_helper.h"
+#include "celix_types.h"
+#include "celix_errno.h"
+
+/**
+ * @brief Tracks the generated JSON-RPC stubs (json_rpc_stub_t services) offered by bundles.
+ */
+typedef struct rsa_json_rpc_stub_tracker rsa_json_rpc_stub_tracker_t;
+
+celix_status_t rsaJsonRpcStubTracker_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
+        rsa_json_rpc_stub_tracker_t **trackerOut);
+
+void rsaJsonRpcStubTracker_destroy(rsa_json_rpc_stub_tracker_t *tracker);
+
+/**
+ * @brief Returns the stub registered by the provided bundle for the interface, or NULL if there is none.
+ *
+ * A stub is generated code and constant data of the registering bundle. It is used as long as a service or proxy of
+ * that bundle uses it and is not bound to the lifetime of the stub service registration.
+ */
+const json_rpc_stub_t* rsaJsonRpcStubTracker_findStub(rsa_json_rpc_stub_tracker_t *tracker,
+        const dyn_interface_type *intf, long bundleId);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RSA_JSON_RPC_STUB_TRACKER_H_ */
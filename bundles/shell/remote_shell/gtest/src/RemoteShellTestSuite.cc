@@ -0,0 +1,262 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "celix_bundle_context.h"
+#include "celix_constants.h"
+#include "celix_framework_factory.h"
+#include "celix_framework_utils.h"
+#include "celix_shell_command.h"
+
+class RemoteShellTestSuite : public ::testing::Test {
+public:
+    static constexpr int REMOTE_SHELL_TEST_PORT = 36666;
+    static constexpr int NR_OF_CLIENTS = 250;
+    static constexpr const char* PROMPT = "-> ";
+
+    RemoteShellTestSuite() : ctx{createFrameworkContext()} {
+        auto* fw = celix_bundleContext_getFramework(ctx.get());
+        size_t nr = celix_framework_utils_installBundleSet(fw, TEST_BUNDLES, true);
+        EXPECT_EQ(nr, 2); //shell and remote shell bundle
+    }
+
+    static std::shared_ptr<celix_bundle_context_t> createFrameworkContext() {
+        auto properties = celix_properties_create();
+        celix_properties_set(properties, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+        celix_properties_set(properties, CELIX_FRAMEWORK_CACHE_DIR, ".cacheRemoteShellTestSuite");
+        celix_properties_setLong(properties, "remote.shell.telnet.port", REMOTE_SHELL_TEST_PORT);
+        celix_properties_setLong(properties, "remote.shell.telnet.maxconn", NR_OF_CLIENTS + 10);
+        celix_properties_setLong(properties, "remote.shell.telnet.workers", 4);
+
+        auto* cFw = celix_frameworkFactory_createFramework(properties);
+        auto cCtx = celix_framework_getFrameworkContext(cFw);
+
+        return std::shared_ptr<celix_bundle_context_t>{cCtx, [](celix_bundle_context_t* context) {
+            auto *fw = celix_bundleContext_getFramework(context);
+            celix_frameworkFactory_destroyFramework(fw);
+        }};
+    }
+
+    /**
+     * @brief A remote shell test client, with a buffer for received but not yet consumed output.
+     */
+    struct Client {
+        int fd{-1};
+        std::string received{};
+    };
+
+    static Client connectClient() {
+        Client client{};
+        client.fd = socket(AF_INET, SOCK_STREAM, 0);
+        EXPECT_GE(client.fd, 0);
+        struct timeval timeout{5, 0};
+        setsockopt(client.fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        struct sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(REMOTE_SHELL_TEST_PORT);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        int rc = connect(client.fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+        EXPECT_EQ(rc, 0) << "Cannot connect to remote shell: " << strerror(errno);
+        return client;
+    }
+
+    static void sendLine(const Client& client, const std::string& line) {
+        std::string data = line + "\r\n";
+        auto written = send(client.fd, data.c_str(), data.size(), MSG_NOSIGNAL);
+        EXPECT_EQ(written, static_cast<ssize_t>(data.size()));
+    }
+
+    /**
+     * @brief Returns the output up to and including the next prompt or - if the connection is closed - the
+     * remaining output.
+     */
+    static std::string readUntilPromptOrClosed(Client& client) {
+        char buf[512];
+        auto pos = client.received.find(PROMPT);
+        while (pos == std::string::npos) {
+            auto len = recv(client.fd, buf, sizeof(buf), 0);
+            if (len <= 0) {
+                break;
+            }
+            client.received.append(buf, static_cast<size_t>(len));
+            pos = client.received.find(PROMPT);
+        }
+        auto end = pos == std::string::npos ? client.received.size() : pos + strlen(PROMPT);
+        auto output = client.received.substr(0, end);
+        client.received.erase(0, end);
+        return output;
+    }
+
+    std::shared_ptr<celix_bundle_context_t> ctx;
+};
+
+TEST_F(RemoteShellTestSuite, ExecuteCommandTest) {
+    // Given a connected remote shell client which received the welcome message
+    auto client = connectClient();
+    auto welcome = readUntilPromptOrClosed(client);
+    EXPECT_NE(welcome.find("Apache Celix Remote Shell"), std::string::npos);
+
+    // When the help command is executed
+    sendLine(client, "help");
+
+    // Then the output contains the available commands
+    auto output = readUntilPromptOrClosed(client);
+    EXPECT_NE(output.find("lb"), std::string::npos);
+
+    // When the exit command is send
+    sendLine(client, "exit");
+
+    // Then the remote shell says goodbye and closes the connection
+    output = readUntilPromptOrClosed(client);
+    EXPECT_NE(output.find("Goodbye!"), std::string::npos);
+    close(client.fd);
+}
+
+TEST_F(RemoteShellTestSuite, HalfClosedConnectionTest) {
+    // Given a connected remote shell client which received the welcome message
+    auto client = connectClient();
+    readUntilPromptOrClosed(client);
+
+    // When a command - without trailing newline - is send and the write side of the connection is closed
+    send(client.fd, "help", 4, MSG_NOSIGNAL);
+    shutdown(client.fd, SHUT_WR);
+
+    // Then the command output is still received, before the connection is closed by the remote shell
+    std::string output{};
+    char buf[512];
+    ssize_t len;
+    while ((len = recv(client.fd, buf, sizeof(buf), 0)) > 0) {
+        output.append(buf, static_cast<size_t>(len));
+    }
+    EXPECT_EQ(len, 0); //closed, not a receive timeout
+    EXPECT_NE(output.find("lb"), std::string::npos);
+    close(client.fd);
+}
+
+TEST_F(RemoteShellTestSuite, ManyConcurrentClientsTest) {
+    // Given many connected remote shell clients
+    std::vector<Client> clients{};
+    for (int i = 0; i < NR_OF_CLIENTS; ++i) {
+        clients.push_back(connectClient());
+        auto welcome = readUntilPromptOrClosed(clients.back());
+        ASSERT_NE(welcome.find("Apache Celix Remote Shell"), std::string::npos) << "client " << i;
+    }
+
+    // When all clients send multiple commands, before reading any output
+    for (const auto& client : clients) {
+        sendLine(client, "help");
+        sendLine(client, "lb");
+    }
+
+    // Then all clients receive the output of both commands
+    for (size_t i = 0; i < clients.size(); ++i) {
+        auto help = readUntilPromptOrClosed(clients[i]);
+        EXPECT_NE(help.find("lb"), std::string::npos) << "client " << i;
+        auto lb = readUntilPromptOrClosed(clients[i]);
+        EXPECT_NE(lb.find("Bundles:"), std::string::npos) << "client " << i;
+    }
+
+    // And all clients can disconnect
+    for (const auto& client : clients) {
+        sendLine(client, "exit");
+    }
+    for (auto& client : clients) {
+        auto output = readUntilPromptOrClosed(client);
+        EXPECT_NE(output.find("Goodbye!"), std::string::npos);
+        close(client.fd);
+    }
+}
+
+TEST_F(RemoteShellTestSuite, MaximumConnectionsTest) {
+    // Given the maximum number of connected clients
+    std::vector<Client> clients{};
+    for (int i = 0; i < NR_OF_CLIENTS + 10; ++i) {
+        clients.push_back(connectClient());
+        readUntilPromptOrClosed(clients.back());
+    }
+
+    // When another client connects
+    auto client = connectClient();
+
+    // Then the client is disconnected, because the maximum number of connections is reached
+    auto output = readUntilPromptOrClosed(client);
+    EXPECT_NE(output.find("Maximum number of connections"), std::string::npos);
+    close(client.fd);
+
+    for (const auto& c : clients) {
+        close(c.fd);
+    }
+}
+
+TEST_F(RemoteShellTestSuite, SlowClientIsDisconnectedTest) {
+    // Given a command which produces a lot of output
+    celix_shell_command_t floodCmd{};
+    floodCmd.executeCommand = [](void*, const char*, FILE* out, FILE*) -> bool {
+        std::string line(1023, 'x');
+        for (int i = 0; i < 32 * 1024; ++i) { //32MB
+            fprintf(out, "%s\n", line.c_str());
+        }
+        return true;
+    };
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, CELIX_SHELL_COMMAND_NAME, "test::flood");
+    long svcId = celix_bundleContext_registerService(ctx.get(), &floodCmd, CELIX_SHELL_COMMAND_SERVICE_NAME, props);
+
+    // And a connected remote shell client with a small receive buffer
+    auto client = connectClient();
+    int rcvBufSize = 4096;
+    setsockopt(client.fd, SOL_SOCKET, SO_RCVBUF, &rcvBufSize, sizeof(rcvBufSize));
+    readUntilPromptOrClosed(client);
+
+    // When the command is executed and the client does not read the output
+    sendLine(client, "flood");
+    std::this_thread::sleep_for(std::chrono::seconds{1});
+
+    // Then the remote shell drops the client, instead of buffering all output
+    size_t received = 0;
+    char buf[4096];
+    ssize_t len;
+    while ((len = recv(client.fd, buf, sizeof(buf), 0)) > 0) {
+        received += static_cast<size_t>(len);
+    }
+    EXPECT_TRUE(len == 0 || errno == ECONNRESET) << strerror(errno); //closed, not a receive timeout
+    EXPECT_LT(received, 32u * 1024u * 1024u);
+    close(client.fd);
+
+    // And other clients can still use the remote shell
+    auto other = connectClient();
+    readUntilPromptOrClosed(other);
+    sendLine(other, "help");
+    auto output = readUntilPromptOrClosed(other);
+    EXPECT_NE(output.find("lb"), std::string::npos);
+    close(other.fd);
+
+    celix_bundleContext_unregisterService(ctx.get(), svcId);
+}
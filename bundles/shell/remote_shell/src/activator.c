@@ -42,6 +42,9 @@
 #define REMOTE_SHELL_TELNET_MAXCONN_PROPERTY_NAME 	"remote.shell.telnet.maxconn"
 #define DEFAULT_REMOTE_SHELL_TELNET_MAXCONN 		2
 
+#define REMOTE_SHELL_TELNET_WORKERS_PROPERTY_NAME 	"remote.shell.telnet.workers"
+#define DEFAULT_REMOTE_SHELL_TELNET_WORKERS 		2
+
 struct bundle_instance {
 	celix_log_helper_t *loghelper;
 	shell_mediator_pt shellMediator;
@@ -53,6 +56,7 @@ typedef struct bundle_instance *bundle_instance_pt;
 
 static int bundleActivator_getPort(bundle_instance_pt bi, bundle_context_pt context);
 static int bundleActivator_getMaximumConnections(bundle_instance_pt bi, bundle_context_pt context);
+static int bundleActivator_getNrOfWorkers(bundle_instance_pt bi, bundle_context_pt context);
 static int bundleActivator_getProperty(bundle_instance_pt bi, bundle_context_pt context, char * propertyName, int defaultValue);
 
 celix_status_t bundleActivator_create(bundle_context_pt context, void **userData) {
@@ -86,9 +90,10 @@ celix_status_t bundleActivator_start(void * userData, bundle_context_pt context)
 
 	int port = bundleActivator_getPort(bi, context);
 	int maxConn = bundleActivator_getMaximumConnections(bi, context);
+	int nrOfWorkers = bundleActivator_getNrOfWorkers(bi, context);
 
 	status = CELIX_DO_IF(status, shellMediator_create(context, &bi->shellMediator));
-	status = CELIX_DO_IF(status, remoteShell_create(bi->shellMediator, maxConn, &bi->remoteShell));
+	status = CELIX_DO_IF(status, remoteShell_create(bi->shellMediator, maxConn, nrOfWorkers, &bi->remoteShell));
 	status = CELIX_DO_IF(status, connectionListener_create(bi->remoteShell, port, &bi->connectionListener));
 	status = CELIX_DO_IF(status, connectionListener_start(bi->connectionListener));
 
@@ -100,10 +105,16 @@ celix_status_t bundleActivator_stop(void * userData, bundle_context_pt context)
 	bundle_instance_pt bi = (bundle_instance_pt) userData;
 
 	connectionListener_stop(bi->connectionListener);
+	connectionListener_destroy(bi->connectionListener);
+	bi->connectionListener = NULL;
+
+	//note stops the command workers before the shell mediator is destroyed
+	remoteShell_destroy(bi->remoteShell);
+	bi->remoteShell = NULL;
+
 	shellMediator_stop(bi->shellMediator);
 	shellMediator_destroy(bi->shellMediator);
-
-	remoteShell_stopConnections(bi->remoteShell);
+	bi->shellMediator = NULL;
 
 	return status;
 }
@@ -112,8 +123,8 @@ celix_status_t bundleActivator_destroy(void * userData, bundle_context_pt contex
 	celix_status_t status = CELIX_SUCCESS;
 	bundle_instance_pt bi = (bundle_instance_pt) userData;
 
-	connectionListener_destroy(bi->connectionListener);
 	celix_logHelper_destroy(bi->loghelper);
+	free(bi);
 
 	return status;
 }
@@ -126,6 +137,10 @@ static int bundleActivator_getMaximumConnections(bundle_instance_pt bi, bundle_c
 	return bundleActivator_getProperty(bi, context, REMOTE_SHELL_TELNET_MAXCONN_PROPERTY_NAME, DEFAULT_REMOTE_SHELL_TELNET_MAXCONN);
 }
 
+static int bundleActivator_getNrOfWorkers(bundle_instance_pt bi, bundle_context_pt context) {
+	return bundleActivator_getProperty(bi, context, REMOTE_SHELL_TELNET_WORKERS_PROPERTY_NAME, DEFAULT_REMOTE_SHELL_TELNET_WORKERS);
+}
+
 static int bundleActivator_getProperty(bundle_instance_pt bi, bundle_context_pt context, char* propertyName, int defaultValue) {
 	int value;
 	const char* strValue = celix_bundleContext_getProperty(context, propertyName, NULL);
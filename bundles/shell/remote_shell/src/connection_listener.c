@@ -32,6 +32,8 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <netdb.h>
@@ -44,7 +46,7 @@
 #include "shell_mediator.h"
 #include "remote_shell.h"
 
-#define CONNECTION_LISTENER_TIMEOUT_SEC        5
+#define CONNECTION_LISTENER_MAX_EVENTS        64
 
 struct connection_listener {
     //constant
@@ -56,10 +58,13 @@ struct connection_listener {
     //protected by mutex
     bool running;
     celix_thread_t thread;
-    fd_set pollset;
+    int listenSocket;
+    int stopEventFd; //eventfd used to wake up and stop the event loop
 };
 
 static void* connection_listener_thread(void *data);
+static celix_status_t connectionListener_createListenSocket(connection_listener_pt instance);
+static void connectionListener_acceptConnections(connection_listener_pt instance);
 
 celix_status_t connectionListener_create(remote_shell_pt remoteShell, int port, connection_listener_pt *instance) {
     celix_status_t status = CELIX_SUCCESS;
@@ -70,8 +75,8 @@ celix_status_t connectionListener_create(remote_shell_pt remoteShell, int port,
         (*instance)->remoteShell = remoteShell;
         (*instance)->running = false;
         (*instance)->loghelper = remoteShell->loghelper;
-
-        FD_ZERO(&(*instance)-> pollset);
+        (*instance)->listenSocket = -1;
+        (*instance)->stopEventFd = -1;
 
         status = celixThreadMutex_create(&(*instance)->mutex, NULL);
     } else {
@@ -81,8 +86,38 @@ celix_status_t connectionListener_create(remote_shell_pt remoteShell, int port,
 }
 
 celix_status_t connectionListener_start(connection_listener_pt instance) {
-    celix_status_t status = CELIX_SUCCESS;
+    celix_status_t status = connectionListener_createListenSocket(instance);
+    if (status != CELIX_SUCCESS) {
+        //note error already logged, the remote shell bundle is still started (without accepting connections)
+        return CELIX_SUCCESS;
+    }
+
+    int epollFd = instance->remoteShell->epollFd;
+    instance->stopEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.ptr = &instance->listenSocket;
+    if (instance->stopEventFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, instance->listenSocket, &event) != 0) {
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    }
+    event.data.ptr = &instance->stopEventFd;
+    if (status == CELIX_SUCCESS && epoll_ctl(epollFd, EPOLL_CTL_ADD, instance->stopEventFd, &event) != 0) {
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    }
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_ERROR, "Cannot setup remote shell event loop: %s", strerror(errno));
+        close(instance->listenSocket);
+        instance->listenSocket = -1;
+        if (instance->stopEventFd >= 0) {
+            close(instance->stopEventFd);
+            instance->stopEventFd = -1;
+        }
+        return status;
+    }
+
     celixThreadMutex_lock(&instance->mutex);
+    instance->running = true;
     celixThread_create(&instance->thread, NULL, connection_listener_thread, instance);
     celixThreadMutex_unlock(&instance->mutex);
     return status;
@@ -90,37 +125,45 @@ celix_status_t connectionListener_start(connection_listener_pt instance) {
 
 celix_status_t connectionListener_stop(connection_listener_pt instance) {
     celix_status_t status = CELIX_SUCCESS;
-    celix_thread_t thread;
-    fd_set pollset;
-
-    instance->running = false;
-    FD_ZERO(&pollset);
 
     celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_INFO, "CONNECTION_LISTENER: Stopping thread\n");
 
     celixThreadMutex_lock(&instance->mutex);
-    thread = instance->thread;
-
-    pollset = instance->pollset;
+    bool running = instance->running;
+    instance->running = false;
+    celix_thread_t thread = instance->thread;
     celixThreadMutex_unlock(&instance->mutex);
 
-    celixThread_join(thread, NULL);
+    if (running) {
+        uint64_t one = 1;
+        ssize_t written = write(instance->stopEventFd, &one, sizeof(one));
+        (void)written;
+        celixThread_join(thread, NULL);
+    }
+
+    if (instance->listenSocket >= 0) {
+        epoll_ctl(instance->remoteShell->epollFd, EPOLL_CTL_DEL, instance->listenSocket, NULL);
+        close(instance->listenSocket);
+        instance->listenSocket = -1;
+    }
+    if (instance->stopEventFd >= 0) {
+        epoll_ctl(instance->remoteShell->epollFd, EPOLL_CTL_DEL, instance->stopEventFd, NULL);
+        close(instance->stopEventFd);
+        instance->stopEventFd = -1;
+    }
     return status;
 }
 
 celix_status_t connectionListener_destroy(connection_listener_pt instance) {
+    celixThreadMutex_destroy(&instance->mutex);
     free(instance);
 
     return CELIX_SUCCESS;
 }
 
-static void* connection_listener_thread(void *data) {
+static celix_status_t connectionListener_createListenSocket(connection_listener_pt instance) {
     celix_status_t status = CELIX_BUNDLE_EXCEPTION;
-    connection_listener_pt instance = data;
-    struct timeval timeout; /* Timeout for select */
-    fd_set active_fd_set;
-    FD_ZERO(&active_fd_set);
-    int listenSocket = 0;
+    int listenSocket = -1;
     int on = 1;
 
     struct addrinfo *result, *rp;
@@ -138,14 +181,17 @@ static void* connection_listener_thread(void *data) {
     char portStr[10];
     snprintf(&portStr[0], 10, "%d", instance->port);
 
-    getaddrinfo(NULL, portStr, &hints, &result);
+    if (getaddrinfo(NULL, portStr, &hints, &result) != 0) {
+        celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_ERROR, "Cannot resolve address for port %d", instance->port);
+        return status;
+    }
 
     for (rp = result; rp != NULL && status == CELIX_BUNDLE_EXCEPTION; rp = rp->ai_next) {
 
         status = CELIX_BUNDLE_EXCEPTION;
 
-        /* Create socket */
-        listenSocket = socket(rp->ai_family, rp->ai_socktype, rp->ai_protocol);
+        /* Create non-blocking socket */
+        listenSocket = socket(rp->ai_family, rp->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, rp->ai_protocol);
         if (listenSocket < 0) {
             celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_ERROR, "Error creating socket: %s", strerror(errno));
         }
@@ -155,66 +201,69 @@ static void* connection_listener_thread(void *data) {
         else if (bind(listenSocket, rp->ai_addr, rp->ai_addrlen) < 0) {
             celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_ERROR, "cannot bind: %s", strerror(errno));
         }
-        else if (listen(listenSocket, 5) < 0) {
+        else if (listen(listenSocket, SOMAXCONN) < 0) {
             celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_ERROR, "listen failed: %s", strerror(errno));
         }
         else {
             status = CELIX_SUCCESS;
         }
+
+        if (status != CELIX_SUCCESS && listenSocket >= 0) {
+            close(listenSocket);
+            listenSocket = -1;
+        }
     }
 
-    if (status == CELIX_SUCCESS) {
+    freeaddrinfo(result);
 
+    if (status == CELIX_SUCCESS) {
         celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_INFO, "Remote Shell accepting connections on port %d", instance->port);
+        instance->listenSocket = listenSocket;
+    }
+    return status;
+}
 
-        celixThreadMutex_lock(&instance->mutex);
-        instance->pollset = active_fd_set;
-        celixThreadMutex_unlock(&instance->mutex);
-
-        instance->running = true;
-
-        while (status == CELIX_SUCCESS && instance->running) {
-            int selectRet = -1;
-            do {
-                timeout.tv_sec = CONNECTION_LISTENER_TIMEOUT_SEC;
-                timeout.tv_usec = 0;
-
-                FD_ZERO(&active_fd_set);
-                FD_SET(listenSocket, &active_fd_set);
-
-                selectRet = select(listenSocket + 1, &active_fd_set, NULL, NULL, &timeout);
-            } while (selectRet == -1 && errno == EINTR && instance->running == true);
-            if (selectRet < 0) {
-                celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_ERROR, "select on listenSocket failed: %s", strerror(errno));
-                status = CELIX_BUNDLE_EXCEPTION;
-            }
-            else if (selectRet == 0) {
-                /* do nothing here */
+static void connectionListener_acceptConnections(connection_listener_pt instance) {
+    while (true) {
+        int acceptedSocket = accept4(instance->listenSocket, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (acceptedSocket < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_ERROR, "REMOTE_SHELL: accept failed: %s.", strerror(errno));
             }
-            else if (FD_ISSET(listenSocket, &active_fd_set)) {
-                int acceptedSocket = accept(listenSocket, NULL, NULL);
-
-                if (acceptedSocket < 0) {
-                    celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_ERROR, "REMOTE_SHELL: accept failed: %s.", strerror(errno));
-                    status = CELIX_BUNDLE_EXCEPTION;
-                }
-                else {
-                    celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_INFO, "REMOTE_SHELL: connection established.");
-                    remoteShell_addConnection(instance->remoteShell, acceptedSocket);
-                }
-            }
-            else {
-                celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_DEBUG, "REMOTE_SHELL: received data on a not-expected file-descriptor?");
+            if (errno != EINTR) {
+                break;
             }
+            continue;
         }
+        celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_DEBUG, "REMOTE_SHELL: connection established.");
+        remoteShell_addConnection(instance->remoteShell, acceptedSocket);
     }
+}
 
-    if (listenSocket >= 0) {
-        close(listenSocket);
+static void* connection_listener_thread(void *data) {
+    connection_listener_pt instance = data;
+    struct epoll_event events[CONNECTION_LISTENER_MAX_EVENTS];
+
+    bool running = true;
+    while (running) {
+        int nrOfEvents = epoll_wait(instance->remoteShell->epollFd, events, CONNECTION_LISTENER_MAX_EVENTS, -1);
+        if (nrOfEvents < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_ERROR, "epoll_wait failed: %s", strerror(errno));
+            break;
+        }
+        for (int i = 0; i < nrOfEvents; ++i) {
+            if (events[i].data.ptr == &instance->stopEventFd) {
+                running = false;
+            } else if (events[i].data.ptr == &instance->listenSocket) {
+                connectionListener_acceptConnections(instance);
+            } else {
+                remoteShell_connection_handleEvents(events[i].data.ptr, events[i].events);
+            }
+        }
     }
 
-    freeaddrinfo(result);
-
     return NULL;
 }
-
@@ -26,8 +26,10 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
 #include <unistd.h>
 #include <utils.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 
 #include "celix_log_helper.h"
@@ -37,51 +39,82 @@
 #include "remote_shell.h"
 
 #define COMMAND_BUFF_SIZE (256)
+#define MAX_OUTPUT_BUFF_SIZE (1024 * 1024) //max buffered output per connection, slower clients are disconnected
 
 #define RS_PROMPT ("-> ")
 #define RS_WELCOME ("\n---- Apache Celix Remote Shell ----\n---- Type exit to disconnect   ----\n\n-> ")
 #define RS_GOODBYE ("Goodbye!\n")
 #define RS_ERROR ("Error executing command!\n")
+#define RS_COMMAND_TOO_LONG ("Command too long!\n")
 #define RS_MAXIMUM_CONNECTIONS_REACHED ("Maximum number of connections  reached. Disconnecting ...\n")
 
-#define CONNECTION_LISTENER_TIMEOUT_SEC		5
-
-
-
 struct connection {
 	remote_shell_pt parent;
-	FILE *socketStream;
-	fd_set pollset;
-	bool threadRunning;
+	int fd;
+
+	//protected by parent->mutex
+	int refCount; //event loop reference + pending/in progress command reference
+	bool closed;
+	bool inputClosed; //peer shutdown the write side of the connection
+	bool closeAfterFlush; //close connection when all output is written (exit command or input closed)
+	bool commandInProgress; //only one command per connection is executed at the same time
+	bool outputOverflow; //client did not keep up with the output, further output is discarded
+	uint32_t epollEvents; //the currently configured epoll events
+	char* command; //command to execute by a worker, owned by the connection
+
+	char inBuf[COMMAND_BUFF_SIZE];
+	size_t inLen;
+
+	char* outBuf;
+	size_t outLen;
+	size_t outCap;
 };
 
-typedef struct connection *connection_pt;
+static void remoteShell_connection_release(connection_pt connection);
+static void remoteShell_connection_close(connection_pt connection);
+static void remoteShell_connection_append(connection_pt connection, const char* text, size_t len);
+static void remoteShell_connection_print(connection_pt connection, const char* text);
+static void remoteShell_connection_flush(connection_pt connection);
+static void remoteShell_connection_processInput(connection_pt connection);
+static void* remoteShell_worker_run(void *data);
+static ssize_t remoteShell_connection_streamWrite(void *cookie, const char *buf, size_t size);
 
-static celix_status_t remoteShell_connection_print(connection_pt connection, char * text);
-static celix_status_t remoteShell_connection_execute(connection_pt connection, char *command);
-static void* remoteShell_connection_run(void *data);
-
-celix_status_t remoteShell_create(shell_mediator_pt mediator, int maximumConnections, remote_shell_pt* instance) {
+celix_status_t remoteShell_create(shell_mediator_pt mediator, int maximumConnections, int nrOfWorkers, remote_shell_pt* instance) {
     celix_status_t status = CELIX_SUCCESS;
     (*instance) = calloc(1, sizeof(**instance));
-    if ((*instance) != NULL) {
-        (*instance)->mediator = mediator;
-        (*instance)->maximumConnections = maximumConnections;
-        (*instance)->connections = NULL;
-        (*instance)->loghelper = &mediator->loghelper;
-
-        status = celixThreadMutex_create(&(*instance)->mutex, NULL);
-
-        if (status == CELIX_SUCCESS) {
-            (*instance)->connections = celix_arrayList_create();
-            if (!(*instance)->connections) {
-                free(*instance);
-                (*instance) = NULL;
-                status = CELIX_ENOMEM;
-            }
+    if ((*instance) == NULL) {
+        return CELIX_ENOMEM;
+    }
+    remote_shell_pt rs = *instance;
+    rs->mediator = mediator;
+    rs->maximumConnections = maximumConnections;
+    rs->nrOfWorkers = nrOfWorkers > 0 ? nrOfWorkers : 1;
+    rs->loghelper = &mediator->loghelper;
+    rs->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    rs->connections = celix_arrayList_create();
+    rs->pendingCommands = celix_arrayList_create();
+    rs->workers = calloc(rs->nrOfWorkers, sizeof(*rs->workers));
+
+    if (rs->epollFd < 0 || !rs->connections || !rs->pendingCommands || !rs->workers) {
+        status = rs->epollFd < 0 ? CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno) : CELIX_ENOMEM;
+    }
+    status = CELIX_DO_IF(status, celixThreadMutex_create(&rs->mutex, NULL));
+    status = CELIX_DO_IF(status, celixThreadCondition_init(&rs->cond, NULL));
+
+    if (status == CELIX_SUCCESS) {
+        rs->workersRunning = true;
+        for (int i = 0; i < rs->nrOfWorkers; ++i) {
+            celixThread_create(&rs->workers[i], NULL, remoteShell_worker_run, rs);
         }
     } else {
-        status = CELIX_ENOMEM;
+        if (rs->epollFd >= 0) {
+            close(rs->epollFd);
+        }
+        celix_arrayList_destroy(rs->connections);
+        celix_arrayList_destroy(rs->pendingCommands);
+        free(rs->workers);
+        free(rs);
+        (*instance) = NULL;
     }
     return status;
 }
@@ -91,156 +124,339 @@ celix_status_t remoteShell_destroy(remote_shell_pt instance) {
 
 	remoteShell_stopConnections(instance);
 
-	celixThreadMutex_lock(&instance->mutex);
-        celix_arrayList_destroy(instance->connections);
-	celixThreadMutex_unlock(&instance->mutex);
+	celix_arrayList_destroy(instance->connections);
+	celix_arrayList_destroy(instance->pendingCommands);
+	free(instance->workers);
+	close(instance->epollFd);
+	celixThreadCondition_destroy(&instance->cond);
+	celixThreadMutex_destroy(&instance->mutex);
+	free(instance);
 
 	return status;
 }
 
 celix_status_t remoteShell_addConnection(remote_shell_pt instance, int socket) {
-	celix_status_t status = CELIX_SUCCESS;
-	connection_pt connection = calloc(1, sizeof(struct connection));
-
-	if (connection != NULL) {
-		connection->parent = instance;
-		connection->threadRunning = false;
-		connection->socketStream = fdopen(socket, "w");
-
-		if (connection->socketStream != NULL) {
-
-			celixThreadMutex_lock(&instance->mutex);
-
-			if (celix_arrayList_size(instance->connections) < instance->maximumConnections) {
-				celix_thread_t connectionRunThread = celix_thread_default;
-                                celix_arrayList_add(instance->connections, connection);
-				status = celixThread_create(&connectionRunThread, NULL, &remoteShell_connection_run, connection);
-			} else {
-				status = CELIX_BUNDLE_EXCEPTION;
-				remoteShell_connection_print(connection, RS_MAXIMUM_CONNECTIONS_REACHED);
-			}
-			celixThreadMutex_unlock(&instance->mutex);
-
-		} else {
-			status = CELIX_BUNDLE_EXCEPTION;
-		}
-	} else {
-		status = CELIX_ENOMEM;
+	celixThreadMutex_lock(&instance->mutex);
+	if (celix_arrayList_size(instance->connections) >= instance->maximumConnections) {
+		celixThreadMutex_unlock(&instance->mutex);
+		send(socket, RS_MAXIMUM_CONNECTIONS_REACHED, strlen(RS_MAXIMUM_CONNECTIONS_REACHED), MSG_NOSIGNAL | MSG_DONTWAIT);
+		close(socket);
+		return CELIX_BUNDLE_EXCEPTION;
 	}
 
-	if (status != CELIX_SUCCESS && connection != NULL) {
-		if (connection->socketStream != NULL) {
-			fclose(connection->socketStream);
-		}
+	connection_pt connection = calloc(1, sizeof(*connection));
+	if (connection == NULL) {
+		celixThreadMutex_unlock(&instance->mutex);
+		close(socket);
+		return CELIX_ENOMEM;
+	}
+	connection->parent = instance;
+	connection->fd = socket;
+	connection->refCount = 1; //event loop reference
+	connection->epollEvents = EPOLLIN | EPOLLRDHUP;
+
+	struct epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = connection->epollEvents;
+	event.data.ptr = connection;
+	if (epoll_ctl(instance->epollFd, EPOLL_CTL_ADD, socket, &event) != 0) {
+		celixThreadMutex_unlock(&instance->mutex);
+		celix_logHelper_log(*instance->loghelper, CELIX_LOG_LEVEL_ERROR, "REMOTE_SHELL: cannot add connection to epoll: %s", strerror(errno));
+		close(socket);
 		free(connection);
+		return CELIX_BUNDLE_EXCEPTION;
 	}
+	celix_arrayList_add(instance->connections, connection);
+	remoteShell_connection_print(connection, RS_WELCOME);
+	remoteShell_connection_flush(connection);
+	celixThreadMutex_unlock(&instance->mutex);
 
-	return status;
+	return CELIX_SUCCESS;
 }
 
 celix_status_t remoteShell_stopConnections(remote_shell_pt instance) {
 	celix_status_t status = CELIX_SUCCESS;
-	int length = 0;
-	int i = 0;
 
+	//stop the workers, commands in progress are finished first
 	celixThreadMutex_lock(&instance->mutex);
-	length = celix_arrayList_size(instance->connections);
-
-	for (i = 0; i < length; i += 1) {
-		connection_pt connection = celix_arrayList_get(instance->connections, i);
-		connection->threadRunning = false;
+	bool joinWorkers = instance->workersRunning;
+	instance->workersRunning = false;
+	celixThreadCondition_broadcast(&instance->cond);
+	celixThreadMutex_unlock(&instance->mutex);
+	if (joinWorkers) {
+		for (int i = 0; i < instance->nrOfWorkers; ++i) {
+			celixThread_join(instance->workers[i], NULL);
+		}
 	}
 
+	celixThreadMutex_lock(&instance->mutex);
+	for (int i = 0; i < celix_arrayList_size(instance->pendingCommands); ++i) {
+		connection_pt connection = celix_arrayList_get(instance->pendingCommands, i);
+		connection->commandInProgress = false;
+		remoteShell_connection_release(connection);
+	}
+	celix_arrayList_clear(instance->pendingCommands);
+	while (celix_arrayList_size(instance->connections) > 0) {
+		connection_pt connection = celix_arrayList_get(instance->connections, 0);
+		remoteShell_connection_print(connection, RS_GOODBYE);
+		remoteShell_connection_flush(connection);
+		remoteShell_connection_close(connection);
+	}
 	celixThreadMutex_unlock(&instance->mutex);
 
 	return status;
 }
 
-void *remoteShell_connection_run(void *data) {
-	celix_status_t status = CELIX_SUCCESS;
-	connection_pt connection = data;
-	size_t len;
-	int result;
-	struct timeval timeout; /* Timeout for select */
-
-	int fd = fileno(connection->socketStream);
-
-	connection->threadRunning = true;
-	status = remoteShell_connection_print(connection, RS_WELCOME);
-
-	while (status == CELIX_SUCCESS && connection->threadRunning == true) {
-		do {
-			timeout.tv_sec = CONNECTION_LISTENER_TIMEOUT_SEC;
-			timeout.tv_usec = 0;
-
-			FD_ZERO(&connection->pollset);
-			FD_SET(fd, &connection->pollset);
-			result = select(fd + 1, &connection->pollset, NULL, NULL, &timeout);
-		} while (result == -1 && errno == EINTR && connection->threadRunning == true);
-
-		/* The socket_fd has data available to be read */
-		if (result > 0 && FD_ISSET(fd, &connection->pollset)) {
-			char buff[COMMAND_BUFF_SIZE];
-
-			len = recv(fd, buff, COMMAND_BUFF_SIZE - 1, 0);
-			if (len < COMMAND_BUFF_SIZE) {
-				celix_status_t commandStatus = CELIX_SUCCESS;
-				buff[len] = '\0';
-
-				commandStatus = remoteShell_connection_execute(connection, buff);
-
-				if (commandStatus == CELIX_SUCCESS) {
-					remoteShell_connection_print(connection, RS_PROMPT);
-				} else if (commandStatus == CELIX_FILE_IO_EXCEPTION) {
-					//exit command
-					break;
-				} else { //error
-					remoteShell_connection_print(connection, RS_ERROR);
-					remoteShell_connection_print(connection, RS_PROMPT);
-				}
+void remoteShell_connection_handleEvents(connection_pt connection, uint32_t events) {
+	remote_shell_pt rs = connection->parent;
+	celixThreadMutex_lock(&rs->mutex);
+	bool peerClosed = (events & (EPOLLERR | EPOLLHUP)) != 0;
+	if (events & EPOLLIN) {
+		while (!connection->closed && connection->inLen < COMMAND_BUFF_SIZE - 1) {
+			ssize_t len = recv(connection->fd, connection->inBuf + connection->inLen, COMMAND_BUFF_SIZE - 1 - connection->inLen, MSG_DONTWAIT);
+			if (len > 0) {
+				connection->inLen += (size_t)len;
+			} else if (len == 0) {
+				connection->inputClosed = true;
+				break;
+			} else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+				peerClosed = true;
+				break;
+			} else if (errno != EINTR) {
+				break;
+			}
+		}
+		if (connection->inLen == COMMAND_BUFF_SIZE - 1 && memchr(connection->inBuf, '\n', connection->inLen) == NULL) {
+			connection->inLen = 0;
+			remoteShell_connection_print(connection, RS_COMMAND_TOO_LONG);
+			remoteShell_connection_print(connection, RS_PROMPT);
+		}
+		remoteShell_connection_processInput(connection);
+	}
+	if (!peerClosed && !connection->closed) {
+		remoteShell_connection_flush(connection);
+	}
+	if (!connection->closed && (peerClosed || (connection->closeAfterFlush && connection->outLen == 0))) {
+		celix_logHelper_log(*rs->loghelper, CELIX_LOG_LEVEL_INFO, "REMOTE_SHELL: Closing socket");
+		remoteShell_connection_close(connection);
+	}
+	celixThreadMutex_unlock(&rs->mutex);
+}
+
+/**
+ * @brief Takes the next complete command line from the input buffer and handles it, if no command is in progress.
+ * Should be called with parent->mutex locked.
+ */
+static void remoteShell_connection_processInput(connection_pt connection) {
+	remote_shell_pt rs = connection->parent;
+	while (!connection->commandInProgress && !connection->closeAfterFlush && !connection->closed) {
+		char* end = memchr(connection->inBuf, '\n', connection->inLen);
+		if (end == NULL && connection->inputClosed && connection->inLen > 0) {
+			//last command of a half-closed connection without a trailing newline
+			end = connection->inBuf + connection->inLen;
+			connection->inLen += 1;
+		}
+		if (end == NULL) {
+			break;
+		}
+		*end = '\0';
+		char* line = celix_utils_trim(connection->inBuf);
+		size_t consumed = (size_t)(end - connection->inBuf) + 1;
+		memmove(connection->inBuf, end + 1, connection->inLen - consumed);
+		connection->inLen -= consumed;
+
+		if (line == NULL) {
+			remoteShell_connection_print(connection, RS_ERROR);
+			remoteShell_connection_print(connection, RS_PROMPT);
+		} else if (strlen(line) == 0) {
+			remoteShell_connection_print(connection, RS_PROMPT);
+			free(line);
+		} else if (strcmp("exit", line) == 0) {
+			remoteShell_connection_print(connection, RS_GOODBYE);
+			connection->closeAfterFlush = true;
+			free(line);
+		} else {
+			connection->command = line;
+			connection->commandInProgress = true;
+			connection->refCount += 1; //command reference
+			celix_arrayList_add(rs->pendingCommands, connection);
+			celixThreadCondition_signal(&rs->cond);
+		}
+	}
+	if (connection->inputClosed && !connection->commandInProgress) {
+		//all commands of a half-closed connection are handled, close after the output is written
+		connection->closeAfterFlush = true;
+	}
+}
 
+static void* remoteShell_worker_run(void *data) {
+	remote_shell_pt rs = data;
+	celixThreadMutex_lock(&rs->mutex);
+	while (rs->workersRunning) {
+		if (celix_arrayList_size(rs->pendingCommands) == 0) {
+			celixThreadCondition_wait(&rs->cond, &rs->mutex);
+			continue;
+		}
+		connection_pt connection = celix_arrayList_get(rs->pendingCommands, 0);
+		celix_arrayList_removeAt(rs->pendingCommands, 0);
+		char* command = connection->command;
+		connection->command = NULL;
+		bool closed = connection->closed;
+		celixThreadMutex_unlock(&rs->mutex);
+
+		//execute the command outside the lock, output is streamed non-blocking to the socket while the command runs
+		celix_status_t status = CELIX_SUCCESS;
+		if (!closed) {
+			cookie_io_functions_t functions = {.read = NULL, .write = remoteShell_connection_streamWrite, .seek = NULL, .close = NULL};
+			FILE* stream = fopencookie(connection, "w", functions);
+			if (stream != NULL) {
+				setvbuf(stream, NULL, _IOLBF, BUFSIZ);
+				status = shellMediator_executeCommand(rs->mediator, command, stream, stream);
+				fclose(stream);
 			} else {
-                celix_logHelper_log(*connection->parent->loghelper, CELIX_LOG_LEVEL_ERROR, "REMOTE_SHELL: Error while retrieving data");
+				status = CELIX_ENOMEM;
 			}
 		}
-	}
+		free(command);
 
-	remoteShell_connection_print(connection, RS_GOODBYE);
+		celixThreadMutex_lock(&rs->mutex);
+		if (!connection->closed) {
+			if (status != CELIX_SUCCESS) {
+				remoteShell_connection_print(connection, RS_ERROR);
+			}
+			remoteShell_connection_print(connection, RS_PROMPT);
+		}
+		connection->commandInProgress = false;
+		remoteShell_connection_processInput(connection);
+		if (!connection->closed) {
+			remoteShell_connection_flush(connection);
+		}
+		remoteShell_connection_release(connection);
+	}
+	celixThreadMutex_unlock(&rs->mutex);
+	return NULL;
+}
 
-    celix_logHelper_log(*connection->parent->loghelper, CELIX_LOG_LEVEL_INFO, "REMOTE_SHELL: Closing socket");
+/**
+ * @brief Write function of the command output stream, appends the output to the connection and flushes it.
+ */
+static ssize_t remoteShell_connection_streamWrite(void *cookie, const char *buf, size_t size) {
+	connection_pt connection = cookie;
 	celixThreadMutex_lock(&connection->parent->mutex);
-        celix_arrayList_remove(connection->parent->connections, connection);
+	if (!connection->closed) {
+		remoteShell_connection_append(connection, buf, size);
+		remoteShell_connection_flush(connection);
+	}
 	celixThreadMutex_unlock(&connection->parent->mutex);
-
-	fclose(connection->socketStream);
-
-	return NULL;
+	return (ssize_t)size;
 }
 
-static celix_status_t remoteShell_connection_execute(connection_pt connection, char *command) {
-	celix_status_t status = CELIX_SUCCESS;
+/**
+ * @brief Appends text to the output buffer of the connection.
+ * If the buffered output would exceed MAX_OUTPUT_BUFF_SIZE, the output is discarded and the connection is dropped.
+ * Should be called with parent->mutex locked.
+ */
+static void remoteShell_connection_append(connection_pt connection, const char* text, size_t len) {
+	if (len == 0 || connection->outputOverflow) {
+		return;
+	}
+	if (connection->outLen + len > MAX_OUTPUT_BUFF_SIZE) {
+		//the client does not read its output (fast enough); drop it instead of buffering without limit.
+		//shutting down the socket results in a EPOLLHUP event, on which the event loop thread closes the connection.
+		celix_logHelper_log(*connection->parent->loghelper, CELIX_LOG_LEVEL_WARNING,
+		                    "REMOTE_SHELL: Output buffer exceeds %i bytes, disconnecting slow client", MAX_OUTPUT_BUFF_SIZE);
+		connection->outputOverflow = true;
+		connection->closeAfterFlush = true;
+		connection->outLen = 0;
+		shutdown(connection->fd, SHUT_RDWR);
+		return;
+	}
+	if (connection->outLen + len > connection->outCap) {
+		size_t newCap = connection->outCap == 0 ? COMMAND_BUFF_SIZE : connection->outCap;
+		while (newCap < connection->outLen + len) {
+			newCap *= 2;
+		}
+		char* newBuf = realloc(connection->outBuf, newCap);
+		if (newBuf == NULL) {
+			celix_logHelper_log(*connection->parent->loghelper, CELIX_LOG_LEVEL_ERROR, "REMOTE_SHELL: Cannot buffer output. ENOMEM");
+			return;
+		}
+		connection->outBuf = newBuf;
+		connection->outCap = newCap;
+	}
+	memcpy(connection->outBuf + connection->outLen, text, len);
+	connection->outLen += len;
+}
 
-	if (status == CELIX_SUCCESS) {
-		char *line = celix_utils_trim(command);
-		int len = strlen(line);
+static void remoteShell_connection_print(connection_pt connection, const char* text) {
+	remoteShell_connection_append(connection, text, strlen(text));
+}
 
-		if (len == 0) {
-			//ignore
-		} else if (len == 4 && strncmp("exit", line, 4) == 0) {
-			status = CELIX_FILE_IO_EXCEPTION;
+/**
+ * @brief Writes the buffered output to the socket without blocking and updates the configured epoll events.
+ *
+ * If the socket send buffer is full, EPOLLOUT is configured so that the event loop continues when the socket is
+ * writable again. EPOLLIN is only configured if the input buffer has space left, so that a client cannot flood the
+ * remote shell while a command is in progress.
+ * Should be called with parent->mutex locked.
+ */
+static void remoteShell_connection_flush(connection_pt connection) {
+	size_t written = 0;
+	while (written < connection->outLen) {
+		ssize_t len = send(connection->fd, connection->outBuf + written, connection->outLen - written, MSG_NOSIGNAL | MSG_DONTWAIT);
+		if (len > 0) {
+			written += (size_t)len;
+		} else if (len < 0 && errno == EINTR) {
+			continue;
 		} else {
-			status = shellMediator_executeCommand(connection->parent->mediator, line, connection->socketStream, connection->socketStream);
-            fflush(connection->socketStream);
+			//EAGAIN -> wait for EPOLLOUT; other errors -> the event loop will receive a EPOLLERR/EPOLLHUP event.
+			break;
 		}
+	}
+	if (written > 0) {
+		memmove(connection->outBuf, connection->outBuf + written, connection->outLen - written);
+		connection->outLen -= written;
+	}
 
-		free(line);
+	uint32_t events = 0;
+	if (!connection->inputClosed && connection->inLen < COMMAND_BUFF_SIZE - 1) {
+		events |= EPOLLIN | EPOLLRDHUP;
+	}
+	if (connection->outLen > 0 || connection->closeAfterFlush) {
+		//note also for close after flush, so that the event loop thread closes the connection
+		events |= EPOLLOUT;
+	}
+	if (events != connection->epollEvents) {
+		struct epoll_event event;
+		memset(&event, 0, sizeof(event));
+		event.events = events;
+		event.data.ptr = connection;
+		epoll_ctl(connection->parent->epollFd, EPOLL_CTL_MOD, connection->fd, &event);
+		connection->epollEvents = events;
 	}
+}
 
-	return status;
+/**
+ * @brief Closes the connection and releases the event loop reference.
+ * Should be called with parent->mutex locked.
+ */
+static void remoteShell_connection_close(connection_pt connection) {
+	connection->closed = true;
+	epoll_ctl(connection->parent->epollFd, EPOLL_CTL_DEL, connection->fd, NULL);
+	celix_arrayList_remove(connection->parent->connections, connection);
+	remoteShell_connection_release(connection);
 }
 
-celix_status_t remoteShell_connection_print(connection_pt connection, char *text) {
-	size_t len = strlen(text);
-    int fd = fileno(connection->socketStream);
-	return (send(fd, text, len, 0) > 0) ? CELIX_SUCCESS : CELIX_FILE_IO_EXCEPTION;
+/**
+ * @brief Releases a connection reference and frees the connection if this was the last reference.
+ * Should be called with parent->mutex locked.
+ */
+static void remoteShell_connection_release(connection_pt connection) {
+	connection->refCount -= 1;
+	if (connection->refCount == 0) {
+		close(connection->fd);
+		free(connection->command);
+		free(connection->outBuf);
+		free(connection);
+	}
 }
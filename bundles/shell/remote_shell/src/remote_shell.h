@@ -27,24 +27,49 @@
 #ifndef REMOTE_SHELL_H_
 #define REMOTE_SHELL_H_
 
+#include <stdint.h>
 #include <bundle_context.h>
 #include <celix_errno.h>
 
 #include "shell_mediator.h"
 
+typedef struct connection *connection_pt;
+
 struct remote_shell {
 	celix_log_helper_t **loghelper;
 	shell_mediator_pt mediator;
-	celix_thread_mutex_t mutex;
 	int maximumConnections;
+	int epollFd; /**< epoll instance for all connection sockets, the event loop is run by the connection listener. */
 
-	celix_array_list_t* connections;
+	celix_thread_mutex_t mutex; //protects below
+	celix_thread_cond_t cond; //signals added pending commands
+	celix_array_list_t* connections; //entry = connection_pt
+	celix_array_list_t* pendingCommands; //entry = connection_pt with a command ready for execution
+	bool workersRunning;
+	int nrOfWorkers;
+	celix_thread_t* workers;
 };
 typedef struct remote_shell *remote_shell_pt;
 
-celix_status_t remoteShell_create(shell_mediator_pt mediator, int maximumConnections, remote_shell_pt *instance);
+celix_status_t remoteShell_create(shell_mediator_pt mediator, int maximumConnections, int nrOfWorkers, remote_shell_pt *instance);
 celix_status_t remoteShell_destroy(remote_shell_pt instance);
+
+/**
+ * @brief Adds a new (non-blocking) connection socket and registers it to the epoll instance of the remote shell.
+ * Should be called from the event loop thread.
+ */
 celix_status_t remoteShell_addConnection(remote_shell_pt instance, int socket);
+
+/**
+ * @brief Stops the command workers and closes all connections.
+ * Should be called after the event loop is stopped.
+ */
 celix_status_t remoteShell_stopConnections(remote_shell_pt instance);
 
+/**
+ * @brief Handles the epoll events for a connection.
+ * Should be called from the event loop thread.
+ */
+void remoteShell_connection_handleEvents(connection_pt connection, uint32_t events);
+
 #endif /* REMOTE_SHELL_H_ */
@@ -51,6 +51,7 @@ celix_status_t shellMediator_create(bundle_context_pt context, shell_mediator_pt
         (*instance)->loghelper = celix_logHelper_create(context, "celix_shell");
 
 		status = CELIX_DO_IF(status, celixThreadMutex_create(&(*instance)->mutex, NULL));
+		status = CELIX_DO_IF(status, celixThreadCondition_init(&(*instance)->cond, NULL));
 
 		status = CELIX_DO_IF(status, serviceTrackerCustomizer_create((*instance), NULL, shellMediator_addedService,
 				NULL, shellMediator_removedService, &customizer));
@@ -88,8 +89,11 @@ celix_status_t shellMediator_destroy(shell_mediator_pt instance) {
 	celixThreadMutex_lock(&instance->mutex);
 
 	instance->shellService = NULL;
+	celixThreadMutex_unlock(&instance->mutex);
+
 	serviceTracker_destroy(instance->tracker);
     celix_logHelper_destroy(instance->loghelper);
+	celixThreadCondition_destroy(&instance->cond);
 	celixThreadMutex_destroy(&instance->mutex);
 
 
@@ -103,14 +107,22 @@ celix_status_t shellMediator_executeCommand(shell_mediator_pt instance, char *co
 	celix_status_t status = CELIX_SUCCESS;
 
 	celixThreadMutex_lock(&instance->mutex);
+	celix_shell_t* shellService = instance->shellService;
+	if (shellService != NULL) {
+		instance->useCount += 1;
+	}
+	celixThreadMutex_unlock(&instance->mutex);
 
+	if (shellService != NULL) {
+		//note executed outside the mutex, so that commands of different connections can run concurrently
+		shellService->executeCommand(shellService->handle, command, out, err);
 
-	if (instance->shellService != NULL) {
-		instance->shellService->executeCommand(instance->shellService->handle, command, out, err);
+		celixThreadMutex_lock(&instance->mutex);
+		instance->useCount -= 1;
+		celixThreadCondition_broadcast(&instance->cond);
+		celixThreadMutex_unlock(&instance->mutex);
 	}
 
-	celixThreadMutex_unlock(&instance->mutex);
-
 	return status;
 }
 
@@ -129,6 +141,10 @@ static celix_status_t shellMediator_removedService(void *handler, service_refere
 	shell_mediator_pt instance = (shell_mediator_pt) handler;
 	celixThreadMutex_lock(&instance->mutex);
 	instance->shellService = NULL;
+	while (instance->useCount > 0) {
+		//the shell service can only be removed if no command is using it anymore
+		celixThreadCondition_wait(&instance->cond, &instance->mutex);
+	}
 	celixThreadMutex_unlock(&instance->mutex);
 	return status;
 }
@@ -40,9 +40,11 @@ struct shell_mediator {
 	bundle_context_pt context;
 	service_tracker_pt tracker;
 	celix_thread_mutex_t mutex;
+	celix_thread_cond_t cond;
 
 	//protected by mutex
 	celix_shell_t *shellService;
+	int useCount; //nr of commands executing without holding the mutex
 };
 typedef struct shell_mediator *shell_mediator_pt;
 
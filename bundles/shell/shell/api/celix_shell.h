@@ -26,10 +26,23 @@ extern "C" {
 #endif
 
 #include <stdio.h>
+#include <stdbool.h>
 #include "celix_array_list.h"
+#include "celix_errno.h"
 
 #define CELIX_SHELL_SERVICE_NAME        "celix_shell"
-#define CELIX_SHELL_SERVICE_VERSION     "2.0.0"
+#define CELIX_SHELL_SERVICE_VERSION     "2.1.0"
+
+/**
+ * @brief Called with a chunk of output of an asynchronously executed command.
+ * The output is not '\0' terminated. isError is true for output written to the error stream of the command.
+ */
+typedef void (*celix_shell_output_callback_fp)(void *callbackHandle, const char *output, size_t outputLen, bool isError);
+
+/**
+ * @brief Called when an asynchronously executed command is finished.
+ */
+typedef void (*celix_shell_done_callback_fp)(void *callbackHandle, celix_status_t status);
 
 struct celix_shell {
 	void *handle;
@@ -54,6 +67,17 @@ struct celix_shell {
 	 * Try to execute a command using the provided command line.
 	 */
 	celix_status_t (*executeCommand)(void *handle, const char *commandLine, FILE *out, FILE *err);
+
+	/**
+	 * @brief Try to execute a command on a separate thread, streaming its output while the command is running.
+	 *
+	 * The output callback is called for every flushed chunk of output and the done callback is called once with the
+	 * status of the command. Both callbacks are called from the thread executing the command.
+	 * If this function returns an error, no callbacks are called.
+	 *
+	 * Can be NULL for shell implementations which do not support asynchronous execution (service version < 2.1.0).
+	 */
+	celix_status_t (*executeCommandAsync)(void *handle, const char *commandLine, void *callbackHandle, celix_shell_output_callback_fp outputCallback, celix_shell_done_callback_fp doneCallback);
 };
 
 typedef struct celix_shell celix_shell_t;
@@ -17,14 +17,17 @@
  * under the License.
  */
 
+#include <condition_variable>
 #include <future>
 #include <gtest/gtest.h>
+#include <mutex>
 #include <thread>
 
 #include "celix_bundle_context.h"
 #include "celix_constants.h"
 #include "celix_framework_factory.h"
 #include "celix_framework_utils.h"
+#include "celix_lock_profiling.h"
 #include "celix_shell.h"
 #include "celix_shell_command.h"
 #include "celix_stdlib_cleanup.h"
@@ -138,7 +141,17 @@ TEST_F(ShellTestSuite, testAllCommandsAreCallable) {
     callCommand(ctx, "start 15", false); //non existing bundle id
     callCommand(ctx, "uninstall 15", false); //non existing bundle id
     callCommand(ctx, "unload 15", false); //non existing bundle id
+    callCommand(ctx, "lock_profile invalid", false);
+    callCommand(ctx, "lock_profile top not-a-number", false);
+    bool lockProfiling = celix_lockProfiling_isSupported();
+    callCommand(ctx, "lock_profile on", lockProfiling);
+    callCommand(ctx, "lock_profile top 5", lockProfiling);
+    callCommand(ctx, "lock_profile reset", lockProfiling);
+    callCommand(ctx, "lock_profile off", lockProfiling);
     callCommand(ctx, "update 15", false); //non existing bundle id
+    callCommand(ctx, "stats", true);
+    callCommand(ctx, "stats -p framework", true);
+    callCommand(ctx, "stats non-existing-provider", false);
 }
 
 TEST_F(ShellTestSuite, quitTest) {
@@ -218,6 +231,38 @@ TEST_F(ShellTestSuite, queryTest) {
     EXPECT_TRUE(called);
 }
 
+TEST_F(ShellTestSuite, statsTest) {
+    celix_service_use_options_t opts{};
+    opts.filter.serviceName = CELIX_SHELL_COMMAND_SERVICE_NAME;
+    opts.filter.filter = "(command.name=celix::stats)";
+    opts.waitTimeoutInSeconds = 1.0;
+    opts.use = [](void*, void *svc) {
+        auto *command = static_cast<celix_shell_command_t*>(svc);
+        ASSERT_TRUE(command != nullptr);
+
+        {
+            celix_autofree char *buf = nullptr;
+            size_t len;
+            FILE *sout = open_memstream(&buf, &len);
+            EXPECT_TRUE(command->executeCommand(command->handle, "stats framework", sout, sout));
+            fclose(sout);
+            EXPECT_TRUE(strstr(buf, "Metrics provider 'framework'") != nullptr);
+            EXPECT_TRUE(strstr(buf, "celix_framework_events_processed_total") != nullptr);
+        }
+        {
+            celix_autofree char *buf = nullptr;
+            size_t len;
+            FILE *sout = open_memstream(&buf, &len);
+            EXPECT_TRUE(command->executeCommand(command->handle, "stats -p", sout, sout));
+            fclose(sout);
+            EXPECT_TRUE(strstr(buf, "# TYPE celix_framework_events_processed_total counter") != nullptr);
+            EXPECT_TRUE(strstr(buf, "celix_framework_event_processing_seconds_bucket{le=\"+Inf\"}") != nullptr);
+        }
+    };
+    bool called = celix_bundleContext_useServiceWithOptions(ctx.get(), &opts);
+    EXPECT_TRUE(called);
+}
+
 TEST_F(ShellTestSuite, localNameClashTest) {
     callCommand(ctx, "lb", true);
 
@@ -241,6 +286,136 @@ TEST_F(ShellTestSuite, localNameClashTest) {
 
 }
 
+static celix_status_t executeCommand(celix_bundle_context_t* ctx, const char* cmdLine) {
+    struct data {
+        const char* cmdLine;
+        celix_status_t status;
+    };
+    data data{cmdLine, CELIX_BUNDLE_EXCEPTION};
+    celix_service_use_options_t opts{};
+    opts.filter.serviceName = CELIX_SHELL_SERVICE_NAME;
+    opts.waitTimeoutInSeconds = 1.0;
+    opts.callbackHandle = &data;
+    opts.use = [](void* handle, void* svc) {
+        auto* d = static_cast<struct data*>(handle);
+        auto* shell = static_cast<celix_shell_t*>(svc);
+        d->status = shell->executeCommand(shell->handle, d->cmdLine, stdout, stderr);
+    };
+    bool called = celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    EXPECT_TRUE(called);
+    return data.status;
+}
+
+struct BlockingCommandState {
+    std::mutex mutex{};
+    std::condition_variable cond{};
+    bool started{false};
+    bool release{false};
+    std::string output{};
+    bool done{false};
+    celix_status_t status{CELIX_BUNDLE_EXCEPTION};
+};
+
+static bool blockingCommand(void* handle, const char*, FILE* out, FILE*) {
+    auto* state = static_cast<BlockingCommandState*>(handle);
+    fprintf(out, "first line\n");
+    std::unique_lock<std::mutex> lck{state->mutex};
+    state->started = true;
+    state->cond.notify_all();
+    state->cond.wait(lck, [state]{ return state->release; });
+    lck.unlock();
+    fprintf(out, "second line\n");
+    return true;
+}
+
+TEST_F(ShellTestSuite, ConcurrentCommandExecutionTest) {
+    BlockingCommandState state{};
+    celix_shell_command_t blockCmd{};
+    blockCmd.handle = &state;
+    blockCmd.executeCommand = blockingCommand;
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, CELIX_SHELL_COMMAND_NAME, "test::block");
+    long blockSvcId = celix_bundleContext_registerService(ctx.get(), &blockCmd, CELIX_SHELL_COMMAND_SERVICE_NAME, props);
+
+    std::thread blockThread{[this]{
+        EXPECT_EQ(CELIX_SUCCESS, executeCommand(ctx.get(), "block"));
+    }};
+    {
+        std::unique_lock<std::mutex> lck{state.mutex};
+        ASSERT_TRUE(state.cond.wait_for(lck, std::chrono::seconds{5}, [&state]{ return state.started; }));
+    }
+
+    //When a command is running, other commands can be executed and new commands can be registered
+    EXPECT_EQ(CELIX_SUCCESS, executeCommand(ctx.get(), "lb"));
+    celix_shell_command_t otherCmd{};
+    otherCmd.executeCommand = [](void*, const char*, FILE*, FILE*) -> bool { return true; };
+    props = celix_properties_create();
+    celix_properties_set(props, CELIX_SHELL_COMMAND_NAME, "test::other");
+    long otherSvcId = celix_bundleContext_registerService(ctx.get(), &otherCmd, CELIX_SHELL_COMMAND_SERVICE_NAME, props);
+    EXPECT_EQ(CELIX_SUCCESS, executeCommand(ctx.get(), "other"));
+
+    {
+        std::lock_guard<std::mutex> lck{state.mutex};
+        state.release = true;
+        state.cond.notify_all();
+    }
+    blockThread.join();
+    celix_bundleContext_unregisterService(ctx.get(), otherSvcId);
+    celix_bundleContext_unregisterService(ctx.get(), blockSvcId);
+}
+
+#ifndef CXX_SHELL
+TEST_F(ShellTestSuite, AsyncExecuteCommandStreamsOutputTest) {
+    BlockingCommandState state{};
+    celix_shell_command_t blockCmd{};
+    blockCmd.handle = &state;
+    blockCmd.executeCommand = blockingCommand;
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, CELIX_SHELL_COMMAND_NAME, "test::block");
+    long svcId = celix_bundleContext_registerService(ctx.get(), &blockCmd, CELIX_SHELL_COMMAND_SERVICE_NAME, props);
+
+    celix_service_use_options_t opts{};
+    opts.filter.serviceName = CELIX_SHELL_SERVICE_NAME;
+    opts.waitTimeoutInSeconds = 1.0;
+    opts.callbackHandle = &state;
+    opts.use = [](void* handle, void* svc) {
+        auto* shell = static_cast<celix_shell_t*>(svc);
+        ASSERT_TRUE(shell->executeCommandAsync != nullptr);
+        auto outputCallback = [](void* handle, const char* output, size_t outputLen, bool isError) {
+            auto* s = static_cast<BlockingCommandState*>(handle);
+            EXPECT_FALSE(isError);
+            std::lock_guard<std::mutex> lck{s->mutex};
+            s->output.append(output, outputLen);
+            s->cond.notify_all();
+        };
+        auto doneCallback = [](void* handle, celix_status_t status) {
+            auto* s = static_cast<BlockingCommandState*>(handle);
+            std::lock_guard<std::mutex> lck{s->mutex};
+            s->done = true;
+            s->status = status;
+            s->cond.notify_all();
+        };
+        auto status = shell->executeCommandAsync(shell->handle, "block", handle, outputCallback, doneCallback);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, shell->executeCommandAsync(shell->handle, nullptr, handle, outputCallback, doneCallback));
+    };
+    EXPECT_TRUE(celix_bundleContext_useServiceWithOptions(ctx.get(), &opts));
+
+    std::unique_lock<std::mutex> lck{state.mutex};
+    //first line is streamed while the command is still running
+    EXPECT_TRUE(state.cond.wait_for(lck, std::chrono::seconds{5}, [&state]{ return state.output == "first line\n"; }));
+    EXPECT_FALSE(state.done);
+    state.release = true;
+    state.cond.notify_all();
+    EXPECT_TRUE(state.cond.wait_for(lck, std::chrono::seconds{5}, [&state]{ return state.done; }));
+    EXPECT_EQ(std::string{"first line\nsecond line\n"}, state.output);
+    EXPECT_EQ(CELIX_SUCCESS, state.status);
+    lck.unlock();
+
+    celix_bundleContext_unregisterService(ctx.get(), svcId);
+}
+#endif
+
 #ifdef CXX_SHELL
 #include "celix/BundleContext.h"
 #include "celix/IShellCommand.h"
@@ -16,8 +16,6 @@
  * specific language governing permissions and limitations
  * under the License.
  */
-
-
 #include <stdlib.h>
 #include <string.h>
 
@@ -26,7 +24,23 @@
 #include "celix_utils.h"
 #include "celix_errno.h"
 #include "shell_private.h"
-#include "utils.h"
+
+typedef struct celix_shell_async_execution {
+    shell_t *shell;
+    celix_thread_t thread;
+    bool done; //protected by shell->mutex
+    char *commandLine;
+    void *callbackHandle;
+    celix_shell_output_callback_fp outputCallback;
+    celix_shell_done_callback_fp doneCallback;
+} celix_shell_async_execution_t;
+
+typedef struct celix_shell_output_stream {
+    celix_shell_async_execution_t *execution;
+    bool isError;
+} celix_shell_output_stream_t;
+
+static void shell_joinAsyncExecutions(shell_t *shell, bool onlyDone);
 
 shell_t* shell_create(celix_bundle_context_t *ctx) {
     shell_t *shell = calloc(1, sizeof(*shell));
@@ -35,15 +49,29 @@ shell_t* shell_create(celix_bundle_context_t *ctx) {
     shell->logHelper = celix_logHelper_create(ctx, "celix_shell");
     
     celixThreadRwlock_create(&shell->lock, NULL);
-    shell->commandServices = hashMap_create(utils_stringHash, NULL, utils_stringEquals, NULL);
+    shell->commandServices = celix_stringHashMap_create();
+    shell->localNameIndex = celix_stringHashMap_create();
+
+    celixThreadMutex_create(&shell->mutex, NULL);
+    celixThreadCondition_init(&shell->cond, NULL);
+    shell->asyncExecutions = celix_arrayList_create();
 
     return shell;
 }
 
 void shell_destroy(shell_t *shell) {
     if (shell != NULL) {
+        shell_joinAsyncExecutions(shell, false);
+        celix_arrayList_destroy(shell->asyncExecutions);
+        celixThreadCondition_destroy(&shell->cond);
+        celixThreadMutex_destroy(&shell->mutex);
+
         celixThreadRwlock_writeLock(&shell->lock);
-        hashMap_destroy(shell->commandServices, false, false);
+        CELIX_STRING_HASH_MAP_ITERATE(shell->localNameIndex, iter) {
+            celix_arrayList_destroy(iter.value.ptrValue);
+        }
+        celix_stringHashMap_destroy(shell->localNameIndex);
+        celix_stringHashMap_destroy(shell->commandServices);
         celixThreadRwlock_unlock(&shell->lock);
         celixThreadRwlock_destroy(&shell->lock);
         celix_logHelper_destroy(shell->logHelper);
@@ -62,7 +90,7 @@ celix_status_t shell_addCommand(shell_t *shell, celix_shell_command_t *svc, cons
     } else {
         long svcId = celix_properties_getAsLong(props, CELIX_FRAMEWORK_SERVICE_ID, -1L);
         celixThreadRwlock_writeLock(&shell->lock);
-        if (hashMap_containsKey(shell->commandServices, name)) {
+        if (celix_stringHashMap_hasKey(shell->commandServices, name)) {
             celix_logHelper_log(shell->logHelper, CELIX_LOG_LEVEL_WARNING, "Command with name %s already registered!", name);
         } else {
             celix_shell_command_entry_t *entry = calloc(1, sizeof(*entry));
@@ -74,7 +102,14 @@ celix_status_t shell_addCommand(shell_t *shell, celix_shell_command_t *svc, cons
             entry->props = props;
             entry->namespace = ns;
             entry->localName = localName;
-            hashMap_put(shell->commandServices, (void*)name, entry);
+            celix_stringHashMap_put(shell->commandServices, name, entry);
+
+            celix_array_list_t *entries = celix_stringHashMap_get(shell->localNameIndex, localName);
+            if (entries == NULL) {
+                entries = celix_arrayList_create();
+                celix_stringHashMap_put(shell->localNameIndex, localName, entries);
+            }
+            celix_arrayList_add(entries, entry);
         }
         celixThreadRwlock_unlock(&shell->lock);
     }
@@ -91,14 +126,19 @@ celix_status_t shell_removeCommand(shell_t *shell, celix_shell_command_t *svc, c
         status = CELIX_BUNDLE_EXCEPTION;
     } else {
         long svcId = celix_properties_getAsLong(props, CELIX_FRAMEWORK_SERVICE_ID, -1L);
+        celix_shell_command_entry_t *removed = NULL;
         celixThreadRwlock_writeLock(&shell->lock);
-        if (hashMap_containsKey(shell->commandServices, name)) {
-            celix_shell_command_entry_t *entry = hashMap_get(shell->commandServices, name);
+        celix_shell_command_entry_t *entry = celix_stringHashMap_get(shell->commandServices, name);
+        if (entry != NULL) {
             if (entry->svcId == svcId) {
-                hashMap_remove(shell->commandServices, name);
-                free(entry->localName);
-                free(entry->namespace);
-                free(entry);
+                celix_stringHashMap_remove(shell->commandServices, name);
+                celix_array_list_t *entries = celix_stringHashMap_get(shell->localNameIndex, entry->localName);
+                celix_arrayList_remove(entries, entry);
+                if (celix_arrayList_size(entries) == 0) {
+                    celix_stringHashMap_remove(shell->localNameIndex, entry->localName);
+                    celix_arrayList_destroy(entries);
+                }
+                removed = entry;
             } else {
                 celix_logHelper_log(shell->logHelper, CELIX_LOG_LEVEL_WARNING, "svc id for command with name %s does not match (%li == %li)!", name, svcId, entry->svcId);
             }
@@ -106,6 +146,18 @@ celix_status_t shell_removeCommand(shell_t *shell, celix_shell_command_t *svc, c
             celix_logHelper_log(shell->logHelper, CELIX_LOG_LEVEL_WARNING, "Cannot find shell command with name %s!", name);
         }
         celixThreadRwlock_unlock(&shell->lock);
+
+        if (removed != NULL) {
+            //the command service is only allowed to be removed after all executions using it are done
+            celixThreadMutex_lock(&shell->mutex);
+            while (__atomic_load_n(&removed->useCount, __ATOMIC_ACQUIRE) > 0) {
+                celixThreadCondition_wait(&shell->cond, &shell->mutex);
+            }
+            celixThreadMutex_unlock(&shell->mutex);
+            free(removed->localName);
+            free(removed->namespace);
+            free(removed);
+        }
     }
 
     return status;
@@ -116,10 +168,8 @@ celix_status_t shell_getCommands(shell_t *shell, celix_array_list_t **outCommand
 	celix_array_list_t *result = celix_arrayList_create();
 
     celixThreadRwlock_readLock(&shell->lock);
-    hash_map_iterator_t iter = hashMapIterator_construct(shell->commandServices);
-    while (hashMapIterator_hasNext(&iter)) {
-        const char *name = hashMapIterator_nextKey(&iter);
-        celix_arrayList_add(result, strndup(name, 1024*1024*10));
+    CELIX_STRING_HASH_MAP_ITERATE(shell->commandServices, iter) {
+        celix_arrayList_add(result, celix_utils_strdup(iter.key));
     }
     celixThreadRwlock_unlock(&shell->lock);
 
@@ -133,7 +183,7 @@ celix_status_t shell_getCommandUsage(shell_t *shell, const char *commandName, ch
     celix_status_t status = CELIX_SUCCESS;
 
     celixThreadRwlock_readLock(&shell->lock);
-    celix_shell_command_entry_t *entry = hashMap_get(shell->commandServices, commandName);
+    celix_shell_command_entry_t *entry = celix_stringHashMap_get(shell->commandServices, commandName);
     if (entry != NULL) {
         const char *usage = celix_properties_get(entry->props, CELIX_SHELL_COMMAND_USAGE, "N/A");
         *outUsage = celix_utils_strdup(usage);
@@ -149,7 +199,7 @@ celix_status_t shell_getCommandDescription(shell_t *shell, const char *commandNa
     celix_status_t status = CELIX_SUCCESS;
 
     celixThreadRwlock_readLock(&shell->lock);
-    celix_shell_command_entry_t *entry = hashMap_get(shell->commandServices, commandName);
+    celix_shell_command_entry_t *entry = celix_stringHashMap_get(shell->commandServices, commandName);
     if (entry != NULL) {
         const char *desc = celix_properties_get(entry->props, CELIX_SHELL_COMMAND_DESCRIPTION, "N/A");
         *outDescription = celix_utils_strdup(desc);
@@ -161,34 +211,47 @@ celix_status_t shell_getCommandDescription(shell_t *shell, const char *commandNa
     return status;
 }
 
-static celix_shell_command_entry_t * shell_findEntry(shell_t *shell, const char *cmdName, FILE *err) {
-    //NOTE precondition shell->mutex locked
+/**
+ * @brief Finds the command entry for the provided command name and increases its use count.
+ *
+ * The shell lock is only held for the lookup, the returned entry stays valid until released with shell_releaseEntry.
+ */
+static celix_shell_command_entry_t * shell_findAndUseEntry(shell_t *shell, const char *cmdName, FILE *err) {
     celix_shell_command_entry_t *result = NULL;
     int entriesFound = 0;
-    const char *substr = strstr(cmdName, "::");
-    if (substr == NULL) {
-        //only local name given, need to search
-        hash_map_iterator_t iter = hashMapIterator_construct(shell->commandServices);
-        while (hashMapIterator_hasNext(&iter)) {
-            celix_shell_command_entry_t *visit = hashMapIterator_nextValue(&iter);
-            if (strncmp(visit->localName, cmdName, 1024) == 0) {
-                entriesFound ++;
-                result = visit;
-            }
+
+    celixThreadRwlock_readLock(&shell->lock);
+    if (strstr(cmdName, "::") == NULL) {
+        //only local name given, use the local name index
+        celix_array_list_t *entries = celix_stringHashMap_get(shell->localNameIndex, cmdName);
+        entriesFound = entries == NULL ? 0 : celix_arrayList_size(entries);
+        if (entriesFound == 1) {
+            result = celix_arrayList_get(entries, 0);
         }
     } else {
         //:: present, assuming fully qualified name given, can just lookup
-        result = hashMap_get(shell->commandServices, cmdName);
+        result = celix_stringHashMap_get(shell->commandServices, cmdName);
+    }
+    if (result != NULL) {
+        __atomic_add_fetch(&result->useCount, 1, __ATOMIC_ACQ_REL);
     }
+    celixThreadRwlock_unlock(&shell->lock);
 
     if (entriesFound > 1 ) {
         fprintf(err, "Got more than 1 command with the name '%s', found %i. Please use the fully qualified name for the requested command.\n", cmdName, entriesFound);
-        result = NULL;
     }
 
     return result;
 }
 
+static void shell_releaseEntry(shell_t *shell, celix_shell_command_entry_t *entry) {
+    if (__atomic_sub_fetch(&entry->useCount, 1, __ATOMIC_ACQ_REL) == 0) {
+        celixThreadMutex_lock(&shell->mutex);
+        celixThreadCondition_broadcast(&shell->cond);
+        celixThreadMutex_unlock(&shell->mutex);
+    }
+}
+
 celix_status_t shell_executeCommand(shell_t *shell, const char *commandLine, FILE *out, FILE *err) {
 	celix_status_t status = CELIX_SUCCESS;
 
@@ -196,18 +259,156 @@ celix_status_t shell_executeCommand(shell_t *shell, const char *commandLine, FIL
 
     char *commandName = (pos != strlen(commandLine)) ? strndup(commandLine, pos) : strdup(commandLine);
 
-
-    celixThreadRwlock_readLock(&shell->lock);
-    celix_shell_command_entry_t *entry = shell_findEntry(shell, commandName, err);
+    //note the command is executed without holding the shell lock, so that commands can run concurrently and
+    //command services can be added/removed while a (long) command is running.
+    celix_shell_command_entry_t *entry = shell_findAndUseEntry(shell, commandName, err);
     if (entry != NULL) {
         bool succeeded = entry->svc->executeCommand(entry->svc->handle, commandLine, out, err);
         status = succeeded ? CELIX_SUCCESS : CELIX_BUNDLE_EXCEPTION;
+        shell_releaseEntry(shell, entry);
     } else {
         fprintf(err, "No command '%s'. Provided command line: %s\n", commandName, commandLine);
         status = CELIX_BUNDLE_EXCEPTION;
     }
-    celixThreadRwlock_unlock(&shell->lock);
     free(commandName);
 
 	return status;
 }
+
+static void shell_forwardOutput(celix_shell_output_stream_t *stream, const char *buf, size_t size) {
+    if (size > 0) {
+        celix_shell_async_execution_t *execution = stream->execution;
+        execution->outputCallback(execution->callbackHandle, buf, size, stream->isError);
+    }
+}
+
+#ifdef __APPLE__
+static int shell_outputStreamWrite(void *cookie, const char *buf, int size) {
+    shell_forwardOutput(cookie, buf, size < 0 ? 0 : (size_t)size);
+    return size;
+}
+#else
+static ssize_t shell_outputStreamWrite(void *cookie, const char *buf, size_t size) {
+    shell_forwardOutput(cookie, buf, size);
+    return (ssize_t)size;
+}
+#endif
+
+static int shell_outputStreamClose(void *cookie) {
+    free(cookie);
+    return 0;
+}
+
+/**
+ * @brief Opens a line buffered FILE stream which forwards the written output to the output callback of the execution.
+ */
+static FILE* shell_openOutputStream(celix_shell_async_execution_t *execution, bool isError) {
+    celix_shell_output_stream_t *cookie = calloc(1, sizeof(*cookie));
+    if (cookie == NULL) {
+        return NULL;
+    }
+    cookie->execution = execution;
+    cookie->isError = isError;
+#ifdef __APPLE__
+    FILE *stream = funopen(cookie, NULL, shell_outputStreamWrite, NULL, shell_outputStreamClose);
+#else
+    cookie_io_functions_t functions = {.read = NULL, .write = shell_outputStreamWrite, .seek = NULL, .close = shell_outputStreamClose};
+    FILE *stream = fopencookie(cookie, "w", functions);
+#endif
+    if (stream == NULL) {
+        free(cookie);
+        return NULL;
+    }
+    setvbuf(stream, NULL, _IOLBF, BUFSIZ);
+    return stream;
+}
+
+static void* shell_runAsyncExecution(void *data) {
+    celix_shell_async_execution_t *execution = data;
+    shell_t *shell = execution->shell;
+
+    celix_status_t status;
+    FILE *out = shell_openOutputStream(execution, false);
+    FILE *err = shell_openOutputStream(execution, true);
+    if (out != NULL && err != NULL) {
+        status = shell_executeCommand(shell, execution->commandLine, out, err);
+    } else {
+        celix_logHelper_log(shell->logHelper, CELIX_LOG_LEVEL_ERROR, "Cannot create output streams for command '%s'", execution->commandLine);
+        status = CELIX_ENOMEM;
+    }
+    if (out != NULL) {
+        fclose(out);
+    }
+    if (err != NULL) {
+        fclose(err);
+    }
+    execution->doneCallback(execution->callbackHandle, status);
+
+    celixThreadMutex_lock(&shell->mutex);
+    execution->done = true;
+    celixThreadMutex_unlock(&shell->mutex);
+    return NULL;
+}
+
+/**
+ * @brief Joins and frees the async executions of the shell. If onlyDone is true, only finished executions are joined.
+ */
+static void shell_joinAsyncExecutions(shell_t *shell, bool onlyDone) {
+    celix_array_list_t *toJoin = celix_arrayList_create();
+    celixThreadMutex_lock(&shell->mutex);
+    for (int i = 0; i < celix_arrayList_size(shell->asyncExecutions);) {
+        celix_shell_async_execution_t *execution = celix_arrayList_get(shell->asyncExecutions, i);
+        if (!onlyDone || execution->done) {
+            celix_arrayList_add(toJoin, execution);
+            celix_arrayList_removeAt(shell->asyncExecutions, i);
+        } else {
+            ++i;
+        }
+    }
+    celixThreadMutex_unlock(&shell->mutex);
+
+    for (int i = 0; i < celix_arrayList_size(toJoin); ++i) {
+        celix_shell_async_execution_t *execution = celix_arrayList_get(toJoin, i);
+        celixThread_join(execution->thread, NULL);
+        free(execution->commandLine);
+        free(execution);
+    }
+    celix_arrayList_destroy(toJoin);
+}
+
+celix_status_t shell_executeCommandAsync(shell_t *shell, const char *commandLine, void *callbackHandle, celix_shell_output_callback_fp outputCallback, celix_shell_done_callback_fp doneCallback) {
+    if (commandLine == NULL || outputCallback == NULL || doneCallback == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    //cleanup finished executions, so that the administration does not grow
+    shell_joinAsyncExecutions(shell, true);
+
+    celix_shell_async_execution_t *execution = calloc(1, sizeof(*execution));
+    char *line = celix_utils_strdup(commandLine);
+    if (execution == NULL || line == NULL) {
+        free(execution);
+        free(line);
+        return CELIX_ENOMEM;
+    }
+    execution->shell = shell;
+    execution->commandLine = line;
+    execution->callbackHandle = callbackHandle;
+    execution->outputCallback = outputCallback;
+    execution->doneCallback = doneCallback;
+
+    celixThreadMutex_lock(&shell->mutex);
+    celix_status_t status = celixThread_create(&execution->thread, NULL, shell_runAsyncExecution, execution);
+    if (status == CELIX_SUCCESS) {
+        celixThread_setName(&execution->thread, "ShellCommand");
+        celix_arrayList_add(shell->asyncExecutions, execution);
+    }
+    celixThreadMutex_unlock(&shell->mutex);
+
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_log(shell->logHelper, CELIX_LOG_LEVEL_ERROR, "Cannot create thread for command '%s'", commandLine);
+        free(execution->commandLine);
+        free(execution);
+    }
+    return status;
+}
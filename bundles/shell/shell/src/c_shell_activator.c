@@ -88,6 +88,7 @@ celix_status_t celix_bundleActivator_start(void *activatorData, celix_bundle_con
     if (status == CELIX_SUCCESS) {
         activator->shellService.handle = activator->shell;
         activator->shellService.executeCommand = (void*)shell_executeCommand;
+        activator->shellService.executeCommandAsync = (void*)shell_executeCommandAsync;
         activator->shellService.getCommandDescription = (void*)shell_getCommandDescription;
         activator->shellService.getCommandUsage = (void*)shell_getCommandUsage;
         activator->shellService.getCommands = (void*)shell_getCommands;
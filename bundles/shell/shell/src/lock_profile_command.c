@@ -0,0 +1,81 @@
+/*
+ Licensed to the Apache Software Foundation (ASF) under one
+ or more contributor license agreements.  See the NOTICE file
+ distributed with this work for additional information
+ regarding copyright ownership.  The ASF licenses this file
+ to you under the Apache License, Version 2.0 (the
+ "License"); you may not use this file except in compliance
+ with the License.  You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+#include <string.h>
+
+#include "celix_compiler.h"
+#include "celix_convert_utils.h"
+#include "celix_err.h"
+#include "celix_lock_profiling.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_utils.h"
+#include "std_commands.h"
+
+#define CELIX_LOCK_PROFILE_COMMAND_DEFAULT_TOP 10
+
+static bool lockProfileCommand_printErrors(FILE* errStream) {
+    const char* msg;
+    while ((msg = celix_err_popLastError()) != NULL) {
+        fprintf(errStream, "%s\n", msg);
+    }
+    return false;
+}
+
+bool lockProfileCommand_execute(void* handle CELIX_UNUSED, const char* constCommandLine, FILE* outStream, FILE* errStream) {
+    char* savePtr = NULL;
+    celix_autofree char* command = celix_utils_strdup(constCommandLine);
+    if (command == NULL) {
+        fprintf(errStream, "Cannot copy command line.\n");
+        return false;
+    }
+    strtok_r(command, CELIX_SHELL_COMMAND_SEPARATOR, &savePtr); //ignore command name
+    const char* sub = strtok_r(NULL, CELIX_SHELL_COMMAND_SEPARATOR, &savePtr);
+    const char* arg = sub == NULL ? NULL : strtok_r(NULL, CELIX_SHELL_COMMAND_SEPARATOR, &savePtr);
+
+    if (sub == NULL || strcmp(sub, "top") == 0) {
+        long top = CELIX_LOCK_PROFILE_COMMAND_DEFAULT_TOP;
+        if (arg != NULL) {
+            bool converted;
+            top = celix_utils_convertStringToLong(arg, 0, &converted);
+            if (!converted || top <= 0) {
+                fprintf(errStream, "Cannot convert '%s' to a positive number of locks.\n", arg);
+                return false;
+            }
+        }
+        if (celix_lockProfiling_print(outStream, (size_t)top) != CELIX_SUCCESS) {
+            return lockProfileCommand_printErrors(errStream);
+        }
+    } else if (strcmp(sub, "on") == 0 || strcmp(sub, "off") == 0) {
+        bool enable = strcmp(sub, "on") == 0;
+        if (celix_lockProfiling_setEnabled(enable) != CELIX_SUCCESS) {
+            return lockProfileCommand_printErrors(errStream);
+        }
+        fprintf(outStream, "Lock profiling %s.\n", enable ? "enabled" : "disabled");
+    } else if (strcmp(sub, "reset") == 0) {
+        if (!celix_lockProfiling_isSupported()) {
+            fprintf(errStream, "Lock profiling is not supported.\n");
+            return false;
+        }
+        celix_lockProfiling_reset();
+        fprintf(outStream, "Lock profiling statistics reset.\n");
+    } else {
+        fprintf(errStream, "Unknown lock_profile argument '%s'.\n", sub);
+        return false;
+    }
+    return true;
+}
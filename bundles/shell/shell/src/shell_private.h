@@ -22,7 +22,7 @@
 
 #include "celix_bundle_context.h"
 #include "celix_shell.h"
-#include "hash_map.h"
+#include "celix_string_hash_map.h"
 #include "celix_shell_command.h"
 #include "celix_log_helper.h"
 #include "celix_threads.h"
@@ -33,13 +33,19 @@ typedef struct celix_shell_command_entry {
     const celix_properties_t *props;
     char *localName;
     char *namespace;
+    long useCount; //atomic, nr of executions using the command. A removed entry is freed when this drops to 0.
 } celix_shell_command_entry_t;
 
 struct shell {
 	celix_bundle_context_t *ctx;
     celix_log_helper_t *logHelper;
     celix_thread_rwlock_t lock; //protects below
-    hash_map_t *commandServices; //key = char* (fully qualified command name), value = celix_shell_command_entry_t*
+    celix_string_hash_map_t *commandServices; //key = fully qualified command name, value = celix_shell_command_entry_t*
+    celix_string_hash_map_t *localNameIndex; //key = local command name, value = celix_array_list_t* of celix_shell_command_entry_t*
+
+    celix_thread_mutex_t mutex; //protects below and is used to wait for entry use counts
+    celix_thread_cond_t cond;
+    celix_array_list_t *asyncExecutions; //celix_shell_async_execution_t*
 };
 typedef struct shell shell_t;
 
@@ -49,6 +55,7 @@ celix_status_t shell_addCommand(shell_t *shell, celix_shell_command_t *svc, cons
 celix_status_t shell_removeCommand(shell_t *shell, celix_shell_command_t *svc, const celix_properties_t *props);
 
 celix_status_t shell_executeCommand(shell_t *shell, const char *commandLine, FILE *out, FILE *err);
+celix_status_t shell_executeCommandAsync(shell_t *shell, const char *commandLine, void *callbackHandle, celix_shell_output_callback_fp outputCallback, celix_shell_done_callback_fp doneCallback);
 
 celix_status_t shell_getCommands(shell_t *shell, celix_array_list_t **commands);
 celix_status_t shell_getCommandUsage(shell_t *shell, const char *commandName, char **outUsage);
@@ -0,0 +1,132 @@
+/*
+ Licensed to the Apache Software Foundation (ASF) under one
+ or more contributor license agreements.  See the NOTICE file
+ distributed with this work for additional information
+ regarding copyright ownership.  The ASF licenses this file
+ to you under the Apache License, Version 2.0 (the
+ "License"); you may not use this file except in compliance
+ with the License.  You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+#include <string.h>
+
+#include "celix_bundle_context.h"
+#include "celix_constants.h"
+#include "celix_metrics_provider.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_utils.h"
+#include "std_commands.h"
+
+typedef struct stats_command_collect_data {
+    FILE* outStream;
+    bool prometheus;
+    char* const* providerNames;
+    int nrOfProviderNames;
+    char* lastMetricName;
+    int nrOfProviders;
+    bool failed;
+} stats_command_collect_data_t;
+
+static void statsCommand_writeMetric(void* handle, const celix_metric_t* metric) {
+    stats_command_collect_data_t* data = handle;
+    if (data->prometheus) {
+        bool writeHeader = data->lastMetricName == NULL || strcmp(data->lastMetricName, metric->name) != 0;
+        if (writeHeader) {
+            free(data->lastMetricName);
+            data->lastMetricName = celix_utils_strdup(metric->name);
+        }
+        data->failed = celix_metrics_writePrometheus(data->outStream, metric, writeHeader) != CELIX_SUCCESS || data->failed;
+    } else {
+        fputs("   ", data->outStream);
+        data->failed = celix_metrics_writeText(data->outStream, metric) != CELIX_SUCCESS || data->failed;
+    }
+}
+
+static bool statsCommand_isSelectedProvider(stats_command_collect_data_t* data, const char* providerName) {
+    if (data->nrOfProviderNames == 0) {
+        return true;
+    }
+    for (int i = 0; i < data->nrOfProviderNames; ++i) {
+        if (providerName != NULL && strcmp(data->providerNames[i], providerName) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void statsCommand_collect(void* handle, void* svc, const celix_properties_t* props) {
+    stats_command_collect_data_t* data = handle;
+    celix_metrics_provider_t* provider = svc;
+    const char* providerName = celix_properties_get(props, CELIX_METRICS_PROVIDER_NAME, NULL);
+    if (!statsCommand_isSelectedProvider(data, providerName)) {
+        return;
+    }
+    data->nrOfProviders += 1;
+    if (!data->prometheus) {
+        fprintf(data->outStream,
+                "Metrics provider '%s' (bundle id %li):\n",
+                providerName == NULL ? "<unnamed>" : providerName,
+                celix_properties_getAsLong(props, CELIX_FRAMEWORK_SERVICE_BUNDLE_ID, -1L));
+    }
+    if (provider->collectMetrics(provider->handle, data, statsCommand_writeMetric) != CELIX_SUCCESS) {
+        data->failed = true;
+    }
+}
+
+bool statsCommand_execute(void* handle, const char* constCommandLine, FILE* outStream, FILE* errStream) {
+    celix_bundle_context_t* ctx = handle;
+    char* savePtr = NULL;
+    celix_autofree char* command = celix_utils_strdup(constCommandLine);
+    if (command == NULL) {
+        fprintf(errStream, "Cannot copy command line.\n");
+        return false;
+    }
+
+    char* providerNames[16];
+    stats_command_collect_data_t data = {.outStream = outStream, .providerNames = providerNames};
+    strtok_r(command, CELIX_SHELL_COMMAND_SEPARATOR, &savePtr); //ignore command name
+    for (char* arg = strtok_r(NULL, CELIX_SHELL_COMMAND_SEPARATOR, &savePtr); arg != NULL;
+         arg = strtok_r(NULL, CELIX_SHELL_COMMAND_SEPARATOR, &savePtr)) {
+        if (strcmp(arg, "-p") == 0 || strcmp(arg, "prometheus") == 0) {
+            data.prometheus = true;
+        } else if (data.nrOfProviderNames < (int)(sizeof(providerNames) / sizeof(providerNames[0]))) {
+            providerNames[data.nrOfProviderNames++] = arg;
+        } else {
+            fprintf(errStream, "Too many metrics provider names.\n");
+            return false;
+        }
+    }
+
+    celix_service_tracking_options_t trkOpts = CELIX_EMPTY_SERVICE_TRACKING_OPTIONS;
+    trkOpts.filter.serviceName = CELIX_METRICS_PROVIDER_SERVICE_NAME;
+    trkOpts.filter.versionRange = "[1.0.0,2)";
+    long trkId = celix_bundleContext_trackServicesWithOptions(ctx, &trkOpts);
+    if (trkId < 0) {
+        fprintf(errStream, "Error tracking metrics provider services\n");
+        return false;
+    }
+
+    celix_tracked_service_use_options_t useOpts = CELIX_EMPTY_TRACKER_SERVICE_USE_OPTIONS;
+    useOpts.callbackHandle = &data;
+    useOpts.useWithProperties = statsCommand_collect;
+    celix_bundleContext_useTrackedServicesWithOptions(ctx, trkId, &useOpts);
+    celix_bundleContext_stopTracker(ctx, trkId);
+    free(data.lastMetricName);
+
+    if (data.nrOfProviders == 0) {
+        fprintf(errStream, "No (matching) metrics providers found.\n");
+        return false;
+    } else if (data.failed) {
+        fprintf(errStream, "Error collecting or writing metrics.\n");
+        return false;
+    }
+    return true;
+}
@@ -25,7 +25,7 @@
 #include "celix_constants.h"
 #include "celix_shell_command.h"
 
-#define NUMBER_OF_COMMANDS 13
+#define NUMBER_OF_COMMANDS 15
 
 struct celix_shell_command_register_entry {
     bool (*exec)(void *handle, const char *commandLine, FILE *out, FILE *err);
@@ -140,6 +140,25 @@ celix_std_commands_t* celix_stdCommands_create(celix_bundle_context_t* ctx) {
             .usage = "unload <id> [<id> ...]"
         };
     commands->std_commands[12] =
+        (struct celix_shell_command_register_entry) {
+            .exec = lockProfileCommand_execute,
+            .name = "celix::lock_profile",
+            .description = "Show the most contended locks or control lock profiling." \
+                    "\nRequires Celix to be build with CELIX_THREADS_LOCK_PROFILING=ON." \
+                    "\nUse on/off to enable/disable lock profiling and reset to clear the statistics." \
+                    "\nWithout arguments or with top, the (n, default 10) most contended locks are printed.",
+            .usage = "lock_profile [on | off | reset | top [n]]"
+        };
+    commands->std_commands[13] =
+        (struct celix_shell_command_register_entry) {
+            .exec = statsCommand_execute,
+            .name = "celix::stats",
+            .description = "Show the runtime statistics of the registered metrics providers (e.g. framework, event admin)." \
+                    "\nIf provider names are provided, only the metrics of the matching providers are printed." \
+                    "\nUse -p to print the metrics in the Prometheus text format.",
+            .usage = "stats [-p] [provider ...]"
+        };
+    commands->std_commands[14] =
             (struct celix_shell_command_register_entry) {
                     .exec = NULL
             };
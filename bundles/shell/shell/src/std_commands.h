@@ -58,6 +58,10 @@ bool dmListCommand_execute(void *handle, const char *commandLine, FILE *out, FIL
 
 bool quitCommand_execute(void *handle, const char *commandLine, FILE *sout, FILE *serr);
 
+bool lockProfileCommand_execute(void *handle, const char *commandLine, FILE *outStream, FILE *errStream);
+
+bool statsCommand_execute(void *handle, const char *commandLine, FILE *outStream, FILE *errStream);
+
 #ifdef __cplusplus
 }
 #endif
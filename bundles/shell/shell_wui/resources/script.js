@@ -23,18 +23,24 @@ function docReady() {
     var host = window.location.host;
     var shellSocket = new WebSocket("ws://" + host + "/shell/socket");
 
+    //command output is streamed in multiple messages, the output is cleared when a new command is sent
+    var sendCommand = function (command) {
+        document.getElementById("console_output").innerHTML = "";
+        shellSocket.send(command);
+    };
+
     shellSocket.onmessage = function (event) {
         var html = ansi_up.ansi_to_html(event.data);
-        document.getElementById("console_output").innerHTML = html;
+        document.getElementById("console_output").innerHTML += html;
     };
     shellSocket.onopen = function (event) {
-        shellSocket.send("lb");
+        sendCommand("lb");
     };
 
     document.getElementById("command_button").onclick = function() {
         input = document.getElementById("command_input").value;
     document.getElementById("command_input").value = "";
-        shellSocket.send(input);
+        sendCommand(input);
     };
 
     var input = document.getElementById("command_input");
@@ -21,7 +21,9 @@
 #include <stdio.h>
 
 #include "celix_bundle_activator.h"
+#include "celix_compiler.h"
 #include "celix_shell.h"
+#include "celix_threads.h"
 #include "civetweb.h"
 #include "http_admin/api.h"
 
@@ -30,28 +32,62 @@ typedef struct shell_wui_activator_data {
 
     celix_websocket_service_t sockSvc;
     long sockSvcId;
+
+    celix_http_service_t metricsSvc;
+    long metricsSvcId;
 } shell_wui_activator_data_t;
 
 struct use_shell_arg {
     char *command;
     struct mg_connection *conn;
+
+    celix_thread_mutex_t mutex; //protects below
+    celix_thread_cond_t cond;
+    bool done;
 };
 
+static void shellWui_writeOutput(void *handle, const char *output, size_t outputLen, bool isError CELIX_UNUSED) {
+    struct use_shell_arg *arg = handle;
+    mg_websocket_write(arg->conn, MG_WEBSOCKET_OPCODE_TEXT, output, outputLen);
+}
+
+static void shellWui_commandDone(void *handle, celix_status_t status CELIX_UNUSED) {
+    struct use_shell_arg *arg = handle;
+    celixThreadMutex_lock(&arg->mutex);
+    arg->done = true;
+    celixThreadCondition_broadcast(&arg->cond);
+    celixThreadMutex_unlock(&arg->mutex);
+}
+
 static void useShell(void *handle, void *svc) {
     celix_shell_t *shell = svc;
     struct use_shell_arg *arg = handle;
+    if (shell->executeCommandAsync != NULL) {
+        //stream the output to the websocket while the command is running
+        celix_status_t status = shell->executeCommandAsync(shell->handle, arg->command, arg, shellWui_writeOutput, shellWui_commandDone);
+        celixThreadMutex_lock(&arg->mutex);
+        while (status == CELIX_SUCCESS && !arg->done) {
+            celixThreadCondition_wait(&arg->cond, &arg->mutex);
+        }
+        celixThreadMutex_unlock(&arg->mutex);
+        return;
+    }
     char *buf = NULL;
     size_t size;
     FILE *out = open_memstream(&buf, &size);
     shell->executeCommand(shell->handle, arg->command, out, out);
     fclose(out);
     mg_websocket_write(arg->conn, MG_WEBSOCKET_OPCODE_TEXT, buf, size);
+    free(buf);
 };
 
 static int websocket_data_handler(struct mg_connection *conn, int bits, char *data, size_t data_len, void *handle) {
     shell_wui_activator_data_t *act = handle;
     struct use_shell_arg arg;
+    memset(&arg, 0, sizeof(arg));
     arg.conn = conn;
+    celixThreadMutex_create(&arg.mutex, NULL);
+    celixThreadCondition_init(&arg.cond, NULL);
 
     //NOTE data is a not null terminated string..
     arg.command = calloc(data_len+1, sizeof(char));
@@ -66,9 +102,50 @@ static int websocket_data_handler(struct mg_connection *conn, int bits, char *da
     }
 
     free(arg.command);
+    celixThreadCondition_destroy(&arg.cond);
+    celixThreadMutex_destroy(&arg.mutex);
     return 1; //keep open
 }
 
+struct use_shell_metrics_arg {
+    char *buf;
+    size_t size;
+    celix_status_t status;
+};
+
+static void useShellForMetrics(void *handle, void *svc) {
+    celix_shell_t *shell = svc;
+    struct use_shell_metrics_arg *arg = handle;
+    FILE *out = open_memstream(&arg->buf, &arg->size);
+    if (out == NULL) {
+        arg->status = CELIX_ENOMEM;
+        return;
+    }
+    arg->status = shell->executeCommand(shell->handle, "celix::stats -p", out, stderr);
+    fclose(out);
+}
+
+/**
+ * Serves the metrics of all metrics providers in the Prometheus text format, so that the Celix runtime
+ * statistics can be scraped using http://<host>:<port>/shell/metrics.
+ */
+static int metrics_get_handler(void *handle, struct mg_connection *conn, const char *path CELIX_UNUSED) {
+    shell_wui_activator_data_t *act = handle;
+    struct use_shell_metrics_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    bool called = celix_bundleContext_useService(act->ctx, CELIX_SHELL_SERVICE_NAME, &arg, useShellForMetrics);
+    if (!called || arg.status != CELIX_SUCCESS) {
+        free(arg.buf);
+        mg_send_http_error(conn, 503, "%s", called ? "Cannot collect metrics" : "No shell available!");
+        return 503;
+    }
+    mg_printf(conn,
+              "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+              "Content-Length: %zu\r\nConnection: close\r\n\r\n", arg.size);
+    mg_write(conn, arg.buf, arg.size);
+    free(arg.buf);
+    return 200;
+}
 
 static celix_status_t shellWui_activator_start(shell_wui_activator_data_t *data, celix_bundle_context_t *ctx) {
     data->ctx = ctx;
@@ -79,11 +156,18 @@ static celix_status_t shellWui_activator_start(shell_wui_activator_data_t *data,
     data->sockSvc.data = websocket_data_handler;
     data->sockSvcId = celix_bundleContext_registerService(ctx, &data->sockSvc, WEBSOCKET_ADMIN_SERVICE_NAME, props);
 
+    props = celix_properties_create();
+    celix_properties_set(props, HTTP_ADMIN_URI, "/shell/metrics");
+    data->metricsSvc.handle = data;
+    data->metricsSvc.doGet = metrics_get_handler;
+    data->metricsSvcId = celix_bundleContext_registerService(ctx, &data->metricsSvc, HTTP_ADMIN_SERVICE_NAME, props);
+
     return CELIX_SUCCESS;
 }
 
 static celix_status_t shellWui_activator_stop(shell_wui_activator_data_t *data, celix_bundle_context_t *ctx) {
 
+    celix_bundleContext_unregisterService(ctx, data->metricsSvcId);
     celix_bundleContext_unregisterService(ctx, data->sockSvcId);
 
     return CELIX_SUCCESS;
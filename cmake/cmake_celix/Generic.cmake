@@ -162,3 +162,59 @@ function(celix_target_hide_symbols)
                 VISIBILITY_INLINES_HIDDEN ON)
     endif ()
 endfunction()
+
+#[[
+Generate typed JSON-RPC stubs for one or more DFI interface descriptors and add them to the provided target.
+
+```CMake
+celix_target_generate_json_rpc_stubs(<cmake_target> DESCRIPTORS <descriptor> [<descriptor> ...])
+```
+
+For every descriptor the `Celix::dfi_json_rpc_stub_gen` generator is run at build time. The generated sources are
+added to the target and the generated headers are made available on the include path of the target. The target is
+linked against `Celix::dfi`.
+
+The generated header for a descriptor `<name>.descriptor` is `<prefix>_json_rpc_stub.h` and declares a
+`const json_rpc_stub_t <prefix>_jsonRpcStub`, where `<prefix>` is the descriptor file name without extension and with
+all non C identifier characters replaced by `_`.
+
+Only descriptors with simple (numeric and boolean) and text arguments are supported; for other descriptors the
+generator fails and the dynamic (libffi based) JSON-RPC implementation should be used.
+
+Example:
+```CMake
+celix_target_generate_json_rpc_stubs(my_bundle DESCRIPTORS ${CMAKE_CURRENT_SOURCE_DIR}/org.example.Calculator.descriptor)
+```
+]]
+function(celix_target_generate_json_rpc_stubs)
+    list(GET ARGN 0 TARGET_NAME)
+    list(REMOVE_AT ARGN 0)
+
+    set(OPTIONS )
+    set(ONE_VAL_ARGS )
+    set(MULTI_VAL_ARGS DESCRIPTORS)
+    cmake_parse_arguments(STUBS "${OPTIONS}" "${ONE_VAL_ARGS}" "${MULTI_VAL_ARGS}" ${ARGN})
+
+    if (NOT STUBS_DESCRIPTORS)
+        message(FATAL_ERROR "Missing required DESCRIPTORS argument")
+    endif ()
+
+    set(GEN_DIR "${CMAKE_CURRENT_BINARY_DIR}/celix/gen/json_rpc_stubs/${TARGET_NAME}")
+    foreach (DESCRIPTOR IN LISTS STUBS_DESCRIPTORS)
+        get_filename_component(DESCRIPTOR_PATH ${DESCRIPTOR} ABSOLUTE)
+        get_filename_component(PREFIX ${DESCRIPTOR} NAME_WLE)
+        string(MAKE_C_IDENTIFIER ${PREFIX} PREFIX)
+        set(GEN_HEADER "${GEN_DIR}/${PREFIX}_json_rpc_stub.h")
+        set(GEN_SOURCE "${GEN_DIR}/${PREFIX}_json_rpc_stub.c")
+        add_custom_command(OUTPUT ${GEN_HEADER} ${GEN_SOURCE}
+                COMMAND ${CMAKE_COMMAND} -E make_directory ${GEN_DIR}
+                COMMAND $<TARGET_FILE:Celix::dfi_json_rpc_stub_gen> ${DESCRIPTOR_PATH} ${GEN_HEADER} ${GEN_SOURCE} ${PREFIX}
+                DEPENDS ${DESCRIPTOR_PATH} Celix::dfi_json_rpc_stub_gen
+                COMMENT "Generating JSON-RPC stub for ${DESCRIPTOR}"
+                VERBATIM
+        )
+        target_sources(${TARGET_NAME} PRIVATE ${GEN_SOURCE})
+    endforeach ()
+    target_include_directories(${TARGET_NAME} PRIVATE ${GEN_DIR})
+    target_link_libraries(${TARGET_NAME} PRIVATE Celix::dfi)
+endfunction()
@@ -81,7 +81,9 @@ class CelixConan(ConanFile):
         "build_rcm": False,
         "build_utils": False,
         "build_event_admin": False,
+        "build_config_admin": False,
         "build_event_admin_examples": False,
+        "build_event_admin_remote_provider_shm": False,
         "celix_cxx14": True,
         "celix_cxx17": True,
         "celix_install_deprecated_api": False,
@@ -89,6 +91,7 @@ class CelixConan(ConanFile):
         "enable_cmake_warning_tests": False,
         "enable_testing_on_ci": False,
         "framework_curlinit": True,
+        "celix_threads_lock_profiling": False,
         "enable_ccache": False,
         "enable_deprecated_warnings": False,
     }
@@ -129,6 +132,12 @@ class CelixConan(ConanFile):
         if self.options.build_rsa_discovery_zeroconf and self.settings.os != "Linux":
             raise ConanInvalidConfiguration("Celix build_rsa_discovery_zeroconf is only supported for Linux")
 
+        if self.options.build_event_admin_remote_provider_shm and self.settings.os != "Linux":
+            raise ConanInvalidConfiguration("Celix build_event_admin_remote_provider_shm is only supported for Linux")
+
+        if self.options.build_remote_shell and self.settings.os != "Linux":
+            raise ConanInvalidConfiguration("Celix build_remote_shell is only supported for Linux")
+
         self.validate_config_option_is_positive_number("celix_err_buffer_size")
         self.validate_config_option_is_positive_number("celix_utils_max_strlen")
         self.validate_config_option_is_positive_number("celix_properties_optimization_string_buffer_size")
@@ -167,6 +176,8 @@ class CelixConan(ConanFile):
         if self.settings.os != "Linux":
             options["build_rsa_remote_service_admin_shm_v2"] = False
             options["build_rsa_discovery_zeroconf"] = False
+            options["build_event_admin_remote_provider_shm"] = False
+            options["build_remote_shell"] = False
 
         if options["enable_code_coverage"]:
             options["enable_testing"] = True
@@ -215,9 +226,17 @@ class CelixConan(ConanFile):
             options["build_shell_tui"] = True
             options["build_launcher"] = True
 
+        if options["build_event_admin_remote_provider_shm"]:
+            options["build_event_admin"] = True
+
         if options["build_event_admin"]:
             options["build_framework"] = True
             options["build_log_helper"] = True
+            options["build_shell_api"] = True
+
+        if options["build_config_admin"]:
+            options["build_framework"] = True
+            options["build_log_helper"] = True
 
         if options["build_remote_shell"]:
             options["build_shell"] = True
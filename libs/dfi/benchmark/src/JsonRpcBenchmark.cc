@@ -0,0 +1,196 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "stub_example_json_rpc_stub.h"
+#include "dyn_interface.h"
+#include "dyn_function.h"
+#include "json_rpc.h"
+
+extern "C" {
+
+//matches the service layout of stub_example.descriptor
+struct stub_example_service {
+    void* handle;
+    int (*add)(void* handle, double a, double b, double* out);
+    int (*scale)(void* handle, int32_t a, int64_t b, float c, int64_t* out);
+    int (*isEven)(void* handle, uint64_t a, bool* out);
+    int (*concat)(void* handle, const char* a, char* b, char** out);
+    int (*setName)(void* handle, char* name);
+    int (*getName)(void* handle, char** out);
+    int (*reset)(void* handle);
+};
+
+}
+
+/**
+ * Compares the dynamic (dyn_type + libffi) JSON-RPC implementation with the generated typed stubs.
+ */
+class JsonRpcBenchmark {
+public:
+    JsonRpcBenchmark() {
+        FILE* desc = fopen(STUB_EXAMPLE_DESCRIPTOR, "r");
+        if (desc == nullptr || dynInterface_parse(desc, &intf) != 0) {
+            std::cerr << "ERROR: cannot parse " << STUB_EXAMPLE_DESCRIPTOR << std::endl;
+        }
+        if (desc != nullptr) {
+            fclose(desc);
+        }
+        svc.add = [](void*, double a, double b, double* out) -> int {
+            *out = a + b;
+            return 0;
+        };
+        svc.concat = [](void*, const char* a, char* b, char** out) -> int {
+            size_t lenA = strlen(a);
+            size_t lenB = strlen(b);
+            *out = (char*)malloc(lenA + lenB + 1);
+            memcpy(*out, a, lenA);
+            memcpy(*out + lenA, b, lenB + 1);
+            free(b);
+            return 0;
+        };
+        proxyHandle.send = [](void*, const char* methodName, const char*, char** reply) -> celix_status_t {
+            *reply = strdup(strcmp(methodName, "add") == 0 ? R"({"r":3.75})" : R"({"r":"hello world"})");
+            return CELIX_SUCCESS;
+        };
+        proxy.handle = &proxyHandle;
+        for (size_t i = 0; i < stub->nrOfMethods; ++i) {
+            ((void (**)(void))&proxy.add)[i] = stub->proxyMethods[i];
+        }
+    }
+
+    ~JsonRpcBenchmark() {
+        dynInterface_destroy(intf);
+    }
+
+    JsonRpcBenchmark(JsonRpcBenchmark&&) = delete;
+    JsonRpcBenchmark& operator=(JsonRpcBenchmark&&) = delete;
+
+    const dyn_function_type* findFunction(const char* id) const {
+        const struct method_entry* entry = dynInterface_findMethod(intf, id);
+        return entry == nullptr ? nullptr : entry->dynFunc;
+    }
+
+    const json_rpc_stub_t* stub{&stub_example_jsonRpcStub};
+    dyn_interface_type* intf{nullptr};
+    stub_example_service svc{};
+    json_rpc_stub_proxy_t proxyHandle{};
+    stub_example_service proxy{};
+};
+
+static constexpr const char* ADD_REQUEST = R"({"m":"add(DD)D","a":[1.5,2.25]})";
+static constexpr const char* CONCAT_REQUEST = R"({"m":"concat(tt)t","a":["hello ","world"]})";
+
+static void JsonRpcBenchmark_callAddDynamic(benchmark::State& state) {
+    JsonRpcBenchmark benchmark{};
+    for (auto _ : state) {
+        char* reply = nullptr;
+        if (jsonRpc_call(benchmark.intf, &benchmark.svc, ADD_REQUEST, &reply) != 0) {
+            std::cerr << "ERROR: call failed" << std::endl;
+        }
+        free(reply);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void JsonRpcBenchmark_callAddStub(benchmark::State& state) {
+    JsonRpcBenchmark benchmark{};
+    for (auto _ : state) {
+        char* reply = nullptr;
+        if (benchmark.stub->call(&benchmark.svc, ADD_REQUEST, &reply) != 0) {
+            std::cerr << "ERROR: call failed" << std::endl;
+        }
+        free(reply);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void JsonRpcBenchmark_callConcatDynamic(benchmark::State& state) {
+    JsonRpcBenchmark benchmark{};
+    for (auto _ : state) {
+        char* reply = nullptr;
+        if (jsonRpc_call(benchmark.intf, &benchmark.svc, CONCAT_REQUEST, &reply) != 0) {
+            std::cerr << "ERROR: call failed" << std::endl;
+        }
+        free(reply);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void JsonRpcBenchmark_callConcatStub(benchmark::State& state) {
+    JsonRpcBenchmark benchmark{};
+    for (auto _ : state) {
+        char* reply = nullptr;
+        if (benchmark.stub->call(&benchmark.svc, CONCAT_REQUEST, &reply) != 0) {
+            std::cerr << "ERROR: call failed" << std::endl;
+        }
+        free(reply);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void JsonRpcBenchmark_proxyAddDynamic(benchmark::State& state) {
+    JsonRpcBenchmark benchmark{};
+    const dyn_function_type* func = benchmark.findFunction("add(DD)D");
+    for (auto _ : state) {
+        //same steps as the libffi closure of a remote service proxy, without the closure call itself
+        void* handle = nullptr;
+        double a = 1.5;
+        double b = 2.25;
+        double result = 0.0;
+        double* resultPtr = &result;
+        void* args[4] = {&handle, &a, &b, &resultPtr};
+        char* request = nullptr;
+        char* reply = nullptr;
+        int rsErrno = 0;
+        if (jsonRpc_prepareInvokeRequest(func, "add(DD)D", args, &request) != 0 ||
+            benchmark.proxyHandle.send(nullptr, "add", request, &reply) != CELIX_SUCCESS ||
+            jsonRpc_handleReply(func, reply, args, &rsErrno) != 0 || result != 3.75) {
+            std::cerr << "ERROR: proxy call failed" << std::endl;
+        }
+        free(request);
+        free(reply);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void JsonRpcBenchmark_proxyAddStub(benchmark::State& state) {
+    JsonRpcBenchmark benchmark{};
+    for (auto _ : state) {
+        double result = 0.0;
+        if (benchmark.proxy.add(benchmark.proxy.handle, 1.5, 2.25, &result) != CELIX_SUCCESS || result != 3.75) {
+            std::cerr << "ERROR: proxy call failed" << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond)
+
+CELIX_BENCHMARK(JsonRpcBenchmark_callAddDynamic);
+CELIX_BENCHMARK(JsonRpcBenchmark_callAddStub);
+CELIX_BENCHMARK(JsonRpcBenchmark_callConcatDynamic);
+CELIX_BENCHMARK(JsonRpcBenchmark_callConcatStub);
+CELIX_BENCHMARK(JsonRpcBenchmark_proxyAddDynamic);
+CELIX_BENCHMARK(JsonRpcBenchmark_proxyAddStub);
@@ -0,0 +1,223 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "stub_example_json_rpc_stub.h"
+#include "dyn_interface.h"
+#include "json_rpc.h"
+#include "celix_err.h"
+
+extern "C" {
+
+//matches the service layout of stub_example.descriptor
+struct stub_example_service {
+    void* handle;
+    int (*add)(void* handle, double a, double b, double* out);
+    int (*scale)(void* handle, int32_t a, int64_t b, float c, int64_t* out);
+    int (*isEven)(void* handle, uint64_t a, bool* out);
+    int (*concat)(void* handle, const char* a, char* b, char** out);
+    int (*setName)(void* handle, char* name);
+    int (*getName)(void* handle, char** out);
+    int (*reset)(void* handle);
+};
+
+}
+
+class JsonRpcStubTestSuite : public ::testing::Test {
+public:
+    JsonRpcStubTestSuite() {
+        FILE* desc = fopen("descriptors/stub_example.descriptor", "r");
+        EXPECT_TRUE(desc != nullptr);
+        int rc = dynInterface_parse(desc, &intf);
+        fclose(desc);
+        EXPECT_EQ(0, rc);
+
+        svc.handle = this;
+        svc.add = [](void*, double a, double b, double* out) -> int {
+            *out = a + b;
+            return 0;
+        };
+        svc.scale = [](void*, int32_t a, int64_t b, float c, int64_t* out) -> int {
+            *out = (int64_t)((float)(a * b) * c);
+            return 0;
+        };
+        svc.isEven = [](void*, uint64_t a, bool* out) -> int {
+            *out = a % 2 == 0;
+            return 0;
+        };
+        svc.concat = [](void*, const char* a, char* b, char** out) -> int {
+            std::string result = std::string{a == nullptr ? "" : a} + std::string{b == nullptr ? "" : b};
+            free(b);
+            *out = strdup(result.c_str());
+            return 0;
+        };
+        svc.setName = [](void* handle, char* name) -> int {
+            auto* self = static_cast<JsonRpcStubTestSuite*>(handle);
+            free(self->name);
+            self->name = name;
+            return 0;
+        };
+        svc.getName = [](void* handle, char** out) -> int {
+            auto* self = static_cast<JsonRpcStubTestSuite*>(handle);
+            if (self->name == nullptr) {
+                return CELIX_ILLEGAL_STATE;
+            }
+            *out = strdup(self->name);
+            return 0;
+        };
+        svc.reset = [](void* handle) -> int {
+            auto* self = static_cast<JsonRpcStubTestSuite*>(handle);
+            free(self->name);
+            self->name = nullptr;
+            return 0;
+        };
+
+        proxyHandle.handle = this;
+        proxyHandle.send = [](void* handle, const char*, const char* request, char** reply) -> celix_status_t {
+            auto* self = static_cast<JsonRpcStubTestSuite*>(handle);
+            return self->stub->call(&self->svc, request, reply) == 0 ? CELIX_SUCCESS : CELIX_SERVICE_EXCEPTION;
+        };
+        proxy.handle = &proxyHandle;
+        for (size_t i = 0; i < stub->nrOfMethods; ++i) {
+            ((void (**)(void))&proxy.add)[i] = stub->proxyMethods[i];
+        }
+    }
+
+    ~JsonRpcStubTestSuite() override {
+        free(name);
+        dynInterface_destroy(intf);
+        celix_err_resetErrors();
+    }
+
+    void expectSameReply(const char* request) {
+        char* stubReply = nullptr;
+        char* dynReply = nullptr;
+        //both calls must start from the same service state
+        char* nameBeforeCall = name == nullptr ? nullptr : strdup(name);
+        int stubRc = stub->call(&svc, request, &stubReply);
+        free(name);
+        name = nameBeforeCall;
+        int dynRc = jsonRpc_call(intf, &svc, request, &dynReply);
+        EXPECT_EQ(dynRc, stubRc) << request;
+        if (stubReply != nullptr && dynReply != nullptr) {
+            EXPECT_STREQ(dynReply, stubReply) << request;
+        } else {
+            EXPECT_EQ(dynReply, stubReply) << request;
+        }
+        free(stubReply);
+        free(dynReply);
+    }
+
+    const json_rpc_stub_t* stub{&stub_example_jsonRpcStub};
+    dyn_interface_type* intf{nullptr};
+    char* name{nullptr};
+    stub_example_service svc{};
+    json_rpc_stub_proxy_t proxyHandle{};
+    stub_example_service proxy{};
+};
+
+TEST_F(JsonRpcStubTestSuite, StubMetadataTest) {
+    EXPECT_STREQ(dynInterface_getName(intf), stub->interfaceName);
+    EXPECT_STREQ(dynInterface_getVersionString(intf), stub->interfaceVersion);
+    EXPECT_EQ((size_t)dynInterface_nrOfMethods(intf), stub->nrOfMethods);
+}
+
+TEST_F(JsonRpcStubTestSuite, CallIsWireCompatibleWithDynamicCallTest) {
+    expectSameReply(R"({"m":"add(DD)D","a":[1.5,2.25]})");
+    expectSameReply(R"({"m":"scale(IJF)J","a":[-3,100000000000,0.5]})");
+    expectSameReply(R"({"m":"isEven(j)Z","a":[42]})");
+    expectSameReply(R"({"m":"isEven(j)Z","a":[43]})");
+    expectSameReply(R"({"m":"concat(tt)t","a":["hello ","world"]})");
+    expectSameReply(R"({"m":"concat(tt)t","a":[null,"world"]})");
+    expectSameReply(R"({"m":"setName(t)V","a":["celix"]})");
+    expectSameReply(R"({"m":"getName()t","a":[]})");
+    expectSameReply(R"({"m":"reset()V","a":[]})");
+}
+
+TEST_F(JsonRpcStubTestSuite, CallWithInvalidRequestTest) {
+    char* reply = nullptr;
+    EXPECT_NE(0, stub->call(&svc, "invalid", &reply));
+    EXPECT_NE(0, stub->call(&svc, R"({"a":[]})", &reply));
+    EXPECT_NE(0, stub->call(&svc, R"({"m":"add(DD)D"})", &reply));
+    EXPECT_NE(0, stub->call(&svc, R"({"m":"unknown()V","a":[]})", &reply));
+    EXPECT_NE(0, stub->call(&svc, R"({"m":"add(DD)D","a":[1.0]})", &reply));
+    EXPECT_NE(0, stub->call(&svc, R"({"m":"concat(tt)t","a":["a",1]})", &reply));
+    EXPECT_EQ(nullptr, reply);
+}
+
+TEST_F(JsonRpcStubTestSuite, ProxyLoopbackTest) {
+    double sum = 0.0;
+    EXPECT_EQ(CELIX_SUCCESS, proxy.add(proxy.handle, 1.5, 2.25, &sum));
+    EXPECT_DOUBLE_EQ(3.75, sum);
+
+    int64_t scaled = 0;
+    EXPECT_EQ(CELIX_SUCCESS, proxy.scale(proxy.handle, 3, 1000, 0.5f, &scaled));
+    EXPECT_EQ(1500, scaled);
+
+    bool even = false;
+    EXPECT_EQ(CELIX_SUCCESS, proxy.isEven(proxy.handle, 42, &even));
+    EXPECT_TRUE(even);
+
+    char* concatenated = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, proxy.concat(proxy.handle, "hello ", strdup("world"), &concatenated));
+    EXPECT_STREQ("hello world", concatenated);
+    free(concatenated);
+
+    EXPECT_EQ(CELIX_SUCCESS, proxy.setName(proxy.handle, strdup("celix")));
+    char* result = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, proxy.getName(proxy.handle, &result));
+    EXPECT_STREQ("celix", result);
+    free(result);
+
+    EXPECT_EQ(CELIX_SUCCESS, proxy.reset(proxy.handle));
+    EXPECT_EQ(nullptr, name);
+}
+
+TEST_F(JsonRpcStubTestSuite, ProxyRemoteErrorTest) {
+    char* result = nullptr;
+    //no name set, so the remote service returns CELIX_ILLEGAL_STATE
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, proxy.getName(proxy.handle, &result));
+    EXPECT_EQ(nullptr, result);
+}
+
+TEST_F(JsonRpcStubTestSuite, ProxySendErrorTest) {
+    proxyHandle.send = [](void*, const char*, const char*, char**) -> celix_status_t {
+        return CELIX_ILLEGAL_STATE;
+    };
+    double sum = 0.0;
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, proxy.add(proxy.handle, 1.0, 2.0, &sum));
+
+    proxyHandle.send = [](void*, const char*, const char*, char** reply) -> celix_status_t {
+        *reply = nullptr;
+        return CELIX_SUCCESS;
+    };
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, proxy.add(proxy.handle, 1.0, 2.0, &sum));
+
+    proxyHandle.send = [](void*, const char*, const char*, char** reply) -> celix_status_t {
+        *reply = strdup("{}");
+        return CELIX_SUCCESS;
+    };
+    EXPECT_EQ(CELIX_SERVICE_EXCEPTION, proxy.add(proxy.handle, 1.0, 2.0, &sum));
+    EXPECT_EQ(CELIX_SUCCESS, proxy.reset(proxy.handle));
+}
@@ -0,0 +1,181 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __JSON_RPC_STUB_H_
+#define __JSON_RPC_STUB_H_
+
+#include <jansson.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "celix_errno.h"
+#include "celix_dfi_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Typed JSON-RPC stubs generated at build time from interface descriptors.
+ *
+ * A JSON-RPC stub is the generated counterpart of jsonRpc_call (endpoint side) and of the libffi closures combined
+ * with jsonRpc_prepareInvokeRequest/jsonRpc_handleReply (proxy side). The generated code serializes the method
+ * arguments directly and calls the service functions directly, so no dyn_type walking and no libffi is involved.
+ * The wire format is identical to the dynamic JSON-RPC implementation.
+ *
+ * Stubs are generated with the `celix_target_generate_json_rpc_stubs` CMake function and can be offered to remote
+ * service admins by registering the generated json_rpc_stub_t as a JSON_RPC_STUB_SERVICE_NAME service with the
+ * JSON_RPC_STUB_INTERFACE_NAME and JSON_RPC_STUB_INTERFACE_VERSION service properties.
+ */
+
+/**
+ * @brief The service name of a json_rpc_stub_t service.
+ */
+#define JSON_RPC_STUB_SERVICE_NAME "json_rpc_stub"
+
+/**
+ * @brief The service version of a json_rpc_stub_t service.
+ */
+#define JSON_RPC_STUB_SERVICE_VERSION "1.0.0"
+
+/**
+ * @brief Service property for the interface name (the descriptor header name) a stub is generated for.
+ */
+#define JSON_RPC_STUB_INTERFACE_NAME "json_rpc_stub.interface.name"
+
+/**
+ * @brief Service property for the interface version (the descriptor header version) a stub is generated for.
+ */
+#define JSON_RPC_STUB_INTERFACE_VERSION "json_rpc_stub.interface.version"
+
+/**
+ * @brief The handle of a generated proxy service.
+ *
+ * A proxy service created with the proxyMethods of a json_rpc_stub_t must use a pointer to a
+ * json_rpc_stub_proxy_t as service handle.
+ */
+typedef struct json_rpc_stub_proxy {
+    void* handle; ///< The handle for the send function.
+
+    /**
+     * @brief Sends a JSON-RPC request and returns the reply.
+     * @param[in] handle The handle.
+     * @param[in] methodName The name of the called method.
+     * @param[in] request The JSON-RPC request. The caller keeps ownership.
+     * @param[out] reply The JSON-RPC reply. The caller is the owner and should release it using free.
+     * @return CELIX_SUCCESS if the request is sent and a reply is received.
+     */
+    celix_status_t (*send)(void* handle, const char* methodName, const char* request, char** reply);
+} json_rpc_stub_proxy_t;
+
+/**
+ * @brief A generated JSON-RPC stub for an interface descriptor.
+ */
+typedef struct json_rpc_stub {
+    const char* interfaceName; ///< The interface name from the descriptor header.
+    const char* interfaceVersion; ///< The interface version from the descriptor header.
+    size_t nrOfMethods; ///< The number of methods of the interface.
+
+    /**
+     * @brief Calls a service using JSON-RPC. Same contract as jsonRpc_call.
+     * @param[in] service The service to call.
+     * @param[in] request The JSON-RPC request.
+     * @param[out] out The JSON-RPC reply. The caller is the owner and should release it using free.
+     * @return 0 if successful, otherwise 1.
+     */
+    int (*call)(void* service, const char* request, char** out);
+
+    /**
+     * @brief The proxy functions for the interface methods in descriptor order.
+     * The service handle of the proxy service must be a json_rpc_stub_proxy_t pointer.
+     */
+    void (* const* proxyMethods)(void);
+} json_rpc_stub_t;
+
+/**
+ * @brief Serializes a JSON-RPC request, sends it using the stub proxy and parses the reply.
+ *
+ * Used by generated proxy functions.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] handle The json_rpc_stub_proxy_t service handle.
+ * @param[in] methodId The method id (signature).
+ * @param[in] methodName The method name.
+ * @param[in] arguments The JSON array with the standard arguments. The ownership is transferred.
+ * @param[in] hasOutput Whether the method has an output argument.
+ * @param[out] result The result of the remote call, NULL if the method has no output. The caller is the owner and
+ * should release it using json_decref.
+ * @return CELIX_SUCCESS if successful, the status returned by the remote service or an error status.
+ */
+CELIX_DFI_EXPORT celix_status_t jsonRpcStub_invoke(void* handle, const char* methodId, const char* methodName,
+                                                   json_t* arguments, bool hasOutput, json_t** result);
+
+/**
+ * @brief Appends a serialized argument to a JSON-RPC arguments array.
+ *
+ * Used by generated proxy functions. The ownership of val is transferred, also in case of an error.
+ *
+ * @return 0 if successful, otherwise 1.
+ */
+CELIX_DFI_EXPORT int jsonRpcStub_appendArgument(json_t* arguments, json_t* val);
+
+/**
+ * @brief Parses a JSON-RPC request.
+ *
+ * Used by generated endpoint functions.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] request The JSON-RPC request.
+ * @param[out] requestOut The parsed request. The caller is the owner and should release it using json_decref.
+ * @param[out] methodId The method id, owned by requestOut.
+ * @param[out] arguments The arguments array, owned by requestOut.
+ * @return 0 if successful, otherwise 1.
+ */
+CELIX_DFI_EXPORT int jsonRpcStub_parseRequest(const char* request, json_t** requestOut, const char** methodId,
+                                              json_t** arguments);
+
+/**
+ * @brief Creates a JSON-RPC reply.
+ *
+ * Used by generated endpoint functions.
+ *
+ * @param[in] funcCallStatus The return value of the called service function.
+ * @param[in] result The result, can be NULL. The ownership is transferred.
+ * @param[out] out The JSON-RPC reply. The caller is the owner and should release it using free.
+ * @return 0 if successful, otherwise 1.
+ */
+CELIX_DFI_EXPORT int jsonRpcStub_createReply(int funcCallStatus, json_t* result, char** out);
+
+/**
+ * @brief Deserializes a JSON string or null value to a newly allocated C string.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] val The JSON value.
+ * @param[out] out The string or NULL for a JSON null. The caller is the owner and should release it using free.
+ * @return 0 if successful, otherwise 1.
+ */
+CELIX_DFI_EXPORT int jsonRpcStub_getString(const json_t* val, char** out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,482 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "json_rpc_stub_gen.h"
+#include "dyn_function.h"
+#include "dyn_type.h"
+#include "celix_err.h"
+
+#include <ctype.h>
+#include <string.h>
+
+static int OK = 0;
+static int ERROR = 1;
+
+typedef enum json_rpc_stub_gen_arg_kind {
+    JSON_RPC_STUB_GEN_ARG_HANDLE,
+    JSON_RPC_STUB_GEN_ARG_SIMPLE,
+    JSON_RPC_STUB_GEN_ARG_TEXT,
+    JSON_RPC_STUB_GEN_ARG_CONST_TEXT,
+    JSON_RPC_STUB_GEN_ARG_PRE_SIMPLE,
+    JSON_RPC_STUB_GEN_ARG_OUT_TEXT,
+    JSON_RPC_STUB_GEN_ARG_UNSUPPORTED
+} json_rpc_stub_gen_arg_kind_e;
+
+/**
+ * @brief C type and the JSON (de)serialization expressions for a simple dyn type.
+ * The expressions are printf formats with a single %s for the value.
+ */
+typedef struct json_rpc_stub_gen_simple_type {
+    char descriptor;
+    const char* cType;
+    const char* toJson;
+    const char* fromJson;
+} json_rpc_stub_gen_simple_type_t;
+
+//note conversions match json_serializer.c, so that the generated stubs are wire compatible with the dynamic path
+static const json_rpc_stub_gen_simple_type_t JSON_RPC_STUB_GEN_SIMPLE_TYPES[] = {
+    {'Z', "bool", "json_boolean(%s)", "json_is_true(%s)"},
+    {'B', "char", "json_integer((json_int_t)%s)", "(char)json_integer_value(%s)"},
+    {'S', "int16_t", "json_integer((json_int_t)%s)", "(int16_t)json_integer_value(%s)"},
+    {'I', "int32_t", "json_integer((json_int_t)%s)", "(int32_t)json_integer_value(%s)"},
+    {'J', "int64_t", "json_integer((json_int_t)%s)", "(int64_t)json_integer_value(%s)"},
+    {'b', "uint8_t", "json_integer((json_int_t)%s)", "(uint8_t)json_integer_value(%s)"},
+    {'s', "uint16_t", "json_integer((json_int_t)%s)", "(uint16_t)json_integer_value(%s)"},
+    {'i', "uint32_t", "json_integer((json_int_t)%s)", "(uint32_t)json_integer_value(%s)"},
+    {'j', "uint64_t", "json_integer((json_int_t)%s)", "(uint64_t)json_integer_value(%s)"},
+    {'N', "int", "json_integer((json_int_t)%s)", "(int)json_integer_value(%s)"},
+    {'F', "float", "json_real((double)%s)", "(float)json_real_value(%s)"},
+    {'D', "double", "json_real(%s)", "json_real_value(%s)"},
+};
+
+static const json_rpc_stub_gen_simple_type_t* jsonRpcStubGen_simpleType(const dyn_type* type) {
+    if (dynType_type(type) != DYN_TYPE_SIMPLE) {
+        return NULL;
+    }
+    char descriptor = dynType_descriptorType(type);
+    for (size_t i = 0; i < sizeof(JSON_RPC_STUB_GEN_SIMPLE_TYPES) / sizeof(JSON_RPC_STUB_GEN_SIMPLE_TYPES[0]); ++i) {
+        if (JSON_RPC_STUB_GEN_SIMPLE_TYPES[i].descriptor == descriptor) {
+            return &JSON_RPC_STUB_GEN_SIMPLE_TYPES[i];
+        }
+    }
+    return NULL;
+}
+
+static json_rpc_stub_gen_arg_kind_e jsonRpcStubGen_argKind(const dyn_function_argument_type* arg) {
+    const dyn_type* real = dynType_realType(arg->type);
+    switch (arg->argumentMeta) {
+        case DYN_FUNCTION_ARGUMENT_META__HANDLE:
+            return JSON_RPC_STUB_GEN_ARG_HANDLE;
+        case DYN_FUNCTION_ARGUMENT_META__STD:
+            if (jsonRpcStubGen_simpleType(real) != NULL) {
+                return JSON_RPC_STUB_GEN_ARG_SIMPLE;
+            } else if (dynType_descriptorType(real) == 't') {
+                // meta info is on the original type, which could be a reference, rather than the real type
+                const char* isConst = dynType_getMetaInfo(arg->type, "const");
+                return isConst != NULL && strcmp("true", isConst) == 0 ? JSON_RPC_STUB_GEN_ARG_CONST_TEXT
+                                                                        : JSON_RPC_STUB_GEN_ARG_TEXT;
+            }
+            return JSON_RPC_STUB_GEN_ARG_UNSUPPORTED;
+        case DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT:
+            if (dynType_type(real) == DYN_TYPE_TYPED_POINTER &&
+                jsonRpcStubGen_simpleType(dynType_realType(dynType_typedPointer_getTypedType(real))) != NULL) {
+                return JSON_RPC_STUB_GEN_ARG_PRE_SIMPLE;
+            }
+            return JSON_RPC_STUB_GEN_ARG_UNSUPPORTED;
+        case DYN_FUNCTION_ARGUMENT_META__OUTPUT:
+            if (dynType_type(real) == DYN_TYPE_TYPED_POINTER &&
+                dynType_descriptorType(dynType_typedPointer_getTypedType(real)) == 't') {
+                return JSON_RPC_STUB_GEN_ARG_OUT_TEXT;
+            }
+            return JSON_RPC_STUB_GEN_ARG_UNSUPPORTED;
+        default:
+            return JSON_RPC_STUB_GEN_ARG_UNSUPPORTED;
+    }
+}
+
+static const json_rpc_stub_gen_simple_type_t* jsonRpcStubGen_outputSimpleType(const dyn_function_argument_type* arg) {
+    return jsonRpcStubGen_simpleType(dynType_realType(dynType_typedPointer_getTypedType(dynType_realType(arg->type))));
+}
+
+bool jsonRpcStubGen_isSupported(const dyn_interface_type* intf) {
+    const struct methods_head* methods = dynInterface_methods(intf);
+    struct method_entry* method = NULL;
+    TAILQ_FOREACH(method, methods, entries) {
+        const char* name = dynFunction_getName(method->dynFunc);
+        struct method_entry* other = NULL;
+        TAILQ_FOREACH(other, methods, entries) {
+            if (other != method && strcmp(name, dynFunction_getName(other->dynFunc)) == 0) {
+                celix_err_pushf("Method name '%s' is used for multiple methods", name);
+                return false;
+            }
+        }
+        if (dynType_descriptorType(dynFunction_returnType(method->dynFunc)) != 'N') {
+            celix_err_pushf("Method '%s' does not have a native int return type", method->id);
+            return false;
+        }
+        dyn_function_argument_type* arg = NULL;
+        TAILQ_FOREACH(arg, dynFunction_arguments(method->dynFunc), entries) {
+            if (jsonRpcStubGen_argKind(arg) == JSON_RPC_STUB_GEN_ARG_UNSUPPORTED) {
+                celix_err_pushf("Argument %d of method '%s' has a type which is not supported by the stub generator",
+                                arg->index, method->id);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void jsonRpcStubGen_writeCString(FILE* out, const char* str) {
+    fputc('"', out);
+    for (const char* c = str; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', out);
+        }
+        fputc(*c, out);
+    }
+    fputc('"', out);
+}
+
+static void jsonRpcStubGen_writeArgDecl(FILE* out, const dyn_function_argument_type* arg) {
+    switch (jsonRpcStubGen_argKind(arg)) {
+        case JSON_RPC_STUB_GEN_ARG_HANDLE:
+            fprintf(out, "void* handle");
+            break;
+        case JSON_RPC_STUB_GEN_ARG_SIMPLE:
+            fprintf(out, "%s arg%d", jsonRpcStubGen_simpleType(dynType_realType(arg->type))->cType, arg->index);
+            break;
+        case JSON_RPC_STUB_GEN_ARG_TEXT:
+            fprintf(out, "char* arg%d", arg->index);
+            break;
+        case JSON_RPC_STUB_GEN_ARG_CONST_TEXT:
+            fprintf(out, "const char* arg%d", arg->index);
+            break;
+        case JSON_RPC_STUB_GEN_ARG_PRE_SIMPLE:
+            fprintf(out, "%s* out", jsonRpcStubGen_outputSimpleType(arg)->cType);
+            break;
+        case JSON_RPC_STUB_GEN_ARG_OUT_TEXT:
+            fprintf(out, "char** out");
+            break;
+        default:
+            break;
+    }
+}
+
+static void jsonRpcStubGen_writeSignature(FILE* out, const struct method_entry* method) {
+    fputc('(', out);
+    dyn_function_argument_type* arg = NULL;
+    TAILQ_FOREACH(arg, dynFunction_arguments(method->dynFunc), entries) {
+        if (arg != TAILQ_FIRST(dynFunction_arguments(method->dynFunc))) {
+            fprintf(out, ", ");
+        }
+        jsonRpcStubGen_writeArgDecl(out, arg);
+    }
+    fputc(')', out);
+}
+
+static const dyn_function_argument_type* jsonRpcStubGen_outputArg(const struct method_entry* method) {
+    const dyn_function_argument_type* last = TAILQ_LAST(dynFunction_arguments(method->dynFunc),
+                                                        dyn_function_arguments_head);
+    json_rpc_stub_gen_arg_kind_e kind = jsonRpcStubGen_argKind(last);
+    return kind == JSON_RPC_STUB_GEN_ARG_PRE_SIMPLE || kind == JSON_RPC_STUB_GEN_ARG_OUT_TEXT ? last : NULL;
+}
+
+static int jsonRpcStubGen_nrOfStdArgs(const struct method_entry* method) {
+    int count = 0;
+    dyn_function_argument_type* arg = NULL;
+    TAILQ_FOREACH(arg, dynFunction_arguments(method->dynFunc), entries) {
+        if (arg->argumentMeta == DYN_FUNCTION_ARGUMENT_META__STD) {
+            count += 1;
+        }
+    }
+    return count;
+}
+
+static bool jsonRpcStubGen_hasTextArgs(const struct method_entry* method) {
+    dyn_function_argument_type* arg = NULL;
+    TAILQ_FOREACH(arg, dynFunction_arguments(method->dynFunc), entries) {
+        json_rpc_stub_gen_arg_kind_e kind = jsonRpcStubGen_argKind(arg);
+        if (kind == JSON_RPC_STUB_GEN_ARG_TEXT || kind == JSON_RPC_STUB_GEN_ARG_CONST_TEXT) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void jsonRpcStubGen_writeEndpointMethod(FILE* out, const char* prefix, const struct method_entry* method) {
+    const char* name = dynFunction_getName(method->dynFunc);
+    const dyn_function_argument_type* outArg = jsonRpcStubGen_outputArg(method);
+    int nrOfStdArgs = jsonRpcStubGen_nrOfStdArgs(method);
+    dyn_function_argument_type* arg = NULL;
+
+    fprintf(out, "static int %s_%s_call(%s_service_t* svc, json_t* arguments, int* funcCallStatus, json_t** result) {\n",
+            prefix, name, prefix);
+    fprintf(out, "    if (json_array_size(arguments) != %d) {\n", nrOfStdArgs);
+    fprintf(out, "        celix_err_pushf(\"Wrong number of standard arguments for %%s. Expected %%d, got %%zu\", ");
+    jsonRpcStubGen_writeCString(out, method->id);
+    fprintf(out, ", %d, json_array_size(arguments));\n", nrOfStdArgs);
+    fprintf(out, "        return 1;\n");
+    fprintf(out, "    }\n");
+    fprintf(out, "    int rc = 0;\n");
+    TAILQ_FOREACH(arg, dynFunction_arguments(method->dynFunc), entries) {
+        json_rpc_stub_gen_arg_kind_e kind = jsonRpcStubGen_argKind(arg);
+        char jsonArg[64];
+        snprintf(jsonArg, sizeof(jsonArg), "json_array_get(arguments, %d)", arg->index - 1);
+        if (kind == JSON_RPC_STUB_GEN_ARG_SIMPLE) {
+            const json_rpc_stub_gen_simple_type_t* simple = jsonRpcStubGen_simpleType(dynType_realType(arg->type));
+            fprintf(out, "    %s arg%d = ", simple->cType, arg->index);
+            fprintf(out, simple->fromJson, jsonArg);
+            fprintf(out, ";\n");
+        } else if (kind == JSON_RPC_STUB_GEN_ARG_TEXT || kind == JSON_RPC_STUB_GEN_ARG_CONST_TEXT) {
+            fprintf(out, "    char* arg%d = NULL;\n", arg->index);
+            fprintf(out, "    rc = rc != 0 ? rc : jsonRpcStub_getString(%s, &arg%d);\n", jsonArg, arg->index);
+        }
+    }
+    if (jsonRpcStubGen_hasTextArgs(method)) {
+        fprintf(out, "    if (rc != 0) {\n");
+        TAILQ_FOREACH(arg, dynFunction_arguments(method->dynFunc), entries) {
+            json_rpc_stub_gen_arg_kind_e kind = jsonRpcStubGen_argKind(arg);
+            if (kind == JSON_RPC_STUB_GEN_ARG_TEXT || kind == JSON_RPC_STUB_GEN_ARG_CONST_TEXT) {
+                fprintf(out, "        free(arg%d);\n", arg->index);
+            }
+        }
+        fprintf(out, "        celix_err_pushf(\"Error deserializing arguments for %%s\", ");
+        jsonRpcStubGen_writeCString(out, method->id);
+        fprintf(out, ");\n");
+        fprintf(out, "        return rc;\n");
+        fprintf(out, "    }\n");
+    }
+    if (outArg != NULL && jsonRpcStubGen_argKind(outArg) == JSON_RPC_STUB_GEN_ARG_PRE_SIMPLE) {
+        fprintf(out, "    %s out = 0;\n", jsonRpcStubGen_outputSimpleType(outArg)->cType);
+    } else if (outArg != NULL) {
+        fprintf(out, "    char* out = NULL;\n");
+    }
+    fprintf(out, "    *funcCallStatus = svc->%s(svc->handle", name);
+    TAILQ_FOREACH(arg, dynFunction_arguments(method->dynFunc), entries) {
+        if (arg->argumentMeta == DYN_FUNCTION_ARGUMENT_META__STD) {
+            fprintf(out, ", arg%d", arg->index);
+        }
+    }
+    fprintf(out, "%s);\n", outArg != NULL ? ", &out" : "");
+    TAILQ_FOREACH(arg, dynFunction_arguments(method->dynFunc), entries) {
+        if (jsonRpcStubGen_argKind(arg) == JSON_RPC_STUB_GEN_ARG_CONST_TEXT) {
+            //const char* -> caller keeps ownership
+            fprintf(out, "    free(arg%d);\n", arg->index);
+        }
+    }
+    if (outArg != NULL) {
+        fprintf(out, "    if (*funcCallStatus == 0) {\n");
+        if (jsonRpcStubGen_argKind(outArg) == JSON_RPC_STUB_GEN_ARG_PRE_SIMPLE) {
+            fprintf(out, "        *result = ");
+            fprintf(out, jsonRpcStubGen_outputSimpleType(outArg)->toJson, "out");
+            fprintf(out, ";\n");
+        } else {
+            fprintf(out, "        *result = out != NULL ? json_string(out) : json_null();\n");
+        }
+        fprintf(out, "        rc = *result != NULL ? 0 : 1;\n");
+        fprintf(out, "    }\n");
+        if (jsonRpcStubGen_argKind(outArg) == JSON_RPC_STUB_GEN_ARG_OUT_TEXT) {
+            fprintf(out, "    free(out);\n");
+        }
+    }
+    fprintf(out, "    return rc;\n");
+    fprintf(out, "}\n\n");
+}
+
+static void jsonRpcStubGen_writeProxyMethod(FILE* out, const char* prefix, const struct method_entry* method) {
+    const char* name = dynFunction_getName(method->dynFunc);
+    const dyn_function_argument_type* outArg = jsonRpcStubGen_outputArg(method);
+    dyn_function_argument_type* arg = NULL;
+
+    fprintf(out, "static int %s_%s_proxy", prefix, name);
+    jsonRpcStubGen_writeSignature(out, method);
+    fprintf(out, " {\n");
+    fprintf(out, "    json_t* arguments = json_array();\n");
+    if (jsonRpcStubGen_nrOfStdArgs(method) > 0) {
+        fprintf(out, "    int rc = 0;\n");
+    }
+    TAILQ_FOREACH(arg, dynFunction_arguments(method->dynFunc), entries) {
+        json_rpc_stub_gen_arg_kind_e kind = jsonRpcStubGen_argKind(arg);
+        char argName[32];
+        snprintf(argName, sizeof(argName), "arg%d", arg->index);
+        if (kind == JSON_RPC_STUB_GEN_ARG_SIMPLE) {
+            fprintf(out, "    rc = rc != 0 ? rc : jsonRpcStub_appendArgument(arguments, ");
+            fprintf(out, jsonRpcStubGen_simpleType(dynType_realType(arg->type))->toJson, argName);
+            fprintf(out, ");\n");
+        } else if (kind == JSON_RPC_STUB_GEN_ARG_TEXT || kind == JSON_RPC_STUB_GEN_ARG_CONST_TEXT) {
+            fprintf(out, "    rc = rc != 0 ? rc : jsonRpcStub_appendArgument(arguments, "
+                         "%s != NULL ? json_string(%s) : json_null());\n", argName, argName);
+        }
+    }
+    TAILQ_FOREACH(arg, dynFunction_arguments(method->dynFunc), entries) {
+        if (jsonRpcStubGen_argKind(arg) == JSON_RPC_STUB_GEN_ARG_TEXT) {
+            //char* as input -> got ownership -> free it.
+            fprintf(out, "    free(arg%d);\n", arg->index);
+        }
+    }
+    if (jsonRpcStubGen_nrOfStdArgs(method) > 0) {
+        fprintf(out, "    if (rc != 0) {\n");
+        fprintf(out, "        json_decref(arguments);\n");
+        fprintf(out, "        return CELIX_SERVICE_EXCEPTION;\n");
+        fprintf(out, "    }\n");
+    }
+    fprintf(out, "    json_t* result = NULL;\n");
+    fprintf(out, "    celix_status_t status = jsonRpcStub_invoke(handle, ");
+    jsonRpcStubGen_writeCString(out, method->id);
+    fprintf(out, ", ");
+    jsonRpcStubGen_writeCString(out, name);
+    fprintf(out, ", arguments, %s, &result);\n", outArg != NULL ? "true" : "false");
+    if (outArg != NULL) {
+        fprintf(out, "    if (status == CELIX_SUCCESS && out != NULL) {\n");
+        if (jsonRpcStubGen_argKind(outArg) == JSON_RPC_STUB_GEN_ARG_PRE_SIMPLE) {
+            fprintf(out, "        *out = ");
+            fprintf(out, jsonRpcStubGen_outputSimpleType(outArg)->fromJson, "result");
+            fprintf(out, ";\n");
+        } else {
+            fprintf(out, "        status = jsonRpcStub_getString(result, out) == 0 ? CELIX_SUCCESS : CELIX_SERVICE_EXCEPTION;\n");
+        }
+        fprintf(out, "    }\n");
+    }
+    fprintf(out, "    json_decref(result);\n");
+    fprintf(out, "    return status;\n");
+    fprintf(out, "}\n\n");
+}
+
+static void jsonRpcStubGen_writeHeader(const dyn_interface_type* intf, const char* prefix, FILE* header) {
+    char guard[256];
+    size_t i = 0;
+    for (; prefix[i] != '\0' && i < sizeof(guard) - 1; ++i) {
+        guard[i] = (char)toupper((unsigned char)prefix[i]);
+    }
+    guard[i] = '\0';
+
+    fprintf(header, "/*\n * Generated by celix_dfi_json_rpc_stub_gen from the '%s' (%s) interface descriptor.\n"
+                    " * Do not edit.\n */\n\n",
+            dynInterface_getName(intf), dynInterface_getVersionString(intf));
+    fprintf(header, "#ifndef %s_JSON_RPC_STUB_H_\n", guard);
+    fprintf(header, "#define %s_JSON_RPC_STUB_H_\n\n", guard);
+    fprintf(header, "#include \"json_rpc_stub.h\"\n\n");
+    fprintf(header, "#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n");
+    fprintf(header, "/**\n * @brief The typed JSON-RPC stub for the '%s' (%s) interface.\n */\n",
+            dynInterface_getName(intf), dynInterface_getVersionString(intf));
+    fprintf(header, "extern const json_rpc_stub_t %s_jsonRpcStub;\n\n", prefix);
+    fprintf(header, "#ifdef __cplusplus\n}\n#endif\n\n");
+    fprintf(header, "#endif //%s_JSON_RPC_STUB_H_\n", guard);
+}
+
+static void jsonRpcStubGen_writeSource(const dyn_interface_type* intf, const char* prefix, const char* headerName,
+                                       FILE* source) {
+    const struct methods_head* methods = dynInterface_methods(intf);
+    struct method_entry* method = NULL;
+    int nrOfMethods = dynInterface_nrOfMethods(intf);
+
+    fprintf(source, "/*\n * Generated by celix_dfi_json_rpc_stub_gen from the '%s' (%s) interface descriptor.\n"
+                    " * Do not edit.\n */\n\n",
+            dynInterface_getName(intf), dynInterface_getVersionString(intf));
+    fprintf(source, "#include \"%s\"\n\n", headerName);
+    fprintf(source, "#include <stdbool.h>\n#include <stdint.h>\n#include <stdlib.h>\n#include <string.h>\n\n");
+    fprintf(source, "#include \"celix_err.h\"\n\n");
+
+    //service layout, see generic_service_layout in json_rpc.c
+    fprintf(source, "typedef struct %s_service {\n", prefix);
+    fprintf(source, "    void* handle;\n");
+    TAILQ_FOREACH(method, methods, entries) {
+        fprintf(source, "    int (*%s)", dynFunction_getName(method->dynFunc));
+        jsonRpcStubGen_writeSignature(source, method);
+        fprintf(source, ";\n");
+    }
+    fprintf(source, "} %s_service_t;\n\n", prefix);
+
+    TAILQ_FOREACH(method, methods, entries) {
+        jsonRpcStubGen_writeEndpointMethod(source, prefix, method);
+    }
+
+    fprintf(source, "static int %s_call(void* service, const char* request, char** out) {\n", prefix);
+    fprintf(source, "    %s_service_t* svc = service;\n", prefix);
+    fprintf(source, "    json_t* jsRequest = NULL;\n");
+    fprintf(source, "    const char* methodId = NULL;\n");
+    fprintf(source, "    json_t* arguments = NULL;\n");
+    fprintf(source, "    if (jsonRpcStub_parseRequest(request, &jsRequest, &methodId, &arguments) != 0) {\n");
+    fprintf(source, "        return 1;\n");
+    fprintf(source, "    }\n");
+    fprintf(source, "    json_t* result = NULL;\n");
+    fprintf(source, "    int funcCallStatus = 0;\n");
+    fprintf(source, "    int rc;\n");
+    bool first = true;
+    TAILQ_FOREACH(method, methods, entries) {
+        fprintf(source, "    %sif (strcmp(methodId, ", first ? "" : "} else ");
+        jsonRpcStubGen_writeCString(source, method->id);
+        fprintf(source, ") == 0) {\n");
+        fprintf(source, "        rc = %s_%s_call(svc, arguments, &funcCallStatus, &result);\n",
+                prefix, dynFunction_getName(method->dynFunc));
+        first = false;
+    }
+    fprintf(source, "    %s{\n", first ? "" : "} else ");
+    fprintf(source, "        celix_err_pushf(\"Cannot find method with sig '%%s'\", methodId);\n");
+    fprintf(source, "        rc = 1;\n");
+    fprintf(source, "    }\n");
+    fprintf(source, "    json_decref(jsRequest);\n");
+    fprintf(source, "    if (rc != 0) {\n");
+    fprintf(source, "        json_decref(result);\n");
+    fprintf(source, "        return rc;\n");
+    fprintf(source, "    }\n");
+    fprintf(source, "    return jsonRpcStub_createReply(funcCallStatus, result, out);\n");
+    fprintf(source, "}\n\n");
+
+    TAILQ_FOREACH(method, methods, entries) {
+        jsonRpcStubGen_writeProxyMethod(source, prefix, method);
+    }
+
+    if (nrOfMethods > 0) {
+        fprintf(source, "static void (* const %s_proxyMethods[])(void) = {\n", prefix);
+        TAILQ_FOREACH(method, methods, entries) {
+            fprintf(source, "    (void (*)(void))%s_%s_proxy,\n", prefix, dynFunction_getName(method->dynFunc));
+        }
+        fprintf(source, "};\n\n");
+    }
+
+    fprintf(source, "const json_rpc_stub_t %s_jsonRpcStub = {\n", prefix);
+    fprintf(source, "    .interfaceName = ");
+    jsonRpcStubGen_writeCString(source, dynInterface_getName(intf));
+    fprintf(source, ",\n    .interfaceVersion = ");
+    jsonRpcStubGen_writeCString(source, dynInterface_getVersionString(intf));
+    fprintf(source, ",\n    .nrOfMethods = %d,\n", nrOfMethods);
+    fprintf(source, "    .call = %s_call,\n", prefix);
+    if (nrOfMethods > 0) {
+        fprintf(source, "    .proxyMethods = %s_proxyMethods,\n", prefix);
+    } else {
+        fprintf(source, "    .proxyMethods = NULL,\n");
+    }
+    fprintf(source, "};\n");
+}
+
+int jsonRpcStubGen_generate(const dyn_interface_type* intf, const char* prefix, const char* headerName,
+                            FILE* header, FILE* source) {
+    if (!jsonRpcStubGen_isSupported(intf)) {
+        celix_err_pushf("Cannot generate a JSON-RPC stub for interface '%s'", dynInterface_getName(intf));
+        return ERROR;
+    }
+    jsonRpcStubGen_writeHeader(intf, prefix, header);
+    jsonRpcStubGen_writeSource(intf, prefix, headerName, source);
+    if (ferror(header) || ferror(source)) {
+        celix_err_push("Error writing JSON-RPC stub");
+        return ERROR;
+    }
+    return OK;
+}
@@ -0,0 +1,67 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __JSON_RPC_STUB_GEN_H_
+#define __JSON_RPC_STUB_GEN_H_
+
+#include <stdbool.h>
+#include <stdio.h>
+#include "dyn_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Checks whether typed JSON-RPC stubs can be generated for the given interface.
+ *
+ * Supported are methods with simple (numeric and boolean) and text standard arguments, a pre-allocated output
+ * argument of a simple type and a text output argument. Interfaces using other types (structs, sequences, enums,
+ * typed pointers) must use the dynamic JSON-RPC implementation.
+ *
+ * In case the interface is not supported, an error message is added to celix_err.
+ *
+ * @param[in] intf The parsed interface descriptor.
+ * @return true if stubs can be generated.
+ */
+bool jsonRpcStubGen_isSupported(const dyn_interface_type* intf);
+
+/**
+ * @brief Generates the C header and source of a typed JSON-RPC stub for the given interface.
+ *
+ * The generated source defines a `const json_rpc_stub_t <prefix>_jsonRpcStub` which is declared in the generated
+ * header.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] intf The parsed interface descriptor.
+ * @param[in] prefix The C identifier prefix used for all generated symbols.
+ * @param[in] headerName The file name of the generated header, used to include the header from the source.
+ * @param[in] header The stream to write the header to.
+ * @param[in] source The stream to write the source to.
+ * @return 0 if successful, otherwise 1.
+ */
+int jsonRpcStubGen_generate(const dyn_interface_type* intf, const char* prefix, const char* headerName,
+                            FILE* header, FILE* source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "json_rpc_stub_gen.h"
+#include "dyn_interface.h"
+#include "celix_err.h"
+
+static void printUsage(const char* progName) {
+    fprintf(stderr, "Usage: %s <descriptor> <output header> <output source> <prefix>\n", progName);
+}
+
+int main(int argc, char** argv) {
+    if (argc != 5) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    const char* descriptorFile = argv[1];
+    const char* headerFile = argv[2];
+    const char* sourceFile = argv[3];
+    const char* prefix = argv[4];
+
+    FILE* descriptor = fopen(descriptorFile, "r");
+    if (descriptor == NULL) {
+        fprintf(stderr, "Cannot open descriptor '%s'\n", descriptorFile);
+        return EXIT_FAILURE;
+    }
+    dyn_interface_type* intf = NULL;
+    int rc = dynInterface_parse(descriptor, &intf);
+    fclose(descriptor);
+    if (rc != 0) {
+        fprintf(stderr, "Cannot parse descriptor '%s'\n", descriptorFile);
+        celix_err_printErrors(stderr, NULL, NULL);
+        return EXIT_FAILURE;
+    }
+
+    FILE* header = fopen(headerFile, "w");
+    FILE* source = fopen(sourceFile, "w");
+    if (header == NULL || source == NULL) {
+        fprintf(stderr, "Cannot open output files '%s' and '%s'\n", headerFile, sourceFile);
+        rc = 1;
+    } else {
+        const char* headerName = strrchr(headerFile, '/');
+        headerName = headerName == NULL ? headerFile : headerName + 1;
+        rc = jsonRpcStubGen_generate(intf, prefix, headerName, header, source);
+    }
+    if (header != NULL) {
+        rc = fclose(header) != 0 ? 1 : rc;
+    }
+    if (source != NULL) {
+        rc = fclose(source) != 0 ? 1 : rc;
+    }
+    dynInterface_destroy(intf);
+
+    if (rc != 0) {
+        fprintf(stderr, "Error generating JSON-RPC stub for descriptor '%s'\n", descriptorFile);
+        celix_err_printErrors(stderr, NULL, NULL);
+        remove(headerFile);
+        remove(sourceFile);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
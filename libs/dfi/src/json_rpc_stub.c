@@ -0,0 +1,167 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "json_rpc_stub.h"
+#include "celix_err.h"
+#include "celix_stdlib_cleanup.h"
+
+#include <jansson.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int OK = 0;
+static int ERROR = 1;
+
+celix_status_t jsonRpcStub_invoke(void* handle, const char* methodId, const char* methodName,
+                                  json_t* arguments, bool hasOutput, json_t** result) {
+    const json_rpc_stub_proxy_t* proxy = handle;
+    *result = NULL;
+    if (arguments == NULL) {
+        celix_err_pushf("Error creating arguments array for '%s'", methodId);
+        return CELIX_ENOMEM;
+    }
+
+    json_auto_t* invoke = json_object();
+    if (invoke == NULL) {
+        json_decref(arguments);
+        celix_err_pushf("Error creating invoke request for '%s'", methodId);
+        return CELIX_ENOMEM;
+    }
+    if (json_object_set_new_nocheck(invoke, "m", json_string(methodId)) != 0 ||
+        json_object_set_new_nocheck(invoke, "a", arguments) != 0) {
+        celix_err_pushf("Error creating invoke request for '%s'", methodId);
+        return CELIX_ENOMEM;
+    }
+    //use JSON_COMPACT to reduce the size of the JSON string.
+    celix_autofree char* request = json_dumps(invoke, JSON_COMPACT | JSON_ENCODE_ANY);
+    if (request == NULL) {
+        celix_err_pushf("Error serializing invoke request for '%s'", methodId);
+        return CELIX_ENOMEM;
+    }
+
+    celix_autofree char* reply = NULL;
+    celix_status_t status = proxy->send(proxy->handle, methodName, request, &reply);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    if (reply == NULL) {
+        celix_err_pushf("Expected a reply for '%s', but reply is empty", methodId);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    json_error_t error;
+    json_auto_t* replyJson = json_loads(reply, JSON_DECODE_ANY, &error);
+    if (replyJson == NULL) {
+        celix_err_pushf("Error parsing json '%s', got error '%s'", reply, error.text);
+        return CELIX_SERVICE_EXCEPTION;
+    }
+    json_t* rsError = json_object_get(replyJson, "e");
+    if (rsError != NULL) {
+        //the invocation error of remote service function
+        return (celix_status_t)json_integer_value(rsError);
+    }
+    if (!hasOutput) {
+        return CELIX_SUCCESS;
+    }
+    json_t* r = json_object_get(replyJson, "r");
+    if (r == NULL) {
+        celix_err_pushf("Expected result in reply. got '%s'", reply);
+        return CELIX_SERVICE_EXCEPTION;
+    }
+    *result = json_incref(r);
+    return CELIX_SUCCESS;
+}
+
+int jsonRpcStub_appendArgument(json_t* arguments, json_t* val) {
+    if (arguments == NULL || val == NULL) {
+        json_decref(val);
+        celix_err_push("Error serializing argument");
+        return ERROR;
+    }
+    if (json_array_append_new(arguments, val) != 0) {
+        celix_err_push("Error adding argument");
+        return ERROR;
+    }
+    return OK;
+}
+
+int jsonRpcStub_parseRequest(const char* request, json_t** requestOut, const char** methodId, json_t** arguments) {
+    json_error_t error;
+    json_auto_t* js_request = json_loads(request, 0, &error);
+    if (js_request == NULL) {
+        celix_err_pushf("Got json error: %s", error.text);
+        return ERROR;
+    }
+    const char* sig;
+    if (json_unpack(js_request, "{s:s}", "m", &sig) != 0) {
+        celix_err_push("Error getting method signature");
+        return ERROR;
+    }
+    json_t* args = json_object_get(js_request, "a");
+    if (args == NULL || !json_is_array(args)) {
+        celix_err_pushf("Error getting arguments array for %s", sig);
+        return ERROR;
+    }
+    *methodId = sig;
+    *arguments = args;
+    *requestOut = celix_steal_ptr(js_request);
+    return OK;
+}
+
+int jsonRpcStub_createReply(int funcCallStatus, json_t* result, char** out) {
+    json_auto_t* jsonResult = result;
+    json_auto_t* payload = json_object();
+    if (payload == NULL) {
+        celix_err_push("Error creating response payload");
+        return ERROR;
+    }
+    int status = OK;
+    if (funcCallStatus == 0) {
+        if (jsonResult != NULL) {
+            status = json_object_set_new_nocheck(payload, "r", celix_steal_ptr(jsonResult));
+        }
+    } else {
+        status = json_object_set_new_nocheck(payload, "e", json_integer(funcCallStatus));
+    }
+    if (status != 0) {
+        celix_err_push("Error generating response payload");
+        return ERROR;
+    }
+    //use JSON_COMPACT to reduce the size of the JSON string.
+    *out = json_dumps(payload, JSON_COMPACT | JSON_ENCODE_ANY);
+    return (*out != NULL) ? OK : ERROR;
+}
+
+int jsonRpcStub_getString(const json_t* val, char** out) {
+    *out = NULL;
+    if (val == NULL || json_is_null(val)) {
+        // NULL string is allowed
+        return OK;
+    }
+    if (!json_is_string(val)) {
+        celix_err_pushf("Expected json string type got %i", json_typeof(val));
+        return ERROR;
+    }
+    *out = strdup(json_string_value(val));
+    if (*out == NULL) {
+        celix_err_push("Error allocating memory for string");
+        return ERROR;
+    }
+    return OK;
+}
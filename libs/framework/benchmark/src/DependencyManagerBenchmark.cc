@@ -113,8 +113,108 @@ static void DependencyManagerBenchmark_cxxCreateAndDestroyComponentTest(benchmar
     createAndDestroyComponentTest(state, false);
 }
 
+static int optionalDependencyCallback(void* handle, void* /*svc*/) {
+    auto* count = static_cast<std::atomic<long>*>(handle);
+    count->fetch_add(1, std::memory_order_relaxed);
+    return CELIX_SUCCESS;
+}
+
+/**
+ * Benchmark to measure the cost of optional service dependency churn (register/unregister of a matching service)
+ * for a large number of components which are not started, because they are still waiting for a required service.
+ * With eager tracking every component tracks the optional service, with lazy tracking the optional service is only
+ * tracked when the component is started.
+ */
+static void optionalDependencyChurnTest(benchmark::State& state, celix_dm_service_dependency_tracking_mode_t mode) {
+    DependencyManagerBenchmark benchmark{0};
+    auto ctx = benchmark.fw->getFrameworkBundleContext();
+    auto* cCtx = ctx->getCBundleContext();
+    auto* cMan = ctx->getDependencyManager()->cDependencyManager();
+    std::atomic<long> callbackCount{0};
+
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        auto* cmp = celix_dmComponent_create(cCtx, "test");
+        celix_dmComponent_setImplementation(cmp, &callbackCount);
+
+        auto* requiredDep = celix_dmServiceDependency_create();
+        celix_dmServiceDependency_setService(requiredDep, "MissingService", nullptr, nullptr);
+        celix_dmServiceDependency_setRequired(requiredDep, true);
+        celix_dmComponent_addServiceDependency(cmp, requiredDep);
+
+        auto* optionalDep = celix_dmServiceDependency_create();
+        celix_dmServiceDependency_setService(optionalDep, IService::NAME, nullptr, nullptr);
+        celix_dmServiceDependency_setTrackingMode(optionalDep, mode);
+        celix_dm_service_dependency_callback_options_t opts{};
+        opts.add = optionalDependencyCallback;
+        opts.remove = optionalDependencyCallback;
+        celix_dmServiceDependency_setCallbacksWithOptions(optionalDep, &opts);
+        celix_dmComponent_addServiceDependency(cmp, optionalDep);
+
+        celix_dependencyManager_addAsync(cMan, cmp);
+    }
+    celix_dependencyManager_wait(cMan);
+
+    auto svc = std::make_shared<ServiceImpl>();
+    for (auto _ : state) {
+        // This code gets timed
+        long svcId = celix_bundleContext_registerService(cCtx, svc.get(), IService::NAME, nullptr);
+        celix_bundleContext_unregisterService(cCtx, svcId);
+        celix_bundleContext_waitForEvents(cCtx);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["callbacks"] = benchmark::Counter{(double)callbackCount.load(), benchmark::Counter::kAvgIterations};
+    celix_dependencyManager_removeAllComponents(cMan);
+}
+
+static void DependencyManagerBenchmark_eagerOptionalDependencyChurnTest(benchmark::State& state) {
+    optionalDependencyChurnTest(state, CELIX_DM_SERVICE_DEPENDENCY_TRACKING_EAGER);
+}
+
+static void DependencyManagerBenchmark_lazyOptionalDependencyChurnTest(benchmark::State& state) {
+    optionalDependencyChurnTest(state, CELIX_DM_SERVICE_DEPENDENCY_TRACKING_LAZY);
+}
+
+/**
+ * Benchmark to measure the startup time of components with a suspend-strategy optional service dependency in a
+ * framework that already contains a number of matching services. The services arriving during the component startup
+ * are handled in the same event and therefore share a single suspend/resume of the component.
+ */
+static void DependencyManagerBenchmark_startupWithSuspendStrategyTest(benchmark::State& state) {
+    DependencyManagerBenchmark benchmark{state.range(0)};
+    auto ctx = benchmark.fw->getFrameworkBundleContext();
+    auto* cCtx = ctx->getCBundleContext();
+    auto* cMan = ctx->getDependencyManager()->cDependencyManager();
+    std::atomic<long> callbackCount{0};
+
+    for (auto _ : state) {
+        // This code gets timed
+        auto* cmp = celix_dmComponent_create(cCtx, "test");
+        celix_dmComponent_setImplementation(cmp, &callbackCount);
+
+        auto* dep = celix_dmServiceDependency_create();
+        celix_dmServiceDependency_setService(dep, IService::NAME, nullptr, nullptr);
+        celix_dmServiceDependency_setStrategy(dep, DM_SERVICE_DEPENDENCY_STRATEGY_SUSPEND);
+        celix_dm_service_dependency_callback_options_t opts{};
+        opts.add = optionalDependencyCallback;
+        celix_dmServiceDependency_setCallbacksWithOptions(dep, &opts);
+        celix_dmComponent_addServiceDependency(cmp, dep);
+
+        celix_dependencyManager_addAsync(cMan, cmp);
+        celix_dependencyManager_wait(cMan);
+        assert(celix_dmComponent_currentState(cmp) == CELIX_DM_CMP_STATE_TRACKING_OPTIONAL);
+        celix_dependencyManager_removeAllComponents(cMan);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["callbacks"] = benchmark::Counter{(double)callbackCount.load(), benchmark::Counter::kAvgIterations};
+}
+
 #define CELIX_BENCHMARK(name) \
     BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMillisecond)
 
 CELIX_BENCHMARK(DependencyManagerBenchmark_cCreateAndDestroyComponentTest)->RangeMultiplier(10)->Range(1, 10000);
 CELIX_BENCHMARK(DependencyManagerBenchmark_cxxCreateAndDestroyComponentTest)->RangeMultiplier(10)->Range(1, 10000);
+CELIX_BENCHMARK(DependencyManagerBenchmark_eagerOptionalDependencyChurnTest)->RangeMultiplier(10)->Range(100, 10000);
+CELIX_BENCHMARK(DependencyManagerBenchmark_lazyOptionalDependencyChurnTest)->RangeMultiplier(10)->Range(100, 10000);
+CELIX_BENCHMARK(DependencyManagerBenchmark_startupWithSuspendStrategyTest)->RangeMultiplier(10)->Range(1, 1000);
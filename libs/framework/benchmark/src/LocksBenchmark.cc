@@ -0,0 +1,198 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <thread>
+
+#include "celix/FrameworkFactory.h"
+#include "celix_threads.h"
+
+/**
+ * Benchmarks to compare the scalability of the celix_threads lock types used by the framework, with a growing number
+ * of concurrent threads. The gain of the reader-biased rwlock and adaptive mutex is only visible on many-core machines.
+ *
+ * Note that the numbers reported when the reader-biased rwlock was introduced were measured on a single core machine,
+ * so they only cover the uncontended lock cost. The multi-core scaling and the writer latency under read contention
+ * have not been measured yet.
+ */
+namespace {
+    const int maxThreads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+
+    celix_thread_rwlock_t rwlock;
+    celix_thread_rb_rwlock_t rbRwlock;
+    celix_thread_mutex_t mutex;
+    long protectedCounter = 0;
+
+    class ILockedService {
+    public:
+        static constexpr const char * const NAME = "ILockedService";
+        virtual ~ILockedService() noexcept = default;
+    };
+
+    class LockedServiceImpl : public ILockedService {
+    public:
+        ~LockedServiceImpl() noexcept override = default;
+    };
+
+    void createMutex(int type) {
+        celix_thread_mutexattr_t attr;
+        celixThreadMutexAttr_create(&attr);
+        celixThreadMutexAttr_settype(&attr, type);
+        celixThreadMutex_create(&mutex, &attr);
+        celixThreadMutexAttr_destroy(&attr);
+    }
+}
+
+static void LocksBenchmark_rwlockReadLock(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        celixThreadRwlock_create(&rwlock, nullptr);
+    }
+    for (auto _ : state) {
+        // This code gets timed
+        celixThreadRwlock_readLock(&rwlock);
+        benchmark::DoNotOptimize(protectedCounter);
+        celixThreadRwlock_unlock(&rwlock);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        celixThreadRwlock_destroy(&rwlock);
+    }
+}
+
+static void LocksBenchmark_rbRwlockReadLock(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        celixThreadRbRwlock_create(&rbRwlock);
+    }
+    for (auto _ : state) {
+        // This code gets timed
+        celixThreadRbRwlock_readLock(&rbRwlock);
+        benchmark::DoNotOptimize(protectedCounter);
+        celixThreadRbRwlock_unlock(&rbRwlock);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        celixThreadRbRwlock_destroy(&rbRwlock);
+    }
+}
+
+static void LocksBenchmark_rbRwlockReadMostly(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        celixThreadRbRwlock_create(&rbRwlock);
+    }
+    long i = 0;
+    for (auto _ : state) {
+        // This code gets timed, 1 write per 1000 reads
+        if (++i % 1000 == 0) {
+            celixThreadRbRwlock_writeLock(&rbRwlock);
+            protectedCounter += 1;
+        } else {
+            celixThreadRbRwlock_readLock(&rbRwlock);
+            benchmark::DoNotOptimize(protectedCounter);
+        }
+        celixThreadRbRwlock_unlock(&rbRwlock);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        celixThreadRbRwlock_destroy(&rbRwlock);
+    }
+}
+
+static void LocksBenchmark_rwlockReadMostly(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        celixThreadRwlock_create(&rwlock, nullptr);
+    }
+    long i = 0;
+    for (auto _ : state) {
+        // This code gets timed, 1 write per 1000 reads
+        if (++i % 1000 == 0) {
+            celixThreadRwlock_writeLock(&rwlock);
+            protectedCounter += 1;
+        } else {
+            celixThreadRwlock_readLock(&rwlock);
+            benchmark::DoNotOptimize(protectedCounter);
+        }
+        celixThreadRwlock_unlock(&rwlock);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        celixThreadRwlock_destroy(&rwlock);
+    }
+}
+
+static void mutexLock(benchmark::State& state, int type) {
+    if (state.thread_index() == 0) {
+        createMutex(type);
+    }
+    for (auto _ : state) {
+        // This code gets timed
+        celixThreadMutex_lock(&mutex);
+        protectedCounter += 1;
+        celixThreadMutex_unlock(&mutex);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        celixThreadMutex_destroy(&mutex);
+    }
+}
+
+static void LocksBenchmark_defaultMutexLock(benchmark::State& state) {
+    mutexLock(state, CELIX_THREAD_MUTEX_DEFAULT);
+}
+
+static void LocksBenchmark_adaptiveMutexLock(benchmark::State& state) {
+    mutexLock(state, CELIX_THREAD_MUTEX_ADAPTIVE);
+}
+
+/**
+ * Concurrent service lookups, which read lock the (reader-biased) service registry lock.
+ */
+static void LocksBenchmark_concurrentFindService(benchmark::State& state) {
+    static std::shared_ptr<celix::Framework> fw{};
+    static std::shared_ptr<celix::ServiceRegistration> reg{};
+    if (state.thread_index() == 0) {
+        celix::Properties config{};
+        config.set("CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "error");
+        fw = celix::createFramework(config);
+        reg = fw->getFrameworkBundleContext()->registerService<ILockedService>(std::make_shared<LockedServiceImpl>(), ILockedService::NAME).build();
+        reg->wait();
+    }
+    //note google benchmark synchronizes all threads before starting the timed loop
+    for (auto _ : state) {
+        // This code gets timed
+        long svcId = celix_bundleContext_findService(fw->getFrameworkBundleContext()->getCBundleContext(), ILockedService::NAME);
+        if (svcId < 0) {
+            state.SkipWithError("invalid svc id");
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        reg.reset();
+        fw.reset();
+    }
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond)
+
+CELIX_BENCHMARK(LocksBenchmark_rwlockReadLock)->ThreadRange(1, maxThreads);
+CELIX_BENCHMARK(LocksBenchmark_rbRwlockReadLock)->ThreadRange(1, maxThreads);
+CELIX_BENCHMARK(LocksBenchmark_rwlockReadMostly)->ThreadRange(1, maxThreads);
+CELIX_BENCHMARK(LocksBenchmark_rbRwlockReadMostly)->ThreadRange(1, maxThreads);
+CELIX_BENCHMARK(LocksBenchmark_defaultMutexLock)->ThreadRange(1, maxThreads);
+CELIX_BENCHMARK(LocksBenchmark_adaptiveMutexLock)->ThreadRange(1, maxThreads);
+CELIX_BENCHMARK(LocksBenchmark_concurrentFindService)->ThreadRange(1, maxThreads);
@@ -0,0 +1,174 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include "celix/FrameworkFactory.h"
+#include "service_tracker.h"
+
+//note using c++ service for both the C and C++ benchmark, because this should not impact the performance.
+class ITrackedService {
+public:
+    static constexpr const char * const NAME = "ITrackedService";
+    virtual ~ITrackedService() noexcept = default;
+    virtual int calc() = 0;
+};
+
+class TrackedServiceImpl : public ITrackedService {
+public:
+    ~TrackedServiceImpl() noexcept override = default;
+    int calc() override { return 42; }
+};
+
+/**
+ * Benchmark to measure the overhead of C and C++ service trackers, when services are added/removed and when the
+ * tracked services are used.
+ */
+class ServiceTrackerBenchmark {
+public:
+    explicit ServiceTrackerBenchmark(int64_t _nrOfServiceRegistrations) : nrOfServiceRegistrations{_nrOfServiceRegistrations}, fw{createFw()} {
+        auto ctx = fw->getFrameworkBundleContext();
+        for (int i = 0; i < nrOfServiceRegistrations; ++i) {
+            auto reg = ctx->registerService<ITrackedService>(std::make_shared<TrackedServiceImpl>(), ITrackedService::NAME)
+                    .build();
+            registrations.emplace_back(std::move(reg));
+        }
+        ctx->waitForEvents();
+    }
+
+    static std::shared_ptr<celix::Framework> createFw() {
+        celix::Properties config{};
+        config.set(celix::FRAMEWORK_STATIC_EVENT_QUEUE_SIZE, 1024*10);
+        config.set("CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "error");
+        return celix::createFramework(config);
+    }
+
+    const int64_t nrOfServiceRegistrations;
+    const std::shared_ptr<celix::Framework> fw;
+
+    std::vector<std::shared_ptr<celix::ServiceRegistration>> registrations{};
+};
+
+static void addRemoveTrackedService(benchmark::State& state, bool cTest) {
+    ServiceTrackerBenchmark benchmark{state.range(0)};
+    auto ctx = benchmark.fw->getFrameworkBundleContext();
+    auto* cCtx = ctx->getCBundleContext();
+    std::atomic<long> count{0};
+
+    long trkId = -1;
+    std::shared_ptr<celix::ServiceTracker<ITrackedService>> tracker{};
+    if (cTest) {
+        celix_service_tracking_options_t opts{};
+        opts.filter.serviceName = ITrackedService::NAME;
+        opts.callbackHandle = &count;
+        opts.addWithProperties = [](void* handle, void*, const celix_properties_t*) {
+            static_cast<std::atomic<long>*>(handle)->fetch_add(1);
+        };
+        opts.removeWithProperties = [](void* handle, void*, const celix_properties_t*) {
+            static_cast<std::atomic<long>*>(handle)->fetch_sub(1);
+        };
+        trkId = celix_bundleContext_trackServicesWithOptions(cCtx, &opts);
+    } else {
+        tracker = ctx->trackServices<ITrackedService>(ITrackedService::NAME)
+                .addAddWithPropertiesCallback([&count](const std::shared_ptr<ITrackedService>&, const std::shared_ptr<const celix::Properties>&) {
+                    count.fetch_add(1);
+                })
+                .addRemWithPropertiesCallback([&count](const std::shared_ptr<ITrackedService>&, const std::shared_ptr<const celix::Properties>&) {
+                    count.fetch_sub(1);
+                })
+                .build();
+        tracker->wait();
+    }
+
+    auto svc = std::make_shared<TrackedServiceImpl>();
+    for (auto _ : state) {
+        // This code gets timed
+        auto reg = ctx->registerService<ITrackedService>(svc, ITrackedService::NAME).build();
+        reg->wait();
+        reg->unregister();
+        reg->wait();
+    }
+
+    if (cTest) {
+        celix_bundleContext_stopTracker(cCtx, trkId);
+    } else {
+        tracker->close();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void useTrackedServices(benchmark::State& state, bool cTest) {
+    ServiceTrackerBenchmark benchmark{state.range(0)};
+    auto ctx = benchmark.fw->getFrameworkBundleContext();
+    auto* cCtx = ctx->getCBundleContext();
+    int result = 0;
+
+    if (cTest) {
+        celix_service_tracker_t* tracker = celix_serviceTracker_create(cCtx, ITrackedService::NAME, nullptr, nullptr);
+        for (auto _ : state) {
+            // This code gets timed
+            size_t count = celix_serviceTracker_useServices(tracker, ITrackedService::NAME, &result, [](void* handle, void* voidSvc) {
+                *static_cast<int*>(handle) += static_cast<ITrackedService*>(voidSvc)->calc();
+            }, nullptr, nullptr);
+            if (count != (size_t)benchmark.nrOfServiceRegistrations) {
+                state.SkipWithError("invalid nr of services");
+            }
+        }
+        celix_serviceTracker_destroy(tracker);
+    } else {
+        auto tracker = ctx->trackServices<ITrackedService>(ITrackedService::NAME).build();
+        tracker->wait();
+        for (auto _ : state) {
+            // This code gets timed
+            size_t count = tracker->useServices([&result](ITrackedService& svc) {
+                result += svc.calc();
+            });
+            if (count != (size_t)benchmark.nrOfServiceRegistrations) {
+                state.SkipWithError("invalid nr of services");
+            }
+        }
+        tracker->close();
+    }
+    benchmark::DoNotOptimize(result);
+    state.SetItemsProcessed(state.iterations() * benchmark.nrOfServiceRegistrations);
+}
+
+static void ServiceTrackerBenchmark_cAddRemoveTrackedService(benchmark::State& state) {
+    addRemoveTrackedService(state, true);
+}
+
+static void ServiceTrackerBenchmark_cxxAddRemoveTrackedService(benchmark::State& state) {
+    addRemoveTrackedService(state, false);
+}
+
+static void ServiceTrackerBenchmark_cUseTrackedServices(benchmark::State& state) {
+    useTrackedServices(state, true);
+}
+
+static void ServiceTrackerBenchmark_cxxUseTrackedServices(benchmark::State& state) {
+    useTrackedServices(state, false);
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMicrosecond)
+
+CELIX_BENCHMARK(ServiceTrackerBenchmark_cAddRemoveTrackedService)->RangeMultiplier(10)->Range(1, 1000);
+CELIX_BENCHMARK(ServiceTrackerBenchmark_cxxAddRemoveTrackedService)->RangeMultiplier(10)->Range(1, 1000);
+
+CELIX_BENCHMARK(ServiceTrackerBenchmark_cUseTrackedServices)->RangeMultiplier(10)->Range(1, 1000);
+CELIX_BENCHMARK(ServiceTrackerBenchmark_cxxUseTrackedServices)->RangeMultiplier(10)->Range(1, 1000);
@@ -37,6 +37,7 @@ CELIX_EI_DECLARE(celix_bundleContext_registerServiceFactoryAsync, long);
 CELIX_EI_DECLARE(celix_bundleContext_scheduleEvent, long);
 CELIX_EI_DECLARE(celix_bundleContext_getDependencyManager, celix_dependency_manager_t*);
 CELIX_EI_DECLARE(celix_bundleContext_trackBundlesWithOptionsAsync, long);
+CELIX_EI_DECLARE(celix_bundleContext_addEventQueueIdleCallback, long);
 
 #ifdef __cplusplus
 }
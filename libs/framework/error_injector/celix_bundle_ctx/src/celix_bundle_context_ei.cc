@@ -116,4 +116,11 @@ long __wrap_celix_bundleContext_trackBundlesWithOptionsAsync(celix_bundle_contex
     return __real_celix_bundleContext_trackBundlesWithOptionsAsync(__ctx, __opts);
 }
 
+long __real_celix_bundleContext_addEventQueueIdleCallback(celix_bundle_context_t *__ctx, void* __callbackData, void (*__idleCallback)(void*));
+CELIX_EI_DEFINE(celix_bundleContext_addEventQueueIdleCallback, long)
+long __wrap_celix_bundleContext_addEventQueueIdleCallback(celix_bundle_context_t *__ctx, void* __callbackData, void (*__idleCallback)(void*)) {
+    CELIX_EI_IMPL(celix_bundleContext_addEventQueueIdleCallback);
+    return __real_celix_bundleContext_addEventQueueIdleCallback(__ctx, __callbackData, __idleCallback);
+}
+
 }
\ No newline at end of file
@@ -17,7 +17,9 @@
  * under the License.
  */
 
+#include <dirent.h>
 #include <gtest/gtest.h>
+#include <sys/stat.h>
 
 #include "celix/FrameworkFactory.h"
 #include "celix_constants.h"
@@ -29,6 +31,7 @@
 //including private headers, which should only be used for testing
 #include "bundle_archive_private.h"
 #include "bundle_private.h"
+#include "framework_private.h"
 
 
 class CxxBundleArchiveTestSuite : public ::testing::Test {
@@ -271,3 +274,65 @@ TEST_F(CxxBundleArchiveTestSuite, BundleArchivesCreatedBeforeStarting) {
     //Then the bundle id will be 1, because the bundle archive is already created
     EXPECT_EQ(bndId, 1); // <-- note whitebox knowledge of the bundle id
 }
+
+TEST_F(CxxBundleArchiveTestSuite, BundleArchivesShareResourceCacheFilesTest) {
+    auto fw = celix::createFramework({
+        {"CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "trace"},
+        {CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true"}
+    });
+    auto* cache = fw->getCFramework()->cache;
+
+    //Given two bundle archives for the same bundle zip
+    bundle_archive_t* archive1 = nullptr;
+    bundle_archive_t* archive2 = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_createArchive(cache, 100, SIMPLE_TEST_BUNDLE1_LOCATION, &archive1));
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_createArchive(cache, 101, SIMPLE_TEST_BUNDLE1_LOCATION, &archive2));
+
+    //Then the extracted files are shared using the content store of the bundle cache
+    std::string manifest1 = std::string{celix_bundleArchive_getCurrentRevisionRoot(archive1)} + "/" + CELIX_BUNDLE_MANIFEST_REL_PATH;
+    std::string manifest2 = std::string{celix_bundleArchive_getCurrentRevisionRoot(archive2)} + "/" + CELIX_BUNDLE_MANIFEST_REL_PATH;
+    struct stat st1{};
+    struct stat st2{};
+    ASSERT_EQ(0, stat(manifest1.c_str(), &st1));
+    ASSERT_EQ(0, stat(manifest2.c_str(), &st2));
+    EXPECT_EQ(st1.st_ino, st2.st_ino);
+    EXPECT_EQ(3, st1.st_nlink);
+    EXPECT_TRUE(celix_utils_directoryExists(celix_bundleCache_getContentStoreDir(cache)));
+
+    //When the bundle zip is touched and the bundle archive is created again
+    celix_bundleCache_destroyArchive(cache, archive1);
+    std::this_thread::sleep_for(std::chrono::milliseconds{100}); //wait so that the zip <-> archive dir modification time is different
+    celix_utils_touch(SIMPLE_TEST_BUNDLE1_LOCATION);
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_createArchive(cache, 100, SIMPLE_TEST_BUNDLE1_LOCATION, &archive1));
+
+    //Then the unchanged files are not extracted again
+    struct stat updatedSt1{};
+    ASSERT_EQ(0, stat(manifest1.c_str(), &updatedSt1));
+    EXPECT_EQ(st1.st_ino, updatedSt1.st_ino);
+
+    //When the bundle archives are removed
+    celix_bundleArchive_invalidate(archive1);
+    celix_bundleArchive_invalidate(archive2);
+    celix_bundleCache_destroyArchive(cache, archive1);
+    celix_bundleCache_destroyArchive(cache, archive2);
+
+    //Then the resource caches are removed and the content store no longer contains files
+    EXPECT_FALSE(celix_utils_fileExists(manifest1.c_str()));
+    EXPECT_FALSE(celix_utils_fileExists(manifest2.c_str()));
+    int nrOfStoredFiles = 0;
+    std::string storeDir = celix_bundleCache_getContentStoreDir(cache);
+    DIR* dir = opendir(storeDir.c_str());
+    ASSERT_NE(nullptr, dir);
+    for (struct dirent* ent = readdir(dir); ent != nullptr; ent = readdir(dir)) {
+        std::string fanOutDir = storeDir + "/" + ent->d_name;
+        DIR* subDir = ent->d_name[0] != '.' ? opendir(fanOutDir.c_str()) : nullptr;
+        for (struct dirent* sub = subDir ? readdir(subDir) : nullptr; sub != nullptr; sub = readdir(subDir)) {
+            nrOfStoredFiles += sub->d_name[0] != '.' ? 1 : 0;
+        }
+        if (subDir) {
+            closedir(subDir);
+        }
+    }
+    closedir(dir);
+    EXPECT_EQ(0, nrOfStoredFiles);
+}
@@ -45,7 +45,8 @@ class BundleArchiveWithErrorInjectionTestSuite : public ::testing::Test {
     BundleArchiveWithErrorInjectionTestSuite() {
         fw = celix::createFramework({{"CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "trace"},
                                      {CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true"},
-                                     {CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED, "false"}});
+                                     {CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED, "false"},
+                                     {CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED, "false"}});
         ctx = fw->getFrameworkBundleContext();
     }
 
@@ -181,6 +182,7 @@ class CelixBundleArchiveErrorInjectionTestSuite : public ::testing::Test {
         celix_ei_expect_celix_utils_writeOrCreateString(nullptr, 0, nullptr);
         celix_ei_expect_celix_utils_extractZipData(nullptr, 0, CELIX_SUCCESS);
         celix_ei_expect_celix_utils_extractZipFile(nullptr, 0, CELIX_SUCCESS);
+        celix_ei_expect_celix_utils_extractZipFileIncrementally(nullptr, 0, CELIX_SUCCESS);
     }
     struct celix_framework fw {};
 };
@@ -226,6 +228,21 @@ TEST_F(CelixBundleArchiveErrorInjectionTestSuite, ArchiveCreateErrorTest) {
     archive = nullptr;
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
     celix_utils_touch(SIMPLE_TEST_BUNDLE1_LOCATION);
+    celix_ei_expect_celix_utils_extractZipFileIncrementally((void*)celix_bundleArchive_create, 4, CELIX_FILE_IO_EXCEPTION);
+    EXPECT_EQ(CELIX_FILE_IO_EXCEPTION,
+              celix_bundleArchive_create(&fw, TEST_ARCHIVE_ROOT, 1, SIMPLE_TEST_BUNDLE1_LOCATION, &archive));
+    EXPECT_EQ(nullptr, archive);
+    EXPECT_FALSE(celix_utils_directoryExists(TEST_ARCHIVE_ROOT));
+    teardownErrorInjectors();
+
+    EXPECT_EQ(CELIX_SUCCESS,
+              celix_bundleArchive_create(&fw, TEST_ARCHIVE_ROOT, 1, SIMPLE_TEST_BUNDLE1_LOCATION, &archive));
+    bundleArchive_destroy(archive);
+    archive = nullptr;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    celix_utils_touch(SIMPLE_TEST_BUNDLE1_LOCATION);
+    // without a resource cache index, the resource cache is removed before extracting
+    unlink((std::string{TEST_ARCHIVE_ROOT} + "/" + CELIX_BUNDLE_ARCHIVE_RESOURCE_CACHE_INDEX_FILE_NAME).c_str());
     celix_ei_expect_celix_utils_deleteDirectory((void*)celix_bundleArchive_create, 3, CELIX_FILE_IO_EXCEPTION);
     EXPECT_EQ(CELIX_FILE_IO_EXCEPTION,
               celix_bundleArchive_create(&fw, TEST_ARCHIVE_ROOT, 1, SIMPLE_TEST_BUNDLE1_LOCATION, &archive));
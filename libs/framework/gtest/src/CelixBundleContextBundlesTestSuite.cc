@@ -54,6 +54,7 @@ public:
         celix_properties_set(properties, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
         celix_properties_set(properties, CELIX_FRAMEWORK_CACHE_DIR, ".cacheBundleContextTestFramework");
         celix_properties_set(properties, CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED, "false");
+        celix_properties_set(properties, CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED, "false");
 
 
         fw = celix_frameworkFactory_createFramework(properties);
@@ -40,6 +40,7 @@ public:
         celix_properties_setBool(properties, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, true);
         celix_properties_set(properties, CELIX_FRAMEWORK_CACHE_DIR, ".cacheBundleContextTestFramework");
         celix_properties_setBool(properties, CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED, false);
+        celix_properties_setBool(properties, CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED, false);
         celix_properties_set(properties, CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE, "10");
 
         fw = celix_frameworkFactory_createFramework(properties);
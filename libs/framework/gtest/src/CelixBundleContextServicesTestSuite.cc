@@ -26,11 +26,14 @@
 #include <condition_variable>
 #include <cstring>
 #include <future>
+#include <atomic>
 
 #include "celix_api.h"
 #include "celix_framework_factory.h"
 #include "celix_service_factory.h"
+#include "celix_stdlib_cleanup.h"
 #include "service_tracker_private.h"
+#include "framework_private.h"
 
 class CelixBundleContextServicesTestSuite : public ::testing::Test {
 public:
@@ -47,6 +50,7 @@ public:
         celix_properties_set(properties, CELIX_FRAMEWORK_CACHE_DIR, ".cacheBundleContextTestFramework");
         celix_properties_set(properties, "CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "trace");
         celix_properties_set(properties, "CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED", "false");
+        celix_properties_set(properties, CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED, "false");
         celix_properties_setLong(properties, CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE,  256); //ensure that the floodEventLoopTest overflows the static event queue size
 
         fw = celix_frameworkFactory_createFramework(properties);
@@ -2071,3 +2075,86 @@ TEST_F(CelixBundleContextServicesTestSuite, RegisterServiceWithInvalidRankingAnd
 
     celix_bundleContext_unregisterService(ctx, svcId);
 }
+
+TEST_F(CelixBundleContextServicesTestSuite, SharedFilterTest) {
+    //Given the service registry of the framework
+    auto* registry = fw->registry;
+
+    //When acquiring filters with identical filter strings (ignoring leading and trailing whitespaces)
+    const celix_filter_t* filter1 = celix_serviceRegistry_acquireFilter(registry, "(" CELIX_FRAMEWORK_SERVICE_NAME "=TestService)");
+    const celix_filter_t* filter2 = celix_serviceRegistry_acquireFilter(registry, "  (" CELIX_FRAMEWORK_SERVICE_NAME "=TestService) ");
+    ASSERT_NE(nullptr, filter1);
+
+    //Then the same shared filter instance is returned
+    EXPECT_EQ(filter1, filter2);
+
+    //And a NULL or empty filter string results in a shared match-all filter
+    const celix_filter_t* matchAll1 = celix_serviceRegistry_acquireFilter(registry, nullptr);
+    const celix_filter_t* matchAll2 = celix_serviceRegistry_acquireFilter(registry, "");
+    EXPECT_EQ(matchAll1, matchAll2);
+    EXPECT_STREQ("(|)", celix_filter_getFilterString(matchAll1));
+
+    //And an invalid filter string results in a NULL filter
+    EXPECT_EQ(nullptr, celix_serviceRegistry_acquireFilter(registry, "(invalid"));
+    celix_err_resetErrors();
+
+    celix_serviceRegistry_releaseFilter(registry, matchAll2);
+    celix_serviceRegistry_releaseFilter(registry, matchAll1);
+    celix_serviceRegistry_releaseFilter(registry, filter2);
+
+    //When the filter is still used, it can still be used to match
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, CELIX_FRAMEWORK_SERVICE_NAME, "TestService");
+    EXPECT_TRUE(celix_filter_match(filter1, props));
+    celix_serviceRegistry_releaseFilter(registry, filter1);
+}
+
+TEST_F(CelixBundleContextServicesTestSuite, TrackersWithIdenticalFiltersTest) {
+    //Given multiple trackers with an identical filter
+    std::atomic<int> count{0};
+    celix_service_tracking_options_t opts{};
+    opts.filter.serviceName = "TestService";
+    opts.filter.filter = "(prop=match)";
+    opts.callbackHandle = &count;
+    opts.add = [](void* handle, void* /*svc*/) {
+        auto* c = static_cast<std::atomic<int>*>(handle);
+        c->fetch_add(1);
+    };
+    long trkId1 = celix_bundleContext_trackServicesWithOptions(ctx, &opts);
+    long trkId2 = celix_bundleContext_trackServicesWithOptions(ctx, &opts);
+    long trkId3 = celix_bundleContext_trackServicesWithOptions(ctx, &opts);
+
+    //When registering a matching and a not matching service
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, "prop", "match");
+    long svcId1 = celix_bundleContext_registerService(ctx, (void*)0x42, "TestService", props);
+    props = celix_properties_create();
+    celix_properties_set(props, "prop", "nomatch");
+    long svcId2 = celix_bundleContext_registerService(ctx, (void*)0x43, "TestService", props);
+
+    //Then every tracker is only called for the matching service
+    EXPECT_EQ(3, count.load());
+
+    //And findServices with the same filter also finds the matching service
+    auto* svcIds = celix_bundleContext_findServicesWithOptions(ctx, &opts.filter);
+    EXPECT_EQ(1, celix_arrayList_size(svcIds));
+    EXPECT_EQ(svcId1, celix_arrayList_getLong(svcIds, 0));
+    celix_arrayList_destroy(svcIds);
+
+    //And findServicesWithFilter with a separately parsed, identical filter uses the shared filter and finds the
+    //matching service
+    celix_autofree char* filterStr = celix_serviceRegistry_createFilterFor(fw->registry, "TestService", nullptr, "(prop=match)");
+    celix_autoptr(celix_filter_t) filter = celix_filter_create(filterStr);
+    ASSERT_NE(nullptr, filter);
+    svcIds = celix_serviceRegistry_findServicesWithFilter(fw->registry, filter);
+    ASSERT_NE(nullptr, svcIds);
+    EXPECT_EQ(1, celix_arrayList_size(svcIds));
+    EXPECT_EQ(svcId1, celix_arrayList_getLong(svcIds, 0));
+    celix_arrayList_destroy(svcIds);
+
+    celix_bundleContext_stopTracker(ctx, trkId1);
+    celix_bundleContext_stopTracker(ctx, trkId2);
+    celix_bundleContext_stopTracker(ctx, trkId3);
+    celix_bundleContext_unregisterService(ctx, svcId1);
+    celix_bundleContext_unregisterService(ctx, svcId2);
+}
@@ -22,6 +22,8 @@
 #include <chrono>
 #include <thread>
 #include <future>
+#include <condition_variable>
+#include <mutex>
 
 #include "celix_launcher.h"
 #include "celix_framework_factory.h"
@@ -98,6 +100,90 @@ TEST_F(CelixFrameworkTestSuite, TimedWaitEventQueueTest) {
     EXPECT_EQ(CELIX_SUCCESS, status);
 }
 
+TEST_F(CelixFrameworkTestSuite, EventQueueIdleCallbackTest) {
+    struct IdleCallbackData {
+        std::mutex mutex{};
+        std::condition_variable cond{};
+        int count{0};
+        bool queueEmptyDuringCallback{true};
+        celix_framework_t* fw{nullptr};
+    } data{};
+    data.fw = framework.get();
+    auto* ctx = celix_framework_getFrameworkContext(framework.get());
+    auto waitForCount = [&data](int expected) {
+        std::unique_lock<std::mutex> lck{data.mutex};
+        return data.cond.wait_for(lck, std::chrono::seconds{5}, [&]{ return data.count >= expected; });
+    };
+
+    //When an idle callback is added
+    long id = celix_bundleContext_addEventQueueIdleCallback(ctx, &data, [](void* voidData) {
+        auto* d = static_cast<IdleCallbackData*>(voidData);
+        std::lock_guard<std::mutex> lck{d->mutex};
+        d->queueEmptyDuringCallback = d->queueEmptyDuringCallback && celix_framework_isEventQueueEmpty(d->fw);
+        d->count += 1;
+        d->cond.notify_all();
+    });
+    EXPECT_GE(id, 0);
+
+    //Then the idle callback is called once, without any events being processed
+    EXPECT_TRUE(waitForCount(1));
+
+    //When an event is processed
+    int countBeforeEvent;
+    {
+        std::lock_guard<std::mutex> lck{data.mutex};
+        countBeforeEvent = data.count;
+    }
+    long eventId = celix_framework_fireGenericEvent(framework.get(), -1L, -1L, "test", nullptr, [](void*) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }, nullptr, nullptr);
+    celix_framework_waitForGenericEvent(framework.get(), eventId);
+
+    //Then the idle callback is called again when the event queue became empty
+    EXPECT_TRUE(waitForCount(countBeforeEvent + 1));
+    {
+        std::lock_guard<std::mutex> lck{data.mutex};
+        EXPECT_TRUE(data.queueEmptyDuringCallback);
+    }
+
+    //When the idle callback is removed, it can not be removed again
+    EXPECT_TRUE(celix_bundleContext_removeEventQueueIdleCallback(ctx, id));
+    EXPECT_FALSE(celix_bundleContext_removeEventQueueIdleCallback(ctx, id));
+}
+
+TEST_F(CelixFrameworkTestSuite, RemoveEventQueueIdleCallbackFromIdleCallbackTest) {
+    struct IdleCallbackData {
+        celix_bundle_context_t* ctx{nullptr};
+        std::atomic<long> id{-1L};
+        std::atomic<int> count{0};
+    } data{};
+    data.ctx = celix_framework_getFrameworkContext(framework.get());
+
+    //When an idle callback is added that removes itself
+    data.id = celix_bundleContext_addEventQueueIdleCallback(data.ctx, &data, [](void* voidData) {
+        auto* d = static_cast<IdleCallbackData*>(voidData);
+        while (d->id < 0) {
+            std::this_thread::yield(); //note idle callback can be called before the id is stored
+        }
+        d->count += 1;
+        celix_bundleContext_removeEventQueueIdleCallback(d->ctx, d->id);
+    });
+    EXPECT_GE(data.id.load(), 0);
+
+    //Then the idle callback is called once, also if more events are processed
+    for (int i = 0; i < 3; ++i) {
+        long eventId = celix_framework_fireGenericEvent(framework.get(), -1L, -1L, "test", nullptr, [](void*) {}, nullptr, nullptr);
+        celix_framework_waitForGenericEvent(framework.get(), eventId);
+    }
+    auto start = std::chrono::steady_clock::now();
+    while (data.count == 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds{5}) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    celix_framework_waitForEmptyEventQueue(framework.get());
+    EXPECT_EQ(1, data.count.load());
+    EXPECT_FALSE(celix_bundleContext_removeEventQueueIdleCallback(data.ctx, data.id));
+}
+
 TEST_F(CelixFrameworkTestSuite, AsyncInstallStartStopUpdateAndUninstallBundleTest) {
     long bndId = celix_framework_installBundleAsync(framework.get(), SIMPLE_TEST_BUNDLE1_LOCATION, false);
     EXPECT_GE(bndId, 0);
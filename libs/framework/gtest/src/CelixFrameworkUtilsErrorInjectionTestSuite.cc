@@ -39,7 +39,8 @@ public:
     CelixFrameworkUtilsErrorInjectionTestSuite () {
         framework = celix::createFramework({
             {"CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "trace"},
-            {CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED, "false"}
+            {CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED, "false"},
+            {CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED, "false"}
         });
     }
 
@@ -38,6 +38,7 @@ public:
         celix_properties_set(properties, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
         celix_properties_setBool(properties, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, true);
         celix_properties_set(properties, "CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED", "false");
+        celix_properties_set(properties, CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED, "false");
 
         auto* cfw = celix_frameworkFactory_createFramework(properties);
         fw = std::shared_ptr<celix_framework_t>{cfw, [](celix_framework_t* f){ celix_frameworkFactory_destroyFramework(f); }};
@@ -887,3 +888,79 @@ TEST_F(CxxBundleContextTestSuite, UseTrackedServidesTest) {
     });
     EXPECT_TRUE(called);
 }
+
+TEST_F(CxxBundleContextTestSuite, UseTrackedServicesWhileTrackerIsUpdatedTest) {
+    // Given a registered service with a service ranking of 10 and a tracker for the service
+    auto svc1 = std::make_shared<CInterface>(CInterface{nullptr, nullptr});
+    auto svcReg1 = ctx->registerService<CInterface>(svc1).addProperty(celix::SERVICE_RANKING, 10).build();
+    auto tracker = ctx->trackServices<CInterface>().build();
+    tracker->wait();
+
+    // When the tracker is used from within a useServices callback
+    // Then this does not deadlock
+    size_t nrCalled = tracker->useServices([&tracker](CInterface&) {
+        EXPECT_EQ(1, tracker->getServices().size());
+        EXPECT_TRUE(tracker->useService([](CInterface&) {/*nop*/}));
+    });
+    EXPECT_EQ(1, nrCalled);
+
+    // When a service is registered and unregistered while using the tracked services
+    nrCalled = tracker->useServicesWithProperties([this](CInterface&, const celix::Properties& props) {
+        EXPECT_EQ(10, props.getAsLong(celix::SERVICE_RANKING, -1L));
+        auto svc2 = std::make_shared<CInterface>(CInterface{nullptr, nullptr});
+        auto svcReg2 = ctx->registerService<CInterface>(svc2).addProperty(celix::SERVICE_RANKING, 20).build();
+        svcReg2->wait();
+        svcReg2->unregister();
+        svcReg2->wait();
+    });
+
+    // Then the used services are not changed during the use
+    EXPECT_EQ(1, nrCalled);
+
+    // And the service properties and owner of a tracked service stay valid while the service is in use
+    auto svc = tracker->getHighestRankingService();
+    ASSERT_NE(nullptr, svc);
+    EXPECT_EQ(svc1.get(), svc.get());
+    svc = nullptr;
+
+    // When the tracked service is unregistered, the tracker is empty
+    svcReg1->unregister();
+    svcReg1->wait();
+    EXPECT_EQ(0, tracker->getServiceCount());
+    EXPECT_EQ(nullptr, tracker->getHighestRankingService());
+    EXPECT_EQ(0, tracker->useServices([](CInterface&) {/*nop*/}));
+}
+
+TEST_F(CxxBundleContextTestSuite, FindServicesWithServiceDescriptorFilterTest) {
+    // Given a service descriptor for the TestInterface
+    EXPECT_EQ(celix::typeName<TestInterface>(), celix::ServiceDescriptor<TestInterface>::name());
+    EXPECT_EQ(&celix::ServiceDescriptor<TestInterface>::filter(), &celix::ServiceDescriptor<TestInterface>::filter());
+
+    // And a filter created once using the service descriptor
+    auto filter = celix::ServiceDescriptor<TestInterface>::createFilter("(key=value)");
+
+    // When no services are registered
+    // Then no services are found
+    EXPECT_EQ(-1, ctx->findServiceWithFilter(filter));
+    EXPECT_TRUE(ctx->findServices<TestInterface>().empty());
+
+    // When 2 services are registered, of which one with the property key=value
+    auto reg1 = ctx->registerService<TestInterface>(std::make_shared<TestImplementation>()).build();
+    auto reg2 = ctx->registerService<TestInterface>(std::make_shared<TestImplementation>())
+            .addProperty("key", "value")
+            .build();
+
+    // Then both services are found using the service descriptor filter
+    EXPECT_EQ(2, ctx->findServices<TestInterface>().size());
+    EXPECT_EQ(reg1->getServiceId(), ctx->findService<TestInterface>());
+
+    // And only the service with key=value is found using the created filter
+    EXPECT_EQ(reg2->getServiceId(), ctx->findServiceWithFilter(filter));
+    auto svcIds = ctx->findServicesWithFilter(filter);
+    ASSERT_EQ(1, svcIds.size());
+    EXPECT_EQ(reg2->getServiceId(), svcIds[0]);
+
+    // And the C API gives the same result
+    EXPECT_EQ(reg2->getServiceId(), celix_bundleContext_findServiceWithFilter(ctx->getCBundleContext(), filter.getCFilter()));
+    EXPECT_EQ(nullptr, celix_bundleContext_findServicesWithFilter(ctx->getCBundleContext(), nullptr));
+}
@@ -225,6 +225,37 @@ TEST_F(DependencyManagerTestSuite, TestCheckActive) {
     ASSERT_FALSE(celix_dependencyManager_areComponentsActive(mng));
 }
 
+TEST_F(DependencyManagerTestSuite, TestNrOfInactiveComponents) {
+    auto *mng = celix_bundleContext_getDependencyManager(ctx);
+    EXPECT_EQ(0, celix_dependencyManager_nrOfInactiveComponentsOfAllBundles(mng));
+
+    auto *cmp1 = celix_dmComponent_create(ctx, "test1");
+    auto *dep = celix_dmServiceDependency_create();
+    celix_dmServiceDependency_setService(dep, "svcname", nullptr, nullptr);
+    celix_dmServiceDependency_setRequired(dep, true);
+    celix_dmComponent_addServiceDependency(cmp1, dep); //required dep -> cmp not active
+    auto *cmp2 = celix_dmComponent_create(ctx, "test2"); //no deps -> cmp active
+
+    celix_dependencyManager_add(mng, cmp1);
+    celix_dependencyManager_add(mng, cmp2);
+    EXPECT_EQ(1, celix_dependencyManager_nrOfInactiveComponentsOfAllBundles(mng));
+
+    //When the required service is registered, the component becomes active
+    void* dummySvc = (void*)0x42;
+    long svcId = celix_bundleContext_registerService(ctx, dummySvc, "svcname", nullptr);
+    celix_bundleContext_waitForEvents(ctx);
+    EXPECT_EQ(0, celix_dependencyManager_nrOfInactiveComponentsOfAllBundles(mng));
+
+    //When the required service is unregistered, the component becomes inactive again
+    celix_bundleContext_unregisterService(ctx, svcId);
+    celix_bundleContext_waitForEvents(ctx);
+    EXPECT_EQ(1, celix_dependencyManager_nrOfInactiveComponentsOfAllBundles(mng));
+
+    //When the inactive component is removed, it is not counted anymore
+    celix_dependencyManager_remove(mng, cmp1);
+    EXPECT_EQ(0, celix_dependencyManager_nrOfInactiveComponentsOfAllBundles(mng));
+}
+
 class TestComponent {
 
 };
@@ -988,8 +1019,8 @@ TEST_F(DependencyManagerTestSuite, UnneededSuspendIsPrevented) {
 
     EXPECT_EQ(cmp1.getInstance().startCount, 1); //only once during creation
     EXPECT_EQ(cmp1.getInstance().stopCount, 0);
-    EXPECT_EQ(cmp2.getInstance().startCount, 3); //1x creation, 1x suspend for set, 1x suspend for add
-    EXPECT_EQ(cmp2.getInstance().stopCount, 2); //1x suspend for set, 1x suspend for add
+    EXPECT_EQ(cmp2.getInstance().startCount, 2); //1x creation, 1x suspend for set and add (batched in a single event)
+    EXPECT_EQ(cmp2.getInstance().stopCount, 1); //1x suspend for set and add
 
     cmp1.getInstance().startCount = 0;
     cmp1.getInstance().stopCount = 0;
@@ -1003,6 +1034,80 @@ TEST_F(DependencyManagerTestSuite, UnneededSuspendIsPrevented) {
     EXPECT_EQ(cmp2.getInstance().stopCount, 2); //1x suspend for set nullptr, 1x suspend for rem
 }
 
+TEST_F(DependencyManagerTestSuite, LazyOptionalDependencyIsOnlyTrackedWhenStarted) {
+    class LazyComponent {
+    public:
+        void start() {
+            startCount++;
+            addCountDuringStart = addCount.load();
+        }
+
+        void stop() {
+            stopCount++;
+        }
+
+        void addService(TestService* /*svc*/) {
+            addCount++;
+        }
+
+        void remService(TestService* /*svc*/) {
+            remCount++;
+        }
+
+        std::atomic<int> startCount{0};
+        std::atomic<int> stopCount{0};
+        std::atomic<int> addCount{0};
+        std::atomic<int> remCount{0};
+        std::atomic<int> addCountDuringStart{0};
+    };
+
+    celix::dm::DependencyManager dm{ctx};
+    auto& cmp = dm.createComponent<LazyComponent>("LazyCmp")
+            .setCallbacks(nullptr, &LazyComponent::start, &LazyComponent::stop, nullptr);
+    cmp.createServiceDependency<TestService>("RequiredService").setRequired(true);
+    cmp.createServiceDependency<TestService>("OptionalService")
+            .setTrackingMode(celix::dm::DependencyTrackingMode::lazy)
+            .setCallbacks(&LazyComponent::addService, &LazyComponent::remService);
+    cmp.build();
+
+    TestService svc;
+    long optSvcId1 = celix_bundleContext_registerService(ctx, &svc, "OptionalService", nullptr);
+    long optSvcId2 = celix_bundleContext_registerService(ctx, &svc, "OptionalService", nullptr);
+    celix_bundleContext_waitForEvents(ctx);
+    EXPECT_EQ(cmp.getState(), celix::dm::ComponentState::WAITING_FOR_REQUIRED);
+    EXPECT_EQ(cmp.getInstance().addCount, 0); //not tracked while not started
+
+    //starting the component injects all optional services before the start callback, without suspending
+    long reqSvcId = celix_bundleContext_registerService(ctx, &svc, "RequiredService", nullptr);
+    celix_bundleContext_waitForEvents(ctx);
+    EXPECT_EQ(cmp.getState(), celix::dm::ComponentState::TRACKING_OPTIONAL);
+    EXPECT_EQ(cmp.getInstance().addCountDuringStart, 2);
+    EXPECT_EQ(cmp.getInstance().startCount, 1);
+    EXPECT_EQ(cmp.getInstance().stopCount, 0);
+
+    //while started, a lazy dependency behaves as an eager dependency
+    celix_bundleContext_unregisterService(ctx, optSvcId2);
+    celix_bundleContext_waitForEvents(ctx);
+    EXPECT_EQ(cmp.getInstance().remCount, 1);
+    EXPECT_EQ(cmp.getInstance().startCount, 2); //suspend for remove
+    EXPECT_EQ(cmp.getInstance().stopCount, 1);
+
+    //stopping the component closes the lazy tracker
+    celix_bundleContext_unregisterService(ctx, reqSvcId);
+    celix_bundleContext_waitForEvents(ctx);
+    EXPECT_EQ(cmp.getState(), celix::dm::ComponentState::INSTANTIATED_AND_WAITING_FOR_REQUIRED);
+    EXPECT_EQ(cmp.getInstance().stopCount, 2);
+    EXPECT_EQ(cmp.getInstance().remCount, 2);
+
+    optSvcId2 = celix_bundleContext_registerService(ctx, &svc, "OptionalService", nullptr);
+    celix_bundleContext_unregisterService(ctx, optSvcId2);
+    celix_bundleContext_waitForEvents(ctx);
+    EXPECT_EQ(cmp.getInstance().addCount, 2);
+    EXPECT_EQ(cmp.getInstance().remCount, 2);
+
+    celix_bundleContext_unregisterService(ctx, optSvcId1);
+}
+
 TEST_F(DependencyManagerTestSuite, ExceptionsInLifecycle) {
     class ExceptionComponent {
     public:
@@ -22,6 +22,11 @@
 #include "celix/Constants.h"
 #include "celix/FrameworkFactory.h"
 #include "celix_condition.h"
+#include "celix_metrics_provider.h"
+#include "framework_private.h"
+
+#include <map>
+#include <string>
 
 class FrameworkBundleTestSuite : public ::testing::Test {
   public:
@@ -120,3 +125,73 @@ TEST_F(FrameworkBundleTestSuite, FrameworkReadyRegisteredLaterTest) {
     long testySvcId = ctx->findServiceWithName(CELIX_CONDITION_SERVICE_NAME, testFilter);
     EXPECT_GT(readySvcId, testySvcId);
 }
+
+TEST_F(FrameworkBundleTestSuite, FrameworkMetricsProviderTest) {
+    // Given a Celix framework
+    auto fw = celix::createFramework();
+    auto ctx = fw->getFrameworkBundleContext();
+
+    // And a registered and tracked service
+    auto reg = ctx->registerService<celix_condition>(std::make_shared<celix_condition>(), CELIX_CONDITION_SERVICE_NAME)
+                   .addProperty(CELIX_CONDITION_ID, "metrics")
+                   .build();
+    auto tracker = ctx->trackServices<celix_condition>(CELIX_CONDITION_SERVICE_NAME).build();
+    tracker->wait();
+    ctx->waitForEvents();
+
+    // When the metrics of the framework metrics provider are collected
+    std::map<std::string, double> values{};
+    auto count = ctx->useService<celix_metrics_provider>(CELIX_METRICS_PROVIDER_SERVICE_NAME)
+                     .setFilter(std::string{"("} + CELIX_METRICS_PROVIDER_NAME + "=framework)")
+                     .addUseCallback([&](celix_metrics_provider& provider) {
+                         auto status = provider.collectMetrics(
+                             provider.handle, &values, [](void* handle, const celix_metric_t* metric) {
+                                 auto* map = static_cast<std::map<std::string, double>*>(handle);
+                                 (*map)[metric->name] = metric->type == CELIX_METRIC_TYPE_HISTOGRAM
+                                                            ? (double)metric->histogram->count
+                                                            : metric->value;
+                             });
+                         EXPECT_EQ(CELIX_SUCCESS, status);
+                     })
+                     .build();
+    EXPECT_EQ(1, count);
+
+    // Then the event dispatcher, service registry and service tracker metrics are provided
+    EXPECT_GT(values["celix_framework_events_processed_total"], 0);
+    EXPECT_GT(values["celix_framework_event_processing_seconds"], 0);
+    EXPECT_GT(values["celix_framework_event_queue_latency_seconds"], 0);
+    EXPECT_GE(values["celix_framework_registered_services"], 3); // true condition, metrics provider and "metrics"
+    EXPECT_GE(values["celix_framework_service_registrations_total"], values["celix_framework_registered_services"]);
+    EXPECT_GE(values["celix_framework_service_listeners"], 1);
+    EXPECT_GE(values["celix_framework_open_service_trackers"], 1);
+    EXPECT_GT(values["celix_framework_service_tracker_events_total"], 0);
+    EXPECT_EQ(1, values.count("celix_framework_event_queue_size"));
+}
+
+TEST_F(FrameworkBundleTestSuite, FrameworkMetricsProviderDisabledTest) {
+    // Given a Celix framework with the framework metrics provider disabled
+    auto fw = celix::createFramework({{CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED, "false"}});
+    auto ctx = fw->getFrameworkBundleContext();
+
+    // When events are handled
+    auto reg = ctx->registerService<celix_condition>(std::make_shared<celix_condition>(), CELIX_CONDITION_SERVICE_NAME)
+                   .addProperty(CELIX_CONDITION_ID, "metrics")
+                   .build();
+    ctx->waitForEvents();
+
+    // Then no metrics provider service is registered
+    EXPECT_EQ(-1L, ctx->findServiceWithName(CELIX_METRICS_PROVIDER_SERVICE_NAME));
+
+    // And the handled events are counted, but the event timings are not recorded (white-box test)
+    std::map<std::string, double> values{};
+    auto status = celix_framework_collectMetrics(
+        fw->getCFramework(), &values, [](void* handle, const celix_metric_t* metric) {
+            auto* map = static_cast<std::map<std::string, double>*>(handle);
+            (*map)[metric->name] =
+                metric->type == CELIX_METRIC_TYPE_HISTOGRAM ? (double)metric->histogram->count : metric->value;
+        });
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_GT(values["celix_framework_events_processed_total"], 0);
+    EXPECT_EQ(0, values["celix_framework_event_processing_seconds"]);
+    EXPECT_EQ(0, values["celix_framework_event_queue_latency_seconds"]);
+}
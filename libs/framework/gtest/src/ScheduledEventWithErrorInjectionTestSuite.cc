@@ -31,7 +31,8 @@ public:
     ScheduledEventWithErrorInjectionTestSuite() {
         fw = celix::createFramework({
             {"CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "info"},
-            {CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED, "false"}
+            {CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED, "false"},
+            {CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED, "false"}
         });
     }
 
@@ -26,6 +26,7 @@
 
 #include "celix_bundle_context.h"
 
+#include "celix/ServiceDescriptor.h"
 #include "celix/ServiceRegistrationBuilder.h"
 #include "celix/UseServiceBuilder.h"
 #include "celix/TrackerBuilders.h"
@@ -179,6 +180,7 @@ namespace celix {
          * and version range.
          *
          * Uses celix::typeName<I> to defer the service name.
+         * If no filter and version range is provided, the filter of celix::ServiceDescriptor<I> is used.
          *
          * @tparam I the service type to found.
          * @param filter An optional LDAP filter.
@@ -187,7 +189,10 @@ namespace celix {
          */
         template<typename I>
         long findService(const std::string& filter = {}, const std::string& versionRange = {}) {
-            return findServiceWithName(celix::typeName<I>(), filter, versionRange);
+            if (filter.empty() && versionRange.empty()) {
+                return findServiceWithFilter(celix::ServiceDescriptor<I>::filter());
+            }
+            return findServiceWithName(celix::ServiceDescriptor<I>::name(), filter, versionRange);
         }
 
         /**
@@ -208,11 +213,26 @@ namespace celix {
             return celix_bundleContext_findServiceWithOptions(cCtx.get(), &opts);
         }
 
+        /**
+         * @brief Finds the highest ranking service matching the provided filter.
+         *
+         * The filter is used as is, so a filter - e.g. created with celix::ServiceDescriptor<I>::createFilter - can be
+         * created once and used for multiple lookups without filter string building and filter parsing.
+         *
+         * @param filter The filter to match the service properties with.
+         * @return The service id of the found service or -1 if the service was not found.
+         */
+        long findServiceWithFilter(const celix::Filter& filter) {
+            waitIfAbleForEvents();
+            return celix_bundleContext_findServiceWithFilter(cCtx.get(), filter.getCFilter());
+        }
+
         /**
          * @brief Finds all services matching the optional provided (LDAP) filter
          * and version range.
          *
          * Note uses celix::typeName<I> to defer the service name.
+         * If no filter and version range is provided, the filter of celix::ServiceDescriptor<I> is used.
          *
          * @tparam I the service type to found.
          * @param filter An optional LDAP filter.
@@ -221,7 +241,10 @@ namespace celix {
          */
         template<typename I>
         std::vector<long> findServices(const std::string& filter = {}, const std::string& versionRange = {}) {
-            return findServicesWithName(celix::typeName<I>(), filter, versionRange);
+            if (filter.empty() && versionRange.empty()) {
+                return findServicesWithFilter(celix::ServiceDescriptor<I>::filter());
+            }
+            return findServicesWithName(celix::ServiceDescriptor<I>::name(), filter, versionRange);
         }
 
         /**
@@ -240,6 +263,19 @@ namespace celix {
                     versionRange.empty() ? nullptr : versionRange.c_str());
         }
 
+        /**
+         * @brief Finds all services matching the provided filter.
+         *
+         * @see celix::BundleContext::findServiceWithFilter
+         * @param filter The filter to match the service properties with.
+         * @return A vector of service ids, ordered by service ranking.
+         */
+        std::vector<long> findServicesWithFilter(const celix::Filter& filter) {
+            waitIfAbleForEvents();
+            auto cList = celix_bundleContext_findServicesWithFilter(cCtx.get(), filter.getCFilter());
+            return toServiceIds(cList);
+        }
+
         /**
          * @brief Track services in the Celix framework using a fluent builder API.
          *
@@ -682,13 +718,22 @@ namespace celix {
             opts.filter = filter;
             opts.versionRange = versionRange;
 
-            std::vector<long> result{};
             auto cList = celix_bundleContext_findServicesWithOptions(cCtx.get(), &opts);
-            for (int i = 0; i < celix_arrayList_size(cList); ++i) {
-                long svcId = celix_arrayList_getLong(cList, i);
-                result.push_back(svcId);
+            return toServiceIds(cList);
+        }
+
+        /**
+         * @brief Converts and destroys a C array list with service ids.
+         */
+        static std::vector<long> toServiceIds(celix_array_list_t* cList) {
+            std::vector<long> result{};
+            if (cList != nullptr) {
+                result.reserve(celix_arrayList_size(cList));
+                for (int i = 0; i < celix_arrayList_size(cList); ++i) {
+                    result.push_back(celix_arrayList_getLong(cList, i));
+                }
+                celix_arrayList_destroy(cList);
             }
-            celix_arrayList_destroy(cList);
             return result;
         }
 
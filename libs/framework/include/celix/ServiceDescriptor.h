@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#pragma once
+
+#include <string>
+
+#include "celix/Utils.h"
+#include "celix/Filter.h"
+#include "celix/Constants.h"
+
+namespace celix {
+
+    /**
+     * @brief The ServiceDescriptor class provides the service name, version and service filter of a service type.
+     *
+     * The service name and filter are created once per service type, so that type-safe service lookups do not
+     * need to infer the service name, build a filter string and parse the filter on every call.
+     *
+     * The service name is inferred using celix::typeName<I> and the service version using celix::typeVersion<I>.
+     *
+     * Currently only the service lookups (celix::BundleContext::findService(s) and
+     * celix::BundleContext::findService(s)WithFilter) use service descriptors. Tracking, registering and using
+     * services still build a filter string for the C API. That filter string is parsed once per distinct filter and
+     * shared by the service registry.
+     *
+     * Example:
+     * @code{.cpp}
+     * //once
+     * static const celix::Filter filter = celix::ServiceDescriptor<IExample>::createFilter("(key=value)");
+     * //for every lookup
+     * long svcId = ctx->findServiceWithFilter(filter);
+     * @endcode
+     *
+     * @tparam I The service type.
+     * @note Thread safe.
+     */
+    template<typename I>
+    class ServiceDescriptor {
+    public:
+        ServiceDescriptor() = delete;
+
+        /**
+         * @brief The service name of the service type I.
+         */
+        static const std::string& name() {
+            static const std::string svcName = celix::typeName<I>();
+            return svcName;
+        }
+
+        /**
+         * @brief The service version of the service type I. Empty if the service type has no version.
+         */
+        static const std::string& version() {
+            static const std::string svcVersion = celix::typeVersion<I>();
+            return svcVersion;
+        }
+
+        /**
+         * @brief The filter matching all services with the service name of the service type I.
+         */
+        static const celix::Filter& filter() {
+            static const celix::Filter svcFilter{createFilter()};
+            return svcFilter;
+        }
+
+        /**
+         * @brief Creates a filter matching the services with the service name of the service type I and the
+         * optional additional filter.
+         *
+         * The returned filter is intended to be created once and used for multiple lookups.
+         *
+         * @param additionalFilter An optional additional LDAP filter, e.g. "(key=value)".
+         * @return The parsed filter.
+         * @throws celix::FilterException if the additional filter is invalid.
+         */
+        static celix::Filter createFilter(const std::string& additionalFilter = {}) {
+            std::string filterStr = std::string{"(&("} + celix::SERVICE_NAME + "=" + name() + ")" + additionalFilter + ")";
+            return celix::Filter{filterStr};
+        }
+    };
+}
@@ -28,6 +28,7 @@
 #include <unordered_map>
 #include <functional>
 #include <thread>
+#include <vector>
 
 #include "celix_utils.h"
 #include "celix_bundle_context.h"
@@ -41,6 +42,100 @@
 
 namespace celix {
 
+    namespace impl {
+        /**
+         * @brief A pool of equally sized memory blocks, used to reuse the memory of service tracker entries.
+         *
+         * The size of the blocks is determined by the first allocation. Allocations of another size and
+         * deallocations exceeding the max nr of free blocks are forwarded to the global operator new/delete.
+         *
+         * @note Thread safe.
+         */
+        class TrackerEntryPool {
+        public:
+            explicit TrackerEntryPool(std::size_t _maxFreeBlocks) : maxFreeBlocks{_maxFreeBlocks} {
+                freeBlocks.reserve(maxFreeBlocks);
+            }
+
+            ~TrackerEntryPool() noexcept {
+                for (auto* block : freeBlocks) {
+                    ::operator delete(block);
+                }
+            }
+
+            TrackerEntryPool(TrackerEntryPool&&) = delete;
+            TrackerEntryPool(const TrackerEntryPool&) = delete;
+            TrackerEntryPool& operator=(TrackerEntryPool&&) = delete;
+            TrackerEntryPool& operator=(const TrackerEntryPool&) = delete;
+
+            void* allocate(std::size_t size) {
+                {
+                    std::lock_guard<std::mutex> lck{mutex};
+                    if (blockSize == 0) {
+                        blockSize = size;
+                    }
+                    if (size == blockSize && !freeBlocks.empty()) {
+                        void* block = freeBlocks.back();
+                        freeBlocks.pop_back();
+                        return block;
+                    }
+                }
+                return ::operator new(size);
+            }
+
+            void deallocate(void* block, std::size_t size) noexcept {
+                {
+                    std::lock_guard<std::mutex> lck{mutex};
+                    if (size == blockSize && freeBlocks.size() < maxFreeBlocks) {
+                        freeBlocks.push_back(block); //note no reallocation, capacity reserved in the ctor
+                        return;
+                    }
+                }
+                ::operator delete(block);
+            }
+        private:
+            const std::size_t maxFreeBlocks;
+            std::mutex mutex{}; //protects below
+            std::size_t blockSize{0};
+            std::vector<void*> freeBlocks{};
+        };
+
+        /**
+         * @brief Allocator using a TrackerEntryPool, so that the (shared ptr control block of) service tracker
+         * entries can be reused.
+         *
+         * The allocator shares ownership of the pool, so the pool outlives all the entries allocated with it.
+         */
+        template<typename T>
+        class TrackerEntryAllocator {
+        public:
+            using value_type = T;
+
+            explicit TrackerEntryAllocator(std::shared_ptr<TrackerEntryPool> _pool) noexcept : pool{std::move(_pool)} {}
+
+            template<typename U>
+            TrackerEntryAllocator(const TrackerEntryAllocator<U>& rhs) noexcept : pool{rhs.pool} {} // NOLINT(google-explicit-constructor)
+
+            T* allocate(std::size_t n) {
+                return static_cast<T*>(pool->allocate(n * sizeof(T)));
+            }
+
+            void deallocate(T* p, std::size_t n) noexcept {
+                pool->deallocate(p, n * sizeof(T));
+            }
+
+            template<typename U>
+            bool operator==(const TrackerEntryAllocator<U>& rhs) const noexcept { return pool == rhs.pool; }
+
+            template<typename U>
+            bool operator!=(const TrackerEntryAllocator<U>& rhs) const noexcept { return pool != rhs.pool; }
+        private:
+            template<typename U>
+            friend class TrackerEntryAllocator;
+
+            std::shared_ptr<TrackerEntryPool> pool;
+        };
+    }
 
     /**
      * @brief The tracker state.
@@ -293,6 +388,12 @@ namespace celix {
      * the service tracking criteria (matches the service name, fits int the optional service
      * version range and matches with the LDAP filter).
      *
+     * The service, properties and owner of a tracked service are provided as shared ptrs aliasing a single
+     * service entry. The service entries are allocated from a per tracker pool, so that tracking services does not
+     * result in a shared ptr control block allocation per service, properties and owner.
+     * The useService(s) methods operate on a snapshot of the tracked services and do not lock the tracker while
+     * calling the provided function. The snapshot is rebuilt (copied) on every service add and remove, which makes
+     * adding and removing services O(n) in the number of tracked services, but keeps using services cheap.
      *
      * @note Thread safe.
      * \tparam I The service type to track
@@ -344,13 +445,11 @@ namespace celix {
          */
         std::shared_ptr<I> getHighestRankingService() {
             waitIfAble();
-            std::shared_ptr<I> result{};
-            std::lock_guard<std::mutex> lck{mutex};
-            auto it = entries.begin();
-            if (it != entries.end()) {
-                result = (*it)->svc;
+            auto snapshot = loadSnapshot();
+            if (snapshot->empty()) {
+                return nullptr;
             }
-            return result;
+            return serviceOf(snapshot->front());
         }
 
         /**
@@ -363,11 +462,11 @@ namespace celix {
          */
         std::vector<std::shared_ptr<I>> getServices() {
             waitIfAble();
+            auto snapshot = loadSnapshot();
             std::vector<std::shared_ptr<I>> result{};
-            std::lock_guard<std::mutex> lck{mutex};
-            result.reserve(entries.size());
-            for (auto& e : entries) {
-                result.push_back(e->svc);
+            result.reserve(snapshot->size());
+            for (const auto& e : *snapshot) {
+                result.push_back(serviceOf(e));
             }
             return result;
         }
@@ -465,19 +564,41 @@ namespace celix {
         }
     protected:
         struct SvcEntry {
-            SvcEntry(long _svcId, long _svcRanking, std::shared_ptr<I> _svc,
-                     std::shared_ptr<const celix::Properties> _properties,
-                     std::shared_ptr<const celix::Bundle> _owner) : svcId(_svcId), svcRanking(_svcRanking),
-                                                                          svc(std::move(_svc)),
-                                                                          properties(std::move(_properties)),
-                                                                          owner(std::move(_owner)) {}
-            long svcId;
-            long svcRanking;
-            std::shared_ptr<I> svc;
-            std::shared_ptr<const celix::Properties> properties;
-            std::shared_ptr<const celix::Bundle> owner;
+            SvcEntry(long _svcId, long _svcRanking, I* _svc, const celix_properties_t* cProps, const celix_bundle_t* cBnd) :
+                    svcId(_svcId), svcRanking(_svcRanking), svc(_svc),
+                    properties(celix::Properties::wrap(cProps)),
+                    owner(const_cast<celix_bundle_t*>(cBnd)) {}
+            SvcEntry(SvcEntry&&) = delete;
+            SvcEntry(const SvcEntry&) = delete;
+            SvcEntry& operator=(SvcEntry&&) = delete;
+            SvcEntry& operator=(const SvcEntry&) = delete;
+
+            const long svcId;
+            const long svcRanking;
+            I* const svc;
+            const celix::Properties properties;
+            const celix::Bundle owner;
         };
 
+        using SvcEntries = std::vector<std::shared_ptr<SvcEntry>>;
+
+        /**
+         * @brief The max nr of free service entry blocks kept in the service entry pool of a tracker.
+         */
+        static constexpr std::size_t MAX_FREE_SVC_ENTRIES = 64;
+
+        static std::shared_ptr<I> serviceOf(const std::shared_ptr<SvcEntry>& entry) {
+            return std::shared_ptr<I>{entry, entry->svc};
+        }
+
+        static std::shared_ptr<const celix::Properties> propertiesOf(const std::shared_ptr<SvcEntry>& entry) {
+            return std::shared_ptr<const celix::Properties>{entry, &entry->properties};
+        }
+
+        static std::shared_ptr<const celix::Bundle> ownerOf(const std::shared_ptr<SvcEntry>& entry) {
+            return std::shared_ptr<const celix::Bundle>{entry, &entry->owner};
+        }
+
 
         ServiceTracker(std::shared_ptr<celix_bundle_context_t> _cCtx, std::string _svcName,
                        std::string _svcVersionRange, celix::Filter _filter,
@@ -491,26 +612,42 @@ namespace celix {
             setupServiceTrackerOptions();
         }
 
-        static std::shared_ptr<SvcEntry> createEntry(void* voidSvc, const celix_properties_t* cProps, const celix_bundle_t* cBnd) {
+        std::shared_ptr<SvcEntry> createEntry(void* voidSvc, const celix_properties_t* cProps, const celix_bundle_t* cBnd) {
             long svcId = celix_properties_getAsLong(cProps, CELIX_FRAMEWORK_SERVICE_ID, -1L);
             long svcRanking = celix_properties_getAsLong(cProps, CELIX_FRAMEWORK_SERVICE_RANKING, 0);
-            auto svc = std::shared_ptr<I>{static_cast<I*>(voidSvc), [](I*){/*nop*/}};
-            auto props = std::make_shared<const celix::Properties>(celix::Properties::wrap(cProps));
-            auto owner = std::make_shared<celix::Bundle>(const_cast<celix_bundle_t*>(cBnd));
-            return std::make_shared<SvcEntry>(svcId, svcRanking, svc, props, owner);
+            return std::allocate_shared<SvcEntry>(celix::impl::TrackerEntryAllocator<SvcEntry>{entryPool}, svcId, svcRanking, static_cast<I*>(voidSvc), cProps, cBnd);
         }
 
+        /**
+         * @brief Waits until the service, properties and owner of the entry are no longer in use.
+         *
+         * The entry must already be removed from the tracked entries and the snapshot.
+         */
         void waitForExpiredSvcEntry(std::shared_ptr<SvcEntry>& entry) {
             if (entry) {
-                std::weak_ptr<void> svcObserve = entry->svc;
-                std::weak_ptr<const celix::Properties> propsObserve = entry->properties;
-                std::weak_ptr<const celix::Bundle> ownerObserve = entry->owner;
-                entry->svc = nullptr;
-                entry->properties = nullptr;
-                entry->owner = nullptr;
-                waitForExpired(svcObserve, entry->svcId, "service");
-                waitForExpired(propsObserve, entry->svcId, "service properties");
-                waitForExpired(ownerObserve, entry->svcId, "service bundle (owner)");
+                long svcId = entry->svcId;
+                std::weak_ptr<SvcEntry> observe = entry;
+                entry = nullptr;
+                waitForExpired(observe, svcId, "service, service properties or service bundle (owner)");
+            }
+        }
+
+        std::shared_ptr<const SvcEntries> loadSnapshot() const {
+            std::lock_guard<std::mutex> lck{snapshotMutex};
+            return snapshot;
+        }
+
+        /**
+         * @brief Replaces the snapshot with a copy of the current tracked entries. Must be called with the mutex locked.
+         *
+         * The copy is made before the snapshot mutex is taken, so readers are only blocked for the pointer swap.
+         * The previous snapshot is released after the snapshot mutex is unlocked.
+         */
+        void updateSnapshot() {
+            std::shared_ptr<const SvcEntries> updated = std::make_shared<const SvcEntries>(entries.begin(), entries.end());
+            {
+                std::lock_guard<std::mutex> lck{snapshotMutex};
+                snapshot.swap(updated);
             }
         }
 
@@ -530,39 +667,33 @@ namespace celix {
 
         void invokeUpdateCallbacks() {
             if (!updateCallbacks.empty()) {
+                auto snapshot = loadSnapshot();
                 std::vector<std::shared_ptr<I>> updateVector{};
-                {
-                    std::lock_guard<std::mutex> lck{mutex};
-                    updateVector.reserve(entries.size());
-                    for (const auto &entry :  entries) {
-                        updateVector.push_back(entry->svc);
-                    }
+                updateVector.reserve(snapshot->size());
+                for (const auto& entry : *snapshot) {
+                    updateVector.push_back(serviceOf(entry));
                 }
                 for (const auto& cb : updateCallbacks) {
                     cb(updateVector);
                 }
             }
             if (!updateWithPropertiesCallbacks.empty()) {
+                auto snapshot = loadSnapshot();
                 std::vector<std::pair<std::shared_ptr<I>, std::shared_ptr<const celix::Properties>>> updateVector{};
-                updateVector.reserve(entries.size());
-                {
-                    std::lock_guard<std::mutex> lck{mutex};
-                    for (const auto &entry :  entries) {
-                        updateVector.emplace_back(entry->svc, entry->properties);
-                    }
+                updateVector.reserve(snapshot->size());
+                for (const auto& entry : *snapshot) {
+                    updateVector.emplace_back(serviceOf(entry), propertiesOf(entry));
                 }
                 for (const auto& cb : updateWithPropertiesCallbacks) {
                     cb(updateVector);
                 }
             }
             if (!updateWithOwnerCallbacks.empty()) {
+                auto snapshot = loadSnapshot();
                 std::vector<std::tuple<std::shared_ptr<I>, std::shared_ptr<const celix::Properties>, std::shared_ptr<const celix::Bundle>>> updateVector{};
-                updateVector.reserve(entries.size());
-                {
-                    std::lock_guard<std::mutex> lck{mutex};
-                    for (const auto &entry :  entries) {
-                        updateVector.emplace_back(entry->svc, entry->properties, entry->owner);
-                    }
+                updateVector.reserve(snapshot->size());
+                for (const auto& entry : *snapshot) {
+                    updateVector.emplace_back(serviceOf(entry), propertiesOf(entry), ownerOf(entry));
                 }
                 for (const auto& cb : updateWithOwnerCallbacks) {
                     cb(updateVector);
@@ -588,11 +719,18 @@ namespace celix {
             }
         };
 
+        const std::shared_ptr<celix::impl::TrackerEntryPool> entryPool{std::make_shared<celix::impl::TrackerEntryPool>(std::size_t{MAX_FREE_SVC_ENTRIES})};
+
         mutable std::mutex mutex{}; //protect below
         std::set<std::shared_ptr<SvcEntry>, SvcEntryCompare> entries{};
         std::unordered_map<long, std::shared_ptr<SvcEntry>> cachedEntries{};
         std::shared_ptr<SvcEntry> highestRankingServiceEntry{};
 
+        //copy of the entries, ordered by service ranking. Updated with the mutex locked.
+        //Note a separate mutex, so that the snapshot can be read from within set callbacks (called with mutex locked).
+        mutable std::mutex snapshotMutex{};
+        std::shared_ptr<const SvcEntries> snapshot{std::make_shared<const SvcEntries>()}; //protected by snapshotMutex
+
     private:
         void setupServiceTrackerOptions() {
             opts.filter.serviceName = svcName.empty() ? nullptr : svcName.c_str();
@@ -601,15 +739,21 @@ namespace celix {
             opts.callbackHandle = this;
             opts.addWithOwner = [](void *handle, void *voidSvc, const celix_properties_t* cProps, const celix_bundle_t* cBnd) {
                 auto tracker = static_cast<ServiceTracker<I>*>(handle);
-                auto entry = createEntry(voidSvc, cProps, cBnd);
+                auto entry = tracker->createEntry(voidSvc, cProps, cBnd);
                 {
                     std::lock_guard<std::mutex> lck{tracker->mutex};
                     tracker->entries.insert(entry);
                     tracker->cachedEntries[entry->svcId] = entry;
+                    tracker->updateSnapshot();
                 }
                 tracker->svcCount.fetch_add(1, std::memory_order_relaxed);
-                for (const auto& cb : tracker->addCallbacks) {
-                    cb(entry->svc, entry->properties, entry->owner);
+                if (!tracker->addCallbacks.empty()) {
+                    auto svc = serviceOf(entry);
+                    auto props = propertiesOf(entry);
+                    auto owner = ownerOf(entry);
+                    for (const auto& cb : tracker->addCallbacks) {
+                        cb(svc, props, owner);
+                    }
                 }
                 tracker->invokeUpdateCallbacks();
             };
@@ -624,9 +768,15 @@ namespace celix {
                     entry = it->second;
                     tracker->cachedEntries.erase(it);
                     tracker->entries.erase(entry);
+                    tracker->updateSnapshot();
                 }
-                for (const auto& cb : tracker->remCallbacks) {
-                    cb(entry->svc, entry->properties, entry->owner);
+                if (!tracker->remCallbacks.empty()) {
+                    auto svc = serviceOf(entry);
+                    auto props = propertiesOf(entry);
+                    auto owner = ownerOf(entry);
+                    for (const auto& cb : tracker->remCallbacks) {
+                        cb(svc, props, owner);
+                    }
                 }
                 tracker->invokeUpdateCallbacks();
                 tracker->svcCount.fetch_sub(1, std::memory_order_relaxed);
@@ -637,16 +787,17 @@ namespace celix {
                 std::unique_lock<std::mutex> lck{tracker->mutex};
                 auto prevEntry = tracker->highestRankingServiceEntry;
                 if (voidSvc) {
-                    tracker->highestRankingServiceEntry = createEntry(voidSvc, cProps, cBnd);
+                    tracker->highestRankingServiceEntry = tracker->createEntry(voidSvc, cProps, cBnd);
                 } else {
                     tracker->highestRankingServiceEntry = nullptr;
                 }
-                for (const auto& cb : tracker->setCallbacks) {
-                    if (tracker->highestRankingServiceEntry) {
-                        auto& e = tracker->highestRankingServiceEntry;
-                        cb(e->svc, e->properties, e->owner);
-                    } else /*"unset"*/ {
-                        cb(nullptr, nullptr, nullptr);
+                if (!tracker->setCallbacks.empty()) {
+                    auto& e = tracker->highestRankingServiceEntry;
+                    auto svc = e ? serviceOf(e) : nullptr;
+                    auto props = e ? propertiesOf(e) : nullptr;
+                    auto owner = e ? ownerOf(e) : nullptr;
+                    for (const auto& cb : tracker->setCallbacks) {
+                        cb(svc, props, owner); //note nullptr for "unset"
                     }
                 }
                 lck.unlock();
@@ -656,26 +807,24 @@ namespace celix {
 
         template<typename F>
         size_t useServicesInternal(const F& f) {
-            size_t count = 0;
-            std::lock_guard<std::mutex> lck{mutex};
-            for (auto& e : entries) {
-                I& svc = *e->svc;
-                const celix::Properties& props = *e->properties;
-                const celix::Bundle& owner = *e->owner;
-                f(svc, props, owner);
-                count++;
+            //note the snapshot keeps the entries alive, so no lock is needed while calling f
+            auto snapshot = loadSnapshot();
+            for (const auto& e : *snapshot) {
+                f(*e->svc, e->properties, e->owner);
             }
-            return count;
+            return snapshot->size();
         }
 
         template<typename F>
         bool useServiceInternal(const F& f) {
-            std::lock_guard<std::mutex> lck{mutex};
-            if (highestRankingServiceEntry) {
-                I& svc = *highestRankingServiceEntry->svc;
-                const celix::Properties& props = *highestRankingServiceEntry->properties;
-                const celix::Bundle& owner = *highestRankingServiceEntry->owner;
-                f(svc, props, owner);
+            std::shared_ptr<SvcEntry> entry{};
+            {
+                std::lock_guard<std::mutex> lck{mutex};
+                entry = highestRankingServiceEntry;
+            }
+            //note the set callback waits until the entry is no longer in use, so no lock is needed while calling f
+            if (entry) {
+                f(*entry->svc, entry->properties, entry->owner);
                 return true;
             }
             return false;
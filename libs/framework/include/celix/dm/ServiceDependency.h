@@ -44,6 +44,14 @@ namespace celix { namespace dm {
         locking
     };
 
+    /**
+     * @brief When a service dependency tracks services. See celix_dmServiceDependency_setTrackingMode.
+     */
+    enum class DependencyTrackingMode {
+        eager,
+        lazy
+    };
+
     class BaseServiceDependency {
     private:
         const std::chrono::milliseconds warningTimoutForNonExpiredSvcObject{5000};
@@ -60,6 +68,14 @@ namespace celix { namespace dm {
             }
         }
 
+        void setDepTrackingMode(DependencyTrackingMode mode) {
+            if (mode == DependencyTrackingMode::lazy) {
+                celix_dmServiceDependency_setTrackingMode(this->cServiceDependency(), CELIX_DM_SERVICE_DEPENDENCY_TRACKING_LAZY);
+            } else { /*eager*/
+                celix_dmServiceDependency_setTrackingMode(this->cServiceDependency(), CELIX_DM_SERVICE_DEPENDENCY_TRACKING_EAGER);
+            }
+        }
+
         template<typename U>
         void waitForExpired(std::weak_ptr<U> observe, long svcId, const char* observeType);
     public:
@@ -172,6 +188,14 @@ namespace celix { namespace dm {
          */
         CServiceDependency<T,I>& setStrategy(DependencyUpdateStrategy strategy);
 
+        /**
+         * Specify the tracking mode to use. Default is eager.
+         * With lazy tracking, an optional dependency is only tracked while the component is started.
+         *
+         * @return the C service dependency reference for chaining (fluent API)
+         */
+        CServiceDependency<T,I>& setTrackingMode(DependencyTrackingMode mode);
+
         /**
          * Set the set callback for when the service dependency becomes available
          *
@@ -416,6 +440,14 @@ namespace celix { namespace dm {
          */
         ServiceDependency<T,I>& setStrategy(DependencyUpdateStrategy strategy);
 
+        /**
+         * Specify the tracking mode to use. Default is eager.
+         * With lazy tracking, an optional dependency is only tracked while the component is started.
+         *
+         * @return the service dependency reference for chaining (fluent API)
+         */
+        ServiceDependency<T,I>& setTrackingMode(DependencyTrackingMode mode);
+
         /**
          * "Build" the service dependency.
          * When build the service dependency is active and the service tracker is created.
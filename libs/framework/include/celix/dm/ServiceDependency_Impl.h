@@ -124,6 +124,12 @@ CServiceDependency<T,I>& CServiceDependency<T,I>::setStrategy(DependencyUpdateSt
     return *this;
 }
 
+template<class T, typename I>
+CServiceDependency<T,I>& CServiceDependency<T,I>::setTrackingMode(DependencyTrackingMode mode) {
+    this->setDepTrackingMode(mode);
+    return *this;
+}
+
 //set callbacks
 template<class T, typename I>
 CServiceDependency<T,I>& CServiceDependency<T,I>::setCallbacks(void (T::*set)(const I* service)) {
@@ -474,6 +480,12 @@ ServiceDependency<T,I>& ServiceDependency<T,I>::setStrategy(DependencyUpdateStra
     return *this;
 }
 
+template<class T, class I>
+ServiceDependency<T,I>& ServiceDependency<T,I>::setTrackingMode(DependencyTrackingMode mode) {
+    this->setDepTrackingMode(mode);
+    return *this;
+}
+
 template<class T, class I>
 int ServiceDependency<T,I>::invokeCallback(std::function<void(I*, Properties&&)> fp, const celix_properties_t *props, const void* service) {
     I *svc = (I*)service;
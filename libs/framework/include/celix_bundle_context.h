@@ -389,6 +389,31 @@ CELIX_FRAMEWORK_EXPORT long celix_bundleContext_findServiceWithOptions(celix_bun
 CELIX_FRAMEWORK_EXPORT celix_array_list_t*
 celix_bundleContext_findServicesWithOptions(celix_bundle_context_t* ctx, const celix_service_filter_options_t* opts);
 
+/**
+ * @brief Finds the highest ranking service matching the provided filter and returns the service id.
+ *
+ * In contrast with celix_bundleContext_findServiceWithOptions, the filter is not created from a service name,
+ * version range and filter string and is not parsed. This makes it possible to create a filter once -
+ * e.g. "(&(objectClass=example_service)(key=value))" - and use it for every lookup.
+ *
+ * @param ctx The bundle context
+ * @param filter The filter to match the service properties with.
+ * @return If found a valid service id (>= 0) if not found -1.
+ */
+CELIX_FRAMEWORK_EXPORT long celix_bundleContext_findServiceWithFilter(celix_bundle_context_t* ctx,
+                                                                      const celix_filter_t* filter);
+
+/**
+ * @brief Finds the services matching the provided filter and returns a list of the found service ids.
+ *
+ * @see celix_bundleContext_findServiceWithFilter
+ * @param ctx The bundle context
+ * @param filter The filter to match the service properties with.
+ * @return A array list with as value a long int, ordered by service ranking, or NULL if the filter is NULL.
+ */
+CELIX_FRAMEWORK_EXPORT celix_array_list_t*
+celix_bundleContext_findServicesWithFilter(celix_bundle_context_t* ctx, const celix_filter_t* filter);
+
 /**
  * @brief Use the service with the provided service id using the provided callback. The Celix framework will ensure that
  * the targeted service cannot be removed during the callback.
@@ -1594,6 +1619,40 @@ CELIX_FRAMEWORK_EXPORT bool celix_bundleContext_removeScheduledEventAsync(celix_
 CELIX_FRAMEWORK_EXPORT bool celix_bundleContext_tryRemoveScheduledEventAsync(celix_bundle_context_t* ctx,
                                                                         long scheduledEventId);
 
+/**
+ * @brief Add an idle callback which is called on the Celix event thread when the Celix event queue becomes empty.
+ *
+ * The idle callback is called every time the Celix event thread has processed events and the event queue is empty,
+ * and once after the idle callback is added. This can be used to react on a settled framework (e.g. all pending
+ * service registrations and bundle events are processed) without periodically polling the event queue.
+ *
+ * The idle callback is called on the Celix event thread and should not block.
+ * Idle callbacks which are not removed by the bundle are removed when the bundle is stopped.
+ *
+ * @param[in] ctx The bundle context.
+ * @param[in] callbackData The data passed to the idle callback.
+ * @param[in] idleCallback The idle callback.
+ * @return The idle callback id or < 0 if the idle callback could not be added.
+ */
+CELIX_FRAMEWORK_EXPORT long celix_bundleContext_addEventQueueIdleCallback(celix_bundle_context_t* ctx,
+                                                                          void* callbackData,
+                                                                          void (*idleCallback)(void* callbackData));
+
+/**
+ * @brief Remove an idle callback.
+ *
+ * Silently ignored if the idle callback id < 0.
+ *
+ * Can be called from the idle callback itself. If called outside the Celix event thread, this function will wait
+ * until the idle callback is not in use anymore.
+ *
+ * @param[in] ctx The bundle context.
+ * @param[in] idleCallbackId The idle callback id to remove.
+ * @return true if the idle callback is removed, false if the idle callback id is not known.
+ */
+CELIX_FRAMEWORK_EXPORT bool celix_bundleContext_removeEventQueueIdleCallback(celix_bundle_context_t* ctx,
+                                                                             long idleCallbackId);
+
 /**
  * @brief Returns the bundle for this bundle context.
  */
@@ -300,6 +300,15 @@ extern "C" {
  */
 #define CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED "CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED"
 
+/**
+ * @brief Celix framework environment property (named "CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED") to configure
+ * whether the framework registers a celix_metrics_provider service for its runtime statistics.
+ * If disabled, the framework also does not record the event queue latency and event processing time.
+ * Default is true.
+ * Should be a boolean value.
+ */
+#define CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED "CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED"
+
 
 #ifdef __cplusplus
 }
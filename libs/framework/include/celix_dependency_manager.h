@@ -116,6 +116,14 @@ CELIX_FRAMEWORK_EXPORT bool celix_dependencyManager_areComponentsActive(celix_de
  */
 CELIX_FRAMEWORK_EXPORT bool celix_dependencyManager_allComponentsActive(celix_dependency_manager_t *manager);
 
+/**
+ * @brief Return the nr of enabled components - for all bundles - which are not active.
+ *
+ * In contrast with celix_dependencyManager_allComponentsActive, this does not iterate over the bundles and
+ * components, but returns a framework wide count which is updated on every component state change.
+ */
+CELIX_FRAMEWORK_EXPORT size_t celix_dependencyManager_nrOfInactiveComponentsOfAllBundles(celix_dependency_manager_t *manager);
+
 /**
  * @brief Return the nr of components for this dependency manager
  */
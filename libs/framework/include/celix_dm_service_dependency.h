@@ -37,6 +37,11 @@ typedef enum celix_dm_service_dependency_strategy_enum {
 	DM_SERVICE_DEPENDENCY_STRATEGY_SUSPEND
 } celix_dm_service_dependency_strategy_t;
 
+typedef enum celix_dm_service_dependency_tracking_mode_enum {
+    CELIX_DM_SERVICE_DEPENDENCY_TRACKING_EAGER,
+    CELIX_DM_SERVICE_DEPENDENCY_TRACKING_LAZY
+} celix_dm_service_dependency_tracking_mode_t;
+
 typedef int (*celix_dm_service_update_fp)(void *handle, void* service);
 typedef int (*celix_dm_service_swap_fp)(void *handle, void* oldService, void* newService);
 
@@ -109,6 +114,29 @@ CELIX_FRAMEWORK_EXPORT celix_status_t celix_dmServiceDependency_setStrategy(celi
  */
 CELIX_FRAMEWORK_EXPORT celix_dm_service_dependency_strategy_t celix_dmServiceDependency_getStrategy(celix_dm_service_dependency_t *dependency);
 
+/**
+ * Specify when the service dependency tracks services.
+ *
+ * With CELIX_DM_SERVICE_DEPENDENCY_TRACKING_EAGER (default) the service tracker is opened as soon as the component
+ * is enabled.
+ *
+ * With CELIX_DM_SERVICE_DEPENDENCY_TRACKING_LAZY the service tracker of an optional service dependency is only
+ * opened when the component is started (i.e. all required service dependencies are resolved) and is closed again
+ * when the component is stopped. The tracker is opened as part of the start transition, so the services already
+ * available are injected before the start callback in a single component update, instead of every matching service
+ * re-evaluating the component state. Optional services registered or unregistered while the component is not
+ * started do not trigger any component callbacks.
+ *
+ * Required service dependencies are always tracked eagerly, because they are needed to resolve the component.
+ * The tracking mode should be set before the service dependency is added to a component.
+ */
+CELIX_FRAMEWORK_EXPORT celix_status_t celix_dmServiceDependency_setTrackingMode(celix_dm_service_dependency_t *dependency, celix_dm_service_dependency_tracking_mode_t mode);
+
+/**
+ * Return the service dependency tracking mode.
+ */
+CELIX_FRAMEWORK_EXPORT celix_dm_service_dependency_tracking_mode_t celix_dmServiceDependency_getTrackingMode(const celix_dm_service_dependency_t *dependency);
+
 /**
  * Set the service name, version range and filter.
  *
@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_METRICS_PROVIDER_H_
+#define CELIX_METRICS_PROVIDER_H_
+
+#include "celix_errno.h"
+#include "celix_metrics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @brief The name of the metrics provider service.
+ */
+#define CELIX_METRICS_PROVIDER_SERVICE_NAME "celix_metrics_provider"
+
+/*!
+ * @brief The version of the metrics provider service.
+ */
+#define CELIX_METRICS_PROVIDER_SERVICE_VERSION "1.0.0"
+
+/*!
+ * @brief The (optional) property key used to specify the name of the metrics provider, e.g. "framework".
+ */
+#define CELIX_METRICS_PROVIDER_NAME "metrics.provider.name"
+
+/**
+ * @brief Callback called for every collected metric.
+ *
+ * The metric - including its name, help, labels and histogram - is only valid during the callback.
+ */
+typedef void (*celix_metrics_callback_fp)(void* callbackHandle, const celix_metric_t* metric);
+
+/**
+ * @brief Celix metrics provider service struct.
+ *
+ * A metrics provider exposes the runtime statistics of a component, e.g. the framework event dispatcher or the
+ * event admin. The metrics themselves should be cheap to update (see celix_metrics.h); they are only read when a
+ * consumer - e.g. the `celix::stats` shell command - collects them.
+ *
+ * The framework registers a metrics provider (with metrics.provider.name=framework) for its event dispatcher,
+ * service registry and service trackers.
+ */
+typedef struct celix_metrics_provider {
+    void* handle;
+
+    /**
+     * @brief Collect the current metrics by calling the callback for every metric.
+     *
+     * Metrics with the same name (i.e. the same metric family with different labels) must be provided consecutively.
+     */
+    celix_status_t (*collectMetrics)(void* handle, void* callbackHandle, celix_metrics_callback_fp callback);
+} celix_metrics_provider_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_METRICS_PROVIDER_H_ */
@@ -27,6 +27,7 @@
 #include "celix_array_list.h"
 #include "service_registration.h"
 #include "celix_service_factory.h"
+#include "celix_metrics_provider.h"
 #include "celix_framework_export.h"
 
 
@@ -154,6 +155,41 @@ CELIX_FRAMEWORK_EXPORT char* celix_serviceRegistry_createFilterFor(
  */
 CELIX_FRAMEWORK_EXPORT celix_array_list_t* celix_serviceRegistry_findServices(celix_service_registry_t* registry, const char* filterStr);
 
+/**
+ * Find services matching an already parsed filter and return a array list of service ids (long), ordered by
+ * service ranking.
+ * The filter is not copied or interned, so finding services with a filter that is created once does not result in
+ * filter string building or filter parsing.
+ * If a shared filter with the same filter string exists (see celix_serviceRegistry_acquireFilter), the shared filter
+ * and its memoized match result are used.
+ * Caller is responsible for freeing the returned array list.
+ */
+CELIX_FRAMEWORK_EXPORT celix_array_list_t* celix_serviceRegistry_findServicesWithFilter(celix_service_registry_t* registry, const celix_filter_t* filter);
+
+/**
+ * Acquire a shared (interned) filter for the provided filter string.
+ *
+ * Identical filter strings (ignoring leading and trailing whitespaces) share a single parsed and compiled filter.
+ * A NULL or empty filter string results in a match-all filter.
+ * The returned filter must be released with celix_serviceRegistry_releaseFilter and must not be destroyed.
+ *
+ * @return The shared filter or NULL if the filter string is invalid.
+ */
+CELIX_FRAMEWORK_EXPORT const celix_filter_t* celix_serviceRegistry_acquireFilter(celix_service_registry_t* registry, const char* filterStr);
+
+/**
+ * Release a shared filter acquired with celix_serviceRegistry_acquireFilter.
+ * The filter is destroyed when it is released by all users.
+ */
+CELIX_FRAMEWORK_EXPORT void celix_serviceRegistry_releaseFilter(celix_service_registry_t* registry, const celix_filter_t* filter);
+
+/**
+ * Collect the service registry metrics: the nr of registered services and service listeners and the total nr of
+ * service (un)registrations.
+ * The metrics are read from atomic counters, so the service registry lock is not taken.
+ */
+CELIX_FRAMEWORK_EXPORT void celix_serviceRegistry_collectMetrics(celix_service_registry_t* registry, void* callbackHandle, celix_metrics_callback_fp callback);
+
 
 #ifdef __cplusplus
 }
@@ -52,6 +52,7 @@ struct bundleArchive {
     char* savedBundleStatePropertiesPath;
     char* storeRoot;
     char* resourceCacheRoot;
+    char* resourceCacheIndexPath;
     char* bundleSymbolicName; // read from the manifest
     char* bundleVersion;      // read from the manifest
     bundle_revision_t* revision; // the current revision
@@ -127,6 +128,15 @@ static celix_status_t celix_bundleArchive_removeResourceCache(bundle_archive_t*
     return status;
 }
 
+/**
+ * Returns whether the resource cache is a directory extracted from a bundle zip, with an index of the extracted files.
+ */
+static bool celix_bundleArchive_isResourceCacheIndexed(bundle_archive_t* archive) {
+    struct stat st;
+    return celix_utils_fileExists(archive->resourceCacheIndexPath) &&
+           lstat(archive->resourceCacheRoot, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
 static celix_status_t
 celix_bundleArchive_extractBundle(bundle_archive_t* archive, const char* bundleUrl) {
     celix_status_t status = CELIX_SUCCESS;
@@ -151,16 +161,21 @@ celix_bundleArchive_extractBundle(bundle_archive_t* archive, const char* bundleU
     }
 
     /*
-     * Note always remove the current revision dir. This is needed to remove files that are not present
-     * in the new bundle zip, but it seems this is also needed to ensure that the lib files get a new inode.
-     * If dlopen/dlsym is used with newer files, but with the same inode already used in dlopen/dlsym this leads to
-     * segfaults.
+     * Note if the resource cache is not (yet) indexed, remove the current revision dir. This is needed to remove files
+     * that are not present in the new bundle zip.
+     * An indexed resource cache is updated incrementally: unchanged files are kept and changed files are replaced by
+     * new files. Replacing a file is needed to ensure that the lib files get a new inode. If dlopen/dlsym is used with
+     * newer files, but with the same inode already used in dlopen/dlsym this leads to segfaults.
      */
-    status = celix_bundleArchive_removeResourceCache(archive);
-    if (status != CELIX_SUCCESS) {
-        return status;
+    if (!celix_bundleArchive_isResourceCacheIndexed(archive)) {
+        status = celix_bundleArchive_removeResourceCache(archive);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
     }
-    status = celix_framework_utils_extractBundle(archive->fw, bundleUrl, archive->resourceCacheRoot);
+    status = celix_framework_utils_extractBundleIncrementally(archive->fw, bundleUrl, archive->resourceCacheRoot,
+                                                              celix_bundleCache_getContentStoreDir(archive->fw->cache),
+                                                              archive->resourceCacheIndexPath);
     if (status != CELIX_SUCCESS) {
         fw_log(archive->fw->logger, CELIX_LOG_LEVEL_ERROR, "Failed to initialize archive. Failed to extract bundle zip to revision directory.");
         return status;
@@ -274,6 +289,10 @@ celix_status_t celix_bundleArchive_create(celix_framework_t* fw, const char *arc
             if (asprintf(&archive->resourceCacheRoot, "%s/%s", archive->archiveRoot, CELIX_BUNDLE_ARCHIVE_RESOURCE_CACHE_NAME) < 0) {
                 break;
             }
+            if (asprintf(&archive->resourceCacheIndexPath, "%s/%s", archive->archiveRoot,
+                         CELIX_BUNDLE_ARCHIVE_RESOURCE_CACHE_INDEX_FILE_NAME) < 0) {
+                break;
+            }
             status = CELIX_SUCCESS;
         } while (0);
     }
@@ -330,6 +349,7 @@ void bundleArchive_destroy(bundle_archive_pt archive) {
         free(archive->savedBundleStatePropertiesPath);
         free(archive->archiveRoot);
         free(archive->resourceCacheRoot);
+        free(archive->resourceCacheIndexPath);
         free(archive->storeRoot);
         free(archive->bundleSymbolicName);
         free(archive->bundleVersion);
@@ -492,5 +512,6 @@ void celix_bundleArchive_removeInvalidDirs(bundle_archive_pt archive) {
         framework_logIfError(archive->fw->logger, status, NULL, "Failed to remove invalid archive root '%s': %s", archive->archiveRoot, err);
     } else if (!archive->cacheValid){
         (void)celix_bundleArchive_removeResourceCache(archive);
+        (void)unlink(archive->resourceCacheIndexPath);
     }
 }
@@ -37,6 +37,7 @@ extern "C" {
 #define CELIX_BUNDLE_ARCHIVE_LOCATION_PROPERTY_NAME "bundle.location"
 
 #define CELIX_BUNDLE_ARCHIVE_RESOURCE_CACHE_NAME "resources"
+#define CELIX_BUNDLE_ARCHIVE_RESOURCE_CACHE_INDEX_FILE_NAME "resources.index"
 #define CELIX_BUNDLE_ARCHIVE_STORE_DIRECTORY_NAME "storage"
 
 #define CELIX_BUNDLE_MANIFEST_REL_PATH "META-INF/MANIFEST.MF"
@@ -46,6 +47,8 @@ extern "C" {
  * Create a bundle archive for the given root, id, location and revision nr.
  * Also create the bundle cache dir and if will reuse a existing bundle resource cache dir if the provided
  * bundle zip location is older then the existing bundle resource cache dir.
+ * If the bundle zip location is newer, only the changed files of the existing bundle resource cache dir are updated
+ * and the files are shared with other bundle archives through the content store of the bundle cache.
  */
 celix_status_t celix_bundleArchive_create(celix_framework_t* fw, const char *archiveRoot, long id, const char *location, bundle_archive_pt *bundle_archive);
 
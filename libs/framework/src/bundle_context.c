@@ -120,6 +120,7 @@ void celix_bundleContext_cleanup(celix_bundle_context_t* ctx) {
                celix_bundle_getId(ctx->bundle));
 
         celix_framework_cleanupScheduledEvents(ctx->framework, celix_bundle_getId(ctx->bundle));
+        celix_framework_cleanupEventQueueIdleCallbacks(ctx->framework, celix_bundle_getId(ctx->bundle));
         // NOTE not perfect, because stopping of registrations/tracker when the activator is destroyed can lead to
         // segfault. but at least we can try to warn the bundle implementer that some cleanup is missing.
         bundleContext_cleanupBundleTrackers(ctx);
@@ -1541,6 +1542,19 @@ long celix_bundleContext_findServiceWithOptions(celix_bundle_context_t *ctx, con
 }
 
 
+long celix_bundleContext_findServiceWithFilter(celix_bundle_context_t *ctx, const celix_filter_t* filter) {
+    long result = -1L;
+    celix_autoptr(celix_array_list_t) svcIds = celix_serviceRegistry_findServicesWithFilter(ctx->framework->registry, filter);
+    if (svcIds != NULL && celix_arrayList_size(svcIds) > 0) {
+        result = celix_arrayList_getLong(svcIds, 0);
+    }
+    return result;
+}
+
+celix_array_list_t* celix_bundleContext_findServicesWithFilter(celix_bundle_context_t *ctx, const celix_filter_t* filter) {
+    return celix_serviceRegistry_findServicesWithFilter(ctx->framework->registry, filter);
+}
+
 celix_array_list_t* celix_bundleContext_findServices(celix_bundle_context_t *ctx, const char *serviceName) {
     celix_service_filter_options_t opts = CELIX_EMPTY_SERVICE_FILTER_OPTIONS;
     opts.serviceName = serviceName;
@@ -1703,6 +1717,17 @@ bool celix_bundleContext_tryRemoveScheduledEventAsync(celix_bundle_context_t* ct
     return celix_framework_removeScheduledEvent(ctx->framework, true, false, scheduledEventId);
 }
 
+long celix_bundleContext_addEventQueueIdleCallback(celix_bundle_context_t* ctx,
+                                                   void* callbackData,
+                                                   void (*idleCallback)(void* callbackData)) {
+    return celix_framework_addEventQueueIdleCallback(
+        ctx->framework, celix_bundle_getId(ctx->bundle), callbackData, idleCallback);
+}
+
+bool celix_bundleContext_removeEventQueueIdleCallback(celix_bundle_context_t* ctx, long idleCallbackId) {
+    return celix_framework_removeEventQueueIdleCallback(ctx->framework, idleCallbackId);
+}
+
 celix_bundle_t* celix_bundleContext_getBundle(const celix_bundle_context_t *ctx) {
     celix_bundle_t *bnd = NULL;
     if (ctx != NULL) {
@@ -42,12 +42,15 @@
 
 #define CELIX_BUNDLE_ARCHIVE_ROOT_FORMAT "%s/bundle%li"
 
+#define CELIX_BUNDLE_CACHE_CONTENT_STORE_DIR_NAME "content"
+
 #define FW_LOG(level, ...) \
     celix_framework_log(cache->fw->logger, (level), __FUNCTION__ , __FILE__, __LINE__, __VA_ARGS__)
 
 struct celix_bundle_cache {
     celix_framework_t* fw;
     char* cacheDir;
+    char* contentStoreDir; // shared files of extracted bundle zips, see celix_utils_extractZipFileIncrementally
     bool deleteOnDestroy;
     bool deleteOnCreate;
 
@@ -123,6 +126,10 @@ celix_status_t celix_bundleCache_create(celix_framework_t* fw, celix_bundle_cach
         return CELIX_ENOMEM;
     }
     celix_autofree char* cacheDir = cache->cacheDir;
+    if (asprintf(&cache->contentStoreDir, "%s/%s", cache->cacheDir, CELIX_BUNDLE_CACHE_CONTENT_STORE_DIR_NAME) < 0) {
+        return CELIX_ENOMEM;
+    }
+    celix_autofree char* contentStoreDir = cache->contentStoreDir;
 
     if (cache->deleteOnCreate) {
         status = celix_bundleCache_deleteCacheDir(cache);
@@ -139,6 +146,7 @@ celix_status_t celix_bundleCache_create(celix_framework_t* fw, celix_bundle_cach
     }
     cache->locationToBundleIdLookupMapLoaded = false;
     celix_steal_ptr(cacheDir);
+    celix_steal_ptr(contentStoreDir);
     celix_steal_ptr(mutex);
     celix_steal_ptr(locationToBundleIdLookupMap);
     *out = celix_steal_ptr(cache);
@@ -151,6 +159,7 @@ celix_status_t celix_bundleCache_destroy(celix_bundle_cache_t* cache) {
         status = celix_bundleCache_deleteCacheDir(cache);
     }
     free(cache->cacheDir);
+    free(cache->contentStoreDir);
     celix_stringHashMap_destroy(cache->locationToBundleIdLookupMap);
     celixThreadMutex_destroy(&cache->mutex);
     free(cache);
@@ -205,12 +214,20 @@ celix_status_t celix_bundleCache_createSystemArchive(celix_framework_t* fw, bund
 
 void celix_bundleCache_destroyArchive(celix_bundle_cache_t* cache, bundle_archive_pt archive) {
     celixThreadMutex_lock(&cache->mutex);
-    if (!celix_bundleArchive_isCacheValid(archive)) {
+    bool cacheValid = celix_bundleArchive_isCacheValid(archive);
+    if (!cacheValid) {
         const char* loc = NULL;
         (void) bundleArchive_getLocation(archive, &loc);
         (void) celix_stringHashMap_remove(cache->locationToBundleIdLookupMap, loc);
     }
     (void)celix_bundleArchive_removeInvalidDirs(archive);
+    if (!cacheValid) {
+        //remove the content store files which were only used by the removed resource cache
+        const char* err = NULL;
+        celix_status_t status = celix_utils_pruneContentStore(cache->contentStoreDir, &err);
+        framework_logIfError(cache->fw->logger, status, NULL, "Failed to prune bundle cache content store '%s': %s",
+                             cache->contentStoreDir, err);
+    }
     celixThreadMutex_unlock(&cache->mutex);
     bundleArchive_destroy(archive);
 }
@@ -264,6 +281,10 @@ long celix_bundleCache_findBundleIdForLocation(celix_bundle_cache_t* cache, cons
     return bndId;
 }
 
+const char* celix_bundleCache_getContentStoreDir(celix_bundle_cache_t* cache) {
+    return cache->contentStoreDir;
+}
+
 bool celix_bundleCache_isBundleIdAlreadyUsed(celix_bundle_cache_t* cache, long bndId) {
     bool found = false;
     celixThreadMutex_lock(&cache->mutex);
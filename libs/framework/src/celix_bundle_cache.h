@@ -108,6 +108,17 @@ void celix_bundleCache_destroyArchive(celix_bundle_cache_t* cache, bundle_archiv
  */
 celix_status_t celix_bundleCache_deleteCacheDir(celix_bundle_cache_t* cache);
 
+/**
+ * @brief Returns the content store dir of the bundle cache.
+ *
+ * The content store contains the files extracted from bundle zips, so that identical files can be shared
+ * (using hardlinks) between bundle archives.
+ *
+ * @param cache The bundle cache.
+ * @return The content store dir.
+ */
+const char* celix_bundleCache_getContentStoreDir(celix_bundle_cache_t* cache);
+
 /**
  * @brief Find if the there is already a bundle cache for the provided bundle zip location and if this is true
  * return the bundle id for the bundle cache entry.
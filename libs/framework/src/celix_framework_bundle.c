@@ -23,9 +23,11 @@
 #include "celix_constants.h"
 #include "celix_threads.h"
 #include "celix_dependency_manager.h"
+#include "celix_metrics_provider.h"
 #include "framework_private.h"
 
 #define CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED_DEFAULT true
+#define CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED_DEFAULT true
 
 /**
  * @brief Celix framework bundle activator struct.
@@ -34,6 +36,8 @@ typedef struct celix_framework_bundle {
     celix_bundle_context_t* ctx;
     celix_condition_t conditionInstance; /**< condition instance which can be used for multiple condition services.*/
     framework_listener_t listener;       /**< framework listener to check if the framework is ready. */
+    celix_metrics_provider_t metricsProvider; /**< metrics provider for the framework runtime statistics. */
+    long metricsProviderSvcId;                /**< service id of the framework metrics provider service. */
 
     celix_thread_mutex_t mutex;               /**< protects below. */
     long trueConditionSvcId;                  /**< service id of the condition service which is always true. */
@@ -60,11 +64,29 @@ celix_status_t celix_frameworkBundle_create(celix_bundle_context_t* ctx, void**
     act->listener.frameworkEvent = celix_frameworkBundle_handleFrameworkEvent;
     act->frameworkReadyOrErrorConditionSvcId = -1L;
     act->conditionInstance.handle = act;
+    act->metricsProvider.handle = celix_bundleContext_getFramework(ctx);
+    act->metricsProvider.collectMetrics = celix_framework_collectMetrics;
+    act->metricsProviderSvcId = -1L;
     *userData = act;
 
     return CELIX_SUCCESS;
 }
 
+static void celix_frameworkBundle_registerMetricsProvider(celix_framework_bundle_t* act) {
+    celix_service_registration_options_t opts = CELIX_EMPTY_SERVICE_REGISTRATION_OPTIONS;
+    opts.serviceName = CELIX_METRICS_PROVIDER_SERVICE_NAME;
+    opts.serviceVersion = CELIX_METRICS_PROVIDER_SERVICE_VERSION;
+    opts.svc = &act->metricsProvider;
+    opts.properties = celix_properties_create();
+    if (opts.properties) {
+        celix_properties_set(opts.properties, CELIX_METRICS_PROVIDER_NAME, "framework");
+        celix_framework_setMetricsEnabled(celix_bundleContext_getFramework(act->ctx), true);
+        act->metricsProviderSvcId = celix_bundleContext_registerServiceWithOptionsAsync(act->ctx, &opts);
+    } else {
+        celix_bundleContext_log(act->ctx, CELIX_LOG_LEVEL_ERROR, "Cannot create properties for metrics provider service");
+    }
+}
+
 static void celix_frameworkBundle_registerTrueCondition(celix_framework_bundle_t* act) {
     celix_service_registration_options_t opts = CELIX_EMPTY_SERVICE_REGISTRATION_OPTIONS;
     opts.serviceName = CELIX_CONDITION_SERVICE_NAME;
@@ -123,21 +145,25 @@ celix_status_t celix_frameworkBundle_start(void* userData, celix_bundle_context_
 
     bool conditionsEnabled = celix_bundleContext_getPropertyAsBool(
         ctx, CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED, CELIX_FRAMEWORK_CONDITION_SERVICES_ENABLED_DEFAULT);
-    if (!conditionsEnabled) {
-        return CELIX_SUCCESS;
-    }
+    if (conditionsEnabled) {
+        celix_status_t status = fw_addFrameworkListener(fw, bnd, &act->listener);
+        if (status != CELIX_SUCCESS) {
+            celix_bundleContext_log(
+                    ctx, CELIX_LOG_LEVEL_ERROR, "Cannot add framework listener for framework bundle");
+            return status;
+        }
 
-    celix_status_t status = fw_addFrameworkListener(fw, bnd, &act->listener);
-    if (status != CELIX_SUCCESS) {
-        celix_bundleContext_log(
-                ctx, CELIX_LOG_LEVEL_ERROR, "Cannot add framework listener for framework bundle");
-        return status;
+        celix_frameworkBundle_registerTrueCondition(act);
+        if (act->trueConditionSvcId < 0) {
+            fw_removeFrameworkListener(fw, bnd, &act->listener);
+            return CELIX_BUNDLE_EXCEPTION;
+        }
     }
 
-    celix_frameworkBundle_registerTrueCondition(act);
-    if (act->trueConditionSvcId < 0) {
-        fw_removeFrameworkListener(fw, bnd, &act->listener);
-        return CELIX_BUNDLE_EXCEPTION;
+    bool metricsEnabled = celix_bundleContext_getPropertyAsBool(
+        ctx, CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED, CELIX_FRAMEWORK_METRICS_PROVIDER_ENABLED_DEFAULT);
+    if (metricsEnabled) {
+        celix_frameworkBundle_registerMetricsProvider(act);
     }
 
     return CELIX_SUCCESS;
@@ -160,6 +186,9 @@ celix_status_t celix_frameworkBundle_stop(void* userData, celix_bundle_context_t
 
     celix_bundleContext_unregisterService(ctx, frameworkReadyOrErrorConditionSvcId);
     celix_bundleContext_unregisterService(ctx, trueConditionSvcId);
+    celix_bundleContext_unregisterService(ctx, act->metricsProviderSvcId);
+    act->metricsProviderSvcId = -1L;
+    celix_framework_setMetricsEnabled(framework, false);
 
     // framework shutdown
     celix_framework_shutdownAsync(framework);
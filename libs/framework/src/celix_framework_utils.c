@@ -126,7 +126,8 @@ bool celix_framework_utils_isBundleUrlNewerThan(celix_framework_t* fw, const cha
     return newer;
 }
 
-static celix_status_t celix_framework_utils_extractBundlePath(celix_framework_t *fw, const char* bundlePath, const char* extractPath) {
+static celix_status_t celix_framework_utils_extractBundlePath(celix_framework_t *fw, const char* bundlePath, const char* extractPath,
+                                                             const char* contentStoreDir, const char* indexPath) {
     FW_LOG(CELIX_LOG_LEVEL_TRACE, "Extracting bundle url `%s` to dir `%s`", bundlePath, extractPath);
     const char* err = NULL;
 
@@ -138,10 +139,18 @@ static celix_status_t celix_framework_utils_extractBundlePath(celix_framework_t
     }
     celix_status_t status = CELIX_SUCCESS;
     if (celix_utils_directoryExists(resolvedPath)) {
-        char *abs = realpath(resolvedPath, NULL);
-        if (abs == NULL) {
-            status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
-            err = "Could not get real path for bundle";
+        if (indexPath != NULL && celix_utils_fileExists(indexPath)) {
+            //bundle was previously extracted from a zip file, remove the extracted files
+            (void)unlink(indexPath);
+            status = celix_utils_deleteDirectory(extractPath, &err);
+        }
+        char *abs = NULL;
+        if (status == CELIX_SUCCESS) {
+            abs = realpath(resolvedPath, NULL);
+            if (abs == NULL) {
+                status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
+                err = "Could not get real path for bundle";
+            }
         }
         if (status == CELIX_SUCCESS) {
             if(symlink(abs, extractPath) == -1) {
@@ -150,6 +159,8 @@ static celix_status_t celix_framework_utils_extractBundlePath(celix_framework_t
             }
         }
         free(abs);
+    } else if (contentStoreDir != NULL) {
+        status = celix_utils_extractZipFileIncrementally(resolvedPath, extractPath, contentStoreDir, indexPath, &err);
     } else {
         status = celix_utils_extractZipFile(resolvedPath, extractPath, &err);
     }
@@ -167,9 +178,28 @@ celix_status_t celix_framework_utils_extractBundle(celix_framework_t *fw, const
     celix_status_t status;
     size_t fileSchemeLen = sizeof(FILE_URL_SCHEME)-1;
     if (strncasecmp(FILE_URL_SCHEME, trimmedUrl, fileSchemeLen) == 0) {
-        status = celix_framework_utils_extractBundlePath(fw, trimmedUrl + fileSchemeLen, extractPath);
+        status = celix_framework_utils_extractBundlePath(fw, trimmedUrl + fileSchemeLen, extractPath, NULL, NULL);
+    } else {
+        status = celix_framework_utils_extractBundlePath(fw, trimmedUrl, extractPath, NULL, NULL);
+    }
+
+    free(trimmedUrl);
+    return status;
+}
+
+celix_status_t celix_framework_utils_extractBundleIncrementally(celix_framework_t *fw, const char *bundleURL, const char* extractPath,
+                                                                const char* contentStoreDir, const char* indexPath) {
+    if (!celix_framework_utils_isBundleUrlValid(fw, bundleURL, false)) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    char* trimmedUrl = celix_utils_trim(bundleURL);
+
+    celix_status_t status;
+    size_t fileSchemeLen = sizeof(FILE_URL_SCHEME)-1;
+    if (strncasecmp(FILE_URL_SCHEME, trimmedUrl, fileSchemeLen) == 0) {
+        status = celix_framework_utils_extractBundlePath(fw, trimmedUrl + fileSchemeLen, extractPath, contentStoreDir, indexPath);
     } else {
-        status = celix_framework_utils_extractBundlePath(fw, trimmedUrl, extractPath);
+        status = celix_framework_utils_extractBundlePath(fw, trimmedUrl, extractPath, contentStoreDir, indexPath);
     }
 
     free(trimmedUrl);
@@ -58,6 +58,23 @@ bool celix_framework_utils_isBundleUrlNewerThan(celix_framework_t* fw, const cha
  */
 celix_status_t celix_framework_utils_extractBundle(celix_framework_t *fw, const char *bundleURL,  const char* extractPath);
 
+/**
+ * @brief Incrementally extracts a bundle for the given cache, sharing identical files through a content store.
+ *
+ * Directory bundles are linked (same as celix_framework_utils_extractBundle) and zip bundles are extracted using
+ * celix_utils_extractZipFileIncrementally.
+ *
+ * @param fw Optional Celix framework (used for logging).
+ *           If NULL the result of celix_frameworkLogger_globalLogger() will be used for logging.
+ * @param bundleURL The bundle url. See celix_framework_utils_extractBundle.
+ * @param extractPath The path to extract the bundle to.
+ * @param contentStoreDir The path of the content store used to share files between extracted bundles.
+ * @param indexPath The path of the index file, which keeps track of the files extracted to extractPath.
+ * @return CELIX_SUCCESS is the bundle was correctly extracted.
+ */
+celix_status_t celix_framework_utils_extractBundleIncrementally(celix_framework_t *fw, const char *bundleURL, const char* extractPath,
+                                                                const char* contentStoreDir, const char* indexPath);
+
 /**
  * @brief Checks whether the provided bundle url is valid.
  *
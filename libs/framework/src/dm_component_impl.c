@@ -29,6 +29,7 @@
 #include "celix_filter.h"
 #include "dm_component_impl.h"
 #include "celix_framework.h"
+#include "framework_private.h"
 
 static const char * const CELIX_DM_PRINT_OK_COLOR = "\033[92m";
 static const char * const CELIX_DM_PRINT_WARNING_COLOR = "\033[93m";
@@ -64,11 +65,24 @@ struct celix_dm_component_struct {
 
     bool isEnabled;
 
+    /**
+     * Whether the component is counted in the framework wide inactive component count, i.e. the component is enabled
+     * but not active.
+     */
+    bool countedAsInactive;
+
     /**
      * Whether the component is an a transition (active performTransition call).
      * Should only be used inside the Celix event Thread -> no locking needed.
      */
     bool inTransition;
+
+    /**
+     * Whether the component is suspended for a service update and the resume is deferred to the end of the current
+     * event, so that multiple service updates during one event only need a single suspend/resume cycle.
+     * Should only be used inside the Celix event Thread -> no locking needed.
+     */
+    bool resumeDeferred;
 };
 
 typedef struct dm_interface_struct {
@@ -84,6 +98,7 @@ static bool celix_dmComponent_areAllRequiredServiceDependenciesResolved(celix_dm
 static bool celix_dmComponent_performTransition(celix_dm_component_t *component, celix_dm_component_state_t oldState, celix_dm_component_state_t newState);
 static celix_status_t celix_dmComponent_calculateNewState(celix_dm_component_t *component, celix_dm_component_state_t currentState, celix_dm_component_state_t *newState);
 static celix_status_t celix_dmComponent_handleChange(celix_dm_component_t *component);
+static void celix_dmComponent_handleChangeOnEventThread(void *data);
 static celix_status_t celix_dmComponent_handleAdd(celix_dm_component_t *component, const celix_dm_event_t* event);
 static celix_status_t celix_dmComponent_handleRemove(celix_dm_component_t *component, const celix_dm_event_t* event);
 static celix_status_t celix_dmComponent_handleSet(celix_dm_component_t *component, const celix_dm_event_t* event);
@@ -97,6 +112,7 @@ static bool celix_dmComponent_isDisabled(celix_dm_component_t *component);
 static void celix_dmComponent_cleanupRemovedDependencies(celix_dm_component_t* component);
 static bool celix_dmComponent_isActiveInternal(celix_dm_component_t *component);
 static void celix_dmComponent_setCurrentState(celix_dm_component_t* cmp, celix_dm_component_state_t s);
+static void celix_dmComponent_updateInactiveCount(celix_dm_component_t* cmp);
 static void celix_dmComponent_logTransition(celix_dm_component_t* cmp, celix_dm_component_state_t currentState, celix_dm_component_state_t desiredState);
 
 celix_dm_component_t* celix_dmComponent_create(bundle_context_t *context, const char* name) {
@@ -228,6 +244,7 @@ static void celix_dmComponent_destroyCallback(void *voidData) {
         }
         celix_arrayList_destroy(component->removedDependencies);
 
+        celix_framework_cancelDeferredCall(celix_bundleContext_getFramework(component->context), component);
         celixThreadMutex_destroy(&component->mutex);
         free(component);
 
@@ -283,7 +300,10 @@ celix_status_t celix_dmComponent_addServiceDependency(celix_dm_component_t *comp
 
     celixThreadMutex_lock(&component->mutex);
     celix_arrayList_add(component->dependencies, dep);
-    bool startDep = celix_dmComponent_currentState(component) != CELIX_DM_CMP_STATE_INACTIVE;
+    celix_dm_component_state_t state = celix_dmComponent_currentState(component);
+    bool startDep = celix_dmServiceDependency_isLazy(dep) ?
+                    state == CELIX_DM_CMP_STATE_TRACKING_OPTIONAL :
+                    state != CELIX_DM_CMP_STATE_INACTIVE;
     if (startDep) {
         celix_dmServiceDependency_enable(dep);
     }
@@ -315,7 +335,23 @@ celix_dm_component_state_t component_currentState(celix_dm_component_t *cmp) {
 }
 
 static void celix_dmComponent_setCurrentState(celix_dm_component_t* cmp, celix_dm_component_state_t s) {
+    //precondition: mutex component->mutex taken.
     __atomic_store_n(&cmp->state, s, __ATOMIC_RELEASE);
+    celix_dmComponent_updateInactiveCount(cmp);
+}
+
+/**
+ * @brief Updates the framework wide inactive component count if the component became (in)active or was
+ * enabled/disabled.
+ */
+static void celix_dmComponent_updateInactiveCount(celix_dm_component_t* cmp) {
+    //precondition: mutex component->mutex taken.
+    bool inactive = cmp->isEnabled && !celix_dmComponent_isActiveInternal(cmp);
+    if (inactive != cmp->countedAsInactive) {
+        cmp->countedAsInactive = inactive;
+        celix_framework_updateNrOfInactiveComponents(celix_bundleContext_getFramework(cmp->context),
+                                                     inactive ? 1 : -1);
+    }
 }
 
 celix_dm_component_state_t celix_dmComponent_currentState(celix_dm_component_t *cmp) {
@@ -349,6 +385,7 @@ celix_status_t celix_private_dmComponent_enable(celix_dm_component_t *component)
     if (!component->isEnabled) {
         changed = !component->isEnabled;
         component->isEnabled = true;
+        celix_dmComponent_updateInactiveCount(component);
     }
     celixThreadMutex_unlock(&component->mutex);
     if (changed) {
@@ -366,6 +403,7 @@ static celix_status_t celix_dmComponent_disable(celix_dm_component_t *component)
     if (component->isEnabled) {
         changed = component->isEnabled;
         component->isEnabled = false;
+        celix_dmComponent_updateInactiveCount(component);
     }
     celixThreadMutex_unlock(&component->mutex);
     if (changed) {
@@ -621,7 +659,7 @@ static celix_status_t celix_dmComponent_resume(celix_dm_component_t *component,
 }
 
 static bool celix_dmComponent_needsSuspend(celix_dm_component_t *component, const celix_dm_event_t* event) {
-    if (celix_dmComponent_currentState(component) == CELIX_DM_CMP_STATE_TRACKING_OPTIONAL) {
+    if (celix_dmComponent_currentState(component) == CELIX_DM_CMP_STATE_TRACKING_OPTIONAL || component->resumeDeferred) {
         bool callbackConfigured = event->eventType == CELIX_DM_EVENT_SVC_SET ?
                                   celix_dmServiceDependency_isSetCallbackConfigured(event->dep) :
                                  /*add or rem*/ celix_dmServiceDependency_isAddRemCallbacksConfigured(event->dep);
@@ -651,32 +689,44 @@ static celix_status_t celix_dmComponent_handleEvent(celix_dm_component_t *compon
         return CELIX_SUCCESS;
     }
 
-    bool eventHandled = false;
+    celix_framework_t* fw = celix_bundleContext_getFramework(component->context);
     if (event->eventType == CELIX_DM_EVENT_SVC_ADD || (event->eventType == CELIX_DM_EVENT_SVC_SET && event->svc != NULL)) {
         //note adding service or setting new service, so cmp will not be stopped in handleChange -> use suspend / resume now
-        eventHandled = true;
         bool needSuspend = celix_dmComponent_needsSuspend(component, event);
-        if (needSuspend) {
+        if (needSuspend && component->resumeDeferred) {
+            //note already suspended for an earlier service update during the current event
+            needSuspend = false;
+            celix_framework_increaseNrOfBatchedComponentResumes(fw);
+        } else if (needSuspend) {
             celix_dmComponent_suspend(component, event->dep);
         }
         setAddOrRemFp(event->dep, event->svc, event->props);
-        if (needSuspend) {
+
+        //note the state evaluation (and resume) is deferred to the end of the current event, so that multiple
+        //service updates during one event (e.g. opening a tracker for multiple services) result in a single
+        //state transition.
+        bool deferred = celix_framework_deferUntilEventHandled(fw, component, celix_dmComponent_handleChangeOnEventThread);
+        if (needSuspend && deferred) {
+            component->resumeDeferred = true;
+        } else if (needSuspend) {
             celix_dmComponent_resume(component, event->dep);
         }
-    };
+        if (!deferred) {
+            celix_dmComponent_handleChange(component);
+        }
+        return CELIX_SUCCESS;
+    }
 
     celix_dmComponent_handleChange(component);
 
-    if (!eventHandled /*remove or set null*/) {
-        //removing svc or set svc to null -> if still active check if suspend is needed before invoking
-        bool needSuspend = celix_dmComponent_needsSuspend(component, event);
-        if (needSuspend) {
-            celix_dmComponent_suspend(component, event->dep);
-        }
-        setAddOrRemFp(event->dep, event->svc, event->props);
-        if (needSuspend) {
-            celix_dmComponent_resume(component, event->dep);
-        }
+    //removing svc or set svc to null -> if still active check if suspend is needed before invoking
+    bool needSuspend = celix_dmComponent_needsSuspend(component, event);
+    if (needSuspend) {
+        celix_dmComponent_suspend(component, event->dep);
+    }
+    setAddOrRemFp(event->dep, event->svc, event->props);
+    if (needSuspend) {
+        celix_dmComponent_resume(component, event->dep);
     }
 
     return CELIX_SUCCESS;
@@ -700,7 +750,39 @@ static celix_status_t celix_dmComponent_handleSet(celix_dm_component_t *componen
 static celix_status_t celix_dmComponent_enableDependencies(celix_dm_component_t *component) {
     for (int i = 0; i < celix_arrayList_size(component->dependencies); i++) {
         celix_dm_service_dependency_t *dependency = celix_arrayList_get(component->dependencies, i);
-        celix_dmServiceDependency_enable(dependency);
+        if (!celix_dmServiceDependency_isLazy(dependency)) {
+            celix_dmServiceDependency_enable(dependency);
+        }
+    }
+    return CELIX_SUCCESS;
+}
+
+/**
+ * Opens the trackers of the lazy dependencies. Called on the event thread during the start transition, so the
+ * tracker callbacks for the already registered services are handled as part of the transition.
+ * This function should be called with the component->mutex locked.
+ */
+static celix_status_t celix_dmComponent_enableLazyDependencies(celix_dm_component_t *component) {
+    celix_status_t status = CELIX_SUCCESS;
+    for (int i = 0; status == CELIX_SUCCESS && i < celix_arrayList_size(component->dependencies); i++) {
+        celix_dm_service_dependency_t *dependency = celix_arrayList_get(component->dependencies, i);
+        if (celix_dmServiceDependency_isLazy(dependency)) {
+            status = celix_dmServiceDependency_enableLazy(dependency);
+        }
+    }
+    return status;
+}
+
+/**
+ * Closes the trackers of the lazy dependencies. Called on the event thread during the stop transition.
+ * This function should be called with the component->mutex locked.
+ */
+static celix_status_t celix_dmComponent_disableLazyDependencies(celix_dm_component_t *component) {
+    for (int i = 0; i < celix_arrayList_size(component->dependencies); i++) {
+        celix_dm_service_dependency_t *dependency = celix_arrayList_get(component->dependencies, i);
+        if (celix_dmServiceDependency_isLazy(dependency)) {
+            celix_dmServiceDependency_disableLazy(dependency);
+        }
     }
     return CELIX_SUCCESS;
 }
@@ -724,6 +806,11 @@ static void celix_dmComponent_handleChangeOnEventThread(void *data) {
     celix_dm_component_t* component = data;
     assert(celix_framework_isCurrentThreadTheEventLoop(celix_bundleContext_getFramework(component->context)));
 
+    if (component->resumeDeferred) {
+        component->resumeDeferred = false;
+        celix_dmComponent_resume(component, NULL);
+    }
+
     celixThreadMutex_lock(&component->mutex);
     celix_dm_component_state_t oldState;
     celix_dm_component_state_t newState;
@@ -852,7 +939,8 @@ static bool celix_dmComponent_performTransition(celix_dm_component_t *component,
     } else if (currentState == CELIX_DM_CMP_STATE_INITIALIZED_AND_WAITING_FOR_REQUIRED && desiredState == CELIX_DM_CMP_STATE_STARTING) {
         //nop
     } else if (currentState == CELIX_DM_CMP_STATE_STARTING && desiredState == CELIX_DM_CMP_STATE_TRACKING_OPTIONAL) {
-        if (component->callbackStart) {
+        status = celix_dmComponent_enableLazyDependencies(component);
+        if (status == CELIX_SUCCESS && component->callbackStart) {
         	status = component->callbackStart(component->implementation);
         }
         if (status == CELIX_SUCCESS) {
@@ -866,6 +954,7 @@ static bool celix_dmComponent_performTransition(celix_dm_component_t *component,
         if (component->callbackStop) {
         	status = component->callbackStop(component->implementation);
         }
+        celix_dmComponent_disableLazyDependencies(component);
     } else if (currentState == CELIX_DM_CMP_STATE_WAITING_FOR_REQUIRED && desiredState == CELIX_DM_CMP_STATE_INACTIVE) {
         celix_dmComponent_disableDependencies(component);
     } else {
@@ -897,7 +986,8 @@ static bool celix_dmComponent_areAllRequiredServiceDependenciesResolved(celix_dm
     bool allResolved = true;
     for (int i = 0; i < celix_arrayList_size(component->dependencies); i++) {
         celix_dm_service_dependency_t *dependency = celix_arrayList_get(component->dependencies, i);
-        bool started = celix_dmServiceDependency_isTrackerOpen(dependency);
+        //note lazy dependencies are optional and only tracked when the component is started
+        bool started = celix_dmServiceDependency_isLazy(dependency) || celix_dmServiceDependency_isTrackerOpen(dependency);
         bool required = celix_dmServiceDependency_isRequired(dependency);
         bool available = celix_dmServiceDependency_isAvailable(dependency);
         if (!started) {
@@ -31,6 +31,7 @@
 #include "celix_compiler.h"
 #include "celix_framework.h"
 #include "celix_array_list.h"
+#include "framework_private.h"
 
 celix_dependency_manager_t* celix_private_dependencyManager_create(celix_bundle_context_t *context) {
 	celix_dependency_manager_t *manager = calloc(1, sizeof(*manager));
@@ -280,6 +281,10 @@ bool celix_dependencyManager_allComponentsActive(celix_dependency_manager_t *man
 	return allActive;
 }
 
+size_t celix_dependencyManager_nrOfInactiveComponentsOfAllBundles(celix_dependency_manager_t *manager) {
+    return celix_framework_nrOfInactiveComponents(celix_bundleContext_getFramework(manager->ctx));
+}
+
 size_t celix_dependencyManager_nrOfComponents(celix_dependency_manager_t *mng) {
     celixThreadMutex_lock(&mng->mutex);
     size_t nr = (size_t)celix_arrayList_size(mng->components);
@@ -116,6 +116,19 @@ celix_dm_service_dependency_strategy_t celix_dmServiceDependency_getStrategy(cel
 	return dependency->strategy;
 }
 
+celix_status_t celix_dmServiceDependency_setTrackingMode(celix_dm_service_dependency_t *dependency, celix_dm_service_dependency_tracking_mode_t mode) {
+    dependency->trackingMode = mode;
+    return CELIX_SUCCESS;
+}
+
+celix_dm_service_dependency_tracking_mode_t celix_dmServiceDependency_getTrackingMode(const celix_dm_service_dependency_t *dependency) {
+    return dependency->trackingMode;
+}
+
+bool celix_dmServiceDependency_isLazy(const celix_dm_service_dependency_t *dependency) {
+    return dependency->trackingMode == CELIX_DM_SERVICE_DEPENDENCY_TRACKING_LAZY && !dependency->required;
+}
+
 celix_status_t serviceDependency_setService(celix_dm_service_dependency_t *dependency, const char* serviceName, const char* serviceVersionRange, const char* filter) {
 	return celix_dmServiceDependency_setService(dependency, serviceName, serviceVersionRange, filter);
 }
@@ -183,25 +196,33 @@ celix_status_t celix_dmServiceDependency_setComponent(celix_dm_service_dependenc
 	return CELIX_SUCCESS;
 }
 
-celix_status_t celix_dmServiceDependency_enable(celix_dm_service_dependency_t* dependency) {
+static celix_status_t celix_dmServiceDependency_createTrackingOptions(celix_dm_service_dependency_t* dependency, celix_service_tracking_options_t* opts) {
+    if (dependency->serviceName == NULL && dependency->filter == NULL) {
         celix_bundle_context_t* ctx = celix_dmComponent_getBundleContext(dependency->component);
+        celix_bundleContext_log(
+            ctx, CELIX_LOG_LEVEL_ERROR, "Cannot start a service dependency without a service name and filter");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    opts->filter.filter = dependency->filter;
+    opts->filter.serviceName = dependency->serviceName;
+    opts->filter.versionRange = dependency->versionRange;
+    opts->callbackHandle = dependency;
+    opts->addWithProperties = serviceDependency_addServiceTrackerCallback;
+    opts->removeWithProperties = serviceDependency_removeServiceTrackerCallback;
+    opts->setWithProperties = serviceDependency_setServiceTrackerCallback;
+    return CELIX_SUCCESS;
+}
 
-        if (dependency->serviceName == NULL && dependency->filter == NULL) {
-                celix_bundleContext_log(
-                    ctx, CELIX_LOG_LEVEL_ERROR, "Cannot start a service dependency without a service name and filter");
-                return CELIX_ILLEGAL_ARGUMENT;
+celix_status_t celix_dmServiceDependency_enable(celix_dm_service_dependency_t* dependency) {
+        celix_bundle_context_t* ctx = celix_dmComponent_getBundleContext(dependency->component);
+        celix_service_tracking_options_t opts = CELIX_EMPTY_SERVICE_TRACKING_OPTIONS;
+        celix_status_t status = celix_dmServiceDependency_createTrackingOptions(dependency, &opts);
+        if (status != CELIX_SUCCESS) {
+                return status;
         }
 
         celixThreadMutex_lock(&dependency->mutex);
         if (dependency->svcTrackerId == -1L) {
-                celix_service_tracking_options_t opts = CELIX_EMPTY_SERVICE_TRACKING_OPTIONS;
-                opts.filter.filter = dependency->filter;
-                opts.filter.serviceName = dependency->serviceName;
-                opts.filter.versionRange = dependency->versionRange;
-                opts.callbackHandle = dependency;
-                opts.addWithProperties = serviceDependency_addServiceTrackerCallback;
-                opts.removeWithProperties = serviceDependency_removeServiceTrackerCallback;
-                opts.setWithProperties = serviceDependency_setServiceTrackerCallback;
                 dependency->svcTrackerId = celix_bundleContext_trackServicesWithOptionsAsync(ctx, &opts);
         }
         celixThreadMutex_unlock(&dependency->mutex);
@@ -209,6 +230,41 @@ celix_status_t celix_dmServiceDependency_enable(celix_dm_service_dependency_t* d
         return CELIX_SUCCESS;
 }
 
+celix_status_t celix_dmServiceDependency_enableLazy(celix_dm_service_dependency_t* dependency) {
+    celix_bundle_context_t* ctx = celix_dmComponent_getBundleContext(dependency->component);
+    celix_service_tracking_options_t opts = CELIX_EMPTY_SERVICE_TRACKING_OPTIONS;
+    celix_status_t status = celix_dmServiceDependency_createTrackingOptions(dependency, &opts);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+
+    celixThreadMutex_lock(&dependency->mutex);
+    bool open = dependency->svcTrackerId >= 0;
+    celixThreadMutex_unlock(&dependency->mutex);
+    if (open) {
+        return CELIX_SUCCESS;
+    }
+
+    //note on the event thread the tracker is created directly and the tracker callbacks (which lock the dependency
+    //mutex) are called before the function returns, so the mutex cannot be held here.
+    long trackerId = celix_bundleContext_trackServicesWithOptions(ctx, &opts);
+    celixThreadMutex_lock(&dependency->mutex);
+    dependency->svcTrackerId = trackerId;
+    celixThreadMutex_unlock(&dependency->mutex);
+    return trackerId >= 0 ? CELIX_SUCCESS : CELIX_BUNDLE_EXCEPTION;
+}
+
+celix_status_t celix_dmServiceDependency_disableLazy(celix_dm_service_dependency_t* dependency) {
+    celixThreadMutex_lock(&dependency->mutex);
+    long trackerId = dependency->svcTrackerId;
+    dependency->svcTrackerId = -1;
+    celixThreadMutex_unlock(&dependency->mutex);
+    if (trackerId >= 0) {
+        celix_bundleContext_stopTracker(celix_dmComponent_getBundleContext(dependency->component), trackerId);
+    }
+    return CELIX_SUCCESS;
+}
+
 static void celix_serviceDependency_stopCallback(void *data) {
     celix_dm_service_dependency_t* dependency = data;
     celixThreadMutex_lock(&dependency->mutex);
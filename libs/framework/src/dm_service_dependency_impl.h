@@ -53,6 +53,7 @@ struct celix_dm_service_dependency {
     char* versionRange;
     bool required;
     dm_service_dependency_strategy_t strategy;
+    celix_dm_service_dependency_tracking_mode_t trackingMode;
     celix_dm_component_t* component;
 
     celix_thread_mutex_t mutex;        // protects below
@@ -65,6 +66,27 @@ struct celix_dm_service_dependency {
 celix_status_t celix_dmServiceDependency_enable(celix_dm_service_dependency_t *dependency);
 celix_status_t celix_dmServiceDependency_disable(celix_dm_service_dependency_t *dependency);
 
+/**
+ * @brief Opens the service tracker of a lazy service dependency (if not already open).
+ *
+ * Must be called on the Celix event thread. The tracker is opened synchronously, so the callbacks for the already
+ * registered services are called before this function returns.
+ */
+celix_status_t celix_dmServiceDependency_enableLazy(celix_dm_service_dependency_t *dependency);
+
+/**
+ * @brief Closes the service tracker of a lazy service dependency (if open).
+ *
+ * Must be called on the Celix event thread. The tracker is closed synchronously, so the remove callbacks for the
+ * tracked services are called before this function returns.
+ */
+celix_status_t celix_dmServiceDependency_disableLazy(celix_dm_service_dependency_t *dependency);
+
+/**
+ * @brief Whether the service tracker of the service dependency is only open while the component is started.
+ */
+bool celix_dmServiceDependency_isLazy(const celix_dm_service_dependency_t *dependency);
+
 bool celix_dmServiceDependency_isDisabled(celix_dm_service_dependency_t *dependency);
 
 celix_status_t celix_dmServiceDependency_setComponent(celix_dm_service_dependency_t *dependency, celix_dm_component_t *component);
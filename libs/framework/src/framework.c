@@ -20,6 +20,7 @@
 #include <assert.h>
 #include <celix_log_utils.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -35,6 +36,7 @@
 #include "celix_file_utils.h"
 #include "celix_framework_utils_private.h"
 #include "celix_libloader.h"
+#include "celix_lock_profiling.h"
 #include "celix_log_constants.h"
 #include "celix_module_private.h"
 #include "celix_framework_bundle.h"
@@ -224,12 +226,18 @@ celix_status_t framework_create(framework_pt *out, celix_properties_t* config) {
 
     celixThreadCondition_init(&framework->shutdown.cond, NULL);
     celixThreadMutex_create(&framework->shutdown.mutex, NULL);
-    celixThreadMutex_create(&framework->dispatcher.mutex, NULL);
+    celix_thread_mutexattr_t dispatcherMutexAttr;
+    celixThreadMutexAttr_create(&dispatcherMutexAttr);
+    celixThreadMutexAttr_settype(&dispatcherMutexAttr, CELIX_THREAD_MUTEX_ADAPTIVE); //short, frequently contended
+    celixThreadMutex_create(&framework->dispatcher.mutex, &dispatcherMutexAttr);
+    celixThreadMutexAttr_destroy(&dispatcherMutexAttr);
     celixThreadMutex_create(&framework->frameworkListenersLock, NULL);
     celixThreadMutex_create(&framework->bundleListenerLock, NULL);
     celixThreadMutex_create(&framework->installLock, NULL);
     celixThreadMutex_create(&framework->installedBundles.mutex, NULL);
     celixThreadCondition_init(&framework->dispatcher.cond, NULL);
+    celix_lockProfiling_setName(&framework->dispatcher.mutex, "celix::framework::dispatcher");
+    celix_lockProfiling_setName(&framework->installedBundles.mutex, "celix::framework::installed_bundles");
     framework->dispatcher.active = true;
     framework->currentBundleId = CELIX_FRAMEWORK_BUNDLE_ID;
     framework->installRequestMap = hashMap_create(utils_stringHash, utils_stringHash, utils_stringEquals, utils_stringEquals);
@@ -241,6 +249,9 @@ celix_status_t framework_create(framework_pt *out, celix_properties_t* config) {
     framework->dispatcher.eventQueue = malloc(sizeof(celix_framework_event_t) * framework->dispatcher.eventQueueCap);
     framework->dispatcher.dynamicEventQueue = celix_arrayList_create();
     framework->dispatcher.scheduledEvents = celix_longHashMap_create();
+    framework->dispatcher.idleCallbacks = celix_arrayList_create();
+    framework->dispatcher.deferredCalls = celix_arrayList_create();
+    framework->dispatcher.deferredCallsByData = celix_longHashMap_create();
 
     //create and store framework uuid
     char uuid[37];
@@ -360,6 +371,14 @@ celix_status_t framework_destroy(framework_pt framework) {
     assert(celix_longHashMap_size(framework->dispatcher.scheduledEvents) == 0);
     celix_longHashMap_destroy(framework->dispatcher.scheduledEvents);
 
+    for (int i = 0; i < celix_arrayList_size(framework->dispatcher.idleCallbacks); ++i) {
+        free(celix_arrayList_get(framework->dispatcher.idleCallbacks, i));
+    }
+    celix_arrayList_destroy(framework->dispatcher.idleCallbacks);
+    assert(celix_arrayList_size(framework->dispatcher.deferredCalls) == 0);
+    celix_arrayList_destroy(framework->dispatcher.deferredCalls);
+    celix_longHashMap_destroy(framework->dispatcher.deferredCallsByData);
+
     celix_bundleCache_destroy(framework->cache);
 
 	celixThreadCondition_destroy(&framework->dispatcher.cond);
@@ -798,11 +817,35 @@ celix_status_t fw_registerServiceFactory(framework_pt framework, service_registr
     return status;
 }
 
+struct fw_assignableReferencesFilterData {
+    bundle_pt bundle;
+    celix_status_t status;
+};
+
+/**
+ * @brief Returns true (and releases the reference) if the service reference is not assignable to the bundle.
+ */
+static bool fw_releaseIfNotAssignable(void* data, celix_array_list_entry_t entry) {
+    struct fw_assignableReferencesFilterData* filterData = data;
+    service_reference_pt ref = entry.voidPtrVal;
+    service_registration_pt reg = NULL;
+    celix_properties_t* props = NULL;
+    filterData->status = CELIX_DO_IF(filterData->status, serviceReference_getServiceRegistration(ref, &reg));
+    filterData->status = CELIX_DO_IF(filterData->status, serviceRegistration_getProperties(reg, &props));
+    if (filterData->status == CELIX_SUCCESS) {
+        const char* serviceNameObjectClass = celix_properties_get(props, CELIX_FRAMEWORK_SERVICE_NAME, NULL);
+        if (!serviceReference_isAssignableTo(ref, filterData->bundle, serviceNameObjectClass)) {
+            serviceReference_release(ref, NULL);
+            return true;
+        }
+    }
+    return false;
+}
+
 celix_status_t fw_getServiceReferences(framework_pt framework, celix_array_list_t** references, bundle_pt bundle, const char * serviceName, const char * sfilter) {
     celix_status_t status = CELIX_SUCCESS;
 
     celix_autoptr(celix_filter_t) filter = NULL;
-    int refIdx = 0;
 
     if (sfilter != NULL) {
         filter = celix_filter_create(sfilter);
@@ -811,23 +854,10 @@ celix_status_t fw_getServiceReferences(framework_pt framework, celix_array_list_
     status = CELIX_DO_IF(status, serviceRegistry_getServiceReferences(framework->registry, bundle, serviceName, filter, references));
 
 
-    if (status == CELIX_SUCCESS) {
-        for (refIdx = 0; (*references != NULL) && refIdx < celix_arrayList_size(*references); refIdx++) {
-            service_reference_pt ref = (service_reference_pt) celix_arrayList_get(*references, refIdx);
-            service_registration_pt reg = NULL;
-            const char* serviceNameObjectClass;
-            celix_properties_t* props = NULL;
-            status = CELIX_DO_IF(status, serviceReference_getServiceRegistration(ref, &reg));
-            status = CELIX_DO_IF(status, serviceRegistration_getProperties(reg, &props));
-            if (status == CELIX_SUCCESS) {
-                serviceNameObjectClass = celix_properties_get(props, CELIX_FRAMEWORK_SERVICE_NAME, NULL);
-                if (!serviceReference_isAssignableTo(ref, bundle, serviceNameObjectClass)) {
-                    serviceReference_release(ref, NULL);
-                    celix_arrayList_removeAt(*references, refIdx);
-                    refIdx--;
-                }
-            }
-        }
+    if (status == CELIX_SUCCESS && *references != NULL) {
+        struct fw_assignableReferencesFilterData filterData = {.bundle = bundle, .status = CELIX_SUCCESS};
+        celix_arrayList_removeIf(*references, fw_releaseIfNotAssignable, &filterData);
+        status = filterData.status;
     }
 
     framework_logIfError(framework->logger, status, NULL, "Failed to get service references");
@@ -1201,11 +1231,16 @@ void fw_fireFrameworkEvent(framework_pt framework, framework_event_type_e eventT
 }
 
 static void celix_framework_addToEventQueue(celix_framework_t *fw, const celix_framework_event_t* event) {
+    struct timespec enqueueTime = {0, 0};
+    if (__atomic_load_n(&fw->dispatcher.metrics.enabled, __ATOMIC_RELAXED)) {
+        enqueueTime = celix_gettime(CLOCK_MONOTONIC);
+    }
     celixThreadMutex_lock(&fw->dispatcher.mutex);
     //try to add to static queue
     if (celix_arrayList_size(fw->dispatcher.dynamicEventQueue) > 0) { //always to dynamic queue if not empty (to ensure order)
         celix_framework_event_t *e = malloc(sizeof(*e));
         *e = *event; //shallow copy
+        e->enqueueTime = enqueueTime;
         celix_arrayList_add(fw->dispatcher.dynamicEventQueue, e);
         if (celix_arrayList_size(fw->dispatcher.dynamicEventQueue) % 100 == 0) {
             fw_log(fw->logger, CELIX_LOG_LEVEL_WARNING, "dynamic event queue size is %i. Is there a bundle blocking on the event loop thread?", celix_arrayList_size(fw->dispatcher.dynamicEventQueue));
@@ -1214,6 +1249,7 @@ static void celix_framework_addToEventQueue(celix_framework_t *fw, const celix_f
         size_t index = (fw->dispatcher.eventQueueFirstEntry + fw->dispatcher.eventQueueSize) %
                        fw->dispatcher.eventQueueCap;
         fw->dispatcher.eventQueue[index] = *event; //shallow copy
+        fw->dispatcher.eventQueue[index].enqueueTime = enqueueTime;
         fw->dispatcher.eventQueueSize += 1;
     } else {
         //static queue is full, dynamics queue is empty. Add first entry to dynamic queue
@@ -1221,13 +1257,74 @@ static void celix_framework_addToEventQueue(celix_framework_t *fw, const celix_f
                "Static event queue for celix framework is full, falling back to dynamic allocated events. Increase static event queue size, current size is %i", fw->dispatcher.eventQueueCap);
         celix_framework_event_t *e = malloc(sizeof(*e));
         *e = *event; //shallow copy
+        e->enqueueTime = enqueueTime;
         celix_arrayList_add(fw->dispatcher.dynamicEventQueue, e);
     }
+    int queueSize = fw->dispatcher.eventQueueSize + celix_arrayList_size(fw->dispatcher.dynamicEventQueue);
+    __atomic_store_n(&fw->dispatcher.metrics.eventQueueSize, queueSize, __ATOMIC_RELAXED);
+    if (queueSize > __atomic_load_n(&fw->dispatcher.metrics.maxEventQueueSize, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&fw->dispatcher.metrics.maxEventQueueSize, queueSize, __ATOMIC_RELAXED);
+    }
     celixThreadCondition_broadcast(&fw->dispatcher.cond);
     celixThreadMutex_unlock(&fw->dispatcher.mutex);
 }
 
+/**
+ * @brief Call the deferred calls, including the calls deferred by a deferred call.
+ * Only called on the event thread.
+ */
+static void celix_framework_callDeferredCalls(celix_framework_t* fw) {
+    while (celix_arrayList_size(fw->dispatcher.deferredCalls) > 0) {
+        celix_framework_deferred_call_t* call = celix_arrayList_get(fw->dispatcher.deferredCalls, 0);
+        celix_arrayList_removeAt(fw->dispatcher.deferredCalls, 0);
+        celix_longHashMap_remove(fw->dispatcher.deferredCallsByData, (long)(intptr_t)call->data);
+        call->callback(call->data);
+        free(call);
+    }
+}
+
+bool celix_framework_deferUntilEventHandled(celix_framework_t* fw, void* data, void (*callback)(void* data)) {
+    if (!celix_framework_isCurrentThreadTheEventLoop(fw) || !fw->dispatcher.handlingEvent) {
+        return false;
+    }
+    if (celix_longHashMap_hasKey(fw->dispatcher.deferredCallsByData, (long)(intptr_t)data)) {
+        __atomic_add_fetch(&fw->dispatcher.nrOfCoalescedDeferredCalls, 1, __ATOMIC_RELAXED);
+        return true;
+    }
+    celix_framework_deferred_call_t* call = malloc(sizeof(*call));
+    if (call == NULL) {
+        return false;
+    }
+    call->data = data;
+    call->callback = callback;
+    if (celix_arrayList_add(fw->dispatcher.deferredCalls, call) != CELIX_SUCCESS) {
+        free(call);
+        return false;
+    }
+    if (celix_longHashMap_put(fw->dispatcher.deferredCallsByData, (long)(intptr_t)data, call) != CELIX_SUCCESS) {
+        celix_arrayList_remove(fw->dispatcher.deferredCalls, call);
+        free(call);
+        return false;
+    }
+    __atomic_add_fetch(&fw->dispatcher.nrOfDeferredCalls, 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+void celix_framework_cancelDeferredCall(celix_framework_t* fw, void* data) {
+    if (!celix_framework_isCurrentThreadTheEventLoop(fw)) {
+        //note deferred calls only exist during the handling of an event on the event thread
+        return;
+    }
+    celix_framework_deferred_call_t* call = celix_longHashMap_get(fw->dispatcher.deferredCallsByData, (long)(intptr_t)data);
+    if (call != NULL) {
+        celix_longHashMap_remove(fw->dispatcher.deferredCallsByData, (long)(intptr_t)data);
+        celix_arrayList_remove(fw->dispatcher.deferredCalls, call);
+        free(call);
+    }
+}
+
 static void fw_handleEventRequest(celix_framework_t *framework, celix_framework_event_t* event) {
+    framework->dispatcher.handlingEvent = true;
     if (event->type == CELIX_BUNDLE_EVENT_TYPE) {
         celix_array_list_t *localListeners = celix_arrayList_create();
         celixThreadMutex_lock(&framework->bundleListenerLock);
@@ -1290,6 +1387,8 @@ static void fw_handleEventRequest(celix_framework_t *framework, celix_framework_
         }
         __atomic_sub_fetch(&framework->dispatcher.stats.nbEvent, 1, __ATOMIC_RELAXED);
     }
+    celix_framework_callDeferredCalls(framework);
+    framework->dispatcher.handlingEvent = false;
 
     if (event->doneCallback != NULL && !event->cancelled) {
         event->doneCallback(event->doneData);
@@ -1318,20 +1417,42 @@ static inline bool fw_removeTopEventFromQueue(celix_framework_t* fw) {
         celix_arrayList_removeAt(fw->dispatcher.dynamicEventQueue, 0);
         dynamicallyAllocated = true;
     }
+    __atomic_store_n(&fw->dispatcher.metrics.eventQueueSize,
+                     fw->dispatcher.eventQueueSize + celix_arrayList_size(fw->dispatcher.dynamicEventQueue),
+                     __ATOMIC_RELAXED);
     celixThreadCondition_broadcast(&fw->dispatcher.cond); //notify that the queue size is changed
     celixThreadMutex_unlock(&fw->dispatcher.mutex);
     return dynamicallyAllocated;
 }
 
 
-static inline void fw_handleEvents(celix_framework_t* framework) {
+/**
+ * @brief Handle all events in the event queue.
+ * @return true if at least one event is handled.
+ */
+static inline bool fw_handleEvents(celix_framework_t* framework) {
     celixThreadMutex_lock(&framework->dispatcher.mutex);
     int size = framework->dispatcher.eventQueueSize + celix_arrayList_size(framework->dispatcher.dynamicEventQueue);
     celixThreadMutex_unlock(&framework->dispatcher.mutex);
+    bool handled = size > 0;
 
     while (size > 0) {
         celix_framework_event_t* topEvent = fw_topEventFromQueue(framework);
+        bool timed = __atomic_load_n(&framework->dispatcher.metrics.enabled, __ATOMIC_RELAXED);
+        struct timespec handleTime = {0, 0};
+        if (timed) {
+            handleTime = celix_gettime(CLOCK_MONOTONIC);
+            if (topEvent->enqueueTime.tv_sec != 0 || topEvent->enqueueTime.tv_nsec != 0) {
+                //note events added before the metrics were enabled have no enqueue time
+                celix_metricsHistogram_record(&framework->dispatcher.metrics.eventQueueLatency,
+                                              (uint64_t)(celix_difftime(&topEvent->enqueueTime, &handleTime) * 1e9));
+            }
+        }
         fw_handleEventRequest(framework, topEvent);
+        if (timed) {
+            celix_metricsHistogram_recordSince(&framework->dispatcher.metrics.eventProcessingTime, &handleTime);
+        }
+        __atomic_add_fetch(&framework->dispatcher.metrics.processedEvents, 1, __ATOMIC_RELAXED);
         bool dynamicallyAllocatedEvent = fw_removeTopEventFromQueue(framework);
 
         if (topEvent->bndEntry != NULL) {
@@ -1346,6 +1467,7 @@ static inline void fw_handleEvents(celix_framework_t* framework) {
         size = framework->dispatcher.eventQueueSize + celix_arrayList_size(framework->dispatcher.dynamicEventQueue);
         celixThreadMutex_unlock(&framework->dispatcher.mutex);
     }
+    return handled;
 }
 
 /**
@@ -1377,6 +1499,9 @@ static void celix_framework_processScheduledEvents(celix_framework_t* fw) {
                 break;
             }
         }
+        __atomic_store_n(&fw->dispatcher.metrics.nrOfScheduledEvents,
+                         (int)celix_longHashMap_size(fw->dispatcher.scheduledEvents),
+                         __ATOMIC_RELAXED);
         celixThreadMutex_unlock(&fw->dispatcher.mutex);
 
         if (callEvent != NULL) {
@@ -1480,9 +1605,49 @@ static bool requiresScheduledEventsProcessing(celix_framework_t* framework) {
     return eventProcessingRequired;
 }
 
+/**
+ * @brief Call the idle callbacks if the event queue is empty and events have been handled or an idle notification is
+ * pending.
+ */
+static void celix_framework_callIdleCallbacks(celix_framework_t* fw, bool eventsHandled) {
+    celixThreadMutex_lock(&fw->dispatcher.mutex);
+    bool callIdleCallbacks = (eventsHandled || fw->dispatcher.idleNotificationPending) &&
+                             celix_framework_eventQueueSize(fw) == 0;
+    if (!callIdleCallbacks) {
+        celixThreadMutex_unlock(&fw->dispatcher.mutex);
+        return;
+    }
+    fw->dispatcher.idleNotificationPending = false;
+    fw->dispatcher.idleCallbacksInProgress = true;
+    for (int i = 0; i < celix_arrayList_size(fw->dispatcher.idleCallbacks); ++i) {
+        celix_framework_idle_callback_entry_t* entry = celix_arrayList_get(fw->dispatcher.idleCallbacks, i);
+        if (entry->removed) {
+            continue;
+        }
+        celixThreadMutex_unlock(&fw->dispatcher.mutex);
+        entry->idleCallback(entry->callbackData);
+        celixThreadMutex_lock(&fw->dispatcher.mutex);
+    }
+    //cleanup idle callbacks which are removed by an idle callback
+    int i = 0;
+    while (i < celix_arrayList_size(fw->dispatcher.idleCallbacks)) {
+        celix_framework_idle_callback_entry_t* entry = celix_arrayList_get(fw->dispatcher.idleCallbacks, i);
+        if (entry->removed) {
+            celix_arrayList_removeAt(fw->dispatcher.idleCallbacks, i);
+            free(entry);
+        } else {
+            ++i;
+        }
+    }
+    fw->dispatcher.idleCallbacksInProgress = false;
+    celixThreadCondition_broadcast(&fw->dispatcher.cond); //notify that the idle callbacks are not in use anymore
+    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+}
+
 static void celix_framework_waitForNextEvent(celix_framework_t* fw, struct timespec nextDeadline) {
     celixThreadMutex_lock(&fw->dispatcher.mutex);
-    if (celix_framework_eventQueueSize(fw) == 0 && !requiresScheduledEventsProcessing(fw) && fw->dispatcher.active) {
+    if (celix_framework_eventQueueSize(fw) == 0 && !requiresScheduledEventsProcessing(fw) &&
+        !fw->dispatcher.idleNotificationPending && fw->dispatcher.active) {
         celixThreadCondition_waitUntil(&fw->dispatcher.cond, &fw->dispatcher.mutex, &nextDeadline);
         // note failing through to fw_eventDispatcher even if timeout is not reached, the fw_eventDispatcher
         // will call this again after processing the events and scheduled events.
@@ -1498,8 +1663,9 @@ static void *fw_eventDispatcher(void *fw) {
     celixThreadMutex_unlock(&framework->dispatcher.mutex);
 
     while (active) {
-        fw_handleEvents(framework);
+        bool eventsHandled = fw_handleEvents(framework);
         celix_framework_processScheduledEvents(framework);
+        celix_framework_callIdleCallbacks(framework, eventsHandled);
         struct timespec nextDeadline = celix_framework_nextDeadlineForEventsWait(framework);
         celix_framework_waitForNextEvent(framework, nextDeadline);
 
@@ -2550,6 +2716,9 @@ long celix_framework_scheduleEvent(celix_framework_t* fw,
 
     celixThreadMutex_lock(&fw->dispatcher.mutex);
     celix_longHashMap_put(fw->dispatcher.scheduledEvents, id, event);
+    __atomic_store_n(&fw->dispatcher.metrics.nrOfScheduledEvents,
+                     (int)celix_longHashMap_size(fw->dispatcher.scheduledEvents),
+                     __ATOMIC_RELAXED);
     celixThreadCondition_broadcast(&fw->dispatcher.cond); //notify dispatcher thread for newly added scheduled event
     celixThreadMutex_unlock(&fw->dispatcher.mutex);
 
@@ -2631,6 +2800,202 @@ bool celix_framework_removeScheduledEvent(celix_framework_t* fw,
     return true;
 }
 
+long celix_framework_addEventQueueIdleCallback(celix_framework_t* fw,
+                                               long bndId,
+                                               void* callbackData,
+                                               void (*idleCallback)(void* callbackData)) {
+    if (idleCallback == NULL) {
+        fw_log(fw->logger, CELIX_LOG_LEVEL_ERROR, "Cannot add idle callback for bundle id %li. No callback provided.", bndId);
+        return -1L;
+    }
+    celix_framework_idle_callback_entry_t* entry = calloc(1, sizeof(*entry));
+    if (entry == NULL) {
+        fw_log(fw->logger, CELIX_LOG_LEVEL_ERROR, "Cannot add idle callback for bundle id %li. ENOMEM.", bndId);
+        return -1L;
+    }
+    entry->bndId = bndId;
+    entry->callbackData = callbackData;
+    entry->idleCallback = idleCallback;
+
+    celixThreadMutex_lock(&fw->dispatcher.mutex);
+    entry->id = fw->dispatcher.nextIdleCallbackId++;
+    celix_status_t status = celix_arrayList_add(fw->dispatcher.idleCallbacks, entry);
+    if (status == CELIX_SUCCESS) {
+        fw->dispatcher.idleNotificationPending = true;
+        celixThreadCondition_broadcast(&fw->dispatcher.cond); //notify dispatcher thread for newly added idle callback
+    }
+    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+
+    if (status != CELIX_SUCCESS) {
+        fw_log(fw->logger, CELIX_LOG_LEVEL_ERROR, "Cannot add idle callback for bundle id %li.", bndId);
+        free(entry);
+        return -1L;
+    }
+    return entry->id;
+}
+
+/**
+ * @brief Remove the idle callback at the provided index.
+ *
+ * If the idle callbacks are in progress on the Celix event thread, the entry is only marked as removed. Otherwise
+ * this function waits until the idle callbacks are not in use anymore.
+ */
+static void celix_framework_removeIdleCallbackAt(celix_framework_t* fw, int index) {
+    //precondition fw->dispatcher.mutex locked
+    celix_framework_idle_callback_entry_t* entry = celix_arrayList_get(fw->dispatcher.idleCallbacks, index);
+    if (fw->dispatcher.idleCallbacksInProgress && celix_framework_isCurrentThreadTheEventLoop(fw)) {
+        entry->removed = true;
+        return;
+    }
+    while (fw->dispatcher.idleCallbacksInProgress) {
+        celixThreadCondition_wait(&fw->dispatcher.cond, &fw->dispatcher.mutex);
+    }
+    celix_arrayList_remove(fw->dispatcher.idleCallbacks, entry); //note index can be changed after waiting
+    free(entry);
+}
+
+bool celix_framework_removeEventQueueIdleCallback(celix_framework_t* fw, long idleCallbackId) {
+    if (idleCallbackId < 0) {
+        return false; // silently ignore
+    }
+    bool found = false;
+    celixThreadMutex_lock(&fw->dispatcher.mutex);
+    for (int i = 0; i < celix_arrayList_size(fw->dispatcher.idleCallbacks); ++i) {
+        celix_framework_idle_callback_entry_t* entry = celix_arrayList_get(fw->dispatcher.idleCallbacks, i);
+        if (entry->id == idleCallbackId && !entry->removed) {
+            celix_framework_removeIdleCallbackAt(fw, i);
+            found = true;
+            break;
+        }
+    }
+    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+
+    if (!found) {
+        fw_log(fw->logger, CELIX_LOG_LEVEL_ERROR, "Cannot remove idle callback with id %li. Not found.", idleCallbackId);
+    }
+    return found;
+}
+
+void celix_framework_cleanupEventQueueIdleCallbacks(celix_framework_t* fw, long bndId) {
+    bool removed;
+    do {
+        removed = false;
+        celixThreadMutex_lock(&fw->dispatcher.mutex);
+        for (int i = 0; i < celix_arrayList_size(fw->dispatcher.idleCallbacks); ++i) {
+            celix_framework_idle_callback_entry_t* entry = celix_arrayList_get(fw->dispatcher.idleCallbacks, i);
+            if (entry->bndId == bndId && !entry->removed) {
+                fw_log(fw->logger,
+                       CELIX_LOG_LEVEL_WARNING,
+                       "Removing dangling idle callback (id=%li) for bundle id %li. This idle callback should have "
+                       "been removed up by the bundle.",
+                       entry->id,
+                       bndId);
+                celix_framework_removeIdleCallbackAt(fw, i);
+                removed = true;
+                break;
+            }
+        }
+        celixThreadMutex_unlock(&fw->dispatcher.mutex);
+    } while (removed);
+}
+
+void celix_framework_updateNrOfInactiveComponents(celix_framework_t* fw, long delta) {
+    __atomic_add_fetch(&fw->nrOfInactiveComponents, delta, __ATOMIC_ACQ_REL);
+}
+
+void celix_framework_increaseNrOfBatchedComponentResumes(celix_framework_t* fw) {
+    __atomic_add_fetch(&fw->nrOfBatchedComponentResumes, 1, __ATOMIC_RELAXED);
+}
+
+size_t celix_framework_nrOfInactiveComponents(celix_framework_t* fw) {
+    long nr = __atomic_load_n(&fw->nrOfInactiveComponents, __ATOMIC_ACQUIRE);
+    return nr > 0 ? (size_t)nr : 0;
+}
+
+void celix_framework_setMetricsEnabled(celix_framework_t* fw, bool enabled) {
+    __atomic_store_n(&fw->dispatcher.metrics.enabled, enabled, __ATOMIC_RELAXED);
+}
+
+celix_status_t celix_framework_collectMetrics(void* handle, void* callbackHandle, celix_metrics_callback_fp callback) {
+    celix_framework_t* fw = handle;
+
+    int queueSize = __atomic_load_n(&fw->dispatcher.metrics.eventQueueSize, __ATOMIC_RELAXED);
+    int maxQueueSize = __atomic_load_n(&fw->dispatcher.metrics.maxEventQueueSize, __ATOMIC_RELAXED);
+    int nrOfScheduledEvents = __atomic_load_n(&fw->dispatcher.metrics.nrOfScheduledEvents, __ATOMIC_RELAXED);
+
+    celix_metric_t metric = {0};
+    metric.name = "celix_framework_event_queue_size";
+    metric.help = "Nr of events in the framework event queue.";
+    metric.type = CELIX_METRIC_TYPE_GAUGE;
+    metric.value = queueSize;
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_event_queue_max_size";
+    metric.help = "Largest observed size of the framework event queue.";
+    metric.value = maxQueueSize;
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_scheduled_events";
+    metric.help = "Nr of scheduled events.";
+    metric.value = nrOfScheduledEvents;
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_events_processed_total";
+    metric.help = "Total nr of events handled by the framework event thread.";
+    metric.type = CELIX_METRIC_TYPE_COUNTER;
+    metric.value = (double)__atomic_load_n(&fw->dispatcher.metrics.processedEvents, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_event_queue_latency_seconds";
+    metric.help = "Time between adding an event to the framework event queue and handling it.";
+    metric.type = CELIX_METRIC_TYPE_HISTOGRAM;
+    metric.histogram = &fw->dispatcher.metrics.eventQueueLatency;
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_event_processing_seconds";
+    metric.help = "Time needed to handle a framework event.";
+    metric.histogram = &fw->dispatcher.metrics.eventProcessingTime;
+    callback(callbackHandle, &metric);
+    metric.histogram = NULL;
+
+    celix_serviceRegistry_collectMetrics(fw->registry, callbackHandle, callback);
+
+    metric.name = "celix_framework_open_service_trackers";
+    metric.help = "Nr of open service trackers.";
+    metric.type = CELIX_METRIC_TYPE_GAUGE;
+    metric.value = (double)__atomic_load_n(&fw->trackerMetrics.openServiceTrackers, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_service_tracker_events_total";
+    metric.help = "Total nr of service events handled by service trackers.";
+    metric.type = CELIX_METRIC_TYPE_COUNTER;
+    metric.value = (double)__atomic_load_n(&fw->trackerMetrics.serviceTrackerEvents, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_inactive_components";
+    metric.help = "Nr of enabled dependency manager components which are not active.";
+    metric.type = CELIX_METRIC_TYPE_GAUGE;
+    metric.value = (double)celix_framework_nrOfInactiveComponents(fw);
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_deferred_calls_total";
+    metric.help = "Total nr of calls deferred to the end of an event, e.g. batched dm component state evaluations.";
+    metric.type = CELIX_METRIC_TYPE_COUNTER;
+    metric.value = (double)__atomic_load_n(&fw->dispatcher.nrOfDeferredCalls, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_deferred_calls_coalesced_total";
+    metric.help = "Total nr of deferred calls avoided, because a call for the same target was already deferred.";
+    metric.value = (double)__atomic_load_n(&fw->dispatcher.nrOfCoalescedDeferredCalls, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_dm_batched_component_resumes_total";
+    metric.help = "Total nr of dm component suspend/resume cycles avoided by batching service dependency updates.";
+    metric.value = (double)__atomic_load_n(&fw->nrOfBatchedComponentResumes, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+    return CELIX_SUCCESS;
+}
+
 void celix_framework_setLogCallback(celix_framework_t* fw, void* logHandle, void (*logFunction)(void* handle, celix_log_level_e level, const char* file, const char *function, int line, const char *format, va_list formatArgs)) {
     celix_frameworkLogger_setLogCallback(fw->logger, logHandle, logFunction);
 }
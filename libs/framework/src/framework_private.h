@@ -37,6 +37,8 @@
 #include "bundle_context.h"
 #include "celix_bundle_cache.h"
 #include "celix_log.h"
+#include "celix_metrics.h"
+#include "celix_metrics_provider.h"
 #include "celix_threads.h"
 #include "service_registry.h"
 #include <stdbool.h>
@@ -109,7 +111,7 @@ struct celix_framework_event {
     void *genericProcessData;
     void (*genericProcess)(void*);
 
-
+    struct timespec enqueueTime; //CLOCK_MONOTONIC time the event was added to the event queue
 };
 
 typedef struct celix_framework_event celix_framework_event_t;
@@ -122,6 +124,19 @@ enum celix_bundle_lifecycle_command {
     CELIX_BUNDLE_LIFECYCLE_UNLOAD
 };
 
+typedef struct celix_framework_idle_callback_entry {
+    long id;
+    long bndId;
+    void* callbackData;
+    void (*idleCallback)(void* callbackData);
+    bool removed; //true if removed during a idle callback iteration, entry is freed after the iteration
+} celix_framework_idle_callback_entry_t;
+
+typedef struct celix_framework_deferred_call {
+    void* data;
+    void (*callback)(void* data);
+} celix_framework_deferred_call_t;
+
 typedef struct celix_framework_bundle_lifecycle_handler {
     celix_framework_t* framework;
     celix_framework_bundle_entry_t* bndEntry;
@@ -142,6 +157,8 @@ struct celix_framework {
     celix_thread_mutex_t bundleListenerLock;
 
     long currentBundleId; //atomic
+    long nrOfInactiveComponents; //atomic. Nr of enabled dm components (of all bundles) which are not active
+    unsigned long nrOfBatchedComponentResumes; //atomic. Nr of dm component suspend/resume cycles avoided by batching
     celix_service_registry_t *registry;
     celix_bundle_cache_t* cache;
 
@@ -187,11 +204,38 @@ struct celix_framework {
             int nbUnregister; // number of pending async de-registration
             int nbEvent; // number of pending generic events
         } stats;
+        struct {
+            bool enabled; //atomic. Whether the event queue latency and processing time are recorded
+            unsigned long processedEvents; //atomic. Nr of handled events
+            int eventQueueSize; //atomic, written with mutex locked. The static + dynamic event queue size
+            int maxEventQueueSize; //atomic, written with mutex locked. High-water mark of the event queue size
+            int nrOfScheduledEvents; //atomic, written with mutex locked. Nr of entries in scheduledEvents
+            celix_metrics_histogram_t eventQueueLatency; //time between adding an event to the queue and handling it
+            celix_metrics_histogram_t eventProcessingTime; //time needed to handle an event
+        } metrics;
         celix_long_hash_map_t *scheduledEvents; //key = scheduled event id, entry = celix_framework_scheduled_event_t*. Used for scheduled events
+
+        //idle callbacks, called when the event queue becomes empty
+        long nextIdleCallbackId;
+        celix_array_list_t* idleCallbacks; //entry = celix_framework_idle_callback_entry_t*
+        bool idleCallbacksInProgress; //true if the event thread is calling the idle callbacks
+        bool idleNotificationPending; //true if the idle callbacks should be called, even if no events are processed
+
+        //deferred calls, called after the handling of the current event. Only accessed on the event thread.
+        bool handlingEvent; //true if the event thread is handling an event (and calls can be deferred)
+        celix_array_list_t* deferredCalls; //entry = celix_framework_deferred_call_t*, in order of deferral
+        celix_long_hash_map_t* deferredCallsByData; //key = (intptr_t)data, value = celix_framework_deferred_call_t*
+        unsigned long nrOfDeferredCalls; //atomic. Nr of deferred calls
+        unsigned long nrOfCoalescedDeferredCalls; //atomic. Nr of deferred calls coalesced with an already deferred call
     } dispatcher;
 
     celix_framework_logger_t* logger;
 
+    struct {
+        long openServiceTrackers; //atomic
+        unsigned long serviceTrackerEvents; //atomic. Nr of service events handled by service trackers
+    } trackerMetrics;
+
     struct {
         celix_thread_cond_t cond;
         celix_thread_mutex_t mutex; //protects below
@@ -523,12 +567,105 @@ bool celix_framework_removeScheduledEvent(celix_framework_t* fw, bool async, boo
  */
 void celix_framework_cleanupScheduledEvents(celix_framework_t* fw, long bndId);
 
+/**
+ * @brief Add an idle callback to the Celix framework.
+ *
+ * The idle callback is called on the Celix event thread every time the event queue becomes empty after events have
+ * been processed, and once after the idle callback is added.
+ *
+ * @param[in] fw The Celix framework
+ * @param[in] bndId The bundle id to add the idle callback for.
+ * @param[in] callbackData The data to pass to the idle callback.
+ * @param[in] idleCallback The idle callback.
+ * @return The idle callback id or < 0 if the idle callback could not be added.
+ */
+long celix_framework_addEventQueueIdleCallback(celix_framework_t* fw,
+                                               long bndId,
+                                               void* callbackData,
+                                               void (*idleCallback)(void* callbackData));
+
+/**
+ * @brief Remove an idle callback.
+ *
+ * If called outside the Celix event thread, this function waits until the idle callback is not in use anymore.
+ * Silently ignored if the idle callback id < 0.
+ *
+ * @param[in] fw The Celix framework
+ * @param[in] idleCallbackId The idle callback id to remove.
+ * @return true if the idle callback is removed, false if the idle callback id is not known.
+ */
+bool celix_framework_removeEventQueueIdleCallback(celix_framework_t* fw, long idleCallbackId);
+
+/**
+ * @brief Remove all idle callbacks for the provided bundle id and logs a warning for every removed idle callback.
+ * @param[in] fw The Celix framework.
+ * @param[in] bndId The bundle id to remove the idle callbacks for.
+ */
+void celix_framework_cleanupEventQueueIdleCallbacks(celix_framework_t* fw, long bndId);
+
+/**
+ * @brief Update the framework wide count of enabled dm components which are not active.
+ * @param[in] fw The Celix framework.
+ * @param[in] delta The change in inactive components (1 or -1).
+ */
+void celix_framework_updateNrOfInactiveComponents(celix_framework_t* fw, long delta);
+
+/**
+ * @brief Returns the framework wide count of enabled dm components which are not active.
+ */
+size_t celix_framework_nrOfInactiveComponents(celix_framework_t* fw);
+
+/**
+ * @brief Increase the framework wide count of dm component suspend/resume cycles avoided by batching.
+ */
+void celix_framework_increaseNrOfBatchedComponentResumes(celix_framework_t* fw);
+
+/**
+ * @brief Defer a call to the end of the handling of the current event.
+ *
+ * If the current thread is the event thread and the event thread is handling an event, the callback is called after
+ * the event is handled, but before the event is marked as done (i.e. before threads waiting for the event are
+ * released). Deferring a call for data which already has a deferred call is a no-op, so multiple updates for the same
+ * data during the handling of a single event are coalesced into a single call.
+ * Calls deferred by a deferred call are called after the deferred call in the same event.
+ *
+ * @param[in] fw The Celix framework.
+ * @param[in] data The data for the callback, also used to coalesce deferred calls.
+ * @param[in] callback The callback to call.
+ * @return true if the call is deferred, false if the call cannot be deferred (not called on the event thread or
+ * the event thread is not handling an event) and the caller should handle the call directly.
+ */
+bool celix_framework_deferUntilEventHandled(celix_framework_t* fw, void* data, void (*callback)(void* data));
+
+/**
+ * @brief Cancel a deferred call for the provided data, if any.
+ *
+ * Should be called before the data is destroyed.
+ */
+void celix_framework_cancelDeferredCall(celix_framework_t* fw, void* data);
+
 
 /**
  * @brief Start the celix framework shutdown sequence on a separate thread and return immediately.
  */
 void celix_framework_shutdownAsync(celix_framework_t* framework);
 
+/**
+ * @brief Collect the framework metrics (event dispatcher, service registry and service trackers).
+ *
+ * Used for the framework metrics provider service. The metrics are read from atomic counters, so no framework locks
+ * are taken.
+ */
+celix_status_t celix_framework_collectMetrics(void* handle, void* callbackHandle, celix_metrics_callback_fp callback);
+
+/**
+ * @brief Enables or disables the recording of the event queue latency and event processing time metrics.
+ *
+ * Recording the timings costs clock reads for every event, so they are only recorded if the framework metrics
+ * provider is registered.
+ */
+void celix_framework_setMetricsEnabled(celix_framework_t* fw, bool enabled);
+
 #ifdef __cplusplus
 }
 #endif
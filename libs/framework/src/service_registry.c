@@ -27,6 +27,7 @@
 #include "service_registration_private.h"
 #include "listener_hook_service.h"
 #include "celix_constants.h"
+#include "celix_lock_profiling.h"
 #include "celix_stdlib_cleanup.h"
 #include "celix_version_range.h"
 #include "service_reference_private.h"
@@ -50,7 +51,11 @@ static void celix_decreaseCountHook(celix_service_registry_listener_hook_entry_t
 
 static void celix_increaseCountServiceListener(celix_service_registry_service_listener_entry_t *entry);
 static void celix_decreaseCountServiceListener(celix_service_registry_service_listener_entry_t *entry);
-static void celix_waitAndDestroyServiceListener(celix_service_registry_service_listener_entry_t *entry);
+static void celix_waitAndDestroyServiceListener(celix_service_registry_t *registry, celix_service_registry_service_listener_entry_t *entry);
+
+static celix_service_registry_shared_filter_t* celix_serviceRegistry_acquireSharedFilter(celix_service_registry_t* registry, const char* filterStr);
+static void celix_serviceRegistry_releaseSharedFilter(celix_service_registry_t* registry, celix_service_registry_shared_filter_t* sharedFilter);
+static bool celix_serviceRegistry_matchSharedFilter(celix_service_registry_shared_filter_t* sharedFilter, service_registration_pt registration);
 
 static void celix_increasePendingRegisteredEvent(celix_service_registry_t *registry, long svcId);
 static void celix_decreasePendingRegisteredEvent(celix_service_registry_t *registry, long svcId);
@@ -74,15 +79,22 @@ celix_service_registry_t* celix_serviceRegistry_create(framework_pt framework) {
 
     celixThreadMutex_create(&reg->pendingRegisterEvents.mutex, NULL);
     celixThreadCondition_init(&reg->pendingRegisterEvents.cond, NULL);
-    celixThreadRwlock_create(&reg->lock, NULL);
+    celixThreadRbRwlock_create(&reg->lock);
+    celix_lockProfiling_setName(&reg->lock, "celix::service_registry");
+    celix_lockProfiling_setName(&reg->pendingRegisterEvents.mutex, "celix::service_registry::pending_events");
     reg->pendingRegisterEvents.map = hashMap_create(NULL, NULL, NULL, NULL);
 
+    celixThreadMutex_create(&reg->sharedFilters.mutex, NULL);
+    celix_lockProfiling_setName(&reg->sharedFilters.mutex, "celix::service_registry::shared_filters");
+    celix_string_hash_map_create_options_t sharedFiltersOpts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    sharedFiltersOpts.storeKeysWeakly = true; //key is the filter string of the shared filter
+    reg->sharedFilters.map = celix_stringHashMap_createWithOptions(&sharedFiltersOpts);
 
 	return reg;
 }
 
 void celix_serviceRegistry_destroy(celix_service_registry_t* registry) {
-    celixThreadRwlock_destroy(&registry->lock);
+    celixThreadRbRwlock_destroy(&registry->lock);
 
     //remove service listeners
     int size = celix_arrayList_size(registry->serviceListeners);
@@ -92,10 +104,23 @@ void celix_serviceRegistry_destroy(celix_service_registry_t* registry) {
     for (int i = 0; i < size; ++i) {
         celix_service_registry_service_listener_entry_t *entry = celix_arrayList_get(registry->serviceListeners, i);
         celix_decreaseCountServiceListener(entry);
-        celix_waitAndDestroyServiceListener(entry);
+        celix_waitAndDestroyServiceListener(registry, entry);
     }
     celix_arrayList_destroy(registry->serviceListeners);
 
+    //destroy shared filters, all shared filters should be released at this point
+    size = (int)celix_stringHashMap_size(registry->sharedFilters.map);
+    if (size > 0) {
+        fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "%i dangling shared filters\n", size);
+    }
+    CELIX_STRING_HASH_MAP_ITERATE(registry->sharedFilters.map, filterIter) {
+        celix_service_registry_shared_filter_t* sharedFilter = filterIter.value.ptrValue;
+        celix_filter_destroy(sharedFilter->filter);
+        free(sharedFilter);
+    }
+    celix_stringHashMap_destroy(registry->sharedFilters.map);
+    celixThreadMutex_destroy(&registry->sharedFilters.mutex);
+
     //destroy service registration map
     size = hashMap_size(registry->serviceRegistrations);
     if (size > 0) {
@@ -144,7 +169,7 @@ void celix_serviceRegistry_destroy(celix_service_registry_t* registry) {
 celix_status_t serviceRegistry_getRegisteredServices(service_registry_pt registry, bundle_pt bundle, celix_array_list_t** services) {
     celix_status_t status = CELIX_SUCCESS;
 
-    celixThreadRwlock_writeLock(&registry->lock);
+    celixThreadRbRwlock_writeLock(&registry->lock);
 
     celix_array_list_t* regs = (celix_array_list_t*) hashMap_get(registry->serviceRegistrations, bundle);
     if (regs != NULL) {
@@ -162,7 +187,7 @@ celix_status_t serviceRegistry_getRegisteredServices(service_registry_pt registr
         }
     }
 
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     framework_logIfError(registry->framework->logger, status, NULL, "Cannot get registered services");
 
@@ -200,7 +225,7 @@ static celix_status_t serviceRegistry_registerServiceInternal(service_registry_p
         serviceRegistry_addHooks(registry, serviceName, serviceObject, *registration);
     }
 
-	celixThreadRwlock_writeLock(&registry->lock);
+	celixThreadRbRwlock_writeLock(&registry->lock);
 	regs = (celix_array_list_t*) hashMap_get(registry->serviceRegistrations, bundle);
 	if (regs == NULL) {
 		regs = celix_arrayList_create();
@@ -210,7 +235,9 @@ static celix_status_t serviceRegistry_registerServiceInternal(service_registry_p
 
     //update pending register event
     celix_increasePendingRegisteredEvent(registry, svcId);
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
+    __atomic_add_fetch(&registry->metrics.registeredServices, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&registry->metrics.registrationsTotal, 1, __ATOMIC_RELAXED);
 
 
     //NOTE there is a race condition with celix_serviceRegistry_addServiceListener, as result
@@ -242,7 +269,7 @@ static celix_status_t serviceRegistry_unregisterService(service_registry_pt regi
         serviceRegistry_removeHook(registry, registration);
     }
 
-    celixThreadRwlock_writeLock(&registry->lock);
+    celixThreadRbRwlock_writeLock(&registry->lock);
     regs = (celix_array_list_t*)hashMap_get(registry->serviceRegistrations, bundle);
     if (regs != NULL) {
         celix_arrayList_remove(regs, registration);
@@ -252,14 +279,16 @@ static celix_status_t serviceRegistry_unregisterService(service_registry_pt regi
             hashMap_remove(registry->serviceRegistrations, bundle);
         }
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
+    __atomic_sub_fetch(&registry->metrics.registeredServices, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&registry->metrics.unregistrationsTotal, 1, __ATOMIC_RELAXED);
 
     // check and wait for pending register events
     celix_waitForPendingRegisteredEvents(registry, svcId);
 
     celix_serviceRegistry_serviceChanged(registry, OSGI_FRAMEWORK_SERVICE_EVENT_UNREGISTERING, registration);
 
-    celixThreadRwlock_readLock(&registry->lock);
+    celixThreadRbRwlock_readLock(&registry->lock);
     // invalidate service references
     hash_map_iterator_pt iter = hashMapIterator_create(registry->serviceReferences);
     while (hashMapIterator_hasNext(iter)) {
@@ -271,7 +300,7 @@ static celix_status_t serviceRegistry_unregisterService(service_registry_pt regi
     }
     hashMapIterator_destroy(iter);
     serviceRegistration_invalidate(registration);
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
     serviceRegistration_release(registration);
 
     return CELIX_SUCCESS;
@@ -281,9 +310,9 @@ celix_status_t serviceRegistry_getServiceReference(service_registry_pt registry,
                                                    service_registration_pt registration, service_reference_pt *out) {
 	celix_status_t status = CELIX_SUCCESS;
 
-	if (celixThreadRwlock_writeLock(&registry->lock) == CELIX_SUCCESS) {
+	if (celixThreadRbRwlock_writeLock(&registry->lock) == CELIX_SUCCESS) {
 	    status = serviceRegistry_getServiceReference_internal(registry, owner, registration, out);
-	    celixThreadRwlock_unlock(&registry->lock);
+	    celixThreadRbRwlock_unlock(&registry->lock);
 	}
 
 	return status;
@@ -338,7 +367,7 @@ celix_status_t serviceRegistry_getServiceReferences(service_registry_pt registry
     }
 
     celix_status_t status = CELIX_SUCCESS;
-    celixThreadRwlock_readLock(&registry->lock);
+    celixThreadRbRwlock_readLock(&registry->lock);
     hash_map_iterator_t iterator = hashMapIterator_construct(registry->serviceRegistrations);
     while (status == CELIX_SUCCESS && hashMapIterator_hasNext(&iterator)) {
         celix_array_list_t* regs = hashMapIterator_nextValue(&iterator);
@@ -375,7 +404,7 @@ celix_status_t serviceRegistry_getServiceReferences(service_registry_pt registry
             }
         }
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     if (status == CELIX_SUCCESS) {
         unsigned int i;
@@ -412,7 +441,7 @@ static bool serviceRegistry_tryRemoveServiceReference(service_registry_pt regist
     size_t refCount = 0;
     size_t usageCount = 0;
     service_reference_pt ref = NULL;
-    celixThreadRwlock_writeLock(&registry->lock);
+    celixThreadRbRwlock_writeLock(&registry->lock);
     serviceReference_getReferenceCount(reference, &refCount);
     if (refCount == 0) {
         serviceReference_getUsageCount(reference, &usageCount);
@@ -450,7 +479,7 @@ static bool serviceRegistry_tryRemoveServiceReference(service_registry_pt regist
             }
         }
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
     return refCount == 0 && ref != NULL;
 
 }
@@ -488,7 +517,7 @@ static void serviceRegistry_logWarningServiceReferenceUsageCount(service_registr
 celix_status_t serviceRegistry_clearReferencesFor(service_registry_pt registry, bundle_pt bundle) {
     celix_status_t status = CELIX_SUCCESS;
 
-    celixThreadRwlock_writeLock(&registry->lock);
+    celixThreadRbRwlock_writeLock(&registry->lock);
 
     hash_map_pt refsMap = hashMap_remove(registry->serviceReferences, bundle);
     if (refsMap != NULL) {
@@ -511,7 +540,7 @@ celix_status_t serviceRegistry_clearReferencesFor(service_registry_pt registry,
         hashMap_destroy(refsMap, false, false);
     }
 
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     return status;
 }
@@ -521,7 +550,7 @@ serviceRegistry_getServicesInUse(service_registry_pt registry, bundle_pt bundle,
     celix_array_list_t* result = celix_arrayList_create();
 
     // LOCK
-    celixThreadRwlock_readLock(&registry->lock);
+    celixThreadRbRwlock_readLock(&registry->lock);
 
     hash_map_pt refsMap = hashMap_get(registry->serviceReferences, bundle);
 
@@ -535,7 +564,7 @@ serviceRegistry_getServicesInUse(service_registry_pt registry, bundle_pt bundle,
     }
 
     // UNLOCK
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     *out = result;
 
@@ -555,7 +584,7 @@ static celix_status_t serviceRegistry_addHooks(service_registry_pt registry, con
     celix_arrayList_add(infos, &info);
     listeners = celix_arrayList_create();
 
-    celixThreadRwlock_writeLock(&registry->lock);
+    celixThreadRbRwlock_writeLock(&registry->lock);
     long svcId = serviceRegistration_getServiceId(registration);
     entry = celix_createHookEntry(svcId, (celix_listener_hook_service_t*)serviceObject);
     celix_increaseCountHook(entry);
@@ -566,12 +595,12 @@ static celix_status_t serviceRegistry_addHooks(service_registry_pt registry, con
         celix_increaseCountServiceListener(listenerEntry);
         celix_arrayList_add(listeners, listenerEntry);
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     for (int i = 0; i < celix_arrayList_size(listeners); ++i) {
         celix_service_registry_service_listener_entry_t *listenerEntry = celix_arrayList_get(listeners, i);
         bundle_getContext(listenerEntry->bundle, &info.context);
-        info.filter = celix_filter_getFilterString(listenerEntry->filter);
+        info.filter = listenerEntry->filter != NULL ? celix_filter_getFilterString(listenerEntry->filter->filter) : NULL;
         entry->hook->added(entry->hook->handle, infos);
         celix_decreaseCountServiceListener(listenerEntry);
     }
@@ -592,7 +621,7 @@ static celix_status_t serviceRegistry_removeHook(service_registry_pt registry, s
     celix_array_list_t* listeners = NULL;
     celix_service_registry_listener_hook_entry_t *removedEntry = NULL;
 
-    celixThreadRwlock_writeLock(&registry->lock);
+    celixThreadRbRwlock_writeLock(&registry->lock);
     for (int i = 0; i < celix_arrayList_size(registry->listenerHooks); ++i) {
         celix_service_registry_listener_hook_entry_t *visit = celix_arrayList_get(registry->listenerHooks, i);
         if (visit->svcId == svcId) {
@@ -612,13 +641,13 @@ static celix_status_t serviceRegistry_removeHook(service_registry_pt registry, s
             celix_arrayList_add(listeners, listenerEntry);
         }
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     if (removedEntry != NULL) {
         for (int i = 0; i < celix_arrayList_size(listeners); ++i) {
             celix_service_registry_service_listener_entry_t *listenerEntry = celix_arrayList_get(listeners, i);
             bundle_getContext(listenerEntry->bundle, &info.context);
-            info.filter = celix_filter_getFilterString(listenerEntry->filter);
+            info.filter = listenerEntry->filter != NULL ? celix_filter_getFilterString(listenerEntry->filter->filter) : NULL;
             removedEntry->hook->removed(removedEntry->hook->handle, infos);
             celix_decreaseCountServiceListener(listenerEntry);
         }
@@ -645,7 +674,7 @@ static void serviceRegistry_callHooksForListenerFilter(service_registry_pt regis
 
     celix_array_list_t *hookRegistrations = celix_arrayList_create();
 
-    celixThreadRwlock_readLock(&registry->lock);
+    celixThreadRbRwlock_readLock(&registry->lock);
     unsigned size = celix_arrayList_size(registry->listenerHooks);
     for (int i = 0; i < size; ++i) {
         celix_service_registry_listener_hook_entry_t* entry = celix_arrayList_get(registry->listenerHooks, i);
@@ -654,7 +683,7 @@ static void serviceRegistry_callHooksForListenerFilter(service_registry_pt regis
             celix_arrayList_add(hookRegistrations, entry);
         }
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     for (int i = 0; i < celix_arrayList_size(hookRegistrations); ++i) {
         celix_service_registry_listener_hook_entry_t* entry = celix_arrayList_get(hookRegistrations, i);
@@ -670,9 +699,9 @@ static void serviceRegistry_callHooksForListenerFilter(service_registry_pt regis
 }
 
 size_t serviceRegistry_nrOfHooks(service_registry_pt registry) {
-    celixThreadRwlock_readLock(&registry->lock);
+    celixThreadRbRwlock_readLock(&registry->lock);
     unsigned size = celix_arrayList_size(registry->listenerHooks);
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
     return (size_t) size;
 }
 
@@ -685,7 +714,7 @@ static celix_status_t serviceRegistry_getUsingBundles(service_registry_pt regist
         return CELIX_ENOMEM;
     }
 
-    celixThreadRwlock_readLock(&registry->lock);
+    celixThreadRbRwlock_readLock(&registry->lock);
     iter = hashMapIterator_create(registry->serviceReferences);
     while (hashMapIterator_hasNext(iter)) {
         hash_map_entry_pt entry = hashMapIterator_nextEntry(iter);
@@ -696,7 +725,7 @@ static celix_status_t serviceRegistry_getUsingBundles(service_registry_pt regist
         }
     }
     hashMapIterator_destroy(iter);
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     *out = bundles;
 
@@ -791,7 +820,7 @@ static void celix_decreaseCountServiceListener(celix_service_registry_service_li
     }
 }
 
-static inline void celix_waitAndDestroyServiceListener(celix_service_registry_service_listener_entry_t *entry) {
+static inline void celix_waitAndDestroyServiceListener(celix_service_registry_t *registry, celix_service_registry_service_listener_entry_t *entry) {
     celixThreadMutex_lock(&entry->mutex);
     while (entry->useCount != 0) {
         celixThreadCondition_wait(&entry->cond, &entry->mutex);
@@ -802,10 +831,105 @@ static inline void celix_waitAndDestroyServiceListener(celix_service_registry_se
     //destroy
     celixThreadMutex_destroy(&entry->mutex);
     celixThreadCondition_destroy(&entry->cond);
-    celix_filter_destroy(entry->filter);
+    celix_serviceRegistry_releaseSharedFilter(registry, entry->filter);
     free(entry);
 }
 
+/**
+ * Normalizes a filter string for the shared filters map. A NULL or empty filter is a match-all filter (see
+ * celix_filter_create) and leading and trailing whitespaces are ignored.
+ */
+static char* celix_serviceRegistry_normalizeFilterString(const char* filterStr) {
+    char* normalized = celix_utils_trim(filterStr != NULL ? filterStr : "");
+    if (normalized != NULL && normalized[0] == '\0') {
+        free(normalized);
+        normalized = celix_utils_strdup("(|)");
+    }
+    return normalized;
+}
+
+static celix_service_registry_shared_filter_t* celix_serviceRegistry_acquireSharedFilter(celix_service_registry_t* registry, const char* filterStr) {
+    celix_autofree char* normalized = celix_serviceRegistry_normalizeFilterString(filterStr);
+    if (normalized == NULL) {
+        return NULL;
+    }
+
+    celix_auto(celix_mutex_lock_guard_t) lck = celixMutexLockGuard_init(&registry->sharedFilters.mutex);
+    celix_service_registry_shared_filter_t* sharedFilter = celix_stringHashMap_get(registry->sharedFilters.map, normalized);
+    if (sharedFilter != NULL) {
+        sharedFilter->useCount += 1;
+        return sharedFilter;
+    }
+
+    celix_autoptr(celix_filter_t) filter = celix_filter_create(normalized);
+    if (filter == NULL) {
+        return NULL;
+    }
+    celix_autofree celix_service_registry_shared_filter_t* newSharedFilter = calloc(1, sizeof(*newSharedFilter));
+    if (newSharedFilter == NULL) {
+        return NULL;
+    }
+    newSharedFilter->filter = filter;
+    newSharedFilter->useCount = 1;
+    newSharedFilter->matchMemo = -1;
+    if (celix_stringHashMap_put(registry->sharedFilters.map, celix_filter_getFilterString(filter), newSharedFilter) != CELIX_SUCCESS) {
+        return NULL;
+    }
+    celix_steal_ptr(filter);
+    return celix_steal_ptr(newSharedFilter);
+}
+
+static void celix_serviceRegistry_releaseSharedFilter(celix_service_registry_t* registry, celix_service_registry_shared_filter_t* sharedFilter) {
+    if (sharedFilter == NULL) {
+        return;
+    }
+    celix_auto(celix_mutex_lock_guard_t) lck = celixMutexLockGuard_init(&registry->sharedFilters.mutex);
+    sharedFilter->useCount -= 1;
+    if (sharedFilter->useCount == 0) {
+        celix_stringHashMap_remove(registry->sharedFilters.map, celix_filter_getFilterString(sharedFilter->filter));
+        celix_filter_destroy(sharedFilter->filter);
+        free(sharedFilter);
+    }
+}
+
+static bool celix_serviceRegistry_matchSharedFilter(celix_service_registry_shared_filter_t* sharedFilter, service_registration_pt registration) {
+    if (sharedFilter == NULL) {
+        return true; //no filter -> match
+    }
+    long svcId = serviceRegistration_getServiceId(registration);
+    long memo = __atomic_load_n(&sharedFilter->matchMemo, __ATOMIC_ACQUIRE);
+    if (svcId >= 0 && memo >= 0 && (memo >> 1) == svcId) {
+        return (memo & 1) != 0;
+    }
+    celix_properties_t* props = NULL;
+    serviceRegistration_getProperties(registration, &props);
+    bool matched = celix_filter_match(sharedFilter->filter, props);
+    if (svcId >= 0) {
+        __atomic_store_n(&sharedFilter->matchMemo, (svcId << 1) | (matched ? 1 : 0), __ATOMIC_RELEASE);
+    }
+    return matched;
+}
+
+const celix_filter_t* celix_serviceRegistry_acquireFilter(celix_service_registry_t* registry, const char* filterStr) {
+    celix_service_registry_shared_filter_t* sharedFilter = celix_serviceRegistry_acquireSharedFilter(registry, filterStr);
+    return sharedFilter != NULL ? sharedFilter->filter : NULL;
+}
+
+void celix_serviceRegistry_releaseFilter(celix_service_registry_t* registry, const celix_filter_t* filter) {
+    if (filter == NULL) {
+        return;
+    }
+    celix_service_registry_shared_filter_t* sharedFilter = NULL;
+    celixThreadMutex_lock(&registry->sharedFilters.mutex);
+    sharedFilter = celix_stringHashMap_get(registry->sharedFilters.map, celix_filter_getFilterString(filter));
+    celixThreadMutex_unlock(&registry->sharedFilters.mutex);
+    if (sharedFilter == NULL || sharedFilter->filter != filter) {
+        fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "Cannot release filter '%s', filter is not a shared filter", celix_filter_getFilterString(filter));
+        return;
+    }
+    celix_serviceRegistry_releaseSharedFilter(registry, sharedFilter);
+}
+
 char* celix_serviceRegistry_createFilterFor(celix_service_registry_t* registry, const char* serviceName, const char* versionRangeStr, const char* additionalFilterIn) {
     char* filter = NULL;
 
@@ -861,30 +985,32 @@ static int celix_serviceRegistry_compareRegistrations(celix_array_list_entry_t a
     return celix_utils_compareServiceIdsAndRanking(servIdA, servRankingA, servIdB, servRankingB);
 }
 
-celix_array_list_t* celix_serviceRegistry_findServices(
-        celix_service_registry_t* registry,
-        const char* filterStr) {
-
-    celix_autoptr(celix_filter_t) filter = celix_filter_create(filterStr);
-    if (filter == NULL) {
-        celix_framework_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, __FUNCTION__, __BASE_FILE__, __LINE__,
-                      "Error incorrect filter.");
-        return NULL;
-    }
-
+/**
+ * Returns the ids of the services matching the shared filter or - if the shared filter is NULL - the filter, ordered
+ * by service ranking.
+ */
+static celix_array_list_t* celix_serviceRegistry_findMatchingServices(celix_service_registry_t* registry,
+                                                                      celix_service_registry_shared_filter_t* sharedFilter,
+                                                                      const celix_filter_t* filter) {
     celix_array_list_t *result = celix_arrayList_create();
     celix_array_list_t* matchedRegistrations = celix_arrayList_create();
 
-    celixThreadRwlock_readLock(&registry->lock);
+    celixThreadRbRwlock_readLock(&registry->lock);
 
     hash_map_iterator_t iter = hashMapIterator_construct(registry->serviceRegistrations);
     while (hashMapIterator_hasNext(&iter)) {
         celix_array_list_t *regs = hashMapIterator_nextValue(&iter);
         for (int i = 0; i < celix_arrayList_size(regs); ++i) {
             service_registration_t *reg = celix_arrayList_get(regs, i);
-            celix_properties_t* svcProps = NULL;
-            serviceRegistration_getProperties(reg, &svcProps);
-            if (svcProps != NULL && celix_filter_match(filter, svcProps)) {
+            bool matched;
+            if (sharedFilter != NULL) {
+                matched = celix_serviceRegistry_matchSharedFilter(sharedFilter, reg);
+            } else {
+                celix_properties_t* props = NULL;
+                serviceRegistration_getProperties(reg, &props);
+                matched = celix_filter_match(filter, props);
+            }
+            if (matched) {
                 celix_arrayList_add(matchedRegistrations, reg);
             }
         }
@@ -898,16 +1024,60 @@ celix_array_list_t* celix_serviceRegistry_findServices(
         service_registration_t* reg = celix_arrayList_get(matchedRegistrations, i);
         celix_arrayList_addLong(result, serviceRegistration_getServiceId(reg));
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     celix_arrayList_destroy(matchedRegistrations);
     return result;
 }
 
+celix_array_list_t* celix_serviceRegistry_findServices(
+        celix_service_registry_t* registry,
+        const char* filterStr) {
+
+    celix_service_registry_shared_filter_t* filter = celix_serviceRegistry_acquireSharedFilter(registry, filterStr);
+    if (filter == NULL) {
+        celix_framework_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, __FUNCTION__, __BASE_FILE__, __LINE__,
+                      "Error incorrect filter.");
+        return NULL;
+    }
+
+    celix_array_list_t* result = celix_serviceRegistry_findMatchingServices(registry, filter, NULL);
+    celix_serviceRegistry_releaseSharedFilter(registry, filter);
+    return result;
+}
+
+/**
+ * Retains and returns the shared filter for the filter string, or returns NULL if there is no such shared filter.
+ * Unlike celix_serviceRegistry_acquireSharedFilter, this never creates (parses) a new shared filter.
+ */
+static celix_service_registry_shared_filter_t* celix_serviceRegistry_retainExistingSharedFilter(celix_service_registry_t* registry, const char* filterStr) {
+    celix_auto(celix_mutex_lock_guard_t) lck = celixMutexLockGuard_init(&registry->sharedFilters.mutex);
+    celix_service_registry_shared_filter_t* sharedFilter = celix_stringHashMap_get(registry->sharedFilters.map, filterStr);
+    if (sharedFilter != NULL) {
+        sharedFilter->useCount += 1;
+    }
+    return sharedFilter;
+}
+
+celix_array_list_t* celix_serviceRegistry_findServicesWithFilter(celix_service_registry_t* registry, const celix_filter_t* filter) {
+    if (filter == NULL) {
+        celix_framework_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, __FUNCTION__, __BASE_FILE__, __LINE__,
+                      "Error invalid (NULL) filter.");
+        return NULL;
+    }
+    //if the same filter is already shared (e.g. used by a tracker), use the shared filter and its match memo.
+    //Otherwise, the provided filter is matched as is, so that no filter is parsed for this call.
+    celix_service_registry_shared_filter_t* sharedFilter =
+        celix_serviceRegistry_retainExistingSharedFilter(registry, celix_filter_getFilterString(filter));
+    celix_array_list_t* result = celix_serviceRegistry_findMatchingServices(registry, sharedFilter, filter);
+    celix_serviceRegistry_releaseSharedFilter(registry, sharedFilter);
+    return result;
+}
+
 
 celix_array_list_t* celix_serviceRegistry_listServiceIdsForOwner(celix_service_registry_t* registry, long bndId) {
     celix_array_list_t *result = celix_arrayList_create();
-    celixThreadRwlock_readLock(&registry->lock);
+    celixThreadRbRwlock_readLock(&registry->lock);
     celix_bundle_t *bundle = framework_getBundleById(registry->framework, bndId);
     celix_array_list_t *registrations = bundle != NULL ? hashMap_get(registry->serviceRegistrations, bundle) : NULL;
     if (registrations != NULL) {
@@ -917,7 +1087,7 @@ celix_array_list_t* celix_serviceRegistry_listServiceIdsForOwner(celix_service_r
             celix_arrayList_addLong(result, svcId);
         }
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
     return result;
 }
 
@@ -930,7 +1100,7 @@ bool celix_serviceRegistry_getServiceInfo(
         bool *outIsFactory) {
     bool found = false;
 
-    celixThreadRwlock_readLock(&registry->lock);
+    celixThreadRbRwlock_readLock(&registry->lock);
     celix_bundle_t *bundle = framework_getBundleById(registry->framework, bndId);
     celix_array_list_t *registrations = bundle != NULL ? hashMap_get(registry->serviceRegistrations, bundle) : NULL;
     if (registrations != NULL) {
@@ -955,16 +1125,16 @@ bool celix_serviceRegistry_getServiceInfo(
             }
         }
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     return found;
 }
 
 celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t *registry, celix_bundle_t *bundle, const char *stringFilter, celix_service_listener_t *listener) {
 
-    celix_filter_t *filter = NULL;
+    celix_service_registry_shared_filter_t *filter = NULL;
     if (stringFilter != NULL) {
-        filter = celix_filter_create(stringFilter);
+        filter = celix_serviceRegistry_acquireSharedFilter(registry, stringFilter);
         if (filter == NULL) {
             fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "Cannot add service listener filter '%s' is invalid", stringFilter);
             celix_framework_logTssErrors(registry->framework->logger, CELIX_LOG_LEVEL_ERROR);
@@ -982,8 +1152,9 @@ celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t
 
     celix_array_list_t *references =  celix_arrayList_create();
 
-    celixThreadRwlock_writeLock(&registry->lock);
+    celixThreadRbRwlock_writeLock(&registry->lock);
     celix_arrayList_add(registry->serviceListeners, entry); //use count 1
+    __atomic_store_n(&registry->metrics.serviceListeners, celix_arrayList_size(registry->serviceListeners), __ATOMIC_RELAXED);
 
     //find already registered services
     hash_map_iterator_t iter = hashMapIterator_construct(registry->serviceRegistrations);
@@ -991,9 +1162,7 @@ celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t
         celix_array_list_t *regs = (celix_array_list_t*) hashMapIterator_nextValue(&iter);
         for (int regIdx = 0; (regs != NULL) && regIdx < celix_arrayList_size(regs); ++regIdx) {
             service_registration_pt registration = celix_arrayList_get(regs, regIdx);
-            celix_properties_t* props = NULL;
-            serviceRegistration_getProperties(registration, &props);
-            if (celix_filter_match(filter, props)) {
+            if (celix_serviceRegistry_matchSharedFilter(filter, registration)) {
                 long svcId = serviceRegistration_getServiceId(registration);
                 service_reference_pt ref = NULL;
                 serviceRegistry_getServiceReference_internal(registry, bundle, registration, &ref);
@@ -1003,7 +1172,7 @@ celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t
             }
         }
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     //NOTE there is a race condition with serviceRegistry_registerServiceInternal, as result
     //a REGISTERED event can be triggered twice instead of once. The service tracker can deal with this.
@@ -1023,7 +1192,7 @@ celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t
     }
     celix_arrayList_destroy(references);
 
-    serviceRegistry_callHooksForListenerFilter(registry, bundle, entry->filter, false);
+    serviceRegistry_callHooksForListenerFilter(registry, bundle, filter != NULL ? filter->filter : NULL, false);
 
     celix_decreaseCountServiceListener(entry); //use count decreased, can be 0
     return CELIX_SUCCESS;
@@ -1032,20 +1201,21 @@ celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t
 celix_status_t celix_serviceRegistry_removeServiceListener(celix_service_registry_t *registry, celix_service_listener_t *listener) {
     celix_service_registry_service_listener_entry_t *entry = NULL;
 
-    celixThreadRwlock_writeLock(&registry->lock);
+    celixThreadRbRwlock_writeLock(&registry->lock);
     for (int i = 0; i < celix_arrayList_size(registry->serviceListeners); ++i) {
         celix_service_registry_service_listener_entry_t *visit = celix_arrayList_get(registry->serviceListeners, i);
         if (visit->listener == listener) {
             entry = visit;
             celix_arrayList_removeAt(registry->serviceListeners, i);
+            __atomic_store_n(&registry->metrics.serviceListeners, celix_arrayList_size(registry->serviceListeners), __ATOMIC_RELAXED);
             break;
         }
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     if (entry != NULL) {
-        serviceRegistry_callHooksForListenerFilter(registry, entry->bundle, entry->filter, true);
-        celix_waitAndDestroyServiceListener(entry);
+        serviceRegistry_callHooksForListenerFilter(registry, entry->bundle, entry->filter != NULL ? entry->filter->filter : NULL, true);
+        celix_waitAndDestroyServiceListener(registry, entry);
     } else {
         fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "Cannot remove service listener, listener not found");
         return CELIX_ILLEGAL_ARGUMENT;
@@ -1059,25 +1229,18 @@ static void celix_serviceRegistry_serviceChanged(celix_service_registry_t *regis
     celix_array_list_t* retainedEntries = celix_arrayList_create();
     celix_array_list_t* matchedEntries = celix_arrayList_create();
 
-    celixThreadRwlock_readLock(&registry->lock);
+    celixThreadRbRwlock_readLock(&registry->lock);
     for (int i = 0; i < celix_arrayList_size(registry->serviceListeners); ++i) {
         entry = celix_arrayList_get(registry->serviceListeners, i);
         celix_arrayList_add(retainedEntries, entry);
         celix_increaseCountServiceListener(entry); //ensure that use count > 0, so that the listener cannot be destroyed until all pending event are handled.
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     for (int i = 0; i < celix_arrayList_size(retainedEntries); ++i) {
         entry = celix_arrayList_get(retainedEntries, i);
-        int matched = 0;
-        celix_properties_t *props = NULL;
-        bool matchResult = false;
-        serviceRegistration_getProperties(registration, &props);
-        if (entry->filter != NULL) {
-            filter_match(entry->filter, props, &matchResult);
-        }
-        matched = (entry->filter == NULL) || matchResult;
-        if (matched) {
+        //note listeners with identical filters share a filter and its memoized match result
+        if (celix_serviceRegistry_matchSharedFilter(entry->filter, registration)) {
             celix_arrayList_add(matchedEntries, entry);
         } else {
             celix_decreaseCountServiceListener(entry); //Not a match -> release entry
@@ -1149,7 +1312,7 @@ long celix_serviceRegistry_nextSvcId(celix_service_registry_t* registry) {
 bool celix_serviceRegistry_isServiceRegistered(celix_service_registry_t* reg, long serviceId) {
     bool isRegistered = false;
     if (serviceId >= 0) {
-        celixThreadRwlock_readLock(&reg->lock);
+        celixThreadRbRwlock_readLock(&reg->lock);
         hash_map_iterator_t iter = hashMapIterator_construct(reg->serviceRegistrations);
         while (!isRegistered && hashMapIterator_hasNext(&iter)) {
             celix_array_list_t *regs = hashMapIterator_nextValue(&iter);
@@ -1161,14 +1324,14 @@ bool celix_serviceRegistry_isServiceRegistered(celix_service_registry_t* reg, lo
                 }
             }
         }
-        celixThreadRwlock_unlock(&reg->lock);
+        celixThreadRbRwlock_unlock(&reg->lock);
     }
     return isRegistered;
 }
 
 void celix_serviceRegistry_unregisterService(celix_service_registry_t* registry, celix_bundle_t* bnd, long serviceId) {
     service_registration_t *reg = NULL;
-    celixThreadRwlock_readLock(&registry->lock);
+    celixThreadRbRwlock_readLock(&registry->lock);
     celix_array_list_t* registrations = hashMap_get(registry->serviceRegistrations, (void*)bnd);
     if (registrations != NULL) {
         for (int i = 0; i < celix_arrayList_size(registrations); ++i) {
@@ -1180,7 +1343,7 @@ void celix_serviceRegistry_unregisterService(celix_service_registry_t* registry,
             }
         }
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadRbRwlock_unlock(&registry->lock);
 
     if (reg != NULL) {
         serviceRegistration_unregister(reg);
@@ -1189,3 +1352,29 @@ void celix_serviceRegistry_unregisterService(celix_service_registry_t* registry,
         fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "Cannot unregister service for service id %li. This id is not present or owned by the provided bundle (bnd id %li)", serviceId, celix_bundle_getId(bnd));
     }
 }
+
+void celix_serviceRegistry_collectMetrics(celix_service_registry_t* registry, void* callbackHandle, celix_metrics_callback_fp callback) {
+    celix_metric_t metric = {0};
+    metric.name = "celix_framework_registered_services";
+    metric.help = "Nr of currently registered services.";
+    metric.type = CELIX_METRIC_TYPE_GAUGE;
+    metric.value = (double)__atomic_load_n(&registry->metrics.registeredServices, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_service_registrations_total";
+    metric.help = "Total nr of service registrations.";
+    metric.type = CELIX_METRIC_TYPE_COUNTER;
+    metric.value = (double)__atomic_load_n(&registry->metrics.registrationsTotal, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_service_unregistrations_total";
+    metric.help = "Total nr of service unregistrations.";
+    metric.value = (double)__atomic_load_n(&registry->metrics.unregistrationsTotal, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+
+    metric.name = "celix_framework_service_listeners";
+    metric.help = "Nr of currently added service listeners.";
+    metric.type = CELIX_METRIC_TYPE_GAUGE;
+    metric.value = (double)__atomic_load_n(&registry->metrics.serviceListeners, __ATOMIC_RELAXED);
+    callback(callbackHandle, &metric);
+}
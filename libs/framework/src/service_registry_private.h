@@ -31,6 +31,7 @@
 #include "service_registry.h"
 #include "listener_hook_service.h"
 #include "service_reference.h"
+#include "celix_string_hash_map.h"
 
 #define CELIX_SERVICE_REGISTRY_STATIC_EVENT_QUEUE_SIZE  64
 
@@ -57,7 +58,7 @@ struct celix_serviceRegistry {
 	framework_pt framework;
 	registry_callback_t callback;
 
-    celix_thread_rwlock_t lock; //protect below
+    celix_thread_rb_rwlock_t lock; //protect below, reader-biased because the registry is read-mostly
 
 	hash_map_t *serviceRegistrations; //key = bundle (reg owner), value = list ( registration )
 	hash_map_t *serviceReferences; //key = bundle, value = map (key = serviceId, value = reference)
@@ -81,8 +82,35 @@ struct celix_serviceRegistry {
 	    celix_thread_cond_t cond;
 	    hash_map_t *map; //key = svc id, value = long (nr of pending register events)
 	} pendingRegisterEvents;
+
+	/**
+	 * The shared filters are used to intern the filters of service listeners and service lookups, so that
+	 * identical filters are only parsed and compiled once and share their match results.
+	 */
+	struct {
+	    celix_thread_mutex_t mutex;
+	    celix_string_hash_map_t* map; //key = normalized filter string, value = celix_service_registry_shared_filter_t*
+	} sharedFilters;
+
+	struct {
+	    long registeredServices; //atomic
+	    unsigned long registrationsTotal; //atomic
+	    unsigned long unregistrationsTotal; //atomic
+	    int serviceListeners; //atomic. Nr of entries in serviceListeners, so that metrics can be read without the lock
+	} metrics;
 };
 
+typedef struct celix_service_registry_shared_filter {
+    celix_filter_t* filter;
+    size_t useCount; //protected by sharedFilters.mutex
+    /**
+     * Memoized match result for the last matched service, encoded as (svcId << 1) | matched or -1 if not set.
+     * Service properties cannot change after registration and service ids are not reused, so a match result is
+     * valid for the lifetime of the service.
+     */
+    long matchMemo;
+} celix_service_registry_shared_filter_t;
+
 typedef struct celix_service_registry_listener_hook_entry {
     long svcId;
     celix_listener_hook_service_t *hook;
@@ -93,7 +121,7 @@ typedef struct celix_service_registry_listener_hook_entry {
 
 typedef struct celix_service_registry_service_listener_entry {
     celix_bundle_t *bundle;
-    celix_filter_t *filter;
+    celix_service_registry_shared_filter_t *filter; //NULL if the listener has no filter
     celix_service_listener_t *listener;
     celix_thread_mutex_t mutex; //protects below
     celix_thread_cond_t cond;
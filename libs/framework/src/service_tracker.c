@@ -34,6 +34,7 @@
 #include "celix_log.h"
 #include "bundle_context_private.h"
 #include "celix_array_list.h"
+#include "celix_lock_profiling.h"
 
 static celix_status_t serviceTracker_track(service_tracker_t *tracker, service_reference_pt reference, celix_service_event_t *event);
 static celix_status_t serviceTracker_untrack(service_tracker_t *tracker, service_reference_pt reference);
@@ -106,6 +107,19 @@ celix_status_t serviceTracker_create(bundle_context_pt context, const char * ser
 	return status;
 }
 
+/**
+ * The tracker state mutex is locked for short periods, but frequently from the event loop and user threads, so an
+ * adaptive (spin-then-park) mutex is used.
+ */
+static void serviceTracker_createStateMutex(service_tracker_t* tracker) {
+    celix_thread_mutexattr_t attr;
+    celixThreadMutexAttr_create(&attr);
+    celixThreadMutexAttr_settype(&attr, CELIX_THREAD_MUTEX_ADAPTIVE);
+    celixThreadMutex_create(&tracker->state.mutex, &attr);
+    celixThreadMutexAttr_destroy(&attr);
+    celix_lockProfiling_setName(&tracker->state.mutex, "celix::service_tracker%s", tracker->filter);
+}
+
 celix_status_t serviceTracker_createWithFilter(bundle_context_pt context, const char * filter, service_tracker_customizer_pt customizer, service_tracker_pt *out) {
 	service_tracker_t* tracker = calloc(1, sizeof(*tracker));
 	*out = tracker;
@@ -118,7 +132,7 @@ celix_status_t serviceTracker_createWithFilter(bundle_context_pt context, const
     celixThreadMutex_create(&tracker->closeSync.mutex, NULL);
     celixThreadCondition_init(&tracker->closeSync.cond, NULL);
 
-    celixThreadMutex_create(&tracker->state.mutex, NULL);
+    serviceTracker_createStateMutex(tracker);
     celixThreadCondition_init(&tracker->state.condTracked, NULL);
     celixThreadCondition_init(&tracker->state.condUntracking, NULL);
     tracker->state.trackedServices = celix_arrayList_create();
@@ -169,6 +183,7 @@ celix_status_t serviceTracker_open(service_tracker_pt tracker) {
     celixThreadMutex_unlock(&tracker->state.mutex);
 
     if (needOpening) {
+        __atomic_add_fetch(&tracker->context->framework->trackerMetrics.openServiceTrackers, 1, __ATOMIC_RELAXED);
         bundleContext_addServiceListener(tracker->context, &tracker->listener, tracker->filter);
         celixThreadMutex_lock(&tracker->state.mutex);
         tracker->state.lifecycleState = CELIX_SERVICE_TRACKER_OPEN;
@@ -243,6 +258,7 @@ celix_status_t serviceTracker_close(service_tracker_t* tracker) {
 
 
         fw_removeServiceListener(tracker->context->framework, tracker->context->bundle, &tracker->listener);
+        __atomic_sub_fetch(&tracker->context->framework->trackerMetrics.openServiceTrackers, 1, __ATOMIC_RELAXED);
 
         celixThreadMutex_lock(&tracker->state.mutex);
         tracker->state.lifecycleState = CELIX_SERVICE_TRACKER_CLOSED;
@@ -330,6 +346,7 @@ void *serviceTracker_getServiceByReference(service_tracker_pt tracker, service_r
 
 static void serviceTracker_serviceChanged(void *handle, celix_service_event_t *event) {
     service_tracker_t *tracker = handle;
+    __atomic_add_fetch(&tracker->context->framework->trackerMetrics.serviceTrackerEvents, 1, __ATOMIC_RELAXED);
 
     celixThreadMutex_lock(&tracker->closeSync.mutex);
     bool closing = tracker->closeSync.closing;
@@ -681,7 +698,7 @@ celix_service_tracker_t* celix_serviceTracker_createClosedWithOptions(celix_bund
     celixThreadMutex_create(&tracker->closeSync.mutex, NULL);
     celixThreadCondition_init(&tracker->closeSync.cond, NULL);
 
-    celixThreadMutex_create(&tracker->state.mutex, NULL);
+    serviceTracker_createStateMutex(tracker);
     celixThreadCondition_init(&tracker->state.condTracked, NULL);
     celixThreadCondition_init(&tracker->state.condUntracking, NULL);
     tracker->state.trackedServices = celix_arrayList_create();
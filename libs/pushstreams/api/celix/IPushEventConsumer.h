@@ -22,6 +22,13 @@
 #include "celix/PushEvent.h"
 
 namespace celix {
+    /**
+     * @brief A consumer of push events.
+     *
+     * The value returned by accept is used as back-pressure: a negative value (ABORT) indicates that the consumer
+     * no longer wants to receive events, zero (CONTINUE) that the next event can be delivered immediately and a
+     * positive value that the event source should wait that many milliseconds before delivering the next event.
+     */
     template <typename T>
     class IPushEventConsumer {
     public:
@@ -30,6 +37,10 @@ namespace celix {
 
         virtual ~IPushEventConsumer() = default;
 
+        /**
+         * @brief Accept an event.
+         * @return ABORT, CONTINUE or a back-pressure delay in milliseconds.
+         */
         virtual long accept(const PushEvent<T>& event) = 0;
     };
 }
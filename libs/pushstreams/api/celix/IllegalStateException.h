@@ -30,10 +30,10 @@ namespace celix {
         explicit IllegalStateException(const char* what) : w{what} {}
         explicit IllegalStateException(std::string what) : w{std::move(what)} {}
 
-        IllegalStateException(const IllegalStateException&) = delete;
+        IllegalStateException(const IllegalStateException&) = default;
         IllegalStateException(IllegalStateException&&) noexcept = default;
 
-        IllegalStateException& operator=(const IllegalStateException&) = delete;
+        IllegalStateException& operator=(const IllegalStateException&) = default;
         IllegalStateException& operator=(IllegalStateException&&) noexcept = default;
 
         [[nodiscard]] const char* what() const noexcept override { return w.c_str(); }
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <optional>
 #include <iostream>
 #include <queue>
@@ -135,7 +137,7 @@ namespace celix {
         PushEventConsumer<T> nextEvent{};
         ErrorFunction onErrorCallback{};
         CloseFunction onCloseCallback{};
-        State closed {State::BUILDING};
+        std::atomic<State> closed {State::BUILDING};
     private:
         Deferred<void> streamEnd{promiseFactory->deferred<void>()};
 
@@ -200,7 +202,7 @@ celix::PushStream<T>& celix::PushStream<T>::filter(PredicateFunction predicate)
     auto downstream = std::make_shared<celix::IntermediatePushStream<T>>(promiseFactory, *this);
     nextEvent = PushEventConsumer<T>([downstream = downstream, predicate = std::move(predicate)](const PushEvent<T>& event) -> long {
         if (event.getType() != celix::PushEvent<T>::EventType::DATA || predicate(event.getData())) {
-            downstream->handleEvent(event);
+            return downstream->handleEvent(event);
         }
         return IPushEventConsumer<T>::CONTINUE;
     });
@@ -217,13 +219,17 @@ std::vector<std::shared_ptr<celix::PushStream<T>>> celix::PushStream<T>::split(s
     }
 
     nextEvent = PushEventConsumer<T>([result = result, predicates = std::move(predicates)](const PushEvent<T>& event) -> long {
+        //the largest requested back-pressure is returned, abort only if all downstreams aborted
+        long backPressure = IPushEventConsumer<T>::ABORT;
         for(long unsigned int i = 0; i < predicates.size(); i++) {
             if (event.getType() != celix::PushEvent<T>::EventType::DATA || predicates[i](event.getData())) {
-                result[i]->handleEvent(event);
+                backPressure = std::max(backPressure, result[i]->handleEvent(event));
+            } else if (result[i]->closed != celix::PushStream<T>::State::CLOSED) {
+                backPressure = std::max(backPressure, IPushEventConsumer<T>::CONTINUE);
             }
         }
 
-        return IPushEventConsumer<T>::CONTINUE;
+        return backPressure;
     });
 
     return result;
@@ -236,11 +242,9 @@ celix::PushStream<R>& celix::PushStream<T>::map(std::function<R(const T&)> mappe
 
     nextEvent = PushEventConsumer<T>([downstream = downstream, mapper = std::move(mapper)](const PushEvent<T>& event) -> long {
         if (event.getType() == celix::PushEvent<T>::EventType::DATA) {
-            downstream->handleEvent(DataPushEvent<R>(mapper(event.getData())));
-        } else {
-            downstream->handleEvent(celix::ClosePushEvent<R>());
+            return downstream->handleEvent(DataPushEvent<R>(mapper(event.getData())));
         }
-        return IPushEventConsumer<T>::CONTINUE;
+        return downstream->handleEvent(celix::ClosePushEvent<R>());
     });
 
     return *downstream;
@@ -294,16 +298,10 @@ bool celix::PushStream<T>::internal_close(const PushEvent<T>& event, bool sendDo
 
 template<typename T>
 bool celix::PushStream<T>::compareAndSetState(celix::PushStream<T>::State expectedValue, celix::PushStream<T>::State newValue) {
-    if (closed == expectedValue) {
-        closed = newValue;
-        return true;
-    }
-    return false;
+    return closed.compare_exchange_strong(expectedValue, newValue);
 }
 
 template<typename T>
 typename celix::PushStream<T>::State celix::PushStream<T>::getAndSetState(celix::PushStream<T>::State newValue) {
-    celix::PushStream<T>::State returnValue = closed;
-    closed = newValue;
-    return returnValue;
+    return closed.exchange(newValue);
 }
@@ -0,0 +1,146 @@
+/**
+ *Licensed to the Apache Software Foundation (ASF) under one
+ *or more contributor license agreements.  See the NOTICE file
+ *distributed with this work for additional information
+ *regarding copyright ownership.  The ASF licenses this file
+ *to you under the Apache License, Version 2.0 (the
+ *"License"); you may not use this file except in compliance
+ *with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing,
+ *software distributed under the License is distributed on an
+ *"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ *specific language governing permissions and limitations
+ *under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#include "celix/IPushEventSource.h"
+#include "celix/PromiseFactory.h"
+#include "celix/PushStream.h"
+#include "celix/PushbackPolicyOption.h"
+#include "celix/QueuePolicyOption.h"
+#include "celix/impl/StreamPushEventConsumer.h"
+
+namespace celix {
+
+    /**
+     * @brief A builder for PushStream instances, used to configure the buffering and back-pressure of the stream.
+     *
+     * By default a buffered stream with an unbounded buffer is built.
+     *
+     * @tparam T The type of the events
+     */
+    template<typename T>
+    class PushStreamBuilder final {
+    public:
+        PushStreamBuilder(std::shared_ptr<IPushEventSource<T>> _eventSource, std::shared_ptr<PromiseFactory>& _promiseFactory);
+
+        /**
+         * @brief Set the maximum number of data events buffered by the stream, 0 for an unbounded buffer.
+         * @return builder style same object
+         */
+        PushStreamBuilder<T>& withBuffer(std::size_t _capacity);
+
+        /**
+         * @brief Set the policy applied when a data event is received while the buffer is full.
+         * Default QueuePolicyOption::BLOCK.
+         * @return builder style same object
+         */
+        PushStreamBuilder<T>& withQueuePolicy(QueuePolicyOption _queuePolicy);
+
+        /**
+         * @brief Set the policy used to calculate the back-pressure delay returned to the event source.
+         * Default PushbackPolicyOption::ON_FULL_FIXED with a delay of 0 ms.
+         * @return builder style same object
+         */
+        PushStreamBuilder<T>& withPushbackPolicy(PushbackPolicyOption _pushbackPolicy, std::chrono::milliseconds _pushbackDelay);
+
+        /**
+         * @brief Build an unbuffered stream, events are sent downstream on the event source's thread.
+         * The buffer, queue policy and pushback policy settings are ignored.
+         * @return builder style same object
+         */
+        PushStreamBuilder<T>& unbuffered();
+
+        /**
+         * @brief Build the stream.
+         * @return the stream, the caller needs to hold the shared_ptr.
+         */
+        [[nodiscard]] std::shared_ptr<PushStream<T>> build();
+
+    private:
+        void connect(const std::shared_ptr<UnbufferedPushStream<T>>& stream);
+
+        std::shared_ptr<IPushEventSource<T>> eventSource;
+        std::shared_ptr<PromiseFactory> promiseFactory;
+        bool buffered{true};
+        std::size_t capacity{0};
+        QueuePolicyOption queuePolicy{QueuePolicyOption::BLOCK};
+        PushbackPolicyOption pushbackPolicy{PushbackPolicyOption::ON_FULL_FIXED};
+        std::chrono::milliseconds pushbackDelay{0};
+    };
+}
+
+/*********************************************************************************
+ Implementation
+*********************************************************************************/
+
+template<typename T>
+celix::PushStreamBuilder<T>::PushStreamBuilder(std::shared_ptr<IPushEventSource<T>> _eventSource, std::shared_ptr<PromiseFactory>& _promiseFactory) :
+    eventSource{std::move(_eventSource)}, promiseFactory{_promiseFactory} {
+}
+
+template<typename T>
+celix::PushStreamBuilder<T>& celix::PushStreamBuilder<T>::withBuffer(std::size_t _capacity) {
+    capacity = _capacity;
+    return *this;
+}
+
+template<typename T>
+celix::PushStreamBuilder<T>& celix::PushStreamBuilder<T>::withQueuePolicy(QueuePolicyOption _queuePolicy) {
+    queuePolicy = _queuePolicy;
+    return *this;
+}
+
+template<typename T>
+celix::PushStreamBuilder<T>& celix::PushStreamBuilder<T>::withPushbackPolicy(PushbackPolicyOption _pushbackPolicy, std::chrono::milliseconds _pushbackDelay) {
+    pushbackPolicy = _pushbackPolicy;
+    pushbackDelay = _pushbackDelay;
+    return *this;
+}
+
+template<typename T>
+celix::PushStreamBuilder<T>& celix::PushStreamBuilder<T>::unbuffered() {
+    buffered = false;
+    return *this;
+}
+
+template<typename T>
+std::shared_ptr<celix::PushStream<T>> celix::PushStreamBuilder<T>::build() {
+    std::shared_ptr<UnbufferedPushStream<T>> stream;
+    if (buffered) {
+        stream = std::make_shared<BufferedPushStream<T>>(promiseFactory, capacity, queuePolicy, pushbackPolicy, pushbackDelay);
+    } else {
+        stream = std::make_shared<UnbufferedPushStream<T>>(promiseFactory);
+    }
+    connect(stream);
+    return stream;
+}
+
+template<typename T>
+void celix::PushStreamBuilder<T>::connect(const std::shared_ptr<UnbufferedPushStream<T>>& stream) {
+    auto pushStreamConsumer = std::make_shared<celix::StreamPushEventConsumer<T>>(stream);
+
+    stream->setConnector([eventSource = eventSource, pushStreamConsumer = std::move(pushStreamConsumer)]() -> std::shared_ptr<IAutoCloseable> {
+        eventSource->open(pushStreamConsumer);
+        return pushStreamConsumer;
+    });
+}
@@ -24,6 +24,7 @@
 #include "celix/IPushEventSource.h"
 #include "celix/impl/StreamPushEventConsumer.h"
 #include "celix/PushStream.h"
+#include "celix/PushStreamBuilder.h"
 
 namespace celix {
 
@@ -80,9 +81,16 @@ namespace celix {
         template <typename T>
         [[nodiscard]] std::shared_ptr<celix::PushStream<T>> createStream(std::shared_ptr<celix::IPushEventSource<T>> eventSource, std::shared_ptr<PromiseFactory>&  promiseFactory);
 
-    private:
+        /**
+         * @brief creates a builder for a stream of event type T. The builder can be used to configure the buffer
+         * capacity, queue policy and pushback policy of the stream.
+         * @param eventSource the coupled event source of which the event are injected.
+         * @param promiseFactory the used promiseFactory
+         * @tparam T The type of the events
+         * @return the stream builder.
+         */
         template <typename T>
-        void createStreamConsumer(std::shared_ptr<celix::UnbufferedPushStream<T>> stream, std::shared_ptr<celix::IPushEventSource<T>> eventSource);
+        [[nodiscard]] celix::PushStreamBuilder<T> buildStream(std::shared_ptr<celix::IPushEventSource<T>> eventSource, std::shared_ptr<PromiseFactory>&  promiseFactory);
     };
 }
 
@@ -101,24 +109,15 @@ inline std::shared_ptr<celix::AsynchronousPushEventSource<T>> celix::PushStreamP
 
 template <typename T>
 std::shared_ptr<celix::PushStream<T>> celix::PushStreamProvider::createUnbufferedStream(std::shared_ptr<celix::IPushEventSource<T>> eventSource, std::shared_ptr<PromiseFactory>& promiseFactory) {
-    auto stream = std::make_shared<UnbufferedPushStream<T>>(promiseFactory);
-    createStreamConsumer<T>(stream, eventSource);
-    return stream;
+    return buildStream<T>(std::move(eventSource), promiseFactory).unbuffered().build();
 }
 
 template <typename T>
 std::shared_ptr<celix::PushStream<T>> celix::PushStreamProvider::createStream(std::shared_ptr<celix::IPushEventSource<T>> eventSource, std::shared_ptr<PromiseFactory>& promiseFactory) {
-    auto stream = std::make_shared<BufferedPushStream<T>>(promiseFactory);
-    createStreamConsumer<T>(stream, eventSource);
-    return stream;
+    return buildStream<T>(std::move(eventSource), promiseFactory).build();
 }
 
-template<typename T>
-void celix::PushStreamProvider::createStreamConsumer(std::shared_ptr<celix::UnbufferedPushStream<T>> stream, std::shared_ptr<celix::IPushEventSource<T>> eventSource) {
-    auto pushStreamConsumer = std::make_shared<celix::StreamPushEventConsumer<T>>(stream);
-
-    stream->setConnector([eventSource, pushStreamConsumer = std::move(pushStreamConsumer)]() -> std::shared_ptr<IAutoCloseable> {
-        eventSource->open(pushStreamConsumer);
-        return pushStreamConsumer;
-    });
+template <typename T>
+celix::PushStreamBuilder<T> celix::PushStreamProvider::buildStream(std::shared_ptr<celix::IPushEventSource<T>> eventSource, std::shared_ptr<PromiseFactory>& promiseFactory) {
+    return celix::PushStreamBuilder<T>{std::move(eventSource), promiseFactory};
 }
\ No newline at end of file
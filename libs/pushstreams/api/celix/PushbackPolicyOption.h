@@ -0,0 +1,47 @@
+/**
+ *Licensed to the Apache Software Foundation (ASF) under one
+ *or more contributor license agreements.  See the NOTICE file
+ *distributed with this work for additional information
+ *regarding copyright ownership.  The ASF licenses this file
+ *to you under the Apache License, Version 2.0 (the
+ *"License"); you may not use this file except in compliance
+ *with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing,
+ *software distributed under the License is distributed on an
+ *"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ *specific language governing permissions and limitations
+ *under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace celix {
+
+    /**
+     * @brief The policy used by a buffered PushStream to calculate the back-pressure delay it returns to the event
+     * source after receiving an event.
+     */
+    enum class PushbackPolicyOption : std::uint8_t {
+        /**
+         * @brief Always return the configured delay.
+         */
+        FIXED,
+
+        /**
+         * @brief Return the configured delay if the buffer is full, otherwise no delay.
+         */
+        ON_FULL_FIXED,
+
+        /**
+         * @brief Return the configured delay scaled by the fill ratio of the buffer, so no delay for an empty buffer
+         * and the configured delay for a full buffer.
+         */
+        LINEAR
+    };
+}
@@ -0,0 +1,45 @@
+/**
+ *Licensed to the Apache Software Foundation (ASF) under one
+ *or more contributor license agreements.  See the NOTICE file
+ *distributed with this work for additional information
+ *regarding copyright ownership.  The ASF licenses this file
+ *to you under the Apache License, Version 2.0 (the
+ *"License"); you may not use this file except in compliance
+ *with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing,
+ *software distributed under the License is distributed on an
+ *"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ *specific language governing permissions and limitations
+ *under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace celix {
+
+    /**
+     * @brief The policy used by a buffered PushStream when an event is received and the buffer is full.
+     */
+    enum class QueuePolicyOption : std::uint8_t {
+        /**
+         * @brief Block the thread delivering the event until the buffer has room for the event.
+         */
+        BLOCK,
+
+        /**
+         * @brief Discard the oldest event in the buffer to make room for the event.
+         */
+        DISCARD_OLDEST,
+
+        /**
+         * @brief Reject the event and fail the stream with an IllegalStateException.
+         */
+        FAIL
+    };
+}
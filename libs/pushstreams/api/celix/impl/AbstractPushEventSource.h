@@ -20,6 +20,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
 #include <set>
 
@@ -33,13 +37,20 @@
 #include "celix/PushEvent.h"
 
 namespace celix {
+    /**
+     * @brief Base class for push event sources.
+     *
+     * The source honours the back-pressure requested by its consumers: if a consumer returns a positive delay from
+     * accept, the next publish call blocks until that delay has elapsed. Consumers returning ABORT are disconnected.
+     */
     template <typename T>
     class AbstractPushEventSource: public IPushEventSource<T> {
     public:
         explicit AbstractPushEventSource(std::shared_ptr<PromiseFactory>& _promiseFactory);
 
         /**
-         * Publishes event event in the stream
+         * Publishes event event in the stream.
+         * Blocks while a connected consumer has requested a back-pressure delay which has not yet elapsed.
          * @param event
          */
         void publish(const T& event);
@@ -70,10 +81,22 @@ namespace celix {
         std::shared_ptr<PromiseFactory> promiseFactory;
 
     private:
+        struct ConsumerEntry {
+            explicit ConsumerEntry(std::shared_ptr<IPushEventConsumer<T>> _consumer) : consumer{std::move(_consumer)} {}
+
+            const std::shared_ptr<IPushEventConsumer<T>> consumer;
+            std::atomic<std::chrono::steady_clock::rep> nextDelivery{0}; //steady clock ticks since epoch
+            std::atomic<bool> aborted{false};
+        };
+
+        static void updateBackPressure(ConsumerEntry& entry, long backPressure);
+        void waitForBackPressure(std::unique_lock<std::mutex>& lck);
+
         std::mutex mutex {};
+        std::condition_variable backPressureCond{};
         bool closed{false};
         std::vector<Deferred<void>> connected {};
-        std::vector<std::shared_ptr<IPushEventConsumer<T>>> eventConsumers {};
+        std::vector<std::shared_ptr<ConsumerEntry>> eventConsumers {};
     };
 }
 
@@ -92,7 +115,7 @@ void celix::AbstractPushEventSource<T>::open(std::shared_ptr<celix::IPushEventCo
     if (closed) {
         _eventConsumer->accept(celix::ClosePushEvent<T>());
     } else {
-        eventConsumers.push_back(_eventConsumer);
+        eventConsumers.push_back(std::make_shared<ConsumerEntry>(std::move(_eventConsumer)));
         for(auto& connect: connected) {
             connect.resolve();
         }
@@ -110,23 +133,57 @@ template <typename T>
 
 template <typename T>
 void celix::AbstractPushEventSource<T>::publish(const T& event) {
-    std::lock_guard lck{mutex};
+    std::unique_lock lck{mutex};
+    waitForBackPressure(lck);
 
     if (closed) {
         throw IllegalStateException("AbstractPushEventSource closed");
     } else {
-        for(auto& eventConsumer : eventConsumers) {
-            execute([&, event]() {
-                eventConsumer->accept(celix::DataPushEvent<T>(event));
+        eventConsumers.erase(std::remove_if(eventConsumers.begin(), eventConsumers.end(), [](const auto& entry) {
+            return entry->aborted.load();
+        }), eventConsumers.end());
+        for(auto& entry : eventConsumers) {
+            execute([entry, event]() {
+                updateBackPressure(*entry, entry->consumer->accept(celix::DataPushEvent<T>(event)));
             });
         }
     }
 }
 
+template <typename T>
+void celix::AbstractPushEventSource<T>::updateBackPressure(ConsumerEntry& entry, long backPressure) {
+    if (backPressure < 0) {
+        entry.aborted = true;
+    } else if (backPressure > 0) {
+        auto next = std::chrono::steady_clock::now() + std::chrono::milliseconds{backPressure};
+        entry.nextDelivery = next.time_since_epoch().count();
+    }
+}
+
+template <typename T>
+void celix::AbstractPushEventSource<T>::waitForBackPressure(std::unique_lock<std::mutex>& lck) {
+    while (!closed) {
+        auto deadline = std::chrono::steady_clock::time_point{};
+        for (auto& entry : eventConsumers) {
+            if (!entry->aborted) {
+                auto next = std::chrono::steady_clock::time_point{std::chrono::steady_clock::duration{entry->nextDelivery.load()}};
+                deadline = std::max(deadline, next);
+            }
+        }
+        if (deadline <= std::chrono::steady_clock::now()) {
+            break;
+        }
+        //note releases the mutex, so other publishers and close are not blocked by the waiting
+        backPressureCond.wait_until(lck, deadline);
+    }
+}
+
 template <typename T>
 bool celix::AbstractPushEventSource<T>::isConnected() {
     std::lock_guard lck{mutex};
-    return !eventConsumers.empty();
+    return std::any_of(eventConsumers.begin(), eventConsumers.end(), [](const auto& entry) {
+        return !entry->aborted;
+    });
 }
 
 template <typename T>
@@ -141,10 +198,12 @@ void celix::AbstractPushEventSource<T>::close() {
             return;
         }
 
-        for (auto &eventConsumer : eventConsumers) {
-            execute([eventConsumer]() {
-                eventConsumer->accept(celix::ClosePushEvent<T>());
-            });
+        for (auto &entry : eventConsumers) {
+            if (!entry->aborted) {
+                execute([entry]() {
+                    entry->consumer->accept(celix::ClosePushEvent<T>());
+                });
+            }
         }
     }
 
@@ -153,6 +212,7 @@ void celix::AbstractPushEventSource<T>::close() {
         eventConsumers.clear();
         closed = true;
         cv.notify_one();
+        backPressureCond.notify_all();
     });
 
     //wait upon closed
@@ -19,14 +19,40 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
 #include "celix/IPushEventSource.h"
+#include "celix/IllegalStateException.h"
+#include "celix/PushbackPolicyOption.h"
+#include "celix/QueuePolicyOption.h"
 
 namespace celix {
 
+    /**
+     * @brief A PushStream which buffers the received events and sends them downstream using the PromiseFactory
+     * executor.
+     *
+     * The buffer can be bounded; if a data event is received while the buffer is full, the queue policy decides
+     * whether the delivering thread is blocked, the oldest buffered event is discarded or the stream fails.
+     * After an event is buffered, the pushback policy decides the back-pressure delay returned to the event source.
+     */
     template<typename T>
     class BufferedPushStream: public UnbufferedPushStream<T> {
     public:
-        explicit BufferedPushStream(std::shared_ptr<PromiseFactory>& _promiseFactory);
+        /**
+         * @param _promiseFactory the used promiseFactory
+         * @param _capacity the maximum number of buffered data events, 0 for an unbounded buffer.
+         * @param _queuePolicy the policy applied when a data event is received while the buffer is full.
+         * @param _pushbackPolicy the policy used to calculate the returned back-pressure delay.
+         * @param _pushbackDelay the delay used by the pushback policy.
+         */
+        explicit BufferedPushStream(std::shared_ptr<PromiseFactory>& _promiseFactory,
+                                    std::size_t _capacity = 0,
+                                    QueuePolicyOption _queuePolicy = QueuePolicyOption::BLOCK,
+                                    PushbackPolicyOption _pushbackPolicy = PushbackPolicyOption::ON_FULL_FIXED,
+                                    std::chrono::milliseconds _pushbackDelay = std::chrono::milliseconds{0});
         BufferedPushStream(const BufferedPushStream&) = delete;
         BufferedPushStream(BufferedPushStream&&) = delete;
         BufferedPushStream& operator=(const BufferedPushStream&) = delete;
@@ -39,6 +65,7 @@ namespace celix {
         void close() override {
             UnbufferedPushStream<T>::close();
             std::unique_lock lk(mutex);
+            notFull.notify_all();
             cv.wait(lk, [this]{return nrWorkers == 0;});
         }
 
@@ -48,11 +75,20 @@ namespace celix {
     private:
         void startWorker();
         std::unique_ptr<PushEvent<T>> popQueue();
+        bool makeRoom(std::unique_lock<std::mutex>& lk);
+        long pushback() const;
+
+        const std::size_t capacity;
+        const QueuePolicyOption queuePolicy;
+        const PushbackPolicyOption pushbackPolicy;
+        const std::chrono::milliseconds pushbackDelay;
 
         std::shared_ptr<std::queue<std::unique_ptr<PushEvent<T>>>> queue{std::make_shared<std::queue<std::unique_ptr<PushEvent<T>>>>()};
         std::condition_variable cv{};
+        std::condition_variable notFull{};
         std::mutex mutex{};
         int nrWorkers{0};
+        bool failed{false};
     };
 }
 
@@ -61,22 +97,83 @@ namespace celix {
 *********************************************************************************/
 
 template<typename T>
-celix::BufferedPushStream<T>::BufferedPushStream(std::shared_ptr<PromiseFactory>& _promiseFactory) : celix::UnbufferedPushStream<T>(_promiseFactory) {
+celix::BufferedPushStream<T>::BufferedPushStream(std::shared_ptr<PromiseFactory>& _promiseFactory,
+                                                 std::size_t _capacity,
+                                                 QueuePolicyOption _queuePolicy,
+                                                 PushbackPolicyOption _pushbackPolicy,
+                                                 std::chrono::milliseconds _pushbackDelay) :
+    celix::UnbufferedPushStream<T>(_promiseFactory),
+    capacity{_capacity},
+    queuePolicy{_queuePolicy},
+    pushbackPolicy{_pushbackPolicy},
+    pushbackDelay{_pushbackDelay} {
 }
 
 template<typename T>
 long celix::BufferedPushStream<T>::handleEvent(const PushEvent<T>& event) {
     std::unique_lock lk(mutex);
-    if(this->closed != celix::PushStream<T>::State::CLOSED) {
+    //note close and error events are always buffered, so that they cannot be blocked or discarded
+    bool accepted = event.getType() != celix::PushEvent<T>::EventType::DATA || makeRoom(lk);
+    if (accepted && !failed && this->closed != celix::PushStream<T>::State::CLOSED) {
         queue->push(std::move(event.clone()));
         if (nrWorkers == 0)  {
             startWorker();
         }
-        return IPushEventConsumer<T>::CONTINUE;
+        return pushback();
     }
     return IPushEventConsumer<T>::ABORT;
 }
 
+template<typename T>
+bool celix::BufferedPushStream<T>::makeRoom(std::unique_lock<std::mutex>& lk) {
+    if (capacity == 0 || queue->size() < capacity) {
+        return true;
+    }
+    switch (queuePolicy) {
+        case QueuePolicyOption::BLOCK:
+            notFull.wait(lk, [this]{
+                return queue->size() < capacity || this->closed == celix::PushStream<T>::State::CLOSED;
+            });
+            return true;
+        case QueuePolicyOption::DISCARD_OLDEST:
+            while (queue->size() >= capacity) {
+                queue->pop();
+            }
+            return true;
+        case QueuePolicyOption::FAIL:
+            if (!failed) {
+                failed = true;
+                auto failure = std::make_exception_ptr(IllegalStateException("BufferedPushStream buffer full"));
+                queue->push(std::make_unique<ErrorPushEvent<T>>(failure));
+                if (nrWorkers == 0) {
+                    startWorker();
+                }
+            }
+            return false;
+    }
+    return false;
+}
+
+template<typename T>
+long celix::BufferedPushStream<T>::pushback() const {
+    switch (pushbackPolicy) {
+        case PushbackPolicyOption::FIXED:
+            return static_cast<long>(pushbackDelay.count());
+        case PushbackPolicyOption::ON_FULL_FIXED:
+            if (capacity > 0 && queue->size() >= capacity) {
+                return static_cast<long>(pushbackDelay.count());
+            }
+            return IPushEventConsumer<T>::CONTINUE;
+        case PushbackPolicyOption::LINEAR:
+            if (capacity > 0) {
+                auto fill = static_cast<long>(std::min(queue->size(), capacity));
+                return static_cast<long>(pushbackDelay.count()) * fill / static_cast<long>(capacity);
+            }
+            return IPushEventConsumer<T>::CONTINUE;
+    }
+    return IPushEventConsumer<T>::CONTINUE;
+}
+
 template<typename T>
 std::unique_ptr<celix::PushEvent<T>> celix::BufferedPushStream<T>::popQueue() {
     std::unique_lock lk(mutex);
@@ -84,8 +181,10 @@ std::unique_ptr<celix::PushEvent<T>> celix::BufferedPushStream<T>::popQueue() {
     if (!queue->empty()) {
         returnValue = std::move(queue->front());
         queue->pop();
+        notFull.notify_all();
     } else {
         nrWorkers = 0;
+        cv.notify_all();
     }
 
     return returnValue;
@@ -103,7 +202,6 @@ void celix::BufferedPushStream<T>::startWorker() {
                 this->nextEvent.accept(*event);
                 event = popQueue();
             }
-            cv.notify_all();
         }
     });
 }
@@ -727,3 +727,179 @@ TEST_F(PushStreamTestSuite, SplitStreamsTest) {
     //GTEST_ASSERT_EQ(12, counts[1]);
 }
 
+
+///
+/// Back-pressure tests
+///
+TEST_F(PushStreamTestSuite, EventSourceHonoursBackPressureDelayTest) {
+    auto ses = psp.createSynchronousEventSource<int>(promiseFactory);
+    int received{0};
+    ses->open(std::make_shared<celix::PushEventConsumer<int>>([&](const celix::PushEvent<int>& /*event*/) -> long {
+        received++;
+        return 20; //request a 20 ms delay before the next event
+    }));
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 5; ++i) {
+        ses->publish(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(5, received);
+    EXPECT_GE(elapsed, std::chrono::milliseconds{80}); //4 delays between 5 events
+    ses->close();
+}
+
+TEST_F(PushStreamTestSuite, EventSourceDisconnectsAbortingConsumerTest) {
+    auto ses = psp.createSynchronousEventSource<int>(promiseFactory);
+    int received{0};
+    ses->open(std::make_shared<celix::PushEventConsumer<int>>([&](const celix::PushEvent<int>& /*event*/) -> long {
+        received++;
+        return celix::IPushEventConsumer<int>::ABORT;
+    }));
+
+    ses->publish(1);
+    EXPECT_FALSE(ses->isConnected());
+    ses->publish(2);
+
+    EXPECT_EQ(1, received);
+    ses->close();
+}
+
+TEST_F(PushStreamTestSuite, BufferedStreamBlockPolicyThroughputTest) {
+    constexpr int nrOfEvents = 100;
+    constexpr std::size_t capacity = 4;
+    std::atomic<int> published{0};
+    std::atomic<int> consumed{0};
+    std::atomic<int> maxBacklog{0};
+    int lastConsumed{-1};
+    bool inOrder{true};
+
+    auto ses = psp.createSynchronousEventSource<int>(promiseFactory);
+    auto stream = psp.buildStream<int>(ses, promiseFactory)
+            .withBuffer(capacity)
+            .withQueuePolicy(celix::QueuePolicyOption::BLOCK)
+            .build();
+    auto streamEnded = stream->forEach([&](int event) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1}); //slow consumer
+        maxBacklog = std::max(maxBacklog.load(), published - consumed);
+        inOrder = inOrder && lastConsumed + 1 == event;
+        lastConsumed = event;
+        consumed++;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nrOfEvents; ++i) {
+        ses->publish(i);
+        published++;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ses->close();
+    streamEnded.wait();
+
+    EXPECT_EQ(nrOfEvents, consumed);
+    EXPECT_TRUE(inOrder);
+    //the publisher is throttled to the consumer rate and the backlog is bounded by the buffer (+ the event in progress)
+    EXPECT_LE(maxBacklog, (int)capacity + 1);
+    EXPECT_GE(elapsed, std::chrono::milliseconds{nrOfEvents - (int)capacity - 1});
+}
+
+TEST_F(PushStreamTestSuite, BufferedStreamDiscardOldestPolicyTest) {
+    constexpr int nrOfEvents = 100;
+    constexpr int bufferSize = 4;
+    std::vector<int> received{};
+    std::promise<void> consumerStarted{};
+    std::promise<void> release{};
+    auto released = release.get_future().share();
+
+    auto ses = psp.createSynchronousEventSource<int>(promiseFactory);
+    auto stream = psp.buildStream<int>(ses, promiseFactory)
+            .withBuffer(bufferSize)
+            .withQueuePolicy(celix::QueuePolicyOption::DISCARD_OLDEST)
+            .build();
+    auto streamEnded = stream->forEach([&](int event) {
+        if (event == 0) {
+            consumerStarted.set_value();
+            released.wait(); //blocked consumer
+        }
+        received.push_back(event);
+    });
+
+    //the first event is in progress and blocks the consumer
+    ses->publish(0);
+    consumerStarted.get_future().wait();
+
+    //publishing to the full buffer does not block the producer
+    auto published = std::async(std::launch::async, [&]{
+        for (int i = 1; i < nrOfEvents; ++i) {
+            ses->publish(i);
+        }
+    });
+    EXPECT_EQ(std::future_status::ready, published.wait_for(std::chrono::seconds{30})); //guard against a hang, not a latency bound
+    release.set_value();
+    published.wait();
+    ses->close();
+    streamEnded.wait();
+
+    //the event in progress and the newest (buffer size) events are received, the older events are discarded
+    std::vector<int> expected{0};
+    for (int i = nrOfEvents - bufferSize; i < nrOfEvents; ++i) {
+        expected.push_back(i);
+    }
+    EXPECT_EQ(expected, received);
+}
+
+TEST_F(PushStreamTestSuite, BufferedStreamFailPolicyTest) {
+    std::atomic<int> onErrorReceived{0};
+    std::atomic<int> consumed{0};
+    std::promise<void> release{};
+    auto released = release.get_future().share();
+
+    auto ses = psp.createSynchronousEventSource<int>(promiseFactory);
+    auto stream = psp.buildStream<int>(ses, promiseFactory)
+            .withBuffer(2)
+            .withQueuePolicy(celix::QueuePolicyOption::FAIL)
+            .build();
+    auto streamEnded = stream->onError([&]() {
+        onErrorReceived++;
+    }).forEach([&](int /*event*/) {
+        released.wait(); //blocked consumer
+        consumed++;
+    });
+
+    for (int i = 0; i < 10; ++i) {
+        ses->publish(i);
+    }
+    EXPECT_FALSE(ses->isConnected()); //stream aborted on the full buffer
+    release.set_value();
+    streamEnded.wait();
+    promiseFactory->getExecutor()->wait(); //onError is called after the stream end is failed
+
+    EXPECT_FALSE(streamEnded.isSuccessfullyResolved());
+    EXPECT_EQ(1, onErrorReceived);
+    EXPECT_LE(consumed, 3); //at most the event in progress + a full buffer
+    ses->close();
+}
+
+TEST_F(PushStreamTestSuite, BufferedStreamPushbackPolicyTest) {
+    int received{0};
+
+    auto ses = psp.createSynchronousEventSource<int>(promiseFactory);
+    auto stream = psp.buildStream<int>(ses, promiseFactory)
+            .withPushbackPolicy(celix::PushbackPolicyOption::FIXED, std::chrono::milliseconds{10})
+            .build();
+    auto streamEnded = stream->forEach([&](int /*event*/) {
+        received++;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 6; ++i) {
+        ses->publish(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ses->close();
+    streamEnded.wait();
+
+    EXPECT_EQ(6, received);
+    EXPECT_GE(elapsed, std::chrono::milliseconds{50}); //source waits 10 ms between the events
+}
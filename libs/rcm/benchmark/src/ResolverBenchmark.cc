@@ -0,0 +1,152 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "celix_capability.h"
+#include "celix_filter.h"
+#include "celix_requirement.h"
+#include "celix_resolver.h"
+#include "celix_resource.h"
+
+/**
+ * @brief Creates a chain of resources, where every resource provides a package and requires the packages of the
+ * previous (up to) 3 resources.
+ */
+class ResolverBenchmark {
+public:
+    explicit ResolverBenchmark(int64_t nrOfResources) {
+        resources.reserve(nrOfResources);
+        for (int64_t i = 0; i < nrOfResources; ++i) {
+            auto* res = celix_resource_create();
+            auto* cap = celix_capability_create(res, "osgi.wiring.package");
+            celix_capability_addAttribute(cap, "osgi.wiring.package", packageName(i).c_str());
+            celix_capability_addAttribute(cap, "version", "1.0.0");
+            celix_resource_addCapability(res, cap);
+            for (int64_t j = i - 3; j < i; ++j) {
+                if (j >= 0) {
+                    auto filter = "(&(osgi.wiring.package=" + packageName(j) + ")(version>=1.0.0))";
+                    auto* req = celix_requirement_create(res, "osgi.wiring.package", filter.c_str());
+                    celix_resource_addRequirement(res, req);
+                }
+            }
+            resources.push_back(res);
+        }
+    }
+
+    ~ResolverBenchmark() {
+        for (auto* res : resources) {
+            celix_resource_destroy(res);
+        }
+    }
+
+    ResolverBenchmark(const ResolverBenchmark&) = delete;
+    ResolverBenchmark& operator=(const ResolverBenchmark&) = delete;
+
+    static std::string packageName(int64_t index) {
+        return "org.example.package" + std::to_string(index);
+    }
+
+    celix_resolver_t* createResolver() const {
+        auto* resolver = celix_resolver_create();
+        for (auto* res : resources) {
+            celix_resolver_addResource(resolver, res);
+        }
+        return resolver;
+    }
+
+    std::vector<celix_resource_t*> resources{};
+};
+
+static void ResolverBenchmark_resolve(benchmark::State& state) {
+    ResolverBenchmark bench{state.range(0)};
+    for (auto _ : state) {
+        // This code gets timed
+        celix_autoptr(celix_resolver_t) resolver = bench.createResolver();
+        celix_autoptr(celix_resolution_t) resolution = nullptr;
+        if (celix_resolver_resolve(resolver, &resolution) != CELIX_SUCCESS ||
+            !celix_resolution_isResolved(resolution, bench.resources.back())) {
+            std::cerr << "ERROR: expected resolved resources" << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void ResolverBenchmark_resolveCached(benchmark::State& state) {
+    ResolverBenchmark bench{state.range(0)};
+    celix_autoptr(celix_resolver_t) resolver = bench.createResolver();
+    for (auto _ : state) {
+        // This code gets timed
+        celix_autoptr(celix_resolution_t) resolution = nullptr;
+        if (celix_resolver_resolve(resolver, &resolution) != CELIX_SUCCESS) {
+            std::cerr << "ERROR: expected resolved resources" << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void ResolverBenchmark_findProviders(benchmark::State& state) {
+    ResolverBenchmark bench{state.range(0)};
+    celix_autoptr(celix_resolver_t) resolver = bench.createResolver();
+    const auto* reqs = celix_resource_getRequirements(bench.resources.back(), nullptr);
+    auto* req = static_cast<celix_requirement_t*>(celix_arrayList_get(reqs, 0));
+    for (auto _ : state) {
+        // This code gets timed
+        auto* providers = celix_resolver_findProviders(resolver, req);
+        if (celix_arrayList_size(providers) != 1) {
+            std::cerr << "ERROR: expected 1 provider" << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Baseline: match a requirement filter against every capability of every resource.
+ */
+static void ResolverBenchmark_findProvidersLinearScan(benchmark::State& state) {
+    ResolverBenchmark bench{state.range(0)};
+    const auto* reqs = celix_resource_getRequirements(bench.resources.back(), nullptr);
+    auto* req = static_cast<celix_requirement_t*>(celix_arrayList_get(reqs, 0));
+    celix_autoptr(celix_filter_t) filter = celix_filter_create(celix_requirement_getFilter(req));
+    for (auto _ : state) {
+        // This code gets timed
+        int count = 0;
+        for (auto* res : bench.resources) {
+            const auto* caps = celix_resource_getCapabilities(res, celix_requirement_getNamespace(req));
+            for (int i = 0; i < celix_arrayList_size(caps); ++i) {
+                auto* cap = static_cast<celix_capability_t*>(celix_arrayList_get(caps, i));
+                count += celix_filter_match(filter, celix_capability_getAttributes(cap)) ? 1 : 0;
+            }
+        }
+        if (count != 1) {
+            std::cerr << "ERROR: expected 1 provider" << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define CELIX_RCM_BENCHMARK_RANGE RangeMultiplier(10)->Range(100, 10000)
+
+BENCHMARK(ResolverBenchmark_resolve)->CELIX_RCM_BENCHMARK_RANGE->Unit(benchmark::kMillisecond);
+BENCHMARK(ResolverBenchmark_resolveCached)->CELIX_RCM_BENCHMARK_RANGE->Unit(benchmark::kMillisecond);
+BENCHMARK(ResolverBenchmark_findProviders)->CELIX_RCM_BENCHMARK_RANGE;
+BENCHMARK(ResolverBenchmark_findProvidersLinearScan)->CELIX_RCM_BENCHMARK_RANGE;
@@ -0,0 +1,285 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "celix_capability.h"
+#include "celix_err.h"
+#include "celix_requirement.h"
+#include "celix_resolver.h"
+#include "celix_resource.h"
+
+class ResolverTestSuite : public ::testing::Test {
+public:
+    ResolverTestSuite() = default;
+
+    ~ResolverTestSuite() override {
+        for (auto* res : resources) {
+            celix_resource_destroy(res);
+        }
+        celix_err_resetErrors();
+    }
+
+    celix_resource_t* createResource() {
+        celix_resource_t* res = celix_resource_create();
+        EXPECT_NE(nullptr, res);
+        resources.push_back(res);
+        return res;
+    }
+
+    static bool contains(const celix_array_list_t* list, const void* ptr) {
+        for (int i = 0; i < celix_arrayList_size(list); ++i) {
+            if (celix_arrayList_get(list, i) == ptr) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static celix_capability_t* addCapability(celix_resource_t* res, const char* ns, const char* name, const char* version) {
+        celix_capability_t* cap = celix_capability_create(res, ns);
+        EXPECT_NE(nullptr, cap);
+        celix_capability_addAttribute(cap, ns, name);
+        celix_capability_addAttribute(cap, "version", version);
+        EXPECT_EQ(CELIX_SUCCESS, celix_resource_addCapability(res, cap));
+        return cap;
+    }
+
+    static celix_requirement_t* addRequirement(celix_resource_t* res, const char* ns, const char* filter, bool optional = false) {
+        celix_requirement_t* req = celix_requirement_create(res, ns, filter);
+        EXPECT_NE(nullptr, req);
+        if (optional) {
+            celix_requirement_addDirective(req, CELIX_RESOLVER_DIRECTIVE_RESOLUTION, CELIX_RESOLVER_RESOLUTION_OPTIONAL);
+        }
+        EXPECT_EQ(CELIX_SUCCESS, celix_resource_addRequirement(res, req));
+        return req;
+    }
+
+    std::vector<celix_resource_t*> resources{};
+};
+
+TEST_F(ResolverTestSuite, CreateDestroyTest) {
+    celix_autoptr(celix_resolver_t) resolver = celix_resolver_create();
+    ASSERT_NE(nullptr, resolver);
+    EXPECT_EQ(0, celix_resolver_getResourceCount(resolver));
+}
+
+TEST_F(ResolverTestSuite, AddAndRemoveResourceTest) {
+    celix_autoptr(celix_resolver_t) resolver = celix_resolver_create();
+    auto* res = createResource();
+    addCapability(res, "test.package", "foo", "1.0.0");
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res));
+    EXPECT_EQ(1, celix_resolver_getResourceCount(resolver));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_resolver_addResource(resolver, res));
+    EXPECT_EQ(1, celix_resolver_getResourceCount(resolver));
+
+    EXPECT_TRUE(celix_resolver_removeResource(resolver, res));
+    EXPECT_FALSE(celix_resolver_removeResource(resolver, res));
+    EXPECT_EQ(0, celix_resolver_getResourceCount(resolver));
+}
+
+TEST_F(ResolverTestSuite, FindProvidersTest) {
+    celix_autoptr(celix_resolver_t) resolver = celix_resolver_create();
+    auto* res1 = createResource();
+    auto* res2 = createResource();
+    auto* res3 = createResource();
+    auto* cap1 = addCapability(res1, "test.package", "foo", "1.0.0");
+    auto* cap2 = addCapability(res2, "test.package", "foo", "2.0.0");
+    auto* cap3 = addCapability(res2, "test.package", "bar", "1.0.0");
+    addCapability(res3, "test.other", "foo", "1.0.0");
+    auto* req1 = addRequirement(res3, "test.package", "(&(test.package=foo)(version>=1.5.0))");
+    auto* req2 = addRequirement(res3, "test.package", "(test.package=foo)");
+    auto* req3 = addRequirement(res3, "test.package", "(|(test.package=foo)(test.package=bar))");
+    auto* req4 = addRequirement(res3, "test.package", "(test.package=baz)");
+    auto* req5 = addRequirement(res3, "test.package", nullptr);
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res1));
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res2));
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res3));
+
+    //indexed lookup with an additional (non indexed) attribute constraint
+    auto* providers = celix_resolver_findProviders(resolver, req1);
+    ASSERT_NE(nullptr, providers);
+    ASSERT_EQ(1, celix_arrayList_size(providers));
+    EXPECT_EQ(cap2, celix_arrayList_get(providers, 0));
+
+    //providers are ordered by the order in which they are added
+    providers = celix_resolver_findProviders(resolver, req2);
+    ASSERT_EQ(2, celix_arrayList_size(providers));
+    EXPECT_EQ(cap1, celix_arrayList_get(providers, 0));
+    EXPECT_EQ(cap2, celix_arrayList_get(providers, 1));
+
+    //or filter is not indexed, so all capabilities of the namespace are matched
+    providers = celix_resolver_findProviders(resolver, req3);
+    EXPECT_EQ(3, celix_arrayList_size(providers));
+    EXPECT_EQ(cap3, celix_arrayList_get(providers, 2));
+
+    EXPECT_EQ(0, celix_arrayList_size(celix_resolver_findProviders(resolver, req4)));
+    EXPECT_EQ(3, celix_arrayList_size(celix_resolver_findProviders(resolver, req5)));
+
+    //lookups are cached per namespace and filter
+    EXPECT_EQ(providers, celix_resolver_findProviders(resolver, req3));
+    celix_requirement_t* sameFilterReq =
+        celix_requirement_create(nullptr, "test.package", "(|(test.package=foo)(test.package=bar))");
+    EXPECT_EQ(providers, celix_resolver_findProviders(resolver, sameFilterReq));
+    celix_requirement_destroy(sameFilterReq);
+
+    //removing a resource invalidates the lookups of the namespaces of its capabilities
+    EXPECT_TRUE(celix_resolver_removeResource(resolver, res1));
+    providers = celix_resolver_findProviders(resolver, req2);
+    ASSERT_EQ(1, celix_arrayList_size(providers));
+    EXPECT_EQ(cap2, celix_arrayList_get(providers, 0));
+
+    //re-adding a resource, adds its capabilities at the end of the providers
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res1));
+    providers = celix_resolver_findProviders(resolver, req2);
+    ASSERT_EQ(2, celix_arrayList_size(providers));
+    EXPECT_EQ(cap2, celix_arrayList_get(providers, 0));
+    EXPECT_EQ(cap1, celix_arrayList_get(providers, 1));
+}
+
+TEST_F(ResolverTestSuite, RemoveResourceWithMultipleCapabilitiesTest) {
+    celix_autoptr(celix_resolver_t) resolver = celix_resolver_create();
+    auto* res1 = createResource();
+    auto* res2 = createResource();
+    auto* res3 = createResource();
+    auto* cap1 = addCapability(res1, "test.package", "foo", "1.0.0");
+    auto* cap2 = addCapability(res2, "test.package", "foo", "2.0.0");
+    auto* cap3 = addCapability(res2, "test.package", "bar", "1.0.0");
+    auto* fooReq = addRequirement(res3, "test.package", "(test.package=foo)");
+    auto* barReq = addRequirement(res3, "test.package", "(test.package=bar)");
+    auto* allReq = addRequirement(res3, "test.package", nullptr);
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res1));
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res2));
+    EXPECT_EQ(3, celix_arrayList_size(celix_resolver_findProviders(resolver, allReq)));
+
+    //removing a resource with multiple capabilities in the same namespace, removes all its capabilities
+    EXPECT_TRUE(celix_resolver_removeResource(resolver, res2));
+    auto* providers = celix_resolver_findProviders(resolver, fooReq);
+    ASSERT_EQ(1, celix_arrayList_size(providers));
+    EXPECT_EQ(cap1, celix_arrayList_get(providers, 0));
+    EXPECT_EQ(0, celix_arrayList_size(celix_resolver_findProviders(resolver, barReq)));
+    EXPECT_EQ(1, celix_arrayList_size(celix_resolver_findProviders(resolver, allReq)));
+
+    //and the resource can be re-added
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res2));
+    providers = celix_resolver_findProviders(resolver, barReq);
+    ASSERT_EQ(1, celix_arrayList_size(providers));
+    EXPECT_EQ(cap3, celix_arrayList_get(providers, 0));
+    providers = celix_resolver_findProviders(resolver, fooReq);
+    ASSERT_EQ(2, celix_arrayList_size(providers));
+    EXPECT_EQ(cap2, celix_arrayList_get(providers, 1));
+}
+
+TEST_F(ResolverTestSuite, FindProvidersWithInvalidFilterTest) {
+    celix_autoptr(celix_resolver_t) resolver = celix_resolver_create();
+    auto* res = createResource();
+    auto* req = addRequirement(res, "test.package", "(invalid");
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res));
+
+    EXPECT_EQ(nullptr, celix_resolver_findProviders(resolver, req));
+    EXPECT_GE(celix_err_getErrorCount(), 1);
+
+    celix_resolution_t* resolution = nullptr;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_resolver_resolve(resolver, &resolution));
+    EXPECT_EQ(nullptr, resolution);
+}
+
+TEST_F(ResolverTestSuite, ResolveTest) {
+    celix_autoptr(celix_resolver_t) resolver = celix_resolver_create();
+    auto* res1 = createResource();
+    auto* res2 = createResource();
+    auto* res3 = createResource();
+    auto* res4 = createResource();
+
+    //res1 provides foo and optionally requires baz (not available)
+    auto* fooCap = addCapability(res1, "test.package", "foo", "1.0.0");
+    auto* bazReq = addRequirement(res1, "test.package", "(test.package=baz)", true);
+
+    //res2 provides bar and requires foo
+    auto* barCap = addCapability(res2, "test.package", "bar", "1.0.0");
+    auto* fooReq = addRequirement(res2, "test.package", "(test.package=foo)");
+
+    //res3 provides qux and requires quux (not available), so cannot be resolved
+    addCapability(res3, "test.package", "qux", "1.0.0");
+    auto* quuxReq = addRequirement(res3, "test.package", "(test.package=quux)");
+
+    //res4 requires bar and qux, qux is provided by the unresolved res3, so cannot be resolved
+    auto* barReq = addRequirement(res4, "test.package", "(test.package=bar)");
+    auto* quxReq = addRequirement(res4, "test.package", "(test.package=qux)");
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res1));
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res2));
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res3));
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res4));
+
+    celix_autoptr(celix_resolution_t) resolution = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_resolver_resolve(resolver, &resolution));
+    ASSERT_NE(nullptr, resolution);
+
+    EXPECT_TRUE(celix_resolution_isResolved(resolution, res1));
+    EXPECT_TRUE(celix_resolution_isResolved(resolution, res2));
+    EXPECT_FALSE(celix_resolution_isResolved(resolution, res3));
+    EXPECT_FALSE(celix_resolution_isResolved(resolution, res4));
+
+    EXPECT_EQ(nullptr, celix_resolution_getProvider(resolution, bazReq));
+    EXPECT_EQ(fooCap, celix_resolution_getProvider(resolution, fooReq));
+    EXPECT_EQ(nullptr, celix_resolution_getProvider(resolution, quuxReq));
+    EXPECT_EQ(nullptr, celix_resolution_getProvider(resolution, barReq)); //res4 is not resolved, so not wired
+    EXPECT_EQ(nullptr, celix_resolution_getProvider(resolution, quxReq));
+    EXPECT_TRUE(contains(celix_resolver_findProviders(resolver, barReq), barCap));
+
+    auto* unresolvedReqs = celix_resolution_getUnresolvedRequirements(resolution);
+    ASSERT_EQ(2, celix_arrayList_size(unresolvedReqs));
+    EXPECT_TRUE(contains(unresolvedReqs, quuxReq));
+    EXPECT_TRUE(contains(unresolvedReqs, quxReq));
+
+    //when res3 is removed, res4 can still not be resolved
+    celix_resolution_destroy(celix_steal_ptr(resolution));
+    EXPECT_TRUE(celix_resolver_removeResource(resolver, res3));
+    ASSERT_EQ(CELIX_SUCCESS, celix_resolver_resolve(resolver, &resolution));
+    EXPECT_FALSE(celix_resolution_isResolved(resolution, res4));
+    EXPECT_FALSE(celix_resolution_isResolved(resolution, res3));
+    unresolvedReqs = celix_resolution_getUnresolvedRequirements(resolution);
+    ASSERT_EQ(1, celix_arrayList_size(unresolvedReqs));
+    EXPECT_EQ(quxReq, celix_arrayList_get(unresolvedReqs, 0));
+}
+
+TEST_F(ResolverTestSuite, ResolveCyclicDependenciesTest) {
+    celix_autoptr(celix_resolver_t) resolver = celix_resolver_create();
+    auto* res1 = createResource();
+    auto* res2 = createResource();
+
+    auto* fooCap = addCapability(res1, "test.package", "foo", "1.0.0");
+    auto* barReq = addRequirement(res1, "test.package", "(test.package=bar)");
+    auto* barCap = addCapability(res2, "test.package", "bar", "1.0.0");
+    auto* fooReq = addRequirement(res2, "test.package", "(test.package=foo)");
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res1));
+    EXPECT_EQ(CELIX_SUCCESS, celix_resolver_addResource(resolver, res2));
+
+    celix_autoptr(celix_resolution_t) resolution = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_resolver_resolve(resolver, &resolution));
+    EXPECT_TRUE(celix_resolution_isResolved(resolution, res1));
+    EXPECT_TRUE(celix_resolution_isResolved(resolution, res2));
+    EXPECT_EQ(barCap, celix_resolution_getProvider(resolution, barReq));
+    EXPECT_EQ(fooCap, celix_resolution_getProvider(resolution, fooReq));
+    EXPECT_EQ(0, celix_arrayList_size(celix_resolution_getUnresolvedRequirements(resolution)));
+}
@@ -0,0 +1,178 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_CELIX_RESOLVER_H
+#define CELIX_CELIX_RESOLVER_H
+
+#include <stdbool.h>
+
+#include "celix_rcm_types.h"
+#include "celix_array_list.h"
+#include "celix_cleanup.h"
+#include "celix_errno.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+* @file celix_resolver.h
+* @brief The celix_resolver_t resolves the requirements of resources against the capabilities of resources.
+*
+* The resolver indexes the capabilities of the added resources by namespace and by (string) attribute value, so that
+* a requirement filter with mandatory equal attributes, e.g. `(&(osgi.wiring.package=foo)(version>=1.0.0))`, only
+* needs to be matched against the capabilities which have one of these attribute values.
+* The capabilities matching a requirement filter are cached per namespace and filter until a resource with
+* capabilities in that namespace is added or removed.
+*
+* @thread_safety none
+*/
+
+/**
+ * @brief The requirement directive used to configure the resolution of a requirement.
+ */
+#define CELIX_RESOLVER_DIRECTIVE_RESOLUTION "resolution"
+
+/**
+ * @brief The resolution directive value for an optional requirement; an optional requirement does not need to be
+ * wired for a resource to be resolved.
+ */
+#define CELIX_RESOLVER_RESOLUTION_OPTIONAL "optional"
+
+typedef struct celix_resolver celix_resolver_t;
+typedef struct celix_resolution celix_resolution_t;
+
+/**
+ * @brief Creates a new resolver.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @return A new resolver.
+ * @retval NULL If the resolver could not be created.
+ */
+celix_resolver_t* celix_resolver_create();
+
+/**
+ * @brief Destroys the resolver.
+ * @param[in] resolver The resolver to destroy. Can be NULL.
+ */
+void celix_resolver_destroy(celix_resolver_t* resolver);
+
+CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(celix_resolver_t, celix_resolver_destroy)
+
+/**
+ * @brief Adds a resource to the resolver.
+ *
+ * The resolver does not take ownership of the resource. The resource must outlive the resolver (or be removed from
+ * the resolver) and its capabilities and requirements must not be changed while it is added to the resolver.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] resolver The resolver.
+ * @param[in] res The resource to add.
+ * @return CELIX_SUCCESS if the resource was added successfully.
+ * @retval CELIX_ILLEGAL_ARGUMENT If the resource is already added to the resolver.
+ * @retval ENOMEM If there is not enough memory to add the resource. The resolver is unchanged.
+ */
+celix_status_t celix_resolver_addResource(celix_resolver_t* resolver, const celix_resource_t* res);
+
+/**
+ * @brief Removes a resource from the resolver.
+ *
+ * Previously returned providers lists for requirements in a namespace of a capability of the resource are no longer
+ * valid after this call.
+ *
+ * @param[in] resolver The resolver.
+ * @param[in] res The resource to remove.
+ * @return true if the resource was removed, false if the resource was not added to the resolver.
+ */
+bool celix_resolver_removeResource(celix_resolver_t* resolver, const celix_resource_t* res);
+
+/**
+ * @brief Returns the number of resources added to the resolver.
+ */
+int celix_resolver_getResourceCount(const celix_resolver_t* resolver);
+
+/**
+ * @brief Finds the capabilities of the added resources which match the provided requirement.
+ *
+ * A capability matches a requirement if the namespace is equal and the requirement filter matches the capability
+ * attributes. The result is cached; requirements with the same namespace and filter share the same providers list.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] resolver The resolver.
+ * @param[in] req The requirement.
+ * @return An array list with the matching celix_capability_t* entries in the order in which they were added to the
+ *         resolver. The array list is owned by the resolver and valid until a resource with a capability in the
+ *         requirement namespace is added or removed.
+ * @retval NULL If the requirement filter is invalid or there is not enough memory.
+ */
+const celix_array_list_t* celix_resolver_findProviders(celix_resolver_t* resolver, const celix_requirement_t* req);
+
+/**
+ * @brief Resolves all resources added to the resolver in a single batch.
+ *
+ * A resource is resolved if every mandatory requirement (all requirements without a
+ * CELIX_RESOLVER_DIRECTIVE_RESOLUTION directive with value CELIX_RESOLVER_RESOLUTION_OPTIONAL) of the resource can be
+ * wired to a capability of a resolved resource. Resources which cannot be resolved are excluded as provider and this
+ * is repeated until the set of resolved resources is stable.
+ * Every requirement of a resolved resource is wired to the first matching capability of a resolved resource, if any.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] resolver The resolver.
+ * @param[out] resolution The resolution result. The caller is the owner of the resolution.
+ * @return CELIX_SUCCESS if the resources are resolved (this includes resources which cannot be resolved).
+ * @retval CELIX_ILLEGAL_ARGUMENT If a requirement has an invalid filter.
+ * @retval ENOMEM If there is not enough memory.
+ */
+celix_status_t celix_resolver_resolve(celix_resolver_t* resolver, celix_resolution_t** resolution);
+
+/**
+ * @brief Destroys the resolution.
+ * @param[in] resolution The resolution to destroy. Can be NULL.
+ */
+void celix_resolution_destroy(celix_resolution_t* resolution);
+
+CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(celix_resolution_t, celix_resolution_destroy)
+
+/**
+ * @brief Returns whether the provided resource is resolved.
+ */
+bool celix_resolution_isResolved(const celix_resolution_t* resolution, const celix_resource_t* res);
+
+/**
+ * @brief Returns the capability the provided requirement is wired to.
+ * @return The capability or NULL if the requirement is not wired.
+ */
+const celix_capability_t* celix_resolution_getProvider(const celix_resolution_t* resolution,
+                                                       const celix_requirement_t* req);
+
+/**
+ * @brief Returns the mandatory requirements of the unresolved resources which cannot be wired.
+ * @return An array list with celix_requirement_t* entries.
+ */
+const celix_array_list_t* celix_resolution_getUnresolvedRequirements(const celix_resolution_t* resolution);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //CELIX_CELIX_RESOLVER_H
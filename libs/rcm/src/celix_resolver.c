@@ -0,0 +1,571 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "celix_capability.h"
+#include "celix_err.h"
+#include "celix_filter.h"
+#include "celix_long_hash_map.h"
+#include "celix_requirement.h"
+#include "celix_resolver.h"
+#include "celix_resource.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_string_hash_map.h"
+#include "celix_utils.h"
+
+/**
+ * @brief A capability indexed by the resolver.
+ */
+typedef struct celix_resolver_capability_entry {
+    const celix_capability_t* capability;
+    unsigned long seq; //the order in which the capability is added to the resolver
+} celix_resolver_capability_entry_t;
+
+/**
+ * @brief The (cached) providers lookup for a requirement filter.
+ */
+typedef struct celix_resolver_lookup {
+    celix_filter_t* filter;
+    celix_array_list_t* providers; //NULL if not yet computed or invalidated
+} celix_resolver_lookup_t;
+
+/**
+ * @brief The capability index and providers lookups for a namespace.
+ */
+typedef struct celix_resolver_namespace {
+    celix_array_list_t* capabilities; //owner of the capability entries, ordered by seq
+    celix_string_hash_map_t* capabilitiesByAttribute; //key "<name>=<value>", value array list of capability entries
+    celix_array_list_t* unindexedCapabilities; //capability entries with one or more non string attributes
+    celix_string_hash_map_t* lookups; //key filter string, value celix_resolver_lookup_t*
+} celix_resolver_namespace_t;
+
+struct celix_resolver {
+    celix_long_hash_map_t* resources; //key resource pointer, value resource (weak ref)
+    celix_string_hash_map_t* namespaces; //key namespace, value celix_resolver_namespace_t*
+    unsigned long nextSeq;
+};
+
+struct celix_resolution {
+    celix_long_hash_map_t* resolvedResources; //key resource pointer, value resource (weak ref)
+    celix_long_hash_map_t* providers; //key requirement pointer, value capability (weak ref)
+    celix_array_list_t* unresolvedRequirements; //weak refs
+};
+
+static void celix_resolver_destroyList(void* list) {
+    celix_arrayList_destroy(list);
+}
+
+static void celix_resolver_destroyLookup(void* data) {
+    celix_resolver_lookup_t* lookup = data;
+    celix_filter_destroy(lookup->filter);
+    celix_arrayList_destroy(lookup->providers);
+    free(lookup);
+}
+
+static void celix_resolver_destroyNamespace(void* data) {
+    celix_resolver_namespace_t* ns = data;
+    if (ns != NULL) {
+        celix_stringHashMap_destroy(ns->lookups);
+        celix_stringHashMap_destroy(ns->capabilitiesByAttribute);
+        celix_arrayList_destroy(ns->unindexedCapabilities);
+        celix_arrayList_destroy(ns->capabilities);
+        free(ns);
+    }
+}
+
+static celix_resolver_namespace_t* celix_resolver_createNamespace() {
+    celix_resolver_namespace_t* ns = calloc(1, sizeof(*ns));
+    if (ns == NULL) {
+        celix_err_push("Failed to allocate resolver namespace. Out of memory.");
+        return NULL;
+    }
+
+    celix_array_list_create_options_t opts = CELIX_EMPTY_ARRAY_LIST_CREATE_OPTIONS;
+    opts.elementType = CELIX_ARRAY_LIST_ELEMENT_TYPE_POINTER;
+    opts.simpleRemovedCallback = free;
+    ns->capabilities = celix_arrayList_createWithOptions(&opts);
+    ns->unindexedCapabilities = celix_arrayList_createPointerArray();
+
+    celix_string_hash_map_create_options_t mapOpts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    mapOpts.simpleRemovedCallback = celix_resolver_destroyList;
+    ns->capabilitiesByAttribute = celix_stringHashMap_createWithOptions(&mapOpts);
+    mapOpts.simpleRemovedCallback = celix_resolver_destroyLookup;
+    ns->lookups = celix_stringHashMap_createWithOptions(&mapOpts);
+
+    if (ns->capabilities == NULL || ns->unindexedCapabilities == NULL || ns->capabilitiesByAttribute == NULL ||
+        ns->lookups == NULL) {
+        celix_err_push("Failed to allocate resolver namespace fields. Out of memory.");
+        celix_resolver_destroyNamespace(ns);
+        return NULL;
+    }
+    return ns;
+}
+
+static celix_resolver_namespace_t* celix_resolver_getOrCreateNamespace(celix_resolver_t* resolver, const char* name) {
+    celix_resolver_namespace_t* ns = celix_stringHashMap_get(resolver->namespaces, name);
+    if (ns == NULL) {
+        ns = celix_resolver_createNamespace();
+        if (ns == NULL) {
+            return NULL;
+        }
+        if (celix_stringHashMap_put(resolver->namespaces, name, ns) != CELIX_SUCCESS) {
+            celix_err_push("Failed to add resolver namespace. Out of memory.");
+            celix_resolver_destroyNamespace(ns);
+            return NULL;
+        }
+    }
+    return ns;
+}
+
+/**
+ * @brief Invalidates the providers lookups of the namespace, the parsed filters are kept.
+ */
+static void celix_resolver_invalidateLookups(celix_resolver_namespace_t* ns) {
+    CELIX_STRING_HASH_MAP_ITERATE(ns->lookups, iter) {
+        celix_resolver_lookup_t* lookup = iter.value.ptrValue;
+        celix_arrayList_destroy(lookup->providers);
+        lookup->providers = NULL;
+    }
+}
+
+celix_resolver_t* celix_resolver_create() {
+    celix_autofree celix_resolver_t* resolver = malloc(sizeof(*resolver));
+    if (resolver == NULL) {
+        celix_err_push("Failed to allocate celix_resolver_t. Out of memory.");
+        return NULL;
+    }
+    resolver->nextSeq = 0;
+    resolver->resources = celix_longHashMap_create();
+
+    celix_string_hash_map_create_options_t mapOpts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    mapOpts.simpleRemovedCallback = celix_resolver_destroyNamespace;
+    resolver->namespaces = celix_stringHashMap_createWithOptions(&mapOpts);
+
+    if (resolver->resources == NULL || resolver->namespaces == NULL) {
+        celix_err_push("Failed to allocate celix_resolver_t fields. Out of memory.");
+        celix_resolver_destroy(celix_steal_ptr(resolver));
+        return NULL;
+    }
+    return celix_steal_ptr(resolver);
+}
+
+void celix_resolver_destroy(celix_resolver_t* resolver) {
+    if (resolver != NULL) {
+        celix_stringHashMap_destroy(resolver->namespaces);
+        celix_longHashMap_destroy(resolver->resources);
+        free(resolver);
+    }
+}
+
+static celix_array_list_t* celix_resolver_getAttributeIndex(const celix_resolver_namespace_t* ns,
+                                                            const char* name,
+                                                            const char* value) {
+    char buf[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    char* key = celix_utils_writeOrCreateString(buf, sizeof(buf), "%s=%s", name, value);
+    if (key == NULL) {
+        return NULL;
+    }
+    celix_array_list_t* index = celix_stringHashMap_get(ns->capabilitiesByAttribute, key);
+    celix_utils_freeStringIfNotEqual(buf, key);
+    return index;
+}
+
+static celix_status_t celix_resolver_addToAttributeIndex(celix_resolver_namespace_t* ns,
+                                                         const char* name,
+                                                         const char* value,
+                                                         celix_resolver_capability_entry_t* entry) {
+    char buf[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    char* key = celix_utils_writeOrCreateString(buf, sizeof(buf), "%s=%s", name, value);
+    if (key == NULL) {
+        return ENOMEM;
+    }
+    celix_status_t status = CELIX_SUCCESS;
+    celix_array_list_t* index = celix_stringHashMap_get(ns->capabilitiesByAttribute, key);
+    if (index == NULL) {
+        index = celix_arrayList_createPointerArray();
+        status = index == NULL ? ENOMEM : celix_stringHashMap_put(ns->capabilitiesByAttribute, key, index);
+        if (status != CELIX_SUCCESS) {
+            celix_arrayList_destroy(index);
+            index = NULL;
+        }
+    }
+    celix_utils_freeStringIfNotEqual(buf, key);
+    return index == NULL ? status : celix_arrayList_add(index, entry);
+}
+
+static celix_status_t celix_resolver_indexCapability(celix_resolver_t* resolver, const celix_capability_t* cap) {
+    celix_resolver_namespace_t* ns = celix_resolver_getOrCreateNamespace(resolver, celix_capability_getNamespace(cap));
+    if (ns == NULL) {
+        return ENOMEM;
+    }
+    celix_resolver_invalidateLookups(ns);
+
+    celix_resolver_capability_entry_t* entry = malloc(sizeof(*entry));
+    if (entry == NULL) {
+        return ENOMEM;
+    }
+    entry->capability = cap;
+    entry->seq = resolver->nextSeq++;
+    celix_status_t status = celix_arrayList_add(ns->capabilities, entry); //note on error entry is freed
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+
+    bool indexed = true;
+    CELIX_PROPERTIES_ITERATE(celix_capability_getAttributes(cap), visit) {
+        if (visit.entry.valueType != CELIX_PROPERTIES_VALUE_TYPE_STRING) {
+            //note a typed attribute can match a filter value with a different string representation (e.g. 1 and 01)
+            indexed = false;
+            continue;
+        }
+        status = celix_resolver_addToAttributeIndex(ns, visit.key, visit.entry.value, entry);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+    if (!indexed) {
+        status = celix_arrayList_add(ns->unindexedCapabilities, entry);
+    }
+    return status;
+}
+
+static bool celix_resolver_isEntryOfCapability(void* data, celix_array_list_entry_t entry) {
+    const celix_resolver_capability_entry_t* capEntry = entry.voidPtrVal;
+    return capEntry->capability == data;
+}
+
+static void celix_resolver_removeCapability(celix_resolver_t* resolver, const celix_capability_t* cap) {
+    celix_resolver_namespace_t* ns = celix_stringHashMap_get(resolver->namespaces, celix_capability_getNamespace(cap));
+    if (ns == NULL) {
+        return;
+    }
+    celix_resolver_invalidateLookups(ns);
+    CELIX_PROPERTIES_ITERATE(celix_capability_getAttributes(cap), visit) {
+        celix_array_list_t* index = celix_resolver_getAttributeIndex(ns, visit.key, visit.entry.value);
+        if (index != NULL) {
+            celix_arrayList_removeIf(index, celix_resolver_isEntryOfCapability, (void*)cap);
+        }
+    }
+    celix_arrayList_removeIf(ns->unindexedCapabilities, celix_resolver_isEntryOfCapability, (void*)cap);
+    celix_arrayList_removeIf(ns->capabilities, celix_resolver_isEntryOfCapability, (void*)cap); //note frees the entry
+}
+
+celix_status_t celix_resolver_addResource(celix_resolver_t* resolver, const celix_resource_t* res) {
+    if (celix_longHashMap_hasKey(resolver->resources, (long)(intptr_t)res)) {
+        celix_err_push("Resource is already added to the resolver.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_status_t status = celix_longHashMap_put(resolver->resources, (long)(intptr_t)res, (void*)res);
+    const celix_array_list_t* caps = celix_resource_getCapabilities(res, NULL);
+    for (int i = 0; status == CELIX_SUCCESS && i < celix_arrayList_size(caps); ++i) {
+        status = celix_resolver_indexCapability(resolver, celix_arrayList_get(caps, i));
+    }
+    if (status != CELIX_SUCCESS) {
+        celix_err_push("Failed to add resource to resolver. Out of memory.");
+        (void)celix_resolver_removeResource(resolver, res);
+    }
+    return status;
+}
+
+bool celix_resolver_removeResource(celix_resolver_t* resolver, const celix_resource_t* res) {
+    if (!celix_longHashMap_remove(resolver->resources, (long)(intptr_t)res)) {
+        return false;
+    }
+    const celix_array_list_t* caps = celix_resource_getCapabilities(res, NULL);
+    for (int i = 0; i < celix_arrayList_size(caps); ++i) {
+        celix_resolver_removeCapability(resolver, celix_arrayList_get(caps, i));
+    }
+    return true;
+}
+
+int celix_resolver_getResourceCount(const celix_resolver_t* resolver) {
+    return (int)celix_longHashMap_size(resolver->resources);
+}
+
+/**
+ * @brief Selects the smallest attribute index for the mandatory equal attributes of the filter.
+ *
+ * Only the filter itself or the children of a (nested) and filter are mandatory; for other filter operands the
+ * candidates are left unchanged.
+ */
+static void celix_resolver_selectCandidates(const celix_resolver_namespace_t* ns,
+                                            const celix_filter_t* filter,
+                                            const celix_array_list_t** candidates,
+                                            bool* indexed) {
+    if (filter->operand == CELIX_FILTER_OPERAND_EQUAL) {
+        char buf[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+        char* key = celix_utils_writeOrCreateString(buf, sizeof(buf), "%s=%s", filter->attribute, filter->value);
+        if (key == NULL) {
+            return; //note the index is an optimization, so fallback to the current candidates
+        }
+        const celix_array_list_t* index = celix_stringHashMap_get(ns->capabilitiesByAttribute, key);
+        celix_utils_freeStringIfNotEqual(buf, key);
+        int size = index == NULL ? 0 : celix_arrayList_size(index);
+        if (!*indexed || size < (*candidates == NULL ? 0 : celix_arrayList_size(*candidates))) {
+            *candidates = index;
+            *indexed = true;
+        }
+    } else if (filter->operand == CELIX_FILTER_OPERAND_AND) {
+        for (int i = 0; i < celix_arrayList_size(filter->children); ++i) {
+            celix_resolver_selectCandidates(ns, celix_arrayList_get(filter->children, i), candidates, indexed);
+        }
+    }
+}
+
+static celix_resolver_capability_entry_t* celix_resolver_getEntry(const celix_array_list_t* list, int index) {
+    if (list == NULL || index >= celix_arrayList_size(list)) {
+        return NULL;
+    }
+    return celix_arrayList_get(list, index);
+}
+
+static celix_status_t celix_resolver_computeProviders(const celix_resolver_namespace_t* ns,
+                                                      celix_resolver_lookup_t* lookup) {
+    celix_autoptr(celix_array_list_t) providers = celix_arrayList_createPointerArray();
+    if (providers == NULL) {
+        return ENOMEM;
+    }
+
+    const celix_array_list_t* candidates = NULL;
+    bool indexed = false;
+    celix_resolver_selectCandidates(ns, lookup->filter, &candidates, &indexed);
+    if (!indexed) {
+        candidates = ns->capabilities;
+    }
+    //note capabilities with typed attributes are not in the attribute index, so always candidates
+    const celix_array_list_t* unindexed = indexed ? ns->unindexedCapabilities : NULL;
+
+    //merge the candidates and unindexed capabilities, so that the providers are ordered by seq
+    int i = 0;
+    int j = 0;
+    celix_resolver_capability_entry_t* a = celix_resolver_getEntry(candidates, i);
+    celix_resolver_capability_entry_t* b = celix_resolver_getEntry(unindexed, j);
+    while (a != NULL || b != NULL) {
+        celix_resolver_capability_entry_t* entry;
+        if (b == NULL || (a != NULL && a->seq <= b->seq)) {
+            entry = a;
+            if (b != NULL && a->seq == b->seq) {
+                b = celix_resolver_getEntry(unindexed, ++j);
+            }
+            a = celix_resolver_getEntry(candidates, ++i);
+        } else {
+            entry = b;
+            b = celix_resolver_getEntry(unindexed, ++j);
+        }
+        if (celix_filter_match(lookup->filter, celix_capability_getAttributes(entry->capability))) {
+            celix_status_t status = celix_arrayList_add(providers, (void*)entry->capability);
+            if (status != CELIX_SUCCESS) {
+                return status;
+            }
+        }
+    }
+    lookup->providers = celix_steal_ptr(providers);
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_resolver_findProvidersInternal(celix_resolver_t* resolver,
+                                                           const celix_requirement_t* req,
+                                                           const celix_array_list_t** providers) {
+    celix_resolver_namespace_t* ns = celix_resolver_getOrCreateNamespace(resolver, celix_requirement_getNamespace(req));
+    if (ns == NULL) {
+        return ENOMEM;
+    }
+
+    const char* filterStr = celix_requirement_getFilter(req);
+    filterStr = filterStr == NULL ? "" : filterStr;
+    celix_resolver_lookup_t* lookup = celix_stringHashMap_get(ns->lookups, filterStr);
+    if (lookup == NULL) {
+        celix_filter_t* filter = celix_filter_create(filterStr);
+        if (filter == NULL) {
+            celix_err_pushf("Invalid requirement filter '%s'.", filterStr);
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+        lookup = calloc(1, sizeof(*lookup));
+        if (lookup == NULL) {
+            celix_filter_destroy(filter);
+            celix_err_push("Failed to allocate resolver lookup. Out of memory.");
+            return ENOMEM;
+        }
+        lookup->filter = filter;
+        if (celix_stringHashMap_put(ns->lookups, filterStr, lookup) != CELIX_SUCCESS) {
+            celix_resolver_destroyLookup(lookup);
+            celix_err_push("Failed to add resolver lookup. Out of memory.");
+            return ENOMEM;
+        }
+    }
+
+    if (lookup->providers == NULL) {
+        celix_status_t status = celix_resolver_computeProviders(ns, lookup);
+        if (status != CELIX_SUCCESS) {
+            celix_err_push("Failed to find providers. Out of memory.");
+            return status;
+        }
+    }
+    *providers = lookup->providers;
+    return CELIX_SUCCESS;
+}
+
+const celix_array_list_t* celix_resolver_findProviders(celix_resolver_t* resolver, const celix_requirement_t* req) {
+    const celix_array_list_t* providers = NULL;
+    (void)celix_resolver_findProvidersInternal(resolver, req, &providers);
+    return providers;
+}
+
+static bool celix_resolver_isMandatory(const celix_requirement_t* req) {
+    const char* resolution = celix_requirement_getDirective(req, CELIX_RESOLVER_DIRECTIVE_RESOLUTION);
+    return !celix_utils_stringEquals(resolution, CELIX_RESOLVER_RESOLUTION_OPTIONAL);
+}
+
+static const celix_capability_t* celix_resolver_findResolvedProvider(const celix_array_list_t* providers,
+                                                                     const celix_long_hash_map_t* unresolved) {
+    for (int i = 0; i < celix_arrayList_size(providers); ++i) {
+        const celix_capability_t* cap = celix_arrayList_get(providers, i);
+        if (!celix_longHashMap_hasKey(unresolved, (long)(intptr_t)celix_capability_getResource(cap))) {
+            return cap;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Marks the resources which have a mandatory requirement without a provider of a resolved resource as
+ * unresolved, until no resource is marked anymore.
+ */
+static celix_status_t celix_resolver_findUnresolvedResources(celix_resolver_t* resolver,
+                                                             celix_long_hash_map_t* unresolved) {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        CELIX_LONG_HASH_MAP_ITERATE(resolver->resources, iter) {
+            const celix_resource_t* res = iter.value.ptrValue;
+            if (celix_longHashMap_hasKey(unresolved, iter.key)) {
+                continue;
+            }
+            const celix_array_list_t* reqs = celix_resource_getRequirements(res, NULL);
+            for (int i = 0; i < celix_arrayList_size(reqs); ++i) {
+                const celix_requirement_t* req = celix_arrayList_get(reqs, i);
+                if (!celix_resolver_isMandatory(req)) {
+                    continue;
+                }
+                const celix_array_list_t* providers = NULL;
+                celix_status_t status = celix_resolver_findProvidersInternal(resolver, req, &providers);
+                if (status != CELIX_SUCCESS) {
+                    return status;
+                }
+                if (celix_resolver_findResolvedProvider(providers, unresolved) == NULL) {
+                    status = celix_longHashMap_put(unresolved, iter.key, (void*)res);
+                    if (status != CELIX_SUCCESS) {
+                        return status;
+                    }
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_resolver_wireResource(celix_resolver_t* resolver,
+                                                  celix_resolution_t* resolution,
+                                                  const celix_resource_t* res,
+                                                  const celix_long_hash_map_t* unresolved) {
+    bool resolved = !celix_longHashMap_hasKey(unresolved, (long)(intptr_t)res);
+    if (resolved) {
+        celix_status_t status = celix_longHashMap_put(resolution->resolvedResources, (long)(intptr_t)res, (void*)res);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+    const celix_array_list_t* reqs = celix_resource_getRequirements(res, NULL);
+    for (int i = 0; i < celix_arrayList_size(reqs); ++i) {
+        const celix_requirement_t* req = celix_arrayList_get(reqs, i);
+        const celix_array_list_t* providers = NULL;
+        celix_status_t status = celix_resolver_findProvidersInternal(resolver, req, &providers);
+        const celix_capability_t* provider =
+            status == CELIX_SUCCESS ? celix_resolver_findResolvedProvider(providers, unresolved) : NULL;
+        if (status == CELIX_SUCCESS && resolved && provider != NULL) {
+            status = celix_longHashMap_put(resolution->providers, (long)(intptr_t)req, (void*)provider);
+        } else if (status == CELIX_SUCCESS && !resolved && provider == NULL && celix_resolver_isMandatory(req)) {
+            status = celix_arrayList_add(resolution->unresolvedRequirements, (void*)req);
+        }
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_resolver_resolve(celix_resolver_t* resolver, celix_resolution_t** resolutionOut) {
+    celix_autoptr(celix_resolution_t) resolution = calloc(1, sizeof(*resolution));
+    celix_autoptr(celix_long_hash_map_t) unresolved = celix_longHashMap_create();
+    if (resolution == NULL || unresolved == NULL) {
+        celix_err_push("Failed to allocate celix_resolution_t. Out of memory.");
+        return ENOMEM;
+    }
+    resolution->resolvedResources = celix_longHashMap_create();
+    resolution->providers = celix_longHashMap_create();
+    resolution->unresolvedRequirements = celix_arrayList_createPointerArray();
+    if (resolution->resolvedResources == NULL || resolution->providers == NULL ||
+        resolution->unresolvedRequirements == NULL) {
+        celix_err_push("Failed to allocate celix_resolution_t fields. Out of memory.");
+        return ENOMEM;
+    }
+
+    celix_status_t status = celix_resolver_findUnresolvedResources(resolver, unresolved);
+    CELIX_LONG_HASH_MAP_ITERATE(resolver->resources, iter) {
+        if (status != CELIX_SUCCESS) {
+            break;
+        }
+        status = celix_resolver_wireResource(resolver, resolution, iter.value.ptrValue, unresolved);
+    }
+    if (status != CELIX_SUCCESS) {
+        if (status == ENOMEM) {
+            celix_err_push("Failed to resolve resources. Out of memory.");
+        }
+        return status;
+    }
+
+    *resolutionOut = celix_steal_ptr(resolution);
+    return CELIX_SUCCESS;
+}
+
+void celix_resolution_destroy(celix_resolution_t* resolution) {
+    if (resolution != NULL) {
+        celix_longHashMap_destroy(resolution->resolvedResources);
+        celix_longHashMap_destroy(resolution->providers);
+        celix_arrayList_destroy(resolution->unresolvedRequirements);
+        free(resolution);
+    }
+}
+
+bool celix_resolution_isResolved(const celix_resolution_t* resolution, const celix_resource_t* res) {
+    return celix_longHashMap_hasKey(resolution->resolvedResources, (long)(intptr_t)res);
+}
+
+const celix_capability_t* celix_resolution_getProvider(const celix_resolution_t* resolution,
+                                                       const celix_requirement_t* req) {
+    return celix_longHashMap_get(resolution->providers, (long)(intptr_t)req);
+}
+
+const celix_array_list_t* celix_resolution_getUnresolvedRequirements(const celix_resolution_t* resolution) {
+    return resolution->unresolvedRequirements;
+}
@@ -0,0 +1,177 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+
+#include "celix_array_list.h"
+
+/**
+ * Benchmarks comparing the celix array list single entry operations with the sorted and bulk operations.
+ */
+static celix_array_list_t* createLongArrayList(int64_t nrOfEntries) {
+    celix_array_list_t* list = celix_arrayList_createLongArray();
+    for (int64_t i = 0; i < nrOfEntries; ++i) {
+        celix_arrayList_addLong(list, (long)i);
+    }
+    return list;
+}
+
+static celix_array_list_entry_t createLongEntry(long val) {
+    celix_array_list_entry_t entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.longVal = val;
+    return entry;
+}
+
+static bool isEven(void* /*data*/, celix_array_list_entry_t entry) {
+    return entry.longVal % 2 == 0;
+}
+
+static void ArrayListBenchmark_findUsingIndexOf(benchmark::State& state) {
+    celix_autoptr(celix_array_list_t) list = createLongArrayList(state.range(0));
+    auto entry = createLongEntry((long)(state.range(0) / 2));
+    for (auto _ : state) {
+        // This code gets timed
+        benchmark::DoNotOptimize(celix_arrayList_indexOf(list, entry));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void ArrayListBenchmark_findUsingBinarySearch(benchmark::State& state) {
+    celix_autoptr(celix_array_list_t) list = createLongArrayList(state.range(0));
+    auto entry = createLongEntry((long)(state.range(0) / 2));
+    for (auto _ : state) {
+        // This code gets timed
+        benchmark::DoNotOptimize(celix_arrayList_binarySearch(list, entry));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void ArrayListBenchmark_fillUsingAddEntrySorted(benchmark::State& state) {
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createLongArray();
+    for (auto _ : state) {
+        // This code gets timed
+        for (int64_t i = state.range(0); i > 0; --i) {
+            celix_arrayList_addEntrySorted(list, createLongEntry((long)i));
+        }
+        state.PauseTiming();
+        celix_arrayList_clear(list);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void ArrayListBenchmark_fillUsingAdd(benchmark::State& state) {
+    celix_autoptr(celix_array_list_t) source = createLongArrayList(state.range(0));
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createLongArray();
+    for (auto _ : state) {
+        // This code gets timed
+        for (int i = 0; i < celix_arrayList_size(source); ++i) {
+            celix_arrayList_addLong(list, celix_arrayList_getLong(source, i));
+        }
+        state.PauseTiming();
+        celix_arrayList_destroy(list);
+        list = celix_arrayList_createLongArray();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void ArrayListBenchmark_fillUsingAddAll(benchmark::State& state) {
+    celix_autoptr(celix_array_list_t) source = createLongArrayList(state.range(0));
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createLongArray();
+    for (auto _ : state) {
+        // This code gets timed
+        celix_arrayList_addAll(list, source);
+        state.PauseTiming();
+        celix_arrayList_destroy(list);
+        list = celix_arrayList_createLongArray();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void ArrayListBenchmark_removeHalfUsingRemove(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        celix_autoptr(celix_array_list_t) list = createLongArrayList(state.range(0));
+        state.ResumeTiming();
+        // This code gets timed
+        for (int64_t i = 0; i < state.range(0); i += 2) {
+            celix_arrayList_removeLong(list, (long)i);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) / 2);
+}
+
+static void ArrayListBenchmark_removeHalfUsingRemoveIf(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        celix_autoptr(celix_array_list_t) list = createLongArrayList(state.range(0));
+        state.ResumeTiming();
+        // This code gets timed
+        celix_arrayList_removeIf(list, isEven, nullptr);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) / 2);
+}
+
+static void ArrayListBenchmark_removeAllUsingRemoveAt(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        celix_autoptr(celix_array_list_t) list = createLongArrayList(state.range(0));
+        state.ResumeTiming();
+        // This code gets timed
+        while (celix_arrayList_size(list) > 0) {
+            celix_arrayList_removeAt(list, 0);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void ArrayListBenchmark_removeAllUsingSwapRemoveAt(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        celix_autoptr(celix_array_list_t) list = createLongArrayList(state.range(0));
+        state.ResumeTiming();
+        // This code gets timed
+        while (celix_arrayList_size(list) > 0) {
+            celix_arrayList_swapRemoveAt(list, 0);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond) \
+        ->RangeMultiplier(10)->Range(10, 10000)
+
+CELIX_BENCHMARK(ArrayListBenchmark_findUsingIndexOf); //reference
+CELIX_BENCHMARK(ArrayListBenchmark_findUsingBinarySearch);
+
+CELIX_BENCHMARK(ArrayListBenchmark_fillUsingAddEntrySorted);
+
+CELIX_BENCHMARK(ArrayListBenchmark_fillUsingAdd); //reference
+CELIX_BENCHMARK(ArrayListBenchmark_fillUsingAddAll);
+
+CELIX_BENCHMARK(ArrayListBenchmark_removeHalfUsingRemove); //reference
+CELIX_BENCHMARK(ArrayListBenchmark_removeHalfUsingRemoveIf);
+
+CELIX_BENCHMARK(ArrayListBenchmark_removeAllUsingRemoveAt); //reference
+CELIX_BENCHMARK(ArrayListBenchmark_removeAllUsingSwapRemoveAt);
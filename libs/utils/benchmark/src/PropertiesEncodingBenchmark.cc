@@ -0,0 +1,142 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "celix_properties.h"
+#include "celix_stdlib_cleanup.h"
+
+class PropertiesEncodingBenchmark {
+public:
+    explicit PropertiesEncodingBenchmark(benchmark::State& state, int encodeFlags) {
+        int64_t nrOfEntries = state.range(0);
+        for (int64_t i = 0; i < nrOfEntries; ++i) {
+            std::string key = "group" + std::to_string(i % 10) + ".service" + std::to_string(i % 100) + ".key" +
+                              std::to_string(i);
+            switch (i % 4) {
+            case 0:
+                celix_properties_set(props, key.c_str(), "a string value");
+                break;
+            case 1:
+                celix_properties_setLong(props, key.c_str(), (long)i);
+                break;
+            case 2:
+                celix_properties_setDouble(props, key.c_str(), (double)i / 3.0);
+                break;
+            default:
+                celix_properties_setBool(props, key.c_str(), i % 2 == 0);
+                break;
+            }
+        }
+        celix_autofree char* str = nullptr;
+        if (celix_properties_saveToString(props, encodeFlags, &str) != CELIX_SUCCESS) {
+            std::cerr << "ERROR: failed to encode properties" << std::endl;
+        } else {
+            json = str;
+        }
+    }
+
+    ~PropertiesEncodingBenchmark() {
+        celix_properties_destroy(props);
+    }
+
+    PropertiesEncodingBenchmark(const PropertiesEncodingBenchmark&) = delete;
+    PropertiesEncodingBenchmark& operator=(const PropertiesEncodingBenchmark&) = delete;
+
+    void checkSize(celix_properties_t* decoded, benchmark::State& state) {
+        if (decoded == nullptr || celix_properties_size(decoded) != (size_t)state.range(0)) {
+            std::cerr << "ERROR: unexpected number of decoded properties" << std::endl;
+        }
+    }
+
+    celix_properties_t* props{celix_properties_create()};
+    std::string json{};
+};
+
+static void PropertiesEncodingBenchmark_saveToStream(benchmark::State& state, int encodeFlags) {
+    PropertiesEncodingBenchmark benchmark{state, encodeFlags};
+    for (auto _ : state) {
+        // This code gets timed
+        celix_autofree char* buf = nullptr;
+        size_t bufLen = 0;
+        FILE* stream = open_memstream(&buf, &bufLen);
+        auto status = celix_properties_saveToStream(benchmark.props, stream, encodeFlags);
+        fclose(stream);
+        benchmark::DoNotOptimize(status);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * (int64_t)benchmark.json.size());
+}
+
+static void PropertiesEncodingBenchmark_encodeToStream(benchmark::State& state, int encodeFlags) {
+    PropertiesEncodingBenchmark benchmark{state, encodeFlags};
+    for (auto _ : state) {
+        // This code gets timed
+        celix_autofree char* buf = nullptr;
+        size_t bufLen = 0;
+        FILE* stream = open_memstream(&buf, &bufLen);
+        auto status = celix_properties_encodeToStream(benchmark.props, stream, encodeFlags);
+        fclose(stream);
+        benchmark::DoNotOptimize(status);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * (int64_t)benchmark.json.size());
+}
+
+static void PropertiesEncodingBenchmark_loadFromString(benchmark::State& state, int encodeFlags) {
+    PropertiesEncodingBenchmark benchmark{state, encodeFlags};
+    for (auto _ : state) {
+        // This code gets timed
+        celix_autoptr(celix_properties_t) decoded = nullptr;
+        (void)celix_properties_loadFromString2(benchmark.json.c_str(), 0, &decoded);
+        benchmark.checkSize(decoded, state);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * (int64_t)benchmark.json.size());
+}
+
+static void PropertiesEncodingBenchmark_decodeFromBuffer(benchmark::State& state, int encodeFlags) {
+    PropertiesEncodingBenchmark benchmark{state, encodeFlags};
+    for (auto _ : state) {
+        // This code gets timed
+        celix_autoptr(celix_properties_t) decoded = nullptr;
+        (void)celix_properties_decodeFromBuffer(benchmark.json.c_str(), benchmark.json.size(), 0, &decoded);
+        benchmark.checkSize(decoded, state);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * (int64_t)benchmark.json.size());
+}
+
+#define CELIX_PROPERTIES_ENCODING_BENCHMARK(func)                                                                      \
+    BENCHMARK_CAPTURE(func, flat, CELIX_PROPERTIES_ENCODE_FLAT_STYLE)                                                  \
+        ->RangeMultiplier(10)                                                                                          \
+        ->Range(10, 100000)                                                                                            \
+        ->Unit(benchmark::kMicrosecond);                                                                               \
+    BENCHMARK_CAPTURE(func, nested, CELIX_PROPERTIES_ENCODE_NESTED_STYLE)                                              \
+        ->RangeMultiplier(10)                                                                                          \
+        ->Range(10, 100000)                                                                                            \
+        ->Unit(benchmark::kMicrosecond)
+
+CELIX_PROPERTIES_ENCODING_BENCHMARK(PropertiesEncodingBenchmark_saveToStream);
+CELIX_PROPERTIES_ENCODING_BENCHMARK(PropertiesEncodingBenchmark_encodeToStream);
+CELIX_PROPERTIES_ENCODING_BENCHMARK(PropertiesEncodingBenchmark_loadFromString);
+CELIX_PROPERTIES_ENCODING_BENCHMARK(PropertiesEncodingBenchmark_decodeFromBuffer);
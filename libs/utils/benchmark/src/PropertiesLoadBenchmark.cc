@@ -0,0 +1,78 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "celix_properties.h"
+
+class PropertiesLoadBenchmark {
+public:
+    explicit PropertiesLoadBenchmark(benchmark::State& state) {
+        int64_t nrOfEntries = state.range(0);
+        FILE* file = fopen(filename.c_str(), "w");
+        for (int64_t i = 0; i < nrOfEntries; ++i) {
+            fprintf(file, "# entry %li\n", (long)i);
+            fprintf(file, "config.key%li = value %li with an escaped \\= character\n", (long)i, (long)i);
+        }
+        fclose(file);
+    }
+
+    ~PropertiesLoadBenchmark() {
+        remove(filename.c_str());
+    }
+
+    PropertiesLoadBenchmark(const PropertiesLoadBenchmark&) = delete;
+    PropertiesLoadBenchmark& operator=(const PropertiesLoadBenchmark&) = delete;
+
+    void checkSize(celix_properties_t* props, benchmark::State& state) {
+        if (props == nullptr || celix_properties_size(props) != (size_t)state.range(0)) {
+            std::cerr << "ERROR: unexpected number of loaded properties" << std::endl;
+        }
+    }
+
+    const std::string filename{"properties_load_benchmark.properties"};
+};
+
+static void PropertiesLoadBenchmark_load(benchmark::State& state) {
+    PropertiesLoadBenchmark benchmark{state};
+    for (auto _ : state) {
+        // This code gets timed
+        celix_autoptr(celix_properties_t) props = celix_properties_load(benchmark.filename.c_str());
+        benchmark.checkSize(props, state);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void PropertiesLoadBenchmark_loadWithStream(benchmark::State& state) {
+    PropertiesLoadBenchmark benchmark{state};
+    for (auto _ : state) {
+        // This code gets timed
+        FILE* file = fopen(benchmark.filename.c_str(), "r");
+        celix_autoptr(celix_properties_t) props = celix_properties_loadWithStream(file);
+        fclose(file);
+        benchmark.checkSize(props, state);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(PropertiesLoadBenchmark_load)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(PropertiesLoadBenchmark_loadWithStream)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
@@ -28,6 +28,7 @@ extern "C" {
 
 CELIX_EI_DECLARE(celix_properties_create, celix_properties_t*);
 CELIX_EI_DECLARE(celix_properties_copy, celix_properties_t*);
+CELIX_EI_DECLARE(celix_properties_share, const celix_properties_t*);
 CELIX_EI_DECLARE(celix_properties_set, celix_status_t);
 CELIX_EI_DECLARE(celix_properties_setLong, celix_status_t);
 CELIX_EI_DECLARE(celix_properties_setVersion, celix_status_t);
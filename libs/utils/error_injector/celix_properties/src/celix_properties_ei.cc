@@ -34,6 +34,13 @@ celix_properties_t *__wrap_celix_properties_copy(const celix_properties_t *prope
     return __real_celix_properties_copy(properties);
 }
 
+const celix_properties_t *__real_celix_properties_share(const celix_properties_t *properties);
+CELIX_EI_DEFINE(celix_properties_share, const celix_properties_t*)
+const celix_properties_t *__wrap_celix_properties_share(const celix_properties_t *properties) {
+    CELIX_EI_IMPL(celix_properties_share);
+    return __real_celix_properties_share(properties);
+}
+
 celix_status_t __real_celix_properties_set(celix_properties_t *properties, const char *key, const char *value);
 CELIX_EI_DEFINE(celix_properties_set, celix_status_t)
 celix_status_t __wrap_celix_properties_set(celix_properties_t *properties, const char *key, const char *value) {
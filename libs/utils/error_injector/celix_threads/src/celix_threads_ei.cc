@@ -56,6 +56,13 @@ celix_status_t __wrap_celixThreadRwlock_create(celix_thread_rwlock_t *__rwlock,
     return __real_celixThreadRwlock_create(__rwlock, __attr);
 }
 
+celix_status_t __real_celixThreadRbRwlock_create(celix_thread_rb_rwlock_t* __rwlock);
+CELIX_EI_DEFINE(celixThreadRbRwlock_create, celix_status_t)
+celix_status_t __wrap_celixThreadRbRwlock_create(celix_thread_rb_rwlock_t* __rwlock) {
+    CELIX_EI_IMPL(celixThreadRbRwlock_create);
+    return __real_celixThreadRbRwlock_create(__rwlock);
+}
+
 
 celix_status_t __real_celix_tss_create(celix_tss_key_t* __key, void (*__destroyFunction)(void*));
 CELIX_EI_DEFINE(celix_tss_create, celix_status_t)
@@ -41,6 +41,8 @@ CELIX_EI_DECLARE(celix_utils_extractZipData, celix_status_t);
 
 CELIX_EI_DECLARE(celix_utils_extractZipFile, celix_status_t);
 
+CELIX_EI_DECLARE(celix_utils_extractZipFileIncrementally, celix_status_t);
+
 CELIX_EI_DECLARE(celix_utils_trim, char *);
 
 CELIX_EI_DECLARE(celix_gettime, struct timespec);
@@ -92,6 +92,16 @@ celix_status_t __wrap_celix_utils_extractZipFile(const char *zipFilePath, const
     return __real_celix_utils_extractZipFile(zipFilePath, extractToDir, errorOut);
 }
 
+celix_status_t __real_celix_utils_extractZipFileIncrementally(const char* zipPath, const char* extractToDir, const char* contentStoreDir, const char* indexPath, const char** errorOut);
+CELIX_EI_DEFINE(celix_utils_extractZipFileIncrementally, celix_status_t)
+celix_status_t __wrap_celix_utils_extractZipFileIncrementally(const char* zipPath, const char* extractToDir, const char* contentStoreDir, const char* indexPath, const char** errorOut) {
+    if (errorOut) {
+        *errorOut = "Error Injected";
+    }
+    CELIX_EI_IMPL(celix_utils_extractZipFileIncrementally);
+    return __real_celix_utils_extractZipFileIncrementally(zipPath, extractToDir, contentStoreDir, indexPath, errorOut);
+}
+
 char* __real_celix_utils_trim(const char* string);
 CELIX_EI_DEFINE(celix_utils_trim, char*)
 char* __wrap_celix_utils_trim(const char* string) {
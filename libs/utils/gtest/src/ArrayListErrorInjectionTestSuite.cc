@@ -160,3 +160,53 @@ TEST_F(ArrayListErrorInjectionTestSuite, CopyArrayListFailureTest) {
     // And a celix_err is expected
     EXPECT_EQ(3, celix_err_getErrorCount());
 }
+
+TEST_F(ArrayListErrorInjectionTestSuite, AddAllFailureTest) {
+    // Given a string array list with 1 element and a string array list with 11 elements
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createStringArray();
+    celix_arrayList_addString(list, "test");
+    celix_autoptr(celix_array_list_t) other = celix_arrayList_createStringArray();
+    for (int i = 0; i < 11; ++i) {
+        std::string str = "test" + std::to_string(i);
+        celix_arrayList_addString(other, str.c_str());
+    }
+
+    // When an error is injected for realloc (ensureCapacity)
+    celix_ei_expect_realloc((void*)celix_arrayList_addAll, 1, nullptr);
+    // Then adding all entries should fail
+    EXPECT_EQ(CELIX_ENOMEM, celix_arrayList_addAll(list, other));
+    // And the array list is unchanged
+    EXPECT_EQ(1, celix_arrayList_size(list));
+    // And a celix_err is expected
+    EXPECT_EQ(1, celix_err_getErrorCount());
+
+    // When an error is injected for celix_utils_strdup for the 5th copied entry (string array list copy callback)
+    celix_ei_expect_celix_utils_strdup((void*)celix_arrayList_addAll, 1, nullptr, 5);
+    // Then adding all entries should fail
+    EXPECT_EQ(CELIX_ENOMEM, celix_arrayList_addAll(list, other));
+    // And the already copied entries are removed again
+    EXPECT_EQ(1, celix_arrayList_size(list));
+    EXPECT_STREQ("test", celix_arrayList_getString(list, 0));
+    // And a celix_err is expected
+    EXPECT_EQ(2, celix_err_getErrorCount());
+}
+
+TEST_F(ArrayListErrorInjectionTestSuite, AddEntrySortedFailureTest) {
+    // Given a string array list with 10 elements (whitebox knowledge that the initial capacity is 10)
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createStringArray();
+    for (int i = 0; i < 10; ++i) {
+        std::string str = "test" + std::to_string(i);
+        celix_arrayList_addString(list, str.c_str());
+    }
+
+    // When an error is injected for realloc (ensureCapacity)
+    celix_ei_expect_realloc(CELIX_EI_UNKNOWN_CALLER, 1, nullptr);
+    // Then adding a sorted entry should fail (and the entry is freed by the removed callback)
+    celix_array_list_entry_t entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.stringVal = celix_utils_strdup("test");
+    EXPECT_EQ(CELIX_ENOMEM, celix_arrayList_addEntrySorted(list, entry));
+    EXPECT_EQ(10, celix_arrayList_size(list));
+    // And a celix_err is expected
+    EXPECT_EQ(1, celix_err_getErrorCount());
+}
@@ -20,6 +20,7 @@
 #include <gtest/gtest.h>
 
 #include "celix_array_list.h"
+#include "celix_err.h"
 #include "celix_version.h"
 #include "celix_stdlib_cleanup.h"
 #include "celix_utils.h"
@@ -507,3 +508,171 @@ TEST_F(ArrayListTestSuite, ElementTypeToStringTest) {
     EXPECT_STREQ("Undefined",
                  celix_arrayList_elementTypeToString((celix_array_list_element_type_t)100 /*non existing*/));
 }
+
+TEST_F(ArrayListTestSuite, SortedAddAndBinarySearchTest) {
+    // Given an empty long array list
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createLongArray();
+
+    // When adding unsorted values (including duplicates) using addEntrySorted
+    for (long val : {5L, 1L, 3L, 9L, 3L, 7L, 0L, 11L, 2L, 10L, 4L}) {
+        celix_array_list_entry_t entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.longVal = val;
+        EXPECT_EQ(CELIX_SUCCESS, celix_arrayList_addEntrySorted(list, entry));
+    }
+
+    // Then the array list is sorted
+    ASSERT_EQ(11, celix_arrayList_size(list));
+    for (int i = 1; i < celix_arrayList_size(list); ++i) {
+        EXPECT_LE(celix_arrayList_getLong(list, i - 1), celix_arrayList_getLong(list, i));
+    }
+
+    // And the values can be found using a binary search, for duplicates the first index is returned
+    celix_array_list_entry_t entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.longVal = 3L;
+    EXPECT_EQ(3, celix_arrayList_binarySearch(list, entry));
+    entry.longVal = 0L;
+    EXPECT_EQ(0, celix_arrayList_binarySearch(list, entry));
+    entry.longVal = 11L;
+    EXPECT_EQ(10, celix_arrayList_binarySearch(list, entry));
+
+    // And a not existing value is not found
+    entry.longVal = 6L;
+    EXPECT_EQ(-1, celix_arrayList_binarySearch(list, entry));
+    entry.longVal = 42L;
+    EXPECT_EQ(-1, celix_arrayList_binarySearch(list, entry));
+
+    // When adding a string to a sorted string array list, the array list takes ownership
+    celix_autoptr(celix_array_list_t) stringList = celix_arrayList_createStringArray();
+    celix_arrayList_addString(stringList, "a");
+    celix_arrayList_addString(stringList, "c");
+    memset(&entry, 0, sizeof(entry));
+    entry.stringVal = celix_utils_strdup("b");
+    EXPECT_EQ(CELIX_SUCCESS, celix_arrayList_addEntrySorted(stringList, entry));
+    EXPECT_STREQ("b", celix_arrayList_getString(stringList, 1));
+    EXPECT_EQ(1, celix_arrayList_binarySearch(stringList, entry));
+
+    // When using an undefined array list without compare callback, the entry is added to the back
+    // and the binary search falls back to a linear search
+    celix_array_list_create_options_t opts{};
+    celix_autoptr(celix_array_list_t) undefinedList = celix_arrayList_createWithOptions(&opts);
+    celix_arrayList_add(undefinedList, (void*)0x3);
+    memset(&entry, 0, sizeof(entry));
+    entry.voidPtrVal = (void*)0x1;
+    EXPECT_EQ(CELIX_SUCCESS, celix_arrayList_addEntrySorted(undefinedList, entry));
+    EXPECT_EQ((void*)0x1, celix_arrayList_get(undefinedList, 1));
+    EXPECT_EQ(1, celix_arrayList_binarySearch(undefinedList, entry));
+}
+
+TEST_F(ArrayListTestSuite, AddAllTest) {
+    // Given two string array lists
+    celix_autoptr(celix_array_list_t) list1 = celix_arrayList_createStringArray();
+    celix_arrayList_addString(list1, "1");
+    celix_arrayList_addString(list1, "2");
+    celix_autoptr(celix_array_list_t) list2 = celix_arrayList_createStringArray();
+    for (int i = 0; i < 20; ++i) {
+        celix_arrayList_addString(list2, std::to_string(i + 3).c_str());
+    }
+
+    // When adding all entries of list2 to list1
+    EXPECT_EQ(CELIX_SUCCESS, celix_arrayList_addAll(list1, list2));
+
+    // Then list1 contains copies of the entries of list2
+    ASSERT_EQ(22, celix_arrayList_size(list1));
+    for (int i = 0; i < 22; ++i) {
+        EXPECT_STREQ(std::to_string(i + 1).c_str(), celix_arrayList_getString(list1, i));
+    }
+    EXPECT_NE(celix_arrayList_getString(list1, 2), celix_arrayList_getString(list2, 0));
+
+    // When adding all entries of list2 to itself
+    EXPECT_EQ(CELIX_SUCCESS, celix_arrayList_addAll(list2, list2));
+
+    // Then list2 contains its entries twice
+    ASSERT_EQ(40, celix_arrayList_size(list2));
+    EXPECT_STREQ(celix_arrayList_getString(list2, 0), celix_arrayList_getString(list2, 20));
+
+    // When adding all entries of an array list with a different element type
+    celix_autoptr(celix_array_list_t) longList = celix_arrayList_createLongArray();
+    celix_arrayList_addLong(longList, 1L);
+
+    // Then this fails and list1 is unchanged
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_arrayList_addAll(list1, longList));
+    EXPECT_EQ(22, celix_arrayList_size(list1));
+    celix_err_resetErrors();
+}
+
+TEST_F(ArrayListTestSuite, RemoveIfAndRetainIfTest) {
+    // Given a long array list with the values 0-99 and a removed callback counting the removed entries
+    int removedCount = 0;
+    celix_array_list_create_options_t opts{};
+    opts.elementType = CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG;
+    opts.removedCallbackData = &removedCount;
+    opts.removedCallback = [](void* data, celix_array_list_entry_t) {
+        auto* count = static_cast<int*>(data);
+        *count += 1;
+    };
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createWithOptions(&opts);
+    for (long i = 0; i < 100; ++i) {
+        celix_arrayList_addLong(list, i);
+    }
+
+    // When removing all even values
+    auto isEven = [](void*, celix_array_list_entry_t entry) -> bool { return entry.longVal % 2 == 0; };
+    EXPECT_EQ(50, celix_arrayList_removeIf(list, isEven, nullptr));
+
+    // Then only the odd values remain, in order
+    EXPECT_EQ(50, removedCount);
+    ASSERT_EQ(50, celix_arrayList_size(list));
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(i * 2 + 1, celix_arrayList_getLong(list, i));
+    }
+
+    // When retaining values smaller than 21
+    long max = 21;
+    auto isSmaller = [](void* data, celix_array_list_entry_t entry) -> bool {
+        return entry.longVal < *static_cast<long*>(data);
+    };
+    EXPECT_EQ(40, celix_arrayList_retainIf(list, isSmaller, &max));
+
+    // Then the values 1, 3, .., 19 remain
+    EXPECT_EQ(90, removedCount);
+    ASSERT_EQ(10, celix_arrayList_size(list));
+    EXPECT_EQ(1, celix_arrayList_getLong(list, 0));
+    EXPECT_EQ(19, celix_arrayList_getLong(list, 9));
+
+    // When removing with a predicate which matches nothing
+    EXPECT_EQ(0, celix_arrayList_removeIf(list, isEven, nullptr));
+    EXPECT_EQ(10, celix_arrayList_size(list));
+}
+
+TEST_F(ArrayListTestSuite, SwapRemoveAtTest) {
+    // Given a string array list with 4 entries
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createStringArray();
+    celix_arrayList_addString(list, "a");
+    celix_arrayList_addString(list, "b");
+    celix_arrayList_addString(list, "c");
+    celix_arrayList_addString(list, "d");
+
+    // When swap removing the first entry
+    celix_arrayList_swapRemoveAt(list, 0);
+
+    // Then the last entry is moved to the first index
+    ASSERT_EQ(3, celix_arrayList_size(list));
+    EXPECT_STREQ("d", celix_arrayList_getString(list, 0));
+    EXPECT_STREQ("b", celix_arrayList_getString(list, 1));
+    EXPECT_STREQ("c", celix_arrayList_getString(list, 2));
+
+    // When swap removing the last entry
+    celix_arrayList_swapRemoveAt(list, 2);
+
+    // Then the other entries are unchanged
+    ASSERT_EQ(2, celix_arrayList_size(list));
+    EXPECT_STREQ("d", celix_arrayList_getString(list, 0));
+    EXPECT_STREQ("b", celix_arrayList_getString(list, 1));
+
+    // When swap removing an out of bound index, nothing is removed
+    celix_arrayList_swapRemoveAt(list, -1);
+    celix_arrayList_swapRemoveAt(list, 2);
+    EXPECT_EQ(2, celix_arrayList_size(list));
+}
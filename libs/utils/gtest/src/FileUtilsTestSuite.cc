@@ -17,12 +17,15 @@
  * under the License.
  */
 
+#include <dirent.h>
 #include <fstream>
 #include <gtest/gtest.h>
 #include <stdlib.h>
 #include <string>
+#include <sys/stat.h>
 #include <thread>
 #include <unistd.h>
+#include <utility>
 #include <vector>
 #include <zip.h>
 
@@ -30,7 +33,59 @@
 #include "celix_properties.h"
 #include "celix_utils.h"
 
-class FileUtilsTestSuite : public ::testing::Test {};
+class FileUtilsTestSuite : public ::testing::Test {
+  public:
+    static void createZip(const char* path, const std::vector<std::pair<std::string, std::string>>& entries) {
+        int error = 0;
+        zip_t* zip = zip_open(path, ZIP_CREATE | ZIP_TRUNCATE, &error);
+        ASSERT_NE(zip, nullptr);
+        for (const auto& entry : entries) {
+            if (entry.first.back() == '/') {
+                EXPECT_GE(zip_dir_add(zip, entry.first.c_str(), 0), 0);
+            } else {
+                zip_source_t* src = zip_source_buffer(zip, entry.second.data(), entry.second.size(), 0);
+                ASSERT_NE(src, nullptr);
+                EXPECT_GE(zip_file_add(zip, entry.first.c_str(), src, ZIP_FL_OVERWRITE), 0);
+            }
+        }
+        EXPECT_EQ(zip_close(zip), 0);
+    }
+
+    static std::string readFile(const std::string& path) {
+        std::ifstream file{path};
+        return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+    static struct stat statFile(const std::string& path) {
+        struct stat st{};
+        EXPECT_EQ(stat(path.c_str(), &st), 0) << "Cannot stat " << path;
+        return st;
+    }
+
+    static int countFiles(const std::string& dir) {
+        int count = 0;
+        DIR* d = opendir(dir.c_str());
+        if (d == nullptr) {
+            return 0;
+        }
+        struct dirent* ent;
+        while ((ent = readdir(d)) != nullptr) {
+            std::string name = ent->d_name;
+            if (name == "." || name == "..") {
+                continue;
+            }
+            std::string path = dir + "/" + name;
+            struct stat st{};
+            if (lstat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+                count += countFiles(path);
+            } else {
+                count += 1;
+            }
+        }
+        closedir(d);
+        return count;
+    }
+};
 
 TEST_F(FileUtilsTestSuite, TestFileAndDirectoryExists) {
     EXPECT_TRUE(celix_utils_fileExists(TEST_A_DIR_LOCATION));
@@ -378,3 +433,106 @@ TEST_F(FileUtilsTestSuite, TouchTest) {
     status = celix_utils_touch("does-not-exists");
     EXPECT_NE(status, CELIX_SUCCESS);
 }
+
+TEST_F(FileUtilsTestSuite, ExtractZipFileIncrementallyTest) {
+    const char* zip1 = "incremental_test1.zip";
+    const char* zip2 = "incremental_test2.zip";
+    const char* storeDir = "incremental_content_store";
+    const char* extractDir1 = "incremental_extract1";
+    const char* extractDir2 = "incremental_extract2";
+    const char* index1 = "incremental_extract1.index";
+    const char* index2 = "incremental_extract2.index";
+    celix_utils_deleteDirectory(storeDir, nullptr);
+    celix_utils_deleteDirectory(extractDir1, nullptr);
+    celix_utils_deleteDirectory(extractDir2, nullptr);
+    unlink(index1);
+    unlink(index2);
+
+    //Given two zip files which share a file and a shared object
+    createZip(zip1, {{"res/", ""}, {"res/foo.txt", "foo"}, {"res/bar.txt", "bar"}, {"lib/", ""}, {"lib/libshared.so.1", "shared"}, {"top.properties", "level=1\n"}});
+    createZip(zip2, {{"res/", ""}, {"res/foo.txt", "foo"}, {"lib/", ""}, {"lib/libshared.so.1", "shared"}, {"other.txt", "other"}});
+
+    //When the zip files are extracted incrementally using the same content store
+    const char* error = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, celix_utils_extractZipFileIncrementally(zip1, extractDir1, storeDir, index1, &error));
+    EXPECT_EQ(nullptr, error);
+    EXPECT_EQ(CELIX_SUCCESS, celix_utils_extractZipFileIncrementally(zip2, extractDir2, storeDir, index2, nullptr));
+
+    //Then the files are extracted
+    std::string dir1 = extractDir1;
+    std::string dir2 = extractDir2;
+    EXPECT_EQ("foo", readFile(dir1 + "/res/foo.txt"));
+    EXPECT_EQ("bar", readFile(dir1 + "/res/bar.txt"));
+    EXPECT_EQ("shared", readFile(dir1 + "/lib/libshared.so.1"));
+    EXPECT_EQ("level=1\n", readFile(dir1 + "/top.properties"));
+    EXPECT_EQ("foo", readFile(dir2 + "/res/foo.txt"));
+    EXPECT_EQ("shared", readFile(dir2 + "/lib/libshared.so.1"));
+    EXPECT_EQ("other", readFile(dir2 + "/other.txt"));
+    EXPECT_TRUE(celix_utils_fileExists(index1));
+    EXPECT_TRUE(celix_utils_fileExists(index2));
+
+    //And the identical file is shared (content store + 2 extraction dirs)
+    auto foo1 = statFile(dir1 + "/res/foo.txt");
+    auto foo2 = statFile(dir2 + "/res/foo.txt");
+    EXPECT_EQ(foo1.st_ino, foo2.st_ino);
+    EXPECT_EQ(3, foo1.st_nlink);
+    EXPECT_EQ(4, countFiles(storeDir));
+
+    //But the identical shared object is not shared, so that the bundles do not share its static state
+    auto shared1 = statFile(dir1 + "/lib/libshared.so.1");
+    auto shared2 = statFile(dir2 + "/lib/libshared.so.1");
+    EXPECT_NE(shared1.st_ino, shared2.st_ino);
+    EXPECT_EQ(1, shared1.st_nlink);
+    EXPECT_EQ(1, shared2.st_nlink);
+
+    //When the first zip file is updated and extracted again
+    auto bar1 = statFile(dir1 + "/res/bar.txt");
+    createZip(zip1, {{"res/", ""}, {"res/foo.txt", "foo v2"}, {"res/bar.txt", "bar"}, {"lib/", ""}, {"lib/libshared.so.1", "shared"}, {"new.txt", "new"}});
+    EXPECT_EQ(CELIX_SUCCESS, celix_utils_extractZipFileIncrementally(zip1, extractDir1, storeDir, index1, nullptr));
+
+    //Then the changed file is replaced by a new file
+    auto updatedFoo1 = statFile(dir1 + "/res/foo.txt");
+    EXPECT_NE(foo1.st_ino, updatedFoo1.st_ino);
+    EXPECT_EQ("foo v2", readFile(dir1 + "/res/foo.txt"));
+    EXPECT_EQ("foo", readFile(dir2 + "/res/foo.txt"));
+
+    //And the unchanged files are kept
+    EXPECT_EQ(bar1.st_ino, statFile(dir1 + "/res/bar.txt").st_ino);
+    EXPECT_EQ(shared1.st_ino, statFile(dir1 + "/lib/libshared.so.1").st_ino);
+
+    //And the removed file is removed and the added file is extracted
+    EXPECT_FALSE(celix_utils_fileExists((dir1 + "/top.properties").c_str()));
+    EXPECT_EQ("new", readFile(dir1 + "/new.txt"));
+
+    //And the content store files which are no longer used are removed (top.properties)
+    EXPECT_EQ(5, countFiles(storeDir));
+
+    //When the second extraction dir is removed and the content store is pruned
+    EXPECT_EQ(CELIX_SUCCESS, celix_utils_deleteDirectory(extractDir2, nullptr));
+    EXPECT_EQ(CELIX_SUCCESS, celix_utils_pruneContentStore(storeDir, &error));
+    EXPECT_EQ(nullptr, error);
+
+    //Then only the files used by the first extraction dir remain
+    EXPECT_EQ(3, countFiles(storeDir));
+    EXPECT_EQ("foo v2", readFile(dir1 + "/res/foo.txt"));
+    EXPECT_EQ(2, statFile(dir1 + "/res/foo.txt").st_nlink);
+
+    //When a file in the extraction dir is removed, it is extracted again
+    EXPECT_EQ(0, unlink((dir1 + "/new.txt").c_str()));
+    EXPECT_EQ(CELIX_SUCCESS, celix_utils_extractZipFileIncrementally(zip1, extractDir1, storeDir, index1, nullptr));
+    EXPECT_EQ("new", readFile(dir1 + "/new.txt"));
+
+    //Given an invalid zip file, the incremental extraction fails
+    EXPECT_NE(CELIX_SUCCESS, celix_utils_extractZipFileIncrementally("does-not-exists.zip", extractDir1, storeDir, index1, &error));
+    EXPECT_NE(nullptr, error);
+
+    //Given a non-existing content store, prune does nothing
+    EXPECT_EQ(CELIX_SUCCESS, celix_utils_pruneContentStore("does-not-exists", nullptr));
+
+    celix_utils_deleteDirectory(storeDir, nullptr);
+    celix_utils_deleteDirectory(extractDir1, nullptr);
+    unlink(index1);
+    unlink(index2);
+    unlink(zip1);
+    unlink(zip2);
+}
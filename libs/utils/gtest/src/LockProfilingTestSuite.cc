@@ -0,0 +1,229 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "celix_err.h"
+#include "celix_lock_profiling.h"
+#include "celix_stdio_cleanup.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_threads.h"
+
+class LockProfilingTestSuite : public ::testing::Test {
+public:
+    LockProfilingTestSuite() {
+        celix_lockProfiling_reset();
+        celix_lockProfiling_setEnabled(true);
+    }
+
+    ~LockProfilingTestSuite() override {
+        celix_lockProfiling_setEnabled(false);
+        celix_lockProfiling_reset();
+        celix_err_resetErrors();
+    }
+
+    static bool findStats(const void* lock, celix_lock_profile_stats_t* out) {
+        std::vector<celix_lock_profile_stats_t> stats{128};
+        size_t count = celix_lockProfiling_getTopContended(stats.data(), stats.size());
+        for (size_t i = 0; i < count; ++i) {
+            if (stats[i].lock == lock) {
+                *out = stats[i];
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+TEST_F(LockProfilingTestSuite, NotSupportedTest) {
+    if (celix_lockProfiling_isSupported()) {
+        GTEST_SKIP() << "Lock profiling is compiled in";
+    }
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_lockProfiling_setEnabled(true));
+    EXPECT_FALSE(celix_lockProfiling_isEnabled());
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_lockProfiling_print(stdout, 10));
+    celix_lock_profile_stats_t stats;
+    EXPECT_EQ(0, celix_lockProfiling_getTopContended(&stats, 1));
+}
+
+TEST_F(LockProfilingTestSuite, ContendedMutexTest) {
+    if (!celix_lockProfiling_isSupported()) {
+        GTEST_SKIP() << "Lock profiling is not compiled in";
+    }
+    celix_thread_mutex_t mutex;
+    celixThreadMutex_create(&mutex, nullptr);
+    celix_lockProfiling_setName(&mutex, "test::mutex%i", 1);
+
+    celixThreadMutex_lock(&mutex);
+    std::thread waiter{[&mutex] {
+        celixThreadMutex_lock(&mutex);
+        celixThreadMutex_unlock(&mutex);
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    celixThreadMutex_unlock(&mutex);
+    waiter.join();
+
+    celix_lock_profile_stats_t stats;
+    ASSERT_TRUE(findStats(&mutex, &stats));
+    EXPECT_STREQ("test::mutex1", stats.name);
+    EXPECT_EQ(2, stats.acquisitions);
+    EXPECT_EQ(1, stats.contentions);
+    EXPECT_GE(stats.maxWaitNs, 10 * 1000 * 1000);
+    EXPECT_EQ(stats.maxWaitNs, stats.totalWaitNs);
+    EXPECT_GE(stats.maxHoldNs, 10 * 1000 * 1000);
+    uint64_t histogramTotal = 0;
+    for (auto count : stats.waitHistogram) {
+        histogramTotal += count;
+    }
+    EXPECT_EQ(1, histogramTotal);
+
+    celixThreadMutex_destroy(&mutex);
+}
+
+TEST_F(LockProfilingTestSuite, RwlockAndConditionWaitTest) {
+    if (!celix_lockProfiling_isSupported()) {
+        GTEST_SKIP() << "Lock profiling is not compiled in";
+    }
+    celix_thread_rwlock_t rwlock;
+    celixThreadRwlock_create(&rwlock, nullptr);
+    celixThreadRwlock_readLock(&rwlock);
+    celixThreadRwlock_readLock(&rwlock);
+    celixThreadRwlock_unlock(&rwlock);
+    celixThreadRwlock_unlock(&rwlock);
+    celixThreadRwlock_writeLock(&rwlock);
+    celixThreadRwlock_unlock(&rwlock);
+
+    celix_lock_profile_stats_t stats;
+    ASSERT_TRUE(findStats(&rwlock, &stats));
+    EXPECT_STREQ("", stats.name);
+    EXPECT_EQ(3, stats.acquisitions);
+    EXPECT_EQ(0, stats.contentions);
+    celixThreadRwlock_destroy(&rwlock);
+
+    //the time spent in a condition wait is not accounted as hold time
+    celix_thread_mutex_t mutex;
+    celix_thread_cond_t cond;
+    celixThreadMutex_create(&mutex, nullptr);
+    celixThreadCondition_init(&cond, nullptr);
+    celixThreadMutex_lock(&mutex);
+    celixThreadCondition_timedwaitRelative(&cond, &mutex, 0, 50 * 1000 * 1000);
+    celixThreadMutex_unlock(&mutex);
+    ASSERT_TRUE(findStats(&mutex, &stats));
+    EXPECT_EQ(1, stats.acquisitions);
+    EXPECT_LT(stats.totalHoldNs, 40 * 1000 * 1000);
+    celixThreadCondition_destroy(&cond);
+    celixThreadMutex_destroy(&mutex);
+}
+
+TEST_F(LockProfilingTestSuite, ResetAndPrintTest) {
+    if (!celix_lockProfiling_isSupported()) {
+        GTEST_SKIP() << "Lock profiling is not compiled in";
+    }
+    celix_thread_mutex_t mutex;
+    celixThreadMutex_create(&mutex, nullptr);
+    celix_lockProfiling_setName(&mutex, "test::printed_mutex");
+    std::thread locker{[&mutex] {
+        celixThreadMutex_lock(&mutex);
+        celixThreadMutex_unlock(&mutex);
+    }};
+    locker.join();
+
+    celix_autofree char* buf = nullptr;
+    size_t bufLen = 0;
+    {
+        celix_autoptr(FILE) stream = open_memstream(&buf, &bufLen);
+        ASSERT_EQ(CELIX_SUCCESS, celix_lockProfiling_print(stream, 100));
+    }
+    EXPECT_NE(nullptr, strstr(buf, "Lock profiling is enabled")) << buf;
+    EXPECT_NE(nullptr, strstr(buf, "test::printed_mutex")) << buf;
+
+    //statistics of exited threads are kept until a reset
+    celix_lock_profile_stats_t stats;
+    EXPECT_TRUE(findStats(&mutex, &stats));
+    celix_lockProfiling_reset();
+    EXPECT_FALSE(findStats(&mutex, &stats));
+
+    //names survive a reset
+    celixThreadMutex_lock(&mutex);
+    celixThreadMutex_unlock(&mutex);
+    ASSERT_TRUE(findStats(&mutex, &stats));
+    EXPECT_STREQ("test::printed_mutex", stats.name);
+    EXPECT_EQ(1, stats.acquisitions);
+
+    //disabled profiling does not record acquisitions
+    celix_lockProfiling_setEnabled(false);
+    celixThreadMutex_lock(&mutex);
+    celixThreadMutex_unlock(&mutex);
+    ASSERT_TRUE(findStats(&mutex, &stats));
+    EXPECT_EQ(1, stats.acquisitions);
+
+    celixThreadMutex_destroy(&mutex);
+}
+
+TEST_F(LockProfilingTestSuite, DestroyedLocksAreRemovedTest) {
+    if (!celix_lockProfiling_isSupported()) {
+        GTEST_SKIP() << "Lock profiling is not compiled in";
+    }
+    //a new lock created at the address of a destroyed lock does not inherit the statistics of the destroyed lock
+    celix_thread_mutex_t mutex;
+    celixThreadMutex_create(&mutex, nullptr);
+    celixThreadMutex_lock(&mutex);
+    celixThreadMutex_unlock(&mutex);
+    celixThreadMutex_lock(&mutex);
+    celixThreadMutex_unlock(&mutex);
+    celixThreadMutex_destroy(&mutex);
+    celix_lock_profile_stats_t stats;
+    EXPECT_FALSE(findStats(&mutex, &stats));
+
+    celixThreadMutex_create(&mutex, nullptr);
+    celixThreadMutex_lock(&mutex);
+    celixThreadMutex_unlock(&mutex);
+    ASSERT_TRUE(findStats(&mutex, &stats));
+    EXPECT_EQ(1, stats.acquisitions);
+    celixThreadMutex_destroy(&mutex);
+
+    //a thread can profile more than the per-thread table size (256) of locks, if the locks are destroyed
+    for (int i = 0; i < 1024; ++i) {
+        auto* lock = static_cast<celix_thread_mutex_t*>(malloc(sizeof(celix_thread_mutex_t)));
+        celixThreadMutex_create(lock, nullptr);
+        celixThreadMutex_lock(lock);
+        celixThreadMutex_unlock(lock);
+        celixThreadMutex_destroy(lock);
+        free(lock);
+    }
+    celixThreadMutex_create(&mutex, nullptr);
+    celixThreadMutex_lock(&mutex);
+    celixThreadMutex_unlock(&mutex);
+    ASSERT_TRUE(findStats(&mutex, &stats));
+    EXPECT_EQ(1, stats.acquisitions);
+
+    celix_autofree char* buf = nullptr;
+    size_t bufLen = 0;
+    {
+        celix_autoptr(FILE) stream = open_memstream(&buf, &bufLen);
+        ASSERT_EQ(CELIX_SUCCESS, celix_lockProfiling_print(stream, 100));
+    }
+    EXPECT_EQ(nullptr, strstr(buf, "not profiled")) << buf;
+    celixThreadMutex_destroy(&mutex);
+}
@@ -0,0 +1,136 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "celix_metrics.h"
+#include "celix_stdio_cleanup.h"
+#include "celix_stdlib_cleanup.h"
+
+class MetricsTestSuite : public ::testing::Test {
+public:
+    static std::string writePrometheus(const celix_metric_t* metric, bool writeHeader) {
+        celix_autofree char* buf = nullptr;
+        size_t bufLen = 0;
+        {
+            celix_autoptr(FILE) stream = open_memstream(&buf, &bufLen);
+            EXPECT_EQ(CELIX_SUCCESS, celix_metrics_writePrometheus(stream, metric, writeHeader));
+        }
+        return std::string{buf};
+    }
+};
+
+TEST_F(MetricsTestSuite, HistogramBucketsTest) {
+    celix_metrics_histogram_t histogram{};
+    celix_metricsHistogram_record(&histogram, 10);        //bucket 0 (< 1us)
+    celix_metricsHistogram_record(&histogram, 1500);      //bucket 1 ([1024, 2048) ns)
+    celix_metricsHistogram_record(&histogram, 5000000000); //last bucket (> ~1s)
+
+    celix_metrics_histogram_t snapshot;
+    celix_metricsHistogram_snapshot(&histogram, &snapshot);
+    EXPECT_EQ(3, snapshot.count);
+    EXPECT_EQ(5000001510, snapshot.sumNs);
+    EXPECT_EQ(1, snapshot.buckets[0]);
+    EXPECT_EQ(1, snapshot.buckets[1]);
+    EXPECT_EQ(1, snapshot.buckets[CELIX_METRICS_HISTOGRAM_SIZE - 1]);
+
+    EXPECT_DOUBLE_EQ(1024e-9, celix_metricsHistogram_bucketUpperBound(0));
+    EXPECT_DOUBLE_EQ(2048e-9, celix_metricsHistogram_bucketUpperBound(1));
+    EXPECT_TRUE(std::isinf(celix_metricsHistogram_bucketUpperBound(CELIX_METRICS_HISTOGRAM_SIZE - 1)));
+
+    EXPECT_DOUBLE_EQ(2048e-9, celix_metricsHistogram_quantile(&histogram, 0.5));
+    EXPECT_TRUE(std::isinf(celix_metricsHistogram_quantile(&histogram, 0.99)));
+
+    celix_metrics_histogram_t empty{};
+    EXPECT_DOUBLE_EQ(0.0, celix_metricsHistogram_quantile(&empty, 0.5));
+}
+
+TEST_F(MetricsTestSuite, ConcurrentRecordTest) {
+    celix_metrics_histogram_t histogram{};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram] {
+            for (int i = 0; i < 10000; ++i) {
+                celix_metricsHistogram_record(&histogram, 2000);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(40000, histogram.count);
+    EXPECT_EQ(40000, histogram.buckets[1]);
+    EXPECT_EQ(80000000, histogram.sumNs);
+}
+
+TEST_F(MetricsTestSuite, WritePrometheusCounterAndGaugeTest) {
+    celix_metric_t counter{};
+    counter.name = "celix_test_total";
+    counter.help = "A test counter";
+    counter.type = CELIX_METRIC_TYPE_COUNTER;
+    counter.value = 42;
+    EXPECT_EQ("# HELP celix_test_total A test counter\n"
+              "# TYPE celix_test_total counter\n"
+              "celix_test_total 42\n",
+              writePrometheus(&counter, true));
+
+    celix_metric_t gauge{};
+    gauge.name = "celix_test_gauge";
+    gauge.labels = "level=\"error\"";
+    gauge.type = CELIX_METRIC_TYPE_GAUGE;
+    gauge.value = 0.5;
+    EXPECT_EQ("celix_test_gauge{level=\"error\"} 0.5\n", writePrometheus(&gauge, false));
+}
+
+TEST_F(MetricsTestSuite, WritePrometheusHistogramTest) {
+    celix_metrics_histogram_t histogram{};
+    celix_metricsHistogram_record(&histogram, 10);
+    celix_metricsHistogram_record(&histogram, 1500);
+
+    celix_metric_t metric{};
+    metric.name = "celix_test_seconds";
+    metric.labels = "topic=\"a\"";
+    metric.type = CELIX_METRIC_TYPE_HISTOGRAM;
+    metric.histogram = &histogram;
+    auto output = writePrometheus(&metric, true);
+
+    EXPECT_NE(std::string::npos, output.find("# TYPE celix_test_seconds histogram\n"));
+    EXPECT_NE(std::string::npos, output.find("celix_test_seconds_bucket{topic=\"a\",le=\"1.024e-06\"} 1\n"));
+    EXPECT_NE(std::string::npos, output.find("celix_test_seconds_bucket{topic=\"a\",le=\"2.048e-06\"} 2\n"));
+    EXPECT_NE(std::string::npos, output.find("celix_test_seconds_bucket{topic=\"a\",le=\"+Inf\"} 2\n"));
+    EXPECT_NE(std::string::npos, output.find("celix_test_seconds_sum{topic=\"a\"} 1.51e-06\n"));
+    EXPECT_NE(std::string::npos, output.find("celix_test_seconds_count{topic=\"a\"} 2\n"));
+    EXPECT_EQ(std::string::npos, output.find("# HELP"));
+}
+
+TEST_F(MetricsTestSuite, WriteInvalidMetricTest) {
+    celix_metric_t metric{};
+    metric.type = CELIX_METRIC_TYPE_COUNTER;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_metrics_writePrometheus(stdout, &metric, true));
+
+    metric.name = "celix_test_seconds";
+    metric.type = CELIX_METRIC_TYPE_HISTOGRAM;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_metrics_writePrometheus(stdout, &metric, true));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_metrics_writeText(stdout, &metric));
+}
@@ -0,0 +1,326 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+
+#include "celix_err.h"
+#include "celix_properties.h"
+#include "celix_stdlib_cleanup.h"
+
+class PropertiesStreamEncodingTestSuite : public ::testing::Test {
+  public:
+    PropertiesStreamEncodingTestSuite() { celix_err_resetErrors(); }
+
+    static celix_status_t encode(const celix_properties_t* props, int flags, std::string& out) {
+        celix_autofree char* buf = nullptr;
+        size_t bufLen = 0;
+        FILE* stream = open_memstream(&buf, &bufLen);
+        auto status = celix_properties_encodeToStream(props, stream, flags);
+        fclose(stream);
+        out = buf;
+        return status;
+    }
+
+    static celix_status_t decode(const std::string& input, int flags, celix_properties_t** out) {
+        return celix_properties_decodeFromBuffer(input.c_str(), input.size(), flags, out);
+    }
+
+    static celix_properties_t* createMixedProperties() {
+        auto* props = celix_properties_create();
+        celix_properties_set(props, "key1", "value1");
+        celix_properties_set(props, "escaped", "quote\" backslash\\ newline\n tab\t control\x01 slash/ utf8 \xc3\xa9");
+        celix_properties_setLong(props, "long", -42);
+        celix_properties_setDouble(props, "double1", 4.0);
+        celix_properties_setDouble(props, "double2", 0.1);
+        celix_properties_setDouble(props, "double3", 1e20);
+        celix_properties_setDouble(props, "double4", 1.5e-7);
+        celix_properties_setBool(props, "bool", true);
+        celix_properties_assignVersion(props, "version", celix_version_create(1, 2, 3, "qualifier"));
+        celix_properties_set(props, "nested.key1", "value2");
+        celix_properties_setLong(props, "nested.deeper.key2", 3);
+
+        celix_array_list_t* longs = celix_arrayList_createLongArray();
+        celix_arrayList_addLong(longs, 1);
+        celix_arrayList_addLong(longs, 2);
+        celix_properties_assignArrayList(props, "longs", longs);
+        celix_array_list_t* strings = celix_arrayList_createStringArray();
+        celix_arrayList_addString(strings, "a");
+        celix_arrayList_addString(strings, "b");
+        celix_properties_assignArrayList(props, "strings", strings);
+        celix_array_list_t* versions = celix_arrayList_createVersionArray();
+        celix_arrayList_assignVersion(versions, celix_version_create(1, 0, 0, ""));
+        celix_properties_assignArrayList(props, "versions", versions);
+        return props;
+    }
+};
+
+TEST_F(PropertiesStreamEncodingTestSuite, EncodeEmptyPropertiesTest) {
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    std::string output;
+    ASSERT_EQ(CELIX_SUCCESS, encode(props, 0, output));
+    EXPECT_EQ("{}", output);
+    ASSERT_EQ(CELIX_SUCCESS, encode(props, CELIX_PROPERTIES_ENCODE_PRETTY | CELIX_PROPERTIES_ENCODE_NESTED_STYLE, output));
+    EXPECT_EQ("{}", output);
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, EncodeFlatIsEqualToSaveToStreamTest) {
+    // Given a properties object with all value types
+    celix_autoptr(celix_properties_t) props = createMixedProperties();
+
+    for (int flags : {0, CELIX_PROPERTIES_ENCODE_PRETTY, CELIX_PROPERTIES_ENCODE_FLAT_STYLE | CELIX_PROPERTIES_ENCODE_STRICT}) {
+        // When encoding the properties with the streaming encoder and with the JSON document based encoder
+        std::string output;
+        ASSERT_EQ(CELIX_SUCCESS, encode(props, flags, output));
+        celix_autofree char* expected = nullptr;
+        ASSERT_EQ(CELIX_SUCCESS, celix_properties_saveToString(props, flags, &expected));
+
+        // Then the output is equal
+        EXPECT_EQ(std::string{expected}, output);
+    }
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, EncodeNestedTest) {
+    // Given a properties object with nested keys
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "b", "value1");
+    celix_properties_set(props, "a.y", "value2");
+    celix_properties_set(props, "a-z", "value3");
+    celix_properties_setLong(props, "a.x.z", 1);
+    celix_properties_setBool(props, "a.x.y", true);
+
+    // When encoding the properties with the nested style
+    std::string output;
+    ASSERT_EQ(CELIX_SUCCESS, encode(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE, output));
+
+    // Then the fields are nested and ordered by key
+    EXPECT_EQ(R"({"a":{"x":{"y":true,"z":1},"y":"value2"},"a-z":"value3","b":"value1"})", output);
+
+    // And with pretty print, the nested objects are indented
+    ASSERT_EQ(CELIX_SUCCESS, encode(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE | CELIX_PROPERTIES_ENCODE_PRETTY, output));
+    auto* expected = "{\n"
+                     "  \"a\": {\n"
+                     "    \"x\": {\n"
+                     "      \"y\": true,\n"
+                     "      \"z\": 1\n"
+                     "    },\n"
+                     "    \"y\": \"value2\"\n"
+                     "  },\n"
+                     "  \"a-z\": \"value3\",\n"
+                     "  \"b\": \"value1\"\n"
+                     "}";
+    EXPECT_EQ(expected, output);
+
+    // And the output can be decoded to the original properties
+    celix_autoptr(celix_properties_t) decoded = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, decode(output, CELIX_PROPERTIES_DECODE_STRICT, &decoded));
+    EXPECT_TRUE(celix_properties_equals(props, decoded));
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, EncodeNestedWithCollisionsTest) {
+    // Given a properties object with colliding keys
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "key.with.dot", "value1");
+    celix_properties_set(props, "key", "value2");
+    celix_properties_set(props, "key.other", "value3");
+
+    // When encoding the properties with the nested style, the value of the shortest key is written
+    std::string output;
+    ASSERT_EQ(CELIX_SUCCESS, encode(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE, output));
+    EXPECT_EQ(R"({"key":"value2"})", output);
+
+    // And when encoding with the error on collisions flag, the encoding fails
+    auto status = encode(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE | CELIX_PROPERTIES_ENCODE_ERROR_ON_COLLISIONS, output);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+    EXPECT_EQ(1, celix_err_getErrorCount());
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, EncodeNaNInfAndEmptyArraysTest) {
+    // Given a properties object with a NaN, an Inf array element and an empty array
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_setDouble(props, "nan", NAN);
+    celix_array_list_t* doubles = celix_arrayList_createDoubleArray();
+    celix_arrayList_addDouble(doubles, 1.0);
+    celix_arrayList_addDouble(doubles, INFINITY);
+    celix_properties_assignArrayList(props, "doubles", doubles);
+    celix_properties_assignArrayList(props, "empty", celix_arrayList_createLongArray());
+
+    // When encoding without flags, the NaN entry, Inf element and empty array are ignored
+    std::string output;
+    ASSERT_EQ(CELIX_SUCCESS, encode(props, 0, output));
+    EXPECT_EQ(R"({"doubles":[1.0]})", output);
+
+    // And with the error flags set, the encoding fails
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, encode(props, CELIX_PROPERTIES_ENCODE_ERROR_ON_NAN_INF, output));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, encode(props, CELIX_PROPERTIES_ENCODE_ERROR_ON_EMPTY_ARRAYS, output));
+    EXPECT_GE(celix_err_getErrorCount(), 2);
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, EncodeInvalidUtf8Test) {
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "key", "invalid \xff utf8");
+    std::string output;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, encode(props, 0, output));
+    EXPECT_EQ(1, celix_err_getErrorCount());
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, EncodeToInvalidStreamTest) {
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+    FILE* stream = fopen("/dev/null", "r"); // read only stream
+    ASSERT_NE(nullptr, stream);
+    setvbuf(stream, nullptr, _IONBF, 0);
+    EXPECT_EQ(CELIX_FILE_IO_EXCEPTION, celix_properties_encodeToStream(props, stream, 0));
+    fclose(stream);
+    EXPECT_EQ(1, celix_err_getErrorCount());
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, RoundTripTest) {
+    celix_autoptr(celix_properties_t) props = createMixedProperties();
+    for (int flags : {0, CELIX_PROPERTIES_ENCODE_PRETTY, CELIX_PROPERTIES_ENCODE_NESTED_STYLE}) {
+        std::string output;
+        ASSERT_EQ(CELIX_SUCCESS, encode(props, flags, output));
+        celix_autoptr(celix_properties_t) decoded = nullptr;
+        ASSERT_EQ(CELIX_SUCCESS, decode(output, CELIX_PROPERTIES_DECODE_STRICT, &decoded)) << output;
+        EXPECT_TRUE(celix_properties_equals(props, decoded)) << output;
+    }
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, DecodeIsEqualToLoadFromStringTest) {
+    // Given a set of (valid and invalid) JSON inputs
+    const char* inputs[] = {
+        R"({})",
+        R"( {"key": "value", "long": 1, "double": 2.5, "bool": false, "version": "version<1.2.3>"} )",
+        R"({"a": {"b": {"c": [1, 2.5, 3]}}, "d": ["x", "version<1.0.0>"]})",
+        R"({"versions": ["version<1.0.0>", "version<2.0.0>"], "bools": [true, false]})",
+        R"({"key": "é😀\n\/\"\\"})",
+        R"({"mixed": [1, "x"], "nulls": [null], "nested": [[1], [2]], "objects": [{"a": 1}]})",
+        R"({"empty": [], "null": null, "": 1})",
+        R"({"key": 2, "key": 3})",
+        R"({"a.b": 1, "a": {"b": 2}})",
+        R"({"n": 1E+2, "m": -0, "o": 1e-5})",
+        R"({"version": "version<invalid>"})",
+        R"({"a": 1,})",
+        R"({"a": 1} trailing)",
+        R"([1, 2])",
+        R"({"key": "\u0000"})",
+        R"({"n": 99999999999999999999})",
+        R"({"n": 01})",
+        R"({"key": tru})",
+        R"({"key": "unterminated)",
+    };
+
+    for (const char* input : inputs) {
+        for (int flags : {0, CELIX_PROPERTIES_DECODE_STRICT, CELIX_PROPERTIES_DECODE_ERROR_ON_COLLISIONS}) {
+            // When decoding the input with the streaming decoder and with the JSON document based decoder
+            celix_err_resetErrors();
+            celix_autoptr(celix_properties_t) props = nullptr;
+            auto status = decode(input, flags, &props);
+            celix_autoptr(celix_properties_t) expected = nullptr;
+            auto expectedStatus = celix_properties_loadFromString2(input, flags, &expected);
+
+            // Then the result is equal
+            EXPECT_EQ(expectedStatus, status) << "Input: " << input << ", flags: " << flags;
+            if (expected && props) {
+                EXPECT_TRUE(celix_properties_equals(expected, props)) << "Input: " << input << ", flags: " << flags;
+            }
+        }
+    }
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, DecodeDuplicateObjectKeysTest) {
+    // Given a JSON input with duplicate keys with JSON object values
+    std::string input = R"({"obj": {"key1": 1}, "obj": {"key2": 2}})";
+
+    // When decoding the input without the error on duplicates flag, the fields of both JSON objects are decoded
+    celix_autoptr(celix_properties_t) props = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, decode(input, 0, &props));
+    EXPECT_EQ(2, celix_properties_size(props));
+    EXPECT_EQ(1, celix_properties_getAsLong(props, "obj.key1", 0));
+    EXPECT_EQ(2, celix_properties_getAsLong(props, "obj.key2", 0));
+
+    // And when decoding with the error on duplicates flag, the decoding fails
+    celix_properties_t* props2 = nullptr;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, decode(input, CELIX_PROPERTIES_DECODE_ERROR_ON_DUPLICATES, &props2));
+    EXPECT_EQ(nullptr, props2);
+    EXPECT_EQ(1, celix_err_getErrorCount());
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, DecodeInvalidInputTest) {
+    const char* inputs[] = {
+        R"({"key": "\ud800"})",             // missing low surrogate
+        R"({"key": "\udc00"})",             // lone low surrogate
+        "{\"key\": \"\xc3\x28\"}",          // invalid UTF-8
+        "{\"key\": \"\x01\"}",              // control character
+        R"({"key": 1e999})",                // real overflow
+        R"({"key": [1, 2})",                // invalid array
+        R"({"key" 1})",                     // missing colon
+        R"({1: 2})",                        // invalid key
+    };
+    for (const char* input : inputs) {
+        celix_err_resetErrors();
+        celix_properties_t* props = nullptr;
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, decode(input, 0, &props)) << "Input: " << input;
+        EXPECT_EQ(nullptr, props);
+        EXPECT_EQ(1, celix_err_getErrorCount());
+    }
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, DecodeMaxDepthTest) {
+    // Given a JSON input with more nested arrays than the supported maximum depth
+    std::string input = R"({"key":)" + std::string(5000, '[') + std::string(5000, ']') + "}";
+
+    // When decoding the input, the decoding fails
+    celix_properties_t* props = nullptr;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, decode(input, 0, &props));
+    EXPECT_EQ(1, celix_err_getErrorCount());
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, DecodeFromStreamTest) {
+    // Given a large properties object encoded to a stream
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    for (int i = 0; i < 10000; ++i) {
+        auto key = "group" + std::to_string(i % 10) + ".key" + std::to_string(i);
+        celix_properties_setLong(props, key.c_str(), i);
+    }
+    std::string output;
+    ASSERT_EQ(CELIX_SUCCESS, encode(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE, output));
+
+    // When decoding the properties from a stream
+    FILE* stream = fmemopen((void*)output.c_str(), output.size(), "r");
+    ASSERT_NE(nullptr, stream);
+    celix_autoptr(celix_properties_t) decoded = nullptr;
+    auto status = celix_properties_decodeFromStream(stream, CELIX_PROPERTIES_DECODE_STRICT, &decoded);
+    fclose(stream);
+
+    // Then the decoded properties are equal to the original properties
+    ASSERT_EQ(CELIX_SUCCESS, status);
+    EXPECT_TRUE(celix_properties_equals(props, decoded));
+}
+
+TEST_F(PropertiesStreamEncodingTestSuite, DecodeFromInvalidStreamTest) {
+    FILE* stream = fopen("/dev/null", "w"); // write only stream
+    ASSERT_NE(nullptr, stream);
+    celix_properties_t* props = nullptr;
+    EXPECT_EQ(CELIX_FILE_IO_EXCEPTION, celix_properties_decodeFromStream(stream, 0, &props));
+    fclose(stream);
+    EXPECT_EQ(nullptr, props);
+    EXPECT_EQ(1, celix_err_getErrorCount());
+}
@@ -20,6 +20,8 @@
 #include <gtest/gtest.h>
 
 #include <climits>
+#include <string>
+#include <unistd.h>
 
 #include "celix_err.h"
 #include "celix_properties.h"
@@ -74,6 +76,55 @@ TEST_F(PropertiesTestSuite, LoadTest) {
     celix_properties_destroy(properties);
 }
 
+TEST_F(PropertiesTestSuite, LoadMappedFileTest) {
+    // Given a properties file with escaped characters, which is loaded using a private file mapping
+    const char* propertiesFile = "resources-test/properties_mapped.txt";
+    FILE* file = fopen(propertiesFile, "w");
+    ASSERT_NE(nullptr, file);
+    fputs("# comment\nkey1 = value1\nkey\\=2=value\\:2\n\nkey3=value3", file);
+    fclose(file);
+
+    // When the properties are loaded
+    celix_autoptr(celix_properties_t) props = celix_properties_load(propertiesFile);
+
+    // Then the keys and values are unescaped in place
+    ASSERT_NE(nullptr, props);
+    EXPECT_EQ(3, celix_properties_size(props));
+    EXPECT_STREQ("value1", celix_properties_get(props, "key1", nullptr));
+    EXPECT_STREQ("value:2", celix_properties_get(props, "key=2", nullptr));
+    EXPECT_STREQ("value3", celix_properties_get(props, "key3", nullptr));
+
+    // And the loaded entries can be overridden and removed
+    celix_properties_set(props, "key1", "value4");
+    EXPECT_STREQ("value4", celix_properties_get(props, "key1", nullptr));
+    celix_properties_unset(props, "key3");
+    EXPECT_FALSE(celix_properties_hasKey(props, "key3"));
+
+    // And a copy does not depend on the loaded file content
+    celix_autoptr(celix_properties_t) copy = celix_properties_copy(props);
+    celix_properties_destroy(celix_steal_ptr(props));
+    EXPECT_STREQ("value:2", celix_properties_get(copy, "key=2", nullptr));
+}
+
+TEST_F(PropertiesTestSuite, LoadPageSizedFileTest) {
+    // Given a properties file with a size of exactly 1 page and without a trailing newline
+    const char* propertiesFile = "resources-test/properties_page.txt";
+    long pageSize = sysconf(_SC_PAGESIZE);
+    std::string value(pageSize - 4, 'v');
+    FILE* file = fopen(propertiesFile, "w");
+    ASSERT_NE(nullptr, file);
+    fprintf(file, "key=%s", value.c_str());
+    fclose(file);
+
+    // When the properties are loaded
+    celix_autoptr(celix_properties_t) props = celix_properties_load(propertiesFile);
+
+    // Then the last value is complete
+    ASSERT_NE(nullptr, props);
+    EXPECT_EQ(1, celix_properties_size(props));
+    EXPECT_EQ(value, celix_properties_get(props, "key", ""));
+}
+
 TEST_F(PropertiesTestSuite, LoadFromStringTest) {
     const char* string = "key1=value1\nkey2=value2";
     auto* props = celix_properties_loadFromString(string);
@@ -1013,3 +1064,104 @@ TEST_F(PropertiesTestSuite, EmptyStringKeyTest) {
     EXPECT_EQ(1, celix_properties_size(props));
     EXPECT_STREQ("value", celix_properties_getString(props, ""));
 }
+
+TEST_F(PropertiesTestSuite, RetainAndReleaseTest) {
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+    EXPECT_FALSE(celix_properties_isShared(props));
+
+    const celix_properties_t* ref = celix_properties_retain(props);
+    EXPECT_EQ(ref, props);
+    EXPECT_TRUE(celix_properties_isShared(props));
+
+    //When the original owner destroys the properties, the retained reference is still valid
+    celix_properties_destroy(props);
+    EXPECT_FALSE(celix_properties_isShared(ref));
+    EXPECT_STREQ("value", celix_properties_getString(ref, "key"));
+    celix_properties_release(ref);
+
+    EXPECT_EQ(nullptr, celix_properties_retain(nullptr));
+    celix_properties_release(nullptr);
+}
+
+TEST_F(PropertiesTestSuite, FreezeTest) {
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+    celix_properties_setLong(props, "long", 1);
+    EXPECT_FALSE(celix_properties_isFrozen(props));
+
+    celix_properties_freeze(props);
+    EXPECT_TRUE(celix_properties_isFrozen(props));
+
+    //When modifying a frozen properties set, an error is returned and the properties set is not changed
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_properties_set(props, "key", "value2"));
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_properties_setLong(props, "long", 2));
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_properties_assignString(props, "key", celix_utils_strdup("value3")));
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_properties_assign(props, celix_utils_strdup("key"), celix_utils_strdup("v")));
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createLongArray();
+    celix_arrayList_addLong(list, 1);
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_properties_setArrayList(props, "list", list));
+    celix_properties_unset(props, "key");
+    EXPECT_EQ(6, celix_err_getErrorCount());
+
+    EXPECT_EQ(2, celix_properties_size(props));
+    EXPECT_STREQ("value", celix_properties_getString(props, "key"));
+    EXPECT_EQ(1, celix_properties_getLong(props, "long", 0));
+
+    //And a copy of a frozen properties set is not frozen
+    celix_autoptr(celix_properties_t) copy = celix_properties_copy(props);
+    EXPECT_FALSE(celix_properties_isFrozen(copy));
+    EXPECT_EQ(CELIX_SUCCESS, celix_properties_set(copy, "key", "value2"));
+}
+
+TEST_F(PropertiesTestSuite, ShareTest) {
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+
+    //When sharing a not frozen properties set, a frozen copy is returned
+    const celix_properties_t* shared1 = celix_properties_share(props);
+    EXPECT_NE(shared1, props);
+    EXPECT_TRUE(celix_properties_isFrozen(shared1));
+    EXPECT_FALSE(celix_properties_isShared(props));
+    EXPECT_TRUE(celix_properties_equals(props, shared1));
+
+    //When sharing a frozen properties set, the same instance is returned
+    const celix_properties_t* shared2 = celix_properties_share(shared1);
+    EXPECT_EQ(shared1, shared2);
+    EXPECT_TRUE(celix_properties_isShared(shared1));
+    celix_properties_release(shared2);
+    celix_properties_release(shared1);
+
+    EXPECT_EQ(nullptr, celix_properties_share(nullptr));
+}
+
+TEST_F(PropertiesTestSuite, MakeWritableTest) {
+    //Given a not shared, not frozen properties set, makeWritable does not copy
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+    celix_properties_t* original = props;
+    EXPECT_EQ(CELIX_SUCCESS, celix_properties_makeWritable(&props));
+    EXPECT_EQ(original, props);
+
+    //Given a shared properties set, makeWritable creates a private copy
+    const celix_properties_t* shared = celix_properties_retain(props);
+    EXPECT_EQ(CELIX_SUCCESS, celix_properties_makeWritable(&props));
+    EXPECT_NE(original, props);
+    EXPECT_FALSE(celix_properties_isShared(shared));
+    EXPECT_EQ(CELIX_SUCCESS, celix_properties_set(props, "key", "value2"));
+    EXPECT_STREQ("value", celix_properties_getString(shared, "key"));
+    EXPECT_STREQ("value2", celix_properties_getString(props, "key"));
+    celix_properties_release(shared);
+
+    //Given a frozen properties set, makeWritable creates a writable copy
+    celix_properties_freeze(props);
+    original = props;
+    EXPECT_EQ(CELIX_SUCCESS, celix_properties_makeWritable(&props));
+    EXPECT_NE(original, props);
+    EXPECT_FALSE(celix_properties_isFrozen(props));
+    EXPECT_EQ(CELIX_SUCCESS, celix_properties_set(props, "key", "value3"));
+    celix_properties_destroy(props);
+
+    celix_properties_t* nullProps = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, celix_properties_makeWritable(&nullProps));
+}
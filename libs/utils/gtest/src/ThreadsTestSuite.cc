@@ -19,7 +19,11 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
 #include <csignal>
+#include <thread>
+#include <vector>
 
 #include "celix_compiler.h"
 #include "celix_utils.h"
@@ -221,6 +225,15 @@ TEST_F(ThreadsTestSuite, AttrSettypeTest) {
     EXPECT_TRUE(celixThreadMutex_unlock(&mu) != CELIX_SUCCESS);
 
     celixThreadMutex_destroy(&mu);
+
+    //test adaptive mutex
+    EXPECT_EQ(CELIX_SUCCESS, celixThreadMutexAttr_settype(&mu_attr, CELIX_THREAD_MUTEX_ADAPTIVE));
+    celixThreadMutex_create(&mu, &mu_attr);
+    EXPECT_EQ(CELIX_SUCCESS, celixThreadMutex_lock(&mu));
+    EXPECT_NE(CELIX_SUCCESS, celixThreadMutex_tryLock(&mu));
+    EXPECT_EQ(CELIX_SUCCESS, celixThreadMutex_unlock(&mu));
+    celixThreadMutex_destroy(&mu);
+
     celixThreadMutexAttr_destroy(&mu_attr);
 }
 
@@ -371,6 +384,114 @@ TEST_F(ThreadsTestSuite, RwLockAttrTest) {
     celixThreadRwlockAttr_destroy(&attr);
 }
 
+TEST_F(ThreadsTestSuite, ReaderBiasedRwLockTest) {
+    celix_autoptr(celix_thread_rb_rwlock_t) lock = nullptr;
+    celix_thread_rb_rwlock_t rbLock;
+    ASSERT_EQ(CELIX_SUCCESS, celixThreadRbRwlock_create(&rbLock));
+    lock = &rbLock;
+
+    //recursive read locks
+    EXPECT_EQ(CELIX_SUCCESS, celixThreadRbRwlock_readLock(lock));
+    EXPECT_EQ(CELIX_SUCCESS, celixThreadRbRwlock_readLock(lock));
+    EXPECT_EQ(CELIX_SUCCESS, celixThreadRbRwlock_unlock(lock));
+    EXPECT_EQ(CELIX_SUCCESS, celixThreadRbRwlock_unlock(lock));
+
+    {
+        celix_auto(celix_rb_rwlock_wlock_guard_t) guard = celixRbRwlockWlockGuard_init(lock);
+    }
+    {
+        celix_auto(celix_rb_rwlock_rlock_guard_t) guard = celixRbRwlockRlockGuard_init(lock);
+    }
+
+    //a writer waits for readers and readers wait for an active writer
+    std::atomic<bool> writerDone{false};
+    celixThreadRbRwlock_readLock(lock);
+    std::thread writer{[&] {
+        celixThreadRbRwlock_writeLock(lock);
+        writerDone = true;
+        celixThreadRbRwlock_unlock(lock);
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    EXPECT_FALSE(writerDone);
+    //a recursive read lock is possible while a writer is waiting
+    EXPECT_EQ(CELIX_SUCCESS, celixThreadRbRwlock_readLock(lock));
+    celixThreadRbRwlock_unlock(lock);
+    EXPECT_FALSE(writerDone);
+    celixThreadRbRwlock_unlock(lock);
+    writer.join();
+    EXPECT_TRUE(writerDone);
+}
+
+TEST_F(ThreadsTestSuite, ReaderBiasedRwLockNestedOverflowTest) {
+    //Given a thread which holds read locks on more reader-biased locks than CELIX_THREAD_RB_RWLOCK_MAX_NESTED_LOCKS
+    constexpr int nrOfLocks = CELIX_THREAD_RB_RWLOCK_MAX_NESTED_LOCKS * 2 + 1;
+    std::vector<celix_thread_rb_rwlock_t> locks(nrOfLocks);
+    for (auto& lock : locks) {
+        ASSERT_EQ(CELIX_SUCCESS, celixThreadRbRwlock_create(&lock));
+        EXPECT_EQ(CELIX_SUCCESS, celixThreadRbRwlock_readLock(&lock));
+    }
+
+    //When a writer waits for the last lock
+    celix_thread_rb_rwlock_t* last = &locks.back();
+    std::atomic<bool> writerDone{false};
+    std::thread writer{[&] {
+        celixThreadRbRwlock_writeLock(last);
+        writerDone = true;
+        celixThreadRbRwlock_unlock(last);
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    EXPECT_FALSE(writerDone);
+
+    //Then a recursive read lock on the last lock is still possible
+    EXPECT_EQ(CELIX_SUCCESS, celixThreadRbRwlock_readLock(last));
+    EXPECT_EQ(CELIX_SUCCESS, celixThreadRbRwlock_unlock(last));
+    EXPECT_FALSE(writerDone);
+
+    //And the writer gets the lock when all read locks are released
+    for (auto& lock : locks) {
+        EXPECT_EQ(CELIX_SUCCESS, celixThreadRbRwlock_unlock(&lock));
+    }
+    writer.join();
+    EXPECT_TRUE(writerDone);
+    for (auto& lock : locks) {
+        celixThreadRbRwlock_destroy(&lock);
+    }
+}
+
+TEST_F(ThreadsTestSuite, ReaderBiasedRwLockConcurrencyTest) {
+    celix_thread_rb_rwlock_t lock;
+    celixThreadRbRwlock_create(&lock);
+    long values[2] = {0, 0}; //invariant values[0] == values[1]
+    std::atomic<long> invariantViolations{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 10000; ++i) {
+                if (t % 4 == 0 && i % 10 == 0) {
+                    celixThreadRbRwlock_writeLock(&lock);
+                    values[0] += 1;
+                    values[1] += 1;
+                    celixThreadRbRwlock_unlock(&lock);
+                } else {
+                    celixThreadRbRwlock_readLock(&lock);
+                    if (values[0] != values[1]) {
+                        invariantViolations += 1;
+                    }
+                    celixThreadRbRwlock_unlock(&lock);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, invariantViolations);
+    EXPECT_EQ(2000, values[0]);
+    EXPECT_EQ(2000, values[1]);
+    celixThreadRbRwlock_destroy(&lock);
+}
+
 TEST_F(ThreadsTestSuite, TssTest) {
     celix_tss_key_t key;
     celix_status_t status = celix_tss_create(&key, [](void* ptr) { free(ptr); });
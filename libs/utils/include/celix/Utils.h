@@ -109,13 +109,15 @@ namespace celix {
      * If the a non empty providedTypeName is provided this will be returned.
      * Otherwise the celix::impl::typeName will be used to infer the type name.
      * celix::impl::typeName uses the macro __PRETTY_FUNCTION__ to extract a type name.
+     * The type name is only inferred once per type.
      */
     template<typename I>
     std::string typeName(const std::string &providedTypeName = "") {
         if (!providedTypeName.empty()) {
             return providedTypeName;
         } else {
-            return celix::impl::extractTypeName<I>();
+            static const std::string inferredTypeName = celix::impl::extractTypeName<I>();
+            return inferredTypeName;
         }
     }
 
@@ -125,13 +127,15 @@ namespace celix {
      * If the a non empty providedCmpTypeName is provided this will be returned.
      * Otherwise the celix::impl::typeName will be used to infer the type name.
      * celix::impl::typeName uses the macro __PRETTY_FUNCTION__ to extract a type name.
+     * The type name is only inferred once per type.
      */
     template<typename T>
     std::string cmpTypeName(const std::string &providedCmpTypeName = "") {
         if (!providedCmpTypeName.empty()) {
             return providedCmpTypeName;
         } else {
-            return celix::impl::extractTypeName<T>();
+            static const std::string inferredTypeName = celix::impl::extractTypeName<T>();
+            return inferredTypeName;
         }
     }
 
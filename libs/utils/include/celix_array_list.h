@@ -98,6 +98,14 @@ typedef int (*celix_array_list_compare_entries_fp)(celix_array_list_entry_t a, c
  */
 typedef celix_status_t (*celix_array_list_copy_entry_fp)(celix_array_list_entry_t src, celix_array_list_entry_t* dst);
 
+/**
+ * @brief Predicate function for array list entries, which can be used to remove or retain array list entries.
+ * @param data The data provided to the remove/retain function.
+ * @param entry The array list entry to test.
+ * @return true if the entry matches the predicate.
+ */
+typedef bool (*celix_array_list_entry_predicate_fp)(void* data, celix_array_list_entry_t entry);
+
 /**
  * @brief Creates a new empty array list with an undefined element type.
  * @deprecated Use celix_arrayList_createWithOptions or celix_arrayList_create<Type>Array instead.
@@ -537,6 +545,48 @@ int celix_arrayList_indexOf(celix_array_list_t *list, celix_array_list_entry_t e
 CELIX_UTILS_EXPORT
 void celix_arrayList_removeAt(celix_array_list_t *list, int index);
 
+/**
+ * @brief Removes an entry at the provided index by replacing it with the last entry of the array list.
+ *
+ * In contrast to celix_arrayList_removeAt, this is a O(1) operation, but the order of the array list entries is
+ * not preserved.
+ * If the provided index < 0 or out of bound, nothing will be removed.
+ *
+ * @note If a (simple) removed callback is configured, the callback will be called for the removed entry.
+ */
+CELIX_UTILS_EXPORT
+void celix_arrayList_swapRemoveAt(celix_array_list_t* list, int index);
+
+/**
+ * @brief Removes all entries for which the provided predicate returns true.
+ *
+ * The order of the remaining entries is preserved and the entries are moved at most once, so removing multiple
+ * entries is a O(n) operation instead of a O(n) operation per removed entry.
+ * The predicate should not modify the array list.
+ *
+ * @note If a (simple) removed callback is configured, the callback will be called for every removed entry.
+ *
+ * @param list The array list.
+ * @param predicate The predicate called for every array list entry.
+ * @param data The data provided to the predicate.
+ * @return The number of removed entries.
+ */
+CELIX_UTILS_EXPORT
+int celix_arrayList_removeIf(celix_array_list_t* list, celix_array_list_entry_predicate_fp predicate, void* data);
+
+/**
+ * @brief Removes all entries for which the provided predicate returns false.
+ *
+ * Same as celix_arrayList_removeIf, but with an inverted predicate.
+ *
+ * @param list The array list.
+ * @param predicate The predicate called for every array list entry.
+ * @param data The data provided to the predicate.
+ * @return The number of removed entries.
+ */
+CELIX_UTILS_EXPORT
+int celix_arrayList_retainIf(celix_array_list_t* list, celix_array_list_entry_predicate_fp predicate, void* data);
+
 /**
  * @brief Clear all entries in the array list.
  *
@@ -642,6 +692,57 @@ void celix_arrayList_sortEntries(celix_array_list_t *list, celix_array_list_comp
 CELIX_UTILS_EXPORT
 void celix_arrayList_sort(celix_array_list_t *list);
 
+/**
+ * @brief Add an entry to a sorted array list, so that the array list stays sorted.
+ *
+ * The array list must be sorted using the array list configured compare function. The entry is added after
+ * the entries which are equal to the provided entry. If the array list has no compare function, the entry is added
+ * to the back of the array list.
+ *
+ * The entry is added as-is; if the array list is the owner of its entries (e.g. a string or version array list),
+ * the array list takes ownership of the entry.
+ *
+ * If the return status is an error, an error message is logged to celix_err.
+ *
+ * @param list The sorted array list.
+ * @param entry The entry to add.
+ * @return CELIX_SUCCESS if the entry is added, CELIX_ENOMEM if the array list is out of memory. If an error is
+ * returned, the entry is not added and the (simple) removed callback, if configured, is called for the entry.
+ */
+CELIX_UTILS_EXPORT
+celix_status_t celix_arrayList_addEntrySorted(celix_array_list_t* list, celix_array_list_entry_t entry);
+
+/**
+ * @brief Returns the index of the provided entry in a sorted array list using a binary search.
+ *
+ * The array list must be sorted using the array list configured compare function. If there are multiple entries
+ * equal to the provided entry, the index of the first one is returned.
+ * If the array list has no compare function, this falls back to celix_arrayList_indexOf.
+ *
+ * @param list The sorted array list.
+ * @param entry The entry to find.
+ * @return The index of the entry or -1 if the entry is not found.
+ */
+CELIX_UTILS_EXPORT
+int celix_arrayList_binarySearch(const celix_array_list_t* list, celix_array_list_entry_t entry);
+
+/**
+ * @brief Add all entries of the other array list to the back of the array list.
+ *
+ * The array lists must have the same element type. For copying the entries the copy callback of the array list will
+ * be used, if the copy callback is NULL a shallow copy will be done. The capacity of the array list is increased at
+ * most once.
+ *
+ * If the return status is an error, an error message is logged to celix_err.
+ *
+ * @param list The array list to add the entries to.
+ * @param other The array list to add the entries from. Can be the same array list.
+ * @return CELIX_SUCCESS if the entries are added, CELIX_ILLEGAL_ARGUMENT if the array lists have a different element
+ * type and CELIX_ENOMEM if the array list is out of memory. If an error is returned, the array list is unchanged.
+ */
+CELIX_UTILS_EXPORT
+celix_status_t celix_arrayList_addAll(celix_array_list_t* list, const celix_array_list_t* other);
+
 /**
  * @brief Check if the array list are equal.
  *
@@ -84,6 +84,48 @@ CELIX_UTILS_EXPORT celix_status_t celix_utils_extractZipFile(const char* zipPath
  */
 CELIX_UTILS_EXPORT celix_status_t celix_utils_extractZipData(const void *zipData, size_t zipDataSize, const char* extractToDir, const char** errorOut);
 
+/**
+ * @brief Incrementally extract the zip file to the target dir, sharing identical files through a content store.
+ *
+ * Every extracted file is identified by a content key: the 64-bit FNV-1a hash of the file data combined with the
+ * CRC-32 and size of the zip entry. Files are stored once in contentStoreDir and hardlinked into extractToDir, so
+ * identical files extracted from different zip files (or from different versions of the same zip file) share their
+ * data. If hardlinks are not supported, files are reflinked or copied instead.
+ * Shared objects (`*.so`, `*.so.*` and `*.dylib` files) are never shared, because the dynamic loader identifies a loaded
+ * library by its inode: bundles with a hardlinked identical library would share the library and its static state.
+ *
+ * The content keys of the extracted files are kept in an index file. On a next extraction to the same dir:
+ *  - entries with an unchanged CRC-32 and size are not extracted again;
+ *  - changed entries are written as new files (and thus get a new inode);
+ *  - files of entries which are no longer present in the zip file are removed.
+ *
+ * Files in the content store are read-only, because they can be shared. Files in the content store which are no
+ * longer used by an extraction dir can be removed with celix_utils_pruneContentStore.
+ *
+ * Will create the extractToDir and contentStoreDir if they do not already exist.
+ *
+ * @param zipPath The path to the zip file.
+ * @param extractToDir The path where the zip file will be extracted.
+ * @param contentStoreDir The path of the content store. Should be on the same filesystem as extractToDir.
+ * @param indexPath The path of the index file for extractToDir. Should not be located in extractToDir.
+ * @param errorOut An optional error output argument. If an error occurs this will point to a (static) error message.
+ * @return CELIX_SUCCESS if the zip file was extracted successfully.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_utils_extractZipFileIncrementally(const char* zipPath,
+                                                                          const char* extractToDir,
+                                                                          const char* contentStoreDir,
+                                                                          const char* indexPath,
+                                                                          const char** errorOut);
+
+/**
+ * @brief Remove the files from the content store which are no longer used by an extraction dir.
+ *
+ * @param contentStoreDir The path of the content store. If the content store does not exist, nothing is done.
+ * @param errorOut An optional error output argument. If an error occurs this will point to a (static) error message.
+ * @return CELIX_SUCCESS if the content store was successfully pruned.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_utils_pruneContentStore(const char* contentStoreDir, const char** errorOut);
+
 /**
  * @brief Returns the last modified time of the file at path.
  *
@@ -0,0 +1,140 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_LOCK_PROFILING_H_
+#define CELIX_LOCK_PROFILING_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "celix_errno.h"
+#include "celix_utils_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file celix_lock_profiling.h
+ * @brief Lock contention profiling for the celix_threads mutex, rwlock and condition wrappers.
+ *
+ * Lock profiling is only available if Celix is build with the `CELIX_THREADS_LOCK_PROFILING` CMake option.
+ * If available, profiling is disabled by default and can be enabled at runtime with celix_lockProfiling_setEnabled.
+ *
+ * When enabled, the celixThreadMutex_*, celixThreadRwlock_* and celixThreadCondition_* wrappers record - per lock -
+ * the number of acquisitions, the number of contended acquisitions, a wait time histogram and the hold times.
+ * The statistics are aggregated per thread without locking and merged when requested.
+ *
+ * Every thread can profile at most 256 distinct locks at the same time. When a lock is destroyed its statistics are
+ * removed, so that a thread can profile new locks and a new lock at the same address starts with empty statistics.
+ * Acquisitions of locks that do not fit in the table of a thread are not profiled; their number is reported by
+ * celix_lockProfiling_print.
+ */
+
+/**
+ * @brief The max length (including the terminating '\0') of a lock name.
+ */
+#define CELIX_LOCK_PROFILING_MAX_NAME_LENGTH 64
+
+/**
+ * @brief The number of buckets in the wait time histogram.
+ *
+ * Bucket 0 contains waits shorter than 1us (1024ns), bucket i (0 < i < size-1) contains waits in the range
+ * [2^(9+i), 2^(10+i)) ns and the last bucket contains all longer waits.
+ */
+#define CELIX_LOCK_PROFILING_HISTOGRAM_SIZE 16
+
+/**
+ * @brief The aggregated profiling statistics of a single lock.
+ */
+typedef struct celix_lock_profile_stats {
+    const void* lock;                                   /**< The address of the profiled lock. */
+    char name[CELIX_LOCK_PROFILING_MAX_NAME_LENGTH];    /**< The name of the lock or "" if the lock is not named. */
+    uint64_t acquisitions;                              /**< The number of (read or write) acquisitions. */
+    uint64_t contentions;                               /**< The number of acquisitions that had to wait. */
+    uint64_t totalWaitNs;                               /**< The total time waited to acquire the lock. */
+    uint64_t maxWaitNs;                                 /**< The longest time waited to acquire the lock. */
+    uint64_t totalHoldNs;                               /**< The total time the lock was held. */
+    uint64_t maxHoldNs;                                 /**< The longest time the lock was held. */
+    uint64_t waitHistogram[CELIX_LOCK_PROFILING_HISTOGRAM_SIZE]; /**< Histogram of the contended wait times. */
+} celix_lock_profile_stats_t;
+
+/**
+ * @brief Returns whether lock profiling is compiled in.
+ */
+CELIX_UTILS_EXPORT bool celix_lockProfiling_isSupported(void);
+
+/**
+ * @brief Enables or disables lock profiling.
+ *
+ * Locks acquired while profiling is disabled are not accounted for.
+ *
+ * @return CELIX_SUCCESS or CELIX_ILLEGAL_STATE if lock profiling is not supported (not compiled in).
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_lockProfiling_setEnabled(bool enabled);
+
+/**
+ * @brief Returns whether lock profiling is enabled.
+ */
+CELIX_UTILS_EXPORT bool celix_lockProfiling_isEnabled(void);
+
+/**
+ * @brief Names a lock, so that it can be identified in the profiling output.
+ *
+ * The name is formatted using a printf-style format and truncated to CELIX_LOCK_PROFILING_MAX_NAME_LENGTH - 1 chars.
+ * The name is removed when the lock is destroyed. Does nothing if lock profiling is not supported.
+ *
+ * @param[in] lock The address of a celix_thread_mutex_t or celix_thread_rwlock_t.
+ * @param[in] format The printf-style format of the name.
+ */
+CELIX_UTILS_EXPORT void celix_lockProfiling_setName(const void* lock, const char* format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Resets the profiling statistics of all locks.
+ *
+ * Lock names are kept.
+ */
+CELIX_UTILS_EXPORT void celix_lockProfiling_reset(void);
+
+/**
+ * @brief Retrieves the statistics of the most contended locks, sorted by total wait time (descending).
+ *
+ * Locks without any acquisitions since the last reset are not included.
+ *
+ * @param[out] stats The array to store the statistics in.
+ * @param[in] maxStats The size of the stats array.
+ * @return The number of entries stored in stats.
+ */
+CELIX_UTILS_EXPORT size_t celix_lockProfiling_getTopContended(celix_lock_profile_stats_t* stats, size_t maxStats);
+
+/**
+ * @brief Prints the statistics of the (at most) topN most contended locks to the provided stream.
+ *
+ * @return CELIX_SUCCESS, CELIX_ENOMEM or CELIX_ILLEGAL_STATE if lock profiling is not supported.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_lockProfiling_print(FILE* stream, size_t topN);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_LOCK_PROFILING_H_ */
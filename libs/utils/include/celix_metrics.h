@@ -0,0 +1,135 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_METRICS_H_
+#define CELIX_METRICS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "celix_errno.h"
+#include "celix_utils_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file celix_metrics.h
+ * @brief Metric primitives for runtime statistics and a writer for the Prometheus text exposition format.
+ *
+ * Metrics are designed to be updated on hot paths: counters, gauges and histograms are plain integers which are
+ * updated with relaxed atomics and are only read when the metrics are collected.
+ */
+
+/**
+ * @brief The number of buckets in a metrics histogram.
+ *
+ * Bucket 0 contains durations shorter than 1us (1024ns), bucket i (0 < i < size-1) contains durations in the range
+ * [2^(9+i), 2^(10+i)) ns and the last bucket contains all longer durations (> ~1s).
+ */
+#define CELIX_METRICS_HISTOGRAM_SIZE 22
+
+/**
+ * @brief The type of a metric, matching the Prometheus metric types.
+ */
+typedef enum celix_metric_type {
+    CELIX_METRIC_TYPE_COUNTER = 0,   /**< A monotonically increasing value. */
+    CELIX_METRIC_TYPE_GAUGE = 1,     /**< A value that can go up and down. */
+    CELIX_METRIC_TYPE_HISTOGRAM = 2, /**< A duration histogram, see celix_metrics_histogram_t. */
+} celix_metric_type_e;
+
+/**
+ * @brief A lock-free duration histogram.
+ *
+ * A zero initialized histogram is valid. All fields are updated with relaxed atomics.
+ */
+typedef struct celix_metrics_histogram {
+    uint64_t buckets[CELIX_METRICS_HISTOGRAM_SIZE]; /**< Nr of recorded durations per bucket (not cumulative). */
+    uint64_t count;                                 /**< Total nr of recorded durations. */
+    uint64_t sumNs;                                 /**< Sum of the recorded durations in nanoseconds. */
+} celix_metrics_histogram_t;
+
+/**
+ * @brief A collected metric.
+ *
+ * The name should follow the Prometheus naming conventions (e.g. `celix_framework_events_processed_total`).
+ * Metrics with the same name should be collected consecutively, so that they can be written as a single metric family.
+ */
+typedef struct celix_metric {
+    const char* name;                             /**< The metric name. */
+    const char* help;                             /**< The metric description, can be NULL. */
+    const char* labels;                           /**< Optional labels without braces, e.g. `level="error"`. */
+    celix_metric_type_e type;                     /**< The metric type. */
+    double value;                                 /**< The value for counter and gauge metrics. */
+    const celix_metrics_histogram_t* histogram;   /**< The histogram for histogram metrics. */
+} celix_metric_t;
+
+/**
+ * @brief Record a duration in the histogram.
+ */
+CELIX_UTILS_EXPORT void celix_metricsHistogram_record(celix_metrics_histogram_t* histogram, uint64_t durationNs);
+
+/**
+ * @brief Record the duration between start and now (CLOCK_MONOTONIC) in the histogram.
+ */
+CELIX_UTILS_EXPORT void celix_metricsHistogram_recordSince(celix_metrics_histogram_t* histogram, const struct timespec* start);
+
+/**
+ * @brief Take a (relaxed) snapshot of the histogram.
+ */
+CELIX_UTILS_EXPORT void celix_metricsHistogram_snapshot(const celix_metrics_histogram_t* histogram, celix_metrics_histogram_t* snapshot);
+
+/**
+ * @brief Return the upper bound of a histogram bucket in seconds, or INFINITY for the last bucket.
+ */
+CELIX_UTILS_EXPORT double celix_metricsHistogram_bucketUpperBound(int bucket);
+
+/**
+ * @brief Estimate a quantile (0.0 - 1.0) of the histogram, as the upper bound (in seconds) of the bucket containing
+ * the quantile. Returns 0 for an empty histogram.
+ */
+CELIX_UTILS_EXPORT double celix_metricsHistogram_quantile(const celix_metrics_histogram_t* histogram, double quantile);
+
+/**
+ * @brief Write a metric in the Prometheus text exposition format (version 0.0.4).
+ *
+ * @param[in] stream The stream to write to.
+ * @param[in] metric The metric to write.
+ * @param[in] writeHeader Whether to write the `# HELP` and `# TYPE` lines. Should only be true for the first metric
+ *                        of a metric family.
+ * @return CELIX_SUCCESS or CELIX_ILLEGAL_ARGUMENT if the metric has no name or a histogram metric has no histogram.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_metrics_writePrometheus(FILE* stream, const celix_metric_t* metric, bool writeHeader);
+
+/**
+ * @brief Write a metric as a single human readable line.
+ *
+ * Counters and gauges are written as `name{labels} value`, histograms as the count, average and estimated
+ * p50/p99 durations.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_metrics_writeText(FILE* stream, const celix_metric_t* metric);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_METRICS_H_ */
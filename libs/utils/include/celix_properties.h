@@ -123,6 +123,9 @@ CELIX_UTILS_EXPORT celix_properties_t* celix_properties_create();
 /**
  * @brief Destroy a property set, freeing all associated resources.
  *
+ * If the property set is shared (see celix_properties_retain), only the callers reference is released and the
+ * property set is destroyed when the last reference is released.
+ *
  * @param[in] properties The property set to destroy. If properties is NULL, this function will do nothing.
  */
 CELIX_UTILS_EXPORT void celix_properties_destroy(celix_properties_t* properties);
@@ -132,6 +135,10 @@ CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(celix_properties_t, celix_properties_destroy)
 /**
  * @brief Load properties from a file.
  *
+ * Regular files are loaded using a private file mapping, which is tokenized in place; the keys and values of the
+ * loaded properties reference the mapped memory instead of being copied. The mapping is released when the
+ * properties set is destroyed. Other files are loaded using a stream.
+ *
  * If the return status is an error, an error message is logged to celix_err.
  *
  * @param[in] filename The name of the file to load properties from.
@@ -846,6 +853,85 @@ CELIX_UTILS_EXPORT void celix_properties_unset(celix_properties_t* properties, c
  */
 CELIX_UTILS_EXPORT celix_properties_t* celix_properties_copy(const celix_properties_t* properties);
 
+/**
+ * @brief Freeze a property set, making it immutable.
+ *
+ * A frozen property set can no longer be modified; the set, assign and unset functions will return
+ * CELIX_ILLEGAL_STATE (or do nothing for unset) and log an error to celix_err.
+ * Frozen property sets can be shared between multiple owners without copying, see celix_properties_share.
+ * Freezing cannot be undone, use celix_properties_makeWritable to get a modifiable property set.
+ *
+ * @param[in] properties The property set to freeze. If NULL, this function will do nothing.
+ */
+CELIX_UTILS_EXPORT void celix_properties_freeze(celix_properties_t* properties);
+
+/**
+ * @brief Check whether a property set is frozen.
+ * @param[in] properties The property set.
+ * @return True if the property set is frozen.
+ */
+CELIX_UTILS_EXPORT bool celix_properties_isFrozen(const celix_properties_t* properties);
+
+/**
+ * @brief Retain a property set, increasing its reference count.
+ *
+ * Property sets are reference counted. celix_properties_create creates a property set with a reference count of 1
+ * and celix_properties_destroy (or celix_properties_release) releases a reference; the property set is only
+ * destroyed when the last reference is released.
+ *
+ * A retained reference is a read-only reference. The caller is responsible for not modifying a property set that
+ * is shared, use celix_properties_makeWritable to get a private copy before modifying it.
+ *
+ * @param[in] properties The property set to retain. Can be NULL.
+ * @return The provided property set.
+ */
+CELIX_UTILS_EXPORT const celix_properties_t* celix_properties_retain(const celix_properties_t* properties);
+
+/**
+ * @brief Release a reference to a property set retained with celix_properties_retain or celix_properties_share.
+ *
+ * Same as celix_properties_destroy, but accepts a read-only reference.
+ *
+ * @param[in] properties The property set to release. If NULL, this function will do nothing.
+ */
+CELIX_UTILS_EXPORT void celix_properties_release(const celix_properties_t* properties);
+
+/**
+ * @brief Check whether a property set is shared, i.e. has more than one reference.
+ * @param[in] properties The property set.
+ * @return True if the property set is shared.
+ */
+CELIX_UTILS_EXPORT bool celix_properties_isShared(const celix_properties_t* properties);
+
+/**
+ * @brief Get a shareable, read-only reference to a property set.
+ *
+ * If the property set is frozen, the property set is retained and returned (no copy is made). Otherwise a frozen
+ * copy of the property set is returned, so that the caller can continue to modify its own property set.
+ *
+ * If the return status is an error, an error message is logged to celix_err.
+ *
+ * @param[in] properties The property set to share.
+ * @return A frozen property set which should be released with celix_properties_release, or NULL if properties is
+ *         NULL or the copy failed.
+ */
+CELIX_UTILS_EXPORT const celix_properties_t* celix_properties_share(const celix_properties_t* properties);
+
+/**
+ * @brief Make a property set writable using copy-on-write.
+ *
+ * If the property set is frozen or shared, the property set is copied, the callers reference to the original
+ * property set is released and the provided pointer is updated to the (writable) copy.
+ * Otherwise the property set is left untouched.
+ *
+ * If the return status is an error, an error message is logged to celix_err.
+ *
+ * @param[in,out] properties The property set to make writable. If the property set is NULL, nothing is done.
+ * @return CELIX_SUCCESS if the operation was successful or CELIX_ENOMEM if the copy failed. In case of an error
+ *         the provided pointer is not updated.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_properties_makeWritable(celix_properties_t** properties);
+
 /**
  * @brief Get the number of properties in a property set.
  *
@@ -1287,6 +1373,78 @@ CELIX_UTILS_EXPORT celix_status_t celix_properties_loadFromString2(const char* i
                                                                    int decodeFlags,
                                                                    celix_properties_t** out);
 
+/**
+ * @brief Encode properties as a JSON representation to a stream, without creating an intermediate JSON document.
+ *
+ * Supports the same encode flags as celix_properties_saveToStream and results in an equivalent JSON representation,
+ * but writes the properties entries directly to the stream. This avoids the memory and allocations needed for
+ * an intermediate JSON document and is therefore preferred for large properties sets.
+ *
+ * Differences with celix_properties_saveToStream:
+ * - With the CELIX_PROPERTIES_ENCODE_NESTED_STYLE flag, the JSON object fields are written ordered by key. For
+ *   colliding keys (e.g. "key" and "key.with.dot"), the value of the shortest key is written.
+ * - If an error occurs, the stream can contain a partial JSON representation.
+ *
+ * For a overview of the possible encode flags, see the CELIX_PROPERTIES_ENCODE_* flags documentation.
+ *
+ * @param[in] properties The properties object to encode.
+ * @param[in] stream The stream to write the JSON representation of the properties object to.
+ * @param[in] encodeFlags The flags to use when encoding the input properties.
+ * @return CELIX_SUCCESS if the operation was successful, CELIX_ILLEGAL_ARGUMENT if the provided properties cannot be
+ * encoded to a JSON representation (this includes strings which are not valid UTF-8), ENOMEM if there was not enough
+ * memory and CELIX_FILE_IO_EXCEPTION if the stream could not be written to.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_properties_encodeToStream(const celix_properties_t* properties,
+                                                                  FILE* stream,
+                                                                  int encodeFlags);
+
+/**
+ * @brief Decode properties from a JSON buffer, without creating an intermediate JSON document.
+ *
+ * Supports the same decode flags as celix_properties_loadFromStream and decodes the same JSON input to equivalent
+ * properties, but the JSON input is tokenized and the properties entries are directly added to the resulting
+ * properties object. This avoids the memory and allocations needed for an intermediate JSON document and is
+ * therefore preferred for large inputs.
+ *
+ * Difference with celix_properties_loadFromStream: if the CELIX_PROPERTIES_DECODE_ERROR_ON_DUPLICATES flag is not
+ * set and a JSON object contains duplicate keys, the last value is used; but if one of the duplicate values is a
+ * JSON object, the properties entries decoded from all the duplicate values are kept.
+ *
+ * For a overview of the possible decode flags, see the CELIX_PROPERTIES_DECODE_* flags documentation.
+ *
+ * If an error occurs, the error status is returned and a message is logged to celix_err.
+ *
+ * @param[in] input The JSON input to decode. Does not need to be NUL-terminated.
+ * @param[in] inputLen The length of the JSON input.
+ * @param[in] decodeFlags The flags to use when decoding the input.
+ * @param[out] out The properties object that will be created from the input. The caller is responsible for
+ * freeing the returned properties object using celix_properties_destroy.
+ * @return CELIX_SUCCESS if the operation was successful, CELIX_ILLEGAL_ARGUMENT if the provided input cannot be
+ * decoded to a properties object and ENOMEM if there was not enough memory.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_properties_decodeFromBuffer(const char* input,
+                                                                    size_t inputLen,
+                                                                    int decodeFlags,
+                                                                    celix_properties_t** out);
+
+/**
+ * @brief Decode properties from a JSON stream, without creating an intermediate JSON document.
+ *
+ * The stream is read until the end of the stream and the content is decoded using celix_properties_decodeFromBuffer.
+ * The stream is not reset or closed by this function.
+ *
+ * @param[in] stream The input stream to decode.
+ * @param[in] decodeFlags The flags to use when decoding the input.
+ * @param[out] out The properties object that will be created from the input. The caller is responsible for
+ * freeing the returned properties object using celix_properties_destroy.
+ * @return CELIX_SUCCESS if the operation was successful, CELIX_ILLEGAL_ARGUMENT if the provided input cannot be
+ * decoded to a properties object, ENOMEM if there was not enough memory and CELIX_FILE_IO_EXCEPTION if the stream
+ * could not be read.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_properties_decodeFromStream(FILE* stream,
+                                                                    int decodeFlags,
+                                                                    celix_properties_t** out);
+
 #ifdef __cplusplus
 }
 #endif
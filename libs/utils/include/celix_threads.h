@@ -87,7 +87,8 @@ enum {
     CELIX_THREAD_MUTEX_NORMAL,
     CELIX_THREAD_MUTEX_RECURSIVE,
     CELIX_THREAD_MUTEX_ERRORCHECK,
-    CELIX_THREAD_MUTEX_DEFAULT
+    CELIX_THREAD_MUTEX_DEFAULT,
+    CELIX_THREAD_MUTEX_ADAPTIVE  /**< Spins shortly before parking the thread. Same as DEFAULT if not supported. */
 };
 
 
@@ -274,6 +275,111 @@ CELIX_UTILS_EXPORT celix_status_t celixThreadRwlockAttr_destroy(celix_thread_rwl
 
 CELIX_DEFINE_AUTO_CLEANUP_CLEAR_FUNC(celix_thread_rwlockattr_t, celixThreadRwlockAttr_destroy)
 
+/**
+ * @brief The number of reader counter slots of a celix_thread_rb_rwlock_t.
+ */
+#define CELIX_THREAD_RB_RWLOCK_READER_SLOTS 16
+
+/**
+ * @brief A reader-biased read-write lock.
+ *
+ * Readers only increment a reader counter selected by the calling thread, so that readers on different threads
+ * - as long as there is no writer - do not write to the same cache line. Writers are serialized by a mutex, announce
+ * themselves and wait - after a short spin, on a condition - until all reader counters are drained. New readers back
+ * off while a writer is active (writer preferring).
+ *
+ * Compared to celix_thread_rwlock_t, read locking is cheaper and scales with the number of cores, but write locking is
+ * more expensive. It is intended for read-mostly locks.
+ *
+ * A thread can recursively obtain a read lock, also if a writer is waiting. To support this, every thread keeps track
+ * of the reader-biased locks it holds a read lock on. Beyond CELIX_THREAD_RB_RWLOCK_MAX_NESTED_LOCKS different locks
+ * this administration is heap allocated.
+ * Obtaining a write lock while holding a read lock on the same lock results in a deadlock.
+ *
+ * The struct members are private, use the celixThreadRbRwlock_* functions.
+ */
+typedef struct celix_thread_rb_rwlock {
+    struct {
+        long readers;
+        char padding[64 - sizeof(long)];
+    } _slots[CELIX_THREAD_RB_RWLOCK_READER_SLOTS];
+    bool _writerActive;
+    bool _writerWaiting;
+    const void* _writer;
+    pthread_mutex_t _writerMutex;
+    pthread_mutex_t _drainMutex;
+    pthread_cond_t _drainCond;
+} celix_thread_rb_rwlock_t;
+
+/**
+ * @brief The number of different reader-biased locks a thread can hold a read lock on, before the administration for
+ * recursive read locking is heap allocated.
+ */
+#define CELIX_THREAD_RB_RWLOCK_MAX_NESTED_LOCKS 8
+
+CELIX_UTILS_EXPORT celix_status_t celixThreadRbRwlock_create(celix_thread_rb_rwlock_t* lock);
+
+CELIX_UTILS_EXPORT celix_status_t celixThreadRbRwlock_destroy(celix_thread_rb_rwlock_t* lock);
+
+CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(celix_thread_rb_rwlock_t, celixThreadRbRwlock_destroy)
+
+CELIX_UTILS_EXPORT celix_status_t celixThreadRbRwlock_readLock(celix_thread_rb_rwlock_t* lock);
+
+CELIX_UTILS_EXPORT celix_status_t celixThreadRbRwlock_writeLock(celix_thread_rb_rwlock_t* lock);
+
+/**
+ * @brief Releases a read or write lock obtained by the calling thread.
+ */
+CELIX_UTILS_EXPORT celix_status_t celixThreadRbRwlock_unlock(celix_thread_rb_rwlock_t* lock);
+
+/**
+ * @brief A RAII style write lock guard for celix_thread_rb_rwlock_t.
+ *
+ * See celix_rwlock_wlock_guard_t.
+ */
+typedef struct celix_rb_rwlock_wlock_guard {
+    celix_thread_rb_rwlock_t* lock;
+} celix_rb_rwlock_wlock_guard_t;
+
+static CELIX_UNUSED inline celix_rb_rwlock_wlock_guard_t celixRbRwlockWlockGuard_init(celix_thread_rb_rwlock_t* lock) {
+    celix_rb_rwlock_wlock_guard_t guard;
+    guard.lock = lock;
+    celixThreadRbRwlock_writeLock(lock);
+    return guard;
+}
+
+static CELIX_UNUSED inline void celixRbRwlockWlockGuard_deinit(celix_rb_rwlock_wlock_guard_t* guard) {
+    if (guard->lock) {
+        celixThreadRbRwlock_unlock(guard->lock);
+    }
+}
+
+CELIX_DEFINE_AUTO_CLEANUP_CLEAR_FUNC(celix_rb_rwlock_wlock_guard_t, celixRbRwlockWlockGuard_deinit)
+
+/**
+ * @brief A RAII style read lock guard for celix_thread_rb_rwlock_t.
+ *
+ * See celix_rwlock_rlock_guard_t.
+ */
+typedef struct celix_rb_rwlock_rlock_guard {
+    celix_thread_rb_rwlock_t* lock;
+} celix_rb_rwlock_rlock_guard_t;
+
+static CELIX_UNUSED inline celix_rb_rwlock_rlock_guard_t celixRbRwlockRlockGuard_init(celix_thread_rb_rwlock_t* lock) {
+    celix_rb_rwlock_rlock_guard_t guard;
+    guard.lock = lock;
+    celixThreadRbRwlock_readLock(lock);
+    return guard;
+}
+
+static CELIX_UNUSED inline void celixRbRwlockRlockGuard_deinit(celix_rb_rwlock_rlock_guard_t* guard) {
+    if (guard->lock) {
+        celixThreadRbRwlock_unlock(guard->lock);
+    }
+}
+
+CELIX_DEFINE_AUTO_CLEANUP_CLEAR_FUNC(celix_rb_rwlock_rlock_guard_t, celixRbRwlockRlockGuard_deinit)
+
 typedef pthread_cond_t celix_thread_cond_t;
 typedef pthread_condattr_t celix_thread_condattr_t;
 
@@ -143,6 +143,9 @@ static celix_status_t celix_arrayList_ensureCapacity(celix_array_list_t* list, s
     size_t oldCapacity = list->capacity;
     if (capacity > oldCapacity) {
         size_t newCapacity = (oldCapacity * 3) / 2 + 1;
+        if (newCapacity < capacity) {
+            newCapacity = capacity;
+        }
         newList = realloc(list->elementData, sizeof(celix_array_list_entry_t) * newCapacity);
         if (!newList) {
             celix_err_push("Failed to reallocate memory for elementData");
@@ -451,6 +454,40 @@ void celix_arrayList_removeAt(celix_array_list_t *list, int index) {
     }
 }
 
+void celix_arrayList_swapRemoveAt(celix_array_list_t* list, int index) {
+    if (index >= 0 && index < list->size) {
+        celix_arrayList_callRemovedCallback(list, index);
+        list->elementData[index] = list->elementData[list->size - 1];
+        memset(&list->elementData[--list->size], 0, sizeof(celix_array_list_entry_t));
+    }
+}
+
+static int celix_arrayList_removeMatching(celix_array_list_t* list,
+                                          celix_array_list_entry_predicate_fp predicate,
+                                          void* data,
+                                          bool removeIfMatches) {
+    size_t retained = 0;
+    for (size_t i = 0; i < list->size; ++i) {
+        if (predicate(data, list->elementData[i]) == removeIfMatches) {
+            celix_arrayList_callRemovedCallback(list, (int)i);
+        } else {
+            list->elementData[retained++] = list->elementData[i];
+        }
+    }
+    size_t removed = list->size - retained;
+    memset(&list->elementData[retained], 0, sizeof(celix_array_list_entry_t) * removed);
+    list->size = retained;
+    return (int)removed;
+}
+
+int celix_arrayList_removeIf(celix_array_list_t* list, celix_array_list_entry_predicate_fp predicate, void* data) {
+    return celix_arrayList_removeMatching(list, predicate, data, true);
+}
+
+int celix_arrayList_retainIf(celix_array_list_t* list, celix_array_list_entry_predicate_fp predicate, void* data) {
+    return celix_arrayList_removeMatching(list, predicate, data, false);
+}
+
 void celix_arrayList_removeEntry(celix_array_list_t *list, celix_array_list_entry_t entry) {
     int index = celix_arrayList_indexOf(list, entry);
     celix_arrayList_removeAt(list, index);
@@ -535,6 +572,96 @@ void celix_arrayList_sort(celix_array_list_t *list) {
     }
 }
 
+/**
+ * @brief Returns the index of the first entry which is not smaller than the provided entry (lower bound) or,
+ * if upper is true, the index of the first entry which is larger than the provided entry (upper bound).
+ */
+static size_t celix_arrayList_bound(const celix_array_list_t* list, celix_array_list_entry_t entry, bool upper) {
+    size_t low = 0;
+    size_t high = list->size;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int cmp = list->compareCallback(list->elementData[mid], entry);
+        if (cmp < 0 || (upper && cmp == 0)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+int celix_arrayList_binarySearch(const celix_array_list_t* list, celix_array_list_entry_t entry) {
+    if (!list->compareCallback) {
+        return celix_arrayList_indexOf((celix_array_list_t*)list, entry);
+    }
+    size_t index = celix_arrayList_bound(list, entry, false);
+    if (index < list->size && list->compareCallback(list->elementData[index], entry) == 0) {
+        return (int)index;
+    }
+    return -1;
+}
+
+celix_status_t celix_arrayList_addEntrySorted(celix_array_list_t* list, celix_array_list_entry_t entry) {
+    if (!list->compareCallback) {
+        return celix_arrayList_addEntry(list, entry);
+    }
+    celix_status_t status = celix_arrayList_ensureCapacity(list, list->size + 1);
+    if (status != CELIX_SUCCESS) {
+        if (list->simpleRemovedCallback) {
+            list->simpleRemovedCallback(entry.voidPtrVal);
+        } else if (list->removedCallback) {
+            list->removedCallback(list->removedCallbackData, entry);
+        }
+        return status;
+    }
+    size_t index = celix_arrayList_bound(list, entry, true);
+    memmove(list->elementData + index + 1,
+            list->elementData + index,
+            sizeof(celix_array_list_entry_t) * (list->size - index));
+    list->elementData[index] = entry;
+    list->size += 1;
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_arrayList_addAll(celix_array_list_t* list, const celix_array_list_t* other) {
+    if (list->elementType != other->elementType) {
+        celix_err_pushf("Cannot add all entries of a %s array list to a %s array list",
+                        celix_arrayList_elementTypeToString(other->elementType),
+                        celix_arrayList_elementTypeToString(list->elementType));
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    size_t otherSize = other->size; //note list and other can be the same array list
+    celix_status_t status = celix_arrayList_ensureCapacity(list, list->size + otherSize);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+
+    size_t originalSize = list->size;
+    for (size_t i = 0; i < otherSize; ++i) {
+        celix_array_list_entry_t entry = other->elementData[i];
+        if (list->copyCallback) {
+            memset(&entry, 0, sizeof(entry));
+            status = list->copyCallback(other->elementData[i], &entry);
+            if (status != CELIX_SUCCESS) {
+                celix_err_push("Failed to copy entry");
+                break;
+            }
+        }
+        list->elementData[list->size++] = entry;
+    }
+
+    if (status != CELIX_SUCCESS) {
+        //revert, so that the array list is unchanged
+        while (list->size > originalSize) {
+            celix_arrayList_callRemovedCallback(list, (int)list->size - 1);
+            memset(&list->elementData[--list->size], 0, sizeof(celix_array_list_entry_t));
+        }
+    }
+    return status;
+}
+
 bool celix_arrayList_equals(const celix_array_list_t* listA, const celix_array_list_t* listB) {
     if (listA == listB) {
         return true;
@@ -23,12 +23,21 @@
 #include <string.h>
 #include <stdio.h>
 #include <dirent.h>
+#include <fcntl.h>
 #include <fts.h>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <zip.h>
 #include <sys/time.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
 
+#include "celix_err.h"
+#include "celix_properties.h"
+#include "celix_stdlib_cleanup.h"
 #include "celix_utils.h"
 
 static const char * const DIRECTORY_ALREADY_EXISTS_ERROR = "Directory already exists.";
@@ -38,6 +47,12 @@ static const char * const ERROR_OPENING_ZIP = "Error opening zip file.";
 static const char * const ERROR_QUERYING_FILE_ZIP = "Error querying file in zip.";
 static const char * const ERROR_OPENING_FILE_ZIP = "Error opening file in zip.";
 static const char * const ERROR_READING_FILE_ZIP = "Error reading file in zip.";
+static const char * const ERROR_WRITING_ZIP_INDEX = "Error writing zip extraction index.";
+
+/**
+ * Maximum length of a content store key: <16 hex FNV-1a hash>-<8 hex CRC-32>-<decimal size>.
+ */
+#define CELIX_UTILS_CONTENT_KEY_SIZE 64
 
 bool celix_utils_fileExists(const char* path) {
     struct stat st;
@@ -333,6 +348,411 @@ celix_status_t celix_utils_extractZipData(const void *zipData, size_t zipDataSiz
     return status;
 }
 
+static bool celix_utils_writeAll(int fd, const char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t written = write(fd, buf, len);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        buf += written;
+        len -= (size_t)written;
+    }
+    return true;
+}
+
+/**
+ * @brief Decompress zip entry `index` to fd, while calculating the 64-bit FNV-1a hash of the data.
+ */
+static celix_status_t celix_utils_writeZipEntry(zip_t* zip, zip_int64_t index, int fd, uint64_t* hashOut, uint64_t* sizeOut, const char** errorOut) {
+    zip_file_t *zf = zip_fopen_index(zip, index, 0);
+    if (!zf) {
+        *errorOut = ERROR_OPENING_FILE_ZIP;
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_ZIP, zip_error_code_zip(zip_get_error(zip)));
+    }
+
+    celix_status_t status = CELIX_SUCCESS;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    uint64_t size = 0;
+    char buf[5120];
+    zip_int64_t read = zip_fread(zf, buf, sizeof(buf));
+    while (read > 0) {
+        for (zip_int64_t i = 0; i < read; ++i) {
+            hash ^= (unsigned char)buf[i];
+            hash *= 0x100000001b3ULL;
+        }
+        if (!celix_utils_writeAll(fd, buf, (size_t)read)) {
+            status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
+            *errorOut = strerror(errno);
+            break;
+        }
+        size += (uint64_t)read;
+        read = zip_fread(zf, buf, sizeof(buf));
+    }
+    if (status == CELIX_SUCCESS && read < 0) {
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_ZIP, zip_error_code_zip(zip_file_get_error(zf)));
+        *errorOut = ERROR_READING_FILE_ZIP;
+    }
+    zip_fclose(zf);
+    *hashOut = hash;
+    *sizeOut = size;
+    return status;
+}
+
+/**
+ * @brief Copy a file, using a reflink if the filesystem supports it.
+ */
+static celix_status_t celix_utils_copyFile(const char* from, const char* to) {
+    celix_status_t status = CELIX_SUCCESS;
+    int in = open(from, O_RDONLY);
+    if (in == -1) {
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
+    }
+    int out = open(to, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IRGRP | S_IROTH);
+    if (out == -1) {
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
+        close(in);
+        return status;
+    }
+#ifdef FICLONE
+    if (ioctl(out, FICLONE, in) == 0) {
+        close(out);
+        close(in);
+        return CELIX_SUCCESS;
+    }
+#endif
+    char buf[5120];
+    ssize_t len;
+    while ((len = read(in, buf, sizeof(buf))) > 0) {
+        if (!celix_utils_writeAll(out, buf, (size_t)len)) {
+            status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
+            break;
+        }
+    }
+    if (len < 0) {
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
+    }
+    if (close(out) != 0 && status == CELIX_SUCCESS) {
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
+    }
+    close(in);
+    return status;
+}
+
+/**
+ * @brief Returns whether the zip entry name is a shared object (e.g. `libfoo.so`, `libfoo.so.1` or `libfoo.dylib`).
+ */
+static bool celix_utils_isSharedObject(const char* name) {
+    const char* base = strrchr(name, '/');
+    base = base == NULL ? name : base + 1;
+    for (const char* ext = strstr(base, ".so"); ext != NULL; ext = strstr(ext + 1, ".so")) {
+        if (ext[3] == '\0' || ext[3] == '.') {
+            return true;
+        }
+    }
+    size_t len = strlen(base);
+    return len >= 6 && strcmp(base + len - 6, ".dylib") == 0;
+}
+
+/**
+ * @brief Make the extracted temp file available at targetPath.
+ *
+ * If blobPath is not NULL, the temp file is first added to the content store - unless an identical file is already
+ * present - and the content store file is hardlinked to targetPath. If blobPath is NULL or hardlinks are not possible
+ * (e.g. different filesystems), the temp file is moved or copied to targetPath instead.
+ */
+static celix_status_t celix_utils_installContentFile(const char* tmpPath, const char* blobPath, const char* targetPath) {
+    if (unlink(targetPath) != 0 && errno != ENOENT) {
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
+    }
+    bool stored = blobPath != NULL && (link(tmpPath, blobPath) == 0 || errno == EEXIST);
+    if (stored && link(blobPath, targetPath) == 0) {
+        return CELIX_SUCCESS;
+    }
+    if (rename(tmpPath, targetPath) == 0) {
+        return CELIX_SUCCESS;
+    }
+    return celix_utils_copyFile(tmpPath, targetPath);
+}
+
+static char* celix_utils_contentStorePath(const char* contentStoreDir, const char* key) {
+    char* path = NULL;
+    if (asprintf(&path, "%s/%.2s/%s", contentStoreDir, key, key) < 0) {
+        return NULL;
+    }
+    return path;
+}
+
+/**
+ * @brief Remove the content store file for key if it is no longer linked from an extraction dir.
+ */
+static void celix_utils_releaseContentFile(const char* contentStoreDir, const char* key) {
+    celix_autofree char* path = celix_utils_contentStorePath(contentStoreDir, key);
+    struct stat st;
+    if (path != NULL && lstat(path, &st) == 0 && S_ISREG(st.st_mode) && st.st_nlink == 1) {
+        (void)unlink(path);
+    }
+}
+
+/**
+ * @brief Returns whether the zip entry still matches the file extracted earlier with the provided content key.
+ *
+ * Only the zip central directory (CRC-32 and size) and the extracted file size are checked, so unchanged entries are
+ * not decompressed.
+ */
+static bool celix_utils_isZipEntryUnchanged(const zip_stat_t* st, const char* key, const char* path) {
+    if (key == NULL || (st->valid & (ZIP_STAT_CRC | ZIP_STAT_SIZE)) != (ZIP_STAT_CRC | ZIP_STAT_SIZE)) {
+        return false;
+    }
+    char suffix[CELIX_UTILS_CONTENT_KEY_SIZE];
+    int suffixLen = snprintf(suffix, sizeof(suffix), "-%08" PRIx32 "-%" PRIu64, (uint32_t)st->crc, (uint64_t)st->size);
+    size_t keyLen = strlen(key);
+    if (keyLen < (size_t)suffixLen || strcmp(key + keyLen - suffixLen, suffix) != 0) {
+        return false;
+    }
+    struct stat fileSt;
+    return lstat(path, &fileSt) == 0 && S_ISREG(fileSt.st_mode) && (uint64_t)fileSt.st_size == st->size;
+}
+
+/**
+ * @brief Extract zip entry `index` to targetPath through the content store and return the content key of the entry.
+ */
+static celix_status_t celix_utils_extractZipEntryToContentStore(zip_t* zip,
+                                                                zip_int64_t index,
+                                                                const zip_stat_t* st,
+                                                                const char* targetPath,
+                                                                const char* contentStoreDir,
+                                                                char* keyOut,
+                                                                const char** errorOut) {
+    celix_autofree char* tmpPath = NULL;
+    if (asprintf(&tmpPath, "%s/.tmp-XXXXXX", contentStoreDir) < 0) {
+        *errorOut = strerror(ENOMEM);
+        return CELIX_ENOMEM;
+    }
+    int fd = mkstemp(tmpPath);
+    if (fd == -1) {
+        int err = errno;
+        *errorOut = strerror(err);
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,err);
+    }
+
+    uint64_t hash = 0;
+    uint64_t size = 0;
+    celix_status_t status = celix_utils_writeZipEntry(zip, index, fd, &hash, &size, errorOut);
+    //content store files are shared between extraction dirs, so they are made read-only
+    if (status == CELIX_SUCCESS && fchmod(fd, S_IRUSR | S_IRGRP | S_IROTH) != 0) {
+        int err = errno;
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,err);
+        *errorOut = strerror(err);
+    }
+    if (close(fd) != 0 && status == CELIX_SUCCESS) {
+        int err = errno;
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,err);
+        *errorOut = strerror(err);
+    }
+
+    //Shared objects are not shared through the content store: the dynamic loader identifies a loaded library by its
+    //device and inode, so bundles with a hardlinked identical library would share the library and its static state.
+    bool shareable = !celix_utils_isSharedObject(st->name);
+    celix_autofree char* blobPath = NULL;
+    if (status == CELIX_SUCCESS) {
+        uint32_t crc = (st->valid & ZIP_STAT_CRC) ? (uint32_t)st->crc : 0;
+        snprintf(keyOut, CELIX_UTILS_CONTENT_KEY_SIZE, "%016" PRIx64 "-%08" PRIx32 "-%" PRIu64, hash, crc, size);
+        blobPath = shareable ? celix_utils_contentStorePath(contentStoreDir, keyOut) : NULL;
+        if (shareable && blobPath == NULL) {
+            status = CELIX_ENOMEM;
+            *errorOut = strerror(ENOMEM);
+        }
+    }
+    if (status == CELIX_SUCCESS && shareable) {
+        //create the fan-out dir (first 2 characters of the key) of the content store file
+        char* sep = strrchr(blobPath, '/');
+        *sep = '\0';
+        status = celix_utils_createDirectory(blobPath, false, errorOut);
+        *sep = '/';
+    }
+    if (status == CELIX_SUCCESS) {
+        status = celix_utils_installContentFile(tmpPath, blobPath, targetPath);
+        if (status != CELIX_SUCCESS) {
+            *errorOut = celix_strerror(status);
+        }
+    }
+    (void)unlink(tmpPath);
+    return status;
+}
+
+static celix_status_t celix_utils_extractZipIncrementallyInternal(zip_t* zip,
+                                                                  const char* extractToDir,
+                                                                  const char* contentStoreDir,
+                                                                  const char* indexPath,
+                                                                  const char** errorOut) {
+    celix_status_t status = celix_utils_createDirectory(extractToDir, false, errorOut);
+    if (status == CELIX_SUCCESS) {
+        status = celix_utils_createDirectory(contentStoreDir, false, errorOut);
+    }
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+
+    celix_autoptr(celix_properties_t) oldIndex = NULL;
+    if (celix_utils_fileExists(indexPath)) {
+        oldIndex = celix_properties_load(indexPath);
+        if (oldIndex == NULL) {
+            //a corrupt index only means that all entries are extracted again
+            celix_err_resetErrors();
+        }
+    }
+    celix_autoptr(celix_properties_t) newIndex = celix_properties_create();
+    if (newIndex == NULL) {
+        *errorOut = strerror(ENOMEM);
+        return CELIX_ENOMEM;
+    }
+
+    zip_int64_t nrOfEntries = zip_get_num_entries(zip, 0);
+    for (zip_int64_t i = 0; status == CELIX_SUCCESS && i < nrOfEntries; ++i) {
+        zip_stat_t st;
+        if (zip_stat_index(zip, i, 0, &st) == -1) {
+            status = CELIX_ERROR_MAKE(CELIX_FACILITY_ZIP, zip_error_code_zip(zip_get_error(zip)));
+            *errorOut = ERROR_QUERYING_FILE_ZIP;
+            continue;
+        }
+        celix_autofree char* path = NULL;
+        if (asprintf(&path, "%s/%s", extractToDir, st.name) < 0) {
+            status = CELIX_ENOMEM;
+            *errorOut = strerror(ENOMEM);
+            continue;
+        }
+        if (st.name[strlen(st.name) - 1] == '/') {
+            status = celix_utils_createDirectory(path, false, errorOut);
+            continue;
+        }
+
+        const char* oldKey = oldIndex ? celix_properties_get(oldIndex, st.name, NULL) : NULL;
+        if (celix_utils_isZipEntryUnchanged(&st, oldKey, path)) {
+            status = celix_properties_set(newIndex, st.name, oldKey);
+        } else {
+            char key[CELIX_UTILS_CONTENT_KEY_SIZE];
+            status = celix_utils_extractZipEntryToContentStore(zip, i, &st, path, contentStoreDir, key, errorOut);
+            if (status == CELIX_SUCCESS && oldKey != NULL && strcmp(oldKey, key) != 0) {
+                celix_utils_releaseContentFile(contentStoreDir, oldKey);
+            }
+            if (status == CELIX_SUCCESS) {
+                status = celix_properties_set(newIndex, st.name, key);
+            }
+        }
+        if (status == CELIX_ENOMEM) {
+            *errorOut = strerror(ENOMEM);
+        }
+    }
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+
+    //remove files which are no longer part of the zip
+    if (oldIndex != NULL) {
+        CELIX_PROPERTIES_ITERATE(oldIndex, iter) {
+            if (celix_properties_hasKey(newIndex, iter.key)) {
+                continue;
+            }
+            celix_autofree char* path = NULL;
+            if (asprintf(&path, "%s/%s", extractToDir, iter.key) >= 0) {
+                (void)unlink(path);
+            }
+            celix_utils_releaseContentFile(contentStoreDir, iter.entry.value);
+        }
+    }
+
+    status = celix_properties_store(newIndex, indexPath, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_err_resetErrors();
+        *errorOut = ERROR_WRITING_ZIP_INDEX;
+        return status;
+    }
+    //mark the extraction dir as updated, also if only the content of existing files changed
+    return celix_utils_touch(extractToDir);
+}
+
+celix_status_t celix_utils_extractZipFileIncrementally(const char* zipPath,
+                                                       const char* extractToDir,
+                                                       const char* contentStoreDir,
+                                                       const char* indexPath,
+                                                       const char** errorOut) {
+    const char *dummyErrorOut = NULL;
+    if (errorOut) {
+        //reset errorOut
+        *errorOut = NULL;
+    } else {
+        errorOut = &dummyErrorOut;
+    }
+
+    celix_status_t status = CELIX_SUCCESS;
+    int error;
+    zip_t* zip = zip_open(zipPath, ZIP_RDONLY, &error);
+
+    if (zip) {
+        status = celix_utils_extractZipIncrementallyInternal(zip, extractToDir, contentStoreDir, indexPath, errorOut);
+        zip_close(zip);
+    } else {
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_ZIP, error);
+        *errorOut = ERROR_OPENING_ZIP;
+    }
+
+    return status;
+}
+
+celix_status_t celix_utils_pruneContentStore(const char* contentStoreDir, const char** errorOut) {
+    const char *dummyErrorOut = NULL;
+    if (errorOut) {
+        //reset errorOut
+        *errorOut = NULL;
+    } else {
+        errorOut = &dummyErrorOut;
+    }
+
+    if (!celix_utils_directoryExists(contentStoreDir)) {
+        return CELIX_SUCCESS;
+    }
+
+    celix_status_t status = CELIX_SUCCESS;
+    char *paths[] = { (char*)contentStoreDir, NULL };
+    errno = 0;
+    FTS *fts = fts_open(paths, FTS_PHYSICAL | FTS_XDEV | FTS_NOCHDIR, NULL);
+    if (fts == NULL) {
+        goto out;
+    }
+    FTSENT *ent = NULL;
+    while ((ent = fts_read(fts)) != NULL) {
+        switch (ent->fts_info) {
+            case FTS_F:
+                //a content store file which is only linked from the content store itself is no longer used
+                if (ent->fts_statp->st_nlink == 1 && unlink(ent->fts_accpath) != 0) {
+                    if (errno != ENOENT) {
+                        goto out;
+                    }
+                    errno = 0;
+                }
+                break;
+            case FTS_DNR:
+            case FTS_ERR:
+                errno = ent->fts_errno;
+                goto out;
+            default:
+                break;
+        }
+    }
+out:
+    if (errno != 0) {
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
+        *errorOut = strerror(errno);
+    }
+    if (fts != NULL) {
+        fts_close(fts); // it may change errno
+    }
+    return status;
+}
+
 celix_status_t celix_utils_getLastModified(const char* path, struct timespec* lastModified) {
     celix_status_t status = CELIX_SUCCESS;
     struct stat st;
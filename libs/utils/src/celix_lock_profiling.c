@@ -0,0 +1,578 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_lock_profiling.h"
+#include "celix_lock_profiling_private.h"
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "celix_compiler.h"
+#include "celix_err.h"
+#include "celix_long_hash_map.h"
+#include "celix_stdlib_cleanup.h"
+
+#if CELIX_THREADS_LOCK_PROFILING
+
+/**
+ * The number of locks a single thread can profile, must be a power of 2.
+ */
+#define CELIX_LOCK_PROFILING_TABLE_SIZE 256
+
+/**
+ * The max number of nested locks a single thread can track the hold time for.
+ */
+#define CELIX_LOCK_PROFILING_MAX_HELD_LOCKS 32
+
+/**
+ * Slot lock markers for destroyed locks. A slot is CLEARING while the destroying thread clears its counters and
+ * DESTROYED (a tombstone) when it can be reused for another lock.
+ */
+#define CELIX_LOCK_PROFILING_SLOT_CLEARING ((const void*)1)
+#define CELIX_LOCK_PROFILING_SLOT_DESTROYED ((const void*)2)
+
+/**
+ * @brief The statistics of a single lock for a single thread.
+ *
+ * Only written by the owning thread, read by the thread merging the statistics. All fields are accessed atomically
+ * (relaxed), so that no additional synchronization is needed.
+ */
+typedef struct celix_lock_profile_slot {
+    const void* lock;
+    uint64_t acquisitions;
+    uint64_t contentions;
+    uint64_t totalWaitNs;
+    uint64_t maxWaitNs;
+    uint64_t totalHoldNs;
+    uint64_t maxHoldNs;
+    uint64_t waitHistogram[CELIX_LOCK_PROFILING_HISTOGRAM_SIZE];
+} celix_lock_profile_slot_t;
+
+typedef struct celix_lock_profile_held_lock {
+    const void* lock;
+    uint64_t since;
+} celix_lock_profile_held_lock_t;
+
+/**
+ * @brief The per-thread lock profiling data.
+ *
+ * Thread data entries are never freed (only recycled when a thread exits), so that the statistics of exited threads
+ * are kept and the list of thread data can be traversed without locking.
+ */
+typedef struct celix_lock_profile_thread_data {
+    struct celix_lock_profile_thread_data* next; //immutable after being added to the list
+    bool inUse;
+    unsigned int generation; //the reset generation of the slots
+    uint64_t droppedAcquisitions; //acquisitions not profiled, because the slots table was full
+    size_t heldCount;
+    celix_lock_profile_held_lock_t held[CELIX_LOCK_PROFILING_MAX_HELD_LOCKS];
+    celix_lock_profile_slot_t slots[CELIX_LOCK_PROFILING_TABLE_SIZE];
+} celix_lock_profile_thread_data_t;
+
+static bool celix_lockProfiling_enabled = false;
+static unsigned int celix_lockProfiling_generation = 0;
+static celix_lock_profile_thread_data_t* celix_lockProfiling_threads = NULL;
+
+static pthread_key_t celix_lockProfiling_tssKey;
+static bool celix_lockProfiling_tssKeyInitialized = false;
+
+//note plain pthread mutex, the celix_threads wrappers are profiled themselves
+static pthread_mutex_t celix_lockProfiling_namesMutex = PTHREAD_MUTEX_INITIALIZER;
+static celix_long_hash_map_t* celix_lockProfiling_names = NULL; //guarded by celix_lockProfiling_namesMutex
+
+static void celix_lockProfiling_recycleThreadData(void* data) {
+    celix_lock_profile_thread_data_t* td = data;
+    td->heldCount = 0;
+    __atomic_store_n(&td->inUse, false, __ATOMIC_RELEASE);
+}
+
+__attribute__((constructor)) static void celix_lockProfiling_initThreadSpecificStorageKey(void) {
+    celix_lockProfiling_tssKeyInitialized =
+        pthread_key_create(&celix_lockProfiling_tssKey, celix_lockProfiling_recycleThreadData) == 0;
+}
+
+__attribute__((destructor)) static void celix_lockProfiling_deinit(void) {
+    pthread_mutex_lock(&celix_lockProfiling_namesMutex);
+    celix_longHashMap_destroy(celix_lockProfiling_names);
+    celix_lockProfiling_names = NULL;
+    pthread_mutex_unlock(&celix_lockProfiling_namesMutex);
+}
+
+static celix_lock_profile_thread_data_t* celix_lockProfiling_getThreadData(bool create) {
+    if (!celix_lockProfiling_tssKeyInitialized) {
+        return NULL;
+    }
+    celix_lock_profile_thread_data_t* td = pthread_getspecific(celix_lockProfiling_tssKey);
+    if (td != NULL || !create) {
+        return td;
+    }
+
+    //try to recycle the data of an exited thread
+    celix_lock_profile_thread_data_t* it = __atomic_load_n(&celix_lockProfiling_threads, __ATOMIC_ACQUIRE);
+    for (; it != NULL && td == NULL; it = it->next) {
+        bool expected = false;
+        if (__atomic_compare_exchange_n(&it->inUse, &expected, true, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            td = it;
+        }
+    }
+    if (td == NULL) {
+        td = calloc(1, sizeof(*td));
+        if (td == NULL) {
+            return NULL;
+        }
+        td->inUse = true;
+        td->generation = __atomic_load_n(&celix_lockProfiling_generation, __ATOMIC_ACQUIRE);
+        td->next = __atomic_load_n(&celix_lockProfiling_threads, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(
+            &celix_lockProfiling_threads, &td->next, td, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            //retry, td->next is updated with the current head
+        }
+    }
+    if (pthread_setspecific(celix_lockProfiling_tssKey, td) != 0) {
+        celix_lockProfiling_recycleThreadData(td);
+        return NULL;
+    }
+    return td;
+}
+
+/**
+ * @brief Clears a slot. The slot can concurrently be read by a merging thread, so every field is cleared with an
+ * atomic store instead of a memset.
+ */
+static void celix_lockProfiling_clearSlotCounters(celix_lock_profile_slot_t* slot) {
+    __atomic_store_n(&slot->acquisitions, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->contentions, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->totalWaitNs, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->maxWaitNs, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->totalHoldNs, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->maxHoldNs, 0, __ATOMIC_RELAXED);
+    for (size_t i = 0; i < CELIX_LOCK_PROFILING_HISTOGRAM_SIZE; ++i) {
+        __atomic_store_n(&slot->waitHistogram[i], 0, __ATOMIC_RELAXED);
+    }
+}
+
+static void celix_lockProfiling_clearSlot(celix_lock_profile_slot_t* slot) {
+    __atomic_store_n(&slot->lock, NULL, __ATOMIC_RELAXED);
+    celix_lockProfiling_clearSlotCounters(slot);
+}
+
+static void celix_lockProfiling_syncGeneration(celix_lock_profile_thread_data_t* td) {
+    unsigned int generation = __atomic_load_n(&celix_lockProfiling_generation, __ATOMIC_ACQUIRE);
+    if (td->generation != generation) {
+        for (size_t i = 0; i < CELIX_LOCK_PROFILING_TABLE_SIZE; ++i) {
+            celix_lockProfiling_clearSlot(&td->slots[i]);
+        }
+        __atomic_store_n(&td->droppedAcquisitions, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&td->generation, generation, __ATOMIC_RELEASE);
+    }
+}
+
+static bool celix_lockProfiling_isLockMarker(const void* lock) {
+    return lock == CELIX_LOCK_PROFILING_SLOT_CLEARING || lock == CELIX_LOCK_PROFILING_SLOT_DESTROYED;
+}
+
+static size_t celix_lockProfiling_slotIndex(const void* lock) {
+    return (size_t)(((uintptr_t)lock >> 3) * 2654435761u);
+}
+
+static celix_lock_profile_slot_t* celix_lockProfiling_findSlot(celix_lock_profile_thread_data_t* td, const void* lock) {
+    size_t idx = celix_lockProfiling_slotIndex(lock);
+    celix_lock_profile_slot_t* reusable = NULL;
+    for (size_t i = 0; i < CELIX_LOCK_PROFILING_TABLE_SIZE; ++i) {
+        celix_lock_profile_slot_t* slot = &td->slots[(idx + i) & (CELIX_LOCK_PROFILING_TABLE_SIZE - 1)];
+        const void* slotLock = __atomic_load_n(&slot->lock, __ATOMIC_ACQUIRE);
+        if (slotLock == lock) {
+            return slot;
+        } else if (slotLock == CELIX_LOCK_PROFILING_SLOT_DESTROYED && reusable == NULL) {
+            reusable = slot;
+        } else if (slotLock == NULL) {
+            reusable = reusable == NULL ? slot : reusable;
+            break;
+        }
+    }
+    if (reusable != NULL) {
+        //note a destroyed slot is already cleared by the destroying thread
+        __atomic_store_n(&reusable->lock, lock, __ATOMIC_RELEASE);
+    }
+    return reusable;
+}
+
+/**
+ * @brief Clears and frees the slot of a destroyed lock in the table of a thread, so that the slot can be reused and a
+ * new lock with the same address does not inherit the statistics of the destroyed lock.
+ *
+ * Called by the destroying thread, concurrently with the owning thread. The owning thread cannot use the destroyed lock
+ * anymore, so it will not update the slot; it only skips the slot while it is being cleared.
+ */
+static void celix_lockProfiling_freeSlot(celix_lock_profile_thread_data_t* td, const void* lock) {
+    size_t idx = celix_lockProfiling_slotIndex(lock);
+    for (size_t i = 0; i < CELIX_LOCK_PROFILING_TABLE_SIZE; ++i) {
+        celix_lock_profile_slot_t* slot = &td->slots[(idx + i) & (CELIX_LOCK_PROFILING_TABLE_SIZE - 1)];
+        const void* expected = lock;
+        if (__atomic_compare_exchange_n(
+                &slot->lock, &expected, CELIX_LOCK_PROFILING_SLOT_CLEARING, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            celix_lockProfiling_clearSlotCounters(slot);
+            const void* clearing = CELIX_LOCK_PROFILING_SLOT_CLEARING;
+            //note only mark as destroyed if the owning thread did not reset (and reuse) the slot in the meantime
+            __atomic_compare_exchange_n(
+                &slot->lock, &clearing, CELIX_LOCK_PROFILING_SLOT_DESTROYED, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+            return;
+        } else if (expected == NULL) {
+            return; //not profiled by this thread
+        }
+    }
+}
+
+static void celix_lockProfiling_add(uint64_t* counter, uint64_t value) {
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+static void celix_lockProfiling_max(uint64_t* counter, uint64_t value) {
+    if (value > __atomic_load_n(counter, __ATOMIC_RELAXED)) {
+        __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+    }
+}
+
+static size_t celix_lockProfiling_histogramBucket(uint64_t waitNs) {
+    if (waitNs < 1024) {
+        return 0;
+    }
+    size_t bucket = (size_t)(63 - __builtin_clzll(waitNs)) - 9;
+    return bucket < CELIX_LOCK_PROFILING_HISTOGRAM_SIZE ? bucket : CELIX_LOCK_PROFILING_HISTOGRAM_SIZE - 1;
+}
+
+static void celix_lockProfiling_pushHeld(celix_lock_profile_thread_data_t* td, const void* lock) {
+    if (td->heldCount < CELIX_LOCK_PROFILING_MAX_HELD_LOCKS) {
+        td->held[td->heldCount].lock = lock;
+        td->held[td->heldCount].since = celix_lockProfiling_now();
+        td->heldCount += 1;
+    }
+}
+
+uint64_t celix_lockProfiling_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void celix_lockProfiling_acquired(const void* lock, bool contended, uint64_t waitNs) {
+    celix_lock_profile_thread_data_t* td = celix_lockProfiling_getThreadData(true);
+    if (td == NULL) {
+        return;
+    }
+    celix_lockProfiling_syncGeneration(td);
+    celix_lock_profile_slot_t* slot = celix_lockProfiling_findSlot(td, lock);
+    if (slot == NULL) {
+        celix_lockProfiling_add(&td->droppedAcquisitions, 1);
+    } else {
+        celix_lockProfiling_add(&slot->acquisitions, 1);
+        if (contended) {
+            celix_lockProfiling_add(&slot->contentions, 1);
+            celix_lockProfiling_add(&slot->totalWaitNs, waitNs);
+            celix_lockProfiling_max(&slot->maxWaitNs, waitNs);
+            celix_lockProfiling_add(&slot->waitHistogram[celix_lockProfiling_histogramBucket(waitNs)], 1);
+        }
+    }
+    celix_lockProfiling_pushHeld(td, lock);
+}
+
+void celix_lockProfiling_reacquired(const void* lock) {
+    if (!celix_lockProfiling_isEnabled()) {
+        return;
+    }
+    celix_lock_profile_thread_data_t* td = celix_lockProfiling_getThreadData(true);
+    if (td != NULL) {
+        celix_lockProfiling_pushHeld(td, lock);
+    }
+}
+
+void celix_lockProfiling_released(const void* lock) {
+    celix_lock_profile_thread_data_t* td = celix_lockProfiling_getThreadData(false);
+    if (td == NULL || td->heldCount == 0) {
+        return;
+    }
+    for (size_t i = td->heldCount; i > 0; --i) {
+        if (td->held[i - 1].lock != lock) {
+            continue;
+        }
+        uint64_t since = td->held[i - 1].since;
+        memmove(&td->held[i - 1], &td->held[i], (td->heldCount - i) * sizeof(td->held[0]));
+        td->heldCount -= 1;
+        if (celix_lockProfiling_isEnabled()) {
+            uint64_t holdNs = celix_lockProfiling_now() - since;
+            celix_lockProfiling_syncGeneration(td);
+            celix_lock_profile_slot_t* slot = celix_lockProfiling_findSlot(td, lock);
+            if (slot != NULL) {
+                celix_lockProfiling_add(&slot->totalHoldNs, holdNs);
+                celix_lockProfiling_max(&slot->maxHoldNs, holdNs);
+            }
+        }
+        break;
+    }
+}
+
+void celix_lockProfiling_destroyed(const void* lock) {
+    celix_lock_profile_thread_data_t* td = __atomic_load_n(&celix_lockProfiling_threads, __ATOMIC_ACQUIRE);
+    for (; td != NULL; td = td->next) {
+        celix_lockProfiling_freeSlot(td, lock);
+    }
+
+    pthread_mutex_lock(&celix_lockProfiling_namesMutex);
+    if (celix_lockProfiling_names != NULL) {
+        celix_longHashMap_remove(celix_lockProfiling_names, (long)(uintptr_t)lock);
+    }
+    pthread_mutex_unlock(&celix_lockProfiling_namesMutex);
+}
+
+bool celix_lockProfiling_isSupported(void) {
+    return true;
+}
+
+celix_status_t celix_lockProfiling_setEnabled(bool enabled) {
+    __atomic_store_n(&celix_lockProfiling_enabled, enabled, __ATOMIC_RELEASE);
+    return CELIX_SUCCESS;
+}
+
+bool celix_lockProfiling_isEnabled(void) {
+    return __atomic_load_n(&celix_lockProfiling_enabled, __ATOMIC_ACQUIRE);
+}
+
+void celix_lockProfiling_setName(const void* lock, const char* format, ...) {
+    char name[CELIX_LOCK_PROFILING_MAX_NAME_LENGTH];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(name, sizeof(name), format, args);
+    va_end(args);
+
+    celix_autofree char* value = strdup(name);
+    if (value == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&celix_lockProfiling_namesMutex);
+    if (celix_lockProfiling_names == NULL) {
+        celix_long_hash_map_create_options_t opts = CELIX_EMPTY_LONG_HASH_MAP_CREATE_OPTIONS;
+        opts.simpleRemovedCallback = free;
+        celix_lockProfiling_names = celix_longHashMap_createWithOptions(&opts);
+    }
+    if (celix_lockProfiling_names != NULL &&
+        celix_longHashMap_put(celix_lockProfiling_names, (long)(uintptr_t)lock, value) == CELIX_SUCCESS) {
+        celix_steal_ptr(value);
+    }
+    pthread_mutex_unlock(&celix_lockProfiling_namesMutex);
+}
+
+void celix_lockProfiling_reset(void) {
+    //note the per-thread data is lazily cleared by the owning thread, merging ignores data of older generations.
+    __atomic_add_fetch(&celix_lockProfiling_generation, 1, __ATOMIC_ACQ_REL);
+}
+
+static void celix_lockProfiling_mergeSlot(celix_lock_profile_stats_t* stats, const celix_lock_profile_slot_t* slot) {
+    stats->acquisitions += __atomic_load_n(&slot->acquisitions, __ATOMIC_RELAXED);
+    stats->contentions += __atomic_load_n(&slot->contentions, __ATOMIC_RELAXED);
+    stats->totalWaitNs += __atomic_load_n(&slot->totalWaitNs, __ATOMIC_RELAXED);
+    stats->totalHoldNs += __atomic_load_n(&slot->totalHoldNs, __ATOMIC_RELAXED);
+    uint64_t maxWaitNs = __atomic_load_n(&slot->maxWaitNs, __ATOMIC_RELAXED);
+    stats->maxWaitNs = maxWaitNs > stats->maxWaitNs ? maxWaitNs : stats->maxWaitNs;
+    uint64_t maxHoldNs = __atomic_load_n(&slot->maxHoldNs, __ATOMIC_RELAXED);
+    stats->maxHoldNs = maxHoldNs > stats->maxHoldNs ? maxHoldNs : stats->maxHoldNs;
+    for (size_t i = 0; i < CELIX_LOCK_PROFILING_HISTOGRAM_SIZE; ++i) {
+        stats->waitHistogram[i] += __atomic_load_n(&slot->waitHistogram[i], __ATOMIC_RELAXED);
+    }
+}
+
+static int celix_lockProfiling_compareStats(const void* a, const void* b) {
+    const celix_lock_profile_stats_t* s1 = *(const celix_lock_profile_stats_t* const*)a;
+    const celix_lock_profile_stats_t* s2 = *(const celix_lock_profile_stats_t* const*)b;
+    if (s1->totalWaitNs != s2->totalWaitNs) {
+        return s1->totalWaitNs > s2->totalWaitNs ? -1 : 1;
+    } else if (s1->contentions != s2->contentions) {
+        return s1->contentions > s2->contentions ? -1 : 1;
+    } else if (s1->acquisitions != s2->acquisitions) {
+        return s1->acquisitions > s2->acquisitions ? -1 : 1;
+    }
+    return 0;
+}
+
+size_t celix_lockProfiling_getTopContended(celix_lock_profile_stats_t* stats, size_t maxStats) {
+    if (maxStats == 0) {
+        return 0;
+    }
+    celix_long_hash_map_create_options_t opts = CELIX_EMPTY_LONG_HASH_MAP_CREATE_OPTIONS;
+    opts.simpleRemovedCallback = free;
+    celix_autoptr(celix_long_hash_map_t) merged = celix_longHashMap_createWithOptions(&opts);
+    if (merged == NULL) {
+        celix_err_push("Failed to create lock profiling merge map");
+        return 0;
+    }
+
+    unsigned int generation = __atomic_load_n(&celix_lockProfiling_generation, __ATOMIC_ACQUIRE);
+    celix_lock_profile_thread_data_t* td = __atomic_load_n(&celix_lockProfiling_threads, __ATOMIC_ACQUIRE);
+    for (; td != NULL; td = td->next) {
+        if (__atomic_load_n(&td->generation, __ATOMIC_ACQUIRE) != generation) {
+            continue; //not yet cleared after a reset
+        }
+        for (size_t i = 0; i < CELIX_LOCK_PROFILING_TABLE_SIZE; ++i) {
+            const celix_lock_profile_slot_t* slot = &td->slots[i];
+            const void* lock = __atomic_load_n(&slot->lock, __ATOMIC_ACQUIRE);
+            if (lock == NULL || celix_lockProfiling_isLockMarker(lock) ||
+                __atomic_load_n(&slot->acquisitions, __ATOMIC_RELAXED) == 0) {
+                continue;
+            }
+            celix_lock_profile_stats_t* entry = celix_longHashMap_get(merged, (long)(uintptr_t)lock);
+            if (entry == NULL) {
+                celix_autofree celix_lock_profile_stats_t* newEntry = calloc(1, sizeof(*newEntry));
+                if (newEntry == NULL ||
+                    celix_longHashMap_put(merged, (long)(uintptr_t)lock, newEntry) != CELIX_SUCCESS) {
+                    celix_err_push("Failed to merge lock profiling statistics");
+                    return 0;
+                }
+                entry = celix_steal_ptr(newEntry);
+                entry->lock = lock;
+            }
+            celix_lockProfiling_mergeSlot(entry, slot);
+        }
+    }
+
+    size_t size = celix_longHashMap_size(merged);
+    celix_autofree celix_lock_profile_stats_t** sorted = calloc(size + 1, sizeof(*sorted));
+    if (sorted == NULL) {
+        celix_err_push("Failed to sort lock profiling statistics");
+        return 0;
+    }
+    size_t idx = 0;
+    CELIX_LONG_HASH_MAP_ITERATE(merged, iter) {
+        sorted[idx++] = iter.value.ptrValue;
+    }
+    qsort(sorted, size, sizeof(*sorted), celix_lockProfiling_compareStats);
+
+    size_t count = size < maxStats ? size : maxStats;
+    pthread_mutex_lock(&celix_lockProfiling_namesMutex);
+    for (size_t i = 0; i < count; ++i) {
+        stats[i] = *sorted[i];
+        const char* name = celix_lockProfiling_names == NULL
+                               ? NULL
+                               : celix_longHashMap_get(celix_lockProfiling_names, (long)(uintptr_t)stats[i].lock);
+        snprintf(stats[i].name, sizeof(stats[i].name), "%s", name == NULL ? "" : name);
+    }
+    pthread_mutex_unlock(&celix_lockProfiling_namesMutex);
+    return count;
+}
+
+static uint64_t celix_lockProfiling_droppedAcquisitions(void) {
+    uint64_t dropped = 0;
+    unsigned int generation = __atomic_load_n(&celix_lockProfiling_generation, __ATOMIC_ACQUIRE);
+    celix_lock_profile_thread_data_t* td = __atomic_load_n(&celix_lockProfiling_threads, __ATOMIC_ACQUIRE);
+    for (; td != NULL; td = td->next) {
+        if (__atomic_load_n(&td->generation, __ATOMIC_ACQUIRE) == generation) {
+            dropped += __atomic_load_n(&td->droppedAcquisitions, __ATOMIC_RELAXED);
+        }
+    }
+    return dropped;
+}
+
+celix_status_t celix_lockProfiling_print(FILE* stream, size_t topN) {
+    celix_autofree celix_lock_profile_stats_t* stats = calloc(topN + 1, sizeof(*stats));
+    if (stats == NULL) {
+        celix_err_push("Failed to allocate lock profiling statistics");
+        return CELIX_ENOMEM;
+    }
+    size_t count = celix_lockProfiling_getTopContended(stats, topN);
+
+    fprintf(stream, "Lock profiling is %s.\n", celix_lockProfiling_isEnabled() ? "enabled" : "disabled");
+    fprintf(stream,
+            "%-40s %12s %12s %14s %12s %14s %12s\n",
+            "Lock",
+            "Acquired",
+            "Contended",
+            "Wait tot(us)",
+            "Wait max(us)",
+            "Hold tot(us)",
+            "Hold max(us)");
+    for (size_t i = 0; i < count; ++i) {
+        const celix_lock_profile_stats_t* s = &stats[i];
+        char unnamed[32];
+        snprintf(unnamed, sizeof(unnamed), "%p", s->lock);
+        fprintf(stream,
+                "%-40s %12llu %12llu %14llu %12llu %14llu %12llu\n",
+                s->name[0] != '\0' ? s->name : unnamed,
+                (unsigned long long)s->acquisitions,
+                (unsigned long long)s->contentions,
+                (unsigned long long)(s->totalWaitNs / 1000),
+                (unsigned long long)(s->maxWaitNs / 1000),
+                (unsigned long long)(s->totalHoldNs / 1000),
+                (unsigned long long)(s->maxHoldNs / 1000));
+        if (s->contentions > 0) {
+            fprintf(stream, "    wait histogram:");
+            for (size_t b = 0; b < CELIX_LOCK_PROFILING_HISTOGRAM_SIZE; ++b) {
+                if (s->waitHistogram[b] == 0) {
+                    continue;
+                }
+                bool last = b == CELIX_LOCK_PROFILING_HISTOGRAM_SIZE - 1;
+                fprintf(stream,
+                        " %s%lluus:%llu",
+                        last ? ">=" : "<",
+                        1ULL << (last ? b - 1 : b),
+                        (unsigned long long)s->waitHistogram[b]);
+            }
+            fprintf(stream, "\n");
+        }
+    }
+    uint64_t dropped = celix_lockProfiling_droppedAcquisitions();
+    if (dropped > 0) {
+        fprintf(stream, "Note: %llu lock acquisitions were not profiled.\n", (unsigned long long)dropped);
+    }
+    return CELIX_SUCCESS;
+}
+
+#else //CELIX_THREADS_LOCK_PROFILING
+
+bool celix_lockProfiling_isSupported(void) {
+    return false;
+}
+
+celix_status_t celix_lockProfiling_setEnabled(bool enabled CELIX_UNUSED) {
+    celix_err_push("Lock profiling is not supported, build Celix with CELIX_THREADS_LOCK_PROFILING=ON");
+    return CELIX_ILLEGAL_STATE;
+}
+
+bool celix_lockProfiling_isEnabled(void) {
+    return false;
+}
+
+void celix_lockProfiling_setName(const void* lock CELIX_UNUSED, const char* format CELIX_UNUSED, ...) {
+    //nop
+}
+
+void celix_lockProfiling_reset(void) {
+    //nop
+}
+
+size_t celix_lockProfiling_getTopContended(celix_lock_profile_stats_t* stats CELIX_UNUSED, size_t maxStats CELIX_UNUSED) {
+    return 0;
+}
+
+celix_status_t celix_lockProfiling_print(FILE* stream CELIX_UNUSED, size_t topN CELIX_UNUSED) {
+    celix_err_push("Lock profiling is not supported, build Celix with CELIX_THREADS_LOCK_PROFILING=ON");
+    return CELIX_ILLEGAL_STATE;
+}
+
+#endif //CELIX_THREADS_LOCK_PROFILING
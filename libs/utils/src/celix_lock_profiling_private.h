@@ -0,0 +1,71 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_LOCK_PROFILING_PRIVATE_H_
+#define CELIX_LOCK_PROFILING_PRIVATE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "celix_lock_profiling.h"
+#include "celix_utils_private_constants.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CELIX_THREADS_LOCK_PROFILING
+
+/**
+ * @brief Returns the current monotonic time in nanoseconds.
+ */
+uint64_t celix_lockProfiling_now(void);
+
+/**
+ * @brief Records an acquisition of lock by the calling thread and starts its hold time.
+ * @param[in] contended Whether the calling thread had to wait for the lock.
+ * @param[in] waitNs The time waited for the lock, only used if contended.
+ */
+void celix_lockProfiling_acquired(const void* lock, bool contended, uint64_t waitNs);
+
+/**
+ * @brief Restarts the hold time of lock after a condition wait, without counting an acquisition.
+ */
+void celix_lockProfiling_reacquired(const void* lock);
+
+/**
+ * @brief Ends the hold time of lock for the calling thread.
+ *
+ * Must be called - even if profiling is disabled - before the lock is unlocked, so that hold times started
+ * before profiling got disabled are ended.
+ */
+void celix_lockProfiling_released(const void* lock);
+
+/**
+ * @brief Removes the name of a lock which is about to be destroyed.
+ */
+void celix_lockProfiling_destroyed(const void* lock);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_LOCK_PROFILING_PRIVATE_H_ */
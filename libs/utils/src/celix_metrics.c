@@ -0,0 +1,184 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_metrics.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "celix_utils.h"
+
+static int celix_metricsHistogram_bucket(uint64_t durationNs) {
+    if (durationNs < 1024) {
+        return 0;
+    }
+    int bucket = (63 - __builtin_clzll(durationNs)) - 9;
+    return bucket < CELIX_METRICS_HISTOGRAM_SIZE ? bucket : CELIX_METRICS_HISTOGRAM_SIZE - 1;
+}
+
+void celix_metricsHistogram_record(celix_metrics_histogram_t* histogram, uint64_t durationNs) {
+    int bucket = celix_metricsHistogram_bucket(durationNs);
+    __atomic_add_fetch(&histogram->buckets[bucket], 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&histogram->count, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&histogram->sumNs, durationNs, __ATOMIC_RELAXED);
+}
+
+void celix_metricsHistogram_recordSince(celix_metrics_histogram_t* histogram, const struct timespec* start) {
+    struct timespec now = celix_gettime(CLOCK_MONOTONIC);
+    int64_t ns = (int64_t)(now.tv_sec - start->tv_sec) * 1000000000LL + (now.tv_nsec - start->tv_nsec);
+    celix_metricsHistogram_record(histogram, ns > 0 ? (uint64_t)ns : 0);
+}
+
+void celix_metricsHistogram_snapshot(const celix_metrics_histogram_t* histogram, celix_metrics_histogram_t* snapshot) {
+    uint64_t count = 0;
+    for (int i = 0; i < CELIX_METRICS_HISTOGRAM_SIZE; ++i) {
+        snapshot->buckets[i] = __atomic_load_n(&histogram->buckets[i], __ATOMIC_RELAXED);
+        count += snapshot->buckets[i];
+    }
+    //note using the sum of the buckets as count, so that the snapshot is consistent with its buckets
+    snapshot->count = count;
+    snapshot->sumNs = __atomic_load_n(&histogram->sumNs, __ATOMIC_RELAXED);
+}
+
+double celix_metricsHistogram_bucketUpperBound(int bucket) {
+    if (bucket < 0) {
+        return 0.0;
+    } else if (bucket >= CELIX_METRICS_HISTOGRAM_SIZE - 1) {
+        return INFINITY;
+    }
+    return (double)(1ULL << (10 + bucket)) / 1000000000.0;
+}
+
+double celix_metricsHistogram_quantile(const celix_metrics_histogram_t* histogram, double quantile) {
+    celix_metrics_histogram_t snapshot;
+    celix_metricsHistogram_snapshot(histogram, &snapshot);
+    if (snapshot.count == 0) {
+        return 0.0;
+    }
+    double rank = quantile * (double)snapshot.count;
+    uint64_t cumulative = 0;
+    for (int i = 0; i < CELIX_METRICS_HISTOGRAM_SIZE; ++i) {
+        cumulative += snapshot.buckets[i];
+        if (cumulative > 0 && (double)cumulative >= rank) {
+            return celix_metricsHistogram_bucketUpperBound(i);
+        }
+    }
+    return INFINITY;
+}
+
+static const char* celix_metrics_typeName(celix_metric_type_e type) {
+    switch (type) {
+    case CELIX_METRIC_TYPE_COUNTER:
+        return "counter";
+    case CELIX_METRIC_TYPE_GAUGE:
+        return "gauge";
+    default:
+        return "histogram";
+    }
+}
+
+static void celix_metrics_writeValue(FILE* stream, double value) {
+    if (isinf(value)) {
+        fputs(value > 0 ? "+Inf" : "-Inf", stream);
+    } else if (value == floor(value) && fabs(value) < 1e15) {
+        fprintf(stream, "%.0f", value);
+    } else {
+        fprintf(stream, "%.9g", value);
+    }
+}
+
+static bool celix_metrics_hasLabels(const celix_metric_t* metric) {
+    return metric->labels != NULL && metric->labels[0] != '\0';
+}
+
+static void celix_metrics_writeSample(FILE* stream,
+                                      const celix_metric_t* metric,
+                                      const char* suffix,
+                                      const char* extraLabel,
+                                      double value) {
+    fprintf(stream, "%s%s", metric->name, suffix);
+    bool labels = celix_metrics_hasLabels(metric);
+    if (labels || extraLabel) {
+        fprintf(stream, "{%s%s%s}",
+                labels ? metric->labels : "",
+                labels && extraLabel ? "," : "",
+                extraLabel ? extraLabel : "");
+    }
+    fputc(' ', stream);
+    celix_metrics_writeValue(stream, value);
+    fputc('\n', stream);
+}
+
+celix_status_t celix_metrics_writePrometheus(FILE* stream, const celix_metric_t* metric, bool writeHeader) {
+    if (metric->name == NULL || (metric->type == CELIX_METRIC_TYPE_HISTOGRAM && metric->histogram == NULL)) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (writeHeader) {
+        if (metric->help != NULL) {
+            fprintf(stream, "# HELP %s %s\n", metric->name, metric->help);
+        }
+        fprintf(stream, "# TYPE %s %s\n", metric->name, celix_metrics_typeName(metric->type));
+    }
+    if (metric->type != CELIX_METRIC_TYPE_HISTOGRAM) {
+        celix_metrics_writeSample(stream, metric, "", NULL, metric->value);
+        return CELIX_SUCCESS;
+    }
+
+    celix_metrics_histogram_t snapshot;
+    celix_metricsHistogram_snapshot(metric->histogram, &snapshot);
+    uint64_t cumulative = 0;
+    for (int i = 0; i < CELIX_METRICS_HISTOGRAM_SIZE; ++i) {
+        cumulative += snapshot.buckets[i];
+        char le[32];
+        double upper = celix_metricsHistogram_bucketUpperBound(i);
+        if (isinf(upper)) {
+            snprintf(le, sizeof(le), "le=\"+Inf\"");
+        } else {
+            snprintf(le, sizeof(le), "le=\"%.9g\"", upper);
+        }
+        celix_metrics_writeSample(stream, metric, "_bucket", le, (double)cumulative);
+    }
+    celix_metrics_writeSample(stream, metric, "_sum", NULL, (double)snapshot.sumNs / 1000000000.0);
+    celix_metrics_writeSample(stream, metric, "_count", NULL, (double)snapshot.count);
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_metrics_writeText(FILE* stream, const celix_metric_t* metric) {
+    if (metric->name == NULL || (metric->type == CELIX_METRIC_TYPE_HISTOGRAM && metric->histogram == NULL)) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (metric->type != CELIX_METRIC_TYPE_HISTOGRAM) {
+        celix_metrics_writeSample(stream, metric, "", NULL, metric->value);
+        return CELIX_SUCCESS;
+    }
+    celix_metrics_histogram_t snapshot;
+    celix_metricsHistogram_snapshot(metric->histogram, &snapshot);
+    double avgUs = snapshot.count == 0 ? 0.0 : (double)snapshot.sumNs / (double)snapshot.count / 1000.0;
+    fprintf(stream, "%s", metric->name);
+    if (celix_metrics_hasLabels(metric)) {
+        fprintf(stream, "{%s}", metric->labels);
+    }
+    fprintf(stream,
+            " count=%llu avg=%.1fus p50<=%.1fus p99<=%.1fus\n",
+            (unsigned long long)snapshot.count,
+            avgUs,
+            celix_metricsHistogram_quantile(&snapshot, 0.5) * 1e6,
+            celix_metricsHistogram_quantile(&snapshot, 0.99) * 1e6);
+    return CELIX_SUCCESS;
+}
@@ -17,12 +17,15 @@
  * under the License.
  */
 
+#include <sched.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/time.h>
 #include <time.h>
 #include <signal.h>
 
 #include "celix_compiler.h"
+#include "celix_lock_profiling_private.h"
 #include "celix_threads.h"
 #include "celix_utils.h"
 
@@ -30,6 +33,26 @@
 const celix_thread_t celix_thread_default = {0, 0};
 #endif
 
+#if CELIX_THREADS_LOCK_PROFILING
+/**
+ * Profiled lock: first try to lock without blocking, only if that fails the lock is contended and the blocking
+ * lock call is timed.
+ */
+#define CELIX_THREADS_PROFILED_LOCK(lock, tryLockFunc, lockFunc)                                                       \
+    do {                                                                                                               \
+        if (tryLockFunc(lock) == 0) {                                                                                  \
+            celix_lockProfiling_acquired(lock, false, 0);                                                              \
+            return CELIX_SUCCESS;                                                                                      \
+        }                                                                                                              \
+        uint64_t start = celix_lockProfiling_now();                                                                    \
+        celix_status_t lockStatus = lockFunc(lock);                                                                    \
+        if (lockStatus == 0) {                                                                                         \
+            celix_lockProfiling_acquired(lock, true, celix_lockProfiling_now() - start);                               \
+        }                                                                                                              \
+        return lockStatus;                                                                                             \
+    } while (0)
+#endif
+
 celix_status_t celixThread_create(celix_thread_t *new_thread, const celix_thread_attr_t *attr, celix_thread_start_t func, void *data) {
     celix_status_t status = CELIX_SUCCESS;
 
@@ -102,18 +125,35 @@ celix_status_t celixThreadMutex_create(celix_thread_mutex_t *mutex, celix_thread
 }
 
 celix_status_t celixThreadMutex_destroy(celix_thread_mutex_t *mutex) {
+#if CELIX_THREADS_LOCK_PROFILING
+    celix_lockProfiling_destroyed(mutex);
+#endif
     return pthread_mutex_destroy(mutex);
 }
 
 celix_status_t celixThreadMutex_lock(celix_thread_mutex_t *mutex) {
+#if CELIX_THREADS_LOCK_PROFILING
+    if (celix_lockProfiling_isEnabled()) {
+        CELIX_THREADS_PROFILED_LOCK(mutex, pthread_mutex_trylock, pthread_mutex_lock);
+    }
+#endif
     return pthread_mutex_lock(mutex);
 }
 
 celix_status_t celixThreadMutex_tryLock(celix_thread_mutex_t *mutex) {
-    return pthread_mutex_trylock(mutex);
+    celix_status_t status = pthread_mutex_trylock(mutex);
+#if CELIX_THREADS_LOCK_PROFILING
+    if (status == 0 && celix_lockProfiling_isEnabled()) {
+        celix_lockProfiling_acquired(mutex, false, 0);
+    }
+#endif
+    return status;
 }
 
 celix_status_t celixThreadMutex_unlock(celix_thread_mutex_t *mutex) {
+#if CELIX_THREADS_LOCK_PROFILING
+    celix_lockProfiling_released(mutex);
+#endif
     return pthread_mutex_unlock(mutex);
 }
 
@@ -140,6 +180,13 @@ celix_status_t celixThreadMutexAttr_settype(celix_thread_mutexattr_t *attr, int
         case CELIX_THREAD_MUTEX_DEFAULT :
             status = pthread_mutexattr_settype(attr, PTHREAD_MUTEX_DEFAULT);
             break;
+        case CELIX_THREAD_MUTEX_ADAPTIVE :
+#if defined(_GNU_SOURCE) && defined(__GLIBC__)
+            status = pthread_mutexattr_settype(attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+#else
+            status = pthread_mutexattr_settype(attr, PTHREAD_MUTEX_DEFAULT);
+#endif
+            break;
         default:
             status = pthread_mutexattr_settype(attr, PTHREAD_MUTEX_DEFAULT);
             break;
@@ -171,7 +218,14 @@ celix_status_t celixThreadCondition_destroy(celix_thread_cond_t *condition) {
 }
 
 celix_status_t celixThreadCondition_wait(celix_thread_cond_t *cond, celix_thread_mutex_t *mutex) {
+#if CELIX_THREADS_LOCK_PROFILING
+    celix_lockProfiling_released(mutex);
+    celix_status_t status = pthread_cond_wait(cond, mutex);
+    celix_lockProfiling_reacquired(mutex);
+    return status;
+#else
     return pthread_cond_wait(cond, mutex);
+#endif
 }
 
 #ifdef __APPLE__
@@ -179,13 +233,20 @@ celix_status_t celixThreadCondition_timedwaitRelative(celix_thread_cond_t *cond,
     struct timespec time;
     time.tv_sec = seconds;
     time.tv_nsec = nanoseconds;
+#if CELIX_THREADS_LOCK_PROFILING
+    celix_lockProfiling_released(mutex);
+    celix_status_t status = pthread_cond_timedwait_relative_np(cond, mutex, &time);
+    celix_lockProfiling_reacquired(mutex);
+    return status;
+#else
     return pthread_cond_timedwait_relative_np(cond, mutex, &time);
+#endif
 }
 #else
 celix_status_t celixThreadCondition_timedwaitRelative(celix_thread_cond_t *cond, celix_thread_mutex_t *mutex, long seconds, long nanoseconds) {
     double delay = (double)seconds + ((double)nanoseconds / 1000000000);
     struct timespec time = celixThreadCondition_getDelayedTime(delay);
-    return pthread_cond_timedwait(cond, mutex, &time);
+    return celixThreadCondition_waitUntil(cond, mutex, &time);
 }
 #endif
 
@@ -215,6 +276,11 @@ celixThreadCondition_waitUntil(celix_thread_cond_t* cond, celix_thread_mutex_t*
     long seconds = diff;
     long nanoseconds = (diff - seconds) * CELIX_NS_IN_SEC;
     return celixThreadCondition_timedwaitRelative(cond, mutex, seconds, nanoseconds);
+#elif CELIX_THREADS_LOCK_PROFILING
+    celix_lockProfiling_released(mutex);
+    celix_status_t status = pthread_cond_timedwait(cond, mutex, absTime);
+    celix_lockProfiling_reacquired(mutex);
+    return status;
 #else
     return pthread_cond_timedwait(cond, mutex, absTime);
 #endif
@@ -233,26 +299,54 @@ celix_status_t celixThreadRwlock_create(celix_thread_rwlock_t *lock, celix_threa
 }
 
 celix_status_t celixThreadRwlock_destroy(celix_thread_rwlock_t *lock) {
+#if CELIX_THREADS_LOCK_PROFILING
+    celix_lockProfiling_destroyed(lock);
+#endif
     return pthread_rwlock_destroy(lock);
 }
 
 celix_status_t celixThreadRwlock_readLock(celix_thread_rwlock_t *lock) {
+#if CELIX_THREADS_LOCK_PROFILING
+    if (celix_lockProfiling_isEnabled()) {
+        CELIX_THREADS_PROFILED_LOCK(lock, pthread_rwlock_tryrdlock, pthread_rwlock_rdlock);
+    }
+#endif
     return pthread_rwlock_rdlock(lock);
 }
 
 celix_status_t celixThreadRwlock_tryReadLock(celix_thread_rwlock_t *lock) {
-    return pthread_rwlock_tryrdlock(lock);
+    celix_status_t status = pthread_rwlock_tryrdlock(lock);
+#if CELIX_THREADS_LOCK_PROFILING
+    if (status == 0 && celix_lockProfiling_isEnabled()) {
+        celix_lockProfiling_acquired(lock, false, 0);
+    }
+#endif
+    return status;
 }
 
 celix_status_t celixThreadRwlock_writeLock(celix_thread_rwlock_t *lock) {
+#if CELIX_THREADS_LOCK_PROFILING
+    if (celix_lockProfiling_isEnabled()) {
+        CELIX_THREADS_PROFILED_LOCK(lock, pthread_rwlock_trywrlock, pthread_rwlock_wrlock);
+    }
+#endif
     return pthread_rwlock_wrlock(lock);
 }
 
 celix_status_t celixThreadRwlock_tryWriteLock(celix_thread_rwlock_t *lock) {
-    return pthread_rwlock_trywrlock(lock);
+    celix_status_t status = pthread_rwlock_trywrlock(lock);
+#if CELIX_THREADS_LOCK_PROFILING
+    if (status == 0 && celix_lockProfiling_isEnabled()) {
+        celix_lockProfiling_acquired(lock, false, 0);
+    }
+#endif
+    return status;
 }
 
 celix_status_t celixThreadRwlock_unlock(celix_thread_rwlock_t *lock) {
+#if CELIX_THREADS_LOCK_PROFILING
+    celix_lockProfiling_released(lock);
+#endif
     return pthread_rwlock_unlock(lock);
 }
 
@@ -264,6 +358,248 @@ celix_status_t celixThreadRwlockAttr_destroy(celix_thread_rwlockattr_t *attr) {
     return pthread_rwlockattr_destroy(attr);
 }
 
+typedef struct celix_rb_rwlock_read_entry {
+    const celix_thread_rb_rwlock_t* lock;
+    unsigned int depth;
+} celix_rb_rwlock_read_entry_t;
+
+static unsigned int celix_rbRwlock_nextSlot = 0;
+static __thread unsigned int celix_rbRwlock_threadSlot = 0; //slot index + 1, 0 if not yet assigned
+static __thread char celix_rbRwlock_threadId; //the address is used as unique thread id
+static __thread celix_rb_rwlock_read_entry_t celix_rbRwlock_readEntries[CELIX_THREAD_RB_RWLOCK_MAX_NESTED_LOCKS];
+//read entries for more than CELIX_THREAD_RB_RWLOCK_MAX_NESTED_LOCKS locks, freed when no longer in use
+static __thread celix_rb_rwlock_read_entry_t* celix_rbRwlock_overflowEntries = NULL;
+static __thread unsigned int celix_rbRwlock_overflowSize = 0;
+static __thread unsigned int celix_rbRwlock_overflowUsed = 0;
+
+static long* celix_rbRwlock_readerCounter(celix_thread_rb_rwlock_t* lock) {
+    if (celix_rbRwlock_threadSlot == 0) {
+        unsigned int slot = __atomic_fetch_add(&celix_rbRwlock_nextSlot, 1, __ATOMIC_RELAXED);
+        celix_rbRwlock_threadSlot = (slot % CELIX_THREAD_RB_RWLOCK_READER_SLOTS) + 1;
+    }
+    return &lock->_slots[celix_rbRwlock_threadSlot - 1].readers;
+}
+
+/**
+ * Returns the read entry of the calling thread for lock or NULL if the thread does not hold a read lock on lock.
+ * If freeEntry is not NULL, it is set to a free entry (or NULL if all entries are in use).
+ */
+static celix_rb_rwlock_read_entry_t* celix_rbRwlock_findReadEntryIn(celix_rb_rwlock_read_entry_t* entries,
+                                                                    unsigned int size,
+                                                                    const celix_thread_rb_rwlock_t* lock,
+                                                                    celix_rb_rwlock_read_entry_t** freeEntry) {
+    for (unsigned int i = 0; i < size; ++i) {
+        if (entries[i].lock == lock) {
+            return &entries[i];
+        } else if (freeEntry != NULL && *freeEntry == NULL && entries[i].lock == NULL) {
+            *freeEntry = &entries[i];
+        }
+    }
+    return NULL;
+}
+
+static celix_rb_rwlock_read_entry_t* celix_rbRwlock_findReadEntry(const celix_thread_rb_rwlock_t* lock,
+                                                                  celix_rb_rwlock_read_entry_t** freeEntry) {
+    celix_rb_rwlock_read_entry_t* entry = celix_rbRwlock_findReadEntryIn(
+        celix_rbRwlock_readEntries, CELIX_THREAD_RB_RWLOCK_MAX_NESTED_LOCKS, lock, freeEntry);
+    if (entry == NULL && celix_rbRwlock_overflowUsed > 0) {
+        entry = celix_rbRwlock_findReadEntryIn(celix_rbRwlock_overflowEntries, celix_rbRwlock_overflowSize, lock, freeEntry);
+    }
+    return entry;
+}
+
+static bool celix_rbRwlock_isOverflowEntry(const celix_rb_rwlock_read_entry_t* entry) {
+    return entry >= celix_rbRwlock_overflowEntries && entry < celix_rbRwlock_overflowEntries + celix_rbRwlock_overflowSize;
+}
+
+/**
+ * Returns a free read entry, using the overflow entries if the thread holds read locks on more than
+ * CELIX_THREAD_RB_RWLOCK_MAX_NESTED_LOCKS locks. Returns NULL if the overflow entries cannot be allocated.
+ */
+static celix_rb_rwlock_read_entry_t* celix_rbRwlock_freeOverflowEntry(void) {
+    if (celix_rbRwlock_overflowUsed < celix_rbRwlock_overflowSize) {
+        //an entry without lock is a free entry
+        return celix_rbRwlock_findReadEntryIn(celix_rbRwlock_overflowEntries, celix_rbRwlock_overflowSize, NULL, NULL);
+    }
+    unsigned int size = celix_rbRwlock_overflowSize == 0 ? CELIX_THREAD_RB_RWLOCK_MAX_NESTED_LOCKS : celix_rbRwlock_overflowSize * 2;
+    celix_rb_rwlock_read_entry_t* entries = realloc(celix_rbRwlock_overflowEntries, size * sizeof(*entries));
+    if (entries == NULL) {
+        return NULL;
+    }
+    memset(entries + celix_rbRwlock_overflowSize, 0, (size - celix_rbRwlock_overflowSize) * sizeof(*entries));
+    celix_rb_rwlock_read_entry_t* freeEntry = entries + celix_rbRwlock_overflowSize;
+    celix_rbRwlock_overflowEntries = entries;
+    celix_rbRwlock_overflowSize = size;
+    return freeEntry;
+}
+
+static void celix_rbRwlock_releaseReadEntry(celix_rb_rwlock_read_entry_t* entry) {
+    entry->lock = NULL;
+    if (celix_rbRwlock_isOverflowEntry(entry) && --celix_rbRwlock_overflowUsed == 0) {
+        free(celix_rbRwlock_overflowEntries);
+        celix_rbRwlock_overflowEntries = NULL;
+        celix_rbRwlock_overflowSize = 0;
+    }
+}
+
+/**
+ * Decrements the reader counter and wakes up the writer if it is waiting for the readers to drain.
+ */
+static void celix_rbRwlock_releaseReader(celix_thread_rb_rwlock_t* lock, long* readers) {
+    __atomic_fetch_sub(readers, 1, __ATOMIC_SEQ_CST);
+    //seq_cst: either the waiting writer sees the decremented counter or this reader sees the waiting writer
+    if (__atomic_load_n(&lock->_writerWaiting, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&lock->_drainMutex);
+        pthread_cond_broadcast(&lock->_drainCond);
+        pthread_mutex_unlock(&lock->_drainMutex);
+    }
+}
+
+/**
+ * Waits until all reader counters are drained, returns whether there were active readers.
+ */
+static bool celix_rbRwlock_waitForReaders(celix_thread_rb_rwlock_t* lock) {
+    bool waited = false;
+    for (int i = 0; i < CELIX_THREAD_RB_RWLOCK_READER_SLOTS; ++i) {
+        long* readers = &lock->_slots[i].readers;
+        for (unsigned int spins = 0; spins < 128 && __atomic_load_n(readers, __ATOMIC_SEQ_CST) != 0; ++spins) {
+            waited = true; //busy spin, read locks are expected to be short
+        }
+        if (__atomic_load_n(readers, __ATOMIC_SEQ_CST) == 0) {
+            continue;
+        }
+        pthread_mutex_lock(&lock->_drainMutex);
+        __atomic_store_n(&lock->_writerWaiting, true, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(readers, __ATOMIC_SEQ_CST) != 0) {
+            pthread_cond_wait(&lock->_drainCond, &lock->_drainMutex);
+        }
+        __atomic_store_n(&lock->_writerWaiting, false, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&lock->_drainMutex);
+    }
+    return waited;
+}
+
+celix_status_t celixThreadRbRwlock_create(celix_thread_rb_rwlock_t* lock) {
+    memset(lock, 0, sizeof(*lock));
+    celix_status_t status = pthread_mutex_init(&lock->_writerMutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    status = pthread_mutex_init(&lock->_drainMutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        pthread_mutex_destroy(&lock->_writerMutex);
+        return status;
+    }
+    status = pthread_cond_init(&lock->_drainCond, NULL);
+    if (status != CELIX_SUCCESS) {
+        pthread_mutex_destroy(&lock->_drainMutex);
+        pthread_mutex_destroy(&lock->_writerMutex);
+    }
+    return status;
+}
+
+celix_status_t celixThreadRbRwlock_destroy(celix_thread_rb_rwlock_t* lock) {
+#if CELIX_THREADS_LOCK_PROFILING
+    celix_lockProfiling_destroyed(lock);
+#endif
+    pthread_cond_destroy(&lock->_drainCond);
+    pthread_mutex_destroy(&lock->_drainMutex);
+    return pthread_mutex_destroy(&lock->_writerMutex);
+}
+
+celix_status_t celixThreadRbRwlock_readLock(celix_thread_rb_rwlock_t* lock) {
+    long* readers = celix_rbRwlock_readerCounter(lock);
+    celix_rb_rwlock_read_entry_t* freeEntry = NULL;
+    celix_rb_rwlock_read_entry_t* entry = celix_rbRwlock_findReadEntry(lock, &freeEntry);
+    if (entry != NULL) {
+        //recursive read lock, the reader counter is already > 0 so a writer cannot proceed: no need to back off.
+        __atomic_fetch_add(readers, 1, __ATOMIC_SEQ_CST);
+        entry->depth += 1;
+        return CELIX_SUCCESS;
+    }
+
+#if CELIX_THREADS_LOCK_PROFILING
+    bool contended = false;
+    uint64_t start = 0;
+#endif
+    for (;;) {
+        __atomic_fetch_add(readers, 1, __ATOMIC_SEQ_CST);
+        if (!__atomic_load_n(&lock->_writerActive, __ATOMIC_SEQ_CST)) {
+            break;
+        }
+        //writer active, back off and park on the writer mutex until the writer is done
+        celix_rbRwlock_releaseReader(lock, readers);
+#if CELIX_THREADS_LOCK_PROFILING
+        if (!contended) {
+            contended = true;
+            start = celix_lockProfiling_now();
+        }
+#endif
+        pthread_mutex_lock(&lock->_writerMutex);
+        pthread_mutex_unlock(&lock->_writerMutex);
+    }
+#if CELIX_THREADS_LOCK_PROFILING
+    if (celix_lockProfiling_isEnabled()) {
+        celix_lockProfiling_acquired(lock, contended, contended ? celix_lockProfiling_now() - start : 0);
+    }
+#endif
+
+    if (freeEntry == NULL) {
+        freeEntry = celix_rbRwlock_freeOverflowEntry();
+    }
+    if (freeEntry != NULL) {
+        freeEntry->lock = lock;
+        freeEntry->depth = 1;
+        celix_rbRwlock_overflowUsed += celix_rbRwlock_isOverflowEntry(freeEntry) ? 1 : 0;
+    }
+    //else out of memory: the read lock is not tracked, a recursive read lock can then deadlock with a waiting writer
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celixThreadRbRwlock_writeLock(celix_thread_rb_rwlock_t* lock) {
+#if CELIX_THREADS_LOCK_PROFILING
+    bool profile = celix_lockProfiling_isEnabled();
+    uint64_t start = profile ? celix_lockProfiling_now() : 0;
+    bool contended = profile && pthread_mutex_trylock(&lock->_writerMutex) != 0;
+    celix_status_t status = profile && !contended ? CELIX_SUCCESS : pthread_mutex_lock(&lock->_writerMutex);
+#else
+    celix_status_t status = pthread_mutex_lock(&lock->_writerMutex);
+#endif
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    __atomic_store_n(&lock->_writerActive, true, __ATOMIC_SEQ_CST);
+    bool waitedForReaders = celix_rbRwlock_waitForReaders(lock);
+    __atomic_store_n(&lock->_writer, &celix_rbRwlock_threadId, __ATOMIC_RELEASE);
+#if CELIX_THREADS_LOCK_PROFILING
+    if (profile) {
+        contended = contended || waitedForReaders;
+        celix_lockProfiling_acquired(lock, contended, contended ? celix_lockProfiling_now() - start : 0);
+    }
+#else
+    (void)waitedForReaders;
+#endif
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celixThreadRbRwlock_unlock(celix_thread_rb_rwlock_t* lock) {
+#if CELIX_THREADS_LOCK_PROFILING
+    celix_lockProfiling_released(lock);
+#endif
+    if (__atomic_load_n(&lock->_writer, __ATOMIC_ACQUIRE) == &celix_rbRwlock_threadId) {
+        __atomic_store_n(&lock->_writer, NULL, __ATOMIC_RELAXED);
+        __atomic_store_n(&lock->_writerActive, false, __ATOMIC_SEQ_CST);
+        return pthread_mutex_unlock(&lock->_writerMutex);
+    }
+
+    celix_rb_rwlock_read_entry_t* entry = celix_rbRwlock_findReadEntry(lock, NULL);
+    if (entry != NULL && --entry->depth == 0) {
+        celix_rbRwlock_releaseReadEntry(entry);
+    }
+    celix_rbRwlock_releaseReader(lock, celix_rbRwlock_readerCounter(lock));
+    return CELIX_SUCCESS;
+}
+
 celix_status_t celixThread_once(celix_thread_once_t *once_control, void (*init_routine)(void)) {
     return pthread_once(once_control, init_routine);
 }
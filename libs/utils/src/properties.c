@@ -23,13 +23,18 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "celix_build_assert.h"
 #include "celix_err.h"
+#include "celix_ref.h"
 #include "celix_string_hash_map.h"
 #include "celix_utils.h"
 #include "celix_stdlib_cleanup.h"
@@ -41,6 +46,16 @@ static const char* const CELIX_PROPERTIES_BOOL_FALSE_STRVAL = "false";
 static const char* const CELIX_PROPERTIES_EMPTY_STRVAL = "";
 
 struct celix_properties {
+    /**
+     * The reference count. A properties set is destroyed when the last reference is released.
+     */
+    struct celix_ref ref;
+
+    /**
+     * Whether the properties set is frozen (immutable). Frozen properties can be shared without copying.
+     */
+    bool frozen;
+
     celix_string_hash_map_t* map;
 
     /**
@@ -72,27 +87,34 @@ struct celix_properties {
      * The current string buffer index.
      */
     int currentEntriesBufferIndex;
-};
 
-#define MALLOC_BLOCK_SIZE 5
+    /**
+     * Buffer with the content the properties are loaded from (either a private mmap-ed file or a heap allocated copy).
+     * The keys and (unescaped) values of loaded entries are tokenized in place and reference this buffer, so it is
+     * kept until the properties set is destroyed. NULL if the properties set is not loaded.
+     */
+    char* loadBuffer;
+
+    /**
+     * The size of the load buffer.
+     */
+    size_t loadBufferSize;
 
-static celix_status_t celix_properties_parseLine(const char* line, celix_properties_t* props);
+    /**
+     * Whether the load buffer is mmap-ed (and should be unmapped) or heap allocated (and should be freed).
+     */
+    bool loadBufferMapped;
+};
 
-static void
-celix_properties_updateBuffers(char** key, char** value, char** output, int outputPos, int* key_len, int* value_len) {
-    if (*output == *key) {
-        if (outputPos == (*key_len) - 1) {
-            (*key_len) += MALLOC_BLOCK_SIZE;
-            *key = realloc(*key, *key_len);
-            *output = *key;
-        }
-    } else {
-        if (outputPos == (*value_len) - 1) {
-            (*value_len) += MALLOC_BLOCK_SIZE;
-            *value = realloc(*value, *value_len);
-            *output = *value;
-        }
+/**
+ * Check if the properties set can be modified. Frozen properties sets are read-only.
+ */
+static bool celix_properties_isWritable(const celix_properties_t* properties, const char* key) {
+    if (properties->frozen) {
+        celix_err_pushf("Cannot modify property %s. Properties set is frozen.", key ? key : "(null)");
+        return false;
     }
+    return true;
 }
 
 /**
@@ -126,6 +148,9 @@ static void celix_properties_freeString(celix_properties_t* properties, char* st
     } else if (str >= properties->stringBuffer &&
                str < (properties->stringBuffer + CELIX_PROPERTIES_OPTIMIZATION_STRING_BUFFER_SIZE)) {
         // str is part of the properties string buffer -> nop
+    } else if (properties->loadBuffer != NULL && str >= properties->loadBuffer &&
+               str <= (properties->loadBuffer + properties->loadBufferSize)) {
+        // str is part of the properties load buffer -> nop
     } else {
         free(str);
     }
@@ -279,6 +304,10 @@ static celix_status_t celix_properties_createAndSetEntry(celix_properties_t* pro
         celix_err_pushf("Cannot set property with NULL key");
         return CELIX_ILLEGAL_ARGUMENT;
     }
+    if (!celix_properties_isWritable(properties, key)) {
+        celix_properties_freeTypedEntry(properties, prototype);
+        return CELIX_ILLEGAL_STATE;
+    }
 
     celix_properties_entry_t* entry = celix_properties_createEntry(properties, prototype);
     if (!entry) {
@@ -328,8 +357,13 @@ celix_properties_t* celix_properties_create() {
         opts.removedCallback = celix_properties_removeEntryCallback;
         opts.removedKeyCallback = celix_properties_removeKeyCallback;
         props->map = celix_stringHashMap_createWithOptions(&opts);
+        celix_ref_init(&props->ref);
+        props->frozen = false;
         props->currentStringBufferIndex = 0;
         props->currentEntriesBufferIndex = 0;
+        props->loadBuffer = NULL;
+        props->loadBufferSize = 0;
+        props->loadBufferMapped = false;
         if (props->map == NULL) {
             free(props);
             props = NULL;
@@ -340,109 +374,234 @@ celix_properties_t* celix_properties_create() {
     return props;
 }
 
+static bool celix_properties_releaseCb(struct celix_ref* ref) {
+    celix_properties_t* props = (celix_properties_t*)ref;
+    celix_stringHashMap_destroy(props->map);
+    if (props->loadBufferMapped) {
+        munmap(props->loadBuffer, props->loadBufferSize);
+    } else {
+        free(props->loadBuffer);
+    }
+    free(props);
+    return true;
+}
+
 void celix_properties_destroy(celix_properties_t* props) {
     if (props != NULL) {
-        celix_stringHashMap_destroy(props->map);
-        free(props);
+        celix_ref_put(&props->ref, celix_properties_releaseCb);
     }
 }
 
-celix_properties_t* celix_properties_load(const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        celix_err_pushf("Cannot open file '%s'", filename);
-        return NULL;
+const celix_properties_t* celix_properties_retain(const celix_properties_t* properties) {
+    if (properties != NULL) {
+        celix_ref_get(&((celix_properties_t*)properties)->ref);
     }
-    celix_properties_t* props = celix_properties_loadWithStream(file);
-    fclose(file);
-    return props;
+    return properties;
 }
 
-static celix_status_t celix_properties_parseLine(const char* line, celix_properties_t* props) {
-    int linePos;
-    int outputPos;
+void celix_properties_release(const celix_properties_t* properties) {
+    celix_properties_destroy((celix_properties_t*)properties);
+}
 
-    bool precedingCharIsBackslash = false;
-    char* output = NULL;
-    int key_len = MALLOC_BLOCK_SIZE;
-    int value_len = MALLOC_BLOCK_SIZE;
-    linePos = 0;
-    precedingCharIsBackslash = false;
-    output = NULL;
-    outputPos = 0;
-
-    // Ignore empty lines
-    if (line[0] == '\n' && line[1] == '\0') {
+void celix_properties_freeze(celix_properties_t* properties) {
+    if (properties != NULL) {
+        properties->frozen = true;
+    }
+}
+
+bool celix_properties_isFrozen(const celix_properties_t* properties) {
+    return properties != NULL && properties->frozen;
+}
+
+bool celix_properties_isShared(const celix_properties_t* properties) {
+    return properties != NULL && celix_ref_read(&properties->ref) > 1;
+}
+
+const celix_properties_t* celix_properties_share(const celix_properties_t* properties) {
+    if (properties == NULL) {
+        return NULL;
+    }
+    if (properties->frozen) {
+        return celix_properties_retain(properties);
+    }
+    celix_properties_t* copy = celix_properties_copy(properties);
+    if (copy == NULL) {
+        return NULL;
+    }
+    copy->frozen = true;
+    return copy;
+}
+
+celix_status_t celix_properties_makeWritable(celix_properties_t** properties) {
+    celix_properties_t* props = *properties;
+    if (props == NULL || (!props->frozen && !celix_properties_isShared(props))) {
         return CELIX_SUCCESS;
     }
+    celix_properties_t* copy = celix_properties_copy(props);
+    if (copy == NULL) {
+        return CELIX_ENOMEM;
+    }
+    celix_properties_destroy(props);
+    *properties = copy;
+    return CELIX_SUCCESS;
+}
 
-    celix_autofree char* key = calloc(1, key_len);
-    celix_autofree char* value = calloc(1, value_len);
-    if (!key || !value) {
-        celix_err_pushf("Cannot allocate memory for key or value. Got error %i", errno);
+/**
+ * @brief Add a loaded entry to the properties set, without copying the key and value.
+ *
+ * The key and value must be part of the properties load buffer (or the static empty string).
+ */
+static celix_status_t celix_properties_assignLoadedEntry(celix_properties_t* props, char* key, char* value) {
+    celix_properties_entry_t* entry = celix_properties_createEntryWithNoCopy(props, value);
+    if (!entry) {
+        celix_err_push("Failed to create entry for property.");
         return CELIX_ENOMEM;
     }
+    celix_status_t status = celix_stringHashMap_put(props->map, key, entry);
+    if (status != CELIX_SUCCESS) {
+        celix_err_pushf("Failed to put entry for key %s in map.", key);
+        celix_properties_destroyEntry(props, entry);
+    }
+    return status;
+}
 
-    key[0] = '\0';
-    value[0] = '\0';
+/**
+ * @brief Parse a properties line in place and add the resulting entry to the properties set.
+ *
+ * The key and value are unescaped into the line itself, which is possible because unescaping never grows a string.
+ * The line must be part of the properties load buffer.
+ */
+static celix_status_t celix_properties_parseLineInPlace(char* line, celix_properties_t* props) {
+    bool precedingCharIsBackslash = false;
+    char* key = NULL;
+    char* value = NULL;
+    char* output = NULL; // start of the current output (key or value)
+    char* out = NULL;    // current write position, never ahead of the read position
 
-    while (line[linePos] != '\0') {
-        if (line[linePos] == ' ' || line[linePos] == '\t') {
+    for (char* c = line; *c != '\0'; ++c) {
+        if (*c == ' ' || *c == '\t') {
             if (output == NULL) {
                 // ignore
-                linePos += 1;
                 continue;
             }
         } else {
             if (output == NULL) {
-                output = key;
+                output = key = out = c;
             }
         }
-        if (line[linePos] == '=' || line[linePos] == ':' || line[linePos] == '#' || line[linePos] == '!') {
+        if (*c == '=' || *c == ':' || *c == '#' || *c == '!') {
             if (precedingCharIsBackslash) {
                 // escaped special character
-                output[outputPos++] = line[linePos];
-                celix_properties_updateBuffers(&key, &value, &output, outputPos, &key_len, &value_len);
+                *out++ = *c;
                 precedingCharIsBackslash = false;
             } else {
-                if (line[linePos] == '#' || line[linePos] == '!') {
-                    if (outputPos == 0) {
+                if (*c == '#' || *c == '!') {
+                    if (out == output) {
                         // comment line, ignore
                         return CELIX_SUCCESS;
                     } else {
-                        output[outputPos++] = line[linePos];
-                        celix_properties_updateBuffers(&key, &value, &output, outputPos, &key_len, &value_len);
+                        *out++ = *c;
                     }
                 } else {                   // = or :
                     if (output == value) { // already have a seperator
-                        output[outputPos++] = line[linePos];
-                        celix_properties_updateBuffers(&key, &value, &output, outputPos, &key_len, &value_len);
+                        *out++ = *c;
                     } else {
-                        output[outputPos++] = '\0';
-                        celix_properties_updateBuffers(&key, &value, &output, outputPos, &key_len, &value_len);
-                        output = value;
-                        outputPos = 0;
+                        *out = '\0';
+                        output = value = out = c + 1;
                     }
                 }
             }
-        } else if (line[linePos] == '\\') {
+        } else if (*c == '\\') {
             if (precedingCharIsBackslash) { // double backslash -> backslash
-                output[outputPos++] = '\\';
-                celix_properties_updateBuffers(&key, &value, &output, outputPos, &key_len, &value_len);
+                *out++ = '\\';
             }
             precedingCharIsBackslash = true;
         } else { // normal character
             precedingCharIsBackslash = false;
-            output[outputPos++] = line[linePos];
-            celix_properties_updateBuffers(&key, &value, &output, outputPos, &key_len, &value_len);
+            *out++ = *c;
         }
-        linePos += 1;
     }
     if (output != NULL) {
-        output[outputPos] = '\0';
+        *out = '\0';
+    }
+
+    key = key == NULL ? (char*)CELIX_PROPERTIES_EMPTY_STRVAL : celix_utils_trimInPlace(key);
+    value = value == NULL ? (char*)CELIX_PROPERTIES_EMPTY_STRVAL : celix_utils_trimInPlace(value);
+    return celix_properties_assignLoadedEntry(props, key, value);
+}
+
+/**
+ * @brief Take ownership of the '\0' terminated load buffer and parse its lines in place.
+ */
+static celix_status_t
+celix_properties_parseLoadBuffer(celix_properties_t* props, char* buffer, size_t size, bool mapped) {
+    assert(props->loadBuffer == NULL);
+    props->loadBuffer = buffer;
+    props->loadBufferSize = size;
+    props->loadBufferMapped = mapped;
+
+    char* savePtr = NULL;
+    char* line = strtok_r(buffer, "\n", &savePtr);
+    while (line != NULL) {
+        celix_status_t status = celix_properties_parseLineInPlace(line, props);
+        if (status != CELIX_SUCCESS) {
+            celix_err_pushf("Failed to parse line '%s'", line);
+            return status;
+        }
+        line = strtok_r(NULL, "\n", &savePtr);
+    }
+    return CELIX_SUCCESS;
+}
+
+/**
+ * @brief Load properties from a private, writable mapping of the file.
+ *
+ * Only used if the mapping is guaranteed to be '\0' terminated, i.e. if the file size is not a multiple of the page
+ * size (the remainder of the last page is zero filled).
+ */
+static celix_properties_t* celix_properties_loadMapped(int fd, size_t size) {
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    if (!props) {
+        return NULL;
+    }
+
+    char* buffer = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (buffer == MAP_FAILED) {
+        celix_err_pushf("Cannot mmap file. Got error %i", errno);
+        return NULL;
+    }
+    (void)madvise(buffer, size, MADV_SEQUENTIAL);
+
+    if (celix_properties_parseLoadBuffer(props, buffer, size, true) != CELIX_SUCCESS) {
+        return NULL;
     }
+    return celix_steal_ptr(props);
+}
 
-    return celix_properties_set(props, celix_utils_trimInPlace(key), celix_utils_trimInPlace(value));
+celix_properties_t* celix_properties_load(const char* filename) {
+    int fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        struct stat st;
+        long pageSize = sysconf(_SC_PAGESIZE);
+        bool mappable = fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && pageSize > 0 &&
+                        (st.st_size % pageSize) != 0;
+        if (mappable) {
+            celix_properties_t* props = celix_properties_loadMapped(fd, (size_t)st.st_size);
+            close(fd);
+            return props;
+        }
+        close(fd);
+    }
+
+    // not a (mappable) regular file, fallback to a stream
+    FILE* file = fopen(filename, "r");
+    if (file == NULL) {
+        celix_err_pushf("Cannot open file '%s'", filename);
+        return NULL;
+    }
+    celix_properties_t* props = celix_properties_loadWithStream(file);
+    fclose(file);
+    return props;
 }
 
 celix_properties_t* celix_properties_loadWithStream(FILE* file) {
@@ -487,17 +646,9 @@ celix_properties_t* celix_properties_loadWithStream(FILE* file) {
     }
     fileBuffer[fileSize] = '\0'; // ensure a '\0' at the end of the fileBuffer
 
-    char* savePtr = NULL;
-    char* line = strtok_r(fileBuffer, "\n", &savePtr);
-    while (line != NULL) {
-        celix_status_t status = celix_properties_parseLine(line, props);
-        if (status != CELIX_SUCCESS) {
-            celix_err_pushf("Failed to parse line '%s'", line);
-            return NULL;
-        }
-        line = strtok_r(NULL, "\n", &savePtr);
+    if (celix_properties_parseLoadBuffer(props, celix_steal_ptr(fileBuffer), fileSize, false) != CELIX_SUCCESS) {
+        return NULL;
     }
-
     return celix_steal_ptr(props);
 }
 
@@ -509,16 +660,9 @@ celix_properties_t* celix_properties_loadFromString(const char* input) {
         return NULL;
     }
 
-    char* line = NULL;
-    char* saveLinePointer = NULL;
-    line = strtok_r(in, "\n", &saveLinePointer);
-    while (line != NULL) {
-        celix_status_t status = celix_properties_parseLine(line, props);
-        if (status != CELIX_SUCCESS) {
-            celix_err_pushf("Failed to parse line '%s'", line);
-            return NULL;
-        }
-        line = strtok_r(NULL, "\n", &saveLinePointer);
+    size_t size = strlen(in);
+    if (celix_properties_parseLoadBuffer(props, celix_steal_ptr(in), size, false) != CELIX_SUCCESS) {
+        return NULL;
     }
     return celix_steal_ptr(props);
 }
@@ -663,6 +807,11 @@ celix_status_t celix_properties_assign(celix_properties_t* properties, char* key
             free(value);
             return CELIX_ILLEGAL_ARGUMENT;
         }
+        if (!celix_properties_isWritable(properties, key)) {
+            free(key);
+            free(value);
+            return CELIX_ILLEGAL_STATE;
+        }
         celix_properties_entry_t* entry = celix_properties_createEntryWithNoCopy(properties, value);
         if (!entry) {
             celix_err_push("Failed to create entry for property.");
@@ -732,7 +881,7 @@ static bool celix_properties_entryEquals(const celix_properties_entry_t* entry1,
 }
 
 void celix_properties_unset(celix_properties_t* properties, const char* key) {
-    if (properties != NULL) {
+    if (properties != NULL && celix_properties_isWritable(properties, key)) {
         celix_stringHashMap_remove(properties->map, key);
     }
 }
@@ -762,6 +911,9 @@ celix_status_t celix_properties_setString(celix_properties_t* properties,
     if  (!properties) {
         return CELIX_SUCCESS; // silently ignore NULL properties
     }
+    if (key != NULL && !celix_properties_isWritable(properties, key)) {
+        return CELIX_ILLEGAL_STATE;
+    }
     char* copy = celix_properties_createString(properties, value);
     if (!copy) {
         return CELIX_ENOMEM;
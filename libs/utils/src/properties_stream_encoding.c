@@ -0,0 +1,1347 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * @file properties_stream_encoding.c
+ * @brief Streaming JSON encoder and decoder for celix_properties_t.
+ *
+ * In contrast to properties_encoding.c, no intermediate (jansson) JSON document is created. The encoder writes the
+ * JSON representation directly to the output stream and the decoder tokenizes the JSON input and directly updates
+ * the resulting properties object.
+ */
+
+#include "celix_properties.h"
+
+#include "celix_array_list.h"
+#include "celix_err.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_string_hash_map.h"
+#include "celix_version.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <locale.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CELIX_PROPERTIES_JSONPATH_SEPARATOR '.'
+#define CELIX_PROPERTIES_JSON_INDENT 2
+#define CELIX_PROPERTIES_JSON_MAX_DEPTH 2048
+#define CELIX_PROPERTIES_JSON_INITIAL_BUFFER_SIZE 4096
+
+/**
+ * @brief Returns the length of the valid UTF-8 sequence at the start of str or 0 if the sequence is not valid UTF-8.
+ *
+ * Overlong encodings, surrogates and code points above U+10FFFF are rejected.
+ */
+static size_t celix_properties_utf8SequenceLength(const unsigned char* str, const unsigned char* end) {
+    uint32_t codePoint;
+    size_t len;
+    if (str[0] < 0x80) {
+        return 1;
+    } else if (str[0] >= 0xC2 && str[0] <= 0xDF) {
+        len = 2;
+        codePoint = str[0] & 0x1F;
+    } else if (str[0] >= 0xE0 && str[0] <= 0xEF) {
+        len = 3;
+        codePoint = str[0] & 0x0F;
+    } else if (str[0] >= 0xF0 && str[0] <= 0xF4) {
+        len = 4;
+        codePoint = str[0] & 0x07;
+    } else {
+        return 0;
+    }
+    if ((size_t)(end - str) < len) {
+        return 0;
+    }
+    for (size_t i = 1; i < len; ++i) {
+        if ((str[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        codePoint = (codePoint << 6) | (str[i] & 0x3F);
+    }
+    if (len == 3 && (codePoint < 0x800 || (codePoint >= 0xD800 && codePoint <= 0xDFFF))) {
+        return 0;
+    } else if (len == 4 && (codePoint < 0x10000 || codePoint > 0x10FFFF)) {
+        return 0;
+    }
+    return len;
+}
+
+static bool celix_properties_isVersionJsonString(const char* str, size_t len) {
+    return len > 8 && strncmp(str, "version<", 8) == 0 && str[len - 1] == '>';
+}
+
+/**********************************************************************************************************************
+ * Encoding
+ **********************************************************************************************************************/
+
+typedef struct celix_properties_json_writer {
+    FILE* stream;
+    bool pretty;
+    int depth;  // the number of open JSON objects and arrays
+    bool first; // whether no element is written yet to the current JSON object or array
+    bool failed;
+} celix_properties_json_writer_t;
+
+typedef struct celix_properties_json_entry {
+    const char* key;
+    celix_properties_entry_t entry;
+} celix_properties_json_entry_t;
+
+static void celix_properties_writeRaw(celix_properties_json_writer_t* writer, const char* data, size_t len) {
+    if (!writer->failed && len > 0 && fwrite(data, 1, len, writer->stream) != len) {
+        writer->failed = true;
+    }
+}
+
+static void celix_properties_writeChar(celix_properties_json_writer_t* writer, char c) {
+    if (!writer->failed && fputc(c, writer->stream) == EOF) {
+        writer->failed = true;
+    }
+}
+
+static void celix_properties_writeNewline(celix_properties_json_writer_t* writer) {
+    static const char spaces[] = "                                ";
+    celix_properties_writeChar(writer, '\n');
+    size_t indent = (size_t)writer->depth * CELIX_PROPERTIES_JSON_INDENT;
+    while (indent > 0) {
+        size_t len = indent < sizeof(spaces) - 1 ? indent : sizeof(spaces) - 1;
+        celix_properties_writeRaw(writer, spaces, len);
+        indent -= len;
+    }
+}
+
+static void celix_properties_writeOpen(celix_properties_json_writer_t* writer, char open) {
+    celix_properties_writeChar(writer, open);
+    writer->depth += 1;
+    writer->first = true;
+}
+
+static void celix_properties_writeClose(celix_properties_json_writer_t* writer, char close) {
+    writer->depth -= 1;
+    if (writer->pretty && !writer->first) {
+        celix_properties_writeNewline(writer);
+    }
+    celix_properties_writeChar(writer, close);
+    writer->first = false;
+}
+
+static void celix_properties_writeElementSeparator(celix_properties_json_writer_t* writer) {
+    if (!writer->first) {
+        celix_properties_writeChar(writer, ',');
+    }
+    if (writer->pretty) {
+        celix_properties_writeNewline(writer);
+    }
+    writer->first = false;
+}
+
+/**
+ * @brief Writes a JSON string, escaping the characters which cannot be part of a JSON string.
+ * @return false if the string is not valid UTF-8.
+ */
+static bool celix_properties_writeString(celix_properties_json_writer_t* writer, const char* str, size_t len) {
+    const unsigned char* cur = (const unsigned char*)str;
+    const unsigned char* end = cur + len;
+    const unsigned char* run = cur;
+    celix_properties_writeChar(writer, '"');
+    while (cur < end) {
+        if (*cur >= 0x20 && *cur < 0x80 && *cur != '"' && *cur != '\\') {
+            cur += 1;
+            continue;
+        } else if (*cur >= 0x80) {
+            size_t seqLen = celix_properties_utf8SequenceLength(cur, end);
+            if (seqLen == 0) {
+                return false;
+            }
+            cur += seqLen;
+            continue;
+        }
+
+        celix_properties_writeRaw(writer, (const char*)run, cur - run);
+        char escaped[8];
+        switch (*cur) {
+        case '"':
+            celix_properties_writeRaw(writer, "\\\"", 2);
+            break;
+        case '\\':
+            celix_properties_writeRaw(writer, "\\\\", 2);
+            break;
+        case '\b':
+            celix_properties_writeRaw(writer, "\\b", 2);
+            break;
+        case '\f':
+            celix_properties_writeRaw(writer, "\\f", 2);
+            break;
+        case '\n':
+            celix_properties_writeRaw(writer, "\\n", 2);
+            break;
+        case '\r':
+            celix_properties_writeRaw(writer, "\\r", 2);
+            break;
+        case '\t':
+            celix_properties_writeRaw(writer, "\\t", 2);
+            break;
+        default:
+            snprintf(escaped, sizeof(escaped), "\\u%04X", *cur);
+            celix_properties_writeRaw(writer, escaped, 6);
+            break;
+        }
+        cur += 1;
+        run = cur;
+    }
+    celix_properties_writeRaw(writer, (const char*)run, cur - run);
+    celix_properties_writeChar(writer, '"');
+    return true;
+}
+
+static celix_status_t
+celix_properties_writeKey(celix_properties_json_writer_t* writer, const char* key, const char* name, size_t len) {
+    celix_properties_writeElementSeparator(writer);
+    if (!celix_properties_writeString(writer, name, len)) {
+        celix_err_pushf("Invalid UTF-8 in key '%s'.", key);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (writer->pretty) {
+        celix_properties_writeRaw(writer, ": ", 2);
+    } else {
+        celix_properties_writeChar(writer, ':');
+    }
+    return CELIX_SUCCESS;
+}
+
+static void celix_properties_writeLong(celix_properties_json_writer_t* writer, long value) {
+    char buf[32];
+    int len = snprintf(buf, sizeof(buf), "%li", value);
+    celix_properties_writeRaw(writer, buf, (size_t)len);
+}
+
+/**
+ * @brief Writes a double the same way as jansson does; with 17 significant digits, always with a fraction or
+ * exponent and without a '+' sign or leading zeros in the exponent.
+ */
+static void celix_properties_writeDouble(celix_properties_json_writer_t* writer, double value) {
+    char buf[40];
+    int len = snprintf(buf, sizeof(buf), "%.17g", value);
+    char decimalPoint = localeconv()->decimal_point[0];
+    if (decimalPoint != '.') {
+        char* pos = strchr(buf, decimalPoint);
+        if (pos) {
+            *pos = '.';
+        }
+    }
+    if (!strchr(buf, '.') && !strchr(buf, 'e')) {
+        buf[len++] = '.';
+        buf[len++] = '0';
+        buf[len] = '\0';
+    }
+    char* exponent = strchr(buf, 'e');
+    if (exponent) {
+        char* start = exponent + 1;
+        char* digits = start + 1;
+        if (*start == '-') {
+            start += 1;
+        }
+        while (*digits == '0') {
+            digits += 1;
+        }
+        memmove(start, digits, strlen(digits) + 1);
+        len = (int)strlen(buf);
+    }
+    celix_properties_writeRaw(writer, buf, (size_t)len);
+}
+
+static void celix_properties_writeBool(celix_properties_json_writer_t* writer, bool value) {
+    if (value) {
+        celix_properties_writeRaw(writer, "true", 4);
+    } else {
+        celix_properties_writeRaw(writer, "false", 5);
+    }
+}
+
+static celix_status_t celix_properties_writeVersion(celix_properties_json_writer_t* writer,
+                                                    const celix_version_t* version) {
+    char buf[64];
+    celix_autofree char* allocated = NULL;
+    const char* str = buf;
+    if (!celix_version_fillString(version, buf, sizeof(buf))) {
+        allocated = celix_version_toString(version);
+        if (!allocated) {
+            celix_err_push("Failed to create version string.");
+            return ENOMEM;
+        }
+        str = allocated;
+    }
+    // note the version qualifier can only contain alphanumeric characters, '-' and '_'; so no escaping is needed.
+    celix_properties_writeRaw(writer, "\"version<", 9);
+    celix_properties_writeRaw(writer, str, strlen(str));
+    celix_properties_writeRaw(writer, ">\"", 2);
+    return CELIX_SUCCESS;
+}
+
+/**
+ * @brief Checks whether the entry can be encoded to JSON.
+ *
+ * Entries with a NaN or Inf value and (effectively) empty arrays cannot be encoded; based on the flags these are
+ * skipped or result in an error.
+ */
+static celix_status_t celix_properties_checkEncodable(const char* key,
+                                                      const celix_properties_entry_t* entry,
+                                                      int flags,
+                                                      bool* skip) {
+    *skip = false;
+    if (entry->valueType == CELIX_PROPERTIES_VALUE_TYPE_DOUBLE &&
+        (isnan(entry->typed.doubleValue) || isinf(entry->typed.doubleValue))) {
+        if (flags & CELIX_PROPERTIES_ENCODE_ERROR_ON_NAN_INF) {
+            celix_err_pushf("Invalid NaN or Inf in key '%s'.", key);
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+        *skip = true;
+    } else if (entry->valueType == CELIX_PROPERTIES_VALUE_TYPE_ARRAY_LIST) {
+        const celix_array_list_t* list = entry->typed.arrayValue;
+        int size = celix_arrayList_size(list);
+        int encodable = size;
+        if (celix_arrayList_getElementType(list) == CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE) {
+            for (int i = 0; i < size; ++i) {
+                double value = celix_arrayList_getDouble(list, i);
+                if (isnan(value) || isinf(value)) {
+                    if (flags & CELIX_PROPERTIES_ENCODE_ERROR_ON_NAN_INF) {
+                        celix_err_push("Invalid NaN or Inf.");
+                        celix_err_pushf("Failed to encode array element(%d) for key %s.", i, key);
+                        return CELIX_ILLEGAL_ARGUMENT;
+                    }
+                    encodable -= 1;
+                }
+            }
+        }
+        if (encodable == 0) {
+            if (flags & CELIX_PROPERTIES_ENCODE_ERROR_ON_EMPTY_ARRAYS) {
+                celix_err_pushf("Invalid empty array for key %s.", key);
+                return CELIX_ILLEGAL_ARGUMENT;
+            }
+            *skip = true;
+        }
+    }
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_properties_writeArray(celix_properties_json_writer_t* writer,
+                                                  const char* key,
+                                                  const celix_array_list_t* list) {
+    celix_array_list_element_type_t elType = celix_arrayList_getElementType(list);
+    int size = celix_arrayList_size(list);
+    celix_properties_writeOpen(writer, '[');
+    for (int i = 0; i < size; ++i) {
+        celix_array_list_entry_t entry = celix_arrayList_getEntry(list, i);
+        if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE && (isnan(entry.doubleVal) || isinf(entry.doubleVal))) {
+            continue; // ignore NaN and Inf
+        }
+        celix_properties_writeElementSeparator(writer);
+        celix_status_t status = CELIX_SUCCESS;
+        switch (elType) {
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING:
+            if (!celix_properties_writeString(writer, entry.stringVal, strlen(entry.stringVal))) {
+                celix_err_pushf("Invalid UTF-8 in array element(%d) for key %s.", i, key);
+                status = CELIX_ILLEGAL_ARGUMENT;
+            }
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG:
+            celix_properties_writeLong(writer, entry.longVal);
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE:
+            celix_properties_writeDouble(writer, entry.doubleVal);
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL:
+            celix_properties_writeBool(writer, entry.boolVal);
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION:
+            status = celix_properties_writeVersion(writer, entry.versionVal);
+            break;
+        default:
+            // LCOV_EXCL_START
+            celix_err_pushf("Invalid array list element type %d.", elType);
+            status = CELIX_ILLEGAL_ARGUMENT;
+            break;
+            // LCOV_EXCL_STOP
+        }
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+    celix_properties_writeClose(writer, ']');
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_properties_writeValue(celix_properties_json_writer_t* writer,
+                                                  const char* key,
+                                                  const celix_properties_entry_t* entry) {
+    switch (entry->valueType) {
+    case CELIX_PROPERTIES_VALUE_TYPE_STRING:
+        if (!celix_properties_writeString(writer, entry->value, strlen(entry->value))) {
+            celix_err_pushf("Invalid UTF-8 in value for key '%s'.", key);
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+        return CELIX_SUCCESS;
+    case CELIX_PROPERTIES_VALUE_TYPE_LONG:
+        celix_properties_writeLong(writer, entry->typed.longValue);
+        return CELIX_SUCCESS;
+    case CELIX_PROPERTIES_VALUE_TYPE_DOUBLE:
+        celix_properties_writeDouble(writer, entry->typed.doubleValue);
+        return CELIX_SUCCESS;
+    case CELIX_PROPERTIES_VALUE_TYPE_BOOL:
+        celix_properties_writeBool(writer, entry->typed.boolValue);
+        return CELIX_SUCCESS;
+    case CELIX_PROPERTIES_VALUE_TYPE_VERSION:
+        return celix_properties_writeVersion(writer, entry->typed.versionValue);
+    case CELIX_PROPERTIES_VALUE_TYPE_ARRAY_LIST:
+        return celix_properties_writeArray(writer, key, entry->typed.arrayValue);
+    default:
+        // LCOV_EXCL_START
+        celix_err_pushf("Unexpected properties entry type %d.", entry->valueType);
+        return CELIX_ILLEGAL_ARGUMENT;
+        // LCOV_EXCL_STOP
+    }
+}
+
+static celix_status_t celix_properties_encodeFlat(celix_properties_json_writer_t* writer,
+                                                  const celix_properties_t* properties,
+                                                  int flags) {
+    CELIX_PROPERTIES_ITERATE(properties, iter) {
+        bool skip;
+        celix_status_t status = celix_properties_checkEncodable(iter.key, &iter.entry, flags, &skip);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        } else if (skip) {
+            continue;
+        }
+        status = celix_properties_writeKey(writer, iter.key, iter.key, strlen(iter.key));
+        status = CELIX_DO_IF(status, celix_properties_writeValue(writer, iter.key, &iter.entry));
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+    return CELIX_SUCCESS;
+}
+
+/**
+ * @brief Compares properties keys so that keys are ordered per JSON path segment.
+ *
+ * The JSON path separator is ordered before all other characters, so that all keys nested in the same JSON object
+ * are consecutive and directly follow the key (if any) which collides with the JSON object.
+ */
+static int celix_properties_compareJsonPaths(const void* a, const void* b) {
+    const unsigned char* keyA = (const unsigned char*)((const celix_properties_json_entry_t*)a)->key;
+    const unsigned char* keyB = (const unsigned char*)((const celix_properties_json_entry_t*)b)->key;
+    while (*keyA != '\0' && *keyA == *keyB) {
+        keyA += 1;
+        keyB += 1;
+    }
+    int rankA = *keyA == CELIX_PROPERTIES_JSONPATH_SEPARATOR ? 1 : (*keyA == '\0' ? 0 : *keyA + 1);
+    int rankB = *keyB == CELIX_PROPERTIES_JSONPATH_SEPARATOR ? 1 : (*keyB == '\0' ? 0 : *keyB + 1);
+    return rankA - rankB;
+}
+
+static celix_status_t celix_properties_encodeNested(celix_properties_json_writer_t* writer,
+                                                    const celix_properties_t* properties,
+                                                    int flags) {
+    size_t size = celix_properties_size(properties);
+    if (size == 0) {
+        return CELIX_SUCCESS;
+    }
+    celix_autofree celix_properties_json_entry_t* entries = malloc(size * sizeof(*entries));
+    if (!entries) {
+        celix_err_push("Failed to allocate entries array.");
+        return ENOMEM;
+    }
+    size_t count = 0;
+    size_t maxDepth = 0;
+    CELIX_PROPERTIES_ITERATE(properties, iter) {
+        bool skip;
+        celix_status_t status = celix_properties_checkEncodable(iter.key, &iter.entry, flags, &skip);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        } else if (skip) {
+            continue;
+        }
+        size_t depth = 0;
+        for (const char* c = strchr(iter.key, CELIX_PROPERTIES_JSONPATH_SEPARATOR); c;
+             c = strchr(c + 1, CELIX_PROPERTIES_JSONPATH_SEPARATOR)) {
+            depth += 1;
+        }
+        maxDepth = depth > maxDepth ? depth : maxDepth;
+        entries[count].key = iter.key;
+        entries[count].entry = iter.entry;
+        count += 1;
+    }
+    qsort(entries, count, sizeof(*entries), celix_properties_compareJsonPaths);
+
+    // openLengths[i] is the length of the key prefix which corresponds to the (i+1)th open nested JSON object.
+    celix_autofree size_t* openLengths = malloc((maxDepth + 1) * sizeof(*openLengths));
+    if (!openLengths) {
+        celix_err_push("Failed to allocate nesting array.");
+        return ENOMEM;
+    }
+    size_t openDepth = 0;
+    const char* openKey = NULL;
+    const char* lastLeafKey = NULL;
+    size_t lastLeafLen = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const char* key = entries[i].key;
+        if (lastLeafKey && strncmp(key, lastLeafKey, lastLeafLen) == 0 &&
+            key[lastLeafLen] == CELIX_PROPERTIES_JSONPATH_SEPARATOR) {
+            if (flags & CELIX_PROPERTIES_ENCODE_ERROR_ON_COLLISIONS) {
+                celix_err_pushf("Invalid key collision. Key '%s' already exists.", lastLeafKey);
+                return CELIX_ILLEGAL_ARGUMENT;
+            }
+            continue; // the already written value wins
+        }
+
+        size_t commonDepth = openDepth;
+        while (commonDepth > 0 && (strncmp(key, openKey, openLengths[commonDepth - 1]) != 0 ||
+                                   key[openLengths[commonDepth - 1]] != CELIX_PROPERTIES_JSONPATH_SEPARATOR)) {
+            commonDepth -= 1;
+        }
+        while (openDepth > commonDepth) {
+            celix_properties_writeClose(writer, '}');
+            openDepth -= 1;
+        }
+
+        const char* name = commonDepth == 0 ? key : key + openLengths[commonDepth - 1] + 1;
+        const char* separator = strchr(name, CELIX_PROPERTIES_JSONPATH_SEPARATOR);
+        while (separator) {
+            celix_status_t status = celix_properties_writeKey(writer, key, name, separator - name);
+            if (status != CELIX_SUCCESS) {
+                return status;
+            }
+            celix_properties_writeOpen(writer, '{');
+            openLengths[openDepth++] = separator - key;
+            name = separator + 1;
+            separator = strchr(name, CELIX_PROPERTIES_JSONPATH_SEPARATOR);
+        }
+        openKey = key;
+
+        celix_status_t status = celix_properties_writeKey(writer, key, name, strlen(name));
+        status = CELIX_DO_IF(status, celix_properties_writeValue(writer, key, &entries[i].entry));
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        lastLeafKey = key;
+        lastLeafLen = strlen(key);
+    }
+    while (openDepth > 0) {
+        celix_properties_writeClose(writer, '}');
+        openDepth -= 1;
+    }
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_properties_encodeToStream(const celix_properties_t* properties, FILE* stream, int encodeFlags) {
+    celix_properties_json_writer_t writer;
+    writer.stream = stream;
+    writer.pretty = (encodeFlags & CELIX_PROPERTIES_ENCODE_PRETTY) != 0;
+    writer.depth = 0;
+    writer.first = true;
+    writer.failed = false;
+
+    celix_properties_writeOpen(&writer, '{');
+    celix_status_t status;
+    if (encodeFlags & CELIX_PROPERTIES_ENCODE_NESTED_STYLE && !(encodeFlags & CELIX_PROPERTIES_ENCODE_FLAT_STYLE)) {
+        status = celix_properties_encodeNested(&writer, properties, encodeFlags);
+    } else {
+        // no encoding flags set, default to flat
+        status = celix_properties_encodeFlat(&writer, properties, encodeFlags);
+    }
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    celix_properties_writeClose(&writer, '}');
+
+    if (writer.failed) {
+        celix_err_push("Failed to write json to stream.");
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+    return CELIX_SUCCESS;
+}
+
+/**********************************************************************************************************************
+ * Decoding
+ **********************************************************************************************************************/
+
+typedef struct celix_properties_json_reader {
+    const char* input;
+    const char* cur;
+    const char* end;
+    int flags;
+    int depth;
+    celix_properties_t* props;
+    char* key; // the properties key of the current JSON value; the JSON path joined with the JSON path separator
+    size_t keyLen;
+    size_t keyCap;
+    char* str; // the current decoded JSON string or number
+    size_t strLen;
+    size_t strCap;
+} celix_properties_json_reader_t;
+
+static celix_status_t celix_properties_readerError(const celix_properties_json_reader_t* reader, const char* msg) {
+    int line = 1;
+    int column = 1;
+    for (const char* c = reader->input; c < reader->cur; ++c) {
+        if (*c == '\n') {
+            line += 1;
+            column = 1;
+        } else {
+            column += 1;
+        }
+    }
+    celix_err_pushf("Failed to parse json at line %i, column %i: %s.", line, column, msg);
+    return CELIX_ILLEGAL_ARGUMENT;
+}
+
+static void celix_properties_skipWhitespace(celix_properties_json_reader_t* reader) {
+    while (reader->cur < reader->end &&
+           (*reader->cur == ' ' || *reader->cur == '\t' || *reader->cur == '\n' || *reader->cur == '\r')) {
+        reader->cur += 1;
+    }
+}
+
+static bool celix_properties_peek(const celix_properties_json_reader_t* reader, char c) {
+    return reader->cur < reader->end && *reader->cur == c;
+}
+
+static celix_status_t celix_properties_reserve(char** buf, size_t* cap, size_t needed) {
+    if (needed <= *cap) {
+        return CELIX_SUCCESS;
+    }
+    size_t newCap = *cap == 0 ? 64 : *cap;
+    while (newCap < needed) {
+        newCap *= 2;
+    }
+    char* newBuf = realloc(*buf, newCap);
+    if (!newBuf) {
+        celix_err_push("Failed to allocate json decode buffer.");
+        return ENOMEM;
+    }
+    *buf = newBuf;
+    *cap = newCap;
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_properties_appendToString(celix_properties_json_reader_t* reader, const char* data, size_t len) {
+    celix_status_t status = celix_properties_reserve(&reader->str, &reader->strCap, reader->strLen + len + 1);
+    if (status == CELIX_SUCCESS) {
+        memcpy(reader->str + reader->strLen, data, len);
+        reader->strLen += len;
+        reader->str[reader->strLen] = '\0';
+    }
+    return status;
+}
+
+static bool celix_properties_readHex4(celix_properties_json_reader_t* reader, uint32_t* out) {
+    if (reader->end - reader->cur < 4) {
+        return false;
+    }
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = reader->cur[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9') {
+            value |= (uint32_t)(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            value |= (uint32_t)(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            value |= (uint32_t)(c - 'A' + 10);
+        } else {
+            return false;
+        }
+    }
+    reader->cur += 4;
+    *out = value;
+    return true;
+}
+
+static celix_status_t celix_properties_readUnicodeEscape(celix_properties_json_reader_t* reader) {
+    // precondition: reader->cur points after "\u"
+    uint32_t codePoint;
+    if (!celix_properties_readHex4(reader, &codePoint)) {
+        return celix_properties_readerError(reader, "invalid \\u escape");
+    }
+    if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+        return celix_properties_readerError(reader, "invalid Unicode low surrogate");
+    } else if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+        uint32_t low;
+        if (reader->end - reader->cur < 2 || reader->cur[0] != '\\' || reader->cur[1] != 'u') {
+            return celix_properties_readerError(reader, "missing Unicode low surrogate");
+        }
+        reader->cur += 2;
+        if (!celix_properties_readHex4(reader, &low) || low < 0xDC00 || low > 0xDFFF) {
+            return celix_properties_readerError(reader, "invalid Unicode low surrogate");
+        }
+        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+    } else if (codePoint == 0) {
+        return celix_properties_readerError(reader, "\\u0000 is not allowed");
+    }
+
+    char utf8[4];
+    size_t len;
+    if (codePoint < 0x80) {
+        utf8[0] = (char)codePoint;
+        len = 1;
+    } else if (codePoint < 0x800) {
+        utf8[0] = (char)(0xC0 | (codePoint >> 6));
+        utf8[1] = (char)(0x80 | (codePoint & 0x3F));
+        len = 2;
+    } else if (codePoint < 0x10000) {
+        utf8[0] = (char)(0xE0 | (codePoint >> 12));
+        utf8[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        utf8[2] = (char)(0x80 | (codePoint & 0x3F));
+        len = 3;
+    } else {
+        utf8[0] = (char)(0xF0 | (codePoint >> 18));
+        utf8[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+        utf8[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        utf8[3] = (char)(0x80 | (codePoint & 0x3F));
+        len = 4;
+    }
+    return celix_properties_appendToString(reader, utf8, len);
+}
+
+/**
+ * @brief Reads a JSON string and stores the decoded (NUL-terminated) string in reader->str.
+ */
+static celix_status_t celix_properties_readString(celix_properties_json_reader_t* reader) {
+    // precondition: reader->cur points to '"'
+    reader->cur += 1;
+    reader->strLen = 0;
+    celix_status_t status = celix_properties_appendToString(reader, "", 0);
+    while (status == CELIX_SUCCESS) {
+        const char* run = reader->cur;
+        while (reader->cur < reader->end && (unsigned char)*reader->cur >= 0x20 &&
+               (unsigned char)*reader->cur < 0x80 && *reader->cur != '"' && *reader->cur != '\\') {
+            reader->cur += 1;
+        }
+        status = celix_properties_appendToString(reader, run, reader->cur - run);
+        if (status != CELIX_SUCCESS) {
+            break;
+        } else if (reader->cur >= reader->end) {
+            return celix_properties_readerError(reader, "premature end of input in string");
+        }
+
+        unsigned char c = (unsigned char)*reader->cur;
+        if (c == '"') {
+            reader->cur += 1;
+            return CELIX_SUCCESS;
+        } else if (c < 0x20) {
+            return celix_properties_readerError(reader, "control character in string");
+        } else if (c >= 0x80) {
+            size_t len = celix_properties_utf8SequenceLength((const unsigned char*)reader->cur,
+                                                             (const unsigned char*)reader->end);
+            if (len == 0) {
+                return celix_properties_readerError(reader, "invalid UTF-8 in string");
+            }
+            status = celix_properties_appendToString(reader, reader->cur, len);
+            reader->cur += len;
+            continue;
+        }
+
+        // escape sequence
+        if (reader->end - reader->cur < 2) {
+            return celix_properties_readerError(reader, "premature end of input in string");
+        }
+        char escaped = reader->cur[1];
+        reader->cur += 2;
+        switch (escaped) {
+        case '"':
+        case '\\':
+        case '/':
+            status = celix_properties_appendToString(reader, &escaped, 1);
+            break;
+        case 'b':
+            status = celix_properties_appendToString(reader, "\b", 1);
+            break;
+        case 'f':
+            status = celix_properties_appendToString(reader, "\f", 1);
+            break;
+        case 'n':
+            status = celix_properties_appendToString(reader, "\n", 1);
+            break;
+        case 'r':
+            status = celix_properties_appendToString(reader, "\r", 1);
+            break;
+        case 't':
+            status = celix_properties_appendToString(reader, "\t", 1);
+            break;
+        case 'u':
+            status = celix_properties_readUnicodeEscape(reader);
+            break;
+        default:
+            reader->cur -= 2;
+            return celix_properties_readerError(reader, "invalid escape");
+        }
+    }
+    return status;
+}
+
+static celix_status_t celix_properties_readLiteral(celix_properties_json_reader_t* reader, const char* literal) {
+    size_t len = strlen(literal);
+    if ((size_t)(reader->end - reader->cur) < len || strncmp(reader->cur, literal, len) != 0) {
+        return celix_properties_readerError(reader, "invalid token");
+    }
+    reader->cur += len;
+    return CELIX_SUCCESS;
+}
+
+static bool celix_properties_isDigit(const celix_properties_json_reader_t* reader) {
+    return reader->cur < reader->end && *reader->cur >= '0' && *reader->cur <= '9';
+}
+
+/**
+ * @brief Reads a JSON number. Numbers with a fraction or exponent are decoded as double, others as long.
+ */
+static celix_status_t
+celix_properties_readNumber(celix_properties_json_reader_t* reader, bool* isReal, long* longValue, double* doubleValue) {
+    const char* start = reader->cur;
+    *isReal = false;
+    if (celix_properties_peek(reader, '-')) {
+        reader->cur += 1;
+    }
+    if (celix_properties_peek(reader, '0')) {
+        reader->cur += 1;
+    } else if (celix_properties_isDigit(reader)) {
+        while (celix_properties_isDigit(reader)) {
+            reader->cur += 1;
+        }
+    } else {
+        return celix_properties_readerError(reader, "invalid token");
+    }
+    if (celix_properties_peek(reader, '.')) {
+        *isReal = true;
+        reader->cur += 1;
+        if (!celix_properties_isDigit(reader)) {
+            return celix_properties_readerError(reader, "invalid number");
+        }
+        while (celix_properties_isDigit(reader)) {
+            reader->cur += 1;
+        }
+    }
+    if (celix_properties_peek(reader, 'e') || celix_properties_peek(reader, 'E')) {
+        *isReal = true;
+        reader->cur += 1;
+        if (celix_properties_peek(reader, '+') || celix_properties_peek(reader, '-')) {
+            reader->cur += 1;
+        }
+        if (!celix_properties_isDigit(reader)) {
+            return celix_properties_readerError(reader, "invalid number");
+        }
+        while (celix_properties_isDigit(reader)) {
+            reader->cur += 1;
+        }
+    }
+    if (celix_properties_isDigit(reader)) {
+        return celix_properties_readerError(reader, "invalid number");
+    }
+
+    // note the input is not NUL-terminated, so the number is copied before it is converted.
+    reader->strLen = 0;
+    celix_status_t status = celix_properties_appendToString(reader, start, reader->cur - start);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    errno = 0;
+    if (*isReal) {
+        char decimalPoint = localeconv()->decimal_point[0];
+        char* pos = decimalPoint != '.' ? strchr(reader->str, '.') : NULL;
+        if (pos) {
+            *pos = decimalPoint;
+        }
+        *doubleValue = strtod(reader->str, NULL);
+        if (errno == ERANGE && (*doubleValue == HUGE_VAL || *doubleValue == -HUGE_VAL)) {
+            return celix_properties_readerError(reader, "real number overflow");
+        }
+    } else {
+        *longValue = strtol(reader->str, NULL, 10);
+        if (errno == ERANGE) {
+            return celix_properties_readerError(reader, "too big integer");
+        }
+    }
+    return CELIX_SUCCESS;
+}
+
+/**
+ * @brief Reads and validates a JSON value without decoding it.
+ */
+static celix_status_t celix_properties_skipValue(celix_properties_json_reader_t* reader) {
+    if (reader->cur >= reader->end) {
+        return celix_properties_readerError(reader, "premature end of input");
+    }
+    char c = *reader->cur;
+    if (c == '"') {
+        return celix_properties_readString(reader);
+    } else if (c == 't') {
+        return celix_properties_readLiteral(reader, "true");
+    } else if (c == 'f') {
+        return celix_properties_readLiteral(reader, "false");
+    } else if (c == 'n') {
+        return celix_properties_readLiteral(reader, "null");
+    } else if (c != '[' && c != '{') {
+        bool isReal;
+        long longValue;
+        double doubleValue;
+        return celix_properties_readNumber(reader, &isReal, &longValue, &doubleValue);
+    }
+
+    char close = c == '[' ? ']' : '}';
+    if (++reader->depth > CELIX_PROPERTIES_JSON_MAX_DEPTH) {
+        return celix_properties_readerError(reader, "maximum parsing depth reached");
+    }
+    reader->cur += 1;
+    celix_properties_skipWhitespace(reader);
+    if (celix_properties_peek(reader, close)) {
+        reader->cur += 1;
+        reader->depth -= 1;
+        return CELIX_SUCCESS;
+    }
+    for (;;) {
+        celix_status_t status;
+        celix_properties_skipWhitespace(reader);
+        if (close == '}') {
+            if (!celix_properties_peek(reader, '"')) {
+                return celix_properties_readerError(reader, "string or '}' expected");
+            }
+            status = celix_properties_readString(reader);
+            if (status != CELIX_SUCCESS) {
+                return status;
+            }
+            celix_properties_skipWhitespace(reader);
+            if (!celix_properties_peek(reader, ':')) {
+                return celix_properties_readerError(reader, "':' expected");
+            }
+            reader->cur += 1;
+            celix_properties_skipWhitespace(reader);
+        }
+        status = celix_properties_skipValue(reader);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        celix_properties_skipWhitespace(reader);
+        if (celix_properties_peek(reader, ',')) {
+            reader->cur += 1;
+        } else if (celix_properties_peek(reader, close)) {
+            reader->cur += 1;
+            reader->depth -= 1;
+            return CELIX_SUCCESS;
+        } else {
+            return celix_properties_readerError(reader, close == ']' ? "']' or ',' expected" : "'}' or ',' expected");
+        }
+    }
+}
+
+static celix_status_t celix_properties_parseVersionString(celix_properties_json_reader_t* reader,
+                                                          celix_version_t** out) {
+    // precondition: reader->str is a version string ("version<...>"); strip the prefix and suffix in place.
+    reader->str[reader->strLen - 1] = '\0';
+    celix_status_t status = celix_version_parse(reader->str + 8, out);
+    if (status != CELIX_SUCCESS) {
+        celix_err_push("Failed to parse version string.");
+    }
+    return status;
+}
+
+static celix_status_t celix_properties_promoteToDoubleArray(celix_array_list_t** list) {
+    celix_autoptr(celix_array_list_t) doubles = celix_arrayList_createDoubleArray();
+    if (!doubles) {
+        return ENOMEM;
+    }
+    int size = celix_arrayList_size(*list);
+    for (int i = 0; i < size; ++i) {
+        celix_status_t status = celix_arrayList_addDouble(doubles, (double)celix_arrayList_getLong(*list, i));
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+    celix_arrayList_destroy(*list);
+    *list = celix_steal_ptr(doubles);
+    return CELIX_SUCCESS;
+}
+
+/**
+ * @brief Reads an array element and adds it to the list.
+ *
+ * The element type of the list is determined by the first element. Integers are promoted to doubles if the array also
+ * contains reals. If an element does not match the element type, *supported is set to false.
+ */
+static celix_status_t celix_properties_readArrayElement(celix_properties_json_reader_t* reader,
+                                                        celix_array_list_t** list,
+                                                        bool* supported) {
+    celix_status_t status;
+    char c = reader->cur < reader->end ? *reader->cur : '\0';
+    celix_array_list_element_type_t elType =
+        *list ? celix_arrayList_getElementType(*list) : CELIX_ARRAY_LIST_ELEMENT_TYPE_UNDEFINED;
+    celix_array_list_create_options_t opts = CELIX_EMPTY_ARRAY_LIST_CREATE_OPTIONS;
+
+    if (c == '"') {
+        status = celix_properties_readString(reader);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        bool isVersion = celix_properties_isVersionJsonString(reader->str, reader->strLen);
+        if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_UNDEFINED) {
+            elType = isVersion ? CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION : CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING;
+            opts.elementType = elType;
+            *list = celix_arrayList_createWithOptions(&opts);
+            if (!*list) {
+                return ENOMEM;
+            }
+        }
+        if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING) {
+            return celix_arrayList_addString(*list, reader->str);
+        } else if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION && isVersion) {
+            celix_version_t* version;
+            status = celix_properties_parseVersionString(reader, &version);
+            return CELIX_DO_IF(status, celix_arrayList_assignVersion(*list, version));
+        }
+    } else if (c == 't' || c == 'f') {
+        bool value = c == 't';
+        status = celix_properties_readLiteral(reader, value ? "true" : "false");
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_UNDEFINED) {
+            elType = CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL;
+            *list = celix_arrayList_createBoolArray();
+            if (!*list) {
+                return ENOMEM;
+            }
+        }
+        if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL) {
+            return celix_arrayList_addBool(*list, value);
+        }
+    } else if (c == '-' || (c >= '0' && c <= '9')) {
+        bool isReal;
+        long longValue = 0;
+        double doubleValue = 0.0;
+        status = celix_properties_readNumber(reader, &isReal, &longValue, &doubleValue);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_UNDEFINED) {
+            elType = isReal ? CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE : CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG;
+            opts.elementType = elType;
+            *list = celix_arrayList_createWithOptions(&opts);
+            if (!*list) {
+                return ENOMEM;
+            }
+        }
+        if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG && isReal) {
+            // mixed integer and real, ok but promote to real
+            status = celix_properties_promoteToDoubleArray(list);
+            return CELIX_DO_IF(status, celix_arrayList_addDouble(*list, doubleValue));
+        } else if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG) {
+            return celix_arrayList_addLong(*list, longValue);
+        } else if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE) {
+            return celix_arrayList_addDouble(*list, isReal ? doubleValue : (double)longValue);
+        }
+    } else {
+        // null, object, array (or invalid JSON)
+        status = celix_properties_skipValue(reader);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+
+    // mixed, null, object or multidimensional array
+    *supported = false;
+    celix_arrayList_destroy(*list);
+    *list = NULL;
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_properties_readArray(celix_properties_json_reader_t* reader) {
+    // precondition: reader->cur points to '['
+    const char* start = reader->cur;
+    reader->cur += 1;
+    celix_properties_skipWhitespace(reader);
+    if (celix_properties_peek(reader, ']')) {
+        reader->cur += 1;
+        if (reader->flags & CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_ARRAYS) {
+            celix_err_pushf("Invalid empty array for key '%s'.", reader->key);
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+        // ignore empty arrays
+        return CELIX_SUCCESS;
+    }
+
+    if (++reader->depth > CELIX_PROPERTIES_JSON_MAX_DEPTH) {
+        return celix_properties_readerError(reader, "maximum parsing depth reached");
+    }
+    celix_autoptr(celix_array_list_t) list = NULL;
+    bool supported = true;
+    for (;;) {
+        celix_status_t status;
+        celix_properties_skipWhitespace(reader);
+        if (supported) {
+            status = celix_properties_readArrayElement(reader, &list, &supported);
+        } else {
+            status = celix_properties_skipValue(reader);
+        }
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        celix_properties_skipWhitespace(reader);
+        if (celix_properties_peek(reader, ',')) {
+            reader->cur += 1;
+        } else if (celix_properties_peek(reader, ']')) {
+            reader->cur += 1;
+            break;
+        } else {
+            return celix_properties_readerError(reader, "']' or ',' expected");
+        }
+    }
+    reader->depth -= 1;
+
+    if (!supported && (reader->flags & CELIX_PROPERTIES_DECODE_ERROR_ON_UNSUPPORTED_ARRAYS)) {
+        celix_err_pushf("Invalid mixed, null, object or multidimensional array for key '%s': %.*s.",
+                        reader->key,
+                        (int)(reader->cur - start),
+                        start);
+        return CELIX_ILLEGAL_ARGUMENT;
+    } else if (!supported) {
+        // ignore mixed types
+        return CELIX_SUCCESS;
+    }
+    return celix_properties_assignArrayList(reader->props, reader->key, celix_steal_ptr(list));
+}
+
+static celix_status_t celix_properties_readObject(celix_properties_json_reader_t* reader);
+
+/**
+ * @brief Reads the JSON value for the current properties key (reader->key) and adds it to the properties.
+ */
+static celix_status_t celix_properties_readValue(celix_properties_json_reader_t* reader, bool checkCollision) {
+    if (reader->cur >= reader->end) {
+        return celix_properties_readerError(reader, "premature end of input");
+    }
+    char c = *reader->cur;
+    if (c == '{') {
+        return celix_properties_readObject(reader);
+    }
+
+    if (checkCollision && (reader->flags & CELIX_PROPERTIES_DECODE_ERROR_ON_COLLISIONS) &&
+        celix_properties_hasKey(reader->props, reader->key)) {
+        celix_err_pushf("Invalid key collision. Key '%s' already exists.", reader->key);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    celix_status_t status;
+    if (c == '"') {
+        status = celix_properties_readString(reader);
+        if (status == CELIX_SUCCESS && celix_properties_isVersionJsonString(reader->str, reader->strLen)) {
+            celix_version_t* version;
+            status = celix_properties_parseVersionString(reader, &version);
+            status = CELIX_DO_IF(status, celix_properties_assignVersion(reader->props, reader->key, version));
+        } else if (status == CELIX_SUCCESS) {
+            status = celix_properties_setString(reader->props, reader->key, reader->str);
+        }
+    } else if (c == 't' || c == 'f') {
+        bool value = c == 't';
+        status = celix_properties_readLiteral(reader, value ? "true" : "false");
+        status = CELIX_DO_IF(status, celix_properties_setBool(reader->props, reader->key, value));
+    } else if (c == 'n') {
+        status = celix_properties_readLiteral(reader, "null");
+        if (status == CELIX_SUCCESS && (reader->flags & CELIX_PROPERTIES_DECODE_ERROR_ON_NULL_VALUES)) {
+            celix_err_pushf("Invalid null value for key '%s'.", reader->key);
+            status = CELIX_ILLEGAL_ARGUMENT;
+        }
+        // else ignore null values
+    } else if (c == '[') {
+        status = celix_properties_readArray(reader);
+    } else {
+        bool isReal;
+        long longValue = 0;
+        double doubleValue = 0.0;
+        status = celix_properties_readNumber(reader, &isReal, &longValue, &doubleValue);
+        if (status == CELIX_SUCCESS && isReal) {
+            status = celix_properties_setDouble(reader->props, reader->key, doubleValue);
+        } else if (status == CELIX_SUCCESS) {
+            status = celix_properties_setLong(reader->props, reader->key, longValue);
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Reads a JSON object. The fields of nested JSON objects are added with the JSON path as properties key.
+ */
+static celix_status_t celix_properties_readObject(celix_properties_json_reader_t* reader) {
+    // precondition: reader->cur points to '{'
+    if (++reader->depth > CELIX_PROPERTIES_JSON_MAX_DEPTH) {
+        return celix_properties_readerError(reader, "maximum parsing depth reached");
+    }
+    reader->cur += 1;
+    celix_properties_skipWhitespace(reader);
+    if (celix_properties_peek(reader, '}')) {
+        reader->cur += 1;
+        reader->depth -= 1;
+        return CELIX_SUCCESS;
+    }
+
+    const size_t prefixLen = reader->keyLen;
+    const size_t nameOffset = reader->depth > 1 ? prefixLen + 1 : prefixLen;
+    // The field names are only tracked if needed to detect duplicates and to distinguish duplicates from collisions
+    const bool trackNames =
+        (reader->flags & (CELIX_PROPERTIES_DECODE_ERROR_ON_DUPLICATES | CELIX_PROPERTIES_DECODE_ERROR_ON_COLLISIONS)) != 0;
+    celix_autoptr(celix_string_hash_map_t) names = NULL;
+    for (;;) {
+        celix_properties_skipWhitespace(reader);
+        if (!celix_properties_peek(reader, '"')) {
+            return celix_properties_readerError(reader, "string or '}' expected");
+        }
+        const char* nameStart = reader->cur;
+        celix_status_t status = celix_properties_readString(reader);
+        status = CELIX_DO_IF(status, celix_properties_reserve(&reader->key, &reader->keyCap, nameOffset + reader->strLen + 1));
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        if (reader->depth > 1) {
+            reader->key[prefixLen] = CELIX_PROPERTIES_JSONPATH_SEPARATOR;
+        }
+        memcpy(reader->key + nameOffset, reader->str, reader->strLen + 1);
+        reader->keyLen = nameOffset + reader->strLen;
+
+        if (reader->keyLen == 0 && (reader->flags & CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_KEYS)) {
+            celix_err_push("Key cannot be empty.");
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+
+        bool duplicate = false;
+        if (trackNames) {
+            if (!names) {
+                names = celix_stringHashMap_create();
+                if (!names) {
+                    return ENOMEM;
+                }
+            }
+            const char* name = reader->key + nameOffset;
+            duplicate = celix_stringHashMap_hasKey(names, name);
+            if (duplicate && (reader->flags & CELIX_PROPERTIES_DECODE_ERROR_ON_DUPLICATES)) {
+                reader->cur = nameStart;
+                return celix_properties_readerError(reader, "duplicate object key");
+            } else if (!duplicate && celix_stringHashMap_putBool(names, name, true) != CELIX_SUCCESS) {
+                return ENOMEM;
+            }
+        }
+
+        celix_properties_skipWhitespace(reader);
+        if (!celix_properties_peek(reader, ':')) {
+            return celix_properties_readerError(reader, "':' expected");
+        }
+        reader->cur += 1;
+        celix_properties_skipWhitespace(reader);
+        status = celix_properties_readValue(reader, !duplicate);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        reader->keyLen = prefixLen;
+        reader->key[prefixLen] = '\0';
+
+        celix_properties_skipWhitespace(reader);
+        if (celix_properties_peek(reader, ',')) {
+            reader->cur += 1;
+        } else if (celix_properties_peek(reader, '}')) {
+            reader->cur += 1;
+            break;
+        } else {
+            return celix_properties_readerError(reader, "'}' or ',' expected");
+        }
+    }
+    reader->depth -= 1;
+    return CELIX_SUCCESS;
+}
+
+celix_status_t
+celix_properties_decodeFromBuffer(const char* input, size_t inputLen, int decodeFlags, celix_properties_t** out) {
+    *out = NULL;
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    if (!props) {
+        return ENOMEM;
+    }
+
+    celix_properties_json_reader_t reader;
+    memset(&reader, 0, sizeof(reader));
+    reader.input = input;
+    reader.cur = input;
+    reader.end = input + inputLen;
+    reader.flags = decodeFlags;
+    reader.props = props;
+    celix_status_t status = celix_properties_reserve(&reader.key, &reader.keyCap, 64);
+
+    if (status == CELIX_SUCCESS) {
+        reader.key[0] = '\0';
+        celix_properties_skipWhitespace(&reader);
+        if (reader.cur >= reader.end) {
+            status = celix_properties_readerError(&reader, "'{' expected near end of input");
+        } else if (*reader.cur != '{') {
+            celix_err_push("Expected json object.");
+            status = CELIX_ILLEGAL_ARGUMENT;
+        } else {
+            status = celix_properties_readObject(&reader);
+        }
+    }
+    if (status == CELIX_SUCCESS) {
+        celix_properties_skipWhitespace(&reader);
+        if (reader.cur < reader.end) {
+            status = celix_properties_readerError(&reader, "end of input expected");
+        }
+    }
+    free(reader.key);
+    free(reader.str);
+
+    if (status == CELIX_SUCCESS) {
+        *out = celix_steal_ptr(props);
+    }
+    return status;
+}
+
+celix_status_t celix_properties_decodeFromStream(FILE* stream, int decodeFlags, celix_properties_t** out) {
+    *out = NULL;
+    celix_autofree char* buffer = NULL;
+    size_t size = 0;
+    size_t cap = 0;
+    for (;;) {
+        if (size == cap) {
+            celix_status_t status = celix_properties_reserve(
+                &buffer, &cap, cap == 0 ? CELIX_PROPERTIES_JSON_INITIAL_BUFFER_SIZE : cap * 2);
+            if (status != CELIX_SUCCESS) {
+                return status;
+            }
+        }
+        size_t read = fread(buffer + size, 1, cap - size, stream);
+        size += read;
+        if (size < cap) {
+            if (ferror(stream)) {
+                celix_err_push("Failed to read json from stream.");
+                return CELIX_FILE_IO_EXCEPTION;
+            }
+            break; // end of stream
+        }
+    }
+    return celix_properties_decodeFromBuffer(buffer, size, decodeFlags, out);
+}
@@ -1,54 +0,0 @@
-/*
- * Licensed to the Apache Software Foundation (ASF) under one
- * or more contributor license agreements.  See the NOTICE file
- * distributed with this work for additional information
- * regarding copyright ownership.  The ASF licenses this file
- * to you under the Apache License, Version 2.0 (the
- * "License"); you may not use this file except in compliance
- * with the License.  You may obtain a copy of the License at
- *
- *   http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing,
- * software distributed under the License is distributed on an
- * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
- *  KIND, either express or implied.  See the License for the
- * specific language governing permissions and limitations
- * under the License.
- */
-/**
- * managed_service_impl.c
- *
- *  \date       Aug 12, 2013
- *  \author    	<a href="mailto:dev@celix.apache.org">Apache Celix Project Team</a>
- *  \copyright	Apache License, Version 2.0
- */
-
-#include <stdlib.h>
-#include <stdio.h>
-
-/* celix.config_admin.ManagedService */
-#include "managed_service.h"
-
-/* APR */
-
-
-/* ------------------------ Constructor -------------------------------------*/
-
-celix_status_t managedService_create(bundle_context_pt context, managed_service_service_pt *service){
-
-	managed_service_service_pt managedServiceService = calloc(1, sizeof(*managedServiceService));
-	if(!managedServiceService){
-		printf("[ ERROR ]: ManagedService Service not initialized \n");
-		return CELIX_ENOMEM;
-	}
-
-	*service = managedServiceService;
-	return CELIX_SUCCESS;
-
-}
-
-celix_status_t managedService_destroy(managed_service_service_pt service) {
-	free(service);
-	return CELIX_SUCCESS;
-}